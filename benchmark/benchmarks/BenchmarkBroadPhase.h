@@ -0,0 +1,232 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef BENCHMARK_BROAD_PHASE_H
+#define BENCHMARK_BROAD_PHASE_H
+
+// Libraries
+#include "Benchmark.h"
+#include "reactphysics3d.h"
+#include <vector>
+#include <sstream>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class BenchmarkBroadPhaseCallback
+/**
+ * Collision callback that counts the reported contacts.
+ */
+class BenchmarkBroadPhaseCallback : public CollisionCallback {
+
+    public:
+
+        /// Number of reported contacts
+        uint nbContacts;
+
+        /// Constructor
+        BenchmarkBroadPhaseCallback() : nbContacts(0) {
+
+        }
+
+        /// Called for each contact
+        virtual void notifyContact(const ContactPointInfo& contactPointInfo) {
+            nbContacts++;
+        }
+};
+
+// Class BenchmarkBroadPhase
+/**
+ * Benchmark of the broad-phase collision detection of a collision world where most
+ * of the bodies are static. The level is made of static tiles that touch each other
+ * and a smaller number of dynamic boxes move above them. The first step computes the
+ * overlapping pairs of all the bodies and the next steps those of the moving bodies.
+ * A second scenario is a very large open world where many small boxes spread over a
+ * few square kilometers all move at each step.
+ */
+class BenchmarkBroadPhase : public Benchmark {
+
+    private :
+
+        // ---------- Methods ---------- //
+
+        /// Return the name of a broad-phase algorithm
+        static const char* getBroadPhaseName(BroadPhaseType broadPhaseType) {
+            switch (broadPhaseType) {
+                case SWEEP_AND_PRUNE: return "sweep-and-prune";
+                case SPATIAL_HASH: return "spatial hash";
+                default: return "AABB trees";
+            }
+        }
+
+        /// Run the benchmark with a given number of static tiles on each side of the level,
+        /// a given number of threads and a given broad-phase algorithm
+        void runWithNbTiles(uint nbTilesPerSide, uint nbThreads,
+                            BroadPhaseType broadPhaseType = DYNAMIC_AABB_TREE) {
+
+            CollisionWorld world(broadPhaseType);
+            world.setNbThreads(nbThreads);
+            BoxShape tileShape(Vector3(decimal(1.0), decimal(0.2), decimal(1.0)));
+            BoxShape boxShape(Vector3(decimal(0.4), decimal(0.4), decimal(0.4)));
+
+            // Create the static tiles (one dynamic box above every nine tiles)
+            std::vector<CollisionBody*> boxes;
+            std::vector<Vector3> boxPositions;
+            world.beginBulkInsertion();
+            for (uint i=0; i<nbTilesPerSide; i++) {
+                for (uint j=0; j<nbTilesPerSide; j++) {
+
+                    const Vector3 position(decimal(i) * decimal(2.0), decimal(0.0), decimal(j) * decimal(2.0));
+                    CollisionBody* tile = world.createCollisionBody(Transform(position, Quaternion::identity()));
+                    tile->setType(STATIC);
+                    tile->addCollisionShape(&tileShape, Transform::identity());
+
+                    if (i % 3 == 1 && j % 3 == 1) {
+                        const Vector3 boxPosition = position + Vector3(decimal(0.0), decimal(1.0), decimal(0.0));
+                        CollisionBody* box = world.createCollisionBody(Transform(boxPosition,
+                                                                                 Quaternion::identity()));
+                        box->addCollisionShape(&boxShape, Transform::identity());
+                        boxes.push_back(box);
+                        boxPositions.push_back(boxPosition);
+                    }
+                }
+            }
+            world.endBulkInsertion();
+
+            std::ostringstream title;
+            title << nbTilesPerSide * nbTilesPerSide << " static tiles and " << boxes.size()
+                  << " dynamic boxes (" << nbThreads << " thread" << (nbThreads > 1 ? "s" : "") << ", "
+                  << getBroadPhaseName(broadPhaseType) << ")";
+            getOutputStream() << title.str() << std::endl;
+
+            // First step (the overlapping pairs of all the bodies are computed)
+            BenchmarkBroadPhaseCallback callback;
+            double startTime = getCurrentTime();
+            world.testCollision(&callback);
+            report("CollisionWorld : first step", getCurrentTime() - startTime);
+
+            // Move the boxes along a circle (they never touch the tiles)
+            const uint nbSteps = 100;
+            startTime = getCurrentTime();
+            for (uint s=1; s<=nbSteps; s++) {
+                const decimal angle = decimal(s) * decimal(0.1);
+                const Vector3 displacement(std::cos(angle) * decimal(0.5), decimal(0.0),
+                                           std::sin(angle) * decimal(0.5));
+                for (uint b=0; b<boxes.size(); b++) {
+                    boxes[b]->setTransform(Transform(boxPositions[b] + displacement, Quaternion::identity()));
+                }
+                world.testCollision(&callback);
+            }
+            report("CollisionWorld : next steps (x100)", getCurrentTime() - startTime);
+
+            // Print the checksum so that the compiler cannot remove the measured code
+            getOutputStream() << "  (contacts " << callback.nbContacts << ")" << std::endl;
+        }
+
+        /// Run the open world benchmark with a given broad-phase algorithm
+        void runOpenWorld(uint nbBoxes, decimal worldSize, BroadPhaseType broadPhaseType) {
+
+            CollisionWorld world(broadPhaseType);
+            BoxShape boxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+
+            // Create the boxes at pseudo-random positions with pseudo-random velocities
+            std::vector<CollisionBody*> boxes;
+            std::vector<Vector3> boxPositions;
+            std::vector<Vector3> boxVelocities;
+            uint random = 12345;
+            world.beginBulkInsertion();
+            for (uint b=0; b<nbBoxes; b++) {
+                decimal values[4];
+                for (int k=0; k<4; k++) {
+                    random = random * 1664525u + 1013904223u;
+                    values[k] = decimal(random >> 8) / decimal(1 << 24);
+                }
+                const Vector3 position(values[0] * worldSize, values[1] * decimal(10.0),
+                                       values[2] * worldSize);
+                CollisionBody* box = world.createCollisionBody(Transform(position, Quaternion::identity()));
+                box->addCollisionShape(&boxShape, Transform::identity());
+                boxes.push_back(box);
+                boxPositions.push_back(position);
+                const decimal angle = values[3] * decimal(2.0 * PI);
+                boxVelocities.push_back(Vector3(std::cos(angle), decimal(0.0), std::sin(angle)) * decimal(0.3));
+            }
+            world.endBulkInsertion();
+
+            getOutputStream() << nbBoxes << " moving boxes in an open world of " << static_cast<int>(worldSize) << " m ("
+                              << getBroadPhaseName(broadPhaseType) << ")" << std::endl;
+
+            // First step (the overlapping pairs of all the bodies are computed)
+            BenchmarkBroadPhaseCallback callback;
+            double startTime = getCurrentTime();
+            world.testCollision(&callback);
+            report("CollisionWorld : first step", getCurrentTime() - startTime);
+
+            // Move all the boxes
+            const uint nbSteps = 50;
+            uint nbReinsertedShapes = 0;
+            uint nbPotentialPairs = 0;
+            startTime = getCurrentTime();
+            for (uint s=1; s<=nbSteps; s++) {
+                for (uint b=0; b<boxes.size(); b++) {
+                    boxPositions[b] += boxVelocities[b];
+                    boxes[b]->setTransform(Transform(boxPositions[b], Quaternion::identity()));
+                }
+                world.testCollision(&callback);
+                nbReinsertedShapes += world.getBroadPhaseStatistics().nbReinsertedShapes;
+                nbPotentialPairs += world.getBroadPhaseStatistics().nbPotentialPairs;
+            }
+            report("CollisionWorld : next steps (x50)", getCurrentTime() - startTime);
+
+            // Print the checksum so that the compiler cannot remove the measured code
+            getOutputStream() << "  (contacts " << callback.nbContacts << ", reinsertions "
+                              << nbReinsertedShapes << ", potential pairs " << nbPotentialPairs
+                              << ")" << std::endl;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        BenchmarkBroadPhase(const std::string& name) : Benchmark(name) {
+
+        }
+
+        /// Run the benchmark
+        virtual void run() {
+            runWithNbTiles(100, 1);
+            runWithNbTiles(100, 1, SWEEP_AND_PRUNE);
+            runWithNbTiles(300, 1);
+            runWithNbTiles(300, 1, SWEEP_AND_PRUNE);
+            runWithNbTiles(300, 4);
+            runOpenWorld(20000, decimal(2000.0), DYNAMIC_AABB_TREE);
+            runOpenWorld(20000, decimal(2000.0), SWEEP_AND_PRUNE);
+            runOpenWorld(20000, decimal(2000.0), SPATIAL_HASH);
+        }
+};
+
+}
+
+#endif
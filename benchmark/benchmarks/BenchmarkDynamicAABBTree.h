@@ -0,0 +1,277 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef BENCHMARK_DYNAMIC_AABB_TREE_H
+#define BENCHMARK_DYNAMIC_AABB_TREE_H
+
+// Libraries
+#include "Benchmark.h"
+#include "reactphysics3d.h"
+#include "collision/broadphase/DynamicAABBTree.h"
+#include <vector>
+#include <sstream>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class BenchmarkOverlapCallback
+/**
+ * Overlap callback that counts the number of overlapping nodes
+ */
+class BenchmarkOverlapCallback : public DynamicAABBTreeOverlapCallback {
+
+    public :
+
+        /// Number of overlapping nodes reported
+        uint nbOverlaps;
+
+        /// Constructor
+        BenchmarkOverlapCallback() : nbOverlaps(0) {
+
+        }
+
+        /// Called when a overlapping node has been found
+        virtual void notifyOverlappingNode(int nodeId) {
+            nbOverlaps++;
+        }
+};
+
+// Class BenchmarkRaycastCallback
+/**
+ * Raycast callback that counts the number of leaves hit by the ray and
+ * continues the raycast as if the shapes did not exist
+ */
+class BenchmarkRaycastCallback : public DynamicAABBTreeRaycastCallback {
+
+    public :
+
+        /// Number of leaves hit by the rays
+        uint nbHits;
+
+        /// Constructor
+        BenchmarkRaycastCallback() : nbHits(0) {
+
+        }
+
+        /// Called when the AABB of a leaf node is hit by a ray
+        virtual decimal raycastBroadPhaseShape(int32 nodeId, const Ray& ray) {
+            nbHits++;
+            return decimal(-1.0);
+        }
+};
+
+// Class BenchmarkDynamicAABBTree
+/**
+ * Benchmark of the dynamic AABB tree on a dense crowd of boxes. The tree is built
+ * by inserting the objects one by one or with a bulk insertion and then queried
+ * (AABB overlap queries as done by the broad-phase and raycasts). The creation of
+ * the bodies of a collision world (level loading) is also measured. Finally, the
+ * objects drift slowly for a long time with and without the incremental optimization
+ * of the tree.
+ */
+class BenchmarkDynamicAABBTree : public Benchmark {
+
+    private :
+
+        // ---------- Methods ---------- //
+
+        /// Return a pseudo-random number between zero and one
+        static decimal random(uint32& seed) {
+            seed = seed * 1664525u + 1013904223u;
+            return decimal(seed >> 8) / decimal(1 << 24);
+        }
+
+        /// Create the AABBs of a crowd of objects on a square grid with some random offsets
+        static void createCrowd(uint nbObjects, std::vector<AABB>& aabbs) {
+
+            uint32 seed = 12345;
+            const uint gridSize = static_cast<uint>(std::sqrt(decimal(nbObjects))) + 1;
+            aabbs.resize(nbObjects);
+            for (uint i=0; i<nbObjects; i++) {
+                Vector3 center(decimal(i % gridSize) * decimal(1.5) + random(seed),
+                               random(seed) * decimal(4.0),
+                               decimal(i / gridSize) * decimal(1.5) + random(seed));
+                Vector3 halfExtent(decimal(0.5), decimal(1.0), decimal(0.5));
+                aabbs[i] = AABB(center - halfExtent, center + halfExtent);
+            }
+        }
+
+        /// Run the benchmark for a given number of objects in the tree
+        void runWithNbObjects(uint nbObjects, bool isBulkInsertion) {
+
+            std::vector<AABB> aabbs;
+            createCrowd(nbObjects, aabbs);
+
+            std::ostringstream title;
+            title << nbObjects << " objects" << (isBulkInsertion ? " (bulk insertion)" : "");
+            getOutputStream() << title.str() << std::endl;
+
+            DynamicAABBTree tree(decimal(0.1));
+            double startTime = getCurrentTime();
+            if (isBulkInsertion) tree.beginBulkInsertion();
+            for (uint i=0; i<nbObjects; i++) {
+                tree.addObject(aabbs[i], static_cast<int32>(i), 0);
+            }
+            if (isBulkInsertion) tree.endBulkInsertion();
+            report("DynamicAABBTree : build", getCurrentTime() - startTime);
+
+            // AABB overlap queries (one for each object as done by the broad-phase)
+            BenchmarkOverlapCallback overlapCallback;
+            startTime = getCurrentTime();
+            for (int r=0; r<4; r++) {
+                for (uint i=0; i<nbObjects; i++) {
+                    tree.reportAllShapesOverlappingWithAABB(aabbs[i], overlapCallback);
+                }
+            }
+            report("DynamicAABBTree : AABB overlap queries (x4)", getCurrentTime() - startTime);
+
+            // Raycasts through the crowd
+            const uint nbRays = 20000;
+            AABB rootAABB = tree.getRootAABB();
+            const Vector3 extent = rootAABB.getMax() - rootAABB.getMin();
+            uint32 seed = 6789;
+            std::vector<Ray> rays;
+            for (uint i=0; i<nbRays; i++) {
+                Vector3 point1 = rootAABB.getMin() + Vector3(random(seed) * extent.x, decimal(2.0),
+                                                             random(seed) * extent.z);
+                Vector3 direction(random(seed) - decimal(0.5), decimal(0.0),
+                                  random(seed) - decimal(0.5));
+                rays.push_back(Ray(point1, point1 + direction * decimal(20.0)));
+            }
+
+            BenchmarkRaycastCallback raycastCallback;
+            startTime = getCurrentTime();
+            for (uint i=0; i<nbRays; i++) {
+                tree.raycast(rays[i], raycastCallback);
+            }
+            report("DynamicAABBTree : raycasts (20000)", getCurrentTime() - startTime);
+
+            // Print the checksum so that the compiler cannot remove the measured code
+            getOutputStream() << "  (overlaps " << overlapCallback.nbOverlaps << ", ray hits "
+                              << raycastCallback.nbHits << ")" << std::endl;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        BenchmarkDynamicAABBTree(const std::string& name) : Benchmark(name) {
+
+        }
+
+        /// Create the bodies of a collision world (one box per body)
+        void runLevelLoading(uint nbBodies, bool isBulkInsertion) {
+
+            std::vector<AABB> aabbs;
+            createCrowd(nbBodies, aabbs);
+
+            CollisionWorld world;
+            BoxShape boxShape(Vector3(decimal(0.5), decimal(1.0), decimal(0.5)));
+
+            double startTime = getCurrentTime();
+            if (isBulkInsertion) world.beginBulkInsertion();
+            for (uint i=0; i<nbBodies; i++) {
+                const Transform transform(aabbs[i].getCenter(), Quaternion::identity());
+                CollisionBody* body = world.createCollisionBody(transform);
+                body->addCollisionShape(&boxShape, Transform::identity());
+            }
+            if (isBulkInsertion) world.endBulkInsertion();
+
+            std::ostringstream title;
+            title << "CollisionWorld : create " << nbBodies << " bodies"
+                  << (isBulkInsertion ? " (bulk insertion)" : "");
+            report(title.str(), getCurrentTime() - startTime);
+        }
+
+        /// Move a few objects at each step during many steps and measure the queries at the end
+        void runDrift(uint nbObjects, uint nbLeavesToOptimizePerStep) {
+
+            std::vector<AABB> aabbs;
+            createCrowd(nbObjects, aabbs);
+
+            DynamicAABBTree tree(decimal(0.1));
+            std::vector<int> nodeIDs(nbObjects);
+            tree.beginBulkInsertion();
+            for (uint i=0; i<nbObjects; i++) {
+                nodeIDs[i] = tree.addObject(aabbs[i], static_cast<int32>(i), 0);
+            }
+            tree.endBulkInsertion();
+
+            // Move 2% of the objects (chosen randomly) in the plane of the crowd at each step
+            const uint nbSteps = 2000;
+            const uint nbMovedObjects = nbObjects / 50;
+            uint32 seed = 4321;
+            double optimizationTime = 0;
+            for (uint s=0; s<nbSteps; s++) {
+                for (uint m=0; m<nbMovedObjects; m++) {
+                    const uint i = static_cast<uint>(random(seed) * nbObjects) % nbObjects;
+                    const Vector3 displacement((random(seed) - decimal(0.5)) * decimal(10.0), decimal(0.0),
+                                               (random(seed) - decimal(0.5)) * decimal(10.0));
+                    aabbs[i] = AABB(aabbs[i].getMin() + displacement, aabbs[i].getMax() + displacement);
+                    tree.updateObject(nodeIDs[i], aabbs[i], Vector3::zero());
+                }
+                const double startTime = getCurrentTime();
+                tree.optimize(nbLeavesToOptimizePerStep);
+                optimizationTime += getCurrentTime() - startTime;
+            }
+
+            std::ostringstream title;
+            title << nbObjects << " objects after " << nbSteps << " steps of drift ("
+                  << nbLeavesToOptimizePerStep << " leaves optimized per step)";
+            getOutputStream() << title.str() << std::endl;
+            if (nbLeavesToOptimizePerStep > 0) {
+                report("DynamicAABBTree : optimization (total)", optimizationTime);
+            }
+
+            BenchmarkOverlapCallback overlapCallback;
+            const double startTime = getCurrentTime();
+            for (int r=0; r<4; r++) {
+                for (uint i=0; i<nbObjects; i++) {
+                    tree.reportAllShapesOverlappingWithAABB(aabbs[i], overlapCallback);
+                }
+            }
+            report("DynamicAABBTree : AABB overlap queries (x4)", getCurrentTime() - startTime);
+            getOutputStream() << "  (tree cost " << tree.computeCost() << ", overlaps "
+                              << overlapCallback.nbOverlaps << ")" << std::endl;
+        }
+
+        /// Run the benchmark
+        virtual void run() {
+            runWithNbObjects(10000, false);
+            runWithNbObjects(10000, true);
+            runWithNbObjects(100000, false);
+            runWithNbObjects(100000, true);
+            runLevelLoading(50000, false);
+            runLevelLoading(50000, true);
+            runDrift(10000, 0);
+            runDrift(10000, 64);
+            runDrift(10000, 256);
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,307 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef BENCHMARK_NARROW_PHASE_H
+#define BENCHMARK_NARROW_PHASE_H
+
+// Libraries
+#include "Benchmark.h"
+#include "reactphysics3d.h"
+#include "collision/narrowphase/GJK/GJKAlgorithm.h"
+#include <vector>
+#include <sstream>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class BenchmarkGJKCollisionDispatch
+/**
+ * Collision dispatch that uses the GJK algorithm for all the pairs of convex shapes.
+ */
+class BenchmarkGJKCollisionDispatch : public CollisionDispatch {
+
+    private:
+
+        /// GJK algorithm
+        GJKAlgorithm mGJKAlgorithm;
+
+    public:
+
+        /// Initialize the collision dispatch configuration
+        virtual void init(CollisionDetection* collisionDetection, MemoryAllocator* memoryAllocator) {
+            mGJKAlgorithm.init(collisionDetection, memoryAllocator);
+        }
+
+        /// Return the GJK algorithm for all the pairs of shapes
+        virtual NarrowPhaseAlgorithm* selectAlgorithm(int shape1Type, int shape2Type) {
+            return &mGJKAlgorithm;
+        }
+};
+
+// Class BenchmarkNarrowPhase
+/**
+ * Benchmark of the narrow-phase collision detection in a scene similar to the
+ * cubes scene of the testbed. Stacks of boxes and spheres fall on a static floor
+ * box. The simulation is run with the default collision dispatch (analytic box and
+ * sphere algorithms) and with the GJK/EPA algorithm for all the pairs of shapes.
+ * A second scene is made of stacks of convex mesh cubes simulated with a small
+ * number of velocity solver iterations. The drift of the cubes measures the
+ * stability of the stacks. A last scene is made of piles of rounded convex meshes
+ * with many vertices to measure the computation of their support points.
+ */
+class BenchmarkNarrowPhase : public Benchmark {
+
+    private :
+
+        // ---------- Methods ---------- //
+
+        /// Run the simulation with a given collision dispatch (NULL for the default one)
+        void runCubesScene(uint nbStacks, uint stackHeight, CollisionDispatch* collisionDispatch) {
+
+            DynamicsWorld world(Vector3(decimal(0.0), decimal(-9.81), decimal(0.0)));
+            if (collisionDispatch != NULL) world.setCollisionDispatch(collisionDispatch);
+
+            BoxShape floorShape(Vector3(decimal(50.0), decimal(0.5), decimal(50.0)));
+            BoxShape boxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            SphereShape sphereShape(decimal(0.5));
+
+            RigidBody* floor = world.createRigidBody(Transform(Vector3(0, decimal(-0.5), 0),
+                                                               Quaternion::identity()));
+            floor->setType(STATIC);
+            floor->addCollisionShape(&floorShape, Transform::identity(), decimal(1.0));
+
+            // Create the stacks (a sphere on top of each stack of boxes)
+            for (uint i=0; i<nbStacks; i++) {
+                for (uint j=0; j<nbStacks; j++) {
+                    for (uint k=0; k<=stackHeight; k++) {
+                        const Vector3 position(decimal(i) * decimal(3.0) - decimal(nbStacks),
+                                               decimal(0.55) + decimal(k) * decimal(1.05),
+                                               decimal(j) * decimal(3.0) - decimal(nbStacks));
+                        RigidBody* body = world.createRigidBody(Transform(position, Quaternion::identity()));
+                        CollisionShape* shape = (k < stackHeight) ? static_cast<CollisionShape*>(&boxShape) :
+                                                                    static_cast<CollisionShape*>(&sphereShape);
+                        body->addCollisionShape(shape, Transform::identity(), decimal(1.0));
+                    }
+                }
+            }
+
+            // Simulate two seconds
+            const uint nbSteps = 120;
+            const double startTime = getCurrentTime();
+            for (uint s=0; s<nbSteps; s++) {
+                world.update(decimal(1.0 / 60.0));
+            }
+
+            std::ostringstream operation;
+            operation << "DynamicsWorld::update() x" << nbSteps << " ("
+                      << (collisionDispatch == NULL ? "analytic" : "GJK/EPA") << ")";
+            report(operation.str(), getCurrentTime() - startTime);
+        }
+
+        /// Run the simulation of stacks of convex mesh cubes with a given collision dispatch
+        /// (NULL for the default one) and a given number of velocity solver iterations
+        void runConvexMeshScene(uint nbStacks, uint stackHeight, CollisionDispatch* collisionDispatch,
+                                uint nbVelocityIterations) {
+
+            DynamicsWorld world(Vector3(decimal(0.0), decimal(-9.81), decimal(0.0)));
+            if (collisionDispatch != NULL) world.setCollisionDispatch(collisionDispatch);
+            world.setNbIterationsVelocitySolver(nbVelocityIterations);
+
+            // Create the convex mesh of a cube
+            std::vector<Vector3> vertices;
+            for (int i=0; i<8; i++) {
+                vertices.push_back(Vector3(i & 1 ? decimal(0.46) : decimal(-0.46),
+                                           i & 2 ? decimal(0.46) : decimal(-0.46),
+                                           i & 4 ? decimal(0.46) : decimal(-0.46)));
+            }
+            uint indices[36] = {0, 1, 3, 0, 3, 2, 4, 7, 5, 4, 6, 7, 0, 4, 5, 0, 5, 1,
+                                2, 3, 7, 2, 7, 6, 0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3};
+            TriangleVertexArray vertexArray(8, &(vertices[0]), sizeof(Vector3), 12, indices, sizeof(uint),
+                                            sizeof(decimal) == 4 ? TriangleVertexArray::VERTEX_FLOAT_TYPE :
+                                                                   TriangleVertexArray::VERTEX_DOUBLE_TYPE,
+                                            TriangleVertexArray::INDEX_INTEGER_TYPE);
+            ConvexMeshShape meshShape(&vertexArray);
+            BoxShape floorShape(Vector3(decimal(50.0), decimal(0.5), decimal(50.0)));
+
+            RigidBody* floor = world.createRigidBody(Transform(Vector3(0, decimal(-0.5), 0),
+                                                               Quaternion::identity()));
+            floor->setType(STATIC);
+            floor->addCollisionShape(&floorShape, Transform::identity(), decimal(1.0));
+
+            // Create the stacks
+            std::vector<RigidBody*> bodies;
+            std::vector<Vector3> initialPositions;
+            for (uint i=0; i<nbStacks; i++) {
+                for (uint j=0; j<nbStacks; j++) {
+                    for (uint k=0; k<stackHeight; k++) {
+                        const Vector3 position(decimal(i) * decimal(3.0) - decimal(nbStacks),
+                                               decimal(0.5) + decimal(k) * decimal(1.0),
+                                               decimal(j) * decimal(3.0) - decimal(nbStacks));
+                        RigidBody* body = world.createRigidBody(Transform(position, Quaternion::identity()));
+                        body->addCollisionShape(&meshShape, Transform::identity(), decimal(1.0));
+                        bodies.push_back(body);
+                        initialPositions.push_back(position);
+                    }
+                }
+            }
+
+            // Simulate two seconds
+            const uint nbSteps = 120;
+            const double startTime = getCurrentTime();
+            for (uint s=0; s<nbSteps; s++) {
+                world.update(decimal(1.0 / 60.0));
+            }
+
+            std::ostringstream operation;
+            operation << "DynamicsWorld::update() x" << nbSteps << " ("
+                      << (collisionDispatch == NULL ? "SAT" : "GJK/EPA") << ", "
+                      << nbVelocityIterations << " iterations)";
+            report(operation.str(), getCurrentTime() - startTime);
+
+            // Average horizontal drift of the cubes
+            decimal drift = decimal(0.0);
+            for (uint b=0; b<bodies.size(); b++) {
+                Vector3 displacement = bodies[b]->getTransform().getPosition() - initialPositions[b];
+                displacement.y = decimal(0.0);
+                drift += displacement.length();
+            }
+            getOutputStream() << "  (average drift " << drift / decimal(bodies.size()) << " m)" << std::endl;
+        }
+
+        /// Run the simulation of piles of rounded convex meshes with the GJK/EPA algorithm.
+        /// The meshes are spheres made of rings of vertices. The support points of the
+        /// meshes are computed with or without the edges information of the mesh.
+        void runRoundMeshScene(uint nbStacks, uint stackHeight, uint nbRings, uint nbSegments,
+                               bool isEdgesInformationUsed, CollisionDispatch* collisionDispatch) {
+
+            DynamicsWorld world(Vector3(decimal(0.0), decimal(-9.81), decimal(0.0)));
+            world.setCollisionDispatch(collisionDispatch);
+
+            // Create the vertices and triangles of the sphere mesh
+            const decimal radius = decimal(0.5);
+            std::vector<Vector3> vertices;
+            vertices.push_back(Vector3(0, radius, 0));
+            for (uint r=1; r<=nbRings; r++) {
+                const decimal theta = PI * decimal(r) / decimal(nbRings + 1);
+                for (uint s=0; s<nbSegments; s++) {
+                    const decimal phi = PI_TIMES_2 * decimal(s) / decimal(nbSegments);
+                    vertices.push_back(radius * Vector3(std::sin(theta) * std::cos(phi), std::cos(theta),
+                                                        std::sin(theta) * std::sin(phi)));
+                }
+            }
+            vertices.push_back(Vector3(0, -radius, 0));
+            const uint lastVertex = static_cast<uint>(vertices.size()) - 1;
+            const uint lastRing = 1 + (nbRings - 1) * nbSegments;
+            std::vector<uint> indices;
+            for (uint s=0; s<nbSegments; s++) {
+                const uint next = (s + 1) % nbSegments;
+                indices.push_back(0); indices.push_back(1 + s); indices.push_back(1 + next);
+                indices.push_back(lastVertex); indices.push_back(lastRing + next); indices.push_back(lastRing + s);
+                for (uint r=0; r+1<nbRings; r++) {
+                    const uint a = 1 + r * nbSegments + s;
+                    const uint b = 1 + r * nbSegments + next;
+                    indices.push_back(a); indices.push_back(a + nbSegments); indices.push_back(b);
+                    indices.push_back(b); indices.push_back(a + nbSegments); indices.push_back(b + nbSegments);
+                }
+            }
+            TriangleVertexArray vertexArray(vertices.size(), &(vertices[0]), sizeof(Vector3),
+                                            indices.size() / 3, &(indices[0]), sizeof(uint),
+                                            sizeof(decimal) == 4 ? TriangleVertexArray::VERTEX_FLOAT_TYPE :
+                                                                   TriangleVertexArray::VERTEX_DOUBLE_TYPE,
+                                            TriangleVertexArray::INDEX_INTEGER_TYPE);
+            ConvexMeshShape meshShape(&vertexArray, isEdgesInformationUsed);
+            BoxShape floorShape(Vector3(decimal(50.0), decimal(0.5), decimal(50.0)));
+
+            RigidBody* floor = world.createRigidBody(Transform(Vector3(0, decimal(-0.5), 0),
+                                                               Quaternion::identity()));
+            floor->setType(STATIC);
+            floor->addCollisionShape(&floorShape, Transform::identity(), decimal(1.0));
+
+            // Create the piles of meshes
+            for (uint i=0; i<nbStacks; i++) {
+                for (uint j=0; j<nbStacks; j++) {
+                    for (uint k=0; k<stackHeight; k++) {
+                        const Vector3 position(decimal(i) * decimal(1.5) - decimal(nbStacks) +
+                                               decimal(0.1) * decimal(k),
+                                               decimal(0.5) + decimal(k) * decimal(1.0),
+                                               decimal(j) * decimal(1.5) - decimal(nbStacks));
+                        RigidBody* body = world.createRigidBody(Transform(position, Quaternion::identity()));
+                        body->addCollisionShape(&meshShape, Transform::identity(), decimal(1.0));
+                    }
+                }
+            }
+
+            // Simulate two seconds
+            const uint nbSteps = 120;
+            const double startTime = getCurrentTime();
+            for (uint s=0; s<nbSteps; s++) {
+                world.update(decimal(1.0 / 60.0));
+            }
+
+            std::ostringstream operation;
+            operation << "DynamicsWorld::update() x" << nbSteps << " (" << vertices.size()
+                      << " vertices, " << (isEdgesInformationUsed ? "hill-climbing" : "all vertices") << ")";
+            report(operation.str(), getCurrentTime() - startTime);
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        BenchmarkNarrowPhase(const std::string& name) : Benchmark(name) {
+
+        }
+
+        /// Run the benchmark
+        virtual void run() {
+
+            const uint nbStacks = 8;
+            const uint stackHeight = 4;
+            getOutputStream() << nbStacks * nbStacks << " stacks of " << stackHeight
+                              << " boxes and a sphere" << std::endl;
+
+            BenchmarkGJKCollisionDispatch gjkDispatch;
+            runCubesScene(nbStacks, stackHeight, NULL);
+            runCubesScene(nbStacks, stackHeight, &gjkDispatch);
+
+            getOutputStream() << nbStacks * nbStacks << " stacks of " << stackHeight + 2
+                              << " convex mesh cubes" << std::endl;
+            runConvexMeshScene(nbStacks, stackHeight + 2, NULL, 4);
+            runConvexMeshScene(nbStacks, stackHeight + 2, &gjkDispatch, 4);
+            runConvexMeshScene(nbStacks, stackHeight + 2, &gjkDispatch, DEFAULT_VELOCITY_SOLVER_NB_ITERATIONS);
+
+            getOutputStream() << nbStacks * nbStacks << " piles of " << stackHeight
+                              << " rounded convex meshes (GJK/EPA)" << std::endl;
+            runRoundMeshScene(nbStacks, stackHeight, 6, 10, false, &gjkDispatch);
+            runRoundMeshScene(nbStacks, stackHeight, 6, 10, true, &gjkDispatch);
+            runRoundMeshScene(nbStacks, stackHeight, 15, 17, false, &gjkDispatch);
+            runRoundMeshScene(nbStacks, stackHeight, 15, 17, true, &gjkDispatch);
+        }
+};
+
+}
+
+#endif
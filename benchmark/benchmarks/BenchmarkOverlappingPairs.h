@@ -0,0 +1,160 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef BENCHMARK_OVERLAPPING_PAIRS_H
+#define BENCHMARK_OVERLAPPING_PAIRS_H
+
+// Libraries
+#include "Benchmark.h"
+#include "reactphysics3d.h"
+#include "engine/OverlappingPairMap.h"
+#include <vector>
+#include <map>
+#include <sstream>
+#include <cstddef>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class BenchmarkOverlappingPairs
+/**
+ * Benchmark of the storage of the overlapping pairs of the collision detection.
+ * The OverlappingPairMap used by the collision detection is compared with
+ * the std::map that was used before for the same operations (add, find, linear
+ * sweep over all the pairs and removal).
+ */
+class BenchmarkOverlappingPairs : public Benchmark {
+
+    private :
+
+        // ---------- Methods ---------- //
+
+        /// Create the IDs of the pairs (each shape overlaps a few neighbor shapes)
+        /// in a pseudo-random order
+        static void createPairIDs(uint nbPairs, std::vector<overlappingpairid>& pairIDs) {
+
+            pairIDs.resize(nbPairs);
+            for (uint i=0; i<nbPairs; i++) {
+                pairIDs[i] = std::make_pair(i / 8, i / 8 + 1 + i % 8);
+            }
+
+            // Shuffle the pairs with a linear congruential generator
+            uint32 seed = 12345;
+            for (uint i=nbPairs-1; i>0; i--) {
+                seed = seed * 1664525u + 1013904223u;
+                std::swap(pairIDs[i], pairIDs[seed % (i + 1)]);
+            }
+        }
+
+        /// Return the fake pair associated with a given index (the pairs are never dereferenced)
+        static OverlappingPair* getPair(uint index) {
+            return reinterpret_cast<OverlappingPair*>(static_cast<size_t>(index + 1) * 16);
+        }
+
+        /// Run the benchmark for a given number of pairs
+        void runWithNbPairs(uint nbPairs) {
+
+            std::vector<overlappingpairid> pairIDs;
+            createPairIDs(nbPairs, pairIDs);
+
+            std::ostringstream title;
+            title << nbPairs << " pairs";
+            getOutputStream() << title.str() << std::endl;
+
+            size_t checksum = 0;
+
+            // ---------- OverlappingPairMap ---------- //
+
+            OverlappingPairMap pairMap;
+
+            double startTime = getCurrentTime();
+            for (uint i=0; i<nbPairs; i++) pairMap.add(pairIDs[i], getPair(i));
+            report("OverlappingPairMap : add", getCurrentTime() - startTime);
+
+            startTime = getCurrentTime();
+            for (uint i=0; i<nbPairs; i++) {
+                checksum += reinterpret_cast<size_t>(pairMap.find(pairIDs[i]));
+            }
+            report("OverlappingPairMap : find", getCurrentTime() - startTime);
+
+            startTime = getCurrentTime();
+            for (uint i=0; i<pairMap.getNbPairs(); i++) {
+                checksum += reinterpret_cast<size_t>(pairMap.getPair(i));
+            }
+            report("OverlappingPairMap : sweep", getCurrentTime() - startTime);
+
+            startTime = getCurrentTime();
+            for (uint i=0; i<nbPairs; i+=2) pairMap.remove(pairIDs[i]);
+            report("OverlappingPairMap : remove half", getCurrentTime() - startTime);
+
+            // ---------- std::map ---------- //
+
+            std::map<overlappingpairid, OverlappingPair*> stdMap;
+
+            startTime = getCurrentTime();
+            for (uint i=0; i<nbPairs; i++) stdMap.insert(std::make_pair(pairIDs[i], getPair(i)));
+            report("std::map : add", getCurrentTime() - startTime);
+
+            startTime = getCurrentTime();
+            for (uint i=0; i<nbPairs; i++) {
+                checksum += reinterpret_cast<size_t>(stdMap.find(pairIDs[i])->second);
+            }
+            report("std::map : find", getCurrentTime() - startTime);
+
+            startTime = getCurrentTime();
+            std::map<overlappingpairid, OverlappingPair*>::const_iterator it;
+            for (it = stdMap.begin(); it != stdMap.end(); ++it) {
+                checksum += reinterpret_cast<size_t>(it->second);
+            }
+            report("std::map : sweep", getCurrentTime() - startTime);
+
+            startTime = getCurrentTime();
+            for (uint i=0; i<nbPairs; i+=2) stdMap.erase(pairIDs[i]);
+            report("std::map : remove half", getCurrentTime() - startTime);
+
+            // Print the checksum so that the compiler cannot remove the measured code
+            getOutputStream() << "  (checksum " << checksum % 997 << ")" << std::endl;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        BenchmarkOverlappingPairs(const std::string& name) : Benchmark(name) {
+
+        }
+
+        /// Run the benchmark
+        virtual void run() {
+            runWithNbPairs(10000);
+            runWithNbPairs(100000);
+            runWithNbPairs(1000000);
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,168 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef BENCHMARK_STATIC_AABB_TREE_H
+#define BENCHMARK_STATIC_AABB_TREE_H
+
+// Libraries
+#include "Benchmark.h"
+#include "BenchmarkDynamicAABBTree.h"
+#include "reactphysics3d.h"
+#include "collision/broadphase/DynamicAABBTree.h"
+#include "collision/broadphase/StaticAABBTree.h"
+#include <vector>
+#include <sstream>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class BenchmarkStaticAABBTree
+/**
+ * Benchmark of the AABB tree of the concave mesh shapes. The triangles of a large
+ * terrain-like mesh are inserted one by one into a DynamicAABBTree (as it was done
+ * before) and are used to build a StaticAABBTree. Both trees are then queried with
+ * the same AABBs and rays.
+ */
+class BenchmarkStaticAABBTree : public Benchmark {
+
+    private :
+
+        // ---------- Methods ---------- //
+
+        /// Return a pseudo-random number between zero and one
+        static decimal random(uint32& seed) {
+            seed = seed * 1664525u + 1013904223u;
+            return decimal(seed >> 8) / decimal(1 << 24);
+        }
+
+        /// Create the AABBs of the triangles of a grid mesh with a bumpy height
+        static void createTriangles(uint gridSize, std::vector<AABB>& aabbs) {
+
+            uint32 seed = 2468;
+            std::vector<decimal> heights((gridSize + 1) * (gridSize + 1));
+            for (uint i=0; i<heights.size(); i++) heights[i] = random(seed) * decimal(2.0);
+
+            for (uint i=0; i<gridSize; i++) {
+                for (uint j=0; j<gridSize; j++) {
+                    Vector3 p00(decimal(i), heights[i * (gridSize + 1) + j], decimal(j));
+                    Vector3 p10(decimal(i + 1), heights[(i + 1) * (gridSize + 1) + j], decimal(j));
+                    Vector3 p01(decimal(i), heights[i * (gridSize + 1) + j + 1], decimal(j + 1));
+                    Vector3 p11(decimal(i + 1), heights[(i + 1) * (gridSize + 1) + j + 1], decimal(j + 1));
+                    Vector3 triangle1[3] = {p00, p10, p11};
+                    Vector3 triangle2[3] = {p00, p11, p01};
+                    aabbs.push_back(AABB::createAABBForTriangle(triangle1));
+                    aabbs.push_back(AABB::createAABBForTriangle(triangle2));
+                }
+            }
+        }
+
+        /// Run the benchmark for a given size of the grid mesh
+        void runWithGridSize(uint gridSize) {
+
+            std::vector<AABB> aabbs;
+            createTriangles(gridSize, aabbs);
+            const uint nbTriangles = static_cast<uint>(aabbs.size());
+
+            std::ostringstream title;
+            title << nbTriangles << " triangles";
+            getOutputStream() << title.str() << std::endl;
+
+            // Queries (AABBs of small objects on the mesh and rays cast down on the mesh)
+            uint32 seed = 1357;
+            std::vector<AABB> queryAABBs;
+            std::vector<Ray> rays;
+            for (uint i=0; i<100000; i++) {
+                Vector3 position(random(seed) * gridSize, random(seed) * decimal(2.0), random(seed) * gridSize);
+                queryAABBs.push_back(AABB(position - Vector3(1, 1, 1), position + Vector3(1, 1, 1)));
+                rays.push_back(Ray(position + Vector3(0, 10, 0), position + Vector3(decimal(0.5), -10, 0)));
+            }
+
+            // ---------- DynamicAABBTree ---------- //
+
+            DynamicAABBTree dynamicTree;
+            double startTime = getCurrentTime();
+            for (uint i=0; i<nbTriangles; i++) dynamicTree.addObject(aabbs[i], 0, static_cast<int32>(i));
+            report("DynamicAABBTree : build", getCurrentTime() - startTime);
+
+            BenchmarkOverlapCallback dynamicOverlapCallback;
+            startTime = getCurrentTime();
+            for (uint i=0; i<queryAABBs.size(); i++) {
+                dynamicTree.reportAllShapesOverlappingWithAABB(queryAABBs[i], dynamicOverlapCallback);
+            }
+            report("DynamicAABBTree : AABB queries (100000)", getCurrentTime() - startTime);
+
+            BenchmarkRaycastCallback dynamicRaycastCallback;
+            startTime = getCurrentTime();
+            for (uint i=0; i<rays.size(); i++) dynamicTree.raycast(rays[i], dynamicRaycastCallback);
+            report("DynamicAABBTree : raycasts (100000)", getCurrentTime() - startTime);
+
+            // ---------- StaticAABBTree ---------- //
+
+            StaticAABBTree staticTree;
+            startTime = getCurrentTime();
+            for (uint i=0; i<nbTriangles; i++) staticTree.addObject(aabbs[i], 0, static_cast<int32>(i));
+            staticTree.build();
+            report("StaticAABBTree : build", getCurrentTime() - startTime);
+
+            BenchmarkOverlapCallback staticOverlapCallback;
+            startTime = getCurrentTime();
+            for (uint i=0; i<queryAABBs.size(); i++) {
+                staticTree.reportAllShapesOverlappingWithAABB(queryAABBs[i], staticOverlapCallback);
+            }
+            report("StaticAABBTree : AABB queries (100000)", getCurrentTime() - startTime);
+
+            BenchmarkRaycastCallback staticRaycastCallback;
+            startTime = getCurrentTime();
+            for (uint i=0; i<rays.size(); i++) staticTree.raycast(rays[i], staticRaycastCallback);
+            report("StaticAABBTree : raycasts (100000)", getCurrentTime() - startTime);
+
+            // Print the results so that the compiler cannot remove the measured code (the
+            // static tree can report a few more objects because of the quantized AABBs)
+            getOutputStream() << "  (overlaps " << dynamicOverlapCallback.nbOverlaps << " / "
+                              << staticOverlapCallback.nbOverlaps << ", ray hits "
+                              << dynamicRaycastCallback.nbHits << " / "
+                              << staticRaycastCallback.nbHits << ", static tree "
+                              << staticTree.getSizeInBytes() / 1024 << " KiB)" << std::endl;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        BenchmarkStaticAABBTree(const std::string& name) : Benchmark(name) {
+
+        }
+
+        /// Run the benchmark
+        virtual void run() {
+            runWithGridSize(100);
+            runWithGridSize(700);
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,67 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "Benchmark.h"
+#include "benchmarks/BenchmarkOverlappingPairs.h"
+#include "benchmarks/BenchmarkDynamicAABBTree.h"
+#include "benchmarks/BenchmarkStaticAABBTree.h"
+#include "benchmarks/BenchmarkBroadPhase.h"
+#include "benchmarks/BenchmarkNarrowPhase.h"
+#include <vector>
+#include <cstring>
+
+using namespace reactphysics3d;
+
+// Run the benchmarks. If names are given as arguments, only the
+// benchmarks with those names are run.
+int main(int argc, char** argv) {
+
+    std::vector<Benchmark*> benchmarks;
+    benchmarks.push_back(new BenchmarkOverlappingPairs("OverlappingPairs"));
+    benchmarks.push_back(new BenchmarkDynamicAABBTree("DynamicAABBTree"));
+    benchmarks.push_back(new BenchmarkStaticAABBTree("StaticAABBTree"));
+    benchmarks.push_back(new BenchmarkBroadPhase("BroadPhase"));
+    benchmarks.push_back(new BenchmarkNarrowPhase("NarrowPhase"));
+
+    for (uint i=0; i<benchmarks.size(); i++) {
+
+        // Check if the benchmark has been selected
+        bool isSelected = (argc < 2);
+        for (int a=1; a<argc; a++) {
+            if (std::strcmp(argv[a], benchmarks[i]->getName().c_str()) == 0) isSelected = true;
+        }
+
+        if (isSelected) {
+            std::cout << "---------- " << benchmarks[i]->getName() << " ----------" << std::endl;
+            benchmarks[i]->run();
+            std::cout << std::endl;
+        }
+
+        delete benchmarks[i];
+    }
+
+    return 0;
+}
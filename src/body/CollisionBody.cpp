@@ -249,6 +249,30 @@ void CollisionBody::setIsActive(bool isActive) {
     }
 }
 
+// Move the proxy shapes of the body into the broad-phase tree of its type
+/// The broad-phase ID of a proxy shape changes when it is moved into another tree.
+/// Therefore, the overlapping pairs of the proxy shape are destroyed and created
+/// again at the next broad-phase step.
+void CollisionBody::changeBroadPhaseTree() {
+
+    // For each proxy shape of the body
+    for (ProxyShape* shape = mProxyCollisionShapes; shape != NULL; shape = shape->mNext) {
+
+        // Remove the proxy shape from the collision detection
+        mWorld.mCollisionDetection.removeProxyCollisionShape(shape);
+
+        // Compute the world-space AABB of the collision shape
+        AABB aabb;
+        shape->getCollisionShape()->computeAABB(aabb, mTransform * shape->mLocalToBodyTransform);
+
+        // Add the proxy shape to the collision detection again
+        mWorld.mCollisionDetection.addProxyCollisionShape(shape, aabb);
+    }
+
+    // Reset the contact manifold list of the body
+    resetContactManifoldsList();
+}
+
 // Ask the broad-phase to test again the collision shapes of the body for collision
 // (as if the body has moved).
 void CollisionBody::askForBroadPhaseCollisionCheck() const {
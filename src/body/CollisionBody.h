@@ -109,6 +109,9 @@ class CollisionBody : public Body {
         /// (as if the body has moved).
         void askForBroadPhaseCollisionCheck() const;
 
+        /// Move the proxy shapes of the body into the broad-phase tree of its type
+        void changeBroadPhaseTree();
+
         /// Reset the mIsAlreadyInIsland variable of the body and contact manifolds
         int resetIsAlreadyInIslandAndCountManifolds();
 
@@ -180,6 +183,9 @@ class CollisionBody : public Body {
         friend class DynamicsWorld;
         friend class CollisionDetection;
         friend class BroadPhaseAlgorithm;
+        friend class AABBTreeAlgorithm;
+        friend class SweepAndPruneAlgorithm;
+        friend class SpatialHashAlgorithm;
         friend class ConvexMeshShape;
         friend class ProxyShape;
 };
@@ -202,16 +208,22 @@ inline BodyType CollisionBody::getType() const {
 /// DYNAMIC : A dynamic body has non-zero mass, non-zero velocity determined by forces and its
 ///           position is determined by the physics engine. A dynamic body can collide with other
 ///           dynamic, static or kinematic bodies.
+/// The proxy shapes of the bodies of each type are stored in different broad-phase
+/// trees. Therefore, the proxy shapes of the body are removed from the collision
+/// detection and added again when the type changes.
 /**
  * @param type The type of the body (STATIC, KINEMATIC, DYNAMIC)
  */
 inline void CollisionBody::setType(BodyType type) {
+
+    if (mType == type) return;
+
     mType = type;
 
-    if (mType == STATIC) {
+    if (mIsActive) {
 
-        // Update the broad-phase state of the body
-        updateBroadPhaseState();
+        // Move the proxy shapes into the broad-phase tree of the new type
+        changeBroadPhaseTree();
     }
 }
 
@@ -41,8 +41,8 @@ using namespace reactphysics3d;
 RigidBody::RigidBody(const Transform& transform, CollisionWorld& world, bodyindex id)
           : CollisionBody(transform, world, id), mInitMass(decimal(1.0)),
             mCenterOfMassLocal(0, 0, 0), mCenterOfMassWorld(transform.getPosition()),
-            mIsGravityEnabled(true), mLinearDamping(decimal(0.0)), mAngularDamping(decimal(0.0)),
-            mJointsList(NULL) {
+            mIsGravityEnabled(true), mIsCCDEnabled(false), mLinearDamping(decimal(0.0)), mAngularDamping(decimal(0.0)),
+            mJointsList(NULL), mArrayIndex(0) {
 
     // Compute the inverse mass
     mMassInverse = decimal(1.0) / mInitMass;
@@ -89,6 +89,9 @@ class RigidBody : public CollisionBody {
         /// True if the gravity needs to be applied to this rigid body
         bool mIsGravityEnabled;
 
+        /// True if the continuous collision detection is used for this rigid body
+        bool mIsCCDEnabled;
+
         /// Material properties of the rigid body
         Material mMaterial;
 
@@ -101,6 +104,10 @@ class RigidBody : public CollisionBody {
         /// First element of the linked list of joints involving this body
         JointListElement* mJointsList;        
 
+        /// Index of the body in the constrained velocities and positions arrays
+        /// of the world (assigned when the islands are computed)
+        uint mArrayIndex;
+
         // -------------------- Methods -------------------- //
 
         /// Private copy-constructor
@@ -176,6 +183,12 @@ class RigidBody : public CollisionBody {
         /// Set the variable to know if the gravity is applied to this rigid body
         void enableGravity(bool isEnabled);
 
+        /// Return true if the continuous collision detection is used for this rigid body
+        bool isCCDEnabled() const;
+
+        /// Set the variable to know if the continuous collision detection is used for this body
+        void enableCCD(bool isEnabled);
+
         /// Return a reference to the material properties of the rigid body
         Material& getMaterial();
 
@@ -315,6 +328,29 @@ inline void RigidBody::enableGravity(bool isEnabled) {
     mIsGravityEnabled = isEnabled;
 }
 
+// Return true if the continuous collision detection is used for this rigid body
+/**
+ * @return True if the motion of the body is clamped at its time of impact
+ */
+inline bool RigidBody::isCCDEnabled() const {
+    return mIsCCDEnabled;
+}
+
+// Set the variable to know if the continuous collision detection is used for this body
+/// With the continuous collision detection, the motion of a fast body during a step is
+/// swept against the other collision shapes and stopped at the first time of impact, so
+/// that the body cannot pass through thin shapes (like the walls of a concave mesh). It
+/// should only be enabled for a few small and fast bodies (projectiles for instance)
+/// because it is much more expensive than the discrete collision detection. Only the
+/// convex collision shapes of the body are swept and the other bodies do not move
+/// during the sweep.
+/**
+ * @param isEnabled True if you want the continuous collision detection for this body
+ */
+inline void RigidBody::enableCCD(bool isEnabled) {
+    mIsCCDEnabled = isEnabled;
+}
+
 // Return a reference to the material properties of the rigid body
 /**
  * @return A reference to the material of the body
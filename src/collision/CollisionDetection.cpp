@@ -26,11 +26,14 @@
 // Libraries
 #include "CollisionDetection.h"
 #include "engine/CollisionWorld.h"
+#include "broadphase/SweepAndPruneAlgorithm.h"
 #include "body/Body.h"
 #include "collision/shapes/BoxShape.h"
+#include "collision/shapes/TriangleShape.h"
 #include "body/RigidBody.h"
 #include "configuration.h"
 #include <cassert>
+#include <algorithm>
 #include <complex>
 #include <set>
 #include <utility>
@@ -41,11 +44,32 @@ using namespace reactphysics3d;
 using namespace std;
 
 // Constructor
-CollisionDetection::CollisionDetection(CollisionWorld* world, MemoryAllocator& memoryAllocator)
+/**
+ * @param world Pointer to the world
+ * @param memoryAllocator Memory allocator of the world
+ * @param broadPhaseType Algorithm used by the broad-phase collision detection
+ */
+CollisionDetection::CollisionDetection(CollisionWorld* world, MemoryAllocator& memoryAllocator,
+                                       BroadPhaseType broadPhaseType)
                    : mMemoryAllocator(memoryAllocator),
-                     mWorld(world), mBroadPhaseAlgorithm(*this),
+                     mWorld(world), mBroadPhaseAlgorithm(NULL), mBroadPhaseType(broadPhaseType),
                      mIsCollisionShapesAdded(false) {
 
+    // Create the broad-phase algorithm
+    switch (broadPhaseType) {
+        case SWEEP_AND_PRUNE:
+            mBroadPhaseAlgorithm = new SweepAndPruneAlgorithm(*this);
+            break;
+        case SPATIAL_HASH:
+            mBroadPhaseAlgorithm = new SpatialHashAlgorithm(*this);
+            break;
+        case DYNAMIC_AABB_TREE:
+        default:
+            mBroadPhaseType = DYNAMIC_AABB_TREE;
+            mBroadPhaseAlgorithm = new AABBTreeAlgorithm(*this);
+            break;
+    }
+
     // Set the default collision dispatch configuration
     setCollisionDispatch(&mDefaultCollisionDispatch);
 
@@ -56,6 +80,13 @@ CollisionDetection::CollisionDetection(CollisionWorld* world, MemoryAllocator& m
 // Destructor
 CollisionDetection::~CollisionDetection() {
 
+    // Delete the collision dispatches of the threads
+    for (uint i=0; i<mThreadCollisionDispatches.size(); i++) {
+        delete mThreadCollisionDispatches[i];
+    }
+
+    // Delete the broad-phase algorithm
+    delete mBroadPhaseAlgorithm;
 }
 
 // Compute the collision detection
@@ -91,10 +122,9 @@ void CollisionDetection::reportCollisionBetweenShapes(CollisionCallback* callbac
                                                       const std::set<uint>& shapes2) {
 
     // For each possible collision pair of bodies
-    map<overlappingpairid, OverlappingPair*>::iterator it;
-    for (it = mOverlappingPairs.begin(); it != mOverlappingPairs.end(); ++it) {
+    for (uint p=0; p < mOverlappingPairs.getNbPairs(); p++) {
 
-        OverlappingPair* pair = it->second;
+        OverlappingPair* pair = mOverlappingPairs.getPair(p);
 
         const ProxyShape* shape1 = pair->getShape1();
         const ProxyShape* shape2 = pair->getShape2();
@@ -157,23 +187,33 @@ void CollisionDetection::computeBroadPhase() {
         // Ask the broad-phase to recompute the overlapping pairs of collision
         // shapes. This call can only add new overlapping pairs in the collision
         // detection.
-        mBroadPhaseAlgorithm.computeOverlappingPairs();
+        mBroadPhaseAlgorithm->computeOverlappingPairs(mWorld->mThreadPool);
     }
 }
 
 // Compute the narrow-phase collision detection
+/// The overlapping pairs are first filtered on the calling thread. Then, the
+/// remaining pairs are tested concurrently with the thread pool of the world. Each
+/// thread stores the contacts it finds in its own contact buffer. Finally, the contacts
+/// are added into the overlapping pairs in the order of the pairs so that the result
+/// does not depend on the number of threads.
 void CollisionDetection::computeNarrowPhase() {
 
     PROFILE("CollisionDetection::computeNarrowPhase()");
 
     // Clear the set of overlapping pairs in narrow-phase contact
     mContactOverlappingPairs.clear();
-    
-    // For each possible collision pair of bodies
-    map<overlappingpairid, OverlappingPair*>::iterator it;
-    for (it = mOverlappingPairs.begin(); it != mOverlappingPairs.end(); ) {
 
-        OverlappingPair* pair = it->second;
+    mNarrowPhaseItems.clear();
+
+    // Only the default collision dispatch can be duplicated for the worker threads
+    const bool isDispatchParallel = (mCollisionDispatch == &mDefaultCollisionDispatch);
+
+    // For each possible collision pair of bodies. When a pair is destroyed, the last
+    // pair of the array is moved at the current index and is tested next.
+    for (uint p=0; p < mOverlappingPairs.getNbPairs(); ) {
+
+        OverlappingPair* pair = mOverlappingPairs.getPair(p);
 
         ProxyShape* shape1 = pair->getShape1();
         ProxyShape* shape2 = pair->getShape2();
@@ -185,21 +225,18 @@ void CollisionDetection::computeNarrowPhase() {
         // overlapping pair
         if (((shape1->getCollideWithMaskBits() & shape2->getCollisionCategoryBits()) == 0 ||
              (shape1->getCollisionCategoryBits() & shape2->getCollideWithMaskBits()) == 0) ||
-             !mBroadPhaseAlgorithm.testOverlappingShapes(shape1, shape2)) {
-
-            std::map<overlappingpairid, OverlappingPair*>::iterator itToRemove = it;
-            ++it;
+             !mBroadPhaseAlgorithm->testOverlappingShapes(shape1, shape2)) {
 
             // TODO : Remove all the contact manifold of the overlapping pair from the contact manifolds list of the two bodies involved
 
             // Destroy the overlapping pair
-            itToRemove->second->~OverlappingPair();
-            mWorld->mMemoryAllocator.release(itToRemove->second, sizeof(OverlappingPair));
-            mOverlappingPairs.erase(itToRemove);
+            mOverlappingPairs.remove(OverlappingPair::computeID(shape1, shape2));
+            pair->~OverlappingPair();
+            mWorld->mMemoryAllocator.release(pair, sizeof(OverlappingPair));
             continue;
         }
         else {
-            ++it;
+            ++p;
         }
 
         CollisionBody* const body1 = shape1->getBody();
@@ -217,31 +254,143 @@ void CollisionDetection::computeNarrowPhase() {
         bodyindexpair bodiesIndex = OverlappingPair::computeBodiesIndexPair(body1, body2);
         if (mNoCollisionPairs.count(bodiesIndex) > 0) continue;
         
-        // Select the narrow phase algorithm to use according to the two collision shapes
+        // If there is no collision algorithm between those two kinds of shapes
         const CollisionShapeType shape1Type = shape1->getCollisionShape()->getType();
         const CollisionShapeType shape2Type = shape2->getCollisionShape()->getType();
-        NarrowPhaseAlgorithm* narrowPhaseAlgorithm = mCollisionMatrix[shape1Type][shape2Type];
+        if (mCollisionMatrix[shape1Type][shape2Type] == NULL) continue;
+
+        // Add the pair to the pairs to test. The data cached between two collision tests
+        // (e.g. the last support vertex of a convex mesh) is stored in the pair and not in
+        // the proxy shapes, so that the pairs can be tested concurrently.
+        NarrowPhaseItem item;
+        item.pair = pair;
+        item.isParallel = isDispatchParallel;
+        item.threadIndex = 0;
+        item.firstContact = 0;
+        item.nbContacts = 0;
+        mNarrowPhaseItems.push_back(item);
+    }
 
-        // If there is no collision algorithm between those two kinds of shapes
-        if (narrowPhaseAlgorithm == NULL) continue;
-        
-        // Notify the narrow-phase algorithm about the overlapping pair we are going to test
-        narrowPhaseAlgorithm->setCurrentOverlappingPair(pair);
+    const uint nbItems = static_cast<uint>(mNarrowPhaseItems.size());
 
-        // Create the CollisionShapeInfo objects
-        CollisionShapeInfo shape1Info(shape1, shape1->getCollisionShape(), shape1->getLocalToWorldTransform(),
-                                      pair, shape1->getCachedCollisionData());
-        CollisionShapeInfo shape2Info(shape2, shape2->getCollisionShape(), shape2->getLocalToWorldTransform(),
-                                      pair, shape2->getCachedCollisionData());
-        
-        // Use the narrow-phase collision detection algorithm to check
-        // if there really is a collision. If a collision occurs, the
-        // notifyContact() callback method will be called.
-        narrowPhaseAlgorithm->testCollision(shape1Info, shape2Info, this);
+    // Create the collision dispatches and contact buffers of the threads
+    initThreadNarrowPhase(mWorld->mThreadPool.getNbThreads());
+
+    // Test the pairs that can be tested concurrently
+    NarrowPhaseTask narrowPhaseTask(*this);
+    mWorld->mThreadPool.parallelFor(nbItems, narrowPhaseTask);
+
+    // Test the other pairs on the calling thread
+    for (uint i=0; i<nbItems; i++) {
+        if (!mNarrowPhaseItems[i].isParallel) {
+            testNarrowPhaseItem(0, i);
+        }
+    }
+
+    // Add the contacts into the overlapping pairs (in the order of the pairs)
+    for (uint i=0; i<nbItems; i++) {
+
+        const NarrowPhaseItem& item = mNarrowPhaseItems[i];
+        const std::vector<ContactPointInfo>& contacts = mThreadContactBuffers[item.threadIndex].contacts;
+
+        for (uint c=item.firstContact; c < item.firstContact + item.nbContacts; c++) {
+            notifyContact(item.pair, contacts[c]);
+        }
+
+        // Remove the contacts between features that are not in contact anymore
+        item.pair->removeObsoleteContacts();
     }
 
     // Add all the contact manifolds (between colliding bodies) to the bodies
     addAllContactManifoldsToBodies();
+
+    // Keep the counters of the EPA algorithm of this narrow-phase
+    updateEPAStatistics();
+}
+
+// Collect the counters of the EPA algorithm of all the collision dispatches
+/// The counters of each dispatch are reset so that the next narrow-phase starts from zero.
+/// A custom collision dispatch set by the user does not report any counter.
+void CollisionDetection::updateEPAStatistics() {
+
+    mLastStepEPAStatistics = mDefaultCollisionDispatch.getEPAStatistics();
+    mDefaultCollisionDispatch.resetEPAStatistics();
+
+    for (uint i=0; i<mThreadCollisionDispatches.size(); i++) {
+        mLastStepEPAStatistics.add(mThreadCollisionDispatches[i]->getEPAStatistics());
+        mThreadCollisionDispatches[i]->resetEPAStatistics();
+    }
+}
+
+// Create the collision dispatches and contact buffers of the threads
+void CollisionDetection::initThreadNarrowPhase(uint nbThreads) {
+
+    // Create the missing collision dispatches of the worker threads
+    while (mThreadCollisionDispatches.size() + 1 < nbThreads) {
+        DefaultCollisionDispatch* dispatch = new DefaultCollisionDispatch();
+        dispatch->init(this, &mMemoryAllocator);
+        mThreadCollisionDispatches.push_back(dispatch);
+    }
+
+    // Create the missing contact buffers and clear the contacts of the previous frame
+    if (mThreadContactBuffers.size() < nbThreads) {
+        mThreadContactBuffers.resize(nbThreads);
+    }
+    for (uint i=0; i<mThreadContactBuffers.size(); i++) {
+        mThreadContactBuffers[i].contacts.clear();
+    }
+}
+
+// Test the overlapping pair of a narrow-phase item
+/// The contacts found are stored in the contact buffer of the thread
+void CollisionDetection::testNarrowPhaseItem(uint threadIndex, uint itemIndex) {
+
+    NarrowPhaseItem& item = mNarrowPhaseItems[itemIndex];
+    OverlappingPair* pair = item.pair;
+    ProxyShape* shape1 = pair->getShape1();
+    ProxyShape* shape2 = pair->getShape2();
+
+    // Select the narrow phase algorithm to use according to the two collision shapes
+    const CollisionShapeType shape1Type = shape1->getCollisionShape()->getType();
+    const CollisionShapeType shape2Type = shape2->getCollisionShape()->getType();
+    NarrowPhaseAlgorithm* narrowPhaseAlgorithm;
+    if (threadIndex == 0) {
+        narrowPhaseAlgorithm = mCollisionMatrix[shape1Type][shape2Type];
+    }
+    else {
+        narrowPhaseAlgorithm = mThreadCollisionDispatches[threadIndex - 1]->selectAlgorithm(shape1Type,
+                                                                                            shape2Type);
+    }
+    assert(narrowPhaseAlgorithm != NULL);
+
+    NarrowPhaseContactBuffer& contactBuffer = mThreadContactBuffers[threadIndex];
+    item.threadIndex = threadIndex;
+    item.firstContact = static_cast<uint>(contactBuffer.contacts.size());
+
+    // Notify the narrow-phase algorithm about the overlapping pair we are going to test
+    narrowPhaseAlgorithm->setCurrentOverlappingPair(pair);
+
+    // Create the CollisionShapeInfo objects
+    CollisionShapeInfo shape1Info(shape1, shape1->getCollisionShape(), shape1->getLocalToWorldTransform(),
+                                  pair, pair->getCachedCollisionData1());
+    CollisionShapeInfo shape2Info(shape2, shape2->getCollisionShape(), shape2->getLocalToWorldTransform(),
+                                  pair, pair->getCachedCollisionData2());
+
+    // Use the narrow-phase collision detection algorithm to check
+    // if there really is a collision. If a collision occurs, the contact
+    // is stored in the contact buffer of the thread.
+    narrowPhaseAlgorithm->testCollision(shape1Info, shape2Info, &contactBuffer);
+
+    item.nbContacts = static_cast<uint>(contactBuffer.contacts.size()) - item.firstContact;
+}
+
+// Test the overlapping pair of a given item
+void NarrowPhaseTask::execute(uint threadIndex, uint itemIndex) {
+
+    // The pairs that cannot be tested concurrently are tested after the task
+    if (mCollisionDetection.mNarrowPhaseItems[itemIndex].isParallel) {
+        mCollisionDetection.testNarrowPhaseItem(threadIndex, itemIndex);
+    }
 }
 
 // Compute the narrow-phase collision detection
@@ -251,11 +400,11 @@ void CollisionDetection::computeNarrowPhaseBetweenShapes(CollisionCallback* call
 
     mContactOverlappingPairs.clear();
 
-    // For each possible collision pair of bodies
-    map<overlappingpairid, OverlappingPair*>::iterator it;
-    for (it = mOverlappingPairs.begin(); it != mOverlappingPairs.end(); ) {
+    // For each possible collision pair of bodies. When a pair is destroyed, the last
+    // pair of the array is moved at the current index and is tested next.
+    for (uint p=0; p < mOverlappingPairs.getNbPairs(); ) {
 
-        OverlappingPair* pair = it->second;
+        OverlappingPair* pair = mOverlappingPairs.getPair(p);
 
         ProxyShape* shape1 = pair->getShape1();
         ProxyShape* shape2 = pair->getShape2();
@@ -267,19 +416,19 @@ void CollisionDetection::computeNarrowPhaseBetweenShapes(CollisionCallback* call
         if (!shapes1.empty() && !shapes2.empty() &&
             (shapes1.count(shape1->mBroadPhaseID) == 0 || shapes2.count(shape2->mBroadPhaseID) == 0) &&
             (shapes1.count(shape2->mBroadPhaseID) == 0 || shapes2.count(shape1->mBroadPhaseID) == 0)) {
-            ++it;
+            ++p;
             continue;
         }
         if (!shapes1.empty() && shapes2.empty() &&
             shapes1.count(shape1->mBroadPhaseID) == 0 && shapes1.count(shape2->mBroadPhaseID) == 0)
         {
-            ++it;
+            ++p;
             continue;
         }
         if (!shapes2.empty() && shapes1.empty() &&
             shapes2.count(shape1->mBroadPhaseID) == 0 && shapes2.count(shape2->mBroadPhaseID) == 0)
         {
-            ++it;
+            ++p;
             continue;
         }
 
@@ -288,21 +437,18 @@ void CollisionDetection::computeNarrowPhaseBetweenShapes(CollisionCallback* call
         // overlapping pair
         if (((shape1->getCollideWithMaskBits() & shape2->getCollisionCategoryBits()) == 0 ||
              (shape1->getCollisionCategoryBits() & shape2->getCollideWithMaskBits()) == 0) ||
-             !mBroadPhaseAlgorithm.testOverlappingShapes(shape1, shape2)) {
-
-            std::map<overlappingpairid, OverlappingPair*>::iterator itToRemove = it;
-            ++it;
+             !mBroadPhaseAlgorithm->testOverlappingShapes(shape1, shape2)) {
 
             // TODO : Remove all the contact manifold of the overlapping pair from the contact manifolds list of the two bodies involved
 
             // Destroy the overlapping pair
-            itToRemove->second->~OverlappingPair();
-            mWorld->mMemoryAllocator.release(itToRemove->second, sizeof(OverlappingPair));
-            mOverlappingPairs.erase(itToRemove);
+            mOverlappingPairs.remove(OverlappingPair::computeID(shape1, shape2));
+            pair->~OverlappingPair();
+            mWorld->mMemoryAllocator.release(pair, sizeof(OverlappingPair));
             continue;
         }
         else {
-            ++it;
+            ++p;
         }
 
         CollisionBody* const body1 = shape1->getBody();
@@ -332,9 +478,9 @@ void CollisionDetection::computeNarrowPhaseBetweenShapes(CollisionCallback* call
 
         // Create the CollisionShapeInfo objects
         CollisionShapeInfo shape1Info(shape1, shape1->getCollisionShape(), shape1->getLocalToWorldTransform(),
-                                      pair, shape1->getCachedCollisionData());
+                                      pair, pair->getCachedCollisionData1());
         CollisionShapeInfo shape2Info(shape2, shape2->getCollisionShape(), shape2->getLocalToWorldTransform(),
-                                      pair, shape2->getCachedCollisionData());
+                                      pair, pair->getCachedCollisionData2());
 
         TestCollisionBetweenShapesCallback narrowPhaseCallback(callback);
 
@@ -345,6 +491,224 @@ void CollisionDetection::computeNarrowPhaseBetweenShapes(CollisionCallback* call
 
     // Add all the contact manifolds (between colliding bodies) to the bodies
     addAllContactManifoldsToBodies();
+
+    // Keep the counters of the EPA algorithm of this narrow-phase
+    updateEPAStatistics();
+}
+
+// Compute the time of impact of a moving convex shape with a static proxy shape
+/// The convex shapes are tested with the conservative advancement of the GJK algorithm.
+/// The moving shape is tested against each triangle of a concave shape that overlaps
+/// with its swept AABB.
+/**
+ * @param motion Motion of the convex shape during the time interval [0, 1]
+ * @param proxyShape Static proxy shape
+ * @param targetPenetrationDepth Penetration depth of the shapes (with their margins) at
+ *                               the time of impact (at most half the sum of the margins)
+ * @param isInitialContactIgnored True if a contact at the beginning of the motion (time
+ *                                zero) is not reported as a hit
+ * @param[out] timeOfImpact Time of impact in [0, 1]
+ * @param[out] normal Unit direction (in world-space) from the moving shape to the proxy
+ *                    shape at the time of impact
+ * @param[out] point Closest point (in world-space) of the proxy shape at the time of impact
+ * @return True if the moving shape hits the proxy shape during the motion
+ */
+bool CollisionDetection::computeTimeOfImpact(const ConvexShapeMotion& motion, ProxyShape* proxyShape,
+                                             decimal targetPenetrationDepth,
+                                             bool isInitialContactIgnored, decimal& timeOfImpact,
+                                             Vector3& normal, Vector3& point) const {
+
+    const CollisionShape* collisionShape = proxyShape->getCollisionShape();
+    const Transform& shapeTransform = proxyShape->getLocalToWorldTransform();
+
+    if (collisionShape->isConvex()) {
+
+        const ConvexShape* convexShape = static_cast<const ConvexShape*>(collisionShape);
+        const decimal targetDistance = -std::min(targetPenetrationDepth, decimal(0.5) *
+                                                 (motion.shape->getMargin() + convexShape->getMargin()));
+
+        const bool isHit = mNarrowPhaseGJKAlgorithm.computeTimeOfImpact(motion, convexShape, shapeTransform,
+                                                            proxyShape->getCachedCollisionData(),
+                                                            targetDistance, timeOfImpact, normal, point);
+
+        return isHit && !(isInitialContactIgnored && timeOfImpact == decimal(0.0));
+    }
+
+    const ConcaveShape* concaveShape = static_cast<const ConcaveShape*>(collisionShape);
+
+    // Compute the swept AABB of the convex shape in the local-space of the concave shape
+    AABB sweptAABB;
+    motion.computeSweptAABB(sweptAABB, shapeTransform.getInverse());
+
+    // Test the triangles that overlap with the swept AABB
+    TimeOfImpactTriangleCallback triangleCallback(mNarrowPhaseGJKAlgorithm, motion, shapeTransform,
+                                                  concaveShape->getTriangleMargin(),
+                                                  targetPenetrationDepth, isInitialContactIgnored);
+    concaveShape->testAllTriangles(triangleCallback, sweptAABB);
+
+    if (!triangleCallback.isHit()) return false;
+
+    timeOfImpact = triangleCallback.getTimeOfImpact();
+    normal = triangleCallback.getNormal();
+    point = triangleCallback.getPoint();
+
+    return true;
+}
+
+// Compute the first time of impact of a proxy shape whose body moves between two transforms
+/// This method is used by the continuous collision detection. The swept AABB of the
+/// shape is used to query the broad-phase and the shape is tested against all the
+/// shapes that can collide with it (with their current transforms). The shapes that
+/// are already in contact at the beginning of the motion are ignored because their
+/// contacts are handled by the discrete collision detection. Only a convex shape
+/// can be tested.
+/**
+ * @param proxyShape Moving proxy shape
+ * @param fromTransform Transform of the body at the beginning of the motion
+ * @param toTransform Transform of the body at the end of the motion
+ * @param[out] timeOfImpact First time of impact in [0, 1]
+ * @return True if the proxy shape hits another shape during the motion
+ */
+bool CollisionDetection::computeFirstTimeOfImpact(ProxyShape* proxyShape, const Transform& fromTransform,
+                                                  const Transform& toTransform, decimal& timeOfImpact) {
+
+    PROFILE("CollisionDetection::computeFirstTimeOfImpact()");
+
+    if (!proxyShape->getCollisionShape()->isConvex()) return false;
+
+    const ConvexShapeMotion motion(static_cast<const ConvexShape*>(proxyShape->getCollisionShape()),
+                                   proxyShape->getCachedCollisionData(), fromTransform, toTransform,
+                                   proxyShape->getLocalToBodyTransform());
+
+    // Find the shapes that overlap with the swept AABB of the shape
+    AABB sweptAABB;
+    motion.computeSweptAABB(sweptAABB, Transform::identity());
+    std::vector<ProxyShape*> overlappingShapes;
+    reportShapesOverlappingWithAABB(sweptAABB, overlappingShapes);
+
+    const CollisionBody* body = proxyShape->getBody();
+    const CollisionShapeType shapeType = proxyShape->getCollisionShape()->getType();
+    bool isHit = false;
+    timeOfImpact = decimal(1.0);
+
+    for (uint i=0; i<overlappingShapes.size(); i++) {
+
+        ProxyShape* otherShape = overlappingShapes[i];
+        const CollisionBody* otherBody = otherShape->getBody();
+
+        // Check that the shapes can collide with each other
+        if (otherBody->getID() == body->getID() || !otherBody->isActive()) continue;
+        if ((proxyShape->getCollideWithMaskBits() & otherShape->getCollisionCategoryBits()) == 0 ||
+            (proxyShape->getCollisionCategoryBits() & otherShape->getCollideWithMaskBits()) == 0) continue;
+        if (mCollisionMatrix[shapeType][otherShape->getCollisionShape()->getType()] == NULL) continue;
+        const bodyindexpair bodiesIndex = OverlappingPair::computeBodiesIndexPair(
+                                                    const_cast<CollisionBody*>(body),
+                                                    const_cast<CollisionBody*>(otherBody));
+        if (mNoCollisionPairs.count(bodiesIndex) > 0) continue;
+
+        decimal shapeTimeOfImpact;
+        Vector3 normal;
+        Vector3 point;
+        if (computeTimeOfImpact(motion, otherShape, CCD_TARGET_PENETRATION_DEPTH, true,
+                                shapeTimeOfImpact, normal, point) && shapeTimeOfImpact < timeOfImpact) {
+            timeOfImpact = shapeTimeOfImpact;
+            isHit = true;
+        }
+    }
+
+    return isHit;
+}
+
+// Convex casting method
+/// The swept AABB of the shape is used to query the broad-phase and the time of impact
+/// with each candidate shape is computed with the conservative advancement algorithm.
+/// The motion of the shape is clipped by the fraction returned by the callback.
+/**
+ * @param convexCastCallback Pointer to the class with the callback method
+ * @param shape Convex shape to cast
+ * @param fromTransform Local-to-world transform of the shape at the beginning of the motion
+ * @param toTransform Local-to-world transform of the shape at the end of the motion
+ * @param convexCastWithCategoryMaskBits Bits mask corresponding to the category of
+ *                                       bodies to be hit by the shape
+ */
+void CollisionDetection::convexCast(ConvexCastCallback* convexCastCallback, const ConvexShape* shape,
+                                    const Transform& fromTransform, const Transform& toTransform,
+                                    unsigned short convexCastWithCategoryMaskBits) const {
+
+    PROFILE("CollisionDetection::convexCast()");
+
+    void* cachedCollisionData = NULL;
+    const ConvexShapeMotion motion(shape, &cachedCollisionData, fromTransform, toTransform,
+                                   Transform::identity());
+
+    // Find the shapes that overlap with the swept AABB of the shape
+    AABB sweptAABB;
+    motion.computeSweptAABB(sweptAABB, Transform::identity());
+    std::vector<ProxyShape*> overlappingShapes;
+    reportShapesOverlappingWithAABB(sweptAABB, overlappingShapes);
+
+    decimal maxFraction = decimal(1.0);
+
+    for (uint i=0; i<overlappingShapes.size() && maxFraction > decimal(0.0); i++) {
+
+        ProxyShape* otherShape = overlappingShapes[i];
+        if ((otherShape->getCollisionCategoryBits() & convexCastWithCategoryMaskBits) == 0 ||
+            !otherShape->getBody()->isActive()) continue;
+
+        // Compute the time of impact during the motion clipped by the previous hits
+        const ConvexShapeMotion clippedMotion(shape, &cachedCollisionData, fromTransform,
+                                              motion.getBodyTransform(maxFraction),
+                                              Transform::identity());
+        decimal timeOfImpact;
+        ConvexCastInfo convexCastInfo;
+        if (!computeTimeOfImpact(clippedMotion, otherShape, decimal(0.0), false, timeOfImpact,
+                                 convexCastInfo.worldNormal, convexCastInfo.worldPoint)) continue;
+
+        // Report the hit to the user and clip the motion with the returned fraction
+        convexCastInfo.worldNormal = -convexCastInfo.worldNormal;
+        convexCastInfo.hitFraction = timeOfImpact * maxFraction;
+        convexCastInfo.body = otherShape->getBody();
+        convexCastInfo.proxyShape = otherShape;
+        const decimal fraction = convexCastCallback->notifyConvexCastHit(convexCastInfo);
+        if (fraction >= decimal(0.0) && fraction < maxFraction) {
+            maxFraction = fraction;
+        }
+    }
+
+    // Release the collision data cached by the shape
+    if (cachedCollisionData != NULL) {
+        free(cachedCollisionData);
+    }
+}
+
+// Compute the time of impact with a triangle of the concave shape
+void TimeOfImpactTriangleCallback::testTriangle(const Vector3* trianglePoints) {
+
+    TriangleShape triangleShape(trianglePoints[0], trianglePoints[1], trianglePoints[2],
+                                mTriangleMargin);
+    void* triangleCachedCollisionData = NULL;
+
+    const decimal targetDistance = -std::min(mTargetPenetrationDepth, decimal(0.5) *
+                                             (mMotion.shape->getMargin() + mTriangleMargin));
+
+    decimal timeOfImpact;
+    Vector3 normal;
+    Vector3 point;
+    if (mGJKAlgorithm.computeTimeOfImpact(mMotion, &triangleShape, mConcaveTransform,
+                                          &triangleCachedCollisionData, targetDistance,
+                                          timeOfImpact, normal, point)) {
+
+        // A triangle can be already in contact at the beginning of the motion while
+        // the shape moves toward another triangle of the concave shape
+        if (mIsInitialContactIgnored && timeOfImpact == decimal(0.0)) return;
+
+        if (!mIsHit || timeOfImpact < mTimeOfImpact) {
+            mTimeOfImpact = timeOfImpact;
+            mNormal = normal;
+            mPoint = point;
+            mIsHit = true;
+        }
+    }
 }
 
 // Allow the broadphase to notify the collision detection about an overlapping pair.
@@ -364,7 +728,7 @@ void CollisionDetection::broadPhaseNotifyOverlappingPair(ProxyShape* shape1, Pro
     overlappingpairid pairID = OverlappingPair::computeID(shape1, shape2);
 
     // Check if the overlapping pair already exists
-    if (mOverlappingPairs.find(pairID) != mOverlappingPairs.end()) return;
+    if (mOverlappingPairs.find(pairID) != NULL) return;
 
     // Compute the maximum number of contact manifolds for this pair
     int nbMaxManifolds = CollisionShape::computeNbMaxContactManifolds(shape1->getCollisionShape()->getType(),
@@ -372,14 +736,14 @@ void CollisionDetection::broadPhaseNotifyOverlappingPair(ProxyShape* shape1, Pro
 
     // Create the overlapping pair and add it into the set of overlapping pairs
     OverlappingPair* newPair = new (mWorld->mMemoryAllocator.allocate(sizeof(OverlappingPair)))
-                              OverlappingPair(shape1, shape2, nbMaxManifolds, mWorld->mMemoryAllocator);
+                              OverlappingPair(shape1, shape2, nbMaxManifolds, mContactManifoldPool);
     assert(newPair != NULL);
 
 #ifndef NDEBUG
-    std::pair<map<overlappingpairid, OverlappingPair*>::iterator, bool> check =
+    bool isAdded =
 #endif
-    mOverlappingPairs.insert(make_pair(pairID, newPair));
-    assert(check.second);
+    mOverlappingPairs.add(pairID, newPair);
+    assert(isAdded);
 
     // Wake up the two bodies
     shape1->getBody()->setIsSleeping(false);
@@ -390,27 +754,61 @@ void CollisionDetection::broadPhaseNotifyOverlappingPair(ProxyShape* shape1, Pro
 void CollisionDetection::removeProxyCollisionShape(ProxyShape* proxyShape) {
 
     // Remove all the overlapping pairs involving this proxy shape
-    std::map<overlappingpairid, OverlappingPair*>::iterator it;
-    for (it = mOverlappingPairs.begin(); it != mOverlappingPairs.end(); ) {
-        if (it->second->getShape1()->mBroadPhaseID == proxyShape->mBroadPhaseID||
-            it->second->getShape2()->mBroadPhaseID == proxyShape->mBroadPhaseID) {
-            std::map<overlappingpairid, OverlappingPair*>::iterator itToRemove = it;
-            ++it;
+    for (uint p=0; p < mOverlappingPairs.getNbPairs(); ) {
+        OverlappingPair* pair = mOverlappingPairs.getPair(p);
+        if (pair->getShape1()->mBroadPhaseID == proxyShape->mBroadPhaseID||
+            pair->getShape2()->mBroadPhaseID == proxyShape->mBroadPhaseID) {
 
             // TODO : Remove all the contact manifold of the overlapping pair from the contact manifolds list of the two bodies involved
 
-            // Destroy the overlapping pair
-            itToRemove->second->~OverlappingPair();
-            mWorld->mMemoryAllocator.release(itToRemove->second, sizeof(OverlappingPair));
-            mOverlappingPairs.erase(itToRemove);
+            // Destroy the overlapping pair (the last pair is moved at the current index)
+            mOverlappingPairs.remove(OverlappingPair::computeID(pair->getShape1(),
+                                                                pair->getShape2()));
+            pair->~OverlappingPair();
+            mWorld->mMemoryAllocator.release(pair, sizeof(OverlappingPair));
         }
         else {
-            ++it;
+            ++p;
         }
     }
 
     // Remove the body from the broad-phase
-    mBroadPhaseAlgorithm.removeProxyCollisionShape(proxyShape);
+    mBroadPhaseAlgorithm->removeProxyCollisionShape(proxyShape);
+}
+
+// Remove many proxy collision shapes from the collision detection at once
+/// The overlapping pairs are traversed only once for all the shapes (instead of once
+/// per removed shape) which makes it possible to destroy a large number of bodies.
+/**
+ * @param proxyShapes The proxy shapes to remove (the array is sorted by this method)
+ */
+void CollisionDetection::removeProxyCollisionShapes(std::vector<ProxyShape*>& proxyShapes) {
+
+    PROFILE("CollisionDetection::removeProxyCollisionShapes()");
+
+    std::sort(proxyShapes.begin(), proxyShapes.end());
+
+    // Remove all the overlapping pairs involving one of the proxy shapes
+    for (uint p=0; p < mOverlappingPairs.getNbPairs(); ) {
+        OverlappingPair* pair = mOverlappingPairs.getPair(p);
+        if (std::binary_search(proxyShapes.begin(), proxyShapes.end(), pair->getShape1()) ||
+            std::binary_search(proxyShapes.begin(), proxyShapes.end(), pair->getShape2())) {
+
+            // Destroy the overlapping pair (the last pair is moved at the current index)
+            mOverlappingPairs.remove(OverlappingPair::computeID(pair->getShape1(),
+                                                                pair->getShape2()));
+            pair->~OverlappingPair();
+            mWorld->mMemoryAllocator.release(pair, sizeof(OverlappingPair));
+        }
+        else {
+            ++p;
+        }
+    }
+
+    // Remove the shapes from the broad-phase
+    for (uint i=0; i<proxyShapes.size(); i++) {
+        mBroadPhaseAlgorithm->removeProxyCollisionShape(proxyShapes[i]);
+    }
 }
 
 // Called by a narrow-phase collision algorithm when a new contact has been found
@@ -434,28 +832,24 @@ void CollisionDetection::notifyContact(OverlappingPair* overlappingPair, const C
 void CollisionDetection::createContact(OverlappingPair* overlappingPair,
                                        const ContactPointInfo& contactInfo) {
 
-    // Create a new contact
-    ContactPoint* contact = new (mWorld->mMemoryAllocator.allocate(sizeof(ContactPoint)))
-                                 ContactPoint(contactInfo);
-
-    // Add the contact to the contact manifold set of the corresponding overlapping pair
-    overlappingPair->addContact(contact);
+    // Add the contact to the contact manifold set of the corresponding overlapping pair.
+    // The contact point is created inside a contact manifold of the pair.
+    overlappingPair->addContact(contactInfo);
 
     // Add the overlapping pair into the set of pairs in contact during narrow-phase
     overlappingpairid pairId = OverlappingPair::computeID(overlappingPair->getShape1(),
                                                           overlappingPair->getShape2());
-    mContactOverlappingPairs[pairId] = overlappingPair;
+    mContactOverlappingPairs.add(pairId, overlappingPair);
 }
 
 void CollisionDetection::addAllContactManifoldsToBodies() {
 
     // For each overlapping pairs in contact during the narrow-phase
-    std::map<overlappingpairid, OverlappingPair*>::iterator it;
-    for (it = mContactOverlappingPairs.begin(); it != mContactOverlappingPairs.end(); ++it) {
+    for (uint p=0; p < mContactOverlappingPairs.getNbPairs(); p++) {
 
         // Add all the contact manifolds of the pair into the list of contact manifolds
         // of the two bodies involved in the contact
-        addContactManifoldToBody(it->second);
+        addContactManifoldToBody(mContactOverlappingPairs.getPair(p));
     }
 }
 
@@ -498,9 +892,8 @@ void CollisionDetection::addContactManifoldToBody(OverlappingPair* pair) {
 void CollisionDetection::clearContactPoints() {
 
     // For each overlapping pair
-    std::map<overlappingpairid, OverlappingPair*>::iterator it;
-    for (it = mOverlappingPairs.begin(); it != mOverlappingPairs.end(); ++it) {
-        it->second->clearContactPoints();
+    for (uint p=0; p < mOverlappingPairs.getNbPairs(); p++) {
+        mOverlappingPairs.getPair(p)->clearContactPoints();
     }
 }
 
@@ -29,13 +29,18 @@
 // Libraries
 #include "body/CollisionBody.h"
 #include "broadphase/BroadPhaseAlgorithm.h"
+#include "broadphase/AABBTreeAlgorithm.h"
+#include "broadphase/SpatialHashAlgorithm.h"
 #include "engine/OverlappingPair.h"
+#include "engine/OverlappingPairMap.h"
 #include "engine/EventListener.h"
+#include "engine/ThreadPool.h"
 #include "narrowphase/DefaultCollisionDispatch.h"
+#include "collision/shapes/ConcaveShape.h"
+#include "collision/ConvexCastInfo.h"
 #include "memory/MemoryAllocator.h"
 #include "constraint/ContactPoint.h"
 #include <vector>
-#include <map>
 #include <set>
 #include <utility>
 
@@ -67,6 +72,152 @@ class TestCollisionBetweenShapesCallback : public NarrowPhaseCallback {
                                    const ContactPointInfo& contactInfo);
 };
 
+// Class TimeOfImpactTriangleCallback
+/**
+ * This class computes the earliest time of impact of a moving convex shape with the
+ * triangles of a static concave shape that are reported by the concave shape.
+ */
+class TimeOfImpactTriangleCallback : public TriangleCallback {
+
+    private:
+
+        /// GJK algorithm used to compute the times of impact
+        const GJKAlgorithm& mGJKAlgorithm;
+
+        /// Motion of the convex shape
+        const ConvexShapeMotion& mMotion;
+
+        /// Local-to-world transform of the concave shape
+        const Transform& mConcaveTransform;
+
+        /// Margin of the triangles of the concave shape
+        decimal mTriangleMargin;
+
+        /// Penetration depth of the shapes (with margins) at the time of impact
+        decimal mTargetPenetrationDepth;
+
+        /// True if the triangles in contact at the beginning of the motion are ignored
+        bool mIsInitialContactIgnored;
+
+        /// True if the convex shape hits a triangle
+        bool mIsHit;
+
+        /// Earliest time of impact
+        decimal mTimeOfImpact;
+
+        /// Normal at the earliest time of impact
+        Vector3 mNormal;
+
+        /// Closest point of the concave shape at the earliest time of impact
+        Vector3 mPoint;
+
+    public:
+
+        /// Constructor
+        TimeOfImpactTriangleCallback(const GJKAlgorithm& gjkAlgorithm, const ConvexShapeMotion& motion,
+                                     const Transform& concaveTransform, decimal triangleMargin,
+                                     decimal targetPenetrationDepth, bool isInitialContactIgnored)
+            : mGJKAlgorithm(gjkAlgorithm), mMotion(motion), mConcaveTransform(concaveTransform),
+              mTriangleMargin(triangleMargin), mTargetPenetrationDepth(targetPenetrationDepth),
+              mIsInitialContactIgnored(isInitialContactIgnored), mIsHit(false), mTimeOfImpact(decimal(1.0)) {
+
+        }
+
+        /// Compute the time of impact with a triangle
+        virtual void testTriangle(const Vector3* trianglePoints);
+
+        /// Return true if the convex shape hits a triangle
+        bool isHit() const {
+            return mIsHit;
+        }
+
+        /// Return the earliest time of impact
+        decimal getTimeOfImpact() const {
+            return mTimeOfImpact;
+        }
+
+        /// Return the normal at the earliest time of impact
+        const Vector3& getNormal() const {
+            return mNormal;
+        }
+
+        /// Return the closest point of the concave shape at the earliest time of impact
+        const Vector3& getPoint() const {
+            return mPoint;
+        }
+};
+
+// Class NarrowPhaseContactBuffer
+/**
+ * This class is a narrow-phase callback that stores the contacts found by a
+ * thread during the narrow-phase collision detection. The contacts are added
+ * into the overlapping pairs later, on the thread that updates the world.
+ */
+class NarrowPhaseContactBuffer : public NarrowPhaseCallback {
+
+    public:
+
+        /// Contacts found by the thread
+        std::vector<ContactPointInfo> contacts;
+
+        /// Called by a narrow-phase collision algorithm when a new contact has been found
+        virtual void notifyContact(OverlappingPair* overlappingPair,
+                                   const ContactPointInfo& contactInfo) {
+            contacts.push_back(contactInfo);
+        }
+};
+
+// Structure NarrowPhaseItem
+/**
+ * Overlapping pair to be tested during the narrow-phase collision detection and
+ * location of its contacts in the contact buffers of the threads.
+ */
+struct NarrowPhaseItem {
+
+    /// Overlapping pair to test
+    OverlappingPair* pair;
+
+    /// True if the pair can be tested concurrently with the other pairs
+    bool isParallel;
+
+    /// Index of the thread that has tested the pair
+    uint threadIndex;
+
+    /// Index of the first contact of the pair in the contact buffer of the thread
+    uint firstContact;
+
+    /// Number of contacts of the pair
+    uint nbContacts;
+};
+
+// Class NarrowPhaseTask
+/**
+ * This class is a parallel task that tests the overlapping pairs of the
+ * narrow-phase collision detection with the thread pool of the world.
+ */
+class NarrowPhaseTask : public ParallelTask {
+
+    private :
+
+        // -------------------- Attributes -------------------- //
+
+        /// Reference to the collision detection
+        CollisionDetection& mCollisionDetection;
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        NarrowPhaseTask(CollisionDetection& collisionDetection)
+            : mCollisionDetection(collisionDetection) {
+
+        }
+
+        /// Test the overlapping pair of a given item
+        virtual void execute(uint threadIndex, uint itemIndex);
+};
+
 // Class CollisionDetection
 /**
  * This class computes the collision detection algorithms. We first
@@ -92,17 +243,23 @@ class CollisionDetection : public NarrowPhaseCallback {
         /// Reference to the memory allocator
         MemoryAllocator& mMemoryAllocator;
 
+        /// Pool of the contact manifolds of the overlapping pairs
+        ContactManifoldPool mContactManifoldPool;
+
         /// Pointer to the physics world
         CollisionWorld* mWorld;
 
         /// Broad-phase overlapping pairs
-        std::map<overlappingpairid, OverlappingPair*> mOverlappingPairs;
+        OverlappingPairMap mOverlappingPairs;
 
         /// Overlapping pairs in contact (during the current Narrow-phase collision detection)
-        std::map<overlappingpairid, OverlappingPair*> mContactOverlappingPairs;
+        OverlappingPairMap mContactOverlappingPairs;
 
         /// Broad-phase algorithm
-        BroadPhaseAlgorithm mBroadPhaseAlgorithm;
+        BroadPhaseAlgorithm* mBroadPhaseAlgorithm;
+
+        /// Type of the broad-phase algorithm
+        BroadPhaseType mBroadPhaseType;
 
         /// Narrow-phase GJK algorithm
         // TODO : Delete this
@@ -114,6 +271,19 @@ class CollisionDetection : public NarrowPhaseCallback {
         /// True if some collision shapes have been added previously
         bool mIsCollisionShapesAdded;
 
+        /// Collision dispatches used by the worker threads during the narrow-phase (the
+        /// calling thread uses the collision matrix)
+        std::vector<DefaultCollisionDispatch*> mThreadCollisionDispatches;
+
+        /// Contact buffers of the threads during the narrow-phase
+        std::vector<NarrowPhaseContactBuffer> mThreadContactBuffers;
+
+        /// Counters of the EPA algorithm during the last narrow-phase
+        EPAStatistics mLastStepEPAStatistics;
+
+        /// Overlapping pairs to test during the current narrow-phase
+        std::vector<NarrowPhaseItem> mNarrowPhaseItems;
+
         // -------------------- Methods -------------------- //
 
         /// Private copy-constructor
@@ -128,6 +298,15 @@ class CollisionDetection : public NarrowPhaseCallback {
         /// Compute the narrow-phase collision detection
         void computeNarrowPhase();
 
+        /// Create the collision dispatches and contact buffers of the threads
+        void initThreadNarrowPhase(uint nbThreads);
+
+        /// Collect the counters of the EPA algorithm of all the collision dispatches
+        void updateEPAStatistics();
+
+        /// Test the overlapping pair of a narrow-phase item
+        void testNarrowPhaseItem(uint threadIndex, uint itemIndex);
+
         /// Add a contact manifold to the linked list of contact manifolds of the two bodies
         /// involed in the corresponding contact.
         void addContactManifoldToBody(OverlappingPair* pair);
@@ -146,7 +325,8 @@ class CollisionDetection : public NarrowPhaseCallback {
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        CollisionDetection(CollisionWorld* world, MemoryAllocator& memoryAllocator);
+        CollisionDetection(CollisionWorld* world, MemoryAllocator& memoryAllocator,
+                           BroadPhaseType broadPhaseType);
 
         /// Destructor
         ~CollisionDetection();
@@ -164,6 +344,9 @@ class CollisionDetection : public NarrowPhaseCallback {
         /// Remove a proxy collision shape from the collision detection
         void removeProxyCollisionShape(ProxyShape* proxyShape);
 
+        /// Remove many proxy collision shapes from the collision detection at once
+        void removeProxyCollisionShapes(std::vector<ProxyShape*>& proxyShapes);
+
         /// Update a proxy collision shape (that has moved for instance)
         void updateProxyCollisionShape(ProxyShape* shape, const AABB& aabb,
                                        const Vector3& displacement = Vector3(0, 0, 0), bool forceReinsert = false);
@@ -177,6 +360,30 @@ class CollisionDetection : public NarrowPhaseCallback {
         /// Ask for a collision shape to be tested again during broad-phase.
         void askForBroadPhaseCollisionCheck(ProxyShape* shape);
 
+        /// Start a bulk insertion of proxy collision shapes
+        void beginBulkInsertion();
+
+        /// End a bulk insertion of proxy collision shapes
+        void endBulkInsertion();
+
+        /// Rebuild the broad-phase data structure
+        void rebuildBroadPhase();
+
+        /// Return the AABB trees broad-phase (NULL with another broad-phase)
+        AABBTreeAlgorithm* getAABBTreeBroadPhase();
+
+        /// Return the spatial hash broad-phase (NULL with another broad-phase)
+        SpatialHashAlgorithm* getSpatialHashBroadPhase();
+
+        /// Return the counters of the broad-phase during the last step
+        const BroadPhaseStatistics& getBroadPhaseStatistics() const;
+
+        /// Return the counters of the EPA algorithm during the last narrow-phase
+        const EPAStatistics& getEPAStatistics() const;
+
+        /// Return the overlapping pair of two proxy shapes (or NULL if they do not overlap)
+        OverlappingPair* getOverlappingPair(ProxyShape* shape1, ProxyShape* shape2) const;
+
         /// Compute the collision detection
         void computeCollisionDetection();
 
@@ -202,6 +409,24 @@ class CollisionDetection : public NarrowPhaseCallback {
         bool testAABBOverlap(const ProxyShape* shape1,
                              const ProxyShape* shape2) const;
 
+        /// Find all the proxy shapes whose fat AABB overlaps with a given AABB
+        void reportShapesOverlappingWithAABB(const AABB& aabb,
+                                             std::vector<ProxyShape*>& overlappingShapes) const;
+
+        /// Compute the time of impact of a moving convex shape with a static proxy shape
+        bool computeTimeOfImpact(const ConvexShapeMotion& motion, ProxyShape* proxyShape,
+                                 decimal targetPenetrationDepth, bool isInitialContactIgnored,
+                                 decimal& timeOfImpact, Vector3& normal, Vector3& point) const;
+
+        /// Compute the first time of impact of a proxy shape whose body moves between two transforms
+        bool computeFirstTimeOfImpact(ProxyShape* proxyShape, const Transform& fromTransform,
+                                      const Transform& toTransform, decimal& timeOfImpact);
+
+        /// Convex casting method
+        void convexCast(ConvexCastCallback* convexCastCallback, const ConvexShape* shape,
+                        const Transform& fromTransform, const Transform& toTransform,
+                        unsigned short convexCastWithCategoryMaskBits) const;
+
         /// Allow the broadphase to notify the collision detection about an overlapping pair.
         void broadPhaseNotifyOverlappingPair(ProxyShape* shape1, ProxyShape* shape2);
 
@@ -229,6 +454,7 @@ class CollisionDetection : public NarrowPhaseCallback {
 
         friend class DynamicsWorld;
         friend class ConvexMeshShape;
+        friend class NarrowPhaseTask;
 };
 
 // Return the Narrow-phase collision detection algorithm to use between two types of shapes
@@ -252,7 +478,7 @@ inline void CollisionDetection::addProxyCollisionShape(ProxyShape* proxyShape,
                                                        const AABB& aabb) {
     
     // Add the body to the broad-phase
-    mBroadPhaseAlgorithm.addProxyCollisionShape(proxyShape, aabb);
+    mBroadPhaseAlgorithm->addProxyCollisionShape(proxyShape, aabb);
 
     mIsCollisionShapesAdded = true;
 }  
@@ -273,13 +499,57 @@ inline void CollisionDetection::removeNoCollisionPair(CollisionBody* body1,
 /// We simply put the shape in the list of collision shape that have moved in the
 /// previous frame so that it is tested for collision again in the broad-phase.
 inline void CollisionDetection::askForBroadPhaseCollisionCheck(ProxyShape* shape) {
-    mBroadPhaseAlgorithm.addMovedCollisionShape(shape->mBroadPhaseID);
+    mBroadPhaseAlgorithm->addMovedCollisionShape(shape);
+}
+
+// Start a bulk insertion of proxy collision shapes
+inline void CollisionDetection::beginBulkInsertion() {
+    mBroadPhaseAlgorithm->beginBulkInsertion();
+}
+
+// End a bulk insertion of proxy collision shapes
+inline void CollisionDetection::endBulkInsertion() {
+    mBroadPhaseAlgorithm->endBulkInsertion();
+}
+
+// Rebuild the broad-phase data structure
+inline void CollisionDetection::rebuildBroadPhase() {
+    mBroadPhaseAlgorithm->rebuild();
+}
+
+// Return the AABB trees broad-phase (NULL with another broad-phase)
+inline AABBTreeAlgorithm* CollisionDetection::getAABBTreeBroadPhase() {
+    return mBroadPhaseType == DYNAMIC_AABB_TREE ?
+                static_cast<AABBTreeAlgorithm*>(mBroadPhaseAlgorithm) : NULL;
+}
+
+// Return the spatial hash broad-phase (NULL with another broad-phase)
+inline SpatialHashAlgorithm* CollisionDetection::getSpatialHashBroadPhase() {
+    return mBroadPhaseType == SPATIAL_HASH ?
+                static_cast<SpatialHashAlgorithm*>(mBroadPhaseAlgorithm) : NULL;
+}
+
+// Return the counters of the broad-phase during the last step
+inline const BroadPhaseStatistics& CollisionDetection::getBroadPhaseStatistics() const {
+    return mBroadPhaseAlgorithm->getLastStepStatistics();
+}
+
+// Return the counters of the EPA algorithm during the last narrow-phase
+inline const EPAStatistics& CollisionDetection::getEPAStatistics() const {
+    return mLastStepEPAStatistics;
+}
+
+// Return the overlapping pair of two proxy shapes (or NULL if they do not overlap)
+inline OverlappingPair* CollisionDetection::getOverlappingPair(ProxyShape* shape1,
+                                                               ProxyShape* shape2) const {
+    if (shape1->mBroadPhaseID < 0 || shape2->mBroadPhaseID < 0) return NULL;
+    return mOverlappingPairs.find(OverlappingPair::computeID(shape1, shape2));
 }
 
 // Update a proxy collision shape (that has moved for instance)
 inline void CollisionDetection::updateProxyCollisionShape(ProxyShape* shape, const AABB& aabb,
                                                           const Vector3& displacement, bool forceReinsert) {
-    mBroadPhaseAlgorithm.updateProxyCollisionShape(shape, aabb, displacement);
+    mBroadPhaseAlgorithm->updateProxyCollisionShape(shape, aabb, displacement, forceReinsert);
 }
 
 // Ray casting method
@@ -293,7 +563,7 @@ inline void CollisionDetection::raycast(RaycastCallback* raycastCallback,
 
     // Ask the broad-phase algorithm to call the testRaycastAgainstShape()
     // callback method for each proxy shape hit by the ray in the broad-phase
-    mBroadPhaseAlgorithm.raycast(ray, rayCastTest, raycastWithCategoryMaskBits);
+    mBroadPhaseAlgorithm->raycast(ray, rayCastTest, raycastWithCategoryMaskBits);
 }
 
 // Test if the AABBs of two proxy shapes overlap
@@ -305,7 +575,13 @@ inline bool CollisionDetection::testAABBOverlap(const ProxyShape* shape1,
         return false;
     }
 
-    return mBroadPhaseAlgorithm.testOverlappingShapes(shape1, shape2);
+    return mBroadPhaseAlgorithm->testOverlappingShapes(shape1, shape2);
+}
+
+// Find all the proxy shapes whose fat AABB overlaps with a given AABB
+inline void CollisionDetection::reportShapesOverlappingWithAABB(const AABB& aabb,
+                                        std::vector<ProxyShape*>& overlappingShapes) const {
+    mBroadPhaseAlgorithm->reportShapesOverlappingWithAABB(aabb, overlappingShapes);
 }
 
 // Return a pointer to the world
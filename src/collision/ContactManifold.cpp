@@ -30,13 +30,11 @@
 using namespace reactphysics3d;
 
 // Constructor
-ContactManifold::ContactManifold(ProxyShape* shape1, ProxyShape* shape2,
-                                 MemoryAllocator& memoryAllocator, short normalDirectionId)
-                : mShape1(shape1), mShape2(shape2), mNormalDirectionId(normalDirectionId),
+ContactManifold::ContactManifold(ProxyShape* shape1, ProxyShape* shape2, short normalDirectionId)
+                : mShape1(shape1), mShape2(shape2), mUsedSlots(0), mNormalDirectionId(normalDirectionId),
                   mNbContactPoints(0), mFrictionImpulse1(0.0), mFrictionImpulse2(0.0),
-                  mFrictionTwistImpulse(0.0), mIsAlreadyInIsland(false),
-                  mMemoryAllocator(memoryAllocator) {
-    
+                  mFrictionTwistImpulse(0.0), mIsAlreadyInIsland(false) {
+
 }
 
 // Destructor
@@ -45,10 +43,44 @@ ContactManifold::~ContactManifold() {
 }
 
 // Add a contact point in the manifold
-void ContactManifold::addContactPoint(ContactPoint* contact) {
-	
+/// A contact point with a feature id replaces the contact point of the manifold with
+/// the same feature id (if any) and keeps its cached impulses for the warm-starting,
+/// even if the bodies have slided. A contact point without feature id is discarded
+/// if a contact point of the manifold is close to it.
+void ContactManifold::addContactPoint(const ContactPointInfo& contactInfo) {
+
+    // Create the contact point in a free slot. There is always a free slot because
+    // the manifold has one more slot than its maximum number of contact points.
+    ContactPoint* contact = createContactPoint(contactInfo);
+
+    // If the contact has been generated from features of the shapes
+    if (contact->getFeatureId() != NO_CONTACT_FEATURE_ID) {
+
+        // Replace the contact point between the same features (if any)
+        for (uint i=0; i<mNbContactPoints; i++) {
+            if (mContactPoints[i]->getFeatureId() == contact->getFeatureId()) {
+
+                contact->setCachedImpulses(*mContactPoints[i]);
+                destroyContactPoint(mContactPoints[i]);
+                mContactPoints[i] = contact;
+
+                return;
+            }
+        }
+
+        // If the contact manifold is full, we remove an obsolete contact point first
+        if (mNbContactPoints == MAX_CONTACT_POINTS_IN_MANIFOLD) {
+            for (uint i=0; i<mNbContactPoints; i++) {
+                if (mContactPoints[i]->getIsObsolete()) {
+                    removeContactPoint(i);
+                    break;
+                }
+            }
+        }
+    }
+
     // For contact already in the manifold
-    for (uint i=0; i<mNbContactPoints; i++) {
+    for (uint i=0; i<mNbContactPoints && contact->getFeatureId() == NO_CONTACT_FEATURE_ID; i++) {
 
 		// Check if the new point point does not correspond to a same contact point
         // already in the manifold.
@@ -57,8 +89,7 @@ void ContactManifold::addContactPoint(ContactPoint* contact) {
         if (distance <= PERSISTENT_CONTACT_DIST_THRESHOLD*PERSISTENT_CONTACT_DIST_THRESHOLD) {
 
             // Delete the new contact
-            contact->~ContactPoint();
-            mMemoryAllocator.release(contact, sizeof(ContactPoint));
+            destroyContactPoint(contact);
 
             assert(mNbContactPoints > 0);
 
@@ -80,16 +111,38 @@ void ContactManifold::addContactPoint(ContactPoint* contact) {
     assert(mNbContactPoints > 0);
 }
 
+// Create a contact point in a free slot of the manifold
+ContactPoint* ContactManifold::createContactPoint(const ContactPointInfo& contactInfo) {
+
+    // Find the first free slot
+    uint slot = 0;
+    while (mUsedSlots & (1u << slot)) slot++;
+    assert(slot <= MAX_CONTACT_POINTS_IN_MANIFOLD);
+
+    mUsedSlots |= (1u << slot);
+
+    return new (mContactPointSlots[slot].memory) ContactPoint(contactInfo);
+}
+
+// Destroy a contact point and free its slot
+void ContactManifold::destroyContactPoint(ContactPoint* contact) {
+
+    const uint slot = static_cast<uint>(reinterpret_cast<ContactPointSlot*>(contact) -
+                                        mContactPointSlots);
+    assert(slot <= MAX_CONTACT_POINTS_IN_MANIFOLD);
+    assert(mUsedSlots & (1u << slot));
+
+    contact->~ContactPoint();
+    mUsedSlots &= ~(1u << slot);
+}
+
 // Remove a contact point from the manifold
 void ContactManifold::removeContactPoint(uint index) {
     assert(index < mNbContactPoints);
     assert(mNbContactPoints > 0);
-	
-    // Call the destructor explicitly and tell the memory allocator that
-	// the corresponding memory block is now free
-    mContactPoints[index]->~ContactPoint();
-    mMemoryAllocator.release(mContactPoints[index], sizeof(ContactPoint));
-	
+
+    destroyContactPoint(mContactPoints[index]);
+
     // If we don't remove the last index
     if (index < mNbContactPoints - 1) {
         mContactPoints[index] = mContactPoints[mNbContactPoints - 1];
@@ -103,7 +156,9 @@ void ContactManifold::removeContactPoint(uint index) {
 /// the corresponding transforms of the bodies because they have moved. Then we remove the contacts
 /// with a negative penetration depth (meaning that the bodies are not penetrating anymore) and also
 /// the contacts with a too large distance between the contact points in the plane orthogonal to the
-/// contact normal.
+/// contact normal. The contacts with a feature id are not removed because of their distance in the
+/// plane orthogonal to the normal. They are marked as obsolete and will be replaced by the contacts
+/// between the same features in the next narrow-phase (or removed if they are not generated again).
 void ContactManifold::update(const Transform& transform1, const Transform& transform2) {
 
     if (mNbContactPoints == 0) return;
@@ -132,6 +187,9 @@ void ContactManifold::update(const Transform& transform1, const Transform& trans
         if (distanceNormal > squarePersistentContactThreshold) {
             removeContactPoint(i);
         }
+        else if (mContactPoints[i]->getFeatureId() != NO_CONTACT_FEATURE_ID) {
+            mContactPoints[i]->setIsObsolete(true);
+        }
         else {
             // Compute the distance of the two contact points in the plane
             // orthogonal to the contact normal
@@ -148,6 +206,19 @@ void ContactManifold::update(const Transform& transform1, const Transform& trans
     }    
 }
 
+// Remove the contact points with a feature id that have not been generated again
+/// This method is called after the narrow-phase of the pair of shapes. The contact points
+/// with a feature id that have not been replaced by new contact points between the same
+/// features do not exist anymore.
+void ContactManifold::removeObsoleteContactPoints() {
+
+    for (int i=static_cast<int>(mNbContactPoints)-1; i>=0; i--) {
+        if (mContactPoints[i]->getIsObsolete()) {
+            removeContactPoint(i);
+        }
+    }
+}
+
 // Return the index of the contact point with the larger penetration depth.
 /// This corresponding contact will be kept in the cache. The method returns -1 is
 /// the new contact is the deepest.
@@ -253,11 +324,8 @@ int ContactManifold::getMaxArea(decimal area0, decimal area1, decimal area2, dec
 // Clear the contact manifold
 void ContactManifold::clear() {
     for (uint i=0; i<mNbContactPoints; i++) {
-		
-        // Call the destructor explicitly and tell the memory allocator that
-		// the corresponding memory block is now free
-        mContactPoints[i]->~ContactPoint();
-        mMemoryAllocator.release(mContactPoints[i], sizeof(ContactPoint));
+        destroyContactPoint(mContactPoints[i]);
     }
     mNbContactPoints = 0;
+    assert(mUsedSlots == 0);
 }
@@ -42,6 +42,23 @@ const uint MAX_CONTACT_POINTS_IN_MANIFOLD = 4;   // Maximum number of contacts i
 // Class declarations
 class ContactManifold;
 
+// Union ContactPointSlot
+/**
+ * This union represents the memory of a contact point stored inside a contact
+ * manifold. The other members are only used to align the memory.
+ */
+union ContactPointSlot {
+
+    /// Memory of the contact point
+    char memory[sizeof(ContactPoint)];
+
+    /// Member used to align the memory on a pointer
+    void* pointerAlignment;
+
+    /// Member used to align the memory on a decimal value
+    decimal decimalAlignment;
+};
+
 // Structure ContactManifoldListElement
 /**
  * This structure represents a single element of a linked list of contact manifolds
@@ -81,7 +98,10 @@ struct ContactManifoldListElement {
  * When the cache is full, we have to remove one point. The idea is to keep
  * the point with the deepest penetration depth and also to keep the
  * points producing the larger area (for a more stable contact manifold).
- * The new added point is always kept.
+ * The new added point is always kept. The contact points are stored inside
+ * the manifold (with one more slot for the point that is added to a full
+ * manifold) so that no memory is allocated when contact points are added or
+ * removed.
  */
 class ContactManifold {
 
@@ -98,6 +118,12 @@ class ContactManifold {
         /// Contact points in the manifold
         ContactPoint* mContactPoints[MAX_CONTACT_POINTS_IN_MANIFOLD];
 
+        /// Memory of the contact points of the manifold
+        ContactPointSlot mContactPointSlots[MAX_CONTACT_POINTS_IN_MANIFOLD + 1];
+
+        /// Bit i is set if the slot i contains a contact point
+        uint mUsedSlots;
+
         /// Normal direction Id (Unique Id representing the normal direction)
         short int mNormalDirectionId;
 
@@ -125,9 +151,6 @@ class ContactManifold {
         /// True if the contact manifold has already been added into an island
         bool mIsAlreadyInIsland;
 
-        /// Reference to the memory allocator
-        MemoryAllocator& mMemoryAllocator;
-
         // -------------------- Methods -------------------- //
 
         /// Private copy-constructor
@@ -136,6 +159,12 @@ class ContactManifold {
         /// Private assignment operator
         ContactManifold& operator=(const ContactManifold& contactManifold);
 
+        /// Create a contact point in a free slot of the manifold
+        ContactPoint* createContactPoint(const ContactPointInfo& contactInfo);
+
+        /// Destroy a contact point and free its slot
+        void destroyContactPoint(ContactPoint* contact);
+
         /// Return the index of maximum area
         int getMaxArea(decimal area0, decimal area1, decimal area2, decimal area3) const;
 
@@ -156,8 +185,7 @@ class ContactManifold {
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        ContactManifold(ProxyShape* shape1, ProxyShape* shape2,
-                        MemoryAllocator& memoryAllocator, short int normalDirectionId);
+        ContactManifold(ProxyShape* shape1, ProxyShape* shape2, short int normalDirectionId);
 
         /// Destructor
         ~ContactManifold();
@@ -178,11 +206,14 @@ class ContactManifold {
         short int getNormalDirectionId() const;
 
         /// Add a contact point to the manifold
-        void addContactPoint(ContactPoint* contact);
+        void addContactPoint(const ContactPointInfo& contactInfo);
 
         /// Update the contact manifold.
         void update(const Transform& transform1, const Transform& transform2);
 
+        /// Remove the contact points with a feature id that have not been generated again
+        void removeObsoleteContactPoints();
+
         /// Clear the contact manifold
         void clear();
 
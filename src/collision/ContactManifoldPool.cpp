@@ -0,0 +1,95 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <cstdlib>
+#include <cassert>
+#include "ContactManifoldPool.h"
+
+using namespace reactphysics3d;
+
+// Constructor
+ContactManifoldPool::ContactManifoldPool() : mFreeSlots(NULL), mNbUsedManifolds(0) {
+
+}
+
+// Destructor
+ContactManifoldPool::~ContactManifoldPool() {
+
+    // All the contact manifolds must have been destroyed
+    assert(mNbUsedManifolds == 0);
+
+    for (uint i=0; i<mChunks.size(); i++) {
+        free(mChunks[i]);
+    }
+}
+
+// Allocate a new chunk of memory and add its slots to the free list
+void ContactManifoldPool::allocateChunk() {
+
+    ManifoldSlot* chunk = static_cast<ManifoldSlot*>(malloc(NB_MANIFOLDS_PER_CHUNK * sizeof(ManifoldSlot)));
+    assert(chunk != NULL);
+    mChunks.push_back(chunk);
+
+    for (uint i=0; i<NB_MANIFOLDS_PER_CHUNK - 1; i++) {
+        chunk[i].nextFreeSlot = &(chunk[i + 1]);
+    }
+    chunk[NB_MANIFOLDS_PER_CHUNK - 1].nextFreeSlot = mFreeSlots;
+    mFreeSlots = chunk;
+}
+
+// Create a new contact manifold
+/**
+ * @param shape1 Pointer to the first proxy shape of the contact
+ * @param shape2 Pointer to the second proxy shape of the contact
+ * @param normalDirectionId Id of the normal direction of the manifold
+ * @return A pointer to the new contact manifold
+ */
+ContactManifold* ContactManifoldPool::createManifold(ProxyShape* shape1, ProxyShape* shape2,
+                                                     short int normalDirectionId) {
+
+    // If there is no free slot, we allocate a new chunk
+    if (mFreeSlots == NULL) allocateChunk();
+
+    ManifoldSlot* slot = mFreeSlots;
+    mFreeSlots = slot->nextFreeSlot;
+    mNbUsedManifolds++;
+
+    return new (slot->memory) ContactManifold(shape1, shape2, normalDirectionId);
+}
+
+// Destroy a contact manifold and give its memory back to the pool
+void ContactManifoldPool::destroyManifold(ContactManifold* manifold) {
+
+    assert(manifold != NULL);
+    assert(mNbUsedManifolds > 0);
+
+    manifold->~ContactManifold();
+
+    ManifoldSlot* slot = reinterpret_cast<ManifoldSlot*>(manifold);
+    slot->nextFreeSlot = mFreeSlots;
+    mFreeSlots = slot;
+    mNbUsedManifolds--;
+}
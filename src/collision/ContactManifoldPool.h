@@ -0,0 +1,130 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_CONTACT_MANIFOLD_POOL_H
+#define REACTPHYSICS3D_CONTACT_MANIFOLD_POOL_H
+
+// Libraries
+#include <vector>
+#include "ContactManifold.h"
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Class ContactManifoldPool
+/**
+ * This class is a pool of contact manifolds used by the contact manifold sets of
+ * the overlapping pairs of a world. The manifolds are allocated by chunks and the
+ * memory of a destroyed manifold is kept in a free list to be reused by the next
+ * created manifold. Therefore, the memory allocator is not used when the contact
+ * manifolds of the pairs are created and destroyed during the narrow-phase.
+ */
+class ContactManifoldPool {
+
+    private :
+
+        // -------------------- Internal Classes -------------------- //
+
+        // Union ManifoldSlot
+        /**
+         * Memory of a contact manifold of the pool. When the slot is free, the
+         * memory is used to store the next free slot of the pool.
+         */
+        union ManifoldSlot {
+
+            /// Memory of the contact manifold
+            char memory[sizeof(ContactManifold)];
+
+            /// Next free slot of the pool
+            ManifoldSlot* nextFreeSlot;
+
+            /// Member used to align the memory on a decimal value
+            decimal decimalAlignment;
+        };
+
+        // -------------------- Constants -------------------- //
+
+        /// Number of contact manifolds in a chunk of memory
+        static const uint NB_MANIFOLDS_PER_CHUNK = 64;
+
+        // -------------------- Attributes -------------------- //
+
+        /// Chunks of memory of the pool
+        std::vector<ManifoldSlot*> mChunks;
+
+        /// First free slot of the pool
+        ManifoldSlot* mFreeSlots;
+
+        /// Number of contact manifolds currently used
+        uint mNbUsedManifolds;
+
+        // -------------------- Methods -------------------- //
+
+        /// Private copy-constructor
+        ContactManifoldPool(const ContactManifoldPool& pool);
+
+        /// Private assignment operator
+        ContactManifoldPool& operator=(const ContactManifoldPool& pool);
+
+        /// Allocate a new chunk of memory and add its slots to the free list
+        void allocateChunk();
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        ContactManifoldPool();
+
+        /// Destructor
+        ~ContactManifoldPool();
+
+        /// Create a new contact manifold
+        ContactManifold* createManifold(ProxyShape* shape1, ProxyShape* shape2,
+                                        short int normalDirectionId);
+
+        /// Destroy a contact manifold and give its memory back to the pool
+        void destroyManifold(ContactManifold* manifold);
+
+        /// Return the number of contact manifolds currently used
+        uint getNbUsedManifolds() const;
+
+        /// Return the number of contact manifolds that can be used without allocation
+        uint getNbAllocatedManifolds() const;
+};
+
+// Return the number of contact manifolds currently used
+inline uint ContactManifoldPool::getNbUsedManifolds() const {
+    return mNbUsedManifolds;
+}
+
+// Return the number of contact manifolds that can be used without allocation
+inline uint ContactManifoldPool::getNbAllocatedManifolds() const {
+    return static_cast<uint>(mChunks.size()) * NB_MANIFOLDS_PER_CHUNK;
+}
+
+}
+
+#endif
@@ -30,9 +30,9 @@ using namespace reactphysics3d;
 
 // Constructor
 ContactManifoldSet::ContactManifoldSet(ProxyShape* shape1, ProxyShape* shape2,
-                                       MemoryAllocator& memoryAllocator, int nbMaxManifolds)
+                                       ContactManifoldPool& manifoldPool, int nbMaxManifolds)
                    : mNbMaxManifolds(nbMaxManifolds), mNbManifolds(0), mShape1(shape1),
-                     mShape2(shape2), mMemoryAllocator(memoryAllocator) {
+                     mShape2(shape2), mManifoldPool(manifoldPool) {
     assert(nbMaxManifolds >= 1);
 }
 
@@ -44,16 +44,16 @@ ContactManifoldSet::~ContactManifoldSet() {
 }
 
 // Add a contact point to the manifold set
-void ContactManifoldSet::addContactPoint(ContactPoint* contact) {
+void ContactManifoldSet::addContactPoint(const ContactPointInfo& contactInfo) {
 
     // Compute an Id corresponding to the normal direction (using a cubemap)
-    short int normalDirectionId = computeCubemapNormalId(contact->getNormal());
+    short int normalDirectionId = computeCubemapNormalId(contactInfo.normal);
 
     // If there is no contact manifold yet
     if (mNbManifolds == 0) {
 
         createManifold(normalDirectionId);
-        mManifolds[0]->addContactPoint(contact);
+        mManifolds[0]->addContactPoint(contactInfo);
         assert(mManifolds[mNbManifolds-1]->getNbContactPoints() > 0);
         for (int i=0; i<mNbManifolds; i++) {
             assert(mManifolds[i]->getNbContactPoints() > 0);
@@ -72,7 +72,7 @@ void ContactManifoldSet::addContactPoint(ContactPoint* contact) {
     if (similarManifoldIndex != -1) {
 
         // Add the contact point to that similar manifold
-        mManifolds[similarManifoldIndex]->addContactPoint(contact);
+        mManifolds[similarManifoldIndex]->addContactPoint(contactInfo);
         assert(mManifolds[similarManifoldIndex]->getNbContactPoints() > 0);
 
         return;
@@ -83,7 +83,7 @@ void ContactManifoldSet::addContactPoint(ContactPoint* contact) {
 
         // Create a new manifold for the contact point
         createManifold(normalDirectionId);
-        mManifolds[mNbManifolds-1]->addContactPoint(contact);
+        mManifolds[mNbManifolds-1]->addContactPoint(contactInfo);
         for (int i=0; i<mNbManifolds; i++) {
             assert(mManifolds[i]->getNbContactPoints() > 0);
         }
@@ -95,7 +95,7 @@ void ContactManifoldSet::addContactPoint(ContactPoint* contact) {
     // manifolds condidates. We need to remove one. We choose to keep the manifolds
     // with the largest contact depth among their points
     int smallestDepthIndex = -1;
-    decimal minDepth = contact->getPenetrationDepth();
+    decimal minDepth = contactInfo.penetrationDepth;
     assert(mNbManifolds == mNbMaxManifolds);
     for (int i=0; i<mNbManifolds; i++) {
         decimal depth = mManifolds[i]->getLargestContactDepth();
@@ -107,14 +107,7 @@ void ContactManifoldSet::addContactPoint(ContactPoint* contact) {
 
     // If we do not want to keep to new manifold (not created yet) with the
     // new contact point
-    if (smallestDepthIndex == -1) {
-
-        // Delete the new contact
-        contact->~ContactPoint();
-        mMemoryAllocator.release(contact, sizeof(ContactPoint));
-
-        return;
-    }
+    if (smallestDepthIndex == -1) return;
 
     assert(smallestDepthIndex >= 0 && smallestDepthIndex < mNbManifolds);
 
@@ -122,7 +115,7 @@ void ContactManifoldSet::addContactPoint(ContactPoint* contact) {
     // the new contact point)
     removeManifold(smallestDepthIndex);
     createManifold(normalDirectionId);
-    mManifolds[mNbManifolds-1]->addContactPoint(contact);
+    mManifolds[mNbManifolds-1]->addContactPoint(contactInfo);
     assert(mManifolds[mNbManifolds-1]->getNbContactPoints() > 0);
     for (int i=0; i<mNbManifolds; i++) {
         assert(mManifolds[i]->getNbContactPoints() > 0);
@@ -198,6 +191,20 @@ void ContactManifoldSet::update() {
     }
 }
 
+// Remove the contact points with a feature id that have not been generated again
+void ContactManifoldSet::removeObsoleteContactPoints() {
+
+    for (int i=mNbManifolds-1; i>=0; i--) {
+
+        mManifolds[i]->removeObsoleteContactPoints();
+
+        // Remove the contact manifold if has no contact points anymore
+        if (mManifolds[i]->getNbContactPoints() == 0) {
+            removeManifold(i);
+        }
+    }
+}
+
 // Clear the contact manifold set
 void ContactManifoldSet::clear() {
 
@@ -213,8 +220,7 @@ void ContactManifoldSet::clear() {
 void ContactManifoldSet::createManifold(short int normalDirectionId) {
     assert(mNbManifolds < mNbMaxManifolds);
 
-    mManifolds[mNbManifolds] = new (mMemoryAllocator.allocate(sizeof(ContactManifold)))
-                                    ContactManifold(mShape1, mShape2, mMemoryAllocator, normalDirectionId);
+    mManifolds[mNbManifolds] = mManifoldPool.createManifold(mShape1, mShape2, normalDirectionId);
     mNbManifolds++;
 }
 
@@ -224,9 +230,8 @@ void ContactManifoldSet::removeManifold(int index) {
     assert(mNbManifolds > 0);
     assert(index >= 0 && index < mNbManifolds);
 
-    // Delete the new contact
-    mManifolds[index]->~ContactManifold();
-    mMemoryAllocator.release(mManifolds[index], sizeof(ContactManifold));
+    // Give the contact manifold back to the pool
+    mManifoldPool.destroyManifold(mManifolds[index]);
 
     for (int i=index; (i+1) < mNbManifolds; i++) {
         mManifolds[i] = mManifolds[i+1];
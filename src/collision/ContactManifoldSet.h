@@ -28,6 +28,7 @@
 
 // Libraries
 #include "ContactManifold.h"
+#include "ContactManifoldPool.h"
 
 namespace reactphysics3d {
 
@@ -60,8 +61,8 @@ class ContactManifoldSet {
         /// Pointer to the second proxy shape of the contact
         ProxyShape* mShape2;
 
-        /// Reference to the memory allocator
-        MemoryAllocator& mMemoryAllocator;
+        /// Reference to the pool of contact manifolds of the world
+        ContactManifoldPool& mManifoldPool;
 
         /// Contact manifolds of the set
         ContactManifold* mManifolds[MAX_MANIFOLDS_IN_CONTACT_MANIFOLD_SET];
@@ -88,7 +89,7 @@ class ContactManifoldSet {
 
         /// Constructor
         ContactManifoldSet(ProxyShape* shape1, ProxyShape* shape2,
-                           MemoryAllocator& memoryAllocator, int nbMaxManifolds);
+                           ContactManifoldPool& manifoldPool, int nbMaxManifolds);
 
         /// Destructor
         ~ContactManifoldSet();
@@ -100,11 +101,14 @@ class ContactManifoldSet {
         ProxyShape* getShape2() const;
 
         /// Add a contact point to the manifold set
-        void addContactPoint(ContactPoint* contact);
+        void addContactPoint(const ContactPointInfo& contactInfo);
 
         /// Update the contact manifolds
         void update();
 
+        /// Remove the contact points with a feature id that have not been generated again
+        void removeObsoleteContactPoints();
+
         /// Clear the contact manifold set
         void clear();
 
@@ -0,0 +1,127 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_CONVEX_CAST_INFO_H
+#define REACTPHYSICS3D_CONVEX_CAST_INFO_H
+
+// Libraries
+#include "mathematics/Vector3.h"
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Declarations
+class CollisionBody;
+class ProxyShape;
+
+// Structure ConvexCastInfo
+/**
+ * This structure contains the information about a convex cast hit.
+ */
+struct ConvexCastInfo {
+
+    private:
+
+        // -------------------- Methods -------------------- //
+
+        /// Private copy constructor
+        ConvexCastInfo(const ConvexCastInfo& convexCastInfo);
+
+        /// Private assignment operator
+        ConvexCastInfo& operator=(const ConvexCastInfo& convexCastInfo);
+
+    public:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Closest point of the hit shape at the time of impact in world-space coordinates
+        Vector3 worldPoint;
+
+        /// Surface normal of the hit shape (toward the cast shape) at the time of
+        /// impact in world-space coordinates (zero if the cast shape overlaps with the
+        /// hit shape at the beginning of the motion)
+        Vector3 worldNormal;
+
+        /// Fraction of the motion at the time of impact. The transform "T" of the cast
+        /// shape at the impact is such that T = interpolate(fromTransform, toTransform,
+        /// hitFraction) (linear interpolation of the position and spherical
+        /// interpolation of the orientation)
+        decimal hitFraction;
+
+        /// Pointer to the hit collision body
+        CollisionBody* body;
+
+        /// Pointer to the hit proxy collision shape
+        ProxyShape* proxyShape;
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        ConvexCastInfo() : hitFraction(decimal(0.0)), body(NULL), proxyShape(NULL) {
+
+        }
+
+        /// Destructor
+        ~ConvexCastInfo() {
+
+        }
+};
+
+// Class ConvexCastCallback
+/**
+ * This class can be used to register a callback for convex casting queries.
+ * You should implement your own class inherited from this one and implement
+ * the notifyConvexCastHit() method. This method will be called for each
+ * ProxyShape that is hit by the cast shape.
+ */
+class ConvexCastCallback {
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Destructor
+        virtual ~ConvexCastCallback() {
+
+        }
+
+        /// This method will be called for each ProxyShape that is hit by the
+        /// cast shape. You cannot make any assumptions about the order of the
+        /// calls. The returned value controls the continuation of the cast in
+        /// the same way as for the ray casting: 0.0 terminates the cast, 1.0
+        /// continues it as if no hit occurred, the hit fraction of the hit clips
+        /// the motion of the cast shape at this fraction for the next queries
+        /// and -1.0 ignores this ProxyShape.
+        /**
+         * @param convexCastInfo Information about the convex cast hit
+         * @return Value that controls the continuation of the cast after a hit
+         */
+        virtual decimal notifyConvexCastHit(const ConvexCastInfo& convexCastInfo)=0;
+
+};
+
+}
+
+#endif
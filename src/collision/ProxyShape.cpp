@@ -37,7 +37,11 @@ using namespace reactphysics3d;
  */
 ProxyShape::ProxyShape(CollisionBody* body, CollisionShape* shape, const Transform& transform, decimal mass)
            :mBody(body), mCollisionShape(shape), mLocalToBodyTransform(transform), mMass(mass),
-            mNext(NULL), mBroadPhaseID(-1), mCachedCollisionData(NULL), mUserData(NULL),
+            mNext(NULL), mBroadPhaseID(-1), mBroadPhaseDisplacement(0, 0, 0),
+            mBroadPhaseAABBCenter(0, 0, 0),
+            mBroadPhasePredictionSteps(DYNAMIC_TREE_AABB_LIN_GAP_MULTIPLIER),
+            mBroadPhaseUpdateStep(0), mBroadPhaseFatAABBStep(0), mMovedShapeIndex(-1),
+            mCachedCollisionData(NULL), mUserData(NULL),
             mCollisionCategoryBits(0x0001), mCollideWithMaskBits(0xFFFF) {
 
 }
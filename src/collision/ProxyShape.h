@@ -66,6 +66,26 @@ class ProxyShape {
         /// Broad-phase ID (node ID in the dynamic AABB tree)
         int mBroadPhaseID;
 
+        /// Estimated displacement of the shape during one step (used by the broad-phase
+        /// to inflate the fat AABB of the shape in direction of its motion)
+        Vector3 mBroadPhaseDisplacement;
+
+        /// Center of the AABB of the shape at its last broad-phase update
+        Vector3 mBroadPhaseAABBCenter;
+
+        /// Adaptive number of steps of motion predicted by the fat AABB of the shape
+        decimal mBroadPhasePredictionSteps;
+
+        /// Broad-phase step of the last update of the shape
+        uint mBroadPhaseUpdateStep;
+
+        /// Broad-phase step at which the fat AABB of the shape has been computed
+        uint mBroadPhaseFatAABBStep;
+
+        /// Index of the shape in the array of moved shapes of the broad-phase (-1 if the
+        /// shape has not moved since the last computation of the overlapping pairs)
+        int mMovedShapeIndex;
+
         /// Cached collision data
         void* mCachedCollisionData;
 
@@ -167,6 +187,9 @@ class ProxyShape {
         friend class CollisionBody;
         friend class RigidBody;
         friend class BroadPhaseAlgorithm;
+        friend class AABBTreeAlgorithm;
+        friend class SweepAndPruneAlgorithm;
+        friend class SpatialHashAlgorithm;
         friend class DynamicAABBTree;
         friend class CollisionDetection;
         friend class CollisionWorld;
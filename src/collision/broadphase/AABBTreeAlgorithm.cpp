@@ -0,0 +1,244 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "AABBTreeAlgorithm.h"
+#include "collision/CollisionDetection.h"
+#include "engine/Profiler.h"
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Initialization of static variables
+const int AABBTreeAlgorithm::NB_TREES;
+const int AABBTreeAlgorithm::NB_TREE_INDEX_BITS;
+
+// Constructor
+/// The AABBs of the static tree are not inflated because the static bodies
+/// are rarely moved.
+AABBTreeAlgorithm::AABBTreeAlgorithm(CollisionDetection& collisionDetection)
+                  :BroadPhaseAlgorithm(collisionDetection), mStaticAABBTree(decimal(0.0)),
+                   mKinematicAABBTree(DYNAMIC_TREE_AABB_GAP), mDynamicAABBTree(DYNAMIC_TREE_AABB_GAP),
+                   mNbStaticShapes(0), mNbStaticTreeChanges(0), mNbTreeLeavesToOptimizePerStep(0) {
+
+    // The trees are indexed by the type of the bodies
+    mTrees[STATIC] = &mStaticAABBTree;
+    mTrees[KINEMATIC] = &mKinematicAABBTree;
+    mTrees[DYNAMIC] = &mDynamicAABBTree;
+}
+
+// Destructor
+AABBTreeAlgorithm::~AABBTreeAlgorithm() {
+
+}
+
+// Add a proxy collision shape into the broad-phase collision detection
+void AABBTreeAlgorithm::addProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb) {
+
+    // Add the collision shape into the tree of the type of its body
+    const int treeIndex = proxyShape->getBody()->getType();
+    int nodeId = mTrees[treeIndex]->addObject(aabb, proxyShape);
+
+    // Set the broad-phase ID of the proxy shape
+    proxyShape->mBroadPhaseID = computeBroadPhaseID(treeIndex, nodeId);
+    initializeShapeMotion(proxyShape, aabb);
+
+    if (treeIndex == STATIC) {
+        mNbStaticShapes++;
+        mNbStaticTreeChanges++;
+    }
+
+    // Add the collision shape into the array of bodies that have moved (or have been created)
+    // during the last simulation step
+    addMovedCollisionShape(proxyShape);
+}
+
+// Remove a proxy collision shape from the broad-phase collision detection
+void AABBTreeAlgorithm::removeProxyCollisionShape(ProxyShape* proxyShape) {
+
+    int broadPhaseID = proxyShape->mBroadPhaseID;
+
+    // Remove the collision shape from its AABB tree
+    const int treeIndex = broadPhaseID & ((1 << NB_TREE_INDEX_BITS) - 1);
+    mTrees[treeIndex]->removeObject(getTreeNodeID(broadPhaseID));
+
+    if (treeIndex == STATIC) {
+        mNbStaticShapes--;
+        mNbStaticTreeChanges++;
+    }
+
+    // Remove the collision shape into the array of shapes that have moved (or have been created)
+    // during the last simulation step
+    removeMovedCollisionShape(proxyShape);
+}
+
+// Notify the broad-phase that a collision shape has moved and need to be updated
+void AABBTreeAlgorithm::updateProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb,
+                                                    const Vector3& displacement, bool forceReinsert) {
+
+    int broadPhaseID = proxyShape->mBroadPhaseID;
+
+    assert(broadPhaseID >= 0);
+
+    PROFILE("AABBTreeAlgorithm::updateProxyCollisionShape()");
+
+    // If the collision shape has moved out of its fat AABB (or if its fat AABB is much
+    // larger than needed), the shape is reinserted into its tree with a new fat AABB
+    const int treeIndex = broadPhaseID & ((1 << NB_TREE_INDEX_BITS) - 1);
+    const int nodeID = getTreeNodeID(broadPhaseID);
+    AABB fatAABB = mTrees[treeIndex]->getFatAABB(nodeID);
+    if (!updateFatAABB(proxyShape, aabb, displacement, treeIndex == STATIC, forceReinsert, fatAABB)) {
+        return;
+    }
+    mTrees[treeIndex]->reinsertObject(nodeID, fatAABB);
+
+    if (treeIndex == STATIC) mNbStaticTreeChanges++;
+
+    // Add the collision shape into the array of shapes that have moved (or have been created)
+    // during the last simulation step
+    addMovedCollisionShape(proxyShape);
+}
+
+// Update the trees before they are queried with the moved collision shapes
+void AABBTreeAlgorithm::prepareQueries() {
+
+    assert(!mDynamicAABBTree.isBulkInsertionActive());
+
+    // If many static shapes have changed since the static tree has been built, we
+    // build it again top-down (the queries of the moving shapes into the static
+    // tree are then faster than with a tree built by incremental insertions)
+    if (mNbStaticTreeChanges > 0 &&
+        decimal(mNbStaticTreeChanges) > STATIC_TREE_REBUILD_RATIO * decimal(mNbStaticShapes)) {
+        mStaticAABBTree.rebuild();
+        mNbStaticTreeChanges = 0;
+    }
+
+    // Incrementally improve the quality of the trees of the moving shapes before the queries
+    if (mNbTreeLeavesToOptimizePerStep > 0) {
+        mKinematicAABBTree.optimize(mNbTreeLeavesToOptimizePerStep);
+        mDynamicAABBTree.optimize(mNbTreeLeavesToOptimizePerStep);
+    }
+}
+
+// Find all the collision shapes that overlap with a given moved collision shape
+/**
+ * @param threadIndex Index of the thread that executes the query
+ * @param shapeID Broad-phase ID of the moved collision shape
+ */
+void AABBTreeAlgorithm::queryOverlappingShapes(uint threadIndex, int shapeID) {
+
+    // Get the AABB of the shape
+    const int treeIndex = shapeID & ((1 << NB_TREE_INDEX_BITS) - 1);
+    const AABB& shapeAABB = mTrees[treeIndex]->getFatAABB(getTreeNodeID(shapeID));
+
+    // Ask the AABB trees to report all collision shapes that overlap with this
+    // AABB. The method BroadPhase::notifiyOverlappingPair() will be called by the
+    // trees for each potential overlapping pair. The static shapes never collide
+    // with each other and are therefore not tested against the static tree.
+    for (int t=0; t<NB_TREES; t++) {
+        if (treeIndex == STATIC && t == STATIC) continue;
+        AABBOverlapCallback callback(*this, shapeID, t, threadIndex);
+        mTrees[t]->reportAllShapesOverlappingWithAABB(shapeAABB, callback);
+    }
+}
+
+// Ray casting method
+/// The three trees are traversed one after the other. The ray is clipped at the
+/// closest hit found in the previous trees.
+void AABBTreeAlgorithm::raycast(const Ray& ray, RaycastTest& raycastTest,
+                                unsigned short raycastWithCategoryMaskBits) const {
+
+    PROFILE("AABBTreeAlgorithm::raycast()");
+
+    assert(!mDynamicAABBTree.isBulkInsertionActive());
+
+    decimal maxFraction = ray.maxFraction;
+    for (int t=0; t<NB_TREES; t++) {
+
+        BroadPhaseRaycastCallback broadPhaseRaycastCallback(*mTrees[t], raycastWithCategoryMaskBits,
+                                                            raycastTest, maxFraction);
+
+        mTrees[t]->raycast(Ray(ray.point1, ray.point2, maxFraction), broadPhaseRaycastCallback);
+
+        // If the raycast test has asked to stop the raycasting
+        if (broadPhaseRaycastCallback.isRaycastStopped()) return;
+
+        maxFraction = broadPhaseRaycastCallback.getMaxFraction();
+    }
+}
+
+// Find all the proxy shapes whose fat AABB overlaps with a given AABB
+void AABBTreeAlgorithm::reportShapesOverlappingWithAABB(const AABB& aabb,
+                                                        std::vector<ProxyShape*>& overlappingShapes) const {
+
+    assert(!mDynamicAABBTree.isBulkInsertionActive());
+
+    for (int t=0; t<NB_TREES; t++) {
+        BroadPhaseAABBQueryCallback callback(*mTrees[t], overlappingShapes);
+        mTrees[t]->reportAllShapesOverlappingWithAABB(aabb, callback);
+    }
+}
+
+// Called when a overlapping node has been found during the call to
+// DynamicAABBTree:reportAllShapesOverlappingWithAABB()
+void BroadPhaseAABBQueryCallback::notifyOverlappingNode(int nodeId) {
+    mOverlappingShapes.push_back(static_cast<ProxyShape*>(mDynamicAABBTree.getNodeDataPointer(nodeId)));
+}
+
+// Called when a overlapping node has been found during the call to
+// DynamicAABBTree:reportAllShapesOverlappingWithAABB()
+void AABBOverlapCallback::notifyOverlappingNode(int nodeId) {
+
+    mBroadPhaseAlgorithm.notifyOverlappingNodes(mThreadIndex, mReferenceNodeId,
+                                                AABBTreeAlgorithm::computeBroadPhaseID(mTreeIndex, nodeId));
+}
+
+// Called for a broad-phase shape that has to be tested for raycast
+decimal BroadPhaseRaycastCallback::raycastBroadPhaseShape(int32 nodeId, const Ray& ray) {
+
+    decimal hitFraction = decimal(-1.0);
+
+    // Get the proxy shape from the node
+    ProxyShape* proxyShape = static_cast<ProxyShape*>(mDynamicAABBTree.getNodeDataPointer(nodeId));
+
+    // Check if the raycast filtering mask allows raycast against this shape
+    if ((mRaycastWithCategoryMaskBits & proxyShape->getCollisionCategoryBits()) != 0) {
+
+        // Ask the collision detection to perform a ray cast test against
+        // the proxy shape of this node because the ray is overlapping
+        // with the shape in the broad-phase
+        hitFraction = mRaycastTest.raycastAgainstShape(proxyShape, ray);
+
+        // Keep the closest hit to clip the ray in the next trees
+        if (hitFraction == decimal(0.0)) {
+            mIsRaycastStopped = true;
+        }
+        else if (hitFraction > decimal(0.0) && hitFraction < mMaxFraction) {
+            mMaxFraction = hitFraction;
+        }
+    }
+
+    return hitFraction;
+}
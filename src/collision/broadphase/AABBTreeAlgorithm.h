@@ -0,0 +1,356 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_AABB_TREE_ALGORITHM_H
+#define REACTPHYSICS3D_AABB_TREE_ALGORITHM_H
+
+// Libraries
+#include "BroadPhaseAlgorithm.h"
+#include "DynamicAABBTree.h"
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Declarations
+class AABBTreeAlgorithm;
+
+// class AABBOverlapCallback
+class AABBOverlapCallback : public DynamicAABBTreeOverlapCallback {
+
+    private:
+
+        AABBTreeAlgorithm& mBroadPhaseAlgorithm;
+
+        int mReferenceNodeId;
+
+        /// Index of the tree that is queried
+        int mTreeIndex;
+
+        /// Index of the thread that queries the tree
+        uint mThreadIndex;
+
+    public:
+
+        // Constructor
+        AABBOverlapCallback(AABBTreeAlgorithm& broadPhaseAlgo, int referenceNodeId, int treeIndex,
+                            uint threadIndex)
+             : mBroadPhaseAlgorithm(broadPhaseAlgo), mReferenceNodeId(referenceNodeId),
+               mTreeIndex(treeIndex), mThreadIndex(threadIndex) {
+
+        }
+
+        // Called when a overlapping node has been found during the call to
+        // DynamicAABBTree:reportAllShapesOverlappingWithAABB()
+        virtual void notifyOverlappingNode(int nodeId);
+
+};
+
+// Class BroadPhaseAABBQueryCallback
+/**
+ * Callback called for each leaf node of a broad-phase Dynamic AABB Tree whose
+ * fat AABB overlaps with the AABB of a query.
+ */
+class BroadPhaseAABBQueryCallback : public DynamicAABBTreeOverlapCallback {
+
+    private:
+
+        const DynamicAABBTree& mDynamicAABBTree;
+
+        /// Array where the overlapping proxy shapes are added
+        std::vector<ProxyShape*>& mOverlappingShapes;
+
+    public:
+
+        // Constructor
+        BroadPhaseAABBQueryCallback(const DynamicAABBTree& dynamicAABBTree,
+                                    std::vector<ProxyShape*>& overlappingShapes)
+             : mDynamicAABBTree(dynamicAABBTree), mOverlappingShapes(overlappingShapes) {
+
+        }
+
+        // Called when a overlapping node has been found during the call to
+        // DynamicAABBTree:reportAllShapesOverlappingWithAABB()
+        virtual void notifyOverlappingNode(int nodeId);
+};
+
+// Class BroadPhaseRaycastCallback
+/**
+ * Callback called when the AABB of a leaf node is hit by a ray the
+ * broad-phase Dynamic AABB Tree.
+ */
+class BroadPhaseRaycastCallback : public DynamicAABBTreeRaycastCallback {
+
+    private :
+
+        const DynamicAABBTree& mDynamicAABBTree;
+
+        unsigned short mRaycastWithCategoryMaskBits;
+
+        RaycastTest& mRaycastTest;
+
+        /// Smallest hit fraction returned by the raycast test (the ray is clipped there)
+        decimal mMaxFraction;
+
+        /// True if the raycast test has asked to stop the raycasting
+        bool mIsRaycastStopped;
+
+    public:
+
+        // Constructor
+        BroadPhaseRaycastCallback(const DynamicAABBTree& dynamicAABBTree, unsigned short raycastWithCategoryMaskBits,
+                                  RaycastTest& raycastTest, decimal maxFraction)
+            : mDynamicAABBTree(dynamicAABBTree), mRaycastWithCategoryMaskBits(raycastWithCategoryMaskBits),
+              mRaycastTest(raycastTest), mMaxFraction(maxFraction), mIsRaycastStopped(false) {
+
+        }
+
+        // Called for a broad-phase shape that has to be tested for raycast
+        virtual decimal raycastBroadPhaseShape(int32 nodeId, const Ray& ray);
+
+        // Return the smallest hit fraction returned by the raycast test
+        decimal getMaxFraction() const {
+            return mMaxFraction;
+        }
+
+        // Return true if the raycast test has asked to stop the raycasting
+        bool isRaycastStopped() const {
+            return mIsRaycastStopped;
+        }
+};
+
+// Class AABBTreeAlgorithm
+/**
+ * This class implements the broad-phase collision detection with dynamic AABB
+ * trees. The proxy shapes of the static, kinematic and dynamic bodies are stored in
+ * three different trees so that the static shapes (usually most of the shapes of a
+ * world) are never tested against each other. The index of the tree of a proxy shape
+ * is stored in the lowest bits of its broad-phase ID and the ID of its node in the
+ * tree in the other bits. This is the default broad-phase algorithm.
+ */
+class AABBTreeAlgorithm : public BroadPhaseAlgorithm {
+
+    public :
+
+        // -------------------- Constants -------------------- //
+
+        /// Number of AABB trees (one for each type of body)
+        static const int NB_TREES = 3;
+
+        /// Number of bits of a broad-phase ID used to store the index of the tree
+        static const int NB_TREE_INDEX_BITS = 2;
+
+    protected :
+
+        // -------------------- Attributes -------------------- //
+
+        /// AABB tree of the proxy shapes of the static bodies
+        DynamicAABBTree mStaticAABBTree;
+
+        /// AABB tree of the proxy shapes of the kinematic bodies
+        DynamicAABBTree mKinematicAABBTree;
+
+        /// AABB tree of the proxy shapes of the dynamic bodies
+        DynamicAABBTree mDynamicAABBTree;
+
+        /// The AABB trees indexed by the type of the bodies of their proxy shapes
+        DynamicAABBTree* mTrees[NB_TREES];
+
+        /// Number of proxy shapes in the static tree
+        uint mNbStaticShapes;
+
+        /// Number of proxy shapes that have been added, removed or reinserted in the
+        /// static tree since it has been built top-down for the last time
+        uint mNbStaticTreeChanges;
+
+        /// Number of leaves of the kinematic and dynamic AABB trees that are optimized
+        /// at each simulation step (zero if the trees are not optimized)
+        uint mNbTreeLeavesToOptimizePerStep;
+
+        // -------------------- Methods -------------------- //
+
+        /// Private copy-constructor
+        AABBTreeAlgorithm(const AABBTreeAlgorithm& algorithm);
+
+        /// Private assignment operator
+        AABBTreeAlgorithm& operator=(const AABBTreeAlgorithm& algorithm);
+
+        /// Return the tree that contains a given broad-phase ID
+        const DynamicAABBTree& getTree(int broadPhaseID) const;
+
+        /// Return the ID of the tree node of a given broad-phase ID
+        static int getTreeNodeID(int broadPhaseID);
+
+        /// Update the trees before they are queried with the moved collision shapes
+        virtual void prepareQueries();
+
+        /// Find all the collision shapes that overlap with a given moved collision shape
+        virtual void queryOverlappingShapes(uint threadIndex, int broadPhaseID);
+
+        /// Return the proxy shape of a given broad-phase ID
+        virtual ProxyShape* getProxyShape(int broadPhaseID) const;
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        AABBTreeAlgorithm(CollisionDetection& collisionDetection);
+
+        /// Destructor
+        virtual ~AABBTreeAlgorithm();
+
+        /// Add a proxy collision shape into the broad-phase collision detection
+        virtual void addProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb);
+
+        /// Remove a proxy collision shape from the broad-phase collision detection
+        virtual void removeProxyCollisionShape(ProxyShape* proxyShape);
+
+        /// Notify the broad-phase that a collision shape has moved and need to be updated
+        virtual void updateProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb,
+                                               const Vector3& displacement, bool forceReinsert = false);
+
+        /// Return true if the two broad-phase collision shapes are overlapping
+        virtual bool testOverlappingShapes(const ProxyShape* shape1, const ProxyShape* shape2) const;
+
+        /// Ray casting method
+        virtual void raycast(const Ray& ray, RaycastTest& raycastTest,
+                             unsigned short raycastWithCategoryMaskBits) const;
+
+        /// Find all the proxy shapes whose fat AABB overlaps with a given AABB
+        virtual void reportShapesOverlappingWithAABB(const AABB& aabb,
+                                                     std::vector<ProxyShape*>& overlappingShapes) const;
+
+        /// Start a bulk insertion of collision shapes
+        virtual void beginBulkInsertion();
+
+        /// End a bulk insertion of collision shapes and rebuild the AABB trees
+        virtual void endBulkInsertion();
+
+        /// Rebuild the AABB trees
+        virtual void rebuild();
+
+        /// Compute the broad-phase ID of a node of a given tree
+        static int computeBroadPhaseID(int treeIndex, int nodeID);
+
+        /// Set the number of tree leaves that are optimized at each simulation step
+        void setNbTreeLeavesToOptimizePerStep(uint nbLeaves);
+
+        /// Return the number of tree leaves that are optimized at each simulation step
+        uint getNbTreeLeavesToOptimizePerStep() const;
+
+        /// Compute the cost of the dynamic AABB tree (a measure of its quality)
+        decimal computeTreeCost() const;
+
+        // -------------------- Friendship -------------------- //
+
+        friend class AABBOverlapCallback;
+};
+
+// Return the tree that contains a given broad-phase ID
+inline const DynamicAABBTree& AABBTreeAlgorithm::getTree(int broadPhaseID) const {
+    return *mTrees[broadPhaseID & ((1 << NB_TREE_INDEX_BITS) - 1)];
+}
+
+// Return the ID of the tree node of a given broad-phase ID
+inline int AABBTreeAlgorithm::getTreeNodeID(int broadPhaseID) {
+    return broadPhaseID >> NB_TREE_INDEX_BITS;
+}
+
+// Compute the broad-phase ID of a node of a given tree
+inline int AABBTreeAlgorithm::computeBroadPhaseID(int treeIndex, int nodeID) {
+    assert(treeIndex >= 0 && treeIndex < NB_TREES);
+    return (nodeID << NB_TREE_INDEX_BITS) | treeIndex;
+}
+
+// Return the proxy shape of a given broad-phase ID
+inline ProxyShape* AABBTreeAlgorithm::getProxyShape(int broadPhaseID) const {
+    return static_cast<ProxyShape*>(getTree(broadPhaseID).getNodeDataPointer(getTreeNodeID(broadPhaseID)));
+}
+
+// Return true if the two broad-phase collision shapes are overlapping
+inline bool AABBTreeAlgorithm::testOverlappingShapes(const ProxyShape* shape1,
+                                                     const ProxyShape* shape2) const {
+    // Get the two AABBs of the collision shapes
+    const AABB& aabb1 = getTree(shape1->mBroadPhaseID).getFatAABB(getTreeNodeID(shape1->mBroadPhaseID));
+    const AABB& aabb2 = getTree(shape2->mBroadPhaseID).getFatAABB(getTreeNodeID(shape2->mBroadPhaseID));
+
+    // Check if the two AABBs are overlapping
+    return aabb1.testCollision(aabb2);
+}
+
+// Start a bulk insertion of collision shapes
+inline void AABBTreeAlgorithm::beginBulkInsertion() {
+    for (int t=0; t<NB_TREES; t++) {
+        mTrees[t]->beginBulkInsertion();
+    }
+}
+
+// End a bulk insertion of collision shapes and rebuild the AABB trees
+inline void AABBTreeAlgorithm::endBulkInsertion() {
+    for (int t=0; t<NB_TREES; t++) {
+        mTrees[t]->endBulkInsertion();
+    }
+    mNbStaticTreeChanges = 0;
+}
+
+// Rebuild the AABB trees
+inline void AABBTreeAlgorithm::rebuild() {
+    for (int t=0; t<NB_TREES; t++) {
+        mTrees[t]->rebuild();
+    }
+    mNbStaticTreeChanges = 0;
+}
+
+// Set the number of tree leaves that are optimized at each simulation step
+/// The AABB trees are only balanced when collision shapes are inserted into them. When
+/// the bodies move during a long time, the quality of the trees decreases and the
+/// collision queries become slower. With a non-zero budget, small sub-trees of the trees
+/// of the kinematic and dynamic bodies are rebuilt at each step until the given number
+/// of leaves have been processed. The cost of the optimization is proportional to the
+/// budget. By default, the budget is zero (no optimization).
+/**
+ * @param nbLeaves Number of tree leaves (collision shapes) processed at each step
+ */
+inline void AABBTreeAlgorithm::setNbTreeLeavesToOptimizePerStep(uint nbLeaves) {
+    mNbTreeLeavesToOptimizePerStep = nbLeaves;
+}
+
+// Return the number of tree leaves that are optimized at each simulation step
+inline uint AABBTreeAlgorithm::getNbTreeLeavesToOptimizePerStep() const {
+    return mNbTreeLeavesToOptimizePerStep;
+}
+
+// Compute the cost of the dynamic AABB tree (a measure of its quality)
+/// This is the Surface Area Heuristic (SAH) cost of the tree of the dynamic bodies. A
+/// lower cost means faster collision queries. This can be used to monitor the quality
+/// of the tree and decide when to rebuild it or to tune the optimization budget. The
+/// cost is computed by visiting all the nodes of the tree.
+inline decimal AABBTreeAlgorithm::computeTreeCost() const {
+    return mDynamicAABBTree.computeCost();
+}
+
+}
+
+#endif
@@ -25,268 +25,372 @@
 
 // Libraries
 #include "BroadPhaseAlgorithm.h"
+#include <algorithm>
 #include "collision/CollisionDetection.h"
 #include "engine/Profiler.h"
 
 // We want to use the ReactPhysics3D namespace
 using namespace reactphysics3d;
 
+// Initialization of static variables
+const uint BroadPhaseAlgorithm::NB_MOVED_SHAPES_PER_QUERY;
+
 // Constructor
 BroadPhaseAlgorithm::BroadPhaseAlgorithm(CollisionDetection& collisionDetection)
-                    :mDynamicAABBTree(DYNAMIC_TREE_AABB_GAP), mNbMovedShapes(0), mNbAllocatedMovedShapes(8),
-                     mNbNonUsedMovedShapes(0), mNbPotentialPairs(0), mNbAllocatedPotentialPairs(8),
-                     mCollisionDetection(collisionDetection) {
+                    :mNbMovedShapes(0), mNbAllocatedMovedShapes(8),
+                     mCollisionDetection(collisionDetection), mStep(0) {
 
-    // Allocate memory for the array of non-static proxy shapes IDs
-    mMovedShapes = (int*) malloc(mNbAllocatedMovedShapes * sizeof(int));
+    // Allocate memory for the array of moved proxy shapes
+    mMovedShapes = (ProxyShape**) malloc(mNbAllocatedMovedShapes * sizeof(ProxyShape*));
     assert(mMovedShapes != NULL);
-
-    // Allocate memory for the array of potential overlapping pairs
-    mPotentialPairs = (BroadPhasePair*) malloc(mNbAllocatedPotentialPairs * sizeof(BroadPhasePair));
-    assert(mPotentialPairs != NULL);
 }
 
 // Destructor
 BroadPhaseAlgorithm::~BroadPhaseAlgorithm() {
 
-    // Release the memory for the array of non-static proxy shapes IDs
+    // Release the memory for the array of moved proxy shapes
     free(mMovedShapes);
-
-    // Release the memory for the array of potential overlapping pairs
-    free(mPotentialPairs);
 }
 
-// Add a collision shape in the array of shapes that have moved in the last simulation step
-// and that need to be tested again for broad-phase overlapping.
-void BroadPhaseAlgorithm::addMovedCollisionShape(int broadPhaseID) {
-
-    // Allocate more elements in the array of shapes that have moved if necessary
-    if (mNbAllocatedMovedShapes == mNbMovedShapes) {
-        mNbAllocatedMovedShapes *= 2;
-        int* oldArray = mMovedShapes;
-        mMovedShapes = (int*) malloc(mNbAllocatedMovedShapes * sizeof(int));
-        assert(mMovedShapes != NULL);
-        memcpy(mMovedShapes, oldArray, mNbMovedShapes * sizeof(int));
-        free(oldArray);
+// Compute the fat AABB of a proxy shape
+/// The AABB is inflated with a constant gap and extended in direction of the
+/// predicted motion of the shape.
+/**
+ * @param aabb AABB of the proxy shape
+ * @param motion Predicted motion of the shape
+ * @param gap Constant gap added on each side of the AABB
+ */
+AABB BroadPhaseAlgorithm::computeFatAABB(const AABB& aabb, const Vector3& motion, decimal gap) {
+
+    Vector3 min = aabb.getMin() - Vector3(gap, gap, gap);
+    Vector3 max = aabb.getMax() + Vector3(gap, gap, gap);
+    for (int i=0; i<3; i++) {
+        if (motion[i] < decimal(0.0)) {
+            min[i] += motion[i];
+        }
+        else {
+            max[i] += motion[i];
+        }
     }
 
-    // Store the broad-phase ID into the array of shapes that have moved
-    assert(mNbMovedShapes < mNbAllocatedMovedShapes);
-    assert(mMovedShapes != NULL);
-    mMovedShapes[mNbMovedShapes] = broadPhaseID;
-    mNbMovedShapes++;
+    return AABB(min, max);
 }
 
-// Remove a collision shape from the array of shapes that have moved in the last simulation step
-// and that need to be tested again for broad-phase overlapping.
-void BroadPhaseAlgorithm::removeMovedCollisionShape(int broadPhaseID) {
+// Initialize the motion of a proxy shape that is added into the broad-phase
+/// The fat AABB of a new shape is its AABB inflated with the constant gap
+/// DYNAMIC_TREE_AABB_GAP (or zero for a static shape).
+void BroadPhaseAlgorithm::initializeShapeMotion(ProxyShape* proxyShape, const AABB& aabb) {
 
-    assert(mNbNonUsedMovedShapes <= mNbMovedShapes);
+    proxyShape->mBroadPhaseDisplacement.setToZero();
+    proxyShape->mBroadPhaseAABBCenter = aabb.getCenter();
+    proxyShape->mBroadPhasePredictionSteps = DYNAMIC_TREE_AABB_LIN_GAP_MULTIPLIER;
+    proxyShape->mBroadPhaseUpdateStep = mStep;
+    proxyShape->mBroadPhaseFatAABBStep = mStep;
+}
 
-    // If less than the quarter of allocated elements of the non-static shapes IDs array
-    // are used, we release some allocated memory
-    if ((mNbMovedShapes - mNbNonUsedMovedShapes) < mNbAllocatedMovedShapes / 4 &&
-            mNbAllocatedMovedShapes > 8) {
+// Compute the adaptive fat AABB of a moving proxy shape
+/// The AABB is extended in direction of the estimated displacement per step of the
+/// shape multiplied by its number of predicted steps. The constant gap grows with
+/// the predicted motion from FAT_AABB_MIN_GAP to DYNAMIC_TREE_AABB_GAP so that
+/// slow shapes get tighter fat AABBs.
+AABB BroadPhaseAlgorithm::computeAdaptiveFatAABB(const ProxyShape* proxyShape, const AABB& aabb) {
 
-        mNbAllocatedMovedShapes /= 2;
-        int* oldArray = mMovedShapes;
-        mMovedShapes = (int*) malloc(mNbAllocatedMovedShapes * sizeof(int));
-        assert(mMovedShapes != NULL);
-        uint nbElements = 0;
-        for (uint i=0; i<mNbMovedShapes; i++) {
-            if (oldArray[i] != -1) {
-                mMovedShapes[nbElements] = oldArray[i];
-                nbElements++;
-            }
-        }
-        mNbMovedShapes = nbElements;
-        mNbNonUsedMovedShapes = 0;
-        free(oldArray);
+    const Vector3 motion = proxyShape->mBroadPhasePredictionSteps * proxyShape->mBroadPhaseDisplacement;
+    const decimal gap = std::min(DYNAMIC_TREE_AABB_GAP, FAT_AABB_MIN_GAP + motion.length());
+    return computeFatAABB(aabb, motion, gap);
+}
+
+// Update the motion of a proxy shape and compute its new fat AABB if needed
+/// The displacement of the shape per step is the displacement given by the linear
+/// velocity of its body if any, or else a running average of the displacement of the
+/// center of its AABB. When the shape leaves its fat AABB, its number of predicted
+/// steps is doubled if this happens too early (a fast shape) or halved if this happens
+/// late. A fat AABB that has become much larger than the current motion of the shape
+/// requires (the shape has slowed down) is also shrunk to avoid false overlapping pairs.
+/// The fat AABBs of the static shapes are not inflated.
+/**
+ * @param proxyShape The proxy shape that has moved
+ * @param aabb New AABB of the shape
+ * @param displacement Displacement of the body of the shape during the last step (or zero)
+ * @param isStatic True if the shape belongs to a static body
+ * @param forceReinsert True if the fat AABB must be computed again
+ * @param[in,out] fatAABB Current fat AABB of the shape (replaced by the new one if needed)
+ * @return True if the fat AABB has been computed again and the shape must be reinserted
+ */
+bool BroadPhaseAlgorithm::updateFatAABB(ProxyShape* proxyShape, const AABB& aabb,
+                                        const Vector3& displacement, bool isStatic,
+                                        bool forceReinsert, AABB& fatAABB) {
+
+    mStatistics.nbUpdatedShapes++;
+
+    if (isStatic) {
+        if (!forceReinsert && fatAABB.contains(aabb)) return false;
+        fatAABB = computeFatAABB(aabb, DYNAMIC_TREE_AABB_LIN_GAP_MULTIPLIER * displacement,
+                                 decimal(0.0));
+        mStatistics.nbReinsertedShapes++;
+        return true;
     }
 
-    // Remove the broad-phase ID from the array
-    for (uint i=0; i<mNbMovedShapes; i++) {
-        if (mMovedShapes[i] == broadPhaseID) {
-            mMovedShapes[i] = -1;
-            mNbNonUsedMovedShapes++;
-            break;
-        }
+    // Estimate the displacement of the shape per step
+    const Vector3 center = aabb.getCenter();
+    if (displacement != Vector3(0, 0, 0)) {
+        proxyShape->mBroadPhaseDisplacement = displacement;
     }
-}
+    else {
+        const uint nbSteps = std::max(mStep - proxyShape->mBroadPhaseUpdateStep, 1u);
+        const Vector3 stepDisplacement = (center - proxyShape->mBroadPhaseAABBCenter) / decimal(nbSteps);
+        proxyShape->mBroadPhaseDisplacement = decimal(0.5) * (proxyShape->mBroadPhaseDisplacement +
+                                                              stepDisplacement);
+    }
+    proxyShape->mBroadPhaseAABBCenter = center;
+    proxyShape->mBroadPhaseUpdateStep = mStep;
+
+    const uint nbStepsInFatAABB = mStep - proxyShape->mBroadPhaseFatAABBStep;
+    decimal& predictionSteps = proxyShape->mBroadPhasePredictionSteps;
+
+    if (!forceReinsert && fatAABB.contains(aabb)) {
+
+        // Shrink the fat AABB if it is much larger than needed along an axis
+        if (nbStepsInFatAABB <= FAT_AABB_TARGET_NB_STEPS) return false;
+        const AABB neededAABB = computeAdaptiveFatAABB(proxyShape, aabb);
+        const Vector3 extent = aabb.getExtent();
+        const Vector3 fatSlack = fatAABB.getExtent() - extent;
+        const Vector3 neededSlack = neededAABB.getExtent() - extent;
+        bool isTooLarge = false;
+        for (int i=0; i<3; i++) {
+            isTooLarge = isTooLarge || (fatSlack[i] > decimal(4.0) * neededSlack[i] &&
+                                        fatSlack[i] > decimal(4.0) * DYNAMIC_TREE_AABB_GAP);
+        }
+        if (!isTooLarge) return false;
 
-// Add a proxy collision shape into the broad-phase collision detection
-void BroadPhaseAlgorithm::addProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb) {
+        predictionSteps = std::max(predictionSteps * decimal(0.5), FAT_AABB_MIN_PREDICTION_STEPS);
+        mStatistics.nbShrunkShapes++;
+    }
+    else if (!forceReinsert) {
 
-    // Add the collision shape into the dynamic AABB tree and get its broad-phase ID
-    int nodeId = mDynamicAABBTree.addObject(aabb, proxyShape);
+        // The shape has left its fat AABB
+        if (nbStepsInFatAABB < FAT_AABB_TARGET_NB_STEPS) {
+            predictionSteps = std::min(predictionSteps * decimal(2.0), FAT_AABB_MAX_PREDICTION_STEPS);
+        }
+        else if (nbStepsInFatAABB > 4 * FAT_AABB_TARGET_NB_STEPS) {
+            predictionSteps = std::max(predictionSteps * decimal(0.5), FAT_AABB_MIN_PREDICTION_STEPS);
+        }
+    }
 
-    // Set the broad-phase ID of the proxy shape
-    proxyShape->mBroadPhaseID = nodeId;
+    fatAABB = computeAdaptiveFatAABB(proxyShape, aabb);
+    proxyShape->mBroadPhaseFatAABBStep = mStep;
+    mStatistics.nbReinsertedShapes++;
 
-    // Add the collision shape into the array of bodies that have moved (or have been created)
-    // during the last simulation step
-    addMovedCollisionShape(proxyShape->mBroadPhaseID);
+    return true;
 }
 
-// Remove a proxy collision shape from the broad-phase collision detection
-void BroadPhaseAlgorithm::removeProxyCollisionShape(ProxyShape* proxyShape) {
+// Add a collision shape in the array of shapes that have moved in the last simulation step
+// and that need to be tested again for broad-phase overlapping.
+/// A shape that is already in the array is not added again.
+void BroadPhaseAlgorithm::addMovedCollisionShape(ProxyShape* proxyShape) {
 
-    int broadPhaseID = proxyShape->mBroadPhaseID;
+    if (proxyShape->mMovedShapeIndex >= 0) return;
 
-    // Remove the collision shape from the dynamic AABB tree
-    mDynamicAABBTree.removeObject(broadPhaseID);
+    // Allocate more elements in the array of shapes that have moved if necessary
+    if (mNbAllocatedMovedShapes == mNbMovedShapes) {
+        mNbAllocatedMovedShapes *= 2;
+        ProxyShape** oldArray = mMovedShapes;
+        mMovedShapes = (ProxyShape**) malloc(mNbAllocatedMovedShapes * sizeof(ProxyShape*));
+        assert(mMovedShapes != NULL);
+        memcpy(mMovedShapes, oldArray, mNbMovedShapes * sizeof(ProxyShape*));
+        free(oldArray);
+    }
 
-    // Remove the collision shape into the array of shapes that have moved (or have been created)
-    // during the last simulation step
-    removeMovedCollisionShape(broadPhaseID);
+    // Store the shape into the array of shapes that have moved
+    assert(mNbMovedShapes < mNbAllocatedMovedShapes);
+    assert(mMovedShapes != NULL);
+    mMovedShapes[mNbMovedShapes] = proxyShape;
+    proxyShape->mMovedShapeIndex = static_cast<int>(mNbMovedShapes);
+    mNbMovedShapes++;
 }
 
-// Notify the broad-phase that a collision shape has moved and need to be updated
-void BroadPhaseAlgorithm::updateProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb,
-                                                    const Vector3& displacement, bool forceReinsert) {
+// Remove a collision shape from the array of shapes that have moved in the last simulation step
+// and that need to be tested again for broad-phase overlapping.
+/// The last shape of the array is moved at the index of the removed shape so that
+/// removing a shape takes constant time.
+void BroadPhaseAlgorithm::removeMovedCollisionShape(ProxyShape* proxyShape) {
 
-    int broadPhaseID = proxyShape->mBroadPhaseID;
+    const int index = proxyShape->mMovedShapeIndex;
+    if (index < 0) return;
 
-    assert(broadPhaseID >= 0);
+    assert(static_cast<uint>(index) < mNbMovedShapes);
+    assert(mMovedShapes[index] == proxyShape);
 
-    // Update the dynamic AABB tree according to the movement of the collision shape
-    bool hasBeenReInserted = mDynamicAABBTree.updateObject(broadPhaseID, aabb, displacement, forceReinsert);
+    // Move the last shape of the array at the index of the removed shape
+    mNbMovedShapes--;
+    mMovedShapes[index] = mMovedShapes[mNbMovedShapes];
+    mMovedShapes[index]->mMovedShapeIndex = index;
+    proxyShape->mMovedShapeIndex = -1;
 
-    // If the collision shape has moved out of its fat AABB (and therefore has been reinserted
-    // into the tree).
-    if (hasBeenReInserted) {
+    // If less than the quarter of allocated elements of the array are used, we release
+    // some allocated memory
+    if (mNbMovedShapes < mNbAllocatedMovedShapes / 4 && mNbAllocatedMovedShapes > 8) {
 
-        // Add the collision shape into the array of shapes that have moved (or have been created)
-        // during the last simulation step
-        addMovedCollisionShape(broadPhaseID);
+        mNbAllocatedMovedShapes /= 2;
+        ProxyShape** oldArray = mMovedShapes;
+        mMovedShapes = (ProxyShape**) malloc(mNbAllocatedMovedShapes * sizeof(ProxyShape*));
+        assert(mMovedShapes != NULL);
+        memcpy(mMovedShapes, oldArray, mNbMovedShapes * sizeof(ProxyShape*));
+        free(oldArray);
     }
 }
 
 // Compute all the overlapping pairs of collision shapes
-void BroadPhaseAlgorithm::computeOverlappingPairs() {
+/// The broad-phase is queried with the shapes that have moved concurrently with the threads
+/// of a thread pool. Each thread stores the potential pairs it finds in its own buffer.
+/// The buffers are then sorted concurrently and merged to report the unique pairs
+/// to the collision detection in increasing order of the broad-phase IDs. Therefore,
+/// the result does not depend on the number of threads.
+/**
+ * @param threadPool Pool of threads used to query the broad-phase and sort the pairs
+ */
+void BroadPhaseAlgorithm::computeOverlappingPairs(ThreadPool& threadPool) {
+
+    PROFILE("BroadPhaseAlgorithm::computeOverlappingPairs()");
+
+    // Update the data structure of the broad-phase before the queries
+    prepareQueries();
+
+    // Create the missing buffers of potential pairs and clear the pairs of the previous frame
+    const uint nbThreads = threadPool.getNbThreads();
+    if (mThreadPotentialPairs.size() < nbThreads) {
+        mThreadPotentialPairs.resize(nbThreads);
+    }
+    for (uint t=0; t<mThreadPotentialPairs.size(); t++) {
+        mThreadPotentialPairs[t].clear();
+    }
 
-    // Reset the potential overlapping pairs
-    mNbPotentialPairs = 0;
+    // Query the broad-phase with the collision shapes that have moved (or have been created)
+    // during the last simulation step
+    const uint nbItems = (mNbMovedShapes + NB_MOVED_SHAPES_PER_QUERY - 1) / NB_MOVED_SHAPES_PER_QUERY;
+    BroadPhaseQueryTask queryTask(*this);
+    threadPool.parallelFor(nbItems, queryTask);
 
-    // For all collision shapes that have moved (or have been created) during the
+    // Reset the array of collision shapes that have move (or have been created) during the
     // last simulation step
     for (uint i=0; i<mNbMovedShapes; i++) {
-        int shapeID = mMovedShapes[i];
+        mMovedShapes[i]->mMovedShapeIndex = -1;
+    }
+    mNbMovedShapes = 0;
 
-        if (shapeID == -1) continue;
+    // Sort the arrays of potential overlapping pairs in order to remove duplicate pairs
+    BroadPhaseSortTask sortTask(*this);
+    threadPool.parallelFor(static_cast<uint>(mThreadPotentialPairs.size()), sortTask);
 
-        AABBOverlapCallback callback(*this, shapeID);
+    // Report the unique overlapping pairs
+    reportPotentialPairs();
 
-        // Get the AABB of the shape
-        const AABB& shapeAABB = mDynamicAABBTree.getFatAABB(shapeID);
+    // Keep the counters of this step
+    mLastStepStatistics = mStatistics;
+    mStatistics = BroadPhaseStatistics();
+    mStep++;
+}
 
-        // Ask the dynamic AABB tree to report all collision shapes that overlap with
-        // this AABB. The method BroadPhase::notifiyOverlappingPair() will be called
-        // by the dynamic AABB tree for each potential overlapping pair.
-        mDynamicAABBTree.reportAllShapesOverlappingWithAABB(shapeAABB, callback);
-    }
+// Query the broad-phase with a range of the moved collision shapes
+/**
+ * @param threadIndex Index of the thread that executes the queries
+ * @param firstMovedShape Index of the first moved shape to query
+ * @param endMovedShape Index after the last moved shape to query
+ */
+void BroadPhaseAlgorithm::queryMovedShapes(uint threadIndex, uint firstMovedShape,
+                                           uint endMovedShape) {
 
-    // Reset the array of collision shapes that have move (or have been created) during the
-    // last simulation step
-    mNbMovedShapes = 0;
+    for (uint i=firstMovedShape; i<endMovedShape; i++) {
 
-    // Sort the array of potential overlapping pairs in order to remove duplicate pairs
-    std::sort(mPotentialPairs, mPotentialPairs + mNbPotentialPairs, BroadPhasePair::smallerThan);
+        // Find the collision shapes that overlap with the shape. The method
+        // notifyOverlappingNodes() is called for each potential overlapping pair.
+        queryOverlappingShapes(threadIndex, mMovedShapes[i]->mBroadPhaseID);
+    }
+}
 
-    // Check all the potential overlapping pairs avoiding duplicates to report unique
-    // overlapping pairs
-    uint i=0;
-    while (i < mNbPotentialPairs) {
+// Report the unique potential pairs of all the threads to the collision detection
+/// The sorted arrays of potential pairs of the threads are merged so that the pairs
+/// are reported in increasing order and the duplicate pairs are skipped.
+void BroadPhaseAlgorithm::reportPotentialPairs() {
+
+    const uint nbThreads = static_cast<uint>(mThreadPotentialPairs.size());
+    mThreadMergeIndices.assign(nbThreads, 0);
+
+    const BroadPhasePair* lastPair = NULL;
+    while (true) {
+
+        // Find the smallest pair that has not been merged yet
+        int bestThread = -1;
+        for (uint t=0; t<nbThreads; t++) {
+            if (mThreadMergeIndices[t] == mThreadPotentialPairs[t].size()) continue;
+            if (bestThread < 0 ||
+                BroadPhasePair::smallerThan(mThreadPotentialPairs[t][mThreadMergeIndices[t]],
+                                            mThreadPotentialPairs[bestThread][mThreadMergeIndices[bestThread]])) {
+                bestThread = static_cast<int>(t);
+            }
+        }
+        if (bestThread < 0) break;
 
-        // Get a potential overlapping pair
-        BroadPhasePair* pair = mPotentialPairs + i;
-        i++;
+        const BroadPhasePair* pair = &mThreadPotentialPairs[bestThread][mThreadMergeIndices[bestThread]];
+        mThreadMergeIndices[bestThread]++;
 
         assert(pair->collisionShape1ID != pair->collisionShape2ID);
 
+        // Skip the duplicate overlapping pairs
+        if (lastPair != NULL && lastPair->collisionShape1ID == pair->collisionShape1ID &&
+            lastPair->collisionShape2ID == pair->collisionShape2ID) {
+            continue;
+        }
+        lastPair = pair;
+
         // Get the two collision shapes of the pair
-        ProxyShape* shape1 = static_cast<ProxyShape*>(mDynamicAABBTree.getNodeDataPointer(pair->collisionShape1ID));
-        ProxyShape* shape2 = static_cast<ProxyShape*>(mDynamicAABBTree.getNodeDataPointer(pair->collisionShape2ID));
+        ProxyShape* shape1 = getProxyShape(pair->collisionShape1ID);
+        ProxyShape* shape2 = getProxyShape(pair->collisionShape2ID);
 
         // Notify the collision detection about the overlapping pair
         mCollisionDetection.broadPhaseNotifyOverlappingPair(shape1, shape2);
-
-        // Skip the duplicate overlapping pairs
-        while (i < mNbPotentialPairs) {
-
-            // Get the next pair
-            BroadPhasePair* nextPair = mPotentialPairs + i;
-
-            // If the next pair is different from the previous one, we stop skipping pairs
-            if (nextPair->collisionShape1ID != pair->collisionShape1ID ||
-                nextPair->collisionShape2ID != pair->collisionShape2ID) {
-                break;
-            }
-            i++;
-        }
+        mStatistics.nbPotentialPairs++;
     }
 
-    // If the number of potential overlapping pairs is less than the quarter of allocated
-    // number of overlapping pairs
-    if (mNbPotentialPairs < mNbAllocatedPotentialPairs / 4 && mNbPotentialPairs > 8) {
-
-        // Reduce the number of allocated potential overlapping pairs
-        BroadPhasePair* oldPairs = mPotentialPairs;
-        mNbAllocatedPotentialPairs /= 2;
-        mPotentialPairs = (BroadPhasePair*) malloc(mNbAllocatedPotentialPairs * sizeof(BroadPhasePair));
-        assert(mPotentialPairs);
-        memcpy(mPotentialPairs, oldPairs, mNbPotentialPairs * sizeof(BroadPhasePair));
-        free(oldPairs);
+    // Release some memory if the arrays of potential pairs are much larger than needed
+    for (uint t=0; t<nbThreads; t++) {
+        std::vector<BroadPhasePair>& pairs = mThreadPotentialPairs[t];
+        if (pairs.size() < pairs.capacity() / 4 && pairs.capacity() > 8) {
+            std::vector<BroadPhasePair>(pairs.begin(), pairs.end()).swap(pairs);
+        }
     }
 }
 
-// Notify the broad-phase about a potential overlapping pair in the dynamic AABB tree
-void BroadPhaseAlgorithm::notifyOverlappingNodes(int node1ID, int node2ID) {
+// Notify the broad-phase about a potential overlapping pair found by a thread
+/**
+ * @param threadIndex Index of the thread that has found the pair
+ * @param node1ID Broad-phase ID of the first collision shape
+ * @param node2ID Broad-phase ID of the second collision shape
+ */
+void BroadPhaseAlgorithm::notifyOverlappingNodes(uint threadIndex, int node1ID, int node2ID) {
 
     // If both the nodes are the same, we do not create store the overlapping pair
     if (node1ID == node2ID) return;
 
-    // If we need to allocate more memory for the array of potential overlapping pairs
-    if (mNbPotentialPairs == mNbAllocatedPotentialPairs) {
-
-        // Allocate more memory for the array of potential pairs
-        BroadPhasePair* oldPairs = mPotentialPairs;
-        mNbAllocatedPotentialPairs *= 2;
-        mPotentialPairs = (BroadPhasePair*) malloc(mNbAllocatedPotentialPairs * sizeof(BroadPhasePair));
-        assert(mPotentialPairs);
-        memcpy(mPotentialPairs, oldPairs, mNbPotentialPairs * sizeof(BroadPhasePair));
-        free(oldPairs);
-    }
-
-    // Add the new potential pair into the array of potential overlapping pairs
-    mPotentialPairs[mNbPotentialPairs].collisionShape1ID = std::min(node1ID, node2ID);
-    mPotentialPairs[mNbPotentialPairs].collisionShape2ID = std::max(node1ID, node2ID);
-    mNbPotentialPairs++;
+    // Add the new potential pair into the array of potential overlapping pairs of the thread
+    BroadPhasePair pair;
+    pair.collisionShape1ID = std::min(node1ID, node2ID);
+    pair.collisionShape2ID = std::max(node1ID, node2ID);
+    mThreadPotentialPairs[threadIndex].push_back(pair);
 }
 
-// Called when a overlapping node has been found during the call to
-// DynamicAABBTree:reportAllShapesOverlappingWithAABB()
-void AABBOverlapCallback::notifyOverlappingNode(int nodeId) {
+// Query the broad-phase with the moved shapes of a given item
+void BroadPhaseQueryTask::execute(uint threadIndex, uint itemIndex) {
 
-    mBroadPhaseAlgorithm.notifyOverlappingNodes(mReferenceNodeId, nodeId);
+    const uint firstMovedShape = itemIndex * BroadPhaseAlgorithm::NB_MOVED_SHAPES_PER_QUERY;
+    const uint endMovedShape = std::min(firstMovedShape + BroadPhaseAlgorithm::NB_MOVED_SHAPES_PER_QUERY,
+                                        mBroadPhaseAlgorithm.mNbMovedShapes);
+    mBroadPhaseAlgorithm.queryMovedShapes(threadIndex, firstMovedShape, endMovedShape);
 }
 
-// Called for a broad-phase shape that has to be tested for raycast
-decimal BroadPhaseRaycastCallback::raycastBroadPhaseShape(int32 nodeId, const Ray& ray) {
-
-    decimal hitFraction = decimal(-1.0);
-
-    // Get the proxy shape from the node
-    ProxyShape* proxyShape = static_cast<ProxyShape*>(mDynamicAABBTree.getNodeDataPointer(nodeId));
-
-    // Check if the raycast filtering mask allows raycast against this shape
-    if ((mRaycastWithCategoryMaskBits & proxyShape->getCollisionCategoryBits()) != 0) {
-
-        // Ask the collision detection to perform a ray cast test against
-        // the proxy shape of this node because the ray is overlapping
-        // with the shape in the broad-phase
-        hitFraction = mRaycastTest.raycastAgainstShape(proxyShape, ray);
-    }
+// Sort the potential pairs of the buffer of a given thread
+void BroadPhaseSortTask::execute(uint threadIndex, uint itemIndex) {
 
-    return hitFraction;
+    std::vector<BroadPhasePair>& pairs = mBroadPhaseAlgorithm.mThreadPotentialPairs[itemIndex];
+    std::sort(pairs.begin(), pairs.end(), BroadPhasePair::smallerThan);
 }
@@ -30,8 +30,8 @@
 #include <vector>
 #include "body/CollisionBody.h"
 #include "collision/ProxyShape.h"
-#include "DynamicAABBTree.h"
 #include "engine/Profiler.h"
+#include "engine/ThreadPool.h"
 
 /// Namespace ReactPhysics3D
 namespace reactphysics3d {
@@ -39,6 +39,7 @@ namespace reactphysics3d {
 // Declarations
 class CollisionDetection;
 class BroadPhaseAlgorithm;
+struct RaycastTest;
 
 // Structure BroadPhasePair
 /**
@@ -61,80 +62,126 @@ struct BroadPhasePair {
     static bool smallerThan(const BroadPhasePair& pair1, const BroadPhasePair& pair2);
 };
 
-// class AABBOverlapCallback
-class AABBOverlapCallback : public DynamicAABBTreeOverlapCallback {
+// Structure BroadPhaseStatistics
+/**
+ * Counters of the broad-phase collision detection during a simulation step. Each
+ * reinsertion of a shape costs an update of the broad-phase data structure and each
+ * potential pair that is not in contact costs a narrow-phase test. Those counters can
+ * be used to check how well the fat AABBs of the moving shapes fit their motion.
+ */
+struct BroadPhaseStatistics {
 
-    private:
+    // -------------------- Attributes -------------------- //
 
-        BroadPhaseAlgorithm& mBroadPhaseAlgorithm;
+    /// Number of updates of collision shapes that have moved
+    uint nbUpdatedShapes;
 
-        int mReferenceNodeId;
+    /// Number of collision shapes whose fat AABB has been computed again
+    uint nbReinsertedShapes;
 
-    public:
+    /// Number of reinsertions that only shrank the fat AABB of a slowed down shape
+    uint nbShrunkShapes;
 
-        // Constructor
-        AABBOverlapCallback(BroadPhaseAlgorithm& broadPhaseAlgo, int referenceNodeId)
-             : mBroadPhaseAlgorithm(broadPhaseAlgo), mReferenceNodeId(referenceNodeId) {
+    /// Number of unique potential overlapping pairs reported to the collision detection
+    uint nbPotentialPairs;
 
-        }
+    // -------------------- Methods -------------------- //
 
-        // Called when a overlapping node has been found during the call to
-        // DynamicAABBTree:reportAllShapesOverlappingWithAABB()
-        virtual void notifyOverlappingNode(int nodeId);
+    /// Constructor
+    BroadPhaseStatistics()
+        : nbUpdatedShapes(0), nbReinsertedShapes(0), nbShrunkShapes(0), nbPotentialPairs(0) {
 
+    }
 };
 
-// Class BroadPhaseRaycastCallback
+// Class BroadPhaseQueryTask
 /**
- * Callback called when the AABB of a leaf node is hit by a ray the
- * broad-phase Dynamic AABB Tree.
+ * This class is a parallel task that queries the broad-phase with the collision
+ * shapes that have moved. Each item of the task is a group of consecutive moved
+ * shapes. The potential overlapping pairs that are found are stored in the buffer
+ * of the thread that executes the item.
  */
-class BroadPhaseRaycastCallback : public DynamicAABBTreeRaycastCallback {
+class BroadPhaseQueryTask : public ParallelTask {
 
     private :
 
-        const DynamicAABBTree& mDynamicAABBTree;
+        // -------------------- Attributes -------------------- //
 
-        unsigned short mRaycastWithCategoryMaskBits;
+        /// Reference to the broad-phase
+        BroadPhaseAlgorithm& mBroadPhaseAlgorithm;
 
-        RaycastTest& mRaycastTest;
+    public :
 
-    public:
+        // -------------------- Methods -------------------- //
 
-        // Constructor
-        BroadPhaseRaycastCallback(const DynamicAABBTree& dynamicAABBTree, unsigned short raycastWithCategoryMaskBits,
-                                  RaycastTest& raycastTest)
-            : mDynamicAABBTree(dynamicAABBTree), mRaycastWithCategoryMaskBits(raycastWithCategoryMaskBits),
-              mRaycastTest(raycastTest) {
+        /// Constructor
+        BroadPhaseQueryTask(BroadPhaseAlgorithm& broadPhaseAlgorithm)
+            : mBroadPhaseAlgorithm(broadPhaseAlgorithm) {
 
         }
 
-        // Called for a broad-phase shape that has to be tested for raycast
-        virtual decimal raycastBroadPhaseShape(int32 nodeId, const Ray& ray);
+        /// Query the broad-phase with the moved shapes of a given item
+        virtual void execute(uint threadIndex, uint itemIndex);
+};
+
+// Class BroadPhaseSortTask
+/**
+ * This class is a parallel task that sorts the buffers of potential overlapping
+ * pairs of the threads. Each item of the task is the buffer of a thread.
+ */
+class BroadPhaseSortTask : public ParallelTask {
 
+    private :
+
+        // -------------------- Attributes -------------------- //
+
+        /// Reference to the broad-phase
+        BroadPhaseAlgorithm& mBroadPhaseAlgorithm;
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        BroadPhaseSortTask(BroadPhaseAlgorithm& broadPhaseAlgorithm)
+            : mBroadPhaseAlgorithm(broadPhaseAlgorithm) {
+
+        }
+
+        /// Sort the potential pairs of the buffer of a given thread
+        virtual void execute(uint threadIndex, uint itemIndex);
 };
 
 // Class BroadPhaseAlgorithm
 /**
- * This class represents the broad-phase collision detection. The
+ * This abstract class represents the broad-phase collision detection. The
  * goal of the broad-phase collision detection is to compute the pairs of proxy shapes
  * that have their AABBs overlapping. Only those pairs of bodies will be tested
- * later for collision during the narrow-phase collision detection. A dynamic AABB
- * tree data structure is used for fast broad-phase collision detection.
+ * later for collision during the narrow-phase collision detection. This class
+ * keeps track of the proxy shapes that have moved since the last simulation step and
+ * computes their overlapping pairs (in parallel). The data structure used to find the
+ * shapes that overlap with a given shape is implemented by the concrete classes
+ * (AABBTreeAlgorithm, SweepAndPruneAlgorithm and SpatialHashAlgorithm). The broad-phase
+ * ID of a proxy shape is given by the concrete class and must be a non-negative integer.
  */
 class BroadPhaseAlgorithm {
 
+    public :
+
+        // -------------------- Constants -------------------- //
+
+        /// Number of moved collision shapes in an item of the parallel queries
+        static const uint NB_MOVED_SHAPES_PER_QUERY = 32;
+
     protected :
 
         // -------------------- Attributes -------------------- //
 
-        /// Dynamic AABB tree
-        DynamicAABBTree mDynamicAABBTree;
-
-        /// Array with the broad-phase IDs of all collision shapes that have moved (or have been
-        /// created) during the last simulation step. Those are the shapes that need to be tested
-        /// for overlapping in the next simulation step.
-        int* mMovedShapes;
+        /// Array with all the collision shapes that have moved (or have been created) during
+        /// the last simulation step. Those are the shapes that need to be tested for
+        /// overlapping in the next simulation step. Each shape stores its index in this array
+        /// so that it can be added only once and removed in constant time.
+        ProxyShape** mMovedShapes;
 
         /// Number of collision shapes in the array of shapes that have moved during the last
         /// simulation step.
@@ -144,22 +191,25 @@ class BroadPhaseAlgorithm {
         /// simulation step.
         uint mNbAllocatedMovedShapes;
 
-        /// Number of non-used elements in the array of shapes that have moved during the last
-        /// simulation step.
-        uint mNbNonUsedMovedShapes;
-
-        /// Temporary array of potential overlapping pairs (with potential duplicates)
-        BroadPhasePair* mPotentialPairs;
-
-        /// Number of potential overlapping pairs
-        uint mNbPotentialPairs;
+        /// Temporary arrays of potential overlapping pairs (with potential duplicates)
+        /// found by each thread
+        std::vector<std::vector<BroadPhasePair> > mThreadPotentialPairs;
 
-        /// Number of allocated elements for the array of potential overlapping pairs
-        uint mNbAllocatedPotentialPairs;
+        /// Index of the next pair to merge in the array of potential pairs of each thread
+        std::vector<uint> mThreadMergeIndices;
 
         /// Reference to the collision detection object
         CollisionDetection& mCollisionDetection;
-        
+
+        /// Number of times the overlapping pairs have been computed
+        uint mStep;
+
+        /// Counters of the current step
+        BroadPhaseStatistics mStatistics;
+
+        /// Counters of the last step
+        BroadPhaseStatistics mLastStepStatistics;
+
         // -------------------- Methods -------------------- //
 
         /// Private copy-constructor
@@ -168,6 +218,34 @@ class BroadPhaseAlgorithm {
         /// Private assignment operator
         BroadPhaseAlgorithm& operator=(const BroadPhaseAlgorithm& algorithm);
 
+        /// Query the broad-phase with a range of the moved collision shapes
+        void queryMovedShapes(uint threadIndex, uint firstMovedShape, uint endMovedShape);
+
+        /// Report the unique potential pairs of all the threads to the collision detection
+        void reportPotentialPairs();
+
+        /// Compute the fat AABB of a proxy shape
+        static AABB computeFatAABB(const AABB& aabb, const Vector3& displacement, decimal gap);
+
+        /// Initialize the motion of a proxy shape that is added into the broad-phase
+        void initializeShapeMotion(ProxyShape* proxyShape, const AABB& aabb);
+
+        /// Compute the adaptive fat AABB of a moving proxy shape
+        static AABB computeAdaptiveFatAABB(const ProxyShape* proxyShape, const AABB& aabb);
+
+        /// Update the motion of a proxy shape and compute its new fat AABB if needed
+        bool updateFatAABB(ProxyShape* proxyShape, const AABB& aabb, const Vector3& displacement,
+                           bool isStatic, bool forceReinsert, AABB& fatAABB);
+
+        /// Update the data structure before it is queried with the moved collision shapes
+        virtual void prepareQueries()=0;
+
+        /// Find all the collision shapes that overlap with a given moved collision shape
+        virtual void queryOverlappingShapes(uint threadIndex, int broadPhaseID)=0;
+
+        /// Return the proxy shape of a given broad-phase ID
+        virtual ProxyShape* getProxyShape(int broadPhaseID) const=0;
+
     public :
 
         // -------------------- Methods -------------------- //
@@ -176,38 +254,59 @@ class BroadPhaseAlgorithm {
         BroadPhaseAlgorithm(CollisionDetection& collisionDetection);
 
         /// Destructor
-        ~BroadPhaseAlgorithm();
+        virtual ~BroadPhaseAlgorithm();
         
         /// Add a proxy collision shape into the broad-phase collision detection
-        void addProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb);
+        virtual void addProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb)=0;
 
         /// Remove a proxy collision shape from the broad-phase collision detection
-        void removeProxyCollisionShape(ProxyShape* proxyShape);
+        virtual void removeProxyCollisionShape(ProxyShape* proxyShape)=0;
 
         /// Notify the broad-phase that a collision shape has moved and need to be updated
-        void updateProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb,
-                                       const Vector3& displacement, bool forceReinsert = false);
+        virtual void updateProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb,
+                                               const Vector3& displacement, bool forceReinsert = false)=0;
 
         /// Add a collision shape in the array of shapes that have moved in the last simulation step
         /// and that need to be tested again for broad-phase overlapping.
-        void addMovedCollisionShape(int broadPhaseID);
+        void addMovedCollisionShape(ProxyShape* proxyShape);
 
         /// Remove a collision shape from the array of shapes that have moved in the last simulation
         /// step and that need to be tested again for broad-phase overlapping.
-        void removeMovedCollisionShape(int broadPhaseID);
+        void removeMovedCollisionShape(ProxyShape* proxyShape);
 
-        /// Notify the broad-phase about a potential overlapping pair in the dynamic AABB tree
-        void notifyOverlappingNodes(int broadPhaseId1, int broadPhaseId2);
+        /// Notify the broad-phase about a potential overlapping pair found by a thread
+        void notifyOverlappingNodes(uint threadIndex, int broadPhaseId1, int broadPhaseId2);
 
         /// Compute all the overlapping pairs of collision shapes
-        void computeOverlappingPairs();
+        void computeOverlappingPairs(ThreadPool& threadPool);
 
         /// Return true if the two broad-phase collision shapes are overlapping
-        bool testOverlappingShapes(const ProxyShape* shape1, const ProxyShape* shape2) const;
+        virtual bool testOverlappingShapes(const ProxyShape* shape1, const ProxyShape* shape2) const=0;
 
         /// Ray casting method
-        void raycast(const Ray& ray, RaycastTest& raycastTest,
-                     unsigned short raycastWithCategoryMaskBits) const;
+        virtual void raycast(const Ray& ray, RaycastTest& raycastTest,
+                             unsigned short raycastWithCategoryMaskBits) const=0;
+
+        /// Find all the proxy shapes whose fat AABB overlaps with a given AABB
+        virtual void reportShapesOverlappingWithAABB(const AABB& aabb,
+                                                     std::vector<ProxyShape*>& overlappingShapes) const=0;
+
+        /// Start a bulk insertion of collision shapes
+        virtual void beginBulkInsertion()=0;
+
+        /// End a bulk insertion of collision shapes and rebuild the data structure
+        virtual void endBulkInsertion()=0;
+
+        /// Rebuild the data structure of the broad-phase
+        virtual void rebuild()=0;
+
+        /// Return the counters of the last simulation step
+        const BroadPhaseStatistics& getLastStepStatistics() const;
+
+        // -------------------- Friendship -------------------- //
+
+        friend class BroadPhaseQueryTask;
+        friend class BroadPhaseSortTask;
 };
 
 // Method used to compare two pairs for sorting algorithm
@@ -220,29 +319,11 @@ inline bool BroadPhasePair::smallerThan(const BroadPhasePair& pair1, const Broad
     return false;
 }
 
-// Return true if the two broad-phase collision shapes are overlapping
-inline bool BroadPhaseAlgorithm::testOverlappingShapes(const ProxyShape* shape1,
-                                                       const ProxyShape* shape2) const {
-    // Get the two AABBs of the collision shapes
-    const AABB& aabb1 = mDynamicAABBTree.getFatAABB(shape1->mBroadPhaseID);
-    const AABB& aabb2 = mDynamicAABBTree.getFatAABB(shape2->mBroadPhaseID);
-
-    // Check if the two AABBs are overlapping
-    return aabb1.testCollision(aabb2);
-}
-
-// Ray casting method
-inline void BroadPhaseAlgorithm::raycast(const Ray& ray, RaycastTest& raycastTest,
-                                         unsigned short raycastWithCategoryMaskBits) const {
-
-    PROFILE("BroadPhaseAlgorithm::raycast()");
-
-    BroadPhaseRaycastCallback broadPhaseRaycastCallback(mDynamicAABBTree, raycastWithCategoryMaskBits, raycastTest);
-
-    mDynamicAABBTree.raycast(ray, broadPhaseRaycastCallback);
+// Return the counters of the last simulation step
+inline const BroadPhaseStatistics& BroadPhaseAlgorithm::getLastStepStatistics() const {
+    return mLastStepStatistics;
 }
 
 }
 
 #endif
-
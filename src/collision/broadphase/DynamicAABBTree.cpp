@@ -27,15 +27,94 @@
 #include "DynamicAABBTree.h"
 #include "BroadPhaseAlgorithm.h"
 #include "memory/Stack.h"
+#include "TreeRaycastQuery.h"
+#include "TreeBuilder.h"
 #include "engine/Profiler.h"
 
+#ifdef REACTPHYSICS3D_SSE_ENABLED
+#include <xmmintrin.h>
+#endif
+
 using namespace reactphysics3d;
 
 // Initialization of static variables
 const int TreeNode::NULL_TREE_NODE = -1;
 
+// Structure TreeOverlapQuery
+/**
+ * AABB of an overlap query prepared to be tested against the AABBs of the tree nodes.
+ * With SSE, the six comparisons between the query and a node AABB are done with two
+ * packed comparisons. The AABB of a node is loaded with two unaligned loads (at the
+ * minimum x and at the minimum z coordinates of the node AABB) so that the loads never
+ * read outside of the node AABB.
+ */
+struct TreeOverlapQuery {
+
+#ifdef REACTPHYSICS3D_SSE_ENABLED
+
+    /// Maximum coordinates of the query AABB (maxX, maxY, maxZ, +infinity)
+    __m128 maxCoordinates;
+
+    /// Minimum coordinates of the query AABB (-infinity, minX, minY, minZ)
+    __m128 minCoordinates;
+
+#else
+
+    /// Query AABB
+    const AABB* aabb;
+
+#endif
+
+    /// Constructor
+    TreeOverlapQuery(const AABB& queryAABB) {
+
+#ifdef REACTPHYSICS3D_SSE_ENABLED
+        const Vector3& min = queryAABB.getMin();
+        const Vector3& max = queryAABB.getMax();
+        maxCoordinates = _mm_setr_ps(max.x, max.y, max.z, DECIMAL_LARGEST);
+        minCoordinates = _mm_setr_ps(DECIMAL_SMALLEST, min.x, min.y, min.z);
+#else
+        aabb = &queryAABB;
+#endif
+    }
+
+    /// Return true if the query AABB overlaps with the AABB of a node
+    bool testOverlap(const AABB& nodeAABB) const {
+
+#ifdef REACTPHYSICS3D_SSE_ENABLED
+        static_assert(sizeof(AABB) == 6 * sizeof(float), "The AABB coordinates must be packed");
+        const float* coordinates = &nodeAABB.getMin().x;
+        const __m128 low = _mm_loadu_ps(coordinates);       // (minX, minY, minZ, maxX)
+        const __m128 high = _mm_loadu_ps(coordinates + 2);  // (minZ, maxX, maxY, maxZ)
+        const __m128 isOverlapping = _mm_and_ps(_mm_cmple_ps(low, maxCoordinates),
+                                                _mm_cmpge_ps(high, minCoordinates));
+        return _mm_movemask_ps(isOverlapping) == 0xF;
+#else
+        return aabb->testCollision(nodeAABB);
+#endif
+    }
+};
+
+// Structure DynamicTreeBuildTask
+/**
+ * Range of leaves for which a node has to be created when the tree is rebuilt.
+ */
+struct DynamicTreeBuildTask {
+
+    /// Range of leaves of the node
+    TreeBuildRange range;
+
+    /// ID of the parent node (or null for the root node)
+    int parentID;
+
+    /// Index of the node in the children of its parent
+    int childIndex;
+};
+
 // Constructor
-DynamicAABBTree::DynamicAABBTree(decimal extraAABBGap) : mExtraAABBGap(extraAABBGap) {
+DynamicAABBTree::DynamicAABBTree(decimal extraAABBGap)
+                : mExtraAABBGap(extraAABBGap), mIsBulkInsertionActive(false),
+                  mOptimizationNodeID(0) {
 
     init();
 }
@@ -141,8 +220,11 @@ int DynamicAABBTree::addObjectInternal(const AABB& aabb) {
     // Set the height of the node in the tree
     mNodes[nodeID].height = 0;
 
-    // Insert the new leaf node in the tree
-    insertLeafNode(nodeID);
+    // Insert the new leaf node in the tree (during a bulk insertion, the node is
+    // inserted when the tree is rebuilt at the end of the bulk insertion)
+    if (!mIsBulkInsertionActive) {
+        insertLeafNode(nodeID);
+    }
     assert(mNodes[nodeID].isLeaf());
 
     assert(nodeID >= 0);
@@ -158,7 +240,9 @@ void DynamicAABBTree::removeObject(int nodeID) {
     assert(mNodes[nodeID].isLeaf());
 
     // Remove the node from the tree
-    removeLeafNode(nodeID);
+    if (isLeafInTree(nodeID)) {
+        removeLeafNode(nodeID);
+    }
     releaseNode(nodeID);
 }
 
@@ -182,41 +266,325 @@ bool DynamicAABBTree::updateObject(int nodeID, const AABB& newAABB, const Vector
         return false;
     }
 
-    // If the new AABB is outside the fat AABB, we remove the corresponding node
-    removeLeafNode(nodeID);
-
     // Compute the fat AABB by inflating the AABB with a constant gap
-    mNodes[nodeID].aabb = newAABB;
+    AABB fatAABB = newAABB;
     const Vector3 gap(mExtraAABBGap, mExtraAABBGap, mExtraAABBGap);
-    mNodes[nodeID].aabb.mMinCoordinates -= gap;
-    mNodes[nodeID].aabb.mMaxCoordinates += gap;
+    fatAABB.mMinCoordinates -= gap;
+    fatAABB.mMaxCoordinates += gap;
 
     // Inflate the fat AABB in direction of the linear motion of the AABB
-    if (displacement.x < decimal(0.0)) {
-      mNodes[nodeID].aabb.mMinCoordinates.x += DYNAMIC_TREE_AABB_LIN_GAP_MULTIPLIER *displacement.x;
+    for (int i=0; i<3; i++) {
+        if (displacement[i] < decimal(0.0)) {
+            fatAABB.mMinCoordinates[i] += DYNAMIC_TREE_AABB_LIN_GAP_MULTIPLIER * displacement[i];
+        }
+        else {
+            fatAABB.mMaxCoordinates[i] += DYNAMIC_TREE_AABB_LIN_GAP_MULTIPLIER * displacement[i];
+        }
     }
-    else {
-      mNodes[nodeID].aabb.mMaxCoordinates.x += DYNAMIC_TREE_AABB_LIN_GAP_MULTIPLIER *displacement.x;
+
+    assert(fatAABB.contains(newAABB));
+
+    // Remove the node and insert it again with its new fat AABB
+    reinsertObject(nodeID, fatAABB);
+
+    return true;
+}
+
+// Replace the fat AABB of an object and reinsert it into the tree
+/// This is used when the fat AABB of the object is computed outside of the tree.
+/**
+ * @param nodeID ID of the leaf node of the object
+ * @param fatAABB New fat AABB of the object
+ */
+void DynamicAABBTree::reinsertObject(int nodeID, const AABB& fatAABB) {
+
+    assert(nodeID >= 0 && nodeID < mNbAllocatedNodes);
+    assert(mNodes[nodeID].isLeaf());
+    assert(mNodes[nodeID].height >= 0);
+
+    // Remove the corresponding node
+    const bool isInTree = isLeafInTree(nodeID);
+    if (isInTree) {
+        removeLeafNode(nodeID);
     }
-    if (displacement.y < decimal(0.0)) {
-      mNodes[nodeID].aabb.mMinCoordinates.y += DYNAMIC_TREE_AABB_LIN_GAP_MULTIPLIER *displacement.y;
+
+    mNodes[nodeID].aabb = fatAABB;
+
+    // Reinsert the node into the tree (a node added during the current bulk
+    // insertion will be inserted when the tree is rebuilt)
+    if (isInTree || !mIsBulkInsertionActive) {
+        insertLeafNode(nodeID);
     }
-    else {
-      mNodes[nodeID].aabb.mMaxCoordinates.y += DYNAMIC_TREE_AABB_LIN_GAP_MULTIPLIER *displacement.y;
+}
+
+// Rebuild the whole tree top-down from its leaves
+/// The internal nodes of the tree are discarded and created again with the binned
+/// Surface Area Heuristic (see the TreeBuilder class). This is much faster than
+/// inserting the leaves one by one and the resulting tree is usually of better quality.
+/// This can be used after a large number of objects have been added or teleported.
+/// The IDs of the leaf nodes (and therefore the IDs of the objects) do not change.
+void DynamicAABBTree::rebuild() {
+
+    PROFILE("DynamicAABBTree::rebuild()");
+
+    assert(!mIsBulkInsertionActive);
+
+    // Collect the leaf nodes and release the internal nodes
+    int* leafNodeIDs = new int[mNbNodes + 1];
+    uint nbLeaves = 0;
+    for (int i=0; i<mNbAllocatedNodes; i++) {
+        if (mNodes[i].height < 0) continue;
+        if (mNodes[i].isLeaf()) {
+            leafNodeIDs[nbLeaves] = i;
+            nbLeaves++;
+        }
+        else {
+            releaseNode(i);
+        }
+    }
+
+    mRootNodeID = TreeNode::NULL_TREE_NODE;
+    if (nbLeaves > 0) {
+        mRootNodeID = buildSubTree(leafNodeIDs, nbLeaves, false);
+    }
+
+    delete[] leafNodeIDs;
+}
+
+// Rebuild the sub-tree of a given internal node top-down from its leaves
+/// The leaves are split at the median so that the new sub-tree is balanced. The AABB
+/// of the sub-tree does not change, only the heights of its ancestors may change. The
+/// method returns the number of leaves of the sub-tree.
+uint DynamicAABBTree::rebuildSubTree(int nodeID) {
+
+    assert(!mNodes[nodeID].isLeaf());
+
+    const int parentID = mNodes[nodeID].parentID;
+
+    // Collect the leaf nodes and release the internal nodes of the sub-tree
+    // (a sub-tree of height h has at most 2^h leaves)
+    int* leafNodeIDs = new int[1 << mNodes[nodeID].height];
+    uint nbLeaves = 0;
+    Stack<int, 64> stack;
+    stack.push(nodeID);
+    while (stack.getNbElements() > 0) {
+        const int currentNodeID = stack.pop();
+        if (mNodes[currentNodeID].isLeaf()) {
+            leafNodeIDs[nbLeaves] = currentNodeID;
+            nbLeaves++;
+        }
+        else {
+            stack.push(mNodes[currentNodeID].children[0]);
+            stack.push(mNodes[currentNodeID].children[1]);
+            releaseNode(currentNodeID);
+        }
     }
-    if (displacement.z < decimal(0.0)) {
-      mNodes[nodeID].aabb.mMinCoordinates.z += DYNAMIC_TREE_AABB_LIN_GAP_MULTIPLIER *displacement.z;
+
+    // Build the new sub-tree and link it to the parent of the previous one
+    const int newNodeID = buildSubTree(leafNodeIDs, nbLeaves, true);
+    mNodes[newNodeID].parentID = parentID;
+    if (parentID == TreeNode::NULL_TREE_NODE) {
+        mRootNodeID = newNodeID;
     }
     else {
-      mNodes[nodeID].aabb.mMaxCoordinates.z += DYNAMIC_TREE_AABB_LIN_GAP_MULTIPLIER *displacement.z;
+        TreeNode& parent = mNodes[parentID];
+        parent.children[parent.children[0] == nodeID ? 0 : 1] = newNodeID;
+        updateAncestorHeights(newNodeID);
     }
 
-    assert(mNodes[nodeID].aabb.contains(newAABB));
+    delete[] leafNodeIDs;
 
-    // Reinsert the node into the tree
-    insertLeafNode(nodeID);
+    return nbLeaves;
+}
 
-    return true;
+// Create the internal nodes of a sub-tree top-down for a given set of leaves and
+// return the ID of the root of the sub-tree (the parent of the root is null)
+/**
+ * @param leafNodeIDs IDs of the leaf nodes of the sub-tree
+ * @param nbLeaves Number of leaf nodes
+ * @param isBalanced True if the leaves are split at the median instead of with the SAH
+ * @return The ID of the root node of the new sub-tree
+ */
+int DynamicAABBTree::buildSubTree(const int* leafNodeIDs, uint nbLeaves, bool isBalanced) {
+
+    assert(nbLeaves > 0);
+
+    if (nbLeaves == 1) {
+        mNodes[leafNodeIDs[0]].parentID = TreeNode::NULL_TREE_NODE;
+        return leafNodeIDs[0];
+    }
+
+    // Compute the AABBs and the centers of the leaves
+    TreeBuildObject* leaves = new TreeBuildObject[nbLeaves];
+    for (uint i=0; i<nbLeaves; i++) {
+        leaves[i].aabb = mNodes[leafNodeIDs[i]].aabb;
+        leaves[i].center = leaves[i].aabb.getCenter();
+        leaves[i].index = static_cast<uint>(leafNodeIDs[i]);
+    }
+
+    // Internal nodes in the order of their creation (a node is created before its children)
+    int* internalNodeIDs = new int[nbLeaves - 1];
+    uint nbInternalNodes = 0;
+
+    // Create the nodes top-down
+    int rootNodeID = TreeNode::NULL_TREE_NODE;
+    Stack<DynamicTreeBuildTask, 64> stack;
+    DynamicTreeBuildTask rootTask;
+    rootTask.range.start = 0;
+    rootTask.range.end = nbLeaves;
+    rootTask.parentID = TreeNode::NULL_TREE_NODE;
+    rootTask.childIndex = 0;
+    TreeBuilder::computeRangeAABBs(leaves, rootTask.range);
+    stack.push(rootTask);
+    while (stack.getNbElements() > 0) {
+
+        const DynamicTreeBuildTask task = stack.pop();
+
+        int nodeID;
+
+        // If there is a single object, the node is the leaf of this object
+        if (task.range.end - task.range.start == 1) {
+            nodeID = static_cast<int>(leaves[task.range.start].index);
+        }
+        else {
+
+            // Create an internal node (its height is computed once all the nodes exist)
+            nodeID = allocateNode();
+            mNodes[nodeID].height = 1;
+            mNodes[nodeID].aabb = task.range.aabb;
+            internalNodeIDs[nbInternalNodes] = nodeID;
+            nbInternalNodes++;
+
+            // Split the objects of the node and create its two children
+            DynamicTreeBuildTask leftTask;
+            DynamicTreeBuildTask rightTask;
+            if (isBalanced) {
+                TreeBuilder::splitRangeAtMedian(leaves, task.range, leftTask.range,
+                                                rightTask.range);
+            }
+            else {
+                TreeBuilder::splitRange(leaves, task.range, leftTask.range, rightTask.range);
+            }
+            leftTask.parentID = nodeID;
+            leftTask.childIndex = 0;
+            rightTask.parentID = nodeID;
+            rightTask.childIndex = 1;
+            stack.push(rightTask);
+            stack.push(leftTask);
+        }
+
+        // Link the node with its parent
+        mNodes[nodeID].parentID = task.parentID;
+        if (task.parentID != TreeNode::NULL_TREE_NODE) {
+            mNodes[task.parentID].children[task.childIndex] = nodeID;
+        }
+        else {
+            rootNodeID = nodeID;
+        }
+    }
+    assert(nbInternalNodes == nbLeaves - 1);
+
+    // Compute the heights of the internal nodes (the children of a node are
+    // created after it)
+    for (int i=static_cast<int>(nbInternalNodes) - 1; i >= 0; i--) {
+        TreeNode& node = mNodes[internalNodeIDs[i]];
+        node.height = 1 + std::max(mNodes[node.children[0]].height,
+                                   mNodes[node.children[1]].height);
+    }
+
+    delete[] leaves;
+    delete[] internalNodeIDs;
+
+    return rootNodeID;
+}
+
+// Incrementally improve the quality of the tree
+/// The tree is only balanced when leaves are inserted or removed. When the objects
+/// move over a long period of time, the quality of the tree decreases (the AABBs of
+/// the internal nodes become larger) and so does the performance of the queries. This
+/// method visits the small sub-trees at the bottom of the tree (continuing where the
+/// previous call stopped) and rebuilds them top-down until a given number of leaves
+/// have been processed. The rebuilt sub-trees are balanced so that the balancing
+/// rotations of the next insertions do not undo the optimization. This can be called
+/// at each frame with a small number of leaves to keep a good tree at a bounded cost.
+/// The method returns the number of sub-trees that have been rebuilt.
+/**
+ * @param nbLeaves Number of leaves to process (the cost of the method is linear in it)
+ * @return The number of sub-trees that have been rebuilt
+ */
+uint DynamicAABBTree::optimize(uint nbLeaves) {
+
+    PROFILE("DynamicAABBTree::optimize()");
+
+    assert(!mIsBulkInsertionActive);
+
+    if (mRootNodeID == TreeNode::NULL_TREE_NODE || mNodes[mRootNodeID].isLeaf()) return 0;
+
+    // Compute the height of the sub-trees to rebuild such that a sub-tree has at
+    // most the given number of leaves
+    int subTreeHeight = 2;
+    while ((2u << subTreeHeight) <= nbLeaves) subTreeHeight++;
+
+    // If the whole tree is small enough, we rebuild it
+    if (mNodes[mRootNodeID].height <= subTreeHeight) {
+        rebuildSubTree(mRootNodeID);
+        return 1;
+    }
+
+    uint nbRebuiltSubTrees = 0;
+    uint nbProcessedLeaves = 0;
+    for (int i=0; i<mNbAllocatedNodes && nbProcessedLeaves < nbLeaves; i++) {
+
+        mOptimizationNodeID = (mOptimizationNodeID + 1) % mNbAllocatedNodes;
+
+        // Rebuild the sub-tree of the node if it has the correct height
+        if (mNodes[mOptimizationNodeID].height == subTreeHeight) {
+            nbProcessedLeaves += rebuildSubTree(mOptimizationNodeID);
+            nbRebuiltSubTrees++;
+        }
+    }
+
+    return nbRebuiltSubTrees;
+}
+
+// Update the heights of the ancestors of a node (after the height of the node has changed)
+void DynamicAABBTree::updateAncestorHeights(int nodeID) {
+
+    int currentNodeID = mNodes[nodeID].parentID;
+    while (currentNodeID != TreeNode::NULL_TREE_NODE) {
+
+        TreeNode& currentNode = mNodes[currentNodeID];
+        const int16 height = 1 + std::max(mNodes[currentNode.children[0]].height,
+                                          mNodes[currentNode.children[1]].height);
+
+        // If the height has not changed, the heights of the ancestors do not change either
+        if (height == currentNode.height) return;
+
+        currentNode.height = height;
+        currentNodeID = currentNode.parentID;
+    }
+}
+
+// Compute the Surface Area Heuristic (SAH) cost of the tree
+/// The cost is the sum of the surface areas of the internal nodes divided by the
+/// surface area of the root node. It is proportional to the expected number of
+/// internal nodes visited by a query and can therefore be used to monitor the
+/// quality of the tree (a lower cost is better).
+decimal DynamicAABBTree::computeCost() const {
+
+    if (mRootNodeID == TreeNode::NULL_TREE_NODE || mNodes[mRootNodeID].isLeaf()) {
+        return decimal(0.0);
+    }
+
+    decimal sumAreas = decimal(0.0);
+    for (int i=0; i<mNbAllocatedNodes; i++) {
+        if (mNodes[i].height > 0) {
+            sumAreas += mNodes[i].aabb.getSurfaceArea();
+        }
+    }
+
+    const decimal rootArea = mNodes[mRootNodeID].aabb.getSurfaceArea();
+    return rootArea > decimal(0.0) ? sumAreas / rootArea : decimal(0.0);
 }
 
 // Insert a leaf node in the tree. The process of inserting a new leaf node
@@ -592,10 +960,20 @@ int DynamicAABBTree::balanceSubTreeAtNode(int nodeID) {
 }
 
 /// Report all shapes overlapping with the AABB given in parameter.
+/// The two children of an internal node are tested against the AABB together before
+/// being pushed into the stack, so that only the overlapping nodes are visited. The
+/// nodes are reported in the same order as with a one-node-at-a-time traversal.
 void DynamicAABBTree::reportAllShapesOverlappingWithAABB(const AABB& aabb,
                                                          DynamicAABBTreeOverlapCallback& callback) const {
 
-    // Create a stack with the nodes to visit
+    if (mRootNodeID == TreeNode::NULL_TREE_NODE) return;
+
+    const TreeOverlapQuery query(aabb);
+
+    // If the AABB does not overlap with the root node, there is nothing to report
+    if (!query.testOverlap(mNodes[mRootNodeID].aabb)) return;
+
+    // Create a stack with the overlapping nodes to visit
     Stack<int, 64> stack;
     stack.push(mRootNodeID);
 
@@ -605,27 +983,24 @@ void DynamicAABBTree::reportAllShapesOverlappingWithAABB(const AABB& aabb,
         // Get the next node ID to visit
         int nodeIDToVisit = stack.pop();
 
-        // Skip it if it is a null node
-        if (nodeIDToVisit == TreeNode::NULL_TREE_NODE) continue;
-
         // Get the corresponding node
         const TreeNode* nodeToVisit = mNodes + nodeIDToVisit;
 
-        // If the AABB in parameter overlaps with the AABB of the node to visit
-        if (aabb.testCollision(nodeToVisit->aabb)) {
-
-            // If the node is a leaf
-            if (nodeToVisit->isLeaf()) {
-
-                // Notify the broad-phase about a new potential overlapping pair
-                callback.notifyOverlappingNode(nodeIDToVisit);
-            }
-            else {  // If the node is not a leaf
+        // If the node is a leaf
+        if (nodeToVisit->isLeaf()) {
 
-                // We need to visit its children
-                stack.push(nodeToVisit->children[0]);
-                stack.push(nodeToVisit->children[1]);
-            }
+            // Notify the broad-phase about a new potential overlapping pair
+            callback.notifyOverlappingNode(nodeIDToVisit);
+        }
+        else {  // If the node is not a leaf
+
+            // Test the two children against the AABB and visit the overlapping ones
+            const int child1ID = nodeToVisit->children[0];
+            const int child2ID = nodeToVisit->children[1];
+            const bool isChild1Overlapping = query.testOverlap(mNodes[child1ID].aabb);
+            const bool isChild2Overlapping = query.testOverlap(mNodes[child2ID].aabb);
+            if (isChild1Overlapping) stack.push(child1ID);
+            if (isChild2Overlapping) stack.push(child2ID);
         }
     }
 }
@@ -635,8 +1010,14 @@ void DynamicAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback &ca
 
     PROFILE("DynamicAABBTree::raycast()");
 
+    if (mRootNodeID == TreeNode::NULL_TREE_NODE) return;
+
     decimal maxFraction = ray.maxFraction;
 
+    // Compute the values of the ray used to test it against the node AABBs
+    TreeRaycastQuery query;
+    query.update(ray, maxFraction);
+
     Stack<int, 128> stack;
     stack.push(mRootNodeID);
 
@@ -647,20 +1028,17 @@ void DynamicAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback &ca
         // Get the next node in the stack
         int nodeID = stack.pop();
 
-        // If it is a null node, skip it
-        if (nodeID == TreeNode::NULL_TREE_NODE) continue;
-
         // Get the corresponding node
         const TreeNode* node = mNodes + nodeID;
 
-        Ray rayTemp(ray.point1, ray.point2, maxFraction);
-
         // Test if the ray intersects with the current node AABB
-        if (!node->aabb.testRayIntersect(rayTemp)) continue;
+        if (!query.testRayIntersect(node->aabb)) continue;
 
         // If the node is a leaf of the tree
         if (node->isLeaf()) {
 
+            Ray rayTemp(ray.point1, ray.point2, maxFraction);
+
             // Call the callback that will raycast again the broad-phase shape
             decimal hitFraction = callback.raycastBroadPhaseShape(nodeID, rayTemp);
 
@@ -677,6 +1055,7 @@ void DynamicAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback &ca
                 // AABB using the new maximum fraction
                 if (hitFraction < maxFraction) {
                     maxFraction = hitFraction;
+                    query.update(ray, maxFraction);
                 }
             }
 
@@ -692,6 +1071,29 @@ void DynamicAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback &ca
     }
 }
 
+// Compute the height of the tree
+int DynamicAABBTree::computeHeight() {
+   return computeHeight(mRootNodeID);
+}
+
+// Compute the height of a given node in the tree
+int DynamicAABBTree::computeHeight(int nodeID) {
+    assert(nodeID >= 0 && nodeID < mNbAllocatedNodes);
+    TreeNode* node = mNodes + nodeID;
+
+    // If the node is a leaf, its height is zero
+    if (node->isLeaf()) {
+        return 0;
+    }
+
+    // Compute the height of the left and right sub-tree
+    int leftHeight = computeHeight(node->children[0]);
+    int rightHeight = computeHeight(node->children[1]);
+
+    // Return the height of the node
+    return 1 + std::max(leftHeight, rightHeight);
+}
+
 #ifndef NDEBUG
 
 // Check if the tree structure is valid (for debugging purpose)
@@ -766,27 +1168,4 @@ void DynamicAABBTree::checkNode(int nodeID) const {
     }
 }
 
-// Compute the height of the tree
-int DynamicAABBTree::computeHeight() {
-   return computeHeight(mRootNodeID);
-}
-
-// Compute the height of a given node in the tree
-int DynamicAABBTree::computeHeight(int nodeID) {
-    assert(nodeID >= 0 && nodeID < mNbAllocatedNodes);
-    TreeNode* node = mNodes + nodeID;
-
-    // If the node is a leaf, its height is zero
-    if (node->isLeaf()) {
-        return 0;
-    }
-
-    // Compute the height of the left and right sub-tree
-    int leftHeight = computeHeight(node->children[0]);
-    int rightHeight = computeHeight(node->children[1]);
-
-    // Return the height of the node
-    return 1 + std::max(leftHeight, rightHeight);
-}
-
 #endif
@@ -150,6 +150,13 @@ class DynamicAABBTree {
         /// without triggering a large modification of the tree which can be costly
         decimal mExtraAABBGap;
 
+        /// True if the objects added to the tree are not inserted into it until the
+        /// end of the bulk insertion (where the whole tree is rebuilt)
+        bool mIsBulkInsertionActive;
+
+        /// ID of the last node visited by the incremental optimization of the tree
+        int mOptimizationNodeID;
+
         // -------------------- Methods -------------------- //
 
         /// Allocate and return a node to use in the tree
@@ -170,6 +177,18 @@ class DynamicAABBTree {
         /// Compute the height of a given node in the tree
         int computeHeight(int nodeID);
 
+        /// Return true if a given leaf node is part of the tree
+        bool isLeafInTree(int nodeID) const;
+
+        /// Update the heights of the ancestors of a node
+        void updateAncestorHeights(int nodeID);
+
+        /// Rebuild the sub-tree of a given internal node top-down from its leaves
+        uint rebuildSubTree(int nodeID);
+
+        /// Create the internal nodes of a sub-tree for a given set of leaves
+        int buildSubTree(const int* leafNodeIDs, uint nbLeaves, bool isBalanced);
+
         /// Internally add an object into the tree
         int addObjectInternal(const AABB& aabb);
 
@@ -208,6 +227,9 @@ class DynamicAABBTree {
         /// Update the dynamic tree after an object has moved.
         bool updateObject(int nodeID, const AABB& newAABB, const Vector3& displacement, bool forceReinsert = false);
 
+        /// Replace the fat AABB of an object and reinsert it into the tree
+        void reinsertObject(int nodeID, const AABB& fatAABB);
+
         /// Return the fat AABB corresponding to a given node ID
         const AABB& getFatAABB(int nodeID) const;
 
@@ -232,6 +254,24 @@ class DynamicAABBTree {
 
         /// Clear all the nodes and reset the tree
         void reset();
+
+        /// Start a bulk insertion of objects into the tree
+        void beginBulkInsertion();
+
+        /// End a bulk insertion of objects and rebuild the tree
+        void endBulkInsertion();
+
+        /// Return true if a bulk insertion of objects is in progress
+        bool isBulkInsertionActive() const;
+
+        /// Rebuild the whole tree top-down from its leaves
+        void rebuild();
+
+        /// Incrementally improve the quality of the tree
+        uint optimize(uint nbLeaves);
+
+        /// Compute the Surface Area Heuristic (SAH) cost of the tree
+        decimal computeCost() const;
 };
 
 // Return true if the node is a leaf of the tree
@@ -264,6 +304,34 @@ inline AABB DynamicAABBTree::getRootAABB() const {
     return getFatAABB(mRootNodeID);
 }
 
+// Return true if a given leaf node is part of the tree (a leaf added during a bulk
+// insertion is not in the tree until the end of the bulk insertion)
+inline bool DynamicAABBTree::isLeafInTree(int nodeID) const {
+    return nodeID == mRootNodeID || mNodes[nodeID].parentID != TreeNode::NULL_TREE_NODE;
+}
+
+// Start a bulk insertion of objects into the tree
+/// Until the endBulkInsertion() method is called, the objects that are added into the
+/// tree are not inserted one by one. Instead, the whole tree is rebuilt once at the end
+/// of the bulk insertion. In the meantime, the tree queries do not report the objects
+/// that have been added.
+inline void DynamicAABBTree::beginBulkInsertion() {
+    assert(!mIsBulkInsertionActive);
+    mIsBulkInsertionActive = true;
+}
+
+// End a bulk insertion of objects and rebuild the tree
+inline void DynamicAABBTree::endBulkInsertion() {
+    assert(mIsBulkInsertionActive);
+    mIsBulkInsertionActive = false;
+    rebuild();
+}
+
+// Return true if a bulk insertion of objects is in progress
+inline bool DynamicAABBTree::isBulkInsertionActive() const {
+    return mIsBulkInsertionActive;
+}
+
 // Add an object into the tree. This method creates a new leaf node in the tree and
 // returns the ID of the corresponding node.
 inline int DynamicAABBTree::addObject(const AABB& aabb, int32 data1, int32 data2) {
@@ -0,0 +1,523 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "SpatialHashAlgorithm.h"
+#include <algorithm>
+#include "TreeRaycastQuery.h"
+#include "collision/CollisionDetection.h"
+#include "engine/Profiler.h"
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Initialization of static variables
+const uint SpatialHashAlgorithm::NB_MAX_CELLS_PER_SHAPE;
+const uint SpatialHashAlgorithm::NB_INITIAL_BUCKETS;
+
+// Constructor
+SpatialHashAlgorithm::SpatialHashAlgorithm(CollisionDetection& collisionDetection)
+                     :BroadPhaseAlgorithm(collisionDetection),
+                      mCellSize(DEFAULT_SPATIAL_HASH_CELL_SIZE), mBuckets(NB_INITIAL_BUCKETS),
+                      mNbBucketEntries(0) {
+
+}
+
+// Destructor
+SpatialHashAlgorithm::~SpatialHashAlgorithm() {
+
+}
+
+// Compute the cells of the fat AABB of a proxy
+void SpatialHashAlgorithm::computeCells(SpatialHashProxy& proxy) const {
+
+    long long nbCells = 1;
+    for (int i=0; i<3; i++) {
+        proxy.minCell[i] = computeCellCoordinate(proxy.aabb.getMin()[i]);
+        proxy.maxCell[i] = computeCellCoordinate(proxy.aabb.getMax()[i]);
+        nbCells *= static_cast<long long>(proxy.maxCell[i]) - proxy.minCell[i] + 1;
+    }
+
+    proxy.isLarge = nbCells > NB_MAX_CELLS_PER_SHAPE;
+}
+
+// Add a proxy into the buckets of its cells (or into the list of large shapes)
+/// The broad-phase ID of a proxy is only added once into a bucket even if several
+/// cells of the proxy are in the same bucket.
+void SpatialHashAlgorithm::insertProxy(int broadPhaseID) {
+
+    const SpatialHashProxy& proxy = mProxies[broadPhaseID];
+
+    if (proxy.isLarge) {
+        mLargeShapes.push_back(broadPhaseID);
+        return;
+    }
+
+    uint bucketIndices[NB_MAX_CELLS_PER_SHAPE];
+    uint nbBuckets = 0;
+    for (int x=proxy.minCell[0]; x<=proxy.maxCell[0]; x++) {
+        for (int y=proxy.minCell[1]; y<=proxy.maxCell[1]; y++) {
+            for (int z=proxy.minCell[2]; z<=proxy.maxCell[2]; z++) {
+                bucketIndices[nbBuckets++] = computeBucketIndex(x, y, z);
+            }
+        }
+    }
+    std::sort(bucketIndices, bucketIndices + nbBuckets);
+    nbBuckets = static_cast<uint>(std::unique(bucketIndices, bucketIndices + nbBuckets) - bucketIndices);
+
+    for (uint i=0; i<nbBuckets; i++) {
+        mBuckets[bucketIndices[i]].push_back(broadPhaseID);
+    }
+    mNbBucketEntries += nbBuckets;
+}
+
+// Remove a proxy from the buckets of its cells (or from the list of large shapes)
+void SpatialHashAlgorithm::extractProxy(int broadPhaseID) {
+
+    const SpatialHashProxy& proxy = mProxies[broadPhaseID];
+
+    if (proxy.isLarge) {
+        std::vector<int>::iterator it = std::find(mLargeShapes.begin(), mLargeShapes.end(),
+                                                  broadPhaseID);
+        assert(it != mLargeShapes.end());
+        *it = mLargeShapes.back();
+        mLargeShapes.pop_back();
+        return;
+    }
+
+    uint bucketIndices[NB_MAX_CELLS_PER_SHAPE];
+    uint nbBuckets = 0;
+    for (int x=proxy.minCell[0]; x<=proxy.maxCell[0]; x++) {
+        for (int y=proxy.minCell[1]; y<=proxy.maxCell[1]; y++) {
+            for (int z=proxy.minCell[2]; z<=proxy.maxCell[2]; z++) {
+                bucketIndices[nbBuckets++] = computeBucketIndex(x, y, z);
+            }
+        }
+    }
+    std::sort(bucketIndices, bucketIndices + nbBuckets);
+    nbBuckets = static_cast<uint>(std::unique(bucketIndices, bucketIndices + nbBuckets) - bucketIndices);
+
+    for (uint i=0; i<nbBuckets; i++) {
+        std::vector<int>& bucket = mBuckets[bucketIndices[i]];
+        std::vector<int>::iterator it = std::find(bucket.begin(), bucket.end(), broadPhaseID);
+        assert(it != bucket.end());
+        *it = bucket.back();
+        bucket.pop_back();
+    }
+    assert(mNbBucketEntries >= nbBuckets);
+    mNbBucketEntries -= nbBuckets;
+}
+
+// Set the number of buckets of the hash table and insert the proxies again
+/// The cells of the proxies are computed again because the size of the cells may
+/// have changed.
+/**
+ * @param nbBuckets Number of buckets (must be a power of two)
+ */
+void SpatialHashAlgorithm::rehash(uint nbBuckets) {
+
+    PROFILE("SpatialHashAlgorithm::rehash()");
+
+    assert(nbBuckets > 0 && (nbBuckets & (nbBuckets - 1)) == 0);
+
+    mBuckets.clear();
+    mBuckets.resize(nbBuckets);
+    mNbBucketEntries = 0;
+    mLargeShapes.clear();
+
+    for (uint i=0; i<mProxies.size(); i++) {
+        if (mProxies[i].proxyShape == NULL) continue;
+        computeCells(mProxies[i]);
+        insertProxy(static_cast<int>(i));
+    }
+}
+
+// Add a proxy collision shape into the broad-phase collision detection
+/// The AABBs of the static shapes are not inflated because the static bodies are
+/// rarely moved.
+void SpatialHashAlgorithm::addProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb) {
+
+    // Get a free proxy
+    int broadPhaseID;
+    if (!mFreeProxyIDs.empty()) {
+        broadPhaseID = mFreeProxyIDs.back();
+        mFreeProxyIDs.pop_back();
+    }
+    else {
+        broadPhaseID = static_cast<int>(mProxies.size());
+        mProxies.push_back(SpatialHashProxy());
+    }
+
+    SpatialHashProxy& proxy = mProxies[broadPhaseID];
+    proxy.proxyShape = proxyShape;
+    proxy.isStatic = proxyShape->getBody()->getType() == STATIC;
+    const decimal gap = proxy.isStatic ? decimal(0.0) : DYNAMIC_TREE_AABB_GAP;
+    proxy.aabb = computeFatAABB(aabb, Vector3(0, 0, 0), gap);
+    computeCells(proxy);
+    insertProxy(broadPhaseID);
+
+    // Grow the hash table if the buckets contain too many entries
+    if (mNbBucketEntries > 2 * mBuckets.size()) {
+        rehash(static_cast<uint>(2 * mBuckets.size()));
+    }
+
+    // Set the broad-phase ID of the proxy shape
+    proxyShape->mBroadPhaseID = broadPhaseID;
+    initializeShapeMotion(proxyShape, aabb);
+
+    // Add the collision shape into the array of bodies that have moved (or have been created)
+    // during the last simulation step
+    addMovedCollisionShape(proxyShape);
+}
+
+// Remove a proxy collision shape from the broad-phase collision detection
+void SpatialHashAlgorithm::removeProxyCollisionShape(ProxyShape* proxyShape) {
+
+    int broadPhaseID = proxyShape->mBroadPhaseID;
+
+    extractProxy(broadPhaseID);
+
+    // Release the proxy
+    mProxies[broadPhaseID].proxyShape = NULL;
+    mFreeProxyIDs.push_back(broadPhaseID);
+
+    // Remove the collision shape into the array of shapes that have moved (or have been created)
+    // during the last simulation step
+    removeMovedCollisionShape(proxyShape);
+}
+
+// Notify the broad-phase that a collision shape has moved and need to be updated
+/// The buckets are only modified if the fat AABB of the shape now overlaps with
+/// other cells.
+void SpatialHashAlgorithm::updateProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb,
+                                                     const Vector3& displacement, bool forceReinsert) {
+
+    int broadPhaseID = proxyShape->mBroadPhaseID;
+
+    assert(broadPhaseID >= 0);
+
+    SpatialHashProxy& proxy = mProxies[broadPhaseID];
+
+    // If the new AABB is still inside the fat AABB of the shape (and if the fat AABB is
+    // not much larger than needed)
+    SpatialHashProxy newProxy = proxy;
+    if (!updateFatAABB(proxyShape, aabb, displacement, proxy.isStatic, forceReinsert, newProxy.aabb)) {
+        return;
+    }
+
+    // Compute the cells of the new fat AABB
+    computeCells(newProxy);
+
+    bool isSameCells = newProxy.isLarge == proxy.isLarge;
+    for (int i=0; i<3 && isSameCells; i++) {
+        isSameCells = newProxy.minCell[i] == proxy.minCell[i] && newProxy.maxCell[i] == proxy.maxCell[i];
+    }
+
+    if (isSameCells) {
+        proxy.aabb = newProxy.aabb;
+    }
+    else {
+        extractProxy(broadPhaseID);
+        proxy = newProxy;
+        insertProxy(broadPhaseID);
+
+        if (mNbBucketEntries > 2 * mBuckets.size()) {
+            rehash(static_cast<uint>(2 * mBuckets.size()));
+        }
+    }
+
+    // Add the collision shape into the array of shapes that have moved (or have been created)
+    // during the last simulation step
+    addMovedCollisionShape(proxyShape);
+}
+
+// Find all the collision shapes that overlap with a given moved collision shape
+/// The buckets of the cells of the moved shape are visited. A pair of shapes is only
+/// reported in the cell that contains the maximum of the minimum points of the two
+/// fat AABBs. This cell belongs to both shapes if they overlap. Therefore, each pair is
+/// reported once even if the shapes share several cells or if cells of the shapes are
+/// in the same bucket. A large shape is tested against all the other shapes.
+/**
+ * @param threadIndex Index of the thread that executes the query
+ * @param broadPhaseID Broad-phase ID of the moved collision shape
+ */
+void SpatialHashAlgorithm::queryOverlappingShapes(uint threadIndex, int broadPhaseID) {
+
+    const SpatialHashProxy& proxy = mProxies[broadPhaseID];
+
+    if (proxy.isLarge) {
+        for (uint i=0; i<mProxies.size(); i++) {
+            const SpatialHashProxy& other = mProxies[i];
+            if (other.proxyShape == NULL || static_cast<int>(i) == broadPhaseID) continue;
+            if (proxy.isStatic && other.isStatic) continue;
+            if (other.aabb.testCollision(proxy.aabb)) {
+                notifyOverlappingNodes(threadIndex, broadPhaseID, static_cast<int>(i));
+            }
+        }
+        return;
+    }
+
+    // Test the shapes of the cells of the moved shape
+    for (int x=proxy.minCell[0]; x<=proxy.maxCell[0]; x++) {
+        for (int y=proxy.minCell[1]; y<=proxy.maxCell[1]; y++) {
+            for (int z=proxy.minCell[2]; z<=proxy.maxCell[2]; z++) {
+
+                const std::vector<int>& bucket = mBuckets[computeBucketIndex(x, y, z)];
+                for (uint i=0; i<bucket.size(); i++) {
+
+                    const int otherID = bucket[i];
+                    if (otherID == broadPhaseID) continue;
+                    const SpatialHashProxy& other = mProxies[otherID];
+                    if (proxy.isStatic && other.isStatic) continue;
+
+                    // Only test the pair in its reference cell
+                    if (x != std::max(proxy.minCell[0], other.minCell[0]) ||
+                        y != std::max(proxy.minCell[1], other.minCell[1]) ||
+                        z != std::max(proxy.minCell[2], other.minCell[2])) continue;
+
+                    if (other.aabb.testCollision(proxy.aabb)) {
+                        notifyOverlappingNodes(threadIndex, broadPhaseID, otherID);
+                    }
+                }
+            }
+        }
+    }
+
+    // Test the large shapes
+    for (uint i=0; i<mLargeShapes.size(); i++) {
+        const SpatialHashProxy& other = mProxies[mLargeShapes[i]];
+        if (proxy.isStatic && other.isStatic) continue;
+        if (other.aabb.testCollision(proxy.aabb)) {
+            notifyOverlappingNodes(threadIndex, broadPhaseID, mLargeShapes[i]);
+        }
+    }
+}
+
+// Test a proxy against a ray and return false if the raycast must stop
+/**
+ * @param proxy Proxy to test
+ * @param ray Ray to use for raycasting
+ * @param raycastTest Raycast test of the collision detection
+ * @param raycastWithCategoryMaskBits Bits mask of the categories of the shapes to test
+ * @param maxFraction Maximum fraction of the ray (updated if the ray is clipped)
+ * @param query Prepared ray segment (updated if the ray is clipped)
+ * @return False if the user asked to stop the raycast
+ */
+bool SpatialHashAlgorithm::raycastProxy(const SpatialHashProxy& proxy, const Ray& ray,
+                                        RaycastTest& raycastTest,
+                                        unsigned short raycastWithCategoryMaskBits,
+                                        decimal& maxFraction, TreeRaycastQuery& query) const {
+
+    if (!query.testRayIntersect(proxy.aabb)) return true;
+
+    // Check if the raycast filtering mask allows raycast against this shape
+    if ((raycastWithCategoryMaskBits & proxy.proxyShape->getCollisionCategoryBits()) == 0) return true;
+
+    // Ask the collision detection to perform a ray cast test against the shape
+    const decimal hitFraction = raycastTest.raycastAgainstShape(proxy.proxyShape,
+                                            Ray(ray.point1, ray.point2, maxFraction));
+
+    // If the user returned a hitFraction of zero, it means that
+    // the raycasting should stop here
+    if (hitFraction == decimal(0.0)) return false;
+
+    // If the user returned a positive fraction, we update the maximum
+    // fraction value to clip the ray
+    if (hitFraction > decimal(0.0) && hitFraction < maxFraction) {
+        maxFraction = hitFraction;
+        query.update(ray, maxFraction);
+    }
+
+    return true;
+}
+
+// Ray casting method
+/// The cells crossed by the ray are visited in order with a 3D digital differential
+/// analyzer until the closest hit found so far. A shape is only tested in the first
+/// cell of the ray that it overlaps. If the ray crosses more cells than there are
+/// shapes, all the shapes are tested instead.
+void SpatialHashAlgorithm::raycast(const Ray& ray, RaycastTest& raycastTest,
+                                   unsigned short raycastWithCategoryMaskBits) const {
+
+    PROFILE("SpatialHashAlgorithm::raycast()");
+
+    decimal maxFraction = ray.maxFraction;
+    TreeRaycastQuery query;
+    query.update(ray, maxFraction);
+
+    // Test the large shapes
+    for (uint i=0; i<mLargeShapes.size(); i++) {
+        if (!raycastProxy(mProxies[mLargeShapes[i]], ray, raycastTest,
+                          raycastWithCategoryMaskBits, maxFraction, query)) return;
+    }
+
+    const Vector3 direction = ray.point2 - ray.point1;
+    const Vector3 point2 = ray.point1 + maxFraction * direction;
+    int cell[3];
+    long long nbCells = 1;
+    for (int i=0; i<3; i++) {
+        cell[i] = computeCellCoordinate(ray.point1[i]);
+        nbCells += std::abs(static_cast<long long>(computeCellCoordinate(point2[i])) - cell[i]);
+    }
+
+    // If the ray crosses too many cells, we test all the small shapes
+    if (nbCells > static_cast<long long>(mProxies.size())) {
+        for (uint i=0; i<mProxies.size(); i++) {
+            const SpatialHashProxy& proxy = mProxies[i];
+            if (proxy.proxyShape == NULL || proxy.isLarge) continue;
+            if (!raycastProxy(proxy, ray, raycastTest, raycastWithCategoryMaskBits,
+                              maxFraction, query)) return;
+        }
+        return;
+    }
+
+    // Initialize the traversal of the cells
+    int step[3];
+    decimal nextFraction[3];
+    decimal deltaFraction[3];
+    for (int i=0; i<3; i++) {
+        if (direction[i] > decimal(0.0)) {
+            step[i] = 1;
+            nextFraction[i] = (decimal(cell[i] + 1) * mCellSize - ray.point1[i]) / direction[i];
+            deltaFraction[i] = mCellSize / direction[i];
+        }
+        else if (direction[i] < decimal(0.0)) {
+            step[i] = -1;
+            nextFraction[i] = (decimal(cell[i]) * mCellSize - ray.point1[i]) / direction[i];
+            deltaFraction[i] = -mCellSize / direction[i];
+        }
+        else {
+            step[i] = 0;
+            nextFraction[i] = DECIMAL_LARGEST;
+            deltaFraction[i] = DECIMAL_LARGEST;
+        }
+    }
+
+    int previousCell[3] = {0, 0, 0};
+    bool isFirstCell = true;
+    while (true) {
+
+        // Test the shapes of the cell that do not overlap with the previous cell
+        const std::vector<int>& bucket = mBuckets[computeBucketIndex(cell[0], cell[1], cell[2])];
+        for (uint i=0; i<bucket.size(); i++) {
+
+            const SpatialHashProxy& proxy = mProxies[bucket[i]];
+
+            bool isInCell = true;
+            bool isInPreviousCell = !isFirstCell;
+            for (int k=0; k<3; k++) {
+                isInCell = isInCell && cell[k] >= proxy.minCell[k] && cell[k] <= proxy.maxCell[k];
+                isInPreviousCell = isInPreviousCell && previousCell[k] >= proxy.minCell[k] &&
+                                   previousCell[k] <= proxy.maxCell[k];
+            }
+            if (!isInCell || isInPreviousCell) continue;
+
+            if (!raycastProxy(proxy, ray, raycastTest, raycastWithCategoryMaskBits,
+                              maxFraction, query)) return;
+        }
+
+        // Move to the next cell crossed by the ray
+        int axis = nextFraction[0] < nextFraction[1] ? 0 : 1;
+        if (nextFraction[2] < nextFraction[axis]) axis = 2;
+        if (nextFraction[axis] > maxFraction) return;
+
+        previousCell[0] = cell[0];
+        previousCell[1] = cell[1];
+        previousCell[2] = cell[2];
+        isFirstCell = false;
+        cell[axis] += step[axis];
+        nextFraction[axis] += deltaFraction[axis];
+    }
+}
+
+// Find all the proxy shapes whose fat AABB overlaps with a given AABB
+/// A shape is only reported in the first cell of the AABB that it overlaps (the cell
+/// that contains the maximum of the minimum points of the two AABBs). If the AABB
+/// overlaps more cells than there are shapes, all the shapes are tested instead.
+void SpatialHashAlgorithm::reportShapesOverlappingWithAABB(const AABB& aabb,
+                                                           std::vector<ProxyShape*>& overlappingShapes) const {
+
+    // Test the large shapes
+    for (uint i=0; i<mLargeShapes.size(); i++) {
+        const SpatialHashProxy& proxy = mProxies[mLargeShapes[i]];
+        if (proxy.aabb.testCollision(aabb)) overlappingShapes.push_back(proxy.proxyShape);
+    }
+
+    int minCell[3];
+    int maxCell[3];
+    long long nbCells = 1;
+    for (int i=0; i<3; i++) {
+        minCell[i] = computeCellCoordinate(aabb.getMin()[i]);
+        maxCell[i] = computeCellCoordinate(aabb.getMax()[i]);
+        nbCells *= static_cast<long long>(maxCell[i]) - minCell[i] + 1;
+    }
+
+    // If the AABB overlaps too many cells, we test all the small shapes
+    if (nbCells > static_cast<long long>(mProxies.size())) {
+        for (uint i=0; i<mProxies.size(); i++) {
+            const SpatialHashProxy& proxy = mProxies[i];
+            if (proxy.proxyShape == NULL || proxy.isLarge) continue;
+            if (proxy.aabb.testCollision(aabb)) overlappingShapes.push_back(proxy.proxyShape);
+        }
+        return;
+    }
+
+    // Test the shapes of the cells of the AABB
+    for (int x=minCell[0]; x<=maxCell[0]; x++) {
+        for (int y=minCell[1]; y<=maxCell[1]; y++) {
+            for (int z=minCell[2]; z<=maxCell[2]; z++) {
+
+                const std::vector<int>& bucket = mBuckets[computeBucketIndex(x, y, z)];
+                for (uint i=0; i<bucket.size(); i++) {
+
+                    const SpatialHashProxy& proxy = mProxies[bucket[i]];
+
+                    // Only test the shape in its reference cell (which also rejects the
+                    // shapes of the other cells of the bucket)
+                    if (x != std::max(proxy.minCell[0], minCell[0]) ||
+                        y != std::max(proxy.minCell[1], minCell[1]) ||
+                        z != std::max(proxy.minCell[2], minCell[2])) continue;
+
+                    if (proxy.aabb.testCollision(aabb)) overlappingShapes.push_back(proxy.proxyShape);
+                }
+            }
+        }
+    }
+}
+
+// Set the size of the cells of the grid
+/// The cells should be larger than most of the collision shapes. With smaller cells,
+/// a shape overlaps with more cells. With larger cells, more shapes are tested
+/// against each other. All the shapes are inserted again into the hash table.
+/**
+ * @param cellSize Size of the cells (in meters)
+ */
+void SpatialHashAlgorithm::setCellSize(decimal cellSize) {
+
+    assert(cellSize > decimal(0.0));
+
+    mCellSize = cellSize;
+    rehash(static_cast<uint>(mBuckets.size()));
+}
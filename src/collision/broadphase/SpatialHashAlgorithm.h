@@ -0,0 +1,259 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_SPATIAL_HASH_ALGORITHM_H
+#define REACTPHYSICS3D_SPATIAL_HASH_ALGORITHM_H
+
+// Libraries
+#include <vector>
+#include "BroadPhaseAlgorithm.h"
+#include "collision/shapes/AABB.h"
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Declarations
+struct TreeRaycastQuery;
+
+// Structure SpatialHashProxy
+/**
+ * This structure represents a proxy shape in the spatial hash broad-phase. The
+ * broad-phase ID of a proxy shape is the index of its proxy in the array of proxies.
+ */
+struct SpatialHashProxy {
+
+    // -------------------- Attributes -------------------- //
+
+    /// Pointer to the proxy shape (NULL if the proxy is not used)
+    ProxyShape* proxyShape;
+
+    /// Fat AABB of the proxy shape
+    AABB aabb;
+
+    /// Coordinates of the cell that contains the minimum point of the fat AABB
+    int minCell[3];
+
+    /// Coordinates of the cell that contains the maximum point of the fat AABB
+    int maxCell[3];
+
+    /// True if the body of the proxy shape is static
+    bool isStatic;
+
+    /// True if the shape overlaps too many cells to be stored in the grid
+    bool isLarge;
+};
+
+// Class SpatialHashAlgorithm
+/**
+ * This class implements the broad-phase collision detection with a uniform grid of cubic
+ * cells. Only the non-empty cells are stored in a hash table. Each bucket of the table
+ * contains the broad-phase IDs of the proxy shapes whose fat AABB overlaps with a cell of
+ * the bucket. Adding, removing or moving a small shape only changes the buckets of the few
+ * cells that it overlaps (in constant expected time) and the shapes that overlap with a
+ * moved shape are found in the buckets of its cells. An overlapping pair of shapes is only
+ * reported in the cell that contains the maximum of the minimum points of their AABBs so
+ * that the pairs are not reported several times (even if the cells of a bucket collide).
+ * The shapes that overlap with too many cells (very large shapes compared to the cells)
+ * are not stored in the grid but in a list that is tested with all the moved shapes. This
+ * algorithm is usually faster than the AABB trees for very large worlds with many small
+ * shapes spread uniformly. The size of the cells should be larger than most of the shapes.
+ */
+class SpatialHashAlgorithm : public BroadPhaseAlgorithm {
+
+    public :
+
+        // -------------------- Constants -------------------- //
+
+        /// Maximum number of cells that a shape can overlap to be stored in the grid
+        static const uint NB_MAX_CELLS_PER_SHAPE = 64;
+
+        /// Initial number of buckets of the hash table
+        static const uint NB_INITIAL_BUCKETS = 256;
+
+    protected :
+
+        // -------------------- Attributes -------------------- //
+
+        /// Size of the cells
+        decimal mCellSize;
+
+        /// Buckets of the hash table with the broad-phase IDs of the shapes of their cells
+        std::vector<std::vector<int> > mBuckets;
+
+        /// Number of broad-phase IDs stored in all the buckets
+        uint mNbBucketEntries;
+
+        /// Array of proxies indexed by the broad-phase IDs
+        std::vector<SpatialHashProxy> mProxies;
+
+        /// Broad-phase IDs of the non-used proxies
+        std::vector<int> mFreeProxyIDs;
+
+        /// Broad-phase IDs of the shapes that are not stored in the grid
+        std::vector<int> mLargeShapes;
+
+        // -------------------- Methods -------------------- //
+
+        /// Private copy-constructor
+        SpatialHashAlgorithm(const SpatialHashAlgorithm& algorithm);
+
+        /// Private assignment operator
+        SpatialHashAlgorithm& operator=(const SpatialHashAlgorithm& algorithm);
+
+        /// Compute the coordinate of the cell that contains a coordinate
+        int computeCellCoordinate(decimal coordinate) const;
+
+        /// Return the index of the bucket of a cell
+        uint computeBucketIndex(int x, int y, int z) const;
+
+        /// Compute the cells of the fat AABB of a proxy
+        void computeCells(SpatialHashProxy& proxy) const;
+
+        /// Add a proxy into the buckets of its cells (or into the list of large shapes)
+        void insertProxy(int broadPhaseID);
+
+        /// Remove a proxy from the buckets of its cells (or from the list of large shapes)
+        void extractProxy(int broadPhaseID);
+
+        /// Set the number of buckets of the hash table and insert the proxies again
+        void rehash(uint nbBuckets);
+
+        /// Test a proxy against a ray and return false if the raycast must stop
+        bool raycastProxy(const SpatialHashProxy& proxy, const Ray& ray, RaycastTest& raycastTest,
+                          unsigned short raycastWithCategoryMaskBits, decimal& maxFraction,
+                          TreeRaycastQuery& query) const;
+
+        /// Nothing to prepare before the queries
+        virtual void prepareQueries();
+
+        /// Find all the collision shapes that overlap with a given moved collision shape
+        virtual void queryOverlappingShapes(uint threadIndex, int broadPhaseID);
+
+        /// Return the proxy shape of a given broad-phase ID
+        virtual ProxyShape* getProxyShape(int broadPhaseID) const;
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        SpatialHashAlgorithm(CollisionDetection& collisionDetection);
+
+        /// Destructor
+        virtual ~SpatialHashAlgorithm();
+
+        /// Add a proxy collision shape into the broad-phase collision detection
+        virtual void addProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb);
+
+        /// Remove a proxy collision shape from the broad-phase collision detection
+        virtual void removeProxyCollisionShape(ProxyShape* proxyShape);
+
+        /// Notify the broad-phase that a collision shape has moved and need to be updated
+        virtual void updateProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb,
+                                               const Vector3& displacement, bool forceReinsert = false);
+
+        /// Return true if the two broad-phase collision shapes are overlapping
+        virtual bool testOverlappingShapes(const ProxyShape* shape1, const ProxyShape* shape2) const;
+
+        /// Ray casting method
+        virtual void raycast(const Ray& ray, RaycastTest& raycastTest,
+                             unsigned short raycastWithCategoryMaskBits) const;
+
+        /// Find all the proxy shapes whose fat AABB overlaps with a given AABB
+        virtual void reportShapesOverlappingWithAABB(const AABB& aabb,
+                                                     std::vector<ProxyShape*>& overlappingShapes) const;
+
+        /// Start a bulk insertion of collision shapes
+        virtual void beginBulkInsertion();
+
+        /// End a bulk insertion of collision shapes
+        virtual void endBulkInsertion();
+
+        /// Insert all the proxy shapes into the hash table again
+        virtual void rebuild();
+
+        /// Set the size of the cells of the grid
+        void setCellSize(decimal cellSize);
+
+        /// Return the size of the cells of the grid
+        decimal getCellSize() const;
+};
+
+// Compute the coordinate of the cell that contains a coordinate
+inline int SpatialHashAlgorithm::computeCellCoordinate(decimal coordinate) const {
+    const decimal cell = std::floor(coordinate / mCellSize);
+    if (cell < decimal(-(1 << 30))) return -(1 << 30);
+    if (cell > decimal(1 << 30)) return 1 << 30;
+    return static_cast<int>(cell);
+}
+
+// Return the index of the bucket of a cell
+inline uint SpatialHashAlgorithm::computeBucketIndex(int x, int y, int z) const {
+    const uint hash = (static_cast<uint>(x) * 73856093u) ^ (static_cast<uint>(y) * 19349663u) ^
+                      (static_cast<uint>(z) * 83492791u);
+    return hash & static_cast<uint>(mBuckets.size() - 1);
+}
+
+// Return the proxy shape of a given broad-phase ID
+inline ProxyShape* SpatialHashAlgorithm::getProxyShape(int broadPhaseID) const {
+    assert(broadPhaseID >= 0 && broadPhaseID < static_cast<int>(mProxies.size()));
+    return mProxies[broadPhaseID].proxyShape;
+}
+
+// Return true if the two broad-phase collision shapes are overlapping
+inline bool SpatialHashAlgorithm::testOverlappingShapes(const ProxyShape* shape1,
+                                                        const ProxyShape* shape2) const {
+    return mProxies[shape1->mBroadPhaseID].aabb.testCollision(mProxies[shape2->mBroadPhaseID].aabb);
+}
+
+// Nothing to prepare before the queries
+inline void SpatialHashAlgorithm::prepareQueries() {
+
+}
+
+// Start a bulk insertion of collision shapes
+/// The shapes are inserted one by one in constant time into the hash table.
+inline void SpatialHashAlgorithm::beginBulkInsertion() {
+
+}
+
+// End a bulk insertion of collision shapes
+inline void SpatialHashAlgorithm::endBulkInsertion() {
+
+}
+
+// Insert all the proxy shapes into the hash table again
+inline void SpatialHashAlgorithm::rebuild() {
+    rehash(static_cast<uint>(mBuckets.size()));
+}
+
+// Return the size of the cells of the grid
+inline decimal SpatialHashAlgorithm::getCellSize() const {
+    return mCellSize;
+}
+
+}
+
+#endif
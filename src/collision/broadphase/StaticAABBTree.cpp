@@ -0,0 +1,380 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "StaticAABBTree.h"
+#include "TreeBuilder.h"
+#include "TreeRaycastQuery.h"
+#include "memory/Stack.h"
+#include "engine/Profiler.h"
+#include <cmath>
+#include <cstring>
+
+using namespace reactphysics3d;
+
+// Initialization of static variables
+const uint32 StaticTreeNode::LEAF_BIT = 0x80000000u;
+const uint32 StaticAABBTree::MAX_QUANTIZED_VALUE = 0xFFFFu;
+
+// Structure StaticTreeBuildTask
+/**
+ * Range of objects for which a node has to be created during the construction of
+ * the static AABB tree.
+ */
+struct StaticTreeBuildTask {
+
+    /// Range of objects of the node
+    TreeBuildRange range;
+
+    /// Index of the parent node if the node to create is a right child and
+    /// -1 otherwise
+    int rightChildParent;
+};
+
+// Constructor
+StaticAABBTree::StaticAABBTree()
+               : mNodes(NULL), mNbNodes(0), mObjectAABBs(NULL), mObjectData(NULL),
+                 mNbObjects(0), mNbAllocatedObjects(0), mIsBuilt(false) {
+
+}
+
+// Destructor
+StaticAABBTree::~StaticAABBTree() {
+
+    // Release the allocated memory
+    reset();
+}
+
+// Clear all the nodes and objects and reset the tree
+void StaticAABBTree::reset() {
+
+    free(mNodes);
+    free(mObjectAABBs);
+    free(mObjectData);
+
+    mNodes = NULL;
+    mObjectAABBs = NULL;
+    mObjectData = NULL;
+    mNbNodes = 0;
+    mNbObjects = 0;
+    mNbAllocatedObjects = 0;
+    mIsBuilt = false;
+}
+
+// Add an object into the tree
+/// The objects have to be added before the tree is built with the build() method
+/**
+ * @param aabb AABB of the object
+ * @param data1 First integer data of the object
+ * @param data2 Second integer data of the object
+ */
+void StaticAABBTree::addObject(const AABB& aabb, int32 data1, int32 data2) {
+
+    assert(!mIsBuilt);
+
+    // If we need to allocate more objects
+    if (mNbObjects == mNbAllocatedObjects) {
+
+        mNbAllocatedObjects = (mNbAllocatedObjects == 0) ? 64 : 2 * mNbAllocatedObjects;
+
+        AABB* oldAABBs = mObjectAABBs;
+        mObjectAABBs = (AABB*) malloc(mNbAllocatedObjects * sizeof(AABB));
+        assert(mObjectAABBs);
+        for (uint i=0; i<mNbObjects; i++) {
+            new (mObjectAABBs + i) AABB(oldAABBs[i]);
+        }
+        free(oldAABBs);
+
+        int32* oldData = mObjectData;
+        mObjectData = (int32*) malloc(mNbAllocatedObjects * 2 * sizeof(int32));
+        assert(mObjectData);
+        if (oldData != NULL) memcpy(mObjectData, oldData, mNbObjects * 2 * sizeof(int32));
+        free(oldData);
+    }
+
+    new (mObjectAABBs + mNbObjects) AABB(aabb);
+    mObjectData[2 * mNbObjects] = data1;
+    mObjectData[2 * mNbObjects + 1] = data2;
+    mNbObjects++;
+}
+
+// Build the tree with all the objects that have been added
+/// The tree is built top-down. The objects of each node are split in two with the
+/// Surface Area Heuristic (SAH) evaluated on a fixed number of bins along the largest
+/// axis of the AABB of the object centers. The nodes are created in depth-first order.
+/// There is a single object per leaf, the tree has therefore exactly 2n-1 nodes.
+void StaticAABBTree::build() {
+
+    PROFILE("StaticAABBTree::build()");
+
+    assert(!mIsBuilt);
+
+    mIsBuilt = true;
+    if (mNbObjects == 0) {
+        mRootAABB = AABB();
+        return;
+    }
+
+    // Compute the centers of the objects and the AABB of the whole tree
+    TreeBuildObject* objects = new TreeBuildObject[mNbObjects];
+    for (uint i=0; i<mNbObjects; i++) {
+        objects[i].aabb = mObjectAABBs[i];
+        objects[i].center = mObjectAABBs[i].getCenter();
+        objects[i].index = i;
+    }
+    StaticTreeBuildTask rootTask;
+    rootTask.range.start = 0;
+    rootTask.range.end = mNbObjects;
+    rootTask.rightChildParent = -1;
+    TreeBuilder::computeRangeAABBs(objects, rootTask.range);
+    mRootAABB = rootTask.range.aabb;
+
+    // Compute the factors used to quantize the coordinates of the node AABBs (an
+    // axis along which the tree is flat is not scaled)
+    const Vector3 extent = mRootAABB.getMax() - mRootAABB.getMin();
+    for (int i=0; i<3; i++) {
+        if (extent[i] > decimal(0.0)) {
+            mQuantizationScale[i] = decimal(MAX_QUANTIZED_VALUE) / extent[i];
+        }
+        else {
+            mQuantizationScale[i] = decimal(1.0);
+        }
+    }
+
+    // Allocate the nodes of the tree
+    mNodes = (StaticTreeNode*) malloc((2 * mNbObjects - 1) * sizeof(StaticTreeNode));
+    assert(mNodes);
+    mNbNodes = 0;
+
+    // Create the nodes in depth-first order
+    Stack<StaticTreeBuildTask, 64> stack;
+    stack.push(rootTask);
+    while (stack.getNbElements() > 0) {
+
+        const StaticTreeBuildTask task = stack.pop();
+
+        // Create the node (the right child index of the parent node is set
+        // now that we know the index of the node)
+        const uint nodeIndex = mNbNodes;
+        mNbNodes++;
+        if (task.rightChildParent >= 0) {
+            mNodes[task.rightChildParent].index = nodeIndex;
+        }
+        StaticTreeNode& node = mNodes[nodeIndex];
+        quantize(task.range.aabb, node.quantizedMin, node.quantizedMax);
+
+        // If there is a single object, the node is a leaf
+        if (task.range.end - task.range.start == 1) {
+            node.index = task.range.start | StaticTreeNode::LEAF_BIT;
+            continue;
+        }
+
+        // Split the objects and create the two children (the left child is the
+        // next node because the right child task is pushed first)
+        StaticTreeBuildTask leftTask;
+        StaticTreeBuildTask rightTask;
+        leftTask.rightChildParent = -1;
+        rightTask.rightChildParent = static_cast<int>(nodeIndex);
+        TreeBuilder::splitRange(objects, task.range, leftTask.range, rightTask.range);
+        stack.push(rightTask);
+        stack.push(leftTask);
+    }
+    assert(mNbNodes == 2 * mNbObjects - 1);
+
+    // Store the data of the objects in the order of the leaves
+    int32* sortedData = (int32*) malloc(mNbObjects * 2 * sizeof(int32));
+    assert(sortedData);
+    for (uint i=0; i<mNbObjects; i++) {
+        sortedData[2 * i] = mObjectData[2 * objects[i].index];
+        sortedData[2 * i + 1] = mObjectData[2 * objects[i].index + 1];
+    }
+    free(mObjectData);
+    mObjectData = sortedData;
+    mNbAllocatedObjects = mNbObjects;
+
+    // The AABBs of the objects are not needed anymore
+    free(mObjectAABBs);
+    mObjectAABBs = NULL;
+
+    delete[] objects;
+}
+
+// Quantize the minimum and maximum coordinates of an AABB
+/// The quantized AABB always contains the AABB in parameter (the coordinates are
+/// rounded down for the minimum and up for the maximum and one more quantization
+/// step is added to counteract arithmetic errors).
+void StaticAABBTree::quantize(const AABB& aabb, uint16* quantizedMin, uint16* quantizedMax) const {
+
+    for (int i=0; i<3; i++) {
+        const decimal min = std::floor((aabb.getMin()[i] - mRootAABB.getMin()[i]) * mQuantizationScale[i]);
+        const decimal max = std::ceil((aabb.getMax()[i] - mRootAABB.getMin()[i]) * mQuantizationScale[i]);
+        quantizedMin[i] = static_cast<uint16>(clamp(min - decimal(1.0), decimal(0.0),
+                                                    decimal(MAX_QUANTIZED_VALUE)));
+        quantizedMax[i] = static_cast<uint16>(clamp(max + decimal(1.0), decimal(0.0),
+                                                    decimal(MAX_QUANTIZED_VALUE)));
+    }
+}
+
+// Return the coordinates of a point in the quantized space of the tree
+Vector3 StaticAABBTree::quantize(const Vector3& point) const {
+
+    const Vector3& rootMin = mRootAABB.getMin();
+    return Vector3((point.x - rootMin.x) * mQuantizationScale.x,
+                   (point.y - rootMin.y) * mQuantizationScale.y,
+                   (point.z - rootMin.z) * mQuantizationScale.z);
+}
+
+// Report all objects whose AABB overlaps with the AABB given in parameter.
+/// The index given to the callback is the index of the object that can be used with
+/// the getNodeDataInt() method. The AABB is quantized (conservatively) once and the
+/// nodes are then tested with integer comparisons only.
+void StaticAABBTree::reportAllShapesOverlappingWithAABB(const AABB& aabb,
+                                                        DynamicAABBTreeOverlapCallback& callback) const {
+
+    assert(mIsBuilt);
+
+    if (mNbNodes == 0 || !aabb.testCollision(mRootAABB)) return;
+
+    // Quantize the AABB
+    uint16 queryMin[3];
+    uint16 queryMax[3];
+    for (int i=0; i<3; i++) {
+        const decimal min = std::floor((aabb.getMin()[i] - mRootAABB.getMin()[i]) * mQuantizationScale[i]);
+        const decimal max = std::ceil((aabb.getMax()[i] - mRootAABB.getMin()[i]) * mQuantizationScale[i]);
+        queryMin[i] = static_cast<uint16>(clamp(min, decimal(0.0), decimal(MAX_QUANTIZED_VALUE)));
+        queryMax[i] = static_cast<uint16>(clamp(max, decimal(0.0), decimal(MAX_QUANTIZED_VALUE)));
+    }
+
+    // Right children that remain to be visited
+    Stack<uint32, 64> stack;
+    uint32 nodeIndex = 0;
+
+    while (true) {
+
+        const StaticTreeNode& node = mNodes[nodeIndex];
+
+        // If the AABB overlaps with the AABB of the node
+        if (node.quantizedMin[0] <= queryMax[0] && node.quantizedMax[0] >= queryMin[0] &&
+            node.quantizedMin[1] <= queryMax[1] && node.quantizedMax[1] >= queryMin[1] &&
+            node.quantizedMin[2] <= queryMax[2] && node.quantizedMax[2] >= queryMin[2]) {
+
+            if (node.isLeaf()) {
+
+                // Report the object of the leaf
+                callback.notifyOverlappingNode(static_cast<int>(node.getObjectIndex()));
+            }
+            else {
+
+                // Visit the left child (next node) now and the right child later
+                stack.push(node.getRightChildIndex());
+                nodeIndex++;
+                continue;
+            }
+        }
+
+        if (stack.getNbElements() == 0) return;
+        nodeIndex = stack.pop();
+    }
+}
+
+// Ray casting method
+/// The index given to the callback is the index of the object that can be used with
+/// the getNodeDataInt() method.
+void StaticAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback) const {
+
+    PROFILE("StaticAABBTree::raycast()");
+
+    assert(mIsBuilt);
+
+    if (mNbNodes == 0) return;
+
+    decimal maxFraction = ray.maxFraction;
+
+    // The ray is tested against the node AABBs in the quantized space of the tree
+    // (this is an affine transformation that preserves the intersections) so that
+    // the nodes do not have to be dequantized
+    const Ray quantizedRay(quantize(ray.point1), quantize(ray.point2));
+    TreeRaycastQuery query;
+    query.update(quantizedRay, maxFraction);
+
+    // Right children that remain to be visited
+    Stack<uint32, 64> stack;
+    uint32 nodeIndex = 0;
+
+    while (true) {
+
+        const StaticTreeNode& node = mNodes[nodeIndex];
+
+        // Test if the ray intersects with the current node AABB
+#ifdef REACTPHYSICS3D_SSE_ENABLED
+        // The quantized coordinates are converted directly into registers (going
+        // through an AABB in memory would stall on the loads of the coordinates)
+        const __m128 nodeMin = _mm_setr_ps(node.quantizedMin[0], node.quantizedMin[1],
+                                           node.quantizedMin[2], 0);
+        const __m128 nodeMax = _mm_setr_ps(node.quantizedMax[0], node.quantizedMax[1],
+                                           node.quantizedMax[2], 0);
+        const bool isRayIntersecting = query.testRayIntersect(nodeMin, nodeMax);
+#else
+        const AABB nodeAABB(Vector3(node.quantizedMin[0], node.quantizedMin[1], node.quantizedMin[2]),
+                            Vector3(node.quantizedMax[0], node.quantizedMax[1], node.quantizedMax[2]));
+        const bool isRayIntersecting = query.testRayIntersect(nodeAABB);
+#endif
+        if (isRayIntersecting) {
+
+            // If the node is a leaf of the tree
+            if (node.isLeaf()) {
+
+                Ray rayTemp(ray.point1, ray.point2, maxFraction);
+
+                // Call the callback that will raycast again the object
+                decimal hitFraction = callback.raycastBroadPhaseShape(static_cast<int32>(node.getObjectIndex()),
+                                                                      rayTemp);
+
+                // If the user returned a hitFraction of zero, it means that
+                // the raycasting should stop here
+                if (hitFraction == decimal(0.0)) {
+                    return;
+                }
+
+                // If the user returned a positive fraction smaller than the current
+                // one, we update the ray
+                if (hitFraction > decimal(0.0) && hitFraction < maxFraction) {
+                    maxFraction = hitFraction;
+                    query.update(quantizedRay, maxFraction);
+                }
+            }
+            else {
+
+                // Visit the left child (next node) now and the right child later
+                stack.push(node.getRightChildIndex());
+                nodeIndex++;
+                continue;
+            }
+        }
+
+        if (stack.getNbElements() == 0) return;
+        nodeIndex = stack.pop();
+    }
+}
@@ -0,0 +1,230 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_STATIC_AABB_TREE_H
+#define REACTPHYSICS3D_STATIC_AABB_TREE_H
+
+// Libraries
+#include "configuration.h"
+#include "collision/shapes/AABB.h"
+#include "DynamicAABBTree.h"
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Structure StaticTreeNode
+/**
+ * This structure represents a node of the static AABB tree. The nodes are stored
+ * in depth-first order. Therefore, the left child of an internal node is always the
+ * next node in the array and only the index of the right child is stored. The AABB
+ * of the node is quantized on 16 bits per coordinate relative to the AABB of the
+ * whole tree.
+ */
+struct StaticTreeNode {
+
+    // -------------------- Constants -------------------- //
+
+    /// Bit of the "index" attribute that is set for a leaf node
+    const static uint32 LEAF_BIT;
+
+    // -------------------- Attributes -------------------- //
+
+    /// Quantized minimum coordinates of the node AABB
+    uint16 quantizedMin[3];
+
+    /// Quantized maximum coordinates of the node AABB
+    uint16 quantizedMax[3];
+
+    /// Index of the right child node (internal node) or index of the
+    /// object with the leaf bit set (leaf node)
+    uint32 index;
+
+    // -------------------- Methods -------------------- //
+
+    /// Return true if the node is a leaf of the tree
+    bool isLeaf() const;
+
+    /// Return the index of the right child of an internal node
+    uint32 getRightChildIndex() const;
+
+    /// Return the index of the object of a leaf node
+    uint32 getObjectIndex() const;
+};
+
+// Class StaticAABBTree
+/**
+ * This class implements a compact bounding volume hierarchy for static objects
+ * (the triangles of a concave mesh for instance). The objects are first added with
+ * the addObject() method and the tree is then built once with the build() method.
+ * The tree is built top-down using the Surface Area Heuristic (SAH) with binning
+ * and is stored as a depth-first linear array of quantized nodes. The tree cannot
+ * be modified after it has been built, it has to be reset and built again.
+ */
+class StaticAABBTree {
+
+    private:
+
+        // -------------------- Constants -------------------- //
+
+        /// Maximum quantized coordinate
+        static const uint32 MAX_QUANTIZED_VALUE;
+
+        // -------------------- Attributes -------------------- //
+
+        /// Nodes of the tree (in depth-first order)
+        StaticTreeNode* mNodes;
+
+        /// Number of nodes of the tree
+        uint mNbNodes;
+
+        /// AABBs of the objects added before the tree is built
+        AABB* mObjectAABBs;
+
+        /// Data of the objects (two integers for each object)
+        int32* mObjectData;
+
+        /// Number of objects in the tree
+        uint mNbObjects;
+
+        /// Number of allocated objects
+        uint mNbAllocatedObjects;
+
+        /// AABB of the whole tree (used to quantize the node AABBs)
+        AABB mRootAABB;
+
+        /// Factors used to convert a local coordinate into a quantized coordinate
+        Vector3 mQuantizationScale;
+
+        /// True if the tree has been built
+        bool mIsBuilt;
+
+        // -------------------- Methods -------------------- //
+
+        /// Private copy-constructor
+        StaticAABBTree(const StaticAABBTree& tree);
+
+        /// Private assignment operator
+        StaticAABBTree& operator=(const StaticAABBTree& tree);
+
+        /// Quantize the minimum and maximum coordinates of an AABB (conservatively)
+        void quantize(const AABB& aabb, uint16* quantizedMin, uint16* quantizedMax) const;
+
+        /// Return the coordinates of a point in the quantized space of the tree
+        Vector3 quantize(const Vector3& point) const;
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        StaticAABBTree();
+
+        /// Destructor
+        ~StaticAABBTree();
+
+        /// Add an object into the tree (where node data are two integers)
+        void addObject(const AABB& aabb, int32 data1, int32 data2);
+
+        /// Build the tree with all the objects that have been added
+        void build();
+
+        /// Clear all the nodes and objects and reset the tree
+        void reset();
+
+        /// Return the number of objects in the tree
+        uint getNbObjects() const;
+
+        /// Return the number of nodes of the tree
+        uint getNbNodes() const;
+
+        /// Return the pointer to the data array of a given object of the tree
+        const int32* getNodeDataInt(int objectIndex) const;
+
+        /// Return the AABB of the whole tree
+        const AABB& getRootAABB() const;
+
+        /// Return the number of bytes used by the tree
+        size_t getSizeInBytes() const;
+
+        /// Report all objects whose AABB overlaps with the AABB given in parameter.
+        void reportAllShapesOverlappingWithAABB(const AABB& aabb,
+                                                DynamicAABBTreeOverlapCallback& callback) const;
+
+        /// Ray casting method
+        void raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback) const;
+};
+
+// Return true if the node is a leaf of the tree
+inline bool StaticTreeNode::isLeaf() const {
+    return (index & LEAF_BIT) != 0;
+}
+
+// Return the index of the right child of an internal node
+inline uint32 StaticTreeNode::getRightChildIndex() const {
+    assert(!isLeaf());
+    return index;
+}
+
+// Return the index of the object of a leaf node
+inline uint32 StaticTreeNode::getObjectIndex() const {
+    assert(isLeaf());
+    return index & ~LEAF_BIT;
+}
+
+// Return the number of objects in the tree
+inline uint StaticAABBTree::getNbObjects() const {
+    return mNbObjects;
+}
+
+// Return the number of nodes of the tree
+inline uint StaticAABBTree::getNbNodes() const {
+    return mNbNodes;
+}
+
+// Return the pointer to the data array of a given object of the tree
+/**
+ * @param objectIndex Index of the object (as reported by the overlap and raycast queries)
+ */
+inline const int32* StaticAABBTree::getNodeDataInt(int objectIndex) const {
+    assert(objectIndex >= 0 && objectIndex < static_cast<int>(mNbObjects));
+    return mObjectData + 2 * objectIndex;
+}
+
+// Return the AABB of the whole tree
+inline const AABB& StaticAABBTree::getRootAABB() const {
+    assert(mIsBuilt);
+    return mRootAABB;
+}
+
+// Return the number of bytes used by the tree
+inline size_t StaticAABBTree::getSizeInBytes() const {
+    return sizeof(StaticAABBTree) + mNbNodes * sizeof(StaticTreeNode) +
+           mNbAllocatedObjects * 2 * sizeof(int32) +
+           (mIsBuilt ? 0 : mNbAllocatedObjects * sizeof(AABB));
+}
+
+}
+
+#endif
@@ -0,0 +1,539 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "SweepAndPruneAlgorithm.h"
+#include <algorithm>
+#include "TreeRaycastQuery.h"
+#include "collision/CollisionDetection.h"
+#include "engine/Profiler.h"
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Initialization of static variables
+const int SweepAndPruneAlgorithm::NB_LISTS;
+const uint SweepAndPruneAlgorithm::NB_MAX_INSERTIONS_FOR_INCREMENTAL_SORT;
+
+namespace {
+
+/// Largest absolute value of a band index
+const int MAX_BAND_INDEX = 1 << 30;
+
+// Functor used to sort the entries of a list by band and then along the sweep axis
+struct SweepAndPruneEntryComparator {
+
+    /// Sweep axis
+    int axis;
+
+    /// Return true if the first entry is before the second one
+    bool operator()(const SweepAndPruneEntry& entry1, const SweepAndPruneEntry& entry2) const {
+        if (entry1.band != entry2.band) return entry1.band < entry2.band;
+        return entry1.aabb.getMin()[axis] < entry2.aabb.getMin()[axis];
+    }
+
+    /// Return true if an entry is before a band and a coordinate along the sweep axis
+    bool operator()(const SweepAndPruneEntry& entry, const std::pair<int, decimal>& key) const {
+        if (entry.band != key.first) return entry.band < key.first;
+        return entry.aabb.getMin()[axis] < key.second;
+    }
+};
+
+}
+
+// Constructor
+/// The AABBs of the list of static shapes are not inflated because the static
+/// bodies are rarely moved.
+SweepAndPruneAlgorithm::SweepAndPruneAlgorithm(CollisionDetection& collisionDetection)
+                       :BroadPhaseAlgorithm(collisionDetection), mIsBulkInsertionActive(false) {
+
+    for (int l=0; l<NB_LISTS; l++) {
+        mLists[l].axis = 0;
+        mLists[l].bandAxis = 2;
+        mLists[l].bandWidth = DECIMAL_LARGEST;
+        mLists[l].maxExtent = decimal(0.0);
+        mLists[l].maxBandExtent = decimal(0.0);
+        mLists[l].extraAABBGap = (l == STATIC) ? decimal(0.0) : DYNAMIC_TREE_AABB_GAP;
+        mLists[l].isSorted = true;
+        mLists[l].nbInsertedEntries = 0;
+        mLists[l].nbRemovedEntries = 0;
+    }
+}
+
+// Destructor
+SweepAndPruneAlgorithm::~SweepAndPruneAlgorithm() {
+
+}
+
+// Compute the band of a list that contains a coordinate along the band axis
+int SweepAndPruneAlgorithm::computeBand(const SweepAndPruneList& list, decimal coordinate) {
+
+    const decimal band = std::floor(coordinate / list.bandWidth);
+    if (band < decimal(-MAX_BAND_INDEX)) return -MAX_BAND_INDEX;
+    if (band > decimal(MAX_BAND_INDEX)) return MAX_BAND_INDEX;
+    return static_cast<int>(band);
+}
+
+// Set the fat AABB of an entry of a list
+void SweepAndPruneAlgorithm::setEntryAABB(SweepAndPruneList& list, SweepAndPruneEntry& entry,
+                                          const AABB& aabb) {
+
+    entry.aabb = aabb;
+    entry.band = computeBand(list, aabb.getMin()[list.bandAxis]);
+    list.maxExtent = std::max(list.maxExtent, aabb.getMax()[list.axis] - aabb.getMin()[list.axis]);
+    list.maxBandExtent = std::max(list.maxBandExtent, aabb.getMax()[list.bandAxis] -
+                                                      aabb.getMin()[list.bandAxis]);
+}
+
+// Return the first entry of a list after a given entry that is not before a given band
+// and a given coordinate along the sweep axis
+std::vector<SweepAndPruneEntry>::const_iterator SweepAndPruneAlgorithm::findFirstEntry(
+        const SweepAndPruneList& list, std::vector<SweepAndPruneEntry>::const_iterator begin,
+        int band, decimal coordinate) {
+
+    SweepAndPruneEntryComparator comparator;
+    comparator.axis = list.axis;
+    return std::lower_bound(begin, list.entries.end(), std::make_pair(band, coordinate), comparator);
+}
+
+// Add a proxy collision shape into the broad-phase collision detection
+void SweepAndPruneAlgorithm::addProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb) {
+
+    // Get a free proxy
+    int broadPhaseID;
+    if (!mFreeProxyIDs.empty()) {
+        broadPhaseID = mFreeProxyIDs.back();
+        mFreeProxyIDs.pop_back();
+    }
+    else {
+        broadPhaseID = static_cast<int>(mProxies.size());
+        mProxies.push_back(SweepAndPruneProxy());
+    }
+
+    // Add the fat AABB at the end of the list of the type of the body
+    const int listIndex = proxyShape->getBody()->getType();
+    SweepAndPruneList& list = mLists[listIndex];
+    SweepAndPruneEntry entry;
+    setEntryAABB(list, entry, computeFatAABB(aabb, Vector3(0, 0, 0), list.extraAABBGap));
+    entry.broadPhaseID = broadPhaseID;
+    list.entries.push_back(entry);
+    list.isSorted = false;
+    list.nbInsertedEntries++;
+
+    SweepAndPruneProxy& proxy = mProxies[broadPhaseID];
+    proxy.proxyShape = proxyShape;
+    proxy.listIndex = listIndex;
+    proxy.entryIndex = static_cast<uint>(list.entries.size() - 1);
+
+    // Set the broad-phase ID of the proxy shape
+    proxyShape->mBroadPhaseID = broadPhaseID;
+    initializeShapeMotion(proxyShape, aabb);
+
+    // Add the collision shape into the array of bodies that have moved (or have been created)
+    // during the last simulation step
+    addMovedCollisionShape(proxyShape);
+}
+
+// Remove a proxy collision shape from the broad-phase collision detection
+/// The entry of the shape is only marked as removed. It is removed from its list
+/// the next time the list is sorted.
+void SweepAndPruneAlgorithm::removeProxyCollisionShape(ProxyShape* proxyShape) {
+
+    int broadPhaseID = proxyShape->mBroadPhaseID;
+
+    SweepAndPruneProxy& proxy = mProxies[broadPhaseID];
+    SweepAndPruneList& list = mLists[proxy.listIndex];
+    assert(list.entries[proxy.entryIndex].broadPhaseID == broadPhaseID);
+    list.entries[proxy.entryIndex].broadPhaseID = -1;
+    list.isSorted = false;
+    list.nbRemovedEntries++;
+
+    // Release the proxy
+    proxy.proxyShape = NULL;
+    mFreeProxyIDs.push_back(broadPhaseID);
+
+    // Remove the collision shape into the array of shapes that have moved (or have been created)
+    // during the last simulation step
+    removeMovedCollisionShape(proxyShape);
+}
+
+// Notify the broad-phase that a collision shape has moved and need to be updated
+void SweepAndPruneAlgorithm::updateProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb,
+                                                       const Vector3& displacement, bool forceReinsert) {
+
+    int broadPhaseID = proxyShape->mBroadPhaseID;
+
+    assert(broadPhaseID >= 0);
+
+    const SweepAndPruneProxy& proxy = mProxies[broadPhaseID];
+    SweepAndPruneList& list = mLists[proxy.listIndex];
+    SweepAndPruneEntry& entry = list.entries[proxy.entryIndex];
+
+    // If the new AABB is still inside the fat AABB of the shape (and if the fat AABB is
+    // not much larger than needed)
+    AABB fatAABB = entry.aabb;
+    if (!updateFatAABB(proxyShape, aabb, displacement, proxy.listIndex == STATIC, forceReinsert,
+                       fatAABB)) {
+        return;
+    }
+
+    // Set the new fat AABB (the list will be sorted again before the next queries)
+    setEntryAABB(list, entry, fatAABB);
+    list.isSorted = false;
+
+    // Add the collision shape into the array of shapes that have moved (or have been created)
+    // during the last simulation step
+    addMovedCollisionShape(proxyShape);
+}
+
+// Sort a list
+/// The entries of the removed shapes are removed from the list. If the list only has a
+/// few new entries, it is sorted with an insertion sort that is nearly linear because the
+/// shapes move little between two steps. Otherwise, the sweep axis and the bands are chosen
+/// again and the list is fully sorted.
+/**
+ * @param list The list to sort
+ * @param isFullSort True if the list has to be fully sorted along a new axis
+ */
+void SweepAndPruneAlgorithm::sortList(SweepAndPruneList& list, bool isFullSort) {
+
+    PROFILE("SweepAndPruneAlgorithm::sortList()");
+
+    std::vector<SweepAndPruneEntry>& entries = list.entries;
+
+    // Remove the entries of the removed shapes (the order of the entries is kept)
+    if (list.nbRemovedEntries > 0) {
+        uint nbEntries = 0;
+        for (uint i=0; i<entries.size(); i++) {
+            if (entries[i].broadPhaseID != -1) {
+                if (nbEntries != i) entries[nbEntries] = entries[i];
+                nbEntries++;
+            }
+        }
+        entries.resize(nbEntries);
+    }
+
+    const uint nbEntries = static_cast<uint>(entries.size());
+
+    if (isFullSort || list.nbInsertedEntries > NB_MAX_INSERTIONS_FOR_INCREMENTAL_SORT ||
+        2 * list.nbInsertedEntries >= nbEntries) {
+
+        // The sweep axis is the axis where the centers of the AABBs are the most spread
+        // and the bands are along the second one. The width of the bands is twice the
+        // average extent of the AABBs along the band axis.
+        if (nbEntries > 1) {
+            Vector3 sum(0, 0, 0);
+            Vector3 sumSquares(0, 0, 0);
+            Vector3 sumExtents(0, 0, 0);
+            for (uint i=0; i<nbEntries; i++) {
+                const Vector3 center = entries[i].aabb.getCenter();
+                sum += center;
+                sumSquares += Vector3(center.x * center.x, center.y * center.y, center.z * center.z);
+                sumExtents += entries[i].aabb.getExtent();
+            }
+            const Vector3 mean = sum / decimal(nbEntries);
+            const Vector3 variance = sumSquares / decimal(nbEntries) -
+                                     Vector3(mean.x * mean.x, mean.y * mean.y, mean.z * mean.z);
+            list.axis = variance.getMaxAxis();
+            const int axis1 = (list.axis + 1) % 3;
+            const int axis2 = (list.axis + 2) % 3;
+            list.bandAxis = variance[axis1] >= variance[axis2] ? axis1 : axis2;
+            const decimal averageExtent = sumExtents[list.bandAxis] / decimal(nbEntries);
+            list.bandWidth = averageExtent > MACHINE_EPSILON ? decimal(2.0) * averageExtent : decimal(1.0);
+        }
+
+        for (uint i=0; i<nbEntries; i++) {
+            entries[i].band = computeBand(list, entries[i].aabb.getMin()[list.bandAxis]);
+        }
+
+        SweepAndPruneEntryComparator comparator;
+        comparator.axis = list.axis;
+        std::sort(entries.begin(), entries.end(), comparator);
+    }
+    else {
+
+        // Insertion sort
+        SweepAndPruneEntryComparator comparator;
+        comparator.axis = list.axis;
+        for (uint i=1; i<nbEntries; i++) {
+            if (!comparator(entries[i], entries[i - 1])) continue;
+            const SweepAndPruneEntry entry = entries[i];
+            uint j = i;
+            while (j > 0 && comparator(entry, entries[j - 1])) {
+                entries[j] = entries[j - 1];
+                j--;
+            }
+            entries[j] = entry;
+        }
+    }
+
+    // Update the entry indices of the proxies and the largest extents of the AABBs
+    list.maxExtent = decimal(0.0);
+    list.maxBandExtent = decimal(0.0);
+    for (uint i=0; i<nbEntries; i++) {
+        const AABB& aabb = entries[i].aabb;
+        mProxies[entries[i].broadPhaseID].entryIndex = i;
+        list.maxExtent = std::max(list.maxExtent, aabb.getMax()[list.axis] - aabb.getMin()[list.axis]);
+        list.maxBandExtent = std::max(list.maxBandExtent, aabb.getMax()[list.bandAxis] -
+                                                          aabb.getMin()[list.bandAxis]);
+    }
+
+    list.isSorted = true;
+    list.nbInsertedEntries = 0;
+    list.nbRemovedEntries = 0;
+}
+
+// Sort the lists before they are queried with the moved collision shapes
+void SweepAndPruneAlgorithm::prepareQueries() {
+
+    assert(!mIsBulkInsertionActive);
+
+    for (int l=0; l<NB_LISTS; l++) {
+        if (!mLists[l].isSorted) {
+            sortList(mLists[l], false);
+        }
+    }
+}
+
+// Find the shapes of a sorted list that overlap with an AABB
+/// The entries of a band that can overlap with the AABB are the ones whose minimum
+/// coordinate along the sweep axis is between the minimum coordinate of the AABB minus
+/// the largest extent of the list and the maximum coordinate of the AABB. The bands
+/// that can contain such entries are found in the same way along the band axis.
+/**
+ * @param list Sorted list to query
+ * @param aabb Fat AABB of the moved collision shape
+ * @param threadIndex Index of the thread that executes the query
+ * @param broadPhaseID Broad-phase ID of the moved collision shape
+ */
+void SweepAndPruneAlgorithm::queryList(const SweepAndPruneList& list, const AABB& aabb,
+                                       uint threadIndex, int broadPhaseID) {
+
+    assert(list.isSorted);
+
+    const int axis = list.axis;
+    const decimal minCoordinate = aabb.getMin()[axis] - list.maxExtent;
+    const decimal maxCoordinate = aabb.getMax()[axis];
+    const int lastBand = computeBand(list, aabb.getMax()[list.bandAxis]);
+    int band = computeBand(list, aabb.getMin()[list.bandAxis] - list.maxBandExtent);
+
+    std::vector<SweepAndPruneEntry>::const_iterator it = list.entries.begin();
+    while (band <= lastBand) {
+
+        // Find the first entry of the band that can overlap with the AABB
+        it = findFirstEntry(list, it, band, minCoordinate);
+        if (it == list.entries.end()) break;
+
+        // If the band is empty, we jump to the next non-empty band
+        if (it->band != band) {
+            band = it->band;
+            continue;
+        }
+
+        // Sweep the band until the entries start after the AABB
+        for (; it != list.entries.end() && it->band == band &&
+               it->aabb.getMin()[axis] <= maxCoordinate; ++it) {
+            if (it->aabb.testCollision(aabb)) {
+                notifyOverlappingNodes(threadIndex, broadPhaseID, it->broadPhaseID);
+            }
+        }
+
+        band++;
+    }
+}
+
+// Find all the collision shapes that overlap with a given moved collision shape
+/**
+ * @param threadIndex Index of the thread that executes the query
+ * @param broadPhaseID Broad-phase ID of the moved collision shape
+ */
+void SweepAndPruneAlgorithm::queryOverlappingShapes(uint threadIndex, int broadPhaseID) {
+
+    const int listIndex = mProxies[broadPhaseID].listIndex;
+    const AABB& aabb = getFatAABB(broadPhaseID);
+
+    // The static shapes never collide with each other and are therefore not tested
+    // against the list of static shapes
+    for (int l=0; l<NB_LISTS; l++) {
+        if (listIndex == STATIC && l == STATIC) continue;
+        queryList(mLists[l], aabb, threadIndex, broadPhaseID);
+    }
+}
+
+// Ray casting method
+/// If a list is sorted, only the entries of the list that can overlap with the AABB of
+/// the ray are tested. Otherwise, all the entries of the list are tested. The ray is
+/// clipped at the closest hit found so far.
+void SweepAndPruneAlgorithm::raycast(const Ray& ray, RaycastTest& raycastTest,
+                                     unsigned short raycastWithCategoryMaskBits) const {
+
+    PROFILE("SweepAndPruneAlgorithm::raycast()");
+
+    assert(!mIsBulkInsertionActive);
+
+    decimal maxFraction = ray.maxFraction;
+    TreeRaycastQuery query;
+    query.update(ray, maxFraction);
+
+    // Compute the AABB of the ray
+    const Vector3 point2 = ray.point1 + maxFraction * (ray.point2 - ray.point1);
+    const Vector3 rayMin(std::min(ray.point1.x, point2.x), std::min(ray.point1.y, point2.y),
+                         std::min(ray.point1.z, point2.z));
+    const Vector3 rayMax(std::max(ray.point1.x, point2.x), std::max(ray.point1.y, point2.y),
+                         std::max(ray.point1.z, point2.z));
+
+    for (int l=0; l<NB_LISTS; l++) {
+
+        const SweepAndPruneList& list = mLists[l];
+        const int axis = list.axis;
+
+        // If the list is not sorted, all its entries are tested in a single band
+        const bool isSorted = list.isSorted;
+        const decimal minCoordinate = rayMin[axis] - list.maxExtent;
+        const decimal maxCoordinate = rayMax[axis];
+        const int lastBand = isSorted ? computeBand(list, rayMax[list.bandAxis]) : 0;
+        int band = isSorted ? computeBand(list, rayMin[list.bandAxis] - list.maxBandExtent) : 0;
+
+        std::vector<SweepAndPruneEntry>::const_iterator it = list.entries.begin();
+        while (band <= lastBand) {
+
+            std::vector<SweepAndPruneEntry>::const_iterator end = list.entries.end();
+            if (isSorted) {
+
+                // Find the first entry of the band that can be hit by the ray
+                it = findFirstEntry(list, it, band, minCoordinate);
+                if (it == list.entries.end()) break;
+
+                // If the band is empty, we jump to the next non-empty band
+                if (it->band != band) {
+                    band = it->band;
+                    continue;
+                }
+            }
+
+            for (; it != end; ++it) {
+
+                if (isSorted && (it->band != band || it->aabb.getMin()[axis] > maxCoordinate)) break;
+
+                if (it->broadPhaseID == -1 || !query.testRayIntersect(it->aabb)) continue;
+
+                ProxyShape* proxyShape = mProxies[it->broadPhaseID].proxyShape;
+
+                // Check if the raycast filtering mask allows raycast against this shape
+                if ((raycastWithCategoryMaskBits & proxyShape->getCollisionCategoryBits()) == 0) continue;
+
+                // Ask the collision detection to perform a ray cast test against the shape
+                const decimal hitFraction = raycastTest.raycastAgainstShape(proxyShape,
+                                                        Ray(ray.point1, ray.point2, maxFraction));
+
+                // If the user returned a hitFraction of zero, it means that
+                // the raycasting should stop here
+                if (hitFraction == decimal(0.0)) return;
+
+                // If the user returned a positive fraction, we update the maximum
+                // fraction value to clip the ray
+                if (hitFraction > decimal(0.0) && hitFraction < maxFraction) {
+                    maxFraction = hitFraction;
+                    query.update(ray, maxFraction);
+                }
+            }
+
+            band++;
+        }
+    }
+}
+
+// Find all the proxy shapes whose fat AABB overlaps with a given AABB
+void SweepAndPruneAlgorithm::reportShapesOverlappingWithAABB(const AABB& aabb,
+                                                             std::vector<ProxyShape*>& overlappingShapes) const {
+
+    assert(!mIsBulkInsertionActive);
+
+    for (int l=0; l<NB_LISTS; l++) {
+
+        const SweepAndPruneList& list = mLists[l];
+        const int axis = list.axis;
+
+        // If the list is not sorted, all its entries are tested in a single band
+        const bool isSorted = list.isSorted;
+        const decimal minCoordinate = aabb.getMin()[axis] - list.maxExtent;
+        const decimal maxCoordinate = aabb.getMax()[axis];
+        const int lastBand = isSorted ? computeBand(list, aabb.getMax()[list.bandAxis]) : 0;
+        int band = isSorted ? computeBand(list, aabb.getMin()[list.bandAxis] - list.maxBandExtent) : 0;
+
+        std::vector<SweepAndPruneEntry>::const_iterator it = list.entries.begin();
+        while (band <= lastBand) {
+
+            if (isSorted) {
+
+                // Find the first entry of the band that can overlap with the AABB
+                it = findFirstEntry(list, it, band, minCoordinate);
+                if (it == list.entries.end()) break;
+
+                // If the band is empty, we jump to the next non-empty band
+                if (it->band != band) {
+                    band = it->band;
+                    continue;
+                }
+            }
+
+            for (; it != list.entries.end(); ++it) {
+
+                if (isSorted && (it->band != band || it->aabb.getMin()[axis] > maxCoordinate)) break;
+
+                if (it->broadPhaseID != -1 && it->aabb.testCollision(aabb)) {
+                    overlappingShapes.push_back(mProxies[it->broadPhaseID].proxyShape);
+                }
+            }
+
+            band++;
+        }
+    }
+}
+
+// End a bulk insertion of collision shapes and sort the lists
+void SweepAndPruneAlgorithm::endBulkInsertion() {
+
+    assert(mIsBulkInsertionActive);
+
+    mIsBulkInsertionActive = false;
+
+    for (int l=0; l<NB_LISTS; l++) {
+        if (!mLists[l].isSorted) {
+            sortList(mLists[l], true);
+        }
+    }
+}
+
+// Fully sort the lists again (and choose their sort axis again)
+/// This can improve the performance of the queries after the bodies of the world
+/// have moved a lot (for instance if the main direction in which they are spread
+/// has changed).
+void SweepAndPruneAlgorithm::rebuild() {
+
+    for (int l=0; l<NB_LISTS; l++) {
+        sortList(mLists[l], true);
+    }
+}
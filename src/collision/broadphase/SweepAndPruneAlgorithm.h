@@ -0,0 +1,273 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_SWEEP_AND_PRUNE_ALGORITHM_H
+#define REACTPHYSICS3D_SWEEP_AND_PRUNE_ALGORITHM_H
+
+// Libraries
+#include <vector>
+#include "BroadPhaseAlgorithm.h"
+#include "collision/shapes/AABB.h"
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Structure SweepAndPruneEntry
+/**
+ * This structure represents an element of a sorted list of the sweep-and-prune
+ * broad-phase. It contains the fat AABB of a proxy shape.
+ */
+struct SweepAndPruneEntry {
+
+    // -------------------- Attributes -------------------- //
+
+    /// Fat AABB of the proxy shape
+    AABB aabb;
+
+    /// Index of the band of the list that contains the minimum coordinate of the AABB
+    int band;
+
+    /// Broad-phase ID of the proxy shape (-1 if the proxy shape has been removed)
+    int broadPhaseID;
+};
+
+// Structure SweepAndPruneProxy
+/**
+ * This structure stores the location of a proxy shape in the sorted lists of
+ * the sweep-and-prune broad-phase. The broad-phase ID of a proxy shape is the
+ * index of its proxy in the array of proxies.
+ */
+struct SweepAndPruneProxy {
+
+    // -------------------- Attributes -------------------- //
+
+    /// Pointer to the proxy shape (NULL if the proxy is not used)
+    ProxyShape* proxyShape;
+
+    /// Index of the sorted list that contains the proxy shape
+    int listIndex;
+
+    /// Index of the entry of the proxy shape in its sorted list
+    uint entryIndex;
+};
+
+// Structure SweepAndPruneList
+/**
+ * This structure represents a list of entries of the sweep-and-prune broad-phase. The
+ * space is divided into parallel bands along a band axis. The entries are sorted by
+ * the band that contains the minimum coordinate of their AABB along the band axis
+ * and then by the minimum coordinate of their AABB along the sweep axis. Each band
+ * is therefore a small sweep-and-prune list. The list is sorted again before the
+ * queries if some entries have changed.
+ */
+struct SweepAndPruneList {
+
+    // -------------------- Attributes -------------------- //
+
+    /// Entries of the list
+    std::vector<SweepAndPruneEntry> entries;
+
+    /// Axis (0, 1 or 2) along which the entries of a band are sorted
+    int axis;
+
+    /// Axis (0, 1 or 2) along which the space is divided into bands
+    int bandAxis;
+
+    /// Width of the bands along the band axis
+    decimal bandWidth;
+
+    /// Upper bound of the extent of the AABBs of the entries along the sweep axis
+    decimal maxExtent;
+
+    /// Upper bound of the extent of the AABBs of the entries along the band axis
+    decimal maxBandExtent;
+
+    /// Extra gap used to inflate the AABBs of the entries
+    decimal extraAABBGap;
+
+    /// True if the entries are sorted
+    bool isSorted;
+
+    /// Number of entries that have been added since the last sort
+    uint nbInsertedEntries;
+
+    /// Number of entries that have been removed since the last sort
+    uint nbRemovedEntries;
+};
+
+// Class SweepAndPruneAlgorithm
+/**
+ * This class implements the broad-phase collision detection with the sweep-and-prune
+ * algorithm. The fat AABBs of the proxy shapes of the static, kinematic and dynamic bodies
+ * are stored in three different lists (so that the static shapes are never tested against
+ * each other). The sweep axis of a list is the axis where the centers of the AABBs are the
+ * most spread. In order to avoid testing all the shapes of a slab of the world along this
+ * axis, the space is also divided into bands along the second axis where the shapes are the
+ * most spread (as in a multi sweep-and-prune, but a shape only belongs to the band of its
+ * minimum coordinate). Because the bodies move little from one step to the next, a list is
+ * sorted again with an insertion sort that is nearly linear. The shapes that overlap with a
+ * moved shape are found by a binary search followed by a sweep in each band that can contain
+ * them. This algorithm is usually faster than the AABB trees for worlds with many shapes of
+ * similar sizes spread along a plane or an axis. However, a very large shape (compared to the
+ * other ones of its list) makes all the queries of the list slower.
+ */
+class SweepAndPruneAlgorithm : public BroadPhaseAlgorithm {
+
+    public :
+
+        // -------------------- Constants -------------------- //
+
+        /// Number of sorted lists (one for each type of body)
+        static const int NB_LISTS = 3;
+
+        /// Maximum number of entries added to a list since its last sort for which the
+        /// list is sorted with an insertion sort (instead of being fully sorted again)
+        static const uint NB_MAX_INSERTIONS_FOR_INCREMENTAL_SORT = 32;
+
+    protected :
+
+        // -------------------- Attributes -------------------- //
+
+        /// Sorted lists of the proxy shapes indexed by the type of their bodies
+        SweepAndPruneList mLists[NB_LISTS];
+
+        /// Array of proxies indexed by the broad-phase IDs
+        std::vector<SweepAndPruneProxy> mProxies;
+
+        /// Broad-phase IDs of the non-used proxies
+        std::vector<int> mFreeProxyIDs;
+
+        /// True if a bulk insertion of collision shapes is in progress
+        bool mIsBulkInsertionActive;
+
+        // -------------------- Methods -------------------- //
+
+        /// Private copy-constructor
+        SweepAndPruneAlgorithm(const SweepAndPruneAlgorithm& algorithm);
+
+        /// Private assignment operator
+        SweepAndPruneAlgorithm& operator=(const SweepAndPruneAlgorithm& algorithm);
+
+        /// Return the fat AABB of a given broad-phase ID
+        const AABB& getFatAABB(int broadPhaseID) const;
+
+        /// Compute the band of a list that contains a coordinate along the band axis
+        static int computeBand(const SweepAndPruneList& list, decimal coordinate);
+
+        /// Set the fat AABB of an entry of a list
+        static void setEntryAABB(SweepAndPruneList& list, SweepAndPruneEntry& entry, const AABB& aabb);
+
+        /// Return the first entry of a list after a given entry that is not before a
+        /// given band and a given coordinate along the sweep axis
+        static std::vector<SweepAndPruneEntry>::const_iterator findFirstEntry(
+                const SweepAndPruneList& list, std::vector<SweepAndPruneEntry>::const_iterator begin,
+                int band, decimal coordinate);
+
+        /// Sort a list
+        void sortList(SweepAndPruneList& list, bool isFullSort);
+
+        /// Find the shapes of a sorted list that overlap with an AABB
+        void queryList(const SweepAndPruneList& list, const AABB& aabb, uint threadIndex,
+                       int broadPhaseID);
+
+        /// Sort the lists before they are queried with the moved collision shapes
+        virtual void prepareQueries();
+
+        /// Find all the collision shapes that overlap with a given moved collision shape
+        virtual void queryOverlappingShapes(uint threadIndex, int broadPhaseID);
+
+        /// Return the proxy shape of a given broad-phase ID
+        virtual ProxyShape* getProxyShape(int broadPhaseID) const;
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        SweepAndPruneAlgorithm(CollisionDetection& collisionDetection);
+
+        /// Destructor
+        virtual ~SweepAndPruneAlgorithm();
+
+        /// Add a proxy collision shape into the broad-phase collision detection
+        virtual void addProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb);
+
+        /// Remove a proxy collision shape from the broad-phase collision detection
+        virtual void removeProxyCollisionShape(ProxyShape* proxyShape);
+
+        /// Notify the broad-phase that a collision shape has moved and need to be updated
+        virtual void updateProxyCollisionShape(ProxyShape* proxyShape, const AABB& aabb,
+                                               const Vector3& displacement, bool forceReinsert = false);
+
+        /// Return true if the two broad-phase collision shapes are overlapping
+        virtual bool testOverlappingShapes(const ProxyShape* shape1, const ProxyShape* shape2) const;
+
+        /// Ray casting method
+        virtual void raycast(const Ray& ray, RaycastTest& raycastTest,
+                             unsigned short raycastWithCategoryMaskBits) const;
+
+        /// Find all the proxy shapes whose fat AABB overlaps with a given AABB
+        virtual void reportShapesOverlappingWithAABB(const AABB& aabb,
+                                                     std::vector<ProxyShape*>& overlappingShapes) const;
+
+        /// Start a bulk insertion of collision shapes
+        virtual void beginBulkInsertion();
+
+        /// End a bulk insertion of collision shapes and sort the lists
+        virtual void endBulkInsertion();
+
+        /// Fully sort the lists again (and choose their sort axis again)
+        virtual void rebuild();
+};
+
+// Return the fat AABB of a given broad-phase ID
+inline const AABB& SweepAndPruneAlgorithm::getFatAABB(int broadPhaseID) const {
+    assert(broadPhaseID >= 0 && broadPhaseID < static_cast<int>(mProxies.size()));
+    const SweepAndPruneProxy& proxy = mProxies[broadPhaseID];
+    assert(proxy.proxyShape != NULL);
+    return mLists[proxy.listIndex].entries[proxy.entryIndex].aabb;
+}
+
+// Return the proxy shape of a given broad-phase ID
+inline ProxyShape* SweepAndPruneAlgorithm::getProxyShape(int broadPhaseID) const {
+    assert(broadPhaseID >= 0 && broadPhaseID < static_cast<int>(mProxies.size()));
+    return mProxies[broadPhaseID].proxyShape;
+}
+
+// Return true if the two broad-phase collision shapes are overlapping
+inline bool SweepAndPruneAlgorithm::testOverlappingShapes(const ProxyShape* shape1,
+                                                          const ProxyShape* shape2) const {
+    return getFatAABB(shape1->mBroadPhaseID).testCollision(getFatAABB(shape2->mBroadPhaseID));
+}
+
+// Start a bulk insertion of collision shapes
+/// The lists are not sorted until the end of the bulk insertion.
+inline void SweepAndPruneAlgorithm::beginBulkInsertion() {
+    mIsBulkInsertionActive = true;
+}
+
+}
+
+#endif
@@ -0,0 +1,250 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "TreeBuilder.h"
+#include <algorithm>
+
+using namespace reactphysics3d;
+
+// Initialization of static variables
+const uint TreeBuilder::NB_BINS;
+
+// Structure TreeBuildBin
+/**
+ * Objects of a range whose centers fall into the same slice along the split axis.
+ * The bounds are stored as plain coordinates because this is the innermost loop
+ * of the construction (the Vector3 constructors are not inlined).
+ */
+struct TreeBuildBin {
+
+    /// Number of objects in the bin
+    uint nbObjects;
+
+    /// Minimum and maximum coordinates of the AABBs of the objects
+    decimal min[3], max[3];
+
+    /// Minimum and maximum coordinates of the centers of the objects
+    decimal minCenter[3], maxCenter[3];
+
+    /// Remove all the objects from the bin
+    void reset() {
+        nbObjects = 0;
+        for (int i=0; i<3; i++) {
+            min[i] = minCenter[i] = DECIMAL_LARGEST;
+            max[i] = maxCenter[i] = DECIMAL_SMALLEST;
+        }
+    }
+
+    /// Add an object into the bin
+    void add(const TreeBuildObject& object) {
+        nbObjects++;
+        const Vector3& objectMin = object.aabb.getMin();
+        const Vector3& objectMax = object.aabb.getMax();
+        for (int i=0; i<3; i++) {
+            min[i] = std::min(min[i], objectMin[i]);
+            max[i] = std::max(max[i], objectMax[i]);
+            minCenter[i] = std::min(minCenter[i], object.center[i]);
+            maxCenter[i] = std::max(maxCenter[i], object.center[i]);
+        }
+    }
+
+    /// Add all the objects of another bin into the bin
+    void add(const TreeBuildBin& bin) {
+        nbObjects += bin.nbObjects;
+        for (int i=0; i<3; i++) {
+            min[i] = std::min(min[i], bin.min[i]);
+            max[i] = std::max(max[i], bin.max[i]);
+            minCenter[i] = std::min(minCenter[i], bin.minCenter[i]);
+            maxCenter[i] = std::max(maxCenter[i], bin.maxCenter[i]);
+        }
+    }
+
+    /// Return the SAH cost of the objects of the bin
+    decimal computeCost() const {
+        if (nbObjects == 0) return decimal(0.0);
+        const decimal dx = max[0] - min[0];
+        const decimal dy = max[1] - min[1];
+        const decimal dz = max[2] - min[2];
+        return nbObjects * decimal(2.0) * (dx * dy + dy * dz + dz * dx);
+    }
+
+    /// Set the AABBs of a range with the objects of the bin
+    void setRangeAABBs(TreeBuildRange& range) const {
+        range.aabb.setMin(Vector3(min[0], min[1], min[2]));
+        range.aabb.setMax(Vector3(max[0], max[1], max[2]));
+        range.centersAABB.setMin(Vector3(minCenter[0], minCenter[1], minCenter[2]));
+        range.centersAABB.setMax(Vector3(maxCenter[0], maxCenter[1], maxCenter[2]));
+    }
+};
+
+// Compute the AABB of a range of objects and the AABB of their centers
+/**
+ * @param objects Array of objects to insert into the tree
+ * @param range Range of objects (its AABBs are computed by the method)
+ */
+void TreeBuilder::computeRangeAABBs(const TreeBuildObject* objects, TreeBuildRange& range) {
+
+    assert(range.end > range.start);
+
+    TreeBuildBin bin;
+    bin.reset();
+    for (uint i=range.start; i<range.end; i++) {
+        bin.add(objects[i]);
+    }
+    bin.setRangeAABBs(range);
+}
+
+// Split a range of objects in two parts
+/// The objects are split along the largest axis of the AABB of their centers at the
+/// bin boundary with the smallest SAH cost. If all the centers are at the same
+/// position, the range is split in the middle. The objects of the range are
+/// reordered so that the objects of the left part come first and the AABBs of the
+/// two parts are computed. Both parts contain at least one object.
+/**
+ * @param objects Array of objects to insert into the tree (reordered by the method)
+ * @param range Range of objects to split (with at least two objects)
+ * @param leftRange Returned left part of the range
+ * @param rightRange Returned right part of the range
+ */
+void TreeBuilder::splitRange(TreeBuildObject* objects, const TreeBuildRange& range,
+                             TreeBuildRange& leftRange, TreeBuildRange& rightRange) {
+
+    const uint start = range.start;
+    const uint end = range.end;
+    const AABB& centersAABB = range.centersAABB;
+    assert(end - start >= 2);
+
+    // Find the largest axis of the AABB of the centers
+    const Vector3 extent = centersAABB.getMax() - centersAABB.getMin();
+    int axis = (extent.x > extent.y) ? 0 : 1;
+    if (extent.z > extent[axis]) axis = 2;
+
+    leftRange.start = start;
+    rightRange.end = end;
+
+    // If all the centers are at the same position, we split in the middle
+    if (extent[axis] <= decimal(0.0)) {
+        leftRange.end = (start + end) / 2;
+        rightRange.start = leftRange.end;
+        computeRangeAABBs(objects, leftRange);
+        computeRangeAABBs(objects, rightRange);
+        return;
+    }
+
+    // Put the objects into the bins (there are fewer bins for the small ranges
+    // because the cost of evaluating the bins would dominate otherwise)
+    const uint nbBins = std::min(NB_BINS, end - start);
+    const decimal minCenter = centersAABB.getMin()[axis];
+    const decimal binFactor = decimal(nbBins) * (decimal(1.0) - decimal(0.0001)) / extent[axis];
+    TreeBuildBin bins[NB_BINS];
+    for (uint b=0; b<nbBins; b++) bins[b].reset();
+    for (uint i=start; i<end; i++) {
+        const uint bin = std::min(static_cast<uint>((objects[i].center[axis] - minCenter) * binFactor),
+                                  nbBins - 1);
+        bins[bin].add(objects[i]);
+    }
+
+    // Compute the right parts for a split after each bin
+    TreeBuildBin rightParts[NB_BINS];
+    rightParts[nbBins - 1].reset();
+    for (int b=nbBins - 2; b >= 0; b--) {
+        rightParts[b] = rightParts[b + 1];
+        rightParts[b].add(bins[b + 1]);
+    }
+
+    // Find the split with the smallest cost (both parts must contain objects)
+    TreeBuildBin leftPart;
+    TreeBuildBin bestLeftPart;
+    leftPart.reset();
+    bestLeftPart.reset();
+    int bestBin = -1;
+    decimal bestCost = DECIMAL_LARGEST;
+    for (uint b=0; b<nbBins - 1; b++) {
+        leftPart.add(bins[b]);
+        if (leftPart.nbObjects == 0 || rightParts[b].nbObjects == 0) continue;
+        const decimal cost = leftPart.computeCost() + rightParts[b].computeCost();
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestBin = static_cast<int>(b);
+            bestLeftPart = leftPart;
+        }
+    }
+    assert(bestBin >= 0);
+
+    // Move the objects of the left bins before the objects of the right bins
+    TreeBuildObject* middle = std::partition(objects + start, objects + end,
+                                             [&](const TreeBuildObject& object) {
+        const uint bin = std::min(static_cast<uint>((object.center[axis] - minCenter) * binFactor),
+                                  nbBins - 1);
+        return static_cast<int>(bin) <= bestBin;
+    });
+
+    leftRange.end = static_cast<uint>(middle - objects);
+    rightRange.start = leftRange.end;
+    assert(leftRange.end - start == bestLeftPart.nbObjects);
+    bestLeftPart.setRangeAABBs(leftRange);
+    rightParts[bestBin].setRangeAABBs(rightRange);
+}
+
+// Split a range of objects in two parts with the same number of objects
+/// The objects are split at the median of their centers along the largest axis of
+/// the AABB of the centers. The resulting tree is balanced, which is used when a
+/// sub-tree of a balanced tree is rebuilt. The objects of the range are reordered
+/// so that the objects of the left part come first and the AABBs of the two parts
+/// are computed.
+/**
+ * @param objects Array of objects to insert into the tree (reordered by the method)
+ * @param range Range of objects to split (with at least two objects)
+ * @param leftRange Returned left part of the range
+ * @param rightRange Returned right part of the range
+ */
+void TreeBuilder::splitRangeAtMedian(TreeBuildObject* objects, const TreeBuildRange& range,
+                                     TreeBuildRange& leftRange, TreeBuildRange& rightRange) {
+
+    const uint start = range.start;
+    const uint end = range.end;
+    const AABB& centersAABB = range.centersAABB;
+    assert(end - start >= 2);
+
+    // Find the largest axis of the AABB of the centers
+    const Vector3 extent = centersAABB.getMax() - centersAABB.getMin();
+    int axis = (extent.x > extent.y) ? 0 : 1;
+    if (extent.z > extent[axis]) axis = 2;
+
+    // Move the objects whose centers are below the median before the other ones
+    const uint middle = (start + end) / 2;
+    std::nth_element(objects + start, objects + middle, objects + end,
+                     [axis](const TreeBuildObject& object1, const TreeBuildObject& object2) {
+        return object1.center[axis] < object2.center[axis];
+    });
+
+    leftRange.start = start;
+    leftRange.end = middle;
+    rightRange.start = middle;
+    rightRange.end = end;
+    computeRangeAABBs(objects, leftRange);
+    computeRangeAABBs(objects, rightRange);
+}
@@ -0,0 +1,105 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_TREE_BUILDER_H
+#define REACTPHYSICS3D_TREE_BUILDER_H
+
+// Libraries
+#include "configuration.h"
+#include "collision/shapes/AABB.h"
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Structure TreeBuildObject
+/**
+ * Object to insert into a tree that is built top-down. The objects are reordered
+ * in place during the construction so that the objects of each node are contiguous.
+ */
+struct TreeBuildObject {
+
+    /// AABB of the object
+    AABB aabb;
+
+    /// Center of the AABB of the object
+    Vector3 center;
+
+    /// Index of the object in the tree
+    uint index;
+};
+
+// Structure TreeBuildRange
+/**
+ * Range of objects (in an array of objects to insert) that belong to a node of a
+ * tree that is built top-down.
+ */
+struct TreeBuildRange {
+
+    /// Index of the first object of the range
+    uint start;
+
+    /// Index after the last object of the range
+    uint end;
+
+    /// AABB of the objects of the range
+    AABB aabb;
+
+    /// AABB of the centers of the objects of the range
+    AABB centersAABB;
+};
+
+// Class TreeBuilder
+/**
+ * This class contains the methods used to build an AABB tree top-down. The objects
+ * of a node are split in two with the Surface Area Heuristic (SAH) evaluated on a
+ * fixed number of bins along the largest axis of the AABB of the object centers.
+ * It is used by both the dynamic and the static AABB trees.
+ */
+class TreeBuilder {
+
+    public:
+
+        // -------------------- Constants -------------------- //
+
+        /// Number of bins used to find the best split of a node with the SAH
+        static const uint NB_BINS = 16;
+
+        // -------------------- Methods -------------------- //
+
+        /// Compute the AABB of a range of objects and the AABB of their centers
+        static void computeRangeAABBs(const TreeBuildObject* objects, TreeBuildRange& range);
+
+        /// Split a range of objects in two parts
+        static void splitRange(TreeBuildObject* objects, const TreeBuildRange& range,
+                               TreeBuildRange& leftRange, TreeBuildRange& rightRange);
+
+        /// Split a range of objects in two parts with the same number of objects
+        static void splitRangeAtMedian(TreeBuildObject* objects, const TreeBuildRange& range,
+                                       TreeBuildRange& leftRange, TreeBuildRange& rightRange);
+};
+
+}
+
+#endif
@@ -0,0 +1,169 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_TREE_RAYCAST_QUERY_H
+#define REACTPHYSICS3D_TREE_RAYCAST_QUERY_H
+
+// Libraries
+#include "configuration.h"
+#include "mathematics/mathematics.h"
+#include "collision/shapes/AABB.h"
+
+#ifdef REACTPHYSICS3D_SSE_ENABLED
+#include <xmmintrin.h>
+#endif
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Structure TreeRaycastQuery
+/**
+ * Ray segment prepared to be tested against the AABBs of the tree nodes. The values
+ * that only depend on the ray are computed once (and again each time the maximum
+ * fraction of the ray changes) instead of for each node. The test is the same
+ * separating axis test as in AABB::testRayIntersect().
+ */
+struct TreeRaycastQuery {
+
+    /// Sum of the two end points of the ray segment
+    Vector3 pointsSum;
+
+    /// Vector from the first to the second point of the ray segment
+    Vector3 d;
+
+    /// Absolute values of the coordinates of "d"
+    Vector3 absD;
+
+#ifdef REACTPHYSICS3D_SSE_ENABLED
+
+    /// Sum of the two end points of the ray segment (x, y, z, 0)
+    __m128 pointsSumSIMD;
+
+    /// Coordinates of "d" in the (x, y, z) order and in the (y, z, x) and (z, x, y) orders
+    __m128 dSIMD, dYZX, dZXY;
+
+    /// Absolute coordinates of "d" and absolute coordinates of "d" plus epsilon in the
+    /// (y, z, x) and (z, x, y) orders
+    __m128 absDSIMD, absDEpsilonYZX, absDEpsilonZXY;
+
+#endif
+
+    /// Compute the values that depend on the ray
+    void update(const Ray& ray, decimal maxFraction) {
+
+        const Vector3 point2 = ray.point1 + maxFraction * (ray.point2 - ray.point1);
+        pointsSum = ray.point1 + point2;
+        d = point2 - ray.point1;
+        absD = Vector3(std::abs(d.x), std::abs(d.y), std::abs(d.z));
+
+#ifdef REACTPHYSICS3D_SSE_ENABLED
+        const decimal epsilon = 0.00001;
+        pointsSumSIMD = _mm_setr_ps(pointsSum.x, pointsSum.y, pointsSum.z, 0);
+        dSIMD = _mm_setr_ps(d.x, d.y, d.z, 0);
+        dYZX = _mm_setr_ps(d.y, d.z, d.x, 0);
+        dZXY = _mm_setr_ps(d.z, d.x, d.y, 0);
+        absDSIMD = _mm_setr_ps(absD.x, absD.y, absD.z, 0);
+        absDEpsilonYZX = _mm_setr_ps(absD.y + epsilon, absD.z + epsilon, absD.x + epsilon, 0);
+        absDEpsilonZXY = _mm_setr_ps(absD.z + epsilon, absD.x + epsilon, absD.y + epsilon, 0);
+#endif
+    }
+
+#ifdef REACTPHYSICS3D_SSE_ENABLED
+
+    /// Return true if the ray segment intersects an AABB given by its minimum and
+    /// maximum coordinates in the first three components of two registers
+    bool testRayIntersect(const __m128& min, const __m128& max) const {
+
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+
+        const __m128 e = _mm_sub_ps(max, min);
+        const __m128 m = _mm_sub_ps(_mm_sub_ps(pointsSumSIMD, min), max);
+
+        // Test if the AABB face normals are separating axis
+        const __m128 absM = _mm_andnot_ps(signMask, m);
+        if (_mm_movemask_ps(_mm_cmpgt_ps(absM, _mm_add_ps(e, absDSIMD))) & 0x7) return false;
+
+        // Test if the cross products between face normals and ray direction are
+        // separating axis
+        const __m128 mYZX = _mm_shuffle_ps(m, m, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 mZXY = _mm_shuffle_ps(m, m, _MM_SHUFFLE(3, 1, 0, 2));
+        const __m128 eYZX = _mm_shuffle_ps(e, e, _MM_SHUFFLE(3, 0, 2, 1));
+        const __m128 eZXY = _mm_shuffle_ps(e, e, _MM_SHUFFLE(3, 1, 0, 2));
+        const __m128 cross = _mm_andnot_ps(signMask, _mm_sub_ps(_mm_mul_ps(mYZX, dZXY),
+                                                                _mm_mul_ps(mZXY, dYZX)));
+        const __m128 radius = _mm_add_ps(_mm_mul_ps(eYZX, absDEpsilonZXY),
+                                         _mm_mul_ps(eZXY, absDEpsilonYZX));
+        return (_mm_movemask_ps(_mm_cmpgt_ps(cross, radius)) & 0x7) == 0;
+    }
+
+#endif
+
+    /// Return true if the ray segment intersects the AABB of a node
+    bool testRayIntersect(const AABB& nodeAABB) const {
+
+#ifdef REACTPHYSICS3D_SSE_ENABLED
+
+        const float* coordinates = &nodeAABB.getMin().x;
+        const __m128 min = _mm_loadu_ps(coordinates);
+        const __m128 high = _mm_loadu_ps(coordinates + 2);
+        const __m128 max = _mm_shuffle_ps(high, high, _MM_SHUFFLE(0, 3, 2, 1));
+        return testRayIntersect(min, max);
+
+#else
+
+        const Vector3& min = nodeAABB.getMin();
+        const Vector3& max = nodeAABB.getMax();
+        const Vector3 e = max - min;
+        const Vector3 m = pointsSum - min - max;
+
+        // Test if the AABB face normals are separating axis
+        if (std::abs(m.x) > e.x + absD.x) return false;
+        if (std::abs(m.y) > e.y + absD.y) return false;
+        if (std::abs(m.z) > e.z + absD.z) return false;
+
+        // Add in an epsilon term to counteract arithmetic errors when segment is
+        // (near) parallel to a coordinate axis
+        const decimal epsilon = 0.00001;
+        const decimal adx = absD.x + epsilon;
+        const decimal ady = absD.y + epsilon;
+        const decimal adz = absD.z + epsilon;
+
+        // Test if the cross products between face normals and ray direction are
+        // separating axis
+        if (std::abs(m.y * d.z - m.z * d.y) > e.y * adz + e.z * ady) return false;
+        if (std::abs(m.z * d.x - m.x * d.z) > e.x * adz + e.z * adx) return false;
+        if (std::abs(m.x * d.y - m.y * d.x) > e.x * ady + e.y * adx) return false;
+
+        // No separating axis has been found
+        return true;
+
+#endif
+    }
+};
+
+}
+
+#endif
+
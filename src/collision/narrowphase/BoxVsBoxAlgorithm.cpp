@@ -0,0 +1,317 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "BoxVsBoxAlgorithm.h"
+#include "collision/shapes/BoxShape.h"
+#include "engine/Profiler.h"
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Constructor
+BoxVsBoxAlgorithm::BoxVsBoxAlgorithm() : NarrowPhaseAlgorithm() {
+
+}
+
+// Destructor
+BoxVsBoxAlgorithm::~BoxVsBoxAlgorithm() {
+
+}
+
+// Compute a contact info if the two bounding volume collide
+/// The separation of the two boxes is computed along the 15 potential separating
+/// axes. The face axes are favored over the edge axes to obtain a stable contact
+/// manifold when a box is resting on another one.
+void BoxVsBoxAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
+                                      const CollisionShapeInfo& shape2Info,
+                                      NarrowPhaseCallback* narrowPhaseCallback) {
+
+    PROFILE("BoxVsBoxAlgorithm::testCollision()");
+
+    assert(shape1Info.collisionShape->getType() == BOX);
+    assert(shape2Info.collisionShape->getType() == BOX);
+
+    const BoxShape* boxShape1 = static_cast<const BoxShape*>(shape1Info.collisionShape);
+    const BoxShape* boxShape2 = static_cast<const BoxShape*>(shape2Info.collisionShape);
+    const Transform& transform1 = shape1Info.shapeToWorldTransform;
+    const Transform& transform2 = shape2Info.shapeToWorldTransform;
+    const Vector3 extent1 = boxShape1->getExtent();
+    const Vector3 extent2 = boxShape2->getExtent();
+
+    // Compute the axes of the two boxes in world-space
+    const Matrix3x3 orientation1 = transform1.getOrientation().getMatrix();
+    const Matrix3x3 orientation2 = transform2.getOrientation().getMatrix();
+    Vector3 axes1[3], axes2[3];
+    for (int i=0; i<3; i++) {
+        axes1[i] = orientation1.getColumn(i);
+        axes2[i] = orientation2.getColumn(i);
+    }
+
+    // Vector between the centers of the two boxes
+    const Vector3 centers = transform2.getPosition() - transform1.getPosition();
+
+    // Compute the absolute values of the dot products between the axes of the two boxes
+    Matrix3x3 absDotAxes;
+    for (int i=0; i<3; i++) {
+        for (int j=0; j<3; j++) {
+            absDotAxes[i][j] = std::abs(axes1[i].dot(axes2[j])) + MACHINE_EPSILON;
+        }
+    }
+
+    // Test the face normals of the first box
+    decimal maxFace1Separation = DECIMAL_SMALLEST;
+    int bestFace1Axis = 0;
+    for (int i=0; i<3; i++) {
+        const decimal separation = std::abs(centers.dot(axes1[i])) - (extent1[i] +
+                                   extent2.x * absDotAxes[i][0] + extent2.y * absDotAxes[i][1] +
+                                   extent2.z * absDotAxes[i][2]);
+        if (separation >= decimal(0.0)) return;
+        if (separation > maxFace1Separation) {
+            maxFace1Separation = separation;
+            bestFace1Axis = i;
+        }
+    }
+
+    // Test the face normals of the second box
+    decimal maxFace2Separation = DECIMAL_SMALLEST;
+    int bestFace2Axis = 0;
+    for (int j=0; j<3; j++) {
+        const decimal separation = std::abs(centers.dot(axes2[j])) - (extent2[j] +
+                                   extent1.x * absDotAxes[0][j] + extent1.y * absDotAxes[1][j] +
+                                   extent1.z * absDotAxes[2][j]);
+        if (separation >= decimal(0.0)) return;
+        if (separation > maxFace2Separation) {
+            maxFace2Separation = separation;
+            bestFace2Axis = j;
+        }
+    }
+
+    // Test the cross products of the edges of the two boxes
+    decimal maxEdgeSeparation = DECIMAL_SMALLEST;
+    int bestEdge1Axis = 0;
+    int bestEdge2Axis = 0;
+    Vector3 bestEdgeAxis;
+    for (int i=0; i<3; i++) {
+        for (int j=0; j<3; j++) {
+
+            Vector3 axis = axes1[i].cross(axes2[j]);
+            const decimal axisLength = axis.length();
+
+            // If the two edges are parallel, the axis has already been tested with the faces
+            if (axisLength < decimal(0.001)) continue;
+            axis /= axisLength;
+
+            decimal projectedExtents = decimal(0.0);
+            for (int k=0; k<3; k++) {
+                projectedExtents += extent1[k] * std::abs(axis.dot(axes1[k])) +
+                                    extent2[k] * std::abs(axis.dot(axes2[k]));
+            }
+            const decimal separation = std::abs(centers.dot(axis)) - projectedExtents;
+            if (separation >= decimal(0.0)) return;
+            if (separation > maxEdgeSeparation) {
+                maxEdgeSeparation = separation;
+                bestEdge1Axis = i;
+                bestEdge2Axis = j;
+                bestEdgeAxis = axis;
+            }
+        }
+    }
+
+    // The two boxes are overlapping. We favor the faces of the first box, then the
+    // faces of the second box and then the edges in order to avoid flipping between
+    // nearly equivalent axes from one frame to the next one.
+    const decimal relativeTolerance = decimal(0.95);
+    const decimal absoluteTolerance = decimal(0.005);
+    const bool isFace2Axis = maxFace2Separation > relativeTolerance * maxFace1Separation +
+                                                  absoluteTolerance;
+    const decimal maxFaceSeparation = isFace2Axis ? maxFace2Separation : maxFace1Separation;
+
+    // If the axis of minimum penetration is the cross product of two edges
+    if (maxEdgeSeparation > relativeTolerance * maxFaceSeparation + absoluteTolerance) {
+
+        // Contact normal from the first box to the second one
+        const Vector3 normal = bestEdgeAxis.dot(centers) < decimal(0.0) ? -bestEdgeAxis : bestEdgeAxis;
+
+        // Compute the edge of each box that is the furthest along the normal toward
+        // the other box. The index of each edge (used as contact feature) is made of
+        // its axis and of the sides of the box along the two other axes.
+        Vector3 edge1Center = transform1.getPosition();
+        Vector3 edge2Center = transform2.getPosition();
+        uint edge1Index = 4 * bestEdge1Axis;
+        uint edge2Index = 4 * bestEdge2Axis;
+        uint edge1Bit = 1, edge2Bit = 1;
+        for (int k=0; k<3; k++) {
+            if (k != bestEdge1Axis) {
+                const bool isPositiveSide = axes1[k].dot(normal) > decimal(0.0);
+                edge1Center += (isPositiveSide ? extent1[k] : -extent1[k]) * axes1[k];
+                if (isPositiveSide) edge1Index |= edge1Bit;
+                edge1Bit <<= 1;
+            }
+            if (k != bestEdge2Axis) {
+                const bool isPositiveSide = axes2[k].dot(normal) < decimal(0.0);
+                edge2Center += (isPositiveSide ? extent2[k] : -extent2[k]) * axes2[k];
+                if (isPositiveSide) edge2Index |= edge2Bit;
+                edge2Bit <<= 1;
+            }
+        }
+
+        const Vector3 edge1HalfVector = extent1[bestEdge1Axis] * axes1[bestEdge1Axis];
+        const Vector3 edge2HalfVector = extent2[bestEdge2Axis] * axes2[bestEdge2Axis];
+
+        // Compute the closest points of the two edges
+        Vector3 closestPoint1, closestPoint2;
+        computeClosestPointBetweenTwoSegments(edge1Center - edge1HalfVector, edge1Center + edge1HalfVector,
+                                              edge2Center - edge2HalfVector, edge2Center + edge2HalfVector,
+                                              closestPoint1, closestPoint2);
+
+        // Create the contact info object
+        ContactPointInfo contactInfo(shape1Info.proxyShape, shape2Info.proxyShape, shape1Info.collisionShape,
+                                     shape2Info.collisionShape, normal, -maxEdgeSeparation,
+                                     orientation1.getTranspose() * (closestPoint1 - transform1.getPosition()),
+                                     orientation2.getTranspose() * (closestPoint2 - transform2.getPosition()));
+        contactInfo.featureId = computeContactFeatureId(CONTACT_FEATURE_EDGE, edge1Index,
+                                                        CONTACT_FEATURE_EDGE, edge2Index);
+        narrowPhaseCallback->notifyContact(shape1Info.overlappingPair, contactInfo);
+
+        return;
+    }
+
+    // Select the reference box (the box that owns the face of minimum penetration)
+    // and the incident box
+    const Transform& referenceTransform = isFace2Axis ? transform2 : transform1;
+    const Transform& incidentTransform = isFace2Axis ? transform1 : transform2;
+    const Vector3* referenceAxes = isFace2Axis ? axes2 : axes1;
+    const Vector3* incidentAxes = isFace2Axis ? axes1 : axes2;
+    const Vector3& referenceExtent = isFace2Axis ? extent2 : extent1;
+    const Vector3& incidentExtent = isFace2Axis ? extent1 : extent2;
+    const int referenceAxis = isFace2Axis ? bestFace2Axis : bestFace1Axis;
+
+    // Compute the normal of the reference face (pointing toward the incident box)
+    const Vector3 referenceToIncident = incidentTransform.getPosition() - referenceTransform.getPosition();
+    Vector3 referenceNormal = referenceAxes[referenceAxis];
+    if (referenceNormal.dot(referenceToIncident) < decimal(0.0)) {
+        referenceNormal = -referenceNormal;
+    }
+
+    // Find the incident face (the face of the incident box that is the most
+    // anti-parallel to the reference face)
+    int incidentAxis = 0;
+    decimal maxAbsDot = decimal(-1.0);
+    for (int k=0; k<3; k++) {
+        const decimal absDot = std::abs(incidentAxes[k].dot(referenceNormal));
+        if (absDot > maxAbsDot) {
+            maxAbsDot = absDot;
+            incidentAxis = k;
+        }
+    }
+    const decimal incidentSign = incidentAxes[incidentAxis].dot(referenceNormal) > decimal(0.0) ?
+                                 decimal(-1.0) : decimal(1.0);
+
+    // Index of the reference and incident faces (two faces per axis)
+    const uint referenceFace = 2 * referenceAxis + (referenceNormal.dot(referenceAxes[referenceAxis]) >
+                                                    decimal(0.0) ? 0 : 1);
+    const uint incidentFace = 2 * incidentAxis + (incidentSign > decimal(0.0) ? 0 : 1);
+    const Vector3 incidentFaceCenter = incidentTransform.getPosition() + incidentSign *
+                                       incidentExtent[incidentAxis] * incidentAxes[incidentAxis];
+
+    // Compute the four vertices of the incident face
+    const int incidentAxisU = (incidentAxis + 1) % 3;
+    const int incidentAxisV = (incidentAxis + 2) % 3;
+    const Vector3 incidentU = incidentExtent[incidentAxisU] * incidentAxes[incidentAxisU];
+    const Vector3 incidentV = incidentExtent[incidentAxisV] * incidentAxes[incidentAxisV];
+    Vector3 vertices[MAX_NB_CLIPPED_VERTICES];
+    Vector3 clippedVertices[MAX_NB_CLIPPED_VERTICES];
+    ClipFeature features[MAX_NB_CLIPPED_VERTICES];
+    ClipFeature clippedFeatures[MAX_NB_CLIPPED_VERTICES];
+    vertices[0] = incidentFaceCenter + incidentU + incidentV;
+    vertices[1] = incidentFaceCenter - incidentU + incidentV;
+    vertices[2] = incidentFaceCenter - incidentU - incidentV;
+    vertices[3] = incidentFaceCenter + incidentU - incidentV;
+    int nbVertices = 4;
+    initClipFeatures(features, nbVertices);
+
+    // Clip the incident face against the four side planes of the reference face
+    Vector3* inputVertices = vertices;
+    Vector3* outputVertices = clippedVertices;
+    for (int k=1; k<3 && nbVertices > 0; k++) {
+        const int sideAxis = (referenceAxis + k) % 3;
+        const Vector3& sideNormal = referenceAxes[sideAxis];
+        const decimal centerOffset = sideNormal.dot(referenceTransform.getPosition());
+
+        nbVertices = clipPolygonWithPlane(inputVertices, features, nbVertices, sideNormal,
+                                          centerOffset + referenceExtent[sideAxis], 2 * k - 2,
+                                          outputVertices, clippedFeatures);
+        nbVertices = clipPolygonWithPlane(outputVertices, clippedFeatures, nbVertices, -sideNormal,
+                                          -centerOffset + referenceExtent[sideAxis], 2 * k - 1,
+                                          inputVertices, features);
+    }
+
+    // Keep the clipped vertices that are below the reference face
+    const decimal referenceFaceOffset = referenceNormal.dot(referenceTransform.getPosition()) +
+                                        referenceExtent[referenceAxis];
+    decimal penetrationDepths[MAX_NB_CLIPPED_VERTICES];
+    int nbContacts = 0;
+    for (int i=0; i<nbVertices; i++) {
+        const decimal penetrationDepth = referenceFaceOffset - referenceNormal.dot(inputVertices[i]);
+        if (penetrationDepth > decimal(0.0)) {
+            inputVertices[nbContacts] = inputVertices[i];
+            features[nbContacts] = features[i];
+            penetrationDepths[nbContacts] = penetrationDepth;
+            nbContacts++;
+        }
+    }
+
+    // Select the contacts to report (a contact manifold cannot have more than four points)
+    int contactIndices[MAX_NB_CLIPPED_VERTICES];
+    nbContacts = reduceContacts(inputVertices, penetrationDepths, nbContacts, referenceNormal,
+                                contactIndices);
+
+    // Create a contact for each selected vertex
+    const Vector3 normal = isFace2Axis ? -referenceNormal : referenceNormal;
+    const Matrix3x3 inverseOrientation1 = orientation1.getTranspose();
+    const Matrix3x3 inverseOrientation2 = orientation2.getTranspose();
+    for (int i=0; i<nbContacts; i++) {
+
+        const int index = contactIndices[i];
+        const decimal penetrationDepth = penetrationDepths[index];
+
+        // Compute the contact point on each box
+        const Vector3 incidentPoint = inputVertices[index];
+        const Vector3 referencePoint = incidentPoint + penetrationDepth * referenceNormal;
+        const Vector3 point1 = inverseOrientation1 * ((isFace2Axis ? incidentPoint : referencePoint) -
+                                                      transform1.getPosition());
+        const Vector3 point2 = inverseOrientation2 * ((isFace2Axis ? referencePoint : incidentPoint) -
+                                                      transform2.getPosition());
+
+        // Create the contact info object
+        ContactPointInfo contactInfo(shape1Info.proxyShape, shape2Info.proxyShape, shape1Info.collisionShape,
+                                     shape2Info.collisionShape, normal, penetrationDepth,
+                                     point1, point2);
+        contactInfo.featureId = computeClipContactFeatureId(features[index], !isFace2Axis,
+                                                            referenceFace, incidentFace);
+        narrowPhaseCallback->notifyContact(shape1Info.overlappingPair, contactInfo);
+    }
+}
@@ -0,0 +1,85 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_BOX_VS_BOX_ALGORITHM_H
+#define REACTPHYSICS3D_BOX_VS_BOX_ALGORITHM_H
+
+// Libraries
+#include "body/Body.h"
+#include "constraint/ContactPoint.h"
+#include "NarrowPhaseAlgorithm.h"
+
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Class BoxVsBoxAlgorithm
+/**
+ * This class is used to compute the narrow-phase collision detection
+ * between two box collision shapes. The Separating Axis Theorem is used
+ * with the three face normals of each box and the nine cross products
+ * of their edges. If the axis of minimum penetration is a face normal,
+ * the incident face of the other box is clipped against the side planes
+ * of the reference face. At most four of the clipped vertices below the
+ * reference face are kept as contacts. This way, a full contact manifold is
+ * computed in a single frame. Otherwise, a single contact is created between the
+ * closest points of the two edges.
+ */
+class BoxVsBoxAlgorithm : public NarrowPhaseAlgorithm {
+
+    protected :
+
+        // -------------------- Constants -------------------- //
+
+        /// Maximum number of vertices of the incident face after clipping
+        static const int MAX_NB_CLIPPED_VERTICES = 8;
+
+        // -------------------- Methods -------------------- //
+
+        /// Private copy-constructor
+        BoxVsBoxAlgorithm(const BoxVsBoxAlgorithm& algorithm);
+
+        /// Private assignment operator
+        BoxVsBoxAlgorithm& operator=(const BoxVsBoxAlgorithm& algorithm);
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        BoxVsBoxAlgorithm();
+
+        /// Destructor
+        virtual ~BoxVsBoxAlgorithm();
+
+        /// Compute a contact info if the two bounding volume collide
+        virtual void testCollision(const CollisionShapeInfo& shape1Info,
+                                   const CollisionShapeInfo& shape2Info,
+                                   NarrowPhaseCallback* narrowPhaseCallback);
+};
+
+}
+
+#endif
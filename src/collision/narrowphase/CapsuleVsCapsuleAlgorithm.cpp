@@ -0,0 +1,172 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "CapsuleVsCapsuleAlgorithm.h"
+#include "collision/shapes/CapsuleShape.h"
+#include "engine/Profiler.h"
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Constructor
+CapsuleVsCapsuleAlgorithm::CapsuleVsCapsuleAlgorithm() : NarrowPhaseAlgorithm() {
+
+}
+
+// Destructor
+CapsuleVsCapsuleAlgorithm::~CapsuleVsCapsuleAlgorithm() {
+
+}
+
+// Compute a contact info if the two bounding volume collide
+/// The inner segments of the capsules are computed in world-space.
+void CapsuleVsCapsuleAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
+                                              const CollisionShapeInfo& shape2Info,
+                                              NarrowPhaseCallback* narrowPhaseCallback) {
+
+    PROFILE("CapsuleVsCapsuleAlgorithm::testCollision()");
+
+    assert(shape1Info.collisionShape->getType() == CAPSULE);
+    assert(shape2Info.collisionShape->getType() == CAPSULE);
+
+    const CapsuleShape* capsuleShape1 = static_cast<const CapsuleShape*>(shape1Info.collisionShape);
+    const CapsuleShape* capsuleShape2 = static_cast<const CapsuleShape*>(shape2Info.collisionShape);
+    const Transform& transform1 = shape1Info.shapeToWorldTransform;
+    const Transform& transform2 = shape2Info.shapeToWorldTransform;
+
+    // Compute the inner segments of the capsules in world-space
+    const decimal halfHeight1 = decimal(0.5) * capsuleShape1->getHeight();
+    const decimal halfHeight2 = decimal(0.5) * capsuleShape2->getHeight();
+    const Vector3 seg1PointA = transform1 * Vector3(0, -halfHeight1, 0);
+    const Vector3 seg1PointB = transform1 * Vector3(0, halfHeight1, 0);
+    const Vector3 seg2PointA = transform2 * Vector3(0, -halfHeight2, 0);
+    const Vector3 seg2PointB = transform2 * Vector3(0, halfHeight2, 0);
+    const Vector3 seg1 = seg1PointB - seg1PointA;
+    const Vector3 seg2 = seg2PointB - seg2PointA;
+
+    // Axis used as contact normal if the two inner segments intersect
+    Vector3 separatingAxis = seg1.cross(seg2);
+    if (separatingAxis.lengthSquare() < MACHINE_EPSILON) {
+        separatingAxis = transform1.getOrientation() * Vector3(1, 0, 0);
+    }
+    separatingAxis.normalize();
+    if (separatingAxis.dot(transform2.getPosition() - transform1.getPosition()) < decimal(0.0)) {
+        separatingAxis = -separatingAxis;
+    }
+
+    // If the two segments are parallel (squared sine of their angle smaller than the
+    // following value), we report a contact at each end of their overlapping part
+    const decimal parallelEpsilon = decimal(0.001);
+    const decimal seg1LengthSquare = seg1.lengthSquare();
+    const decimal seg2LengthSquare = seg2.lengthSquare();
+    if (seg1LengthSquare > MACHINE_EPSILON && seg2LengthSquare > MACHINE_EPSILON &&
+        seg1.cross(seg2).lengthSquare() <= parallelEpsilon * seg1LengthSquare * seg2LengthSquare) {
+
+        // Project the second segment onto the first one
+        decimal tA = (seg2PointA - seg1PointA).dot(seg1) / seg1LengthSquare;
+        decimal tB = (seg2PointB - seg1PointA).dot(seg1) / seg1LengthSquare;
+        const decimal tMin = std::max(std::min(tA, tB), decimal(0.0));
+        const decimal tMax = std::min(std::max(tA, tB), decimal(1.0));
+
+        if (tMin < tMax) {
+            const Vector3 point1Min = seg1PointA + tMin * seg1;
+            const Vector3 point1Max = seg1PointA + tMax * seg1;
+            reportContact(shape1Info, shape2Info, seg1PointA, seg1PointB, seg2PointA, seg2PointB,
+                          point1Min, computeClosestPointOnSegment(seg2PointA, seg2PointB, point1Min),
+                          separatingAxis, narrowPhaseCallback);
+            reportContact(shape1Info, shape2Info, seg1PointA, seg1PointB, seg2PointA, seg2PointB,
+                          point1Max, computeClosestPointOnSegment(seg2PointA, seg2PointB, point1Max),
+                          separatingAxis, narrowPhaseCallback);
+            return;
+        }
+    }
+
+    // Compute the closest points of the two inner segments
+    Vector3 closestPoint1, closestPoint2;
+    computeClosestPointBetweenTwoSegments(seg1PointA, seg1PointB, seg2PointA, seg2PointB,
+                                          closestPoint1, closestPoint2);
+    reportContact(shape1Info, shape2Info, seg1PointA, seg1PointB, seg2PointA, seg2PointB,
+                  closestPoint1, closestPoint2, separatingAxis, narrowPhaseCallback);
+}
+
+// Report a contact between two points of the inner segments of the capsules
+/**
+ * @param shape1Info Information about the first capsule
+ * @param shape2Info Information about the second capsule
+ * @param seg1PointA First end point of the inner segment of the first capsule (in world-space)
+ * @param seg1PointB Second end point of the inner segment of the first capsule (in world-space)
+ * @param seg2PointA First end point of the inner segment of the second capsule (in world-space)
+ * @param seg2PointB Second end point of the inner segment of the second capsule (in world-space)
+ * @param segmentPoint1 Point of the inner segment of the first capsule (in world-space)
+ * @param segmentPoint2 Point of the inner segment of the second capsule (in world-space)
+ * @param separatingAxis Contact normal used if the two points are at the same position
+ * @param narrowPhaseCallback Callback notified about the contact
+ */
+void CapsuleVsCapsuleAlgorithm::reportContact(const CollisionShapeInfo& shape1Info,
+                                              const CollisionShapeInfo& shape2Info,
+                                              const Vector3& seg1PointA, const Vector3& seg1PointB,
+                                              const Vector3& seg2PointA, const Vector3& seg2PointB,
+                                              const Vector3& segmentPoint1, const Vector3& segmentPoint2,
+                                              const Vector3& separatingAxis,
+                                              NarrowPhaseCallback* narrowPhaseCallback) const {
+
+    const decimal radius1 = static_cast<const CapsuleShape*>(shape1Info.collisionShape)->getRadius();
+    const decimal radius2 = static_cast<const CapsuleShape*>(shape2Info.collisionShape)->getRadius();
+    const decimal sumRadius = radius1 + radius2;
+
+    const Vector3 segment1ToSegment2 = segmentPoint2 - segmentPoint1;
+    const decimal distanceSquare = segment1ToSegment2.lengthSquare();
+    if (distanceSquare >= sumRadius * sumRadius) return;
+
+    // Compute the contact normal from the first capsule to the second one
+    decimal distance = std::sqrt(distanceSquare);
+    Vector3 normal;
+    if (distance > MACHINE_EPSILON) {
+        normal = segment1ToSegment2 / distance;
+    }
+    else {
+        normal = separatingAxis;
+        distance = decimal(0.0);
+    }
+
+    // Compute the contact points in local-space of the two shapes
+    const Vector3 point1 = shape1Info.shapeToWorldTransform.getInverse() * (segmentPoint1 + radius1 * normal);
+    const Vector3 point2 = shape2Info.shapeToWorldTransform.getInverse() * (segmentPoint2 - radius2 * normal);
+
+    // Create the contact info object
+    ContactPointInfo contactInfo(shape1Info.proxyShape, shape2Info.proxyShape, shape1Info.collisionShape,
+                                 shape2Info.collisionShape, normal, sumRadius - distance,
+                                 point1, point2);
+
+    // The features of the contact are the end points or the inner segments of the capsules
+    ContactFeatureType featureType1, featureType2;
+    uint featureIndex1, featureIndex2;
+    computeSegmentFeature(seg1PointA, seg1PointB, segmentPoint1, featureType1, featureIndex1);
+    computeSegmentFeature(seg2PointA, seg2PointB, segmentPoint2, featureType2, featureIndex2);
+    contactInfo.featureId = computeContactFeatureId(featureType1, featureIndex1,
+                                                    featureType2, featureIndex2);
+    narrowPhaseCallback->notifyContact(shape1Info.overlappingPair, contactInfo);
+}
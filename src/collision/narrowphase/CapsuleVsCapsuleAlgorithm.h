@@ -0,0 +1,83 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_CAPSULE_VS_CAPSULE_ALGORITHM_H
+#define REACTPHYSICS3D_CAPSULE_VS_CAPSULE_ALGORITHM_H
+
+// Libraries
+#include "body/Body.h"
+#include "constraint/ContactPoint.h"
+#include "NarrowPhaseAlgorithm.h"
+
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Class CapsuleVsCapsuleAlgorithm
+/**
+ * This class is used to compute the narrow-phase collision detection
+ * between two capsule collision shapes. The closest points of the inner
+ * segments of the capsules are computed. When the two segments are parallel,
+ * a contact is created at each end of their overlapping part so that a capsule
+ * lying on another one is stable.
+ */
+class CapsuleVsCapsuleAlgorithm : public NarrowPhaseAlgorithm {
+
+    protected :
+
+        // -------------------- Methods -------------------- //
+
+        /// Private copy-constructor
+        CapsuleVsCapsuleAlgorithm(const CapsuleVsCapsuleAlgorithm& algorithm);
+
+        /// Private assignment operator
+        CapsuleVsCapsuleAlgorithm& operator=(const CapsuleVsCapsuleAlgorithm& algorithm);
+
+        /// Report a contact between two points of the inner segments of the capsules
+        void reportContact(const CollisionShapeInfo& shape1Info, const CollisionShapeInfo& shape2Info,
+                           const Vector3& seg1PointA, const Vector3& seg1PointB,
+                           const Vector3& seg2PointA, const Vector3& seg2PointB,
+                           const Vector3& segmentPoint1, const Vector3& segmentPoint2,
+                           const Vector3& separatingAxis, NarrowPhaseCallback* narrowPhaseCallback) const;
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        CapsuleVsCapsuleAlgorithm();
+
+        /// Destructor
+        virtual ~CapsuleVsCapsuleAlgorithm();
+
+        /// Compute a contact info if the two bounding volume collide
+        virtual void testCollision(const CollisionShapeInfo& shape1Info,
+                                   const CollisionShapeInfo& shape2Info,
+                                   NarrowPhaseCallback* narrowPhaseCallback);
+};
+
+}
+
+#endif
@@ -27,6 +27,7 @@
 #include "collision/shapes/ConcaveShape.h"
 #include "collision/shapes/TriangleShape.h"
 #include "ConcaveVsConvexAlgorithm.h"
+#include "CollisionDispatch.h"
 #include "collision/CollisionDetection.h"
 #include "engine/CollisionWorld.h"
 #include <algorithm>
@@ -34,7 +35,7 @@
 using namespace reactphysics3d;
 
 // Constructor
-ConcaveVsConvexAlgorithm::ConcaveVsConvexAlgorithm() {
+ConcaveVsConvexAlgorithm::ConcaveVsConvexAlgorithm() : mCollisionDispatch(NULL) {
 
 }
 
@@ -52,6 +53,8 @@ void ConcaveVsConvexAlgorithm::testCollision(const CollisionShapeInfo& shape1Inf
     ProxyShape* concaveProxyShape;
     const ConvexShape* convexShape;
     const ConcaveShape* concaveShape;
+    void** convexCachedCollisionData;
+    void** concaveCachedCollisionData;
 
     // Collision shape 1 is convex, collision shape 2 is concave
     if (shape1Info.collisionShape->isConvex()) {
@@ -59,25 +62,44 @@ void ConcaveVsConvexAlgorithm::testCollision(const CollisionShapeInfo& shape1Inf
         convexShape = static_cast<const ConvexShape*>(shape1Info.collisionShape);
         concaveProxyShape = shape2Info.proxyShape;
         concaveShape = static_cast<const ConcaveShape*>(shape2Info.collisionShape);
+        convexCachedCollisionData = shape1Info.cachedCollisionData;
+        concaveCachedCollisionData = shape2Info.cachedCollisionData;
     }
     else {  // Collision shape 2 is convex, collision shape 1 is concave
         convexProxyShape = shape2Info.proxyShape;
         convexShape = static_cast<const ConvexShape*>(shape2Info.collisionShape);
         concaveProxyShape = shape1Info.proxyShape;
         concaveShape = static_cast<const ConcaveShape*>(shape1Info.collisionShape);
+        convexCachedCollisionData = shape2Info.cachedCollisionData;
+        concaveCachedCollisionData = shape1Info.cachedCollisionData;
     }
 
+    // Select the collision algorithm to use between the triangles and the convex shape
+    NarrowPhaseAlgorithm* triangleAlgorithm;
+    if (mCollisionDispatch != NULL) {
+        triangleAlgorithm = mCollisionDispatch->selectAlgorithm(TRIANGLE, convexShape->getType());
+    }
+    else {
+        triangleAlgorithm = mCollisionDetection->getCollisionAlgorithm(TRIANGLE, convexShape->getType());
+    }
+
+    // If there is no collision algorithm between those two kinds of shapes
+    if (triangleAlgorithm == NULL) return;
+
     // Set the parameters of the callback object
     ConvexVsTriangleCallback convexVsTriangleCallback;
-    convexVsTriangleCallback.setCollisionDetection(mCollisionDetection);
+    convexVsTriangleCallback.setTriangleAlgorithm(triangleAlgorithm);
     convexVsTriangleCallback.setConvexShape(convexShape);
     convexVsTriangleCallback.setConcaveShape(concaveShape);
     convexVsTriangleCallback.setProxyShapes(convexProxyShape, concaveProxyShape);
+    convexVsTriangleCallback.setCachedCollisionData(convexCachedCollisionData,
+                                                    concaveCachedCollisionData);
     convexVsTriangleCallback.setOverlappingPair(shape1Info.overlappingPair);
 
-    // Compute the convex shape AABB in the local-space of the convex shape
+    // Compute the convex shape AABB in the local-space of the concave shape
     AABB aabb;
-    convexShape->computeAABB(aabb, convexProxyShape->getLocalToWorldTransform());
+    convexShape->computeAABB(aabb, concaveProxyShape->getLocalToWorldTransform().getInverse() *
+                                   convexProxyShape->getLocalToWorldTransform());
 
     // If smooth mesh collision is enabled for the concave mesh
     if (concaveShape->getIsSmoothMeshCollisionEnabled()) {
@@ -110,25 +132,18 @@ void ConvexVsTriangleCallback::testTriangle(const Vector3* trianglePoints) {
     decimal margin = mConcaveShape->getTriangleMargin();
     TriangleShape triangleShape(trianglePoints[0], trianglePoints[1], trianglePoints[2], margin);
 
-    // Select the collision algorithm to use between the triangle and the convex shape
-    NarrowPhaseAlgorithm* algo = mCollisionDetection->getCollisionAlgorithm(triangleShape.getType(),
-                                                                            mConvexShape->getType());
-
-    // If there is no collision algorithm between those two kinds of shapes
-    if (algo == NULL) return;
-
     // Notify the narrow-phase algorithm about the overlapping pair we are going to test
-    algo->setCurrentOverlappingPair(mOverlappingPair);
+    mTriangleAlgorithm->setCurrentOverlappingPair(mOverlappingPair);
 
     // Create the CollisionShapeInfo objects
     CollisionShapeInfo shapeConvexInfo(mConvexProxyShape, mConvexShape, mConvexProxyShape->getLocalToWorldTransform(),
-                                       mOverlappingPair, mConvexProxyShape->getCachedCollisionData());
+                                       mOverlappingPair, mConvexCachedCollisionData);
     CollisionShapeInfo shapeConcaveInfo(mConcaveProxyShape, &triangleShape,
                                         mConcaveProxyShape->getLocalToWorldTransform(),
-                                        mOverlappingPair, mConcaveProxyShape->getCachedCollisionData());
+                                        mOverlappingPair, mConcaveCachedCollisionData);
 
     // Use the collision algorithm to test collision between the triangle and the other convex shape
-    algo->testCollision(shapeConvexInfo, shapeConcaveInfo, mNarrowPhaseCallback);
+    mTriangleAlgorithm->testCollision(shapeConvexInfo, shapeConcaveInfo, mNarrowPhaseCallback);
 }
 
 // Process the concave triangle mesh collision using the smooth mesh collision algorithm described
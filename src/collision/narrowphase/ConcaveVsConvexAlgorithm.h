@@ -35,6 +35,9 @@
 /// Namespace ReactPhysics3D
 namespace reactphysics3d {
 
+// Declarations
+class CollisionDispatch;
+
 // Class ConvexVsTriangleCallback
 /**
  * This class is used to encapsulate a callback method for
@@ -45,8 +48,8 @@ class ConvexVsTriangleCallback : public TriangleCallback {
 
     protected:
 
-        /// Pointer to the collision detection object
-        CollisionDetection* mCollisionDetection;
+        /// Narrow-phase algorithm used to test collision between a triangle and the convex shape
+        NarrowPhaseAlgorithm* mTriangleAlgorithm;
 
         /// Narrow-phase collision callback
         NarrowPhaseCallback* mNarrowPhaseCallback;
@@ -66,15 +69,21 @@ class ConvexVsTriangleCallback : public TriangleCallback {
         /// Broadphase overlapping pair
         OverlappingPair* mOverlappingPair;
 
+        /// Cached collision data of the convex shape for the overlapping pair
+        void** mConvexCachedCollisionData;
+
+        /// Cached collision data of the concave shape for the overlapping pair
+        void** mConcaveCachedCollisionData;
+
         /// Used to sort ContactPointInfos according to their penetration depth
         static bool contactsDepthCompare(const ContactPointInfo& contact1,
                                          const ContactPointInfo& contact2);
 
     public:
 
-        /// Set the collision detection pointer
-        void setCollisionDetection(CollisionDetection* collisionDetection) {
-            mCollisionDetection = collisionDetection;
+        /// Set the narrow-phase algorithm used between a triangle and the convex shape
+        void setTriangleAlgorithm(NarrowPhaseAlgorithm* triangleAlgorithm) {
+            mTriangleAlgorithm = triangleAlgorithm;
         }
 
         /// Set the narrow-phase collision callback
@@ -103,6 +112,13 @@ class ConvexVsTriangleCallback : public TriangleCallback {
             mConcaveProxyShape = concaveProxyShape;
         }
 
+        /// Set the cached collision data of the two collision shapes
+        void setCachedCollisionData(void** convexCachedCollisionData,
+                                    void** concaveCachedCollisionData) {
+            mConvexCachedCollisionData = convexCachedCollisionData;
+            mConcaveCachedCollisionData = concaveCachedCollisionData;
+        }
+
         /// Test collision between a triangle and the convex mesh shape
         virtual void testTriangle(const Vector3* trianglePoints);
 };
@@ -184,7 +200,12 @@ class ConcaveVsConvexAlgorithm : public NarrowPhaseAlgorithm {
 
     protected :
 
-        // -------------------- Attributes -------------------- //        
+        // -------------------- Attributes -------------------- //
+
+        /// Collision dispatch used to select the algorithm between a triangle and
+        /// the convex shape. If it is NULL, the collision matrix of the collision
+        /// detection is used instead.
+        CollisionDispatch* mCollisionDispatch;
 
         // -------------------- Methods -------------------- //
 
@@ -217,12 +238,23 @@ class ConcaveVsConvexAlgorithm : public NarrowPhaseAlgorithm {
         /// Destructor
         virtual ~ConcaveVsConvexAlgorithm();
 
+        /// Set the collision dispatch used to select the triangle vs convex algorithm
+        void setCollisionDispatch(CollisionDispatch* collisionDispatch);
+
         /// Compute a contact info if the two bounding volume collide
         virtual void testCollision(const CollisionShapeInfo& shape1Info,
                                    const CollisionShapeInfo& shape2Info,
                                    NarrowPhaseCallback* narrowPhaseCallback);
 };
 
+// Set the collision dispatch used to select the triangle vs convex algorithm
+/// This is used by a collision dispatch to make sure that the triangles are tested with
+/// its own algorithms (and not with the ones of the collision matrix that may be used
+/// concurrently by another thread).
+inline void ConcaveVsConvexAlgorithm::setCollisionDispatch(CollisionDispatch* collisionDispatch) {
+    mCollisionDispatch = collisionDispatch;
+}
+
 // Add a triangle vertex into the set of processed triangles
 inline void ConcaveVsConvexAlgorithm::addProcessedVertex(std::unordered_multimap<int, Vector3>& processTriangleVertices, const Vector3& vertex) {
     processTriangleVertices.insert(std::make_pair(int(vertex.x * vertex.y * vertex.z), vertex));
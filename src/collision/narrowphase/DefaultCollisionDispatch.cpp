@@ -45,8 +45,19 @@ void DefaultCollisionDispatch::init(CollisionDetection* collisionDetection,
 
     // Initialize the collision algorithms
     mSphereVsSphereAlgorithm.init(collisionDetection, memoryAllocator);
+    mSphereVsBoxAlgorithm.init(collisionDetection, memoryAllocator);
+    mSphereVsCapsuleAlgorithm.init(collisionDetection, memoryAllocator);
+    mBoxVsBoxAlgorithm.init(collisionDetection, memoryAllocator);
+    mCapsuleVsCapsuleAlgorithm.init(collisionDetection, memoryAllocator);
+    mSATAlgorithm.init(collisionDetection, memoryAllocator);
     mGJKAlgorithm.init(collisionDetection, memoryAllocator);
     mConcaveVsConvexAlgorithm.init(collisionDetection, memoryAllocator);
+
+    // The triangles of concave shapes are tested with the algorithms of this dispatch
+    mConcaveVsConvexAlgorithm.setCollisionDispatch(this);
+
+    // The convex meshes without faces information are tested with the GJK algorithm
+    mSATAlgorithm.setGJKAlgorithm(&mGJKAlgorithm);
 }
 
 // Select and return the narrow-phase collision detection algorithm to
@@ -60,6 +71,29 @@ NarrowPhaseAlgorithm* DefaultCollisionDispatch::selectAlgorithm(int type1, int t
     if (shape1Type == SPHERE && shape2Type == SPHERE) {
         return &mSphereVsSphereAlgorithm;
     }
+    // Sphere vs Box algorithm
+    else if ((shape1Type == SPHERE && shape2Type == BOX) ||
+             (shape1Type == BOX && shape2Type == SPHERE)) {
+        return &mSphereVsBoxAlgorithm;
+    }
+    // Sphere vs Capsule algorithm
+    else if ((shape1Type == SPHERE && shape2Type == CAPSULE) ||
+             (shape1Type == CAPSULE && shape2Type == SPHERE)) {
+        return &mSphereVsCapsuleAlgorithm;
+    }
+    // Box vs Box algorithm
+    else if (shape1Type == BOX && shape2Type == BOX) {
+        return &mBoxVsBoxAlgorithm;
+    }
+    // Capsule vs Capsule algorithm
+    else if (shape1Type == CAPSULE && shape2Type == CAPSULE) {
+        return &mCapsuleVsCapsuleAlgorithm;
+    }
+    // Convex polyhedron vs Convex polyhedron algorithm (SAT algorithm)
+    else if ((shape1Type == BOX || shape1Type == CONVEX_MESH) &&
+             (shape2Type == BOX || shape2Type == CONVEX_MESH)) {
+        return &mSATAlgorithm;
+    }
     // Concave vs Convex algorithm
     else if ((!CollisionShape::isConvex(shape1Type) && CollisionShape::isConvex(shape2Type)) ||
              (!CollisionShape::isConvex(shape2Type) && CollisionShape::isConvex(shape1Type))) {
@@ -30,7 +30,12 @@
 #include "CollisionDispatch.h"
 #include "ConcaveVsConvexAlgorithm.h"
 #include "SphereVsSphereAlgorithm.h"
+#include "SphereVsBoxAlgorithm.h"
+#include "SphereVsCapsuleAlgorithm.h"
+#include "BoxVsBoxAlgorithm.h"
+#include "CapsuleVsCapsuleAlgorithm.h"
 #include "GJK/GJKAlgorithm.h"
+#include "SAT/SATAlgorithm.h"
 
 namespace reactphysics3d {
 
@@ -47,6 +52,21 @@ class DefaultCollisionDispatch : public CollisionDispatch {
         /// Sphere vs Sphere collision algorithm
         SphereVsSphereAlgorithm mSphereVsSphereAlgorithm;
 
+        /// Sphere vs Box collision algorithm
+        SphereVsBoxAlgorithm mSphereVsBoxAlgorithm;
+
+        /// Sphere vs Capsule collision algorithm
+        SphereVsCapsuleAlgorithm mSphereVsCapsuleAlgorithm;
+
+        /// Box vs Box collision algorithm
+        BoxVsBoxAlgorithm mBoxVsBoxAlgorithm;
+
+        /// Capsule vs Capsule collision algorithm
+        CapsuleVsCapsuleAlgorithm mCapsuleVsCapsuleAlgorithm;
+
+        /// SAT algorithm for the pairs of convex polyhedra
+        SATAlgorithm mSATAlgorithm;
+
         /// Concave vs Convex collision algorithm
         ConcaveVsConvexAlgorithm mConcaveVsConvexAlgorithm;
 
@@ -68,8 +88,24 @@ class DefaultCollisionDispatch : public CollisionDispatch {
         /// Select and return the narrow-phase collision detection algorithm to
         /// use between two types of collision shapes.
         virtual NarrowPhaseAlgorithm* selectAlgorithm(int type1, int type2);
+
+        /// Return the counters of the EPA algorithm
+        const EPAStatistics& getEPAStatistics() const;
+
+        /// Reset the counters of the EPA algorithm
+        void resetEPAStatistics();
 };
 
+// Return the counters of the EPA algorithm
+inline const EPAStatistics& DefaultCollisionDispatch::getEPAStatistics() const {
+    return mGJKAlgorithm.getEPAStatistics();
+}
+
+// Reset the counters of the EPA algorithm
+inline void DefaultCollisionDispatch::resetEPAStatistics() {
+    mGJKAlgorithm.resetEPAStatistics();
+}
+
 }
 
 #endif
@@ -27,13 +27,14 @@
 #include "EPAAlgorithm.h"
 #include "engine/Profiler.h"
 #include "collision/narrowphase//GJK/GJKAlgorithm.h"
-#include "TrianglesStore.h"
 
 // We want to use the ReactPhysics3D namespace
 using namespace reactphysics3d;
 
 // Constructor
-EPAAlgorithm::EPAAlgorithm() {
+EPAAlgorithm::EPAAlgorithm()
+             : mSuppPointsA(INITIAL_NB_SUPPORT_POINTS), mSuppPointsB(INITIAL_NB_SUPPORT_POINTS),
+               mPoints(INITIAL_NB_SUPPORT_POINTS) {
 
 }
 
@@ -76,6 +77,15 @@ int EPAAlgorithm::isOriginInTetrahedron(const Vector3& p1, const Vector3& p2,
     return 0;
 }
 
+// Double the size of the arrays of support points
+void EPAAlgorithm::growSupportPointsArrays() {
+
+    const size_t newSize = std::min(2 * mPoints.size(), size_t(MAX_SUPPORT_POINTS));
+    mSuppPointsA.resize(newSize);
+    mSuppPointsB.resize(newSize);
+    mPoints.resize(newSize);
+}
+
 // Compute the penetration depth with the EPA algorithm.
 /// This method computes the penetration depth and contact points between two
 /// enlarged objects (with margin) where the original objects (without margin)
@@ -101,12 +111,15 @@ void EPAAlgorithm::computePenetrationDepthAndContactPoints(const Simplex& simple
     void** shape1CachedCollisionData = shape1Info.cachedCollisionData;
     void** shape2CachedCollisionData = shape2Info.cachedCollisionData;
 
-    Vector3 suppPointsA[MAX_SUPPORT_POINTS];  // Support points of object A in local coordinates
-    Vector3 suppPointsB[MAX_SUPPORT_POINTS];  // Support points of object B in local coordinates
-    Vector3 points[MAX_SUPPORT_POINTS];       // Current points
-    TrianglesStore triangleStore;             // Store the triangles
-    TriangleEPA* triangleHeap[MAX_FACETS];    // Heap that contains the face
-                                              // candidate of the EPA algorithm
+    mStatistics.nbRuns++;
+
+    // The support points, the triangles and the candidate heap of the polytope are
+    // stored in the memory of the previous runs of the algorithm. The pointers to the
+    // support points are updated each time the arrays of support points grow.
+    Vector3* suppPointsA = &mSuppPointsA[0];  // Support points of object A in local coordinates
+    Vector3* suppPointsB = &mSuppPointsB[0];  // Support points of object B in local coordinates
+    Vector3* points = &mPoints[0];            // Current points
+    TrianglesStore& triangleStore = mTriangleStore;
 
     // Transform a point from local space of body 2 to local
     // space of body 1 (the GJK algorithm is done in local space of body 1)
@@ -123,11 +136,9 @@ void EPAAlgorithm::computePenetrationDepthAndContactPoints(const Simplex& simple
     // Compute the tolerance
     decimal tolerance = MACHINE_EPSILON * simplex.getMaxLengthSquareOfAPoint();
 
-    // Number of triangles in the polytope
-    unsigned int nbTriangles = 0;
-
-    // Clear the storing of triangles
+    // Clear the storing of triangles and the candidate heap
     triangleStore.clear();
+    mTriangleHeap.clear();
 
     // Select an action according to the number of points in the simplex
     // computed with GJK algorithm in order to obtain an initial polytope for
@@ -137,6 +148,7 @@ void EPAAlgorithm::computePenetrationDepthAndContactPoints(const Simplex& simple
             // Only one point in the simplex (which should be the origin).
             // We have a touching contact with zero penetration depth.
             // We drop that kind of contact. Therefore, we return false
+            mStatistics.nbInvalidPolytopeExits++;
             return;
 
         case 2: {
@@ -204,6 +216,7 @@ void EPAAlgorithm::computePenetrationDepthAndContactPoints(const Simplex& simple
             }
             else {
                 // The origin is not in the initial polytope
+                mStatistics.nbInvalidPolytopeExits++;
                 return;
             }
 
@@ -234,6 +247,7 @@ void EPAAlgorithm::computePenetrationDepthAndContactPoints(const Simplex& simple
                 if (!((face0 != NULL) && (face1 != NULL) && (face2 != NULL) && (face3 != NULL)
                    && face0->getDistSquare() > 0.0 && face1->getDistSquare() > 0.0
                    && face2->getDistSquare() > 0.0 && face3->getDistSquare() > 0.0)) {
+                    mStatistics.nbInvalidPolytopeExits++;
                     return;
                 }
 
@@ -246,10 +260,10 @@ void EPAAlgorithm::computePenetrationDepthAndContactPoints(const Simplex& simple
                 link(EdgeEPA(face2, 1), EdgeEPA(face3, 1));
 
                 // Add the triangle faces in the candidate heap
-                addFaceCandidate(face0, triangleHeap, nbTriangles, DECIMAL_LARGEST);
-                addFaceCandidate(face1, triangleHeap, nbTriangles, DECIMAL_LARGEST);
-                addFaceCandidate(face2, triangleHeap, nbTriangles, DECIMAL_LARGEST);
-                addFaceCandidate(face3, triangleHeap, nbTriangles, DECIMAL_LARGEST);
+                addFaceCandidate(face0, DECIMAL_LARGEST);
+                addFaceCandidate(face1, DECIMAL_LARGEST);
+                addFaceCandidate(face2, DECIMAL_LARGEST);
+                addFaceCandidate(face3, DECIMAL_LARGEST);
 
                 break;
             }
@@ -319,6 +333,7 @@ void EPAAlgorithm::computePenetrationDepthAndContactPoints(const Simplex& simple
                 face3 = triangleStore.newTriangle(points, 1, 4, 2);
             }
             else {
+                mStatistics.nbInvalidPolytopeExits++;
                 return;
             }
 
@@ -326,6 +341,7 @@ void EPAAlgorithm::computePenetrationDepthAndContactPoints(const Simplex& simple
             if (!((face0 != NULL) && (face1 != NULL) && (face2 != NULL) && (face3 != NULL)
                && face0->getDistSquare() > 0.0 && face1->getDistSquare() > 0.0
                && face2->getDistSquare() > 0.0 && face3->getDistSquare() > 0.0)) {
+                mStatistics.nbInvalidPolytopeExits++;
                 return;
             }
 
@@ -338,10 +354,10 @@ void EPAAlgorithm::computePenetrationDepthAndContactPoints(const Simplex& simple
             link(EdgeEPA(face2, 1), EdgeEPA(face3, 1));
 
             // Add the triangle faces in the candidate heap
-            addFaceCandidate(face0, triangleHeap, nbTriangles, DECIMAL_LARGEST);
-            addFaceCandidate(face1, triangleHeap, nbTriangles, DECIMAL_LARGEST);
-            addFaceCandidate(face2, triangleHeap, nbTriangles, DECIMAL_LARGEST);
-            addFaceCandidate(face3, triangleHeap, nbTriangles, DECIMAL_LARGEST);
+            addFaceCandidate(face0, DECIMAL_LARGEST);
+            addFaceCandidate(face1, DECIMAL_LARGEST);
+            addFaceCandidate(face2, DECIMAL_LARGEST);
+            addFaceCandidate(face3, DECIMAL_LARGEST);
 
             nbVertices = 4;
 
@@ -352,28 +368,46 @@ void EPAAlgorithm::computePenetrationDepthAndContactPoints(const Simplex& simple
     // At this point, we have a polytope that contains the origin. Therefore, we
     // can run the EPA algorithm.
 
-    if (nbTriangles == 0) {
+    if (mTriangleHeap.empty()) {
+        mStatistics.nbInvalidPolytopeExits++;
         return;
     }
 
     TriangleEPA* triangle = 0;
     decimal upperBoundSquarePenDepth = DECIMAL_LARGEST;
+    uint nbIterations = 0;
+    bool isConverged = true;
 
     do {
-        triangle = triangleHeap[0];
+        triangle = mTriangleHeap.front();
 
         // Get the next candidate face (the face closest to the origin)
-        std::pop_heap(&triangleHeap[0], &triangleHeap[nbTriangles], mTriangleComparison);
-        nbTriangles--;
+        std::pop_heap(mTriangleHeap.begin(), mTriangleHeap.end(), mTriangleComparison);
+        mTriangleHeap.pop_back();
 
         // If the candidate face in the heap is not obsolete
         if (!triangle->getIsObsolete()) {
-            // If we have reached the maximum number of support points
-            if (nbVertices == MAX_SUPPORT_POINTS) {
-                assert(false);
-                break;
+
+            // If the arrays of support points are full
+            if (nbVertices == mPoints.size()) {
+
+                // If we have reached the maximum number of support points, we stop
+                // with the closest triangle found so far
+                if (nbVertices == MAX_SUPPORT_POINTS) {
+                    mStatistics.nbMaxSupportPointsExits++;
+                    isConverged = false;
+                    break;
+                }
+
+                // Grow the arrays of support points
+                growSupportPointsArrays();
+                suppPointsA = &mSuppPointsA[0];
+                suppPointsB = &mSuppPointsB[0];
+                points = &mPoints[0];
             }
 
+            nbIterations++;
+
             // Compute the support point of the Minkowski
             // difference (A-B) in the closest point direction
             suppPointsA[nbVertices] = shape1->getLocalSupportPointWithMargin(
@@ -408,6 +442,8 @@ void EPAAlgorithm::computePenetrationDepthAndContactPoints(const Simplex& simple
             // algorithm from the current triangle face.
             int i = triangleStore.getNbTriangles();
             if (!triangle->computeSilhouette(points, indexNewVertex, triangleStore)) {
+                mStatistics.nbSilhouetteExits++;
+                isConverged = false;
                 break;
             }
 
@@ -415,11 +451,19 @@ void EPAAlgorithm::computePenetrationDepthAndContactPoints(const Simplex& simple
             // to the candidates list of faces of the current polytope
             while(i != triangleStore.getNbTriangles()) {
                 TriangleEPA* newTriangle = &triangleStore[i];
-                addFaceCandidate(newTriangle, triangleHeap, nbTriangles, upperBoundSquarePenDepth);
+                addFaceCandidate(newTriangle, upperBoundSquarePenDepth);
                 i++;
             }
         }
-    } while(nbTriangles > 0 && triangleHeap[0]->getDistSquare() <= upperBoundSquarePenDepth);
+    } while(!mTriangleHeap.empty() &&
+            mTriangleHeap.front()->getDistSquare() <= upperBoundSquarePenDepth);
+
+    // Update the counters of the algorithm
+    if (isConverged) mStatistics.nbConvergedRuns++;
+    mStatistics.nbIterations += nbIterations;
+    mStatistics.maxNbIterations = std::max(mStatistics.maxNbIterations, nbIterations);
+    mStatistics.maxNbTriangles = std::max(mStatistics.maxNbTriangles,
+                                          uint(triangleStore.getNbTriangles()));
 
     // Compute the contact info
     v = transform1.getOrientation() * triangle->getClosestPoint();
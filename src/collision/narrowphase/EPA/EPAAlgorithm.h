@@ -34,19 +34,80 @@
 #include "collision/narrowphase/NarrowPhaseAlgorithm.h"
 #include "mathematics/mathematics.h"
 #include "TriangleEPA.h"
+#include "TrianglesStore.h"
 #include "memory/MemoryAllocator.h"
 #include <algorithm>
+#include <vector>
 
 /// ReactPhysics3D namespace
 namespace reactphysics3d {
 
 // ---------- Constants ---------- //
 
-/// Maximum number of support points of the polytope
-const unsigned int MAX_SUPPORT_POINTS = 100;
+/// Initial number of support points of the polytope (the arrays grow if needed)
+const unsigned int INITIAL_NB_SUPPORT_POINTS = 64;
 
-/// Maximum number of facets of the polytope
-const unsigned int MAX_FACETS = 200;
+/// Maximum number of support points of the polytope (safety limit of the
+/// number of iterations of the algorithm)
+const unsigned int MAX_SUPPORT_POINTS = 1024;
+
+// Structure EPAStatistics
+/**
+ * Counters of the EPA algorithm. The EPA algorithm is only used when the objects
+ * (without margin) of a GJK test are in contact and it is much more expensive
+ * than GJK. Those counters can be used to check how often it is run, how many
+ * iterations it needs and why it stops.
+ */
+struct EPAStatistics {
+
+    // -------------------- Attributes -------------------- //
+
+    /// Number of runs of the EPA algorithm
+    uint nbRuns;
+
+    /// Total number of iterations (number of support points added to the polytopes)
+    uint nbIterations;
+
+    /// Largest number of iterations of a single run
+    uint maxNbIterations;
+
+    /// Number of runs that have converged to the penetration depth
+    uint nbConvergedRuns;
+
+    /// Number of runs stopped because no initial polytope containing the origin was found
+    uint nbInvalidPolytopeExits;
+
+    /// Number of runs stopped because the silhouette of the polytope could not be computed
+    uint nbSilhouetteExits;
+
+    /// Number of runs stopped because the maximum number of support points was reached
+    uint nbMaxSupportPointsExits;
+
+    /// Largest number of triangles of a polytope
+    uint maxNbTriangles;
+
+    // -------------------- Methods -------------------- //
+
+    /// Constructor
+    EPAStatistics()
+        : nbRuns(0), nbIterations(0), maxNbIterations(0), nbConvergedRuns(0),
+          nbInvalidPolytopeExits(0), nbSilhouetteExits(0), nbMaxSupportPointsExits(0),
+          maxNbTriangles(0) {
+
+    }
+
+    /// Add the counters of other statistics to those ones
+    void add(const EPAStatistics& statistics) {
+        nbRuns += statistics.nbRuns;
+        nbIterations += statistics.nbIterations;
+        maxNbIterations = std::max(maxNbIterations, statistics.maxNbIterations);
+        nbConvergedRuns += statistics.nbConvergedRuns;
+        nbInvalidPolytopeExits += statistics.nbInvalidPolytopeExits;
+        nbSilhouetteExits += statistics.nbSilhouetteExits;
+        nbMaxSupportPointsExits += statistics.nbMaxSupportPointsExits;
+        maxNbTriangles = std::max(maxNbTriangles, statistics.maxNbTriangles);
+    }
+};
 
 
 // Class TriangleComparison
@@ -80,6 +141,9 @@ class TriangleComparison {
  * has been computed wit GJK algorithm. The EPA Algorithm will extend this simplex
  * polytope to find the correct penetration depth. The implementation of the EPA
  * algorithm is based on the book "Collision Detection in 3D Environments".
+ * The memory used for the polytope (support points, triangles and candidate heap)
+ * is kept between the runs of the algorithm and grows when a polytope needs more of it.
+ * Therefore, an instance of this class must not be used by several threads at a time.
  */
 class EPAAlgorithm {
 
@@ -92,7 +156,25 @@ class EPAAlgorithm {
 
         /// Triangle comparison operator
         TriangleComparison mTriangleComparison;
-        
+
+        /// Support points of object A in local coordinates
+        std::vector<Vector3> mSuppPointsA;
+
+        /// Support points of object B in local coordinates
+        std::vector<Vector3> mSuppPointsB;
+
+        /// Points of the polytope (support points of the Minkowski difference A-B)
+        std::vector<Vector3> mPoints;
+
+        /// Store of the triangles of the polytope
+        TrianglesStore mTriangleStore;
+
+        /// Heap that contains the candidate triangle faces of the polytope
+        std::vector<TriangleEPA*> mTriangleHeap;
+
+        /// Counters of the algorithm
+        EPAStatistics mStatistics;
+
         // -------------------- Methods -------------------- //
 
         /// Private copy-constructor
@@ -102,8 +184,10 @@ class EPAAlgorithm {
         EPAAlgorithm& operator=(const EPAAlgorithm& algorithm);
 
         /// Add a triangle face in the candidate triangle heap
-        void addFaceCandidate(TriangleEPA* triangle, TriangleEPA** heap, uint& nbTriangles,
-                              decimal upperBoundSquarePenDepth);
+        void addFaceCandidate(TriangleEPA* triangle, decimal upperBoundSquarePenDepth);
+
+        /// Double the size of the arrays of support points
+        void growSupportPointsArrays();
 
         /// Decide if the origin is in the tetrahedron.
         int isOriginInTetrahedron(const Vector3& p1, const Vector3& p2,
@@ -130,11 +214,17 @@ class EPAAlgorithm {
                                                      const Transform& transform2,
                                                      Vector3& v,
                                                     NarrowPhaseCallback* narrowPhaseCallback);
+
+        /// Return the counters of the algorithm
+        const EPAStatistics& getStatistics() const;
+
+        /// Reset the counters of the algorithm
+        void resetStatistics();
 };
 
 // Add a triangle face in the candidate triangle heap in the EPA algorithm
-inline void EPAAlgorithm::addFaceCandidate(TriangleEPA* triangle, TriangleEPA** heap,
-                                           uint& nbTriangles, decimal upperBoundSquarePenDepth) {
+inline void EPAAlgorithm::addFaceCandidate(TriangleEPA* triangle,
+                                           decimal upperBoundSquarePenDepth) {
     
     // If the closest point of the affine hull of triangle
     // points is internal to the triangle and if the distance
@@ -144,9 +234,8 @@ inline void EPAAlgorithm::addFaceCandidate(TriangleEPA* triangle, TriangleEPA**
         triangle->getDistSquare() <= upperBoundSquarePenDepth) {
 
         // Add the triangle face to the list of candidates
-        heap[nbTriangles] = triangle;
-        nbTriangles++;
-        std::push_heap(&heap[0], &heap[nbTriangles], mTriangleComparison);
+        mTriangleHeap.push_back(triangle);
+        std::push_heap(mTriangleHeap.begin(), mTriangleHeap.end(), mTriangleComparison);
     }
 }
 
@@ -155,6 +244,16 @@ inline void EPAAlgorithm::init(MemoryAllocator* memoryAllocator) {
     mMemoryAllocator = memoryAllocator;
 }
 
+// Return the counters of the algorithm
+inline const EPAStatistics& EPAAlgorithm::getStatistics() const {
+    return mStatistics;
+}
+
+// Reset the counters of the algorithm
+inline void EPAAlgorithm::resetStatistics() {
+    mStatistics = EPAStatistics();
+}
+
 }
 
 #endif
@@ -25,6 +25,7 @@
 
 // Libraries
 #include "TrianglesStore.h"
+#include <cstdlib>
 
 // We use the ReactPhysics3D namespace
 using namespace reactphysics3d;
@@ -37,4 +38,25 @@ TrianglesStore::TrianglesStore() : mNbTriangles(0) {
 // Destructor
 TrianglesStore::~TrianglesStore() {
 
+    // Release the blocks of triangles
+    for (uint i=0; i<mBlocks.size(); i++) {
+        free(mBlocks[i]);
+    }
+}
+
+// Allocate a new block of triangles
+/// The blocks are allocated with malloc() and not with the memory allocator of the
+/// world because the EPA algorithm can run concurrently on several threads. Return
+/// false if the maximum number of triangles has been reached.
+bool TrianglesStore::allocateBlock() {
+
+    if (getCapacity() + NB_TRIANGLES_PER_BLOCK > MAX_TRIANGLES) return false;
+
+    TriangleEPA* block = static_cast<TriangleEPA*>(malloc(NB_TRIANGLES_PER_BLOCK *
+                                                          sizeof(TriangleEPA)));
+    if (block == NULL) return false;
+
+    mBlocks.push_back(block);
+
+    return true;
 }
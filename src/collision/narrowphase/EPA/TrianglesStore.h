@@ -31,16 +31,27 @@
 
 // Libraries
 #include <cassert>
+#include <vector>
 
 /// ReactPhysics3D namespace
 namespace reactphysics3d {
 
 // Constants
-const unsigned int MAX_TRIANGLES = 200;     // Maximum number of triangles
+
+/// Number of triangles in each block of memory of the triangles store
+const unsigned int NB_TRIANGLES_PER_BLOCK = 64;
+
+/// Maximum number of triangles (safety limit of the memory used by a degenerate polytope)
+const unsigned int MAX_TRIANGLES = 16384;
 
 // Class TriangleStore
 /**
- * This class stores several triangles of the polytope in the EPA algorithm.
+ * This class stores several triangles of the polytope in the EPA algorithm. The
+ * triangles are stored in blocks of memory that are never moved, because the triangles
+ * of the polytope point to each other. The store grows by allocating new blocks when
+ * it is full and the blocks are kept when the store is cleared. Therefore, a store that
+ * is reused between the runs of the EPA algorithm does not allocate memory anymore
+ * once it is large enough.
  */
 class TrianglesStore {
 
@@ -48,8 +59,8 @@ class TrianglesStore {
 
         // -------------------- Attributes -------------------- //
 
-        /// Triangles
-        TriangleEPA mTriangles[MAX_TRIANGLES];
+        /// Blocks of memory that contain the triangles
+        std::vector<TriangleEPA*> mBlocks;
 
         /// Number of triangles
         int mNbTriangles;
@@ -61,7 +72,10 @@ class TrianglesStore {
 
         /// Private assignment operator
         TrianglesStore& operator=(const TrianglesStore& triangleStore);
-        
+
+        /// Allocate a new block of triangles
+        bool allocateBlock();
+
     public:
 
         // -------------------- Methods -------------------- //
@@ -81,6 +95,9 @@ class TrianglesStore {
         /// Set the number of triangles
         void setNbTriangles(int backup);
 
+        /// Return the number of triangles that can be stored without allocating memory
+        uint getCapacity() const;
+
         /// Return the last triangle
         TriangleEPA& last();
 
@@ -106,10 +123,15 @@ inline void TrianglesStore::setNbTriangles(int backup) {
     mNbTriangles = backup;
 }
 
+// Return the number of triangles that can be stored without allocating memory
+inline uint TrianglesStore::getCapacity() const {
+    return static_cast<uint>(mBlocks.size()) * NB_TRIANGLES_PER_BLOCK;
+}
+
 // Return the last triangle
 inline TriangleEPA& TrianglesStore::last() {
     assert(mNbTriangles > 0);
-    return mTriangles[mNbTriangles - 1];
+    return (*this)[mNbTriangles - 1];
 }
 
 // Create a new triangle
@@ -117,14 +139,17 @@ inline TriangleEPA* TrianglesStore::newTriangle(const Vector3* vertices,
                                                 uint v0,uint v1, uint v2) {
     TriangleEPA* newTriangle = NULL;
 
-    // If we have not reached the maximum number of triangles
-    if (mNbTriangles != MAX_TRIANGLES) {
-        newTriangle = &mTriangles[mNbTriangles++];
-        new (newTriangle) TriangleEPA(v0, v1, v2);
-        if (!newTriangle->computeClosestPoint(vertices)) {
-            mNbTriangles--;
-            newTriangle = NULL;
-        }
+    // If the store is full, we allocate a new block of triangles (unless we
+    // have reached the maximum number of triangles)
+    if (static_cast<uint>(mNbTriangles) == getCapacity() && !allocateBlock()) {
+        return NULL;
+    }
+
+    newTriangle = &(*this)[mNbTriangles++];
+    new (newTriangle) TriangleEPA(v0, v1, v2);
+    if (!newTriangle->computeClosestPoint(vertices)) {
+        mNbTriangles--;
+        newTriangle = NULL;
     }
 
     // Return the new triangle
@@ -133,7 +158,9 @@ inline TriangleEPA* TrianglesStore::newTriangle(const Vector3* vertices,
 
 // Access operator
 inline TriangleEPA& TrianglesStore::operator[](int i) {
-    return mTriangles[i];
+    assert(i >= 0 && static_cast<uint>(i) < getCapacity());
+    const uint index = static_cast<uint>(i);
+    return mBlocks[index / NB_TRIANGLES_PER_BLOCK][index % NB_TRIANGLES_PER_BLOCK];
 }
 
 }
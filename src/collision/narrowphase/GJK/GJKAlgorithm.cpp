@@ -56,6 +56,8 @@ GJKAlgorithm::~GJKAlgorithm() {
 /// algorithm on the enlarged object to obtain a simplex polytope that contains the
 /// origin, they we give that simplex polytope to the EPA algorithm which will compute
 /// the correct penetration depth and contact points between the enlarged objects.
+/// The simplex of the previous test of the overlapping pair is used as the initial
+/// simplex so that the algorithm converges in a few iterations for resting contacts.
 void GJKAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
                                  const CollisionShapeInfo& shape2Info,
                                  NarrowPhaseCallback* narrowPhaseCallback) {
@@ -105,9 +107,24 @@ void GJKAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
 
     // Initialize the upper bound for the square distance
     decimal distSquare = DECIMAL_LARGEST;
-    
-    do {
-              
+
+    // The simplex of the previous test can only be reused if the shapes are the collision
+    // shapes of the pair (and not the triangles of a concave shape for instance)
+    const bool isSimplexCached = shape1Info.collisionShape == shape1Info.proxyShape->getCollisionShape() &&
+                                 shape2Info.collisionShape == shape2Info.proxyShape->getCollisionShape();
+    if (isSimplexCached) {
+        initSimplexFromCache(simplex, body2Tobody1, v, distSquare);
+    }
+
+    mCurrentOverlappingPair->resetNbGJKIterations();
+
+    // Iterate until the simplex contains the origin (the initial simplex may already
+    // contain it)
+    while (simplex.isEmpty() || (!simplex.isFull() && distSquare > MACHINE_EPSILON *
+                                 simplex.getMaxLengthSquareOfAPoint())) {
+
+        mCurrentOverlappingPair->incrementNbGJKIterations();
+
         // Compute the support points for original objects (without margins) A and B
         suppA = shape1->getLocalSupportPointWithoutMargin(-v, shape1CachedCollisionData);
         suppB = body2Tobody1 *
@@ -121,9 +138,10 @@ void GJKAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
         // If the enlarge objects (with margins) do not intersect
         if (vDotw > 0.0 && vDotw * vDotw > distSquare * marginSquare) {
                         
-            // Cache the current separating axis for frame coherence
+            // Cache the current separating axis and simplex for frame coherence
             mCurrentOverlappingPair->setCachedSeparatingAxis(v);
-            
+            if (isSimplexCached) cacheSimplex(simplex, body2Tobody1);
+
             // No intersection, we return
             return;
         }
@@ -131,6 +149,8 @@ void GJKAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
         // If the objects intersect only in the margins
         if (simplex.isPointInSimplex(w) || distSquare - vDotw <= distSquare * REL_ERROR_SQUARE) {
 
+            if (isSimplexCached) cacheSimplex(simplex, body2Tobody1);
+
             // Compute the closet points of both objects (without the margins)
             simplex.computeClosestPointsOfAandB(pA, pB);
 
@@ -164,6 +184,8 @@ void GJKAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
         // If the simplex is affinely dependent
         if (simplex.isAffinelyDependent()) {
 
+            if (isSimplexCached) cacheSimplex(simplex, body2Tobody1);
+
             // Compute the closet points of both objects (without the margins)
             simplex.computeClosestPointsOfAandB(pA, pB);
 
@@ -195,6 +217,8 @@ void GJKAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
         // If the computation of the closest point fail
         if (!simplex.computeClosestPoint(v)) {
 
+            if (isSimplexCached) cacheSimplex(simplex, body2Tobody1);
+
             // Compute the closet points of both objects (without the margins)
             simplex.computeClosestPointsOfAandB(pA, pB);
 
@@ -233,6 +257,8 @@ void GJKAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
             // Get the new squared distance
             distSquare = v.lengthSquare();
 
+            if (isSimplexCached) cacheSimplex(simplex, body2Tobody1);
+
             // Compute the closet points of both objects (without the margins)
             simplex.computeClosestPointsOfAandB(pA, pB);
 
@@ -259,8 +285,9 @@ void GJKAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
             // There is an intersection, therefore we return
             return;
         }
-    } while(!simplex.isFull() && distSquare > MACHINE_EPSILON *
-                                 simplex.getMaxLengthSquareOfAPoint());
+    }
+
+    if (isSimplexCached) cacheSimplex(simplex, body2Tobody1);
 
     // The objects (without margins) intersect. Therefore, we run the GJK algorithm
     // again but on the enlarged objects to compute a simplex polytope that contains
@@ -270,6 +297,69 @@ void GJKAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
                                                      transform2, narrowPhaseCallback, v);
 }
 
+// Initialize the simplex with the support points cached in the current overlapping pair
+/// The cached support points are points of the two shapes in their local-spaces. They are
+/// transformed with the current transforms of the shapes so that the simplex is still a
+/// simplex of the Minkowski difference of the shapes after they have moved. The simplex
+/// is left empty if the cached points are degenerate.
+/**
+ * @param simplex The empty simplex to initialize
+ * @param body2ToBody1 Transform from local-space of shape 2 to local-space of shape 1
+ * @param[out] v Point of the initial simplex closest to the origin
+ * @param[out] distSquare Squared distance of this point to the origin
+ */
+void GJKAlgorithm::initSimplexFromCache(Simplex& simplex, const Transform& body2ToBody1,
+                                        Vector3& v, decimal& distSquare) const {
+
+    assert(simplex.isEmpty());
+
+    Vector3 suppPointsA[4];
+    Vector3 suppPointsB[4];
+    const uint nbPoints = mCurrentOverlappingPair->getCachedSimplex(suppPointsA, suppPointsB);
+
+    Vector3 closestPoint;
+    for (uint i=0; i<nbPoints; i++) {
+
+        const Vector3 suppB = body2ToBody1 * suppPointsB[i];
+        const Vector3 w = suppPointsA[i] - suppB;
+        if (simplex.isPointInSimplex(w)) continue;
+
+        simplex.addPoint(w, suppPointsA[i], suppB);
+
+        // If the points are degenerate, we start with an empty simplex
+        if (simplex.isAffinelyDependent() || !simplex.computeClosestPoint(closestPoint)) {
+            simplex.clear();
+            return;
+        }
+    }
+
+    if (!simplex.isEmpty()) {
+        v = closestPoint;
+        distSquare = v.lengthSquare();
+    }
+}
+
+// Cache the support points of the simplex in the current overlapping pair
+/**
+ * @param simplex The current simplex of the GJK algorithm
+ * @param body2ToBody1 Transform from local-space of shape 2 to local-space of shape 1
+ */
+void GJKAlgorithm::cacheSimplex(const Simplex& simplex, const Transform& body2ToBody1) const {
+
+    Vector3 suppPointsA[4];
+    Vector3 suppPointsB[4];
+    Vector3 points[4];
+    const uint nbPoints = simplex.getSimplex(suppPointsA, suppPointsB, points);
+
+    // Store the support points of the second shape in its local-space
+    const Transform body1ToBody2 = body2ToBody1.getInverse();
+    for (uint i=0; i<nbPoints; i++) {
+        suppPointsB[i] = body1ToBody2 * suppPointsB[i];
+    }
+
+    mCurrentOverlappingPair->setCachedSimplex(nbPoints, suppPointsA, suppPointsB);
+}
+
 /// This method runs the GJK algorithm on the two enlarged objects (with margin)
 /// to compute a simplex polytope that contains the origin. The two objects are
 /// assumed to intersect in the original objects (without margin). Therefore such
@@ -309,6 +399,9 @@ void GJKAlgorithm::computePenetrationDepthForEnlargedObjects(const CollisionShap
                               transform1.getOrientation().getMatrix();
     
     do {
+
+        mCurrentOverlappingPair->incrementNbGJKIterations();
+
         // Compute the support points for the enlarged object A and B
         suppA = shape1->getLocalSupportPointWithMargin(-v, shape1CachedCollisionData);
         suppB = body2ToBody1 * shape2->getLocalSupportPointWithMargin(rotateToBody2 * v, shape2CachedCollisionData);
@@ -526,3 +619,201 @@ bool GJKAlgorithm::raycast(const Ray& ray, ProxyShape* proxyShape, RaycastInfo&
 
     return true;
 }
+
+// Return an upper bound of the distance between the points of the shape and its body origin
+decimal ConvexShapeMotion::computeMaxRadius() const {
+
+    Vector3 minBounds;
+    Vector3 maxBounds;
+    shape->getLocalBounds(minBounds, maxBounds);
+    const Vector3 maxCorner(std::max(std::abs(minBounds.x), std::abs(maxBounds.x)),
+                            std::max(std::abs(minBounds.y), std::abs(maxBounds.y)),
+                            std::max(std::abs(minBounds.z), std::abs(maxBounds.z)));
+
+    return maxCorner.length() + localToBodyTransform.getPosition().length();
+}
+
+// Return the cosine of half the rotation angle of the body during the motion
+decimal ConvexShapeMotion::computeCosineHalfRotationAngle() const {
+    return std::min(std::abs(fromTransform.getOrientation().dot(toTransform.getOrientation())),
+                    decimal(1.0));
+}
+
+// Compute an AABB (in a given space) that contains the shape during the whole motion
+/// The AABB contains the AABBs of the shape at the beginning and at the end of the motion.
+/// It is inflated by the largest distance between a point of the shape and the segment
+/// between its initial and final positions (the sagitta of the arc of the rotation).
+void ConvexShapeMotion::computeSweptAABB(AABB& aabb, const Transform& worldToSpaceTransform) const {
+
+    AABB toAABB;
+    shape->computeAABB(aabb, worldToSpaceTransform * fromTransform * localToBodyTransform);
+    shape->computeAABB(toAABB, worldToSpaceTransform * toTransform * localToBodyTransform);
+    aabb.mergeWithAABB(toAABB);
+
+    const decimal gap = computeMaxRadius() * (decimal(1.0) - computeCosineHalfRotationAngle());
+    aabb.inflate(gap, gap, gap);
+}
+
+// Compute the distance between two convex shapes (with their margins)
+/// The GJK algorithm computes the closest points of the two shapes without margin.
+/// The distance is negative if the shapes only overlap in their margins. The method
+/// returns false if the shapes without margin overlap (the distance is not computed).
+/**
+ * @param shape1 First convex shape
+ * @param transform1 Local-to-world transform of the first shape
+ * @param cachedCollisionData1 Cached collision data of the first shape
+ * @param shape2 Second convex shape
+ * @param transform2 Local-to-world transform of the second shape
+ * @param cachedCollisionData2 Cached collision data of the second shape
+ * @param[out] distance Distance between the two shapes with their margins
+ * @param[out] normal Unit direction (in world-space) from the first to the second shape
+ * @param[out] point2 Closest point (in world-space) of the second shape with its margin
+ * @return True if the shapes without margin are separated
+ */
+bool GJKAlgorithm::computeDistance(const ConvexShape* shape1, const Transform& transform1,
+                                   void** cachedCollisionData1, const ConvexShape* shape2,
+                                   const Transform& transform2, void** cachedCollisionData2,
+                                   decimal& distance, Vector3& normal, Vector3& point2) const {
+
+    // Transform a point from local space of body 2 to local
+    // space of body 1 (the GJK algorithm is done in local space of body 1)
+    const Transform body2Tobody1 = transform1.getInverse() * transform2;
+
+    // Matrix that transform a direction from local
+    // space of body 1 into local space of body 2
+    const Matrix3x3 rotateToBody2 = transform2.getOrientation().getMatrix().getTranspose() *
+                                    transform1.getOrientation().getMatrix();
+
+    Simplex simplex;
+
+    // The first direction goes from the origin of the second shape to the first one
+    Vector3 v = -body2Tobody1.getPosition();
+    if (v.lengthSquare() < MACHINE_EPSILON) v.setAllValues(0, 1, 0);
+    decimal distSquare = DECIMAL_LARGEST;
+
+    for (int i=0; i<MAX_ITERATIONS_GJK_DISTANCE; i++) {
+
+        // Compute the support points for original objects (without margins) A and B
+        const Vector3 suppA = shape1->getLocalSupportPointWithoutMargin(-v, cachedCollisionData1);
+        const Vector3 suppB = body2Tobody1 *
+                shape2->getLocalSupportPointWithoutMargin(rotateToBody2 * v, cachedCollisionData2);
+
+        // Compute the support point for the Minkowski difference A-B
+        const Vector3 w = suppA - suppB;
+
+        // If the support point does not bring the simplex closer to the origin
+        if (simplex.isPointInSimplex(w) || distSquare - v.dot(w) <= distSquare * REL_ERROR_SQUARE) {
+            break;
+        }
+
+        // Add the new support point to the simplex
+        simplex.addPoint(w, suppA, suppB);
+        if (simplex.isAffinelyDependent()) break;
+
+        // Compute the point of the simplex closest to the origin
+        if (!simplex.computeClosestPoint(v)) break;
+
+        // Store and update the squared distance of the closest point
+        const decimal prevDistSquare = distSquare;
+        distSquare = v.lengthSquare();
+
+        // If the distance to the closest point doesn't improve a lot
+        if (prevDistSquare - distSquare <= MACHINE_EPSILON * prevDistSquare) {
+            simplex.backupClosestPointInSimplex(v);
+            distSquare = v.lengthSquare();
+            break;
+        }
+
+        // If the simplex contains the origin, the shapes without margin overlap
+        if (simplex.isFull() || distSquare <= MACHINE_EPSILON * simplex.getMaxLengthSquareOfAPoint()) {
+            return false;
+        }
+    }
+
+    const decimal dist = std::sqrt(distSquare);
+    if (dist < MACHINE_EPSILON) return false;
+
+    distance = dist - shape1->getMargin() - shape2->getMargin();
+    normal = transform1.getOrientation() * (-v / dist);
+
+    // Compute the closest point of the second shape (the closest points are
+    // computed on the shapes without margin in the local-space of the first shape)
+    Vector3 pA;
+    Vector3 pB;
+    simplex.computeClosestPointsOfAandB(pA, pB);
+    point2 = transform1 * pB - shape2->getMargin() * normal;
+
+    return true;
+}
+
+// Compute the time of impact of a moving convex shape with a static convex shape
+/// This method implements the conservative advancement algorithm described by Brian
+/// Mirtich in "Impulse-based Dynamic Simulation of Rigid Body Systems". At each
+/// iteration, the moving shape is advanced by the largest time during which it cannot
+/// travel more than its distance to the static shape, using an upper bound of the
+/// speed of its points along the direction between the closest points. Therefore, the
+/// shape never passes the time of impact, even with a fast rotation.
+/**
+ * @param motion Motion of the moving shape during the time interval [0, 1]
+ * @param shape2 Static convex shape
+ * @param transform2 Local-to-world transform of the static shape
+ * @param cachedCollisionData2 Cached collision data of the static shape
+ * @param targetDistance Distance between the shapes (with their margins) at the impact
+ * @param[out] timeOfImpact Time in [0, 1] when the distance reaches the target distance
+ * @param[out] normal Unit direction (in world-space) from the moving to the static shape
+ *                    at the time of impact (zero if the shapes overlap at time zero)
+ * @param[out] point Closest point (in world-space) of the static shape at the time of
+ *                   impact (origin of the moving shape if the shapes overlap at time zero)
+ * @return True if the moving shape reaches the target distance during the motion
+ */
+bool GJKAlgorithm::computeTimeOfImpact(const ConvexShapeMotion& motion, const ConvexShape* shape2,
+                                       const Transform& transform2, void** cachedCollisionData2,
+                                       decimal targetDistance, decimal& timeOfImpact,
+                                       Vector3& normal, Vector3& point) const {
+
+    PROFILE("GJKAlgorithm::computeTimeOfImpact()");
+
+    // Compute the translation of the body and an upper bound of the distance traveled
+    // by the points of the shape because of the rotation of the body
+    const Vector3 translation = motion.toTransform.getPosition() - motion.fromTransform.getPosition();
+    const decimal angularMotionBound = decimal(2.0) * std::acos(motion.computeCosineHalfRotationAngle()) *
+                                       motion.computeMaxRadius();
+
+    normal.setToZero();
+    point = (motion.fromTransform * motion.localToBodyTransform).getPosition();
+    decimal time = decimal(0.0);
+
+    for (int i=0; i<MAX_ITERATIONS_CONSERVATIVE_ADVANCEMENT; i++) {
+
+        const Transform transform1 = motion.getBodyTransform(time) * motion.localToBodyTransform;
+
+        // If the shapes without margin overlap, we cannot advance anymore
+        decimal distance;
+        if (!computeDistance(motion.shape, transform1, motion.cachedCollisionData, shape2,
+                             transform2, cachedCollisionData2, distance, normal, point)) {
+            timeOfImpact = time;
+            return true;
+        }
+
+        // If the target distance has been reached
+        const decimal gap = distance - targetDistance;
+        if (gap <= CONSERVATIVE_ADVANCEMENT_TOLERANCE) {
+            timeOfImpact = time;
+            return true;
+        }
+
+        // Upper bound of the distance traveled by the points of the moving
+        // shape toward the static shape during the whole motion
+        const decimal motionBound = translation.dot(normal) + angularMotionBound;
+
+        // If the moving shape cannot reach the target distance before the end of the motion
+        if ((decimal(1.0) - time) * motionBound <= gap) return false;
+
+        time += gap / motionBound;
+    }
+
+    // The shape has not reached the target distance but it is already
+    // very close (this time of impact is earlier than the exact one)
+    timeOfImpact = time;
+    return true;
+}
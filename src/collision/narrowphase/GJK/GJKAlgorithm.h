@@ -40,6 +40,61 @@ namespace reactphysics3d {
 const decimal REL_ERROR = decimal(1.0e-3);
 const decimal REL_ERROR_SQUARE = REL_ERROR * REL_ERROR;
 const int MAX_ITERATIONS_GJK_RAYCAST = 32;
+const int MAX_ITERATIONS_GJK_DISTANCE = 32;
+const int MAX_ITERATIONS_CONSERVATIVE_ADVANCEMENT = 32;
+const decimal CONSERVATIVE_ADVANCEMENT_TOLERANCE = decimal(0.001);
+
+// Structure ConvexShapeMotion
+/**
+ * This structure represents the motion of a convex shape during a time interval
+ * [0, 1]. The transform of the body of the shape is interpolated between two
+ * transforms (linearly for the position and spherically for the orientation) and
+ * the shape is attached to the body with a constant local transform.
+ */
+struct ConvexShapeMotion {
+
+    // -------------------- Attributes -------------------- //
+
+    /// Moving convex shape
+    const ConvexShape* shape;
+
+    /// Cached collision data of the shape
+    void** cachedCollisionData;
+
+    /// Transform of the body at the beginning of the motion
+    Transform fromTransform;
+
+    /// Transform of the body at the end of the motion
+    Transform toTransform;
+
+    /// Transform from the local-space of the shape to the local-space of the body
+    Transform localToBodyTransform;
+
+    // -------------------- Methods -------------------- //
+
+    /// Constructor
+    ConvexShapeMotion(const ConvexShape* shape, void** cachedCollisionData,
+                      const Transform& fromTransform, const Transform& toTransform,
+                      const Transform& localToBodyTransform)
+        : shape(shape), cachedCollisionData(cachedCollisionData), fromTransform(fromTransform),
+          toTransform(toTransform), localToBodyTransform(localToBodyTransform) {
+
+    }
+
+    /// Return the transform of the body at a given time of the motion
+    Transform getBodyTransform(decimal time) const {
+        return Transform::interpolateTransforms(fromTransform, toTransform, time);
+    }
+
+    /// Return an upper bound of the distance between the points of the shape and its body origin
+    decimal computeMaxRadius() const;
+
+    /// Return the cosine of half the rotation angle of the body during the motion
+    decimal computeCosineHalfRotationAngle() const;
+
+    /// Compute an AABB (in a given space) that contains the shape during the whole motion
+    void computeSweptAABB(AABB& aabb, const Transform& worldToSpaceTransform) const;
+};
 
 // Class GJKAlgorithm
 /**
@@ -74,6 +129,13 @@ class GJKAlgorithm : public NarrowPhaseAlgorithm {
         /// Private assignment operator
         GJKAlgorithm& operator=(const GJKAlgorithm& algorithm);
 
+        /// Initialize the simplex with the support points cached in the current overlapping pair
+        void initSimplexFromCache(Simplex& simplex, const Transform& body2ToBody1, Vector3& v,
+                                  decimal& distSquare) const;
+
+        /// Cache the support points of the simplex in the current overlapping pair
+        void cacheSimplex(const Simplex& simplex, const Transform& body2ToBody1) const;
+
         /// Compute the penetration depth for enlarged objects.
         void computePenetrationDepthForEnlargedObjects(const CollisionShapeInfo& shape1Info,
                                                        const Transform& transform1,
@@ -106,6 +168,24 @@ class GJKAlgorithm : public NarrowPhaseAlgorithm {
 
         /// Ray casting algorithm agains a convex collision shape using the GJK Algorithm
         bool raycast(const Ray& ray, ProxyShape* proxyShape, RaycastInfo& raycastInfo);
+
+        /// Compute the distance between two convex shapes (with their margins)
+        bool computeDistance(const ConvexShape* shape1, const Transform& transform1,
+                             void** cachedCollisionData1, const ConvexShape* shape2,
+                             const Transform& transform2, void** cachedCollisionData2,
+                             decimal& distance, Vector3& normal, Vector3& point2) const;
+
+        /// Compute the time of impact of a moving convex shape with a static convex shape
+        bool computeTimeOfImpact(const ConvexShapeMotion& motion, const ConvexShape* shape2,
+                                 const Transform& transform2, void** cachedCollisionData2,
+                                 decimal targetDistance, decimal& timeOfImpact,
+                                 Vector3& normal, Vector3& point) const;
+
+        /// Return the counters of the EPA algorithm
+        const EPAStatistics& getEPAStatistics() const;
+
+        /// Reset the counters of the EPA algorithm
+        void resetEPAStatistics();
 };
 
 // Initalize the algorithm
@@ -115,6 +195,16 @@ inline void GJKAlgorithm::init(CollisionDetection* collisionDetection,
     mAlgoEPA.init(memoryAllocator);
 }
 
+// Return the counters of the EPA algorithm
+inline const EPAStatistics& GJKAlgorithm::getEPAStatistics() const {
+    return mAlgoEPA.getStatistics();
+}
+
+// Reset the counters of the EPA algorithm
+inline void GJKAlgorithm::resetEPAStatistics() {
+    mAlgoEPA.resetStatistics();
+}
+
 }
 
 #endif
@@ -125,9 +125,9 @@ unsigned int Simplex::getSimplex(Vector3* suppPointsA, Vector3* suppPointsB,
         if (overlap(mBitsCurrentSimplex, bit)) {
 
             // Store the points
-            suppPointsA[nbVertices] = this->mSuppPointsA[nbVertices];
-            suppPointsB[nbVertices] = this->mSuppPointsB[nbVertices];
-            points[nbVertices] = this->mPoints[nbVertices];
+            suppPointsA[nbVertices] = this->mSuppPointsA[i];
+            suppPointsB[nbVertices] = this->mSuppPointsB[i];
+            points[nbVertices] = this->mPoints[i];
 
             nbVertices++;
         }
@@ -133,6 +133,9 @@ class Simplex {
         /// Return true if the simplex is empty
         bool isEmpty() const;
 
+        /// Remove all the points of the simplex
+        void clear();
+
         /// Return the points of the simplex
         unsigned int getSimplex(Vector3* mSuppPointsA, Vector3* mSuppPointsB,
                                 Vector3* mPoints) const;
@@ -179,6 +182,12 @@ inline bool Simplex::isEmpty() const {
     return (mBitsCurrentSimplex == 0x0);
 }
 
+// Remove all the points of the simplex
+inline void Simplex::clear() {
+    mBitsCurrentSimplex = 0x0;
+    mAllBits = 0x0;
+}
+
 // Return the maximum squared length of a point
 inline decimal Simplex::getMaxLengthSquareOfAPoint() const {
     return mMaxLengthSquare;
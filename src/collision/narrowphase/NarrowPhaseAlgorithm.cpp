@@ -45,3 +45,190 @@ void NarrowPhaseAlgorithm::init(CollisionDetection* collisionDetection, MemoryAl
     mCollisionDetection = collisionDetection;
     mMemoryAllocator = memoryAllocator;
 }
+
+// Select at most four contact points among a set of points of a contact face
+/// The deepest point is kept first, then the point that is the furthest from it
+/// and then the two points that maximize the area of the contact polygon on each
+/// side of the line between the two first ones. The method returns the number of
+/// selected contacts and their indices.
+int NarrowPhaseAlgorithm::reduceContacts(const Vector3* points, const decimal* penetrationDepths,
+                                         int nbPoints, const Vector3& normal, int* selectedIndices) const {
+
+    if (nbPoints <= static_cast<int>(MAX_CONTACT_POINTS_IN_MANIFOLD)) {
+        for (int i=0; i<nbPoints; i++) selectedIndices[i] = i;
+        return nbPoints;
+    }
+
+    // Find the deepest point
+    int index0 = 0;
+    for (int i=1; i<nbPoints; i++) {
+        if (penetrationDepths[i] > penetrationDepths[index0]) index0 = i;
+    }
+
+    // Find the point that is the furthest from the first one
+    int index1 = 0;
+    decimal maxDistanceSquare = decimal(-1.0);
+    for (int i=0; i<nbPoints; i++) {
+        const decimal distanceSquare = (points[i] - points[index0]).lengthSquare();
+        if (distanceSquare > maxDistanceSquare) {
+            maxDistanceSquare = distanceSquare;
+            index1 = i;
+        }
+    }
+
+    // Find the points with the largest positive and negative triangle areas with
+    // the two first points
+    int index2 = -1;
+    int index3 = -1;
+    decimal maxArea = decimal(0.0);
+    decimal minArea = decimal(0.0);
+    const Vector3 edge = points[index1] - points[index0];
+    for (int i=0; i<nbPoints; i++) {
+        const decimal area = edge.cross(points[i] - points[index0]).dot(normal);
+        if (area > maxArea) {
+            maxArea = area;
+            index2 = i;
+        }
+        else if (area < minArea) {
+            minArea = area;
+            index3 = i;
+        }
+    }
+
+    int nbSelectedPoints = 0;
+    selectedIndices[nbSelectedPoints++] = index0;
+    if (index1 != index0) selectedIndices[nbSelectedPoints++] = index1;
+    if (index2 >= 0) selectedIndices[nbSelectedPoints++] = index2;
+    if (index3 >= 0) selectedIndices[nbSelectedPoints++] = index3;
+
+    return nbSelectedPoints;
+}
+
+// Initialize the features of the vertices of an incident face before the clipping
+/// Each vertex is a vertex of the incident face inside the reference face and the
+/// edge i of the incident face goes from the vertex i to the vertex i+1.
+void NarrowPhaseAlgorithm::initClipFeatures(ClipFeature* features, int nbVertices) const {
+
+    for (int i=0; i<nbVertices; i++) {
+        features[i].incidentType = CONTACT_FEATURE_VERTEX;
+        features[i].incidentIndex = i;
+        features[i].referenceType = CONTACT_FEATURE_FACE;
+        features[i].referenceIndex = 0;
+        features[i].isEdgeOnSidePlane = false;
+        features[i].edgeIndex = (i + nbVertices - 1) % nbVertices;
+    }
+}
+
+// Clip a polygon against the plane dot(planeNormal, x) <= planeOffset
+/// This method uses the Sutherland-Hodgman clipping algorithm and returns
+/// the number of vertices of the clipped polygon. The output array must be able
+/// to store one more vertex than the input polygon. The features of the clipped
+/// vertices are also computed. A vertex created on the plane (with index planeIndex
+/// among the side planes of the reference face) is the intersection of an incident
+/// edge with a side edge of the reference face or the intersection of two side planes
+/// (a vertex of the reference face).
+int NarrowPhaseAlgorithm::clipPolygonWithPlane(const Vector3* inputVertices, const ClipFeature* inputFeatures,
+                                               int nbInputVertices, const Vector3& planeNormal,
+                                               decimal planeOffset, uint planeIndex,
+                                               Vector3* outputVertices, ClipFeature* outputFeatures) const {
+
+    int nbOutputVertices = 0;
+    if (nbInputVertices == 0) return 0;
+
+    Vector3 previousVertex = inputVertices[nbInputVertices - 1];
+    decimal previousDistance = planeNormal.dot(previousVertex) - planeOffset;
+
+    for (int i=0; i<nbInputVertices; i++) {
+
+        const Vector3& vertex = inputVertices[i];
+        const decimal distance = planeNormal.dot(vertex) - planeOffset;
+        const ClipFeature& edgeFeature = inputFeatures[i];
+
+        // If the edge crosses the plane, we add the intersection point
+        if ((previousDistance <= decimal(0.0)) != (distance <= decimal(0.0))) {
+            const decimal t = previousDistance / (previousDistance - distance);
+            outputVertices[nbOutputVertices] = previousVertex + t * (vertex - previousVertex);
+
+            ClipFeature& feature = outputFeatures[nbOutputVertices];
+            if (edgeFeature.isEdgeOnSidePlane) {
+                feature.incidentType = CONTACT_FEATURE_FACE;
+                feature.incidentIndex = 0;
+                feature.referenceType = CONTACT_FEATURE_VERTEX;
+                feature.referenceIndex = (std::min(edgeFeature.edgeIndex, planeIndex) << 8) |
+                                         std::max(edgeFeature.edgeIndex, planeIndex);
+            }
+            else {
+                feature.incidentType = CONTACT_FEATURE_EDGE;
+                feature.incidentIndex = edgeFeature.edgeIndex;
+                feature.referenceType = CONTACT_FEATURE_EDGE;
+                feature.referenceIndex = planeIndex;
+            }
+
+            // If the edge enters the plane, the previous edge of the clipped polygon is on the plane
+            feature.isEdgeOnSidePlane = previousDistance > decimal(0.0) || edgeFeature.isEdgeOnSidePlane;
+            feature.edgeIndex = previousDistance > decimal(0.0) ? planeIndex : edgeFeature.edgeIndex;
+            nbOutputVertices++;
+        }
+
+        // If the vertex is inside the plane, we keep it
+        if (distance <= decimal(0.0)) {
+            outputVertices[nbOutputVertices] = vertex;
+            outputFeatures[nbOutputVertices] = edgeFeature;
+            nbOutputVertices++;
+        }
+
+        previousVertex = vertex;
+        previousDistance = distance;
+    }
+
+    return nbOutputVertices;
+}
+
+// Return the feature id of a contact point generated by clipping an incident face
+/**
+ * @param feature Features of the clipped vertex of the incident face
+ * @param isReferenceShape1 True if the reference face belongs to the first shape
+ * @param referenceFace Index of the reference face in its shape
+ * @param incidentFace Index of the incident face in its shape
+ * @return Feature id of the contact point
+ */
+uint NarrowPhaseAlgorithm::computeClipContactFeatureId(const ClipFeature& feature, bool isReferenceShape1,
+                                                       uint referenceFace, uint incidentFace) const {
+
+    // The features are identified by their index in their face and by the index of the face
+    const uint referenceIndex = (referenceFace << 16) ^ feature.referenceIndex;
+    const uint incidentIndex = (incidentFace << 16) ^ feature.incidentIndex;
+
+    if (isReferenceShape1) {
+        return computeContactFeatureId(feature.referenceType, referenceIndex,
+                                       feature.incidentType, incidentIndex);
+    }
+
+    return computeContactFeatureId(feature.incidentType, incidentIndex,
+                                   feature.referenceType, referenceIndex);
+}
+
+// Return the feature of a segment (an end point or the segment) that contains a point
+/// The end points A and B have the indices 0 and 1 and the segment has the index 0.
+void NarrowPhaseAlgorithm::computeSegmentFeature(const Vector3& segPointA, const Vector3& segPointB,
+                                                 const Vector3& point, ContactFeatureType& type,
+                                                 uint& index) const {
+
+    const Vector3 segment = segPointB - segPointA;
+    const decimal segmentLengthSquare = segment.lengthSquare();
+    const decimal t = segmentLengthSquare > MACHINE_EPSILON ?
+                      (point - segPointA).dot(segment) / segmentLengthSquare : decimal(0.0);
+
+    if (t <= MACHINE_EPSILON) {
+        type = CONTACT_FEATURE_VERTEX;
+        index = 0;
+    }
+    else if (t >= decimal(1.0) - MACHINE_EPSILON) {
+        type = CONTACT_FEATURE_VERTEX;
+        index = 1;
+    }
+    else {
+        type = CONTACT_FEATURE_EDGE;
+        index = 0;
+    }
+}
@@ -53,6 +53,35 @@ class NarrowPhaseCallback {
 
 };
 
+// Structure ClipFeature
+/**
+ * This structure contains the features of the incident face and of the reference
+ * face that define a vertex of the incident face clipped against the side planes of
+ * the reference face. The line of the edge of the clipped polygon that ends at the
+ * vertex (an edge of the incident face or a side plane of the reference face) is
+ * also stored to compute the features of the vertices created by the next clipping.
+ */
+struct ClipFeature {
+
+    /// Type of the feature of the incident face (vertex, edge or the face itself)
+    ContactFeatureType incidentType;
+
+    /// Index of the feature in the incident face
+    uint incidentIndex;
+
+    /// Type of the feature of the reference face (vertex, side edge or the face itself)
+    ContactFeatureType referenceType;
+
+    /// Index of the feature in the reference face
+    uint referenceIndex;
+
+    /// True if the edge that ends at the vertex is on a side plane of the reference face
+    bool isEdgeOnSidePlane;
+
+    /// Index of the incident face edge or of the side plane of the edge that ends at the vertex
+    uint edgeIndex;
+};
+
 // Class NarrowPhaseAlgorithm
 /**
  * This abstract class is the base class for a  narrow-phase collision
@@ -82,6 +111,28 @@ class NarrowPhaseAlgorithm {
         /// Private assignment operator
         NarrowPhaseAlgorithm& operator=(const NarrowPhaseAlgorithm& algorithm);
 
+        /// Initialize the features of the vertices of an incident face before the clipping
+        void initClipFeatures(ClipFeature* features, int nbVertices) const;
+
+        /// Clip a polygon against the plane dot(planeNormal, x) <= planeOffset
+        int clipPolygonWithPlane(const Vector3* inputVertices, const ClipFeature* inputFeatures,
+                                 int nbInputVertices, const Vector3& planeNormal,
+                                 decimal planeOffset, uint planeIndex, Vector3* outputVertices,
+                                 ClipFeature* outputFeatures) const;
+
+        /// Return the feature id of a contact point generated by clipping an incident face
+        uint computeClipContactFeatureId(const ClipFeature& feature, bool isReferenceShape1,
+                                         uint referenceFace, uint incidentFace) const;
+
+        /// Return the feature of a segment (an end point or the segment) that contains a point
+        void computeSegmentFeature(const Vector3& segPointA, const Vector3& segPointB,
+                                   const Vector3& point, ContactFeatureType& type,
+                                   uint& index) const;
+
+        /// Select at most four contact points among a set of points of a contact face
+        int reduceContacts(const Vector3* points, const decimal* penetrationDepths, int nbPoints,
+                           const Vector3& normal, int* selectedIndices) const;
+
     public :
 
         // -------------------- Methods -------------------- //
@@ -0,0 +1,474 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "SATAlgorithm.h"
+#include "collision/narrowphase/GJK/GJKAlgorithm.h"
+#include "collision/shapes/BoxShape.h"
+#include "collision/shapes/ConvexMeshShape.h"
+#include "engine/Profiler.h"
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Faces of a box. The vertex i of the box is at the corner (x, y, z) of the box where
+// x (resp. y and z) is positive if the first (resp. second and third) bit of i is set.
+static const PolyhedronFace BOX_FACES[6] = {
+    {Vector3(1, 0, 0), 0, 4}, {Vector3(-1, 0, 0), 4, 4}, {Vector3(0, 1, 0), 8, 4},
+    {Vector3(0, -1, 0), 12, 4}, {Vector3(0, 0, 1), 16, 4}, {Vector3(0, 0, -1), 20, 4}
+};
+
+// Vertex indices of the faces of a box
+static const uint BOX_FACES_VERTEX_INDICES[24] = {
+    1, 3, 7, 5,   0, 4, 6, 2,   2, 6, 7, 3,   0, 1, 5, 4,   4, 5, 7, 6,   0, 2, 3, 1
+};
+
+// Edges of a box with their two adjacent faces
+static const PolyhedronEdge BOX_EDGES[12] = {
+    {1, 3, 0, 5}, {3, 7, 0, 2}, {7, 5, 0, 4}, {5, 1, 0, 3},
+    {0, 4, 1, 3}, {4, 6, 1, 4}, {6, 2, 1, 2}, {2, 0, 1, 5},
+    {6, 7, 2, 4}, {3, 2, 2, 5}, {5, 4, 3, 4}, {0, 1, 3, 5}
+};
+
+// Constructor
+SATAlgorithm::SATAlgorithm() : NarrowPhaseAlgorithm(), mGJKAlgorithm(NULL) {
+
+}
+
+// Destructor
+SATAlgorithm::~SATAlgorithm() {
+
+}
+
+// Compute a contact info if the two bounding volume collide
+/// The collision test is done in local-space of the first shape.
+void SATAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
+                                 const CollisionShapeInfo& shape2Info,
+                                 NarrowPhaseCallback* narrowPhaseCallback) {
+
+    PROFILE("SATAlgorithm::testCollision()");
+
+    // Compute the transforms between the local-spaces of the two shapes
+    const Transform shape2ToShape1 = shape1Info.shapeToWorldTransform.getInverse() *
+                                     shape2Info.shapeToWorldTransform;
+    const Transform shape1ToShape2 = shape2ToShape1.getInverse();
+
+    // If one of the shapes is a convex mesh without faces, we use the GJK algorithm
+    if (!initPolyhedron(shape1Info, Transform::identity(), mPolyhedron1) ||
+        !initPolyhedron(shape2Info, shape2ToShape1, mPolyhedron2)) {
+
+        assert(mGJKAlgorithm != NULL);
+        mGJKAlgorithm->setCurrentOverlappingPair(mCurrentOverlappingPair);
+        mGJKAlgorithm->testCollision(shape1Info, shape2Info, narrowPhaseCallback);
+        return;
+    }
+
+    const decimal margin = mPolyhedron1.margin + mPolyhedron2.margin;
+    OverlappingPair* pair = shape1Info.overlappingPair;
+    const bool isPairOrder = pair != NULL && pair->getShape1() == shape1Info.proxyShape;
+
+    // Test the separating axis found at the previous frame first
+    if (isPairOrder) {
+        uint featureIndex1, featureIndex2;
+        Vector3 axis;
+        switch (pair->getCachedSATFeature(featureIndex1, featureIndex2)) {
+            case SAT_FACE_SHAPE1:
+                if (featureIndex1 < mPolyhedron1.nbFaces &&
+                    computeFaceSeparation(mPolyhedron1, featureIndex1, mPolyhedron2) >= margin) return;
+                break;
+            case SAT_FACE_SHAPE2:
+                if (featureIndex2 < mPolyhedron2.nbFaces &&
+                    computeFaceSeparation(mPolyhedron2, featureIndex2, mPolyhedron1) >= margin) return;
+                break;
+            case SAT_EDGES:
+
+                // The separation along the cross product of two edges is only valid if the
+                // edges still build a face of the Minkowski difference after the rotation of
+                // the polyhedra. Otherwise, the cached edges are discarded.
+                if (featureIndex1 >= mPolyhedron1.nbEdges || featureIndex2 >= mPolyhedron2.nbEdges ||
+                    !isEdgesMinkowskiFace(featureIndex1, featureIndex2)) {
+                    pair->setCachedSATFeature(SAT_NO_FEATURE, 0, 0);
+                    break;
+                }
+                if (computeEdgesSeparation(featureIndex1, featureIndex2, axis) >= margin) return;
+                break;
+            default:
+                break;
+        }
+    }
+
+    // Test the face normals of the first polyhedron
+    decimal maxFace1Separation = DECIMAL_SMALLEST;
+    uint bestFace1 = 0;
+    for (uint f=0; f<mPolyhedron1.nbFaces; f++) {
+        const decimal separation = computeFaceSeparation(mPolyhedron1, f, mPolyhedron2) - margin;
+        if (separation >= decimal(0.0)) {
+            if (isPairOrder) pair->setCachedSATFeature(SAT_FACE_SHAPE1, f, 0);
+            return;
+        }
+        if (separation > maxFace1Separation) {
+            maxFace1Separation = separation;
+            bestFace1 = f;
+        }
+    }
+
+    // Test the face normals of the second polyhedron
+    decimal maxFace2Separation = DECIMAL_SMALLEST;
+    uint bestFace2 = 0;
+    for (uint f=0; f<mPolyhedron2.nbFaces; f++) {
+        const decimal separation = computeFaceSeparation(mPolyhedron2, f, mPolyhedron1) - margin;
+        if (separation >= decimal(0.0)) {
+            if (isPairOrder) pair->setCachedSATFeature(SAT_FACE_SHAPE2, 0, f);
+            return;
+        }
+        if (separation > maxFace2Separation) {
+            maxFace2Separation = separation;
+            bestFace2 = f;
+        }
+    }
+
+    // Test the cross products of the pairs of edges that build a face of the
+    // Minkowski difference of the two polyhedra
+    decimal maxEdgeSeparation = DECIMAL_SMALLEST;
+    uint bestEdge1 = 0;
+    uint bestEdge2 = 0;
+    Vector3 bestEdgeAxis;
+    for (uint e1=0; e1<mPolyhedron1.nbEdges; e1++) {
+        for (uint e2=0; e2<mPolyhedron2.nbEdges; e2++) {
+
+            if (!isEdgesMinkowskiFace(e1, e2)) continue;
+
+            Vector3 axis;
+            const decimal separation = computeEdgesSeparation(e1, e2, axis) - margin;
+            if (separation >= decimal(0.0)) {
+                if (isPairOrder) pair->setCachedSATFeature(SAT_EDGES, e1, e2);
+                return;
+            }
+            if (separation > maxEdgeSeparation) {
+                maxEdgeSeparation = separation;
+                bestEdge1 = e1;
+                bestEdge2 = e2;
+                bestEdgeAxis = axis;
+            }
+        }
+    }
+
+    // The two polyhedra are overlapping
+    if (isPairOrder) pair->setCachedSATFeature(SAT_NO_FEATURE, 0, 0);
+
+    // We prefer the faces of the first polyhedron, then those of the second one and then
+    // the edges so that the contact manifold of a resting polyhedron stays the same when
+    // several axes have almost the same penetration depth
+    const decimal relativeTolerance = decimal(0.95);
+    const decimal absoluteTolerance = decimal(0.005);
+    const bool isFace2Axis = maxFace2Separation > relativeTolerance * maxFace1Separation +
+                                                  absoluteTolerance;
+    const decimal maxFaceSeparation = isFace2Axis ? maxFace2Separation : maxFace1Separation;
+
+    // If the axis of minimum penetration is the cross product of two edges
+    if (maxEdgeSeparation > relativeTolerance * maxFaceSeparation + absoluteTolerance) {
+
+        const PolyhedronEdge& edge1 = mPolyhedron1.edges[bestEdge1];
+        const PolyhedronEdge& edge2 = mPolyhedron2.edges[bestEdge2];
+
+        // Compute the closest points of the two edges
+        Vector3 closestPoint1, closestPoint2;
+        computeClosestPointBetweenTwoSegments(mPolyhedron1.vertices[edge1.vertex1],
+                                              mPolyhedron1.vertices[edge1.vertex2],
+                                              mPolyhedron2.vertices[edge2.vertex1],
+                                              mPolyhedron2.vertices[edge2.vertex2],
+                                              closestPoint1, closestPoint2);
+
+        // Create the contact info object (the contact points are on the enlarged polyhedra)
+        const Vector3 normal = shape1Info.shapeToWorldTransform.getOrientation() * bestEdgeAxis;
+        ContactPointInfo contactInfo(shape1Info.proxyShape, shape2Info.proxyShape, shape1Info.collisionShape,
+                                     shape2Info.collisionShape, normal, -maxEdgeSeparation,
+                                     closestPoint1 + mPolyhedron1.margin * bestEdgeAxis,
+                                     shape1ToShape2 * (closestPoint2 - mPolyhedron2.margin * bestEdgeAxis));
+        contactInfo.featureId = computeContactFeatureId(CONTACT_FEATURE_EDGE, bestEdge1,
+                                                        CONTACT_FEATURE_EDGE, bestEdge2);
+        narrowPhaseCallback->notifyContact(shape1Info.overlappingPair, contactInfo);
+
+        return;
+    }
+
+    // Compute the contacts of the reference face
+    computeFaceContacts(shape1Info, shape2Info, !isFace2Axis, isFace2Axis ? bestFace2 : bestFace1,
+                        shape1ToShape2, narrowPhaseCallback);
+}
+
+// Initialize the features of a polyhedron in local-space of the first shape
+/**
+ * @param shapeInfo Information about the box or convex mesh shape
+ * @param shapeToSpace Transform from local-space of the shape to local-space of the first shape
+ * @param[out] polyhedron Features of the polyhedron
+ * @return False if the shape is a convex mesh without faces information
+ */
+bool SATAlgorithm::initPolyhedron(const CollisionShapeInfo& shapeInfo, const Transform& shapeToSpace,
+                                  Polyhedron& polyhedron) const {
+
+    const Matrix3x3 rotation = shapeToSpace.getOrientation().getMatrix();
+    uint nbVertices;
+
+    if (shapeInfo.collisionShape->getType() == BOX) {
+
+        const BoxShape* boxShape = static_cast<const BoxShape*>(shapeInfo.collisionShape);
+        const Vector3 extent = boxShape->getExtent();
+
+        polyhedron.faces = BOX_FACES;
+        polyhedron.nbFaces = 6;
+        polyhedron.facesVertexIndices = BOX_FACES_VERTEX_INDICES;
+        polyhedron.edges = BOX_EDGES;
+        polyhedron.nbEdges = 12;
+
+        // The extent of the box already contains the margin
+        polyhedron.margin = decimal(0.0);
+
+        nbVertices = 8;
+        polyhedron.vertices.resize(nbVertices);
+        for (uint i=0; i<nbVertices; i++) {
+            const Vector3 vertex(i & 1 ? extent.x : -extent.x, i & 2 ? extent.y : -extent.y,
+                                 i & 4 ? extent.z : -extent.z);
+            polyhedron.vertices[i] = shapeToSpace * vertex;
+        }
+    }
+    else {
+
+        assert(shapeInfo.collisionShape->getType() == CONVEX_MESH);
+        const ConvexMeshShape* meshShape = static_cast<const ConvexMeshShape*>(shapeInfo.collisionShape);
+        if (!meshShape->isFacesInformationAvailable()) return false;
+
+        polyhedron.faces = &(meshShape->getFace(0));
+        polyhedron.nbFaces = meshShape->getNbFaces();
+        polyhedron.facesVertexIndices = meshShape->getFacesVertexIndices();
+        polyhedron.edges = &(meshShape->getEdge(0));
+        polyhedron.nbEdges = meshShape->getNbEdges();
+        polyhedron.margin = meshShape->getMargin();
+
+        nbVertices = meshShape->getNbVertices();
+        polyhedron.vertices.resize(nbVertices);
+        for (uint i=0; i<nbVertices; i++) {
+            polyhedron.vertices[i] = shapeToSpace * meshShape->getVertex(i);
+        }
+    }
+
+    // Compute the face normals and the centroid
+    polyhedron.facesNormals.resize(polyhedron.nbFaces);
+    for (uint f=0; f<polyhedron.nbFaces; f++) {
+        polyhedron.facesNormals[f] = rotation * polyhedron.faces[f].normal;
+    }
+    polyhedron.centroid.setToZero();
+    for (uint i=0; i<nbVertices; i++) {
+        polyhedron.centroid += polyhedron.vertices[i];
+    }
+    polyhedron.centroid /= decimal(nbVertices);
+
+    return true;
+}
+
+// Compute the separation of two polyhedra along the normal of a face of the first one
+/// The separation is the distance between the face and the deepest vertex of the
+/// second polyhedron (without the margins). It is negative if the polyhedra overlap
+/// along this axis.
+decimal SATAlgorithm::computeFaceSeparation(const Polyhedron& polyhedron1, uint face,
+                                            const Polyhedron& polyhedron2) const {
+
+    const Vector3& normal = polyhedron1.facesNormals[face];
+    const decimal faceOffset = normal.dot(polyhedron1.getFaceVertex(face, 0));
+
+    decimal minDotProduct = DECIMAL_LARGEST;
+    for (uint i=0; i<polyhedron2.vertices.size(); i++) {
+        const decimal dotProduct = normal.dot(polyhedron2.vertices[i]);
+        if (dotProduct < minDotProduct) minDotProduct = dotProduct;
+    }
+
+    return minDotProduct - faceOffset;
+}
+
+// Compute the separation of two polyhedra along the cross product of two edges
+/**
+ * @param edge1 Index of the edge of the first polyhedron
+ * @param edge2 Index of the edge of the second polyhedron
+ * @param[out] separatingAxis Unit axis pointing from the first polyhedron to the second one
+ * @return The separation along the axis (without the margins) or DECIMAL_SMALLEST
+ *         if the two edges are parallel
+ */
+decimal SATAlgorithm::computeEdgesSeparation(uint edge1, uint edge2, Vector3& separatingAxis) const {
+
+    const Vector3& edge1Vertex = mPolyhedron1.vertices[mPolyhedron1.edges[edge1].vertex1];
+    const Vector3& edge2Vertex = mPolyhedron2.vertices[mPolyhedron2.edges[edge2].vertex1];
+    const Vector3 edge1Direction = mPolyhedron1.vertices[mPolyhedron1.edges[edge1].vertex2] - edge1Vertex;
+    const Vector3 edge2Direction = mPolyhedron2.vertices[mPolyhedron2.edges[edge2].vertex2] - edge2Vertex;
+
+    // If the two edges are parallel, the axis has already been tested with the faces
+    separatingAxis = edge1Direction.cross(edge2Direction);
+    const decimal axisLengthSquare = separatingAxis.lengthSquare();
+    if (axisLengthSquare < decimal(0.000001) * edge1Direction.lengthSquare() *
+                           edge2Direction.lengthSquare()) {
+        return DECIMAL_SMALLEST;
+    }
+    separatingAxis /= std::sqrt(axisLengthSquare);
+
+    // The axis must point away from the first polyhedron
+    if (separatingAxis.dot(edge1Vertex - mPolyhedron1.centroid) < decimal(0.0)) {
+        separatingAxis = -separatingAxis;
+    }
+
+    return separatingAxis.dot(edge2Vertex - edge1Vertex);
+}
+
+// Return true if an edge of each polyhedron build a face of the Minkowski difference
+bool SATAlgorithm::isEdgesMinkowskiFace(uint edge1, uint edge2) const {
+
+    const PolyhedronEdge& polyhedronEdge1 = mPolyhedron1.edges[edge1];
+    const PolyhedronEdge& polyhedronEdge2 = mPolyhedron2.edges[edge2];
+    return isMinkowskiFace(mPolyhedron1.facesNormals[polyhedronEdge1.face1],
+                           mPolyhedron1.facesNormals[polyhedronEdge1.face2],
+                           -mPolyhedron2.facesNormals[polyhedronEdge2.face1],
+                           -mPolyhedron2.facesNormals[polyhedronEdge2.face2]);
+}
+
+// Return true if the arcs of two edges on the Gauss map intersect
+/// The first arc goes from the normal "a" to the normal "b" of the faces adjacent to
+/// an edge of the first polyhedron. The second arc goes from "c" to "d", the negated
+/// normals of the faces adjacent to an edge of the second polyhedron. The two edges
+/// build a face of the Minkowski difference only if the two arcs intersect.
+bool SATAlgorithm::isMinkowskiFace(const Vector3& a, const Vector3& b, const Vector3& c,
+                                   const Vector3& d) const {
+
+    const Vector3 bCrossA = b.cross(a);
+    const Vector3 dCrossC = d.cross(c);
+    const decimal cba = c.dot(bCrossA);
+    const decimal dba = d.dot(bCrossA);
+    const decimal adc = a.dot(dCrossC);
+    const decimal bdc = b.dot(dCrossC);
+
+    return cba * dba < decimal(0.0) && adc * bdc < decimal(0.0) && cba * bdc > decimal(0.0);
+}
+
+// Compute the contacts between a reference face and the incident polyhedron
+/// The face of the incident polyhedron that is the most anti-parallel to the reference
+/// face is clipped against the side planes of the reference face. The clipped vertices
+/// below the reference face are the contact points.
+void SATAlgorithm::computeFaceContacts(const CollisionShapeInfo& shape1Info,
+                                       const CollisionShapeInfo& shape2Info,
+                                       bool isReferenceShape1, uint referenceFace,
+                                       const Transform& spaceToShape2,
+                                       NarrowPhaseCallback* narrowPhaseCallback) {
+
+    const Polyhedron& reference = isReferenceShape1 ? mPolyhedron1 : mPolyhedron2;
+    const Polyhedron& incident = isReferenceShape1 ? mPolyhedron2 : mPolyhedron1;
+    const Vector3& referenceNormal = reference.facesNormals[referenceFace];
+    const uint nbReferenceVertices = reference.faces[referenceFace].nbVertices;
+
+    // Find the incident face
+    uint incidentFace = 0;
+    decimal minDotProduct = DECIMAL_LARGEST;
+    for (uint f=0; f<incident.nbFaces; f++) {
+        const decimal dotProduct = incident.facesNormals[f].dot(referenceNormal);
+        if (dotProduct < minDotProduct) {
+            minDotProduct = dotProduct;
+            incidentFace = f;
+        }
+    }
+
+    // Each clipping plane can add one vertex to the clipped polygon
+    const uint nbIncidentVertices = incident.faces[incidentFace].nbVertices;
+    const uint maxNbClippedVertices = nbIncidentVertices + nbReferenceVertices;
+    mClippedVertices[0].resize(maxNbClippedVertices);
+    mClippedVertices[1].resize(maxNbClippedVertices);
+    mClippedFeatures[0].resize(maxNbClippedVertices);
+    mClippedFeatures[1].resize(maxNbClippedVertices);
+    for (uint i=0; i<nbIncidentVertices; i++) {
+        mClippedVertices[0][i] = incident.getFaceVertex(incidentFace, i);
+    }
+    int nbVertices = nbIncidentVertices;
+    initClipFeatures(&(mClippedFeatures[0][0]), nbVertices);
+
+    // Clip the incident face against the side planes of the reference face
+    int input = 0;
+    for (uint i=0; i<nbReferenceVertices && nbVertices > 0; i++) {
+
+        const Vector3& vertex = reference.getFaceVertex(referenceFace, i);
+        const Vector3& nextVertex = reference.getFaceVertex(referenceFace, (i + 1) % nbReferenceVertices);
+        Vector3 sideNormal = (nextVertex - vertex).cross(referenceNormal);
+        const decimal sideNormalLength = sideNormal.length();
+        if (sideNormalLength < MACHINE_EPSILON) continue;
+        sideNormal /= sideNormalLength;
+
+        nbVertices = clipPolygonWithPlane(&(mClippedVertices[input][0]), &(mClippedFeatures[input][0]),
+                                          nbVertices, sideNormal,
+                                          sideNormal.dot(vertex) + reference.margin, i,
+                                          &(mClippedVertices[1 - input][0]),
+                                          &(mClippedFeatures[1 - input][0]));
+        input = 1 - input;
+    }
+
+    // Keep the clipped vertices that are below the enlarged reference face
+    const decimal margin = reference.margin + incident.margin;
+    const decimal referenceFaceOffset = referenceNormal.dot(reference.getFaceVertex(referenceFace, 0));
+    std::vector<Vector3>& clippedVertices = mClippedVertices[input];
+    std::vector<ClipFeature>& clippedFeatures = mClippedFeatures[input];
+    mPenetrationDepths.resize(maxNbClippedVertices);
+    int nbContacts = 0;
+    for (int i=0; i<nbVertices; i++) {
+        const decimal penetrationDepth = referenceFaceOffset + margin - referenceNormal.dot(clippedVertices[i]);
+        if (penetrationDepth > decimal(0.0)) {
+            clippedVertices[nbContacts] = clippedVertices[i];
+            clippedFeatures[nbContacts] = clippedFeatures[i];
+            mPenetrationDepths[nbContacts] = penetrationDepth;
+            nbContacts++;
+        }
+    }
+
+    // Select the contacts to report
+    mContactIndices.resize(maxNbClippedVertices);
+    nbContacts = reduceContacts(&(clippedVertices[0]), &(mPenetrationDepths[0]), nbContacts,
+                                referenceNormal, &(mContactIndices[0]));
+
+    // Contact normal from the first shape to the second one
+    const Vector3 normal = shape1Info.shapeToWorldTransform.getOrientation() *
+                           (isReferenceShape1 ? referenceNormal : -referenceNormal);
+
+    for (int i=0; i<nbContacts; i++) {
+
+        const int index = mContactIndices[i];
+        const decimal penetrationDepth = mPenetrationDepths[index];
+
+        // Compute the contact points on the enlarged polyhedra
+        const Vector3 incidentPoint = clippedVertices[index] - incident.margin * referenceNormal;
+        const Vector3 referencePoint = incidentPoint + penetrationDepth * referenceNormal;
+        const Vector3& point1 = isReferenceShape1 ? referencePoint : incidentPoint;
+        const Vector3& point2 = isReferenceShape1 ? incidentPoint : referencePoint;
+
+        // Create the contact info object
+        ContactPointInfo contactInfo(shape1Info.proxyShape, shape2Info.proxyShape, shape1Info.collisionShape,
+                                     shape2Info.collisionShape, normal, penetrationDepth,
+                                     point1, spaceToShape2 * point2);
+        contactInfo.featureId = computeClipContactFeatureId(clippedFeatures[index], isReferenceShape1,
+                                                            referenceFace, incidentFace);
+        narrowPhaseCallback->notifyContact(shape1Info.overlappingPair, contactInfo);
+    }
+}
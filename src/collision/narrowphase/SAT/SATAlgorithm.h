@@ -0,0 +1,183 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_SAT_ALGORITHM_H
+#define REACTPHYSICS3D_SAT_ALGORITHM_H
+
+// Libraries
+#include "collision/narrowphase/NarrowPhaseAlgorithm.h"
+#include "collision/shapes/PolyhedronFeatures.h"
+#include "constraint/ContactPoint.h"
+#include <vector>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Declarations
+class GJKAlgorithm;
+
+// Class SATAlgorithm
+/**
+ * This class implements the Separating Axis Theorem (SAT) to compute the
+ * narrow-phase collision detection between two convex polyhedra (boxes and
+ * convex meshes with faces information). The face normals of both polyhedra
+ * and the cross products of the pairs of edges that build a face of the
+ * Minkowski difference are tested. If the axis of minimum penetration is a
+ * face normal, the incident face of the other polyhedron is clipped against
+ * the side planes of the reference face and up to four contacts are created.
+ * Therefore, a complete contact manifold is computed in a single frame. The
+ * features of the last separating axis are cached in the overlapping pair
+ * and tested first at the next frame. The polyhedra are enlarged with their
+ * collision margin like with the GJK algorithm. A convex mesh without faces
+ * information is tested with the GJK algorithm.
+ */
+class SATAlgorithm : public NarrowPhaseAlgorithm {
+
+    private :
+
+        // Structure Polyhedron
+        /**
+         * Features of a convex polyhedron used during a collision test. The
+         * vertices and face normals are expressed in local-space of the first
+         * shape of the pair.
+         */
+        struct Polyhedron {
+
+            /// Faces of the polyhedron
+            const PolyhedronFace* faces;
+
+            /// Number of faces of the polyhedron
+            uint nbFaces;
+
+            /// Vertex indices of all the faces of the polyhedron
+            const uint* facesVertexIndices;
+
+            /// Edges of the polyhedron
+            const PolyhedronEdge* edges;
+
+            /// Number of edges of the polyhedron
+            uint nbEdges;
+
+            /// Vertices of the polyhedron
+            std::vector<Vector3> vertices;
+
+            /// Normals of the faces of the polyhedron
+            std::vector<Vector3> facesNormals;
+
+            /// Centroid of the vertices of the polyhedron
+            Vector3 centroid;
+
+            /// Collision margin around the polyhedron
+            decimal margin;
+
+            /// Return the i-th vertex of a face
+            const Vector3& getFaceVertex(uint face, uint i) const {
+                return vertices[facesVertexIndices[faces[face].firstVertexIndex + i]];
+            }
+        };
+
+        // -------------------- Attributes -------------------- //
+
+        /// GJK algorithm used for the convex meshes without faces information
+        GJKAlgorithm* mGJKAlgorithm;
+
+        /// First polyhedron of the current collision test
+        Polyhedron mPolyhedron1;
+
+        /// Second polyhedron of the current collision test
+        Polyhedron mPolyhedron2;
+
+        /// Buffers used to clip the incident face
+        std::vector<Vector3> mClippedVertices[2];
+
+        /// Features of the clipped vertices
+        std::vector<ClipFeature> mClippedFeatures[2];
+
+        /// Penetration depths of the clipped vertices
+        std::vector<decimal> mPenetrationDepths;
+
+        /// Indices of the clipped vertices that are reported as contacts
+        std::vector<int> mContactIndices;
+
+        // -------------------- Methods -------------------- //
+
+        /// Private copy-constructor
+        SATAlgorithm(const SATAlgorithm& algorithm);
+
+        /// Private assignment operator
+        SATAlgorithm& operator=(const SATAlgorithm& algorithm);
+
+        /// Initialize the features of a polyhedron in local-space of the first shape
+        bool initPolyhedron(const CollisionShapeInfo& shapeInfo, const Transform& shapeToSpace,
+                            Polyhedron& polyhedron) const;
+
+        /// Compute the separation of two polyhedra along the normal of a face of the first one
+        decimal computeFaceSeparation(const Polyhedron& polyhedron1, uint face,
+                                      const Polyhedron& polyhedron2) const;
+
+        /// Compute the separation of two polyhedra along the cross product of two edges
+        decimal computeEdgesSeparation(uint edge1, uint edge2, Vector3& separatingAxis) const;
+
+        /// Return true if the arcs of two edges on the Gauss map intersect
+        bool isMinkowskiFace(const Vector3& a, const Vector3& b, const Vector3& c,
+                             const Vector3& d) const;
+
+        /// Return true if an edge of each polyhedron build a face of the Minkowski difference
+        bool isEdgesMinkowskiFace(uint edge1, uint edge2) const;
+
+        /// Compute the contacts between a reference face and the incident polyhedron
+        void computeFaceContacts(const CollisionShapeInfo& shape1Info,
+                                 const CollisionShapeInfo& shape2Info,
+                                 bool isReferenceShape1, uint referenceFace,
+                                 const Transform& spaceToShape2,
+                                 NarrowPhaseCallback* narrowPhaseCallback);
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        SATAlgorithm();
+
+        /// Destructor
+        virtual ~SATAlgorithm();
+
+        /// Set the GJK algorithm used for the convex meshes without faces information
+        void setGJKAlgorithm(GJKAlgorithm* gjkAlgorithm);
+
+        /// Compute a contact info if the two bounding volume collide
+        virtual void testCollision(const CollisionShapeInfo& shape1Info,
+                                   const CollisionShapeInfo& shape2Info,
+                                   NarrowPhaseCallback* narrowPhaseCallback);
+};
+
+// Set the GJK algorithm used for the convex meshes without faces information
+inline void SATAlgorithm::setGJKAlgorithm(GJKAlgorithm* gjkAlgorithm) {
+    mGJKAlgorithm = gjkAlgorithm;
+}
+
+}
+
+#endif
@@ -0,0 +1,146 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "SphereVsBoxAlgorithm.h"
+#include "collision/shapes/SphereShape.h"
+#include "collision/shapes/BoxShape.h"
+#include "engine/Profiler.h"
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Constructor
+SphereVsBoxAlgorithm::SphereVsBoxAlgorithm() : NarrowPhaseAlgorithm() {
+
+}
+
+// Destructor
+SphereVsBoxAlgorithm::~SphereVsBoxAlgorithm() {
+
+}
+
+// Compute a contact info if the two bounding volume collide
+/// The sphere can be the first or the second shape of the overlapping pair.
+void SphereVsBoxAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
+                                         const CollisionShapeInfo& shape2Info,
+                                         NarrowPhaseCallback* narrowPhaseCallback) {
+
+    PROFILE("SphereVsBoxAlgorithm::testCollision()");
+
+    const bool isSphereShape1 = shape1Info.collisionShape->getType() == SPHERE;
+    const CollisionShapeInfo& sphereInfo = isSphereShape1 ? shape1Info : shape2Info;
+    const CollisionShapeInfo& boxInfo = isSphereShape1 ? shape2Info : shape1Info;
+
+    assert(sphereInfo.collisionShape->getType() == SPHERE);
+    assert(boxInfo.collisionShape->getType() == BOX);
+
+    const SphereShape* sphereShape = static_cast<const SphereShape*>(sphereInfo.collisionShape);
+    const BoxShape* boxShape = static_cast<const BoxShape*>(boxInfo.collisionShape);
+    const decimal radius = sphereShape->getRadius();
+    const Vector3 extent = boxShape->getExtent();
+
+    // Compute the center of the sphere in local-space of the box
+    const Transform& boxTransform = boxInfo.shapeToWorldTransform;
+    const Transform& sphereTransform = sphereInfo.shapeToWorldTransform;
+    const Vector3 sphereCenter = boxTransform.getInverse() * sphereTransform.getPosition();
+
+    // Compute the point of the box closest to the center of the sphere
+    Vector3 pointOnBox(clamp(sphereCenter.x, -extent.x, extent.x),
+                       clamp(sphereCenter.y, -extent.y, extent.y),
+                       clamp(sphereCenter.z, -extent.z, extent.z));
+    Vector3 normal;             // Contact normal from the box to the sphere in local-space of the box
+    decimal penetrationDepth;
+
+    const Vector3 boxToSphere = sphereCenter - pointOnBox;
+    const decimal distanceSquare = boxToSphere.lengthSquare();
+
+    // If the center of the sphere is outside the box
+    if (distanceSquare > MACHINE_EPSILON) {
+
+        if (distanceSquare >= radius * radius) return;
+
+        const decimal distance = std::sqrt(distanceSquare);
+        normal = boxToSphere / distance;
+        penetrationDepth = radius - distance;
+    }
+    else {
+
+        // The center of the sphere is inside the box. The contact normal is the
+        // normal of the face of the box that is the closest to the center.
+        int closestAxis = 0;
+        decimal minDistanceToFace = DECIMAL_LARGEST;
+        for (int i=0; i<3; i++) {
+            const decimal distanceToFace = extent[i] - std::abs(sphereCenter[i]);
+            if (distanceToFace < minDistanceToFace) {
+                minDistanceToFace = distanceToFace;
+                closestAxis = i;
+            }
+        }
+
+        normal.setToZero();
+        normal[closestAxis] = sphereCenter[closestAxis] < decimal(0.0) ? decimal(-1.0) : decimal(1.0);
+        pointOnBox = sphereCenter;
+        pointOnBox[closestAxis] = normal[closestAxis] * extent[closestAxis];
+        penetrationDepth = radius + minDistanceToFace;
+    }
+
+    // Compute the feature of the box (vertex, edge or face region) that contains the
+    // contact point from the number of axes along which the point is on the boundary
+    uint boxFeatureIndex = 0;
+    int nbBoundaryAxes = 0;
+    for (int i=0; i<3; i++) {
+        uint region = 1;
+        if (pointOnBox[i] <= -extent[i]) region = 0;
+        else if (pointOnBox[i] >= extent[i]) region = 2;
+        if (region != 1) nbBoundaryAxes++;
+        boxFeatureIndex = 3 * boxFeatureIndex + region;
+    }
+    const ContactFeatureType boxFeatureType = nbBoundaryAxes == 3 ? CONTACT_FEATURE_VERTEX :
+                                              (nbBoundaryAxes == 2 ? CONTACT_FEATURE_EDGE :
+                                                                     CONTACT_FEATURE_FACE);
+
+    // Compute the contact point on the sphere in local-space of the sphere
+    const Vector3 worldNormal = boxTransform.getOrientation() * normal;
+    const Vector3 pointOnSphere = sphereTransform.getOrientation().getInverse() * (-radius * worldNormal);
+
+    // Create the contact info object (the normal goes from the first shape to the second one)
+    if (isSphereShape1) {
+        ContactPointInfo contactInfo(shape1Info.proxyShape, shape2Info.proxyShape, shape1Info.collisionShape,
+                                     shape2Info.collisionShape, -worldNormal, penetrationDepth,
+                                     pointOnSphere, pointOnBox);
+        contactInfo.featureId = computeContactFeatureId(CONTACT_FEATURE_FACE, 0,
+                                                        boxFeatureType, boxFeatureIndex);
+        narrowPhaseCallback->notifyContact(shape1Info.overlappingPair, contactInfo);
+    }
+    else {
+        ContactPointInfo contactInfo(shape1Info.proxyShape, shape2Info.proxyShape, shape1Info.collisionShape,
+                                     shape2Info.collisionShape, worldNormal, penetrationDepth,
+                                     pointOnBox, pointOnSphere);
+        contactInfo.featureId = computeContactFeatureId(boxFeatureType, boxFeatureIndex,
+                                                        CONTACT_FEATURE_FACE, 0);
+        narrowPhaseCallback->notifyContact(shape1Info.overlappingPair, contactInfo);
+    }
+}
@@ -0,0 +1,123 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "SphereVsCapsuleAlgorithm.h"
+#include "collision/shapes/SphereShape.h"
+#include "collision/shapes/CapsuleShape.h"
+#include "engine/Profiler.h"
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Constructor
+SphereVsCapsuleAlgorithm::SphereVsCapsuleAlgorithm() : NarrowPhaseAlgorithm() {
+
+}
+
+// Destructor
+SphereVsCapsuleAlgorithm::~SphereVsCapsuleAlgorithm() {
+
+}
+
+// Compute a contact info if the two bounding volume collide
+/// The sphere can be the first or the second shape of the overlapping pair.
+void SphereVsCapsuleAlgorithm::testCollision(const CollisionShapeInfo& shape1Info,
+                                             const CollisionShapeInfo& shape2Info,
+                                             NarrowPhaseCallback* narrowPhaseCallback) {
+
+    PROFILE("SphereVsCapsuleAlgorithm::testCollision()");
+
+    const bool isSphereShape1 = shape1Info.collisionShape->getType() == SPHERE;
+    const CollisionShapeInfo& sphereInfo = isSphereShape1 ? shape1Info : shape2Info;
+    const CollisionShapeInfo& capsuleInfo = isSphereShape1 ? shape2Info : shape1Info;
+
+    assert(sphereInfo.collisionShape->getType() == SPHERE);
+    assert(capsuleInfo.collisionShape->getType() == CAPSULE);
+
+    const SphereShape* sphereShape = static_cast<const SphereShape*>(sphereInfo.collisionShape);
+    const CapsuleShape* capsuleShape = static_cast<const CapsuleShape*>(capsuleInfo.collisionShape);
+    const decimal sphereRadius = sphereShape->getRadius();
+    const decimal capsuleRadius = capsuleShape->getRadius();
+    const decimal sumRadius = sphereRadius + capsuleRadius;
+
+    // Compute the center of the sphere in local-space of the capsule
+    const Transform& capsuleTransform = capsuleInfo.shapeToWorldTransform;
+    const Transform& sphereTransform = sphereInfo.shapeToWorldTransform;
+    const Vector3 sphereCenter = capsuleTransform.getInverse() * sphereTransform.getPosition();
+
+    // Compute the point of the inner segment of the capsule closest to the center of the sphere
+    const decimal halfHeight = decimal(0.5) * capsuleShape->getHeight();
+    const Vector3 segmentPoint = computeClosestPointOnSegment(Vector3(0, -halfHeight, 0),
+                                                              Vector3(0, halfHeight, 0), sphereCenter);
+
+    Vector3 segmentToSphere = sphereCenter - segmentPoint;
+    const decimal distanceSquare = segmentToSphere.lengthSquare();
+    if (distanceSquare >= sumRadius * sumRadius) return;
+
+    // Compute the contact normal from the capsule to the sphere in local-space of the capsule
+    decimal distance = std::sqrt(distanceSquare);
+    Vector3 normal;
+    if (distance > MACHINE_EPSILON) {
+        normal = segmentToSphere / distance;
+    }
+    else {
+
+        // The center of the sphere is on the inner segment of the capsule
+        normal.setAllValues(1, 0, 0);
+        distance = decimal(0.0);
+    }
+    const decimal penetrationDepth = sumRadius - distance;
+
+    // Compute the contact points in local-space of the two shapes
+    const Vector3 pointOnCapsule = segmentPoint + capsuleRadius * normal;
+    const Vector3 worldNormal = capsuleTransform.getOrientation() * normal;
+    const Vector3 pointOnSphere = sphereTransform.getOrientation().getInverse() *
+                                  (-sphereRadius * worldNormal);
+
+    // Compute the feature of the capsule (an end point or the inner segment) of the contact
+    ContactFeatureType capsuleFeatureType;
+    uint capsuleFeatureIndex;
+    computeSegmentFeature(Vector3(0, -halfHeight, 0), Vector3(0, halfHeight, 0), segmentPoint,
+                          capsuleFeatureType, capsuleFeatureIndex);
+
+    // Create the contact info object (the normal goes from the first shape to the second one)
+    if (isSphereShape1) {
+        ContactPointInfo contactInfo(shape1Info.proxyShape, shape2Info.proxyShape, shape1Info.collisionShape,
+                                     shape2Info.collisionShape, -worldNormal, penetrationDepth,
+                                     pointOnSphere, pointOnCapsule);
+        contactInfo.featureId = computeContactFeatureId(CONTACT_FEATURE_FACE, 0,
+                                                        capsuleFeatureType, capsuleFeatureIndex);
+        narrowPhaseCallback->notifyContact(shape1Info.overlappingPair, contactInfo);
+    }
+    else {
+        ContactPointInfo contactInfo(shape1Info.proxyShape, shape2Info.proxyShape, shape1Info.collisionShape,
+                                     shape2Info.collisionShape, worldNormal, penetrationDepth,
+                                     pointOnCapsule, pointOnSphere);
+        contactInfo.featureId = computeContactFeatureId(capsuleFeatureType, capsuleFeatureIndex,
+                                                        CONTACT_FEATURE_FACE, 0);
+        narrowPhaseCallback->notifyContact(shape1Info.overlappingPair, contactInfo);
+    }
+}
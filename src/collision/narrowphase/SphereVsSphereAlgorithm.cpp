@@ -73,6 +73,8 @@ void SphereVsSphereAlgorithm::testCollision(const CollisionShapeInfo& shape1Info
         ContactPointInfo contactInfo(shape1Info.proxyShape, shape2Info.proxyShape, shape1Info.collisionShape,
                                      shape2Info.collisionShape, vectorBetweenCenters.getUnit(), penetrationDepth,
                                      intersectionOnBody1, intersectionOnBody2);
+        contactInfo.featureId = computeContactFeatureId(CONTACT_FEATURE_FACE, 0,
+                                                        CONTACT_FEATURE_FACE, 0);
 
         // Notify about the new contact
         narrowPhaseCallback->notifyContact(shape1Info.overlappingPair, contactInfo);
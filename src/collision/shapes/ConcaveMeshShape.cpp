@@ -34,7 +34,7 @@ ConcaveMeshShape::ConcaveMeshShape(TriangleMesh* triangleMesh)
     mTriangleMesh = triangleMesh;
     mRaycastTestType = FRONT;
 
-    // Insert all the triangles into the dynamic AABB tree
+    // Insert all the triangles into the AABB tree
     initBVHTree();
 }
 
@@ -43,11 +43,9 @@ ConcaveMeshShape::~ConcaveMeshShape() {
 
 }
 
-// Insert all the triangles into the dynamic AABB tree
+// Insert all the triangles into the AABB tree and build it
 void ConcaveMeshShape::initBVHTree() {
 
-    // TODO : Try to randomly add the triangles into the tree to obtain a better tree
-
     // For each sub-part of the mesh
     for (uint subPart=0; subPart<mTriangleMesh->getNbSubparts(); subPart++) {
 
@@ -104,10 +102,13 @@ void ConcaveMeshShape::initBVHTree() {
             AABB aabb = AABB::createAABBForTriangle(trianglePoints);
             aabb.inflate(mTriangleMargin, mTriangleMargin, mTriangleMargin);
 
-            // Add the AABB with the index of the triangle into the dynamic AABB tree
-            mDynamicAABBTree.addObject(aabb, subPart, triangleIndex);
+            // Add the AABB with the index of the triangle into the AABB tree
+            mAABBTree.addObject(aabb, subPart, triangleIndex);
         }
     }
+
+    // Build the tree once all the triangles have been added
+    mAABBTree.build();
 }
 
 // Return the three vertices coordinates (in the array outTriangleVertices) of a triangle
@@ -164,11 +165,11 @@ void ConcaveMeshShape::getTriangleVerticesWithIndexPointer(int32 subPart, int32
 // Use a callback method on all triangles of the concave shape inside a given AABB
 void ConcaveMeshShape::testAllTriangles(TriangleCallback& callback, const AABB& localAABB) const {
 
-    ConvexTriangleAABBOverlapCallback overlapCallback(callback, *this, mDynamicAABBTree);
+    ConvexTriangleAABBOverlapCallback overlapCallback(callback, *this, mAABBTree);
 
-    // Ask the Dynamic AABB Tree to report all the triangles that are overlapping
+    // Ask the AABB tree to report all the triangles that are overlapping
     // with the AABB of the convex shape.
-    mDynamicAABBTree.reportAllShapesOverlappingWithAABB(localAABB, overlapCallback);
+    mAABBTree.reportAllShapesOverlappingWithAABB(localAABB, overlapCallback);
 }
 
 // Raycast method with feedback information
@@ -179,19 +180,19 @@ bool ConcaveMeshShape::raycast(const Ray& ray, RaycastInfo& raycastInfo, ProxySh
     PROFILE("ConcaveMeshShape::raycast()");
 
     // Create the callback object that will compute ray casting against triangles
-    ConcaveMeshRaycastCallback raycastCallback(mDynamicAABBTree, *this, proxyShape, raycastInfo, ray);
+    ConcaveMeshRaycastCallback raycastCallback(mAABBTree, *this, proxyShape, raycastInfo, ray);
 
-    // Ask the Dynamic AABB Tree to report all AABB nodes that are hit by the ray.
-    // The raycastCallback object will then compute ray casting against the triangles
-    // in the hit AABBs.
-    mDynamicAABBTree.raycast(ray, raycastCallback);
+    // Ask the AABB tree to report all the triangles whose AABB is hit by the ray.
+    // The raycastCallback object will then compute ray casting against those
+    // triangles.
+    mAABBTree.raycast(ray, raycastCallback);
 
     raycastCallback.raycastTriangles();
 
     return raycastCallback.getIsHit();
 }
 
-// Collect all the AABB nodes that are hit by the ray in the Dynamic AABB Tree
+// Collect all the triangles whose AABB is hit by the ray in the AABB tree
 decimal ConcaveMeshRaycastCallback::raycastBroadPhaseShape(int32 nodeId, const Ray& ray) {
 
     // Add the id of the hit AABB node into
@@ -209,7 +210,7 @@ void ConcaveMeshRaycastCallback::raycastTriangles() {
     for (it = mHitAABBNodes.begin(); it != mHitAABBNodes.end(); ++it) {
 
         // Get the node data (triangle index and mesh subpart index)
-        int32* data = mDynamicAABBTree.getNodeDataInt(*it);
+        const int32* data = mAABBTree.getNodeDataInt(*it);
 
         // Get the triangle vertices for this node from the concave mesh shape
         Vector3 trianglePoints[3];
@@ -28,7 +28,7 @@
 
 // Libraries
 #include "ConcaveShape.h"
-#include "collision/broadphase/DynamicAABBTree.h"
+#include "collision/broadphase/StaticAABBTree.h"
 #include "collision/TriangleMesh.h"
 #include "collision/shapes/TriangleShape.h"
 #include "engine/Profiler.h"
@@ -47,20 +47,20 @@ class ConvexTriangleAABBOverlapCallback : public DynamicAABBTreeOverlapCallback
         // Reference to the concave mesh shape
         const ConcaveMeshShape& mConcaveMeshShape;
 
-        // Reference to the Dynamic AABB tree
-        const DynamicAABBTree& mDynamicAABBTree;
+        // Reference to the static AABB tree
+        const StaticAABBTree& mAABBTree;
 
     public:
 
         // Constructor
         ConvexTriangleAABBOverlapCallback(TriangleCallback& triangleCallback, const ConcaveMeshShape& concaveShape,
-                                          const DynamicAABBTree& dynamicAABBTree)
-          : mTriangleTestCallback(triangleCallback), mConcaveMeshShape(concaveShape), mDynamicAABBTree(dynamicAABBTree) {
+                                          const StaticAABBTree& aabbTree)
+          : mTriangleTestCallback(triangleCallback), mConcaveMeshShape(concaveShape), mAABBTree(aabbTree) {
 
         }
 
-        // Called when a overlapping node has been found during the call to
-        // DynamicAABBTree:reportAllShapesOverlappingWithAABB()
+        // Called when a overlapping triangle has been found during the call to
+        // StaticAABBTree:reportAllShapesOverlappingWithAABB()
         virtual void notifyOverlappingNode(int nodeId);
 
 };
@@ -71,7 +71,7 @@ class ConcaveMeshRaycastCallback : public DynamicAABBTreeRaycastCallback {
     private :
 
         std::vector<int32> mHitAABBNodes;
-        const DynamicAABBTree& mDynamicAABBTree;
+        const StaticAABBTree& mAABBTree;
         const ConcaveMeshShape& mConcaveMeshShape;
         ProxyShape* mProxyShape;
         RaycastInfo& mRaycastInfo;
@@ -81,14 +81,14 @@ class ConcaveMeshRaycastCallback : public DynamicAABBTreeRaycastCallback {
     public:
 
         // Constructor
-        ConcaveMeshRaycastCallback(const DynamicAABBTree& dynamicAABBTree, const ConcaveMeshShape& concaveMeshShape,
+        ConcaveMeshRaycastCallback(const StaticAABBTree& aabbTree, const ConcaveMeshShape& concaveMeshShape,
                                    ProxyShape* proxyShape, RaycastInfo& raycastInfo, const Ray& ray)
-            : mDynamicAABBTree(dynamicAABBTree), mConcaveMeshShape(concaveMeshShape), mProxyShape(proxyShape),
+            : mAABBTree(aabbTree), mConcaveMeshShape(concaveMeshShape), mProxyShape(proxyShape),
               mRaycastInfo(raycastInfo), mRay(ray), mIsHit(false) {
 
         }
 
-        /// Collect all the AABB nodes that are hit by the ray in the Dynamic AABB Tree
+        /// Collect all the triangles whose AABB is hit by the ray in the AABB tree
         virtual decimal raycastBroadPhaseShape(int32 nodeId, const Ray& ray);
 
         /// Raycast all collision shapes that have been collected
@@ -115,8 +115,8 @@ class ConcaveMeshShape : public ConcaveShape {
         /// Triangle mesh
         TriangleMesh* mTriangleMesh;
 
-        /// Dynamic AABB tree to accelerate collision with the triangles
-        DynamicAABBTree mDynamicAABBTree;
+        /// Static AABB tree to accelerate collision with the triangles
+        StaticAABBTree mAABBTree;
 
         // -------------------- Methods -------------------- //
 
@@ -129,10 +129,7 @@ class ConcaveMeshShape : public ConcaveShape {
         /// Raycast method with feedback information
         virtual bool raycast(const Ray& ray, RaycastInfo& raycastInfo, ProxyShape* proxyShape) const;
 
-        /// Return the number of bytes used by the collision shape
-        virtual size_t getSizeInBytes() const;
-
-        /// Insert all the triangles into the dynamic AABB tree
+        /// Insert all the triangles into the AABB tree and build it
         void initBVHTree();
 
         /// Return the three vertices coordinates (in the array outTriangleVertices) of a triangle
@@ -160,6 +157,9 @@ class ConcaveMeshShape : public ConcaveShape {
         /// Use a callback method on all triangles of the concave shape inside a given AABB
         virtual void testAllTriangles(TriangleCallback& callback, const AABB& localAABB) const;
 
+        /// Return the number of bytes used by the collision shape (including its AABB tree)
+        virtual size_t getSizeInBytes() const;
+
         // ---------- Friendship ----------- //
 
         friend class ConvexTriangleAABBOverlapCallback;
@@ -168,7 +168,7 @@ class ConcaveMeshShape : public ConcaveShape {
 
 // Return the number of bytes used by the collision shape
 inline size_t ConcaveMeshShape::getSizeInBytes() const {
-    return sizeof(ConcaveMeshShape);
+    return sizeof(ConcaveMeshShape) + mAABBTree.getSizeInBytes();
 }
 
 // Return the local bounds of the shape in x, y and z directions.
@@ -180,7 +180,7 @@ inline size_t ConcaveMeshShape::getSizeInBytes() const {
 inline void ConcaveMeshShape::getLocalBounds(Vector3& min, Vector3& max) const {
 
     // Get the AABB of the whole tree
-    AABB treeAABB = mDynamicAABBTree.getRootAABB();
+    const AABB& treeAABB = mAABBTree.getRootAABB();
 
     min = treeAABB.getMin();
     max = treeAABB.getMax();
@@ -191,10 +191,10 @@ inline void ConcaveMeshShape::setLocalScaling(const Vector3& scaling) {
 
     CollisionShape::setLocalScaling(scaling);
 
-    // Reset the Dynamic AABB Tree
-    mDynamicAABBTree.reset();
+    // Reset the AABB tree
+    mAABBTree.reset();
 
-    // Rebuild Dynamic AABB Tree here
+    // Rebuild the AABB tree with the scaled triangles
     initBVHTree();
 }
 
@@ -215,12 +215,12 @@ inline void ConcaveMeshShape::computeLocalInertiaTensor(Matrix3x3& tensor, decim
                         0, 0, mass);
 }
 
-// Called when a overlapping node has been found during the call to
-// DynamicAABBTree:reportAllShapesOverlappingWithAABB()
+// Called when a overlapping triangle has been found during the call to
+// StaticAABBTree:reportAllShapesOverlappingWithAABB()
 inline void ConvexTriangleAABBOverlapCallback::notifyOverlappingNode(int nodeId) {
 
     // Get the node data (triangle index and mesh subpart index)
-    int32* data = mDynamicAABBTree.getNodeDataInt(nodeId);
+    const int32* data = mAABBTree.getNodeDataInt(nodeId);
 
     // Get the triangle vertices for this node from the concave mesh shape
     Vector3 trianglePoints[3];
@@ -25,8 +25,14 @@
 
 // Libraries
 #include <complex>
+#include <algorithm>
 #include "configuration.h"
 #include "ConvexMeshShape.h"
+#include "QuickHull.h"
+
+#ifdef REACTPHYSICS3D_SSE_ENABLED
+#include <xmmintrin.h>
+#endif
 
 using namespace reactphysics3d;
 
@@ -40,7 +46,8 @@ using namespace reactphysics3d;
  */
 ConvexMeshShape::ConvexMeshShape(const decimal* arrayVertices, uint nbVertices, int stride, decimal margin)
                 : ConvexShape(CONVEX_MESH, margin), mNbVertices(nbVertices), mMinBounds(0, 0, 0),
-                  mMaxBounds(0, 0, 0), mIsEdgesInformationUsed(false) {
+                  mMaxBounds(0, 0, 0), mIsEdgesInformationUsed(false),
+                  mIsAdjacencyUpToDate(false) {
     assert(nbVertices > 0);
     assert(stride > 0);
 
@@ -52,11 +59,76 @@ ConvexMeshShape::ConvexMeshShape(const decimal* arrayVertices, uint nbVertices,
         mVertices.push_back(Vector3(newPoint[0], newPoint[1], newPoint[2]));
         vertexPointer += stride;
     }
+    updateVerticesComponents(0);
 
     // Recalculate the bounds of the mesh
     recalculateBounds();
 }
 
+// Constructor to initialize with the convex hull of a cloud of points
+/// The convex hull of the points is computed with the Quickhull algorithm. Only the
+/// vertices of the hull are kept and the edges and faces of the hull are used for the
+/// collision detection. The hull is simplified by adding at most "maxNbVertices"
+/// vertices (the furthest points first) and by ignoring the points that are closer
+/// than the welding distance to the hull. If all the points are on a plane or on a
+/// line, all the points are used as vertices without edges or faces.
+/**
+ * @param arrayPoints Array with the points of the cloud
+ * @param nbPoints Number of points in the cloud
+ * @param stride Stride between the beginning of two elements in the points array
+ * @param maxNbVertices Maximum number of vertices of the hull (at least four)
+ * @param weldingDistance Distance (in meters) under which a point is considered to be
+ *                        on the hull and does not become a new vertex
+ * @param margin Collision margin (in meters) around the collision shape
+ */
+ConvexMeshShape::ConvexMeshShape(const decimal* arrayPoints, uint nbPoints, int stride,
+                                 uint maxNbVertices, decimal weldingDistance, decimal margin)
+                : ConvexShape(CONVEX_MESH, margin), mNbVertices(0), mMinBounds(0, 0, 0),
+                  mMaxBounds(0, 0, 0), mIsEdgesInformationUsed(true),
+                  mIsAdjacencyUpToDate(false) {
+    assert(nbPoints > 0);
+    assert(stride > 0);
+
+    // Compute the convex hull of the points
+    QuickHull quickHull;
+    if (!quickHull.computeHull(arrayPoints, nbPoints, stride, maxNbVertices, weldingDistance)) {
+
+        // If the points are degenerate, use all of them as vertices
+        mIsEdgesInformationUsed = false;
+        const unsigned char* pointPointer = (const unsigned char*) arrayPoints;
+        for (uint i=0; i<nbPoints; i++) {
+            const decimal* point = (const decimal*) pointPointer;
+            mVertices.push_back(Vector3(point[0], point[1], point[2]));
+            pointPointer += stride;
+        }
+        mNbVertices = nbPoints;
+        updateVerticesComponents(0);
+        recalculateBounds();
+        return;
+    }
+
+    // Copy the vertices of the hull
+    for (uint v=0; v<quickHull.getNbVertices(); v++) {
+        mVertices.push_back(quickHull.getVertex(v));
+    }
+    mNbVertices = mVertices.size();
+    updateVerticesComponents(0);
+    recalculateBounds();
+
+    // Add the edges of the triangles of the hull
+    const std::vector<uint>& trianglesVertexIndices = quickHull.getTrianglesVertexIndices();
+    for (uint t=0; t + 2 < trianglesVertexIndices.size(); t += 3) {
+        for (int k=0; k<3; k++) {
+            mEdgesVertexIndices.push_back(trianglesVertexIndices[t + k]);
+            mEdgesVertexIndices.push_back(trianglesVertexIndices[t + (k + 1) % 3]);
+        }
+    }
+    computeAdjacencyArrays();
+
+    // Merge the coplanar triangles into the faces of the polyhedron
+    computeFacesFromTriangles(trianglesVertexIndices);
+}
+
 // Constructor to initialize with a triangle mesh
 /// This method creates an internal copy of the input vertices.
 /**
@@ -66,7 +138,8 @@ ConvexMeshShape::ConvexMeshShape(const decimal* arrayVertices, uint nbVertices,
  */
 ConvexMeshShape::ConvexMeshShape(TriangleVertexArray* triangleVertexArray, bool isEdgesInformationUsed, decimal margin)
                 : ConvexShape(CONVEX_MESH, margin), mMinBounds(0, 0, 0),
-                  mMaxBounds(0, 0, 0), mIsEdgesInformationUsed(isEdgesInformationUsed) {
+                  mMaxBounds(0, 0, 0), mIsEdgesInformationUsed(isEdgesInformationUsed),
+                  mIsAdjacencyUpToDate(false) {
 
     TriangleVertexArray::VertexDataType vertexType = triangleVertexArray->getVertexDataType();
     TriangleVertexArray::IndexDataType indexType = triangleVertexArray->getIndexDataType();
@@ -95,40 +168,55 @@ ConvexMeshShape::ConvexMeshShape(TriangleVertexArray* triangleVertexArray, bool
         }
     }
 
-    // If we need to use the edges information of the mesh
-    if (mIsEdgesInformationUsed) {
-
-        // For each triangle of the mesh
-        for (uint triangleIndex=0; triangleIndex<triangleVertexArray->getNbTriangles(); triangleIndex++) {
+    // For each triangle of the mesh
+    std::vector<uint> trianglesVertexIndices;
+    for (uint triangleIndex=0; triangleIndex<triangleVertexArray->getNbTriangles(); triangleIndex++) {
 
-            void* vertexIndexPointer = (indicesStart + triangleIndex * 3 * indexStride);
+        void* vertexIndexPointer = (indicesStart + triangleIndex * 3 * indexStride);
 
-            uint vertexIndex[3] = {0, 0, 0};
+        uint vertexIndex[3] = {0, 0, 0};
 
-            // For each vertex of the triangle
-            for (int k=0; k < 3; k++) {
+        // For each vertex of the triangle
+        for (int k=0; k < 3; k++) {
 
-                // Get the index of the current vertex in the triangle
-                if (indexType == TriangleVertexArray::INDEX_INTEGER_TYPE) {
-                    vertexIndex[k] = ((uint*)vertexIndexPointer)[k];
-                }
-                else if (indexType == TriangleVertexArray::INDEX_SHORT_TYPE) {
-                    vertexIndex[k] = ((unsigned short*)vertexIndexPointer)[k];
-                }
-                else {
-                    assert(false);
-                }
+            // Get the index of the current vertex in the triangle
+            if (indexType == TriangleVertexArray::INDEX_INTEGER_TYPE) {
+                vertexIndex[k] = ((uint*)vertexIndexPointer)[k];
+            }
+            else if (indexType == TriangleVertexArray::INDEX_SHORT_TYPE) {
+                vertexIndex[k] = ((unsigned short*)vertexIndexPointer)[k];
+            }
+            else {
+                assert(false);
             }
 
+            trianglesVertexIndices.push_back(vertexIndex[k]);
+        }
+
+        // If we need to use the edges information of the mesh
+        if (mIsEdgesInformationUsed) {
+
             // Add information about the edges
-            addEdge(vertexIndex[0], vertexIndex[1]);
-            addEdge(vertexIndex[0], vertexIndex[2]);
-            addEdge(vertexIndex[1], vertexIndex[2]);
+            mEdgesVertexIndices.push_back(vertexIndex[0]);
+            mEdgesVertexIndices.push_back(vertexIndex[1]);
+            mEdgesVertexIndices.push_back(vertexIndex[0]);
+            mEdgesVertexIndices.push_back(vertexIndex[2]);
+            mEdgesVertexIndices.push_back(vertexIndex[1]);
+            mEdgesVertexIndices.push_back(vertexIndex[2]);
         }
     }
 
     mNbVertices = mVertices.size();
+    updateVerticesComponents(0);
     recalculateBounds();
+
+    // Build the adjacency arrays of the vertices once all the edges are known
+    if (mIsEdgesInformationUsed) {
+        computeAdjacencyArrays();
+    }
+
+    // Merge the coplanar triangles into the faces of the polyhedron
+    computeFacesFromTriangles(trianglesVertexIndices);
 }
 
 // Constructor.
@@ -136,7 +224,8 @@ ConvexMeshShape::ConvexMeshShape(TriangleVertexArray* triangleVertexArray, bool
 /// the addVertex() method.
 ConvexMeshShape::ConvexMeshShape(decimal margin)
                 : ConvexShape(CONVEX_MESH, margin), mNbVertices(0), mMinBounds(0, 0, 0),
-                  mMaxBounds(0, 0, 0), mIsEdgesInformationUsed(false) {
+                  mMaxBounds(0, 0, 0), mIsEdgesInformationUsed(false),
+                  mIsAdjacencyUpToDate(false) {
 
 }
 
@@ -152,82 +241,235 @@ ConvexMeshShape::~ConvexMeshShape() {
 /// However, if the edges information is used, we can cache the previous support vertex and use
 /// it as a start in a hill-climbing (local search) process to find the new support vertex which
 /// will be in most of the cases very close to the previous one. Using hill-climbing, this method
-/// runs in almost constant time.
+/// runs in almost constant time. For small meshes, testing all the vertices four by four is
+/// faster than the hill-climbing and is used instead. All the vertices are also tested if
+/// vertices or edges have been added since the adjacency arrays have been built.
 Vector3 ConvexMeshShape::getLocalSupportPointWithoutMargin(const Vector3& direction,
                                                            void** cachedCollisionData) const {
 
     assert(mNbVertices == mVertices.size());
     assert(cachedCollisionData != NULL);
 
-    // Allocate memory for the cached collision data if not allocated yet
-    if ((*cachedCollisionData) == NULL) {
-        *cachedCollisionData = (int*) malloc(sizeof(int));
-        *((int*)(*cachedCollisionData)) = 0;
-    }
+    // The vertices are stored without the scaling. Therefore, we scale the direction
+    // instead of each vertex (v * s).dot(d) = v.dot(d * s).
+    const Vector3 scaledDirection = direction * mScaling;
 
     // If the edges information is used to speed up the collision detection
-    if (mIsEdgesInformationUsed) {
+    if (mIsEdgesInformationUsed && mIsAdjacencyUpToDate &&
+        mNbVertices > CONVEX_MESH_MAX_NB_VERTICES_BRUTE_FORCE_SUPPORT) {
 
-        assert(mEdgesAdjacencyList.size() == mNbVertices);
+        // Allocate memory for the cached collision data if not allocated yet
+        if ((*cachedCollisionData) == NULL) {
+            *cachedCollisionData = (int*) malloc(sizeof(int));
+            *((int*)(*cachedCollisionData)) = 0;
+        }
 
-        uint maxVertex = *((int*)(*cachedCollisionData));
-        decimal maxDotProduct = direction.dot(mVertices[maxVertex]);
-        bool isOptimal;
+        // Perform hill-climbing from the previous support vertex
+        uint startVertex = *((int*)(*cachedCollisionData));
+        if (startVertex >= mNbVertices) startVertex = 0;
+        const uint maxVertex = computeSupportVertexHillClimbing(scaledDirection, startVertex);
 
-        // Perform hill-climbing (local search)
-        do {
-            isOptimal = true;
+        // Cache the support vertex
+        *((int*)(*cachedCollisionData)) = maxVertex;
 
-            assert(mEdgesAdjacencyList.at(maxVertex).size() > 0);
+        // Return the support vertex
+        return mVertices[maxVertex] * mScaling;
+    }
+    else {  // If the edges information is not used
 
-            // For all neighbors of the current vertex
-            std::set<uint>::const_iterator it;
-            std::set<uint>::const_iterator itBegin = mEdgesAdjacencyList.at(maxVertex).begin();
-            std::set<uint>::const_iterator itEnd = mEdgesAdjacencyList.at(maxVertex).end();
-            for (it = itBegin; it != itEnd; ++it) {
+        // Return the vertex with the largest dot product in the support direction
+        return mVertices[computeSupportVertexBruteForce(scaledDirection)] * mScaling;
+    }
+}
 
-                // Compute the dot product
-                decimal dotProduct = direction.dot(mVertices[*it]);
+// Return the index of the support vertex by testing all the vertices of the mesh
+/// With SSE, the dot products of four vertices are computed at the same time using the
+/// arrays of vertices coordinates. Each lane keeps its own maximum and the index of the
+/// corresponding vertex. The four lanes are compared at the end.
+/**
+ * @param direction Support direction (in local-space of the mesh without the scaling)
+ * @return The index of the vertex with the largest dot product in the direction
+ */
+uint ConvexMeshShape::computeSupportVertexBruteForce(const Vector3& direction) const {
 
-                // If the current vertex is a better vertex (larger dot product)
-                if (dotProduct > maxDotProduct) {
-                    maxVertex = *it;
-                    maxDotProduct = dotProduct;
-                    isOptimal = false;
-                }
-            }
+    assert(mNbVertices > 0);
+    assert(mVerticesComponents[0].size() % 4 == 0);
 
-        } while(!isOptimal);
+    const decimal* x = &(mVerticesComponents[0][0]);
+    const decimal* y = &(mVerticesComponents[1][0]);
+    const decimal* z = &(mVerticesComponents[2][0]);
+    const uint nbPaddedVertices = static_cast<uint>(mVerticesComponents[0].size());
 
-        // Cache the support vertex
-        *((int*)(*cachedCollisionData)) = maxVertex;
+#ifdef REACTPHYSICS3D_SSE_ENABLED
 
-        // Return the support vertex
-        return mVertices[maxVertex] * mScaling;
+    const __m128 directionX = _mm_set1_ps(direction.x);
+    const __m128 directionY = _mm_set1_ps(direction.y);
+    const __m128 directionZ = _mm_set1_ps(direction.z);
+    const __m128 four = _mm_set1_ps(4.0f);
+
+    // The indices are stored as floats because SSE has no integer selection
+    __m128 indices = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+    __m128 maxIndices = indices;
+    __m128 maxDotProducts = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x), directionX),
+                                                  _mm_mul_ps(_mm_loadu_ps(y), directionY)),
+                                       _mm_mul_ps(_mm_loadu_ps(z), directionZ));
+
+    // For each group of four vertices
+    for (uint i=4; i<nbPaddedVertices; i += 4) {
+
+        indices = _mm_add_ps(indices, four);
+
+        const __m128 dotProducts = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(x + i), directionX),
+                                                         _mm_mul_ps(_mm_loadu_ps(y + i), directionY)),
+                                              _mm_mul_ps(_mm_loadu_ps(z + i), directionZ));
+
+        // Keep the largest dot product of each lane with the index of its vertex
+        const __m128 isLarger = _mm_cmpgt_ps(dotProducts, maxDotProducts);
+        maxDotProducts = _mm_max_ps(dotProducts, maxDotProducts);
+        maxIndices = _mm_or_ps(_mm_and_ps(isLarger, indices), _mm_andnot_ps(isLarger, maxIndices));
     }
-    else {  // If the edges information is not used
 
-        double maxDotProduct = DECIMAL_SMALLEST;
-        uint indexMaxDotProduct = 0;
+    // Select the largest dot product of the four lanes
+    float lanesDotProducts[4];
+    float lanesIndices[4];
+    _mm_storeu_ps(lanesDotProducts, maxDotProducts);
+    _mm_storeu_ps(lanesIndices, maxIndices);
+    uint maxLane = 0;
+    for (uint lane=1; lane<4; lane++) {
+        if (lanesDotProducts[lane] > lanesDotProducts[maxLane]) maxLane = lane;
+    }
+
+    // The padding vertices are copies of the first vertex
+    const uint indexMaxDotProduct = static_cast<uint>(lanesIndices[maxLane]);
+    return indexMaxDotProduct < mNbVertices ? indexMaxDotProduct : 0;
+
+#else
+
+    decimal maxDotProduct = DECIMAL_SMALLEST;
+    uint indexMaxDotProduct = 0;
+
+    // For each vertex of the mesh
+    for (uint i=0; i<nbPaddedVertices; i++) {
+
+        // Compute the dot product of the current vertex
+        const decimal dotProduct = x[i] * direction.x + y[i] * direction.y + z[i] * direction.z;
 
-        // For each vertex of the mesh
-        for (uint i=0; i<mNbVertices; i++) {
+        // If the current dot product is larger than the maximum one
+        if (dotProduct > maxDotProduct) {
+            indexMaxDotProduct = i;
+            maxDotProduct = dotProduct;
+        }
+    }
+
+    // The padding vertices are copies of the first vertex
+    return indexMaxDotProduct < mNbVertices ? indexMaxDotProduct : 0;
+
+#endif
+}
+
+// Return the index of the support vertex by hill-climbing from a given vertex
+/// We move to a neighbor of the current vertex as long as it has a larger dot product
+/// in the support direction. Because the mesh is convex, the local maximum that is found
+/// is also the global one.
+/**
+ * @param direction Support direction (in local-space of the mesh without the scaling)
+ * @param startVertex Index of the vertex where to start the search
+ * @return The index of the vertex with the largest dot product in the direction
+ */
+uint ConvexMeshShape::computeSupportVertexHillClimbing(const Vector3& direction,
+                                                       uint startVertex) const {
 
-            // Compute the dot product of the current vertex
-            double dotProduct = direction.dot(mVertices[i]);
+    assert(mAdjacencyOffsets.size() == mNbVertices + 1);
+    assert(startVertex < mNbVertices);
 
-            // If the current dot product is larger than the maximum one
+    const uint* offsets = &(mAdjacencyOffsets[0]);
+    const uint* adjacentVertices = mAdjacentVertices.empty() ? NULL : &(mAdjacentVertices[0]);
+
+    uint maxVertex = startVertex;
+    decimal maxDotProduct = direction.dot(mVertices[maxVertex]);
+    bool isOptimal;
+
+    // Perform hill-climbing (local search)
+    do {
+        isOptimal = true;
+
+        // For all neighbors of the current vertex
+        const uint firstNeighbor = offsets[maxVertex];
+        const uint lastNeighbor = offsets[maxVertex + 1];
+        for (uint n=firstNeighbor; n<lastNeighbor; n++) {
+
+            // Compute the dot product
+            const uint vertex = adjacentVertices[n];
+            const decimal dotProduct = direction.dot(mVertices[vertex]);
+
+            // If the current vertex is a better vertex (larger dot product)
             if (dotProduct > maxDotProduct) {
-                indexMaxDotProduct = i;
+                maxVertex = vertex;
                 maxDotProduct = dotProduct;
+                isOptimal = false;
             }
         }
 
-        assert(maxDotProduct >= decimal(0.0));
+    } while(!isOptimal);
 
-        // Return the vertex with the largest dot product in the support direction
-        return mVertices[indexMaxDotProduct] * mScaling;
+    return maxVertex;
+}
+
+// Update the arrays of vertices coordinates from a given vertex
+/// The arrays are padded with copies of the first vertex so that their size is a
+/// multiple of four.
+/**
+ * @param firstVertexIndex Index of the first vertex that has changed
+ */
+void ConvexMeshShape::updateVerticesComponents(uint firstVertexIndex) {
+
+    const uint nbPaddedVertices = (mNbVertices + 3) & ~3u;
+
+    for (int c=0; c<3; c++) {
+        mVerticesComponents[c].resize(nbPaddedVertices);
+        for (uint i=firstVertexIndex; i<nbPaddedVertices; i++) {
+            const Vector3& vertex = mVertices[i < mNbVertices ? i : 0];
+            mVerticesComponents[c][i] = vertex[c];
+        }
+    }
+}
+
+// Compute the compact adjacency arrays of the vertices from the edges of the mesh
+/// The neighbors of all the vertices are stored contiguously in a single array
+/// (compressed sparse rows) with each neighbor only once. The edges with an invalid
+/// vertex index are ignored.
+void ConvexMeshShape::computeAdjacencyArrays() {
+
+    // Collect the two directions of each edge
+    std::vector<std::pair<uint, uint> > neighbors;
+    neighbors.reserve(mEdgesVertexIndices.size());
+    for (uint i=0; i + 1 < mEdgesVertexIndices.size(); i += 2) {
+        const uint v1 = mEdgesVertexIndices[i];
+        const uint v2 = mEdgesVertexIndices[i + 1];
+        if (v1 == v2 || v1 >= mNbVertices || v2 >= mNbVertices) continue;
+        neighbors.push_back(std::make_pair(v1, v2));
+        neighbors.push_back(std::make_pair(v2, v1));
     }
+
+    // Sort the neighbors by vertex and remove the duplicated edges
+    std::sort(neighbors.begin(), neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+
+    // Compute the index of the first neighbor of each vertex
+    mAdjacencyOffsets.assign(mNbVertices + 1, 0);
+    for (uint i=0; i<neighbors.size(); i++) {
+        mAdjacencyOffsets[neighbors[i].first + 1]++;
+    }
+    for (uint v=0; v<mNbVertices; v++) {
+        mAdjacencyOffsets[v + 1] += mAdjacencyOffsets[v];
+    }
+
+    mAdjacentVertices.resize(neighbors.size());
+    for (uint i=0; i<neighbors.size(); i++) {
+        mAdjacentVertices[i] = neighbors[i].second;
+    }
+
+    mIsAdjacencyUpToDate = true;
 }
 
 // Recompute the bounds of the mesh
@@ -261,6 +503,161 @@ void ConvexMeshShape::recalculateBounds() {
     mMinBounds -= Vector3(mMargin, mMargin, mMargin);
 }
 
+// Compute the faces and edges of the polyhedron from the triangles of the mesh
+/// The triangles with the same supporting plane are merged into a single face whose
+/// vertices are sorted counter-clockwise around the outward normal of the face. The
+/// triangles do not need to be consistently oriented because the faces are oriented
+/// away from the centroid of the mesh. If the triangles do not describe a closed
+/// convex polyhedron, no face is kept and the collision detection only uses the
+/// vertices of the mesh.
+/**
+ * @param trianglesVertexIndices Three vertex indices for each triangle of the mesh
+ */
+void ConvexMeshShape::computeFacesFromTriangles(const std::vector<uint>& trianglesVertexIndices) {
+
+    mFaces.clear();
+    mFacesVertexIndices.clear();
+    mEdges.clear();
+
+    if (mNbVertices < 4) return;
+
+    // Compute the centroid of the vertices
+    Vector3 centroid(0, 0, 0);
+    for (uint i=0; i<mNbVertices; i++) {
+        centroid += mVertices[i];
+    }
+    centroid /= decimal(mNbVertices);
+
+    // Tolerances used to decide if two triangles are coplanar
+    const decimal size = (mMaxBounds - mMinBounds).length();
+    const decimal distanceTolerance = decimal(0.001) * size;
+    const decimal normalTolerance = decimal(0.999);
+
+    // Group the triangles with the same supporting plane
+    std::vector<Vector3> facesNormals;
+    std::vector<decimal> facesOffsets;
+    std::vector<std::set<uint> > facesVertices;
+    for (uint t=0; t + 2 < trianglesVertexIndices.size(); t += 3) {
+
+        const uint v0 = trianglesVertexIndices[t];
+        const uint v1 = trianglesVertexIndices[t + 1];
+        const uint v2 = trianglesVertexIndices[t + 2];
+        assert(v0 < mNbVertices && v1 < mNbVertices && v2 < mNbVertices);
+
+        Vector3 normal = (mVertices[v1] - mVertices[v0]).cross(mVertices[v2] - mVertices[v0]);
+        const decimal normalLength = normal.length();
+        if (normalLength < MACHINE_EPSILON) continue;
+        normal /= normalLength;
+        if (normal.dot(mVertices[v0] - centroid) < decimal(0.0)) normal = -normal;
+        const decimal offset = normal.dot(mVertices[v0]);
+
+        // Find a face with the same plane or create a new one
+        uint face = 0;
+        while (face < facesNormals.size() &&
+               (facesNormals[face].dot(normal) < normalTolerance ||
+                std::abs(facesOffsets[face] - offset) > distanceTolerance)) {
+            face++;
+        }
+        if (face == facesNormals.size()) {
+            facesNormals.push_back(normal);
+            facesOffsets.push_back(offset);
+            facesVertices.push_back(std::set<uint>());
+        }
+        facesVertices[face].insert(v0);
+        facesVertices[face].insert(v1);
+        facesVertices[face].insert(v2);
+    }
+
+    if (facesNormals.size() < 4) return;
+
+    // Sort the vertices of each face counter-clockwise around its normal
+    std::map<std::pair<uint, uint>, uint> edgesIndices;
+    for (uint face=0; face<facesNormals.size(); face++) {
+
+        const Vector3& normal = facesNormals[face];
+        Vector3 faceCenter(0, 0, 0);
+        std::set<uint>::const_iterator it;
+        for (it = facesVertices[face].begin(); it != facesVertices[face].end(); ++it) {
+            faceCenter += mVertices[*it];
+        }
+        faceCenter /= decimal(facesVertices[face].size());
+
+        const Vector3 axisU = (mVertices[*(facesVertices[face].begin())] - faceCenter).getUnit();
+        const Vector3 axisV = normal.cross(axisU);
+        std::vector<std::pair<decimal, uint> > sortedVertices;
+        for (it = facesVertices[face].begin(); it != facesVertices[face].end(); ++it) {
+            const Vector3 vector = mVertices[*it] - faceCenter;
+            sortedVertices.push_back(std::make_pair(std::atan2(vector.dot(axisV), vector.dot(axisU)), *it));
+        }
+        std::sort(sortedVertices.begin(), sortedVertices.end());
+
+        PolyhedronFace polyhedronFace;
+        polyhedronFace.normal = normal;
+        polyhedronFace.firstVertexIndex = mFacesVertexIndices.size();
+        polyhedronFace.nbVertices = sortedVertices.size();
+        for (uint i=0; i<sortedVertices.size(); i++) {
+            mFacesVertexIndices.push_back(sortedVertices[i].second);
+        }
+        mFaces.push_back(polyhedronFace);
+
+        // Add the edges of the face
+        for (uint i=0; i<sortedVertices.size(); i++) {
+
+            const uint vertex1 = sortedVertices[i].second;
+            const uint vertex2 = sortedVertices[(i + 1) % sortedVertices.size()].second;
+            const std::pair<uint, uint> key(std::min(vertex1, vertex2), std::max(vertex1, vertex2));
+
+            std::map<std::pair<uint, uint>, uint>::iterator itEdge = edgesIndices.find(key);
+            if (itEdge == edgesIndices.end()) {
+                PolyhedronEdge edge;
+                edge.vertex1 = vertex1;
+                edge.vertex2 = vertex2;
+                edge.face1 = face;
+                edge.face2 = face;
+                edgesIndices.insert(std::make_pair(key, mEdges.size()));
+                mEdges.push_back(edge);
+            }
+            else {
+                mEdges[itEdge->second].face2 = face;
+            }
+        }
+    }
+
+    // If an edge does not have two adjacent faces, the polyhedron is not closed
+    for (uint i=0; i<mEdges.size(); i++) {
+        if (mEdges[i].face1 == mEdges[i].face2) {
+            mFaces.clear();
+            mFacesVertexIndices.clear();
+            mEdges.clear();
+            return;
+        }
+    }
+
+    updateFacesNormals();
+}
+
+// Recompute the normals of the faces with the current scaling of the mesh
+/// The normals are computed with the Newell method on the scaled vertices of
+/// each face.
+void ConvexMeshShape::updateFacesNormals() {
+
+    for (uint face=0; face<mFaces.size(); face++) {
+
+        Vector3 normal(0, 0, 0);
+        const uint nbFaceVertices = mFaces[face].nbVertices;
+        for (uint i=0; i<nbFaceVertices; i++) {
+            const Vector3 current = getVertex(mFacesVertexIndices[mFaces[face].firstVertexIndex + i]);
+            const Vector3 next = getVertex(mFacesVertexIndices[mFaces[face].firstVertexIndex +
+                                                               (i + 1) % nbFaceVertices]);
+            normal.x += (current.y - next.y) * (current.z + next.z);
+            normal.y += (current.z - next.z) * (current.x + next.x);
+            normal.z += (current.x - next.x) * (current.y + next.y);
+        }
+
+        mFaces[face].normal = normal.getUnit();
+    }
+}
+
 // Raycast method with feedback information
 bool ConvexMeshShape::raycast(const Ray& ray, RaycastInfo& raycastInfo, ProxyShape* proxyShape) const {
     return proxyShape->mBody->mWorld.mCollisionDetection.mNarrowPhaseGJKAlgorithm.raycast(
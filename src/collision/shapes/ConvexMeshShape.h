@@ -28,6 +28,7 @@
 
 // Libraries
 #include "ConvexShape.h"
+#include "PolyhedronFeatures.h"
 #include "engine/CollisionWorld.h"
 #include "mathematics/mathematics.h"
 #include "collision/TriangleMesh.h"
@@ -49,14 +50,23 @@ class CollisionWorld;
  * passing a vertices array to the constructor or using the addVertex() method. Make sure
  * that the set of vertices that you use to create the shape are indeed part of a convex
  * mesh. The center of mass of the shape will be at the origin of the local-space geometry
- * that you use to create the mesh. The method used for collision detection with a convex
- * mesh shape has an O(n) running time with "n" beeing the number of vertices in the mesh.
+ * that you use to create the mesh. If your vertices are not all on the surface of a convex
+ * mesh (for instance the vertices of a render mesh), you can use the constructor that
+ * computes the convex hull of the points instead. The hull can be simplified with a
+ * maximum number of vertices and a welding distance. The method used for collision
+ * detection with a convex mesh shape has an O(n) running time with "n" beeing the number
+ * of vertices in the mesh.
  * Therefore, you should try not to use too many vertices. However, it is possible to speed
  * up the collision detection by using the edges information of your mesh. The running time
  * of the collision detection that uses the edges is almost O(1) constant time at the cost
- * of additional memory used to store the vertices. You can indicate edges information
- * with the addEdge() method. Then, you must use the setIsEdgesInformationUsed(true) method
- * in order to use the edges information for collision detection.
+ * of additional memory used to store the adjacency of the vertices. You can indicate edges
+ * information with the addEdge() method. Then, you must use the setIsEdgesInformationUsed(true)
+ * method in order to use the edges information for collision detection. The adjacency of the
+ * vertices is built at this point and the vertices and edges added afterwards are only used
+ * once the setIsEdgesInformationUsed(true) method is called again. When the shape is created
+ * with a triangle vertex array or a cloud of points, the coplanar triangles are also merged
+ * into the faces of the polyhedron. The faces allow the collision detection to compute all the contact points
+ * between two polyhedra in a single frame.
  */
 class ConvexMeshShape : public ConvexShape {
 
@@ -80,8 +90,32 @@ class ConvexMeshShape : public ConvexShape {
         /// make the collision detection faster
         bool mIsEdgesInformationUsed;
 
-        /// Adjacency list representing the edges of the mesh
-        std::map<uint, std::set<uint> > mEdgesAdjacencyList;
+        /// Coordinates of the vertices in three separate arrays (x, y and z) padded with
+        /// copies of the first vertex to a multiple of four vertices
+        std::vector<decimal> mVerticesComponents[3];
+
+        /// Two vertex indices for each edge added into the mesh
+        std::vector<uint> mEdgesVertexIndices;
+
+        /// Index in the mAdjacentVertices array of the first neighbor of each vertex
+        /// (with an additional element equal to the size of the mAdjacentVertices array)
+        std::vector<uint> mAdjacencyOffsets;
+
+        /// Neighbors of all the vertices of the mesh (only built if the edges
+        /// information is used)
+        std::vector<uint> mAdjacentVertices;
+
+        /// True if the adjacency arrays contain all the vertices and edges of the mesh
+        bool mIsAdjacencyUpToDate;
+
+        /// Faces of the polyhedron (empty if the faces of the mesh are not known)
+        std::vector<PolyhedronFace> mFaces;
+
+        /// Vertex indices of all the faces of the polyhedron
+        std::vector<uint> mFacesVertexIndices;
+
+        /// Edges of the polyhedron with their two adjacent faces
+        std::vector<PolyhedronEdge> mEdges;
 
         // -------------------- Methods -------------------- //
 
@@ -94,6 +128,24 @@ class ConvexMeshShape : public ConvexShape {
         /// Recompute the bounds of the mesh
         void recalculateBounds();
 
+        /// Update the arrays of vertices coordinates from a given vertex
+        void updateVerticesComponents(uint firstVertexIndex);
+
+        /// Compute the compact adjacency arrays of the vertices from the edges of the mesh
+        void computeAdjacencyArrays();
+
+        /// Return the index of the support vertex by testing all the vertices of the mesh
+        uint computeSupportVertexBruteForce(const Vector3& direction) const;
+
+        /// Return the index of the support vertex by hill-climbing from a given vertex
+        uint computeSupportVertexHillClimbing(const Vector3& direction, uint startVertex) const;
+
+        /// Compute the faces and edges of the polyhedron from the triangles of the mesh
+        void computeFacesFromTriangles(const std::vector<uint>& trianglesVertexIndices);
+
+        /// Recompute the normals of the faces with the current scaling of the mesh
+        void updateFacesNormals();
+
         /// Set the scaling vector of the collision shape
         virtual void setLocalScaling(const Vector3& scaling);
 
@@ -118,6 +170,10 @@ class ConvexMeshShape : public ConvexShape {
         ConvexMeshShape(const decimal* arrayVertices, uint nbVertices, int stride,
                         decimal margin = OBJECT_MARGIN);
 
+        /// Constructor to initialize with the convex hull of a cloud of points
+        ConvexMeshShape(const decimal* arrayPoints, uint nbPoints, int stride, uint maxNbVertices,
+                        decimal weldingDistance, decimal margin = OBJECT_MARGIN);
+
         /// Constructor to initialize with a triangle vertex array
         ConvexMeshShape(TriangleVertexArray* triangleVertexArray, bool isEdgesInformationUsed = true,
                         decimal margin = OBJECT_MARGIN);
@@ -146,12 +202,37 @@ class ConvexMeshShape : public ConvexShape {
         /// Set the variable to know if the edges information is used to speed up the
         /// collision detection
         void setIsEdgesInformationUsed(bool isEdgesUsed);
+
+        /// Return true if the faces of the polyhedron are known
+        bool isFacesInformationAvailable() const;
+
+        /// Return the number of vertices of the mesh
+        uint getNbVertices() const;
+
+        /// Return a vertex of the mesh (in local-space of the shape with the scaling)
+        Vector3 getVertex(uint vertexIndex) const;
+
+        /// Return the number of faces of the polyhedron
+        uint getNbFaces() const;
+
+        /// Return a face of the polyhedron
+        const PolyhedronFace& getFace(uint faceIndex) const;
+
+        /// Return the vertex indices of all the faces of the polyhedron
+        const uint* getFacesVertexIndices() const;
+
+        /// Return the number of edges of the polyhedron
+        uint getNbEdges() const;
+
+        /// Return an edge of the polyhedron
+        const PolyhedronEdge& getEdge(uint edgeIndex) const;
 };
 
 /// Set the scaling vector of the collision shape
 inline void ConvexMeshShape::setLocalScaling(const Vector3& scaling) {
     ConvexShape::setLocalScaling(scaling);
     recalculateBounds();
+    updateFacesNormals();
 }
 
 // Return the number of bytes used by the collision shape
@@ -190,14 +271,23 @@ inline void ConvexMeshShape::computeLocalInertiaTensor(Matrix3x3& tensor, decima
 }
 
 // Add a vertex into the convex mesh
+/// A vertex cannot be added into a mesh created with faces (from a triangle vertex array
+/// or from a cloud of points) because the faces would not be valid anymore.
 /**
  * @param vertex Vertex to be added
  */
 inline void ConvexMeshShape::addVertex(const Vector3& vertex) {
 
+    // The faces of the polyhedron cannot be updated with a new vertex
+    assert(mFaces.empty());
+
     // Add the vertex in to vertices array
     mVertices.push_back(vertex);
     mNbVertices++;
+    updateVerticesComponents(mNbVertices - 1);
+
+    // The adjacency arrays do not contain the new vertex anymore
+    mIsAdjacencyUpToDate = false;
 
     // Update the bounds of the mesh
     if (vertex.x * mScaling.x > mMaxBounds.x) mMaxBounds.x = vertex.x * mScaling.x;
@@ -211,26 +301,20 @@ inline void ConvexMeshShape::addVertex(const Vector3& vertex) {
 // Add an edge into the convex mesh by specifying the two vertex indices of the edge.
 /// Note that the vertex indices start at zero and need to correspond to the order of
 /// the vertices in the vertices array in the constructor or the order of the calls
-/// of the addVertex() methods that you use to add vertices into the convex mesh.
+/// of the addVertex() methods that you use to add vertices into the convex mesh. The
+/// adjacency arrays of the vertices are only built by the setIsEdgesInformationUsed()
+/// method. Therefore, you should add all the edges before calling this method.
 /**
 * @param v1 Index of the first vertex of the edge to add
 * @param v2 Index of the second vertex of the edge to add
 */
 inline void ConvexMeshShape::addEdge(uint v1, uint v2) {
 
-    // If the entry for vertex v1 does not exist in the adjacency list
-    if (mEdgesAdjacencyList.count(v1) == 0) {
-        mEdgesAdjacencyList.insert(std::make_pair(v1, std::set<uint>()));
-    }
-
-    // If the entry for vertex v2 does not exist in the adjacency list
-    if (mEdgesAdjacencyList.count(v2) == 0) {
-        mEdgesAdjacencyList.insert(std::make_pair(v2, std::set<uint>()));
-    }
+    mEdgesVertexIndices.push_back(v1);
+    mEdgesVertexIndices.push_back(v2);
 
-    // Add the edge in the adjacency list
-    mEdgesAdjacencyList[v1].insert(v2);
-    mEdgesAdjacencyList[v2].insert(v1);
+    // The adjacency arrays do not contain the new edge anymore
+    mIsAdjacencyUpToDate = false;
 }
 
 // Return true if the edges information is used to speed up the collision detection
@@ -249,6 +333,62 @@ inline bool ConvexMeshShape::isEdgesInformationUsed() const {
  */
 inline void ConvexMeshShape::setIsEdgesInformationUsed(bool isEdgesUsed) {
     mIsEdgesInformationUsed = isEdgesUsed;
+
+    // Build the adjacency arrays of the vertices (or release them)
+    if (isEdgesUsed) {
+        computeAdjacencyArrays();
+    }
+    else {
+        mAdjacencyOffsets.clear();
+        mAdjacentVertices.clear();
+        mIsAdjacencyUpToDate = false;
+    }
+}
+
+// Return true if the faces of the polyhedron are known
+/**
+ * @return True if the faces and edges of the polyhedron have been computed
+ */
+inline bool ConvexMeshShape::isFacesInformationAvailable() const {
+    return !mFaces.empty();
+}
+
+// Return the number of vertices of the mesh
+inline uint ConvexMeshShape::getNbVertices() const {
+    return mNbVertices;
+}
+
+// Return a vertex of the mesh (in local-space of the shape with the scaling)
+inline Vector3 ConvexMeshShape::getVertex(uint vertexIndex) const {
+    assert(vertexIndex < mNbVertices);
+    return mVertices[vertexIndex] * mScaling;
+}
+
+// Return the number of faces of the polyhedron
+inline uint ConvexMeshShape::getNbFaces() const {
+    return mFaces.size();
+}
+
+// Return a face of the polyhedron
+inline const PolyhedronFace& ConvexMeshShape::getFace(uint faceIndex) const {
+    assert(faceIndex < mFaces.size());
+    return mFaces[faceIndex];
+}
+
+// Return the vertex indices of all the faces of the polyhedron
+inline const uint* ConvexMeshShape::getFacesVertexIndices() const {
+    return mFacesVertexIndices.empty() ? NULL : &(mFacesVertexIndices[0]);
+}
+
+// Return the number of edges of the polyhedron
+inline uint ConvexMeshShape::getNbEdges() const {
+    return mEdges.size();
+}
+
+// Return an edge of the polyhedron
+inline const PolyhedronEdge& ConvexMeshShape::getEdge(uint edgeIndex) const {
+    assert(edgeIndex < mEdges.size());
+    return mEdges[edgeIndex];
 }
 
 // Return true if a point is inside the collision shape
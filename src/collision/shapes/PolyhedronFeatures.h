@@ -0,0 +1,77 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_POLYHEDRON_FEATURES_H
+#define REACTPHYSICS3D_POLYHEDRON_FEATURES_H
+
+// Libraries
+#include "configuration.h"
+#include "mathematics/Vector3.h"
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Structure PolyhedronFace
+/**
+ * This structure represents a face of a convex polyhedron. The vertices of
+ * the face are stored in an array of vertex indices shared by all the faces
+ * of the polyhedron and are ordered counter-clockwise around the outward
+ * normal of the face.
+ */
+struct PolyhedronFace {
+
+    /// Outward unit normal of the face in local-space of the polyhedron
+    Vector3 normal;
+
+    /// Index of the first vertex of the face in the array of face vertex indices
+    uint firstVertexIndex;
+
+    /// Number of vertices of the face
+    uint nbVertices;
+};
+
+// Structure PolyhedronEdge
+/**
+ * This structure represents an edge of a convex polyhedron with the two
+ * faces that share it.
+ */
+struct PolyhedronEdge {
+
+    /// Index of the first vertex of the edge
+    uint vertex1;
+
+    /// Index of the second vertex of the edge
+    uint vertex2;
+
+    /// Index of the first face adjacent to the edge
+    uint face1;
+
+    /// Index of the second face adjacent to the edge
+    uint face2;
+};
+
+}
+
+#endif
@@ -0,0 +1,496 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "QuickHull.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace reactphysics3d;
+
+// Constructor
+QuickHull::QuickHull() : mTolerance(0), mWeldingDistance(0), mNbHullVertices(0) {
+
+}
+
+// Destructor
+QuickHull::~QuickHull() {
+
+}
+
+// Compute the convex hull of a cloud of points
+/// The vertices and triangles of the hull can then be retrieved with the getVertex() and
+/// getTrianglesVertexIndices() methods. If all the points are on a plane or on a line,
+/// no hull is computed and this method returns false.
+/**
+ * @param arrayPoints Array with the points of the cloud
+ * @param nbPoints Number of points in the array
+ * @param stride Stride between the beginning of two elements in the points array
+ * @param maxNbVertices Maximum number of vertices of the hull (at least four)
+ * @param weldingDistance Distance (in meters) under which a point is considered to be
+ *                        on the hull and does not become a new vertex of the hull
+ * @return True if the hull has been computed and false if the points are degenerate
+ */
+bool QuickHull::computeHull(const decimal* arrayPoints, uint nbPoints, int stride,
+                            uint maxNbVertices, decimal weldingDistance) {
+
+    assert(stride > 0);
+    assert(maxNbVertices >= 4);
+    assert(weldingDistance >= decimal(0.0));
+
+    mPoints.clear();
+    mFaces.clear();
+    mFreeFaces.clear();
+    mFacesQueue = std::priority_queue<std::pair<decimal, uint> >();
+    mEdgesFaces.clear();
+    mHullVertices.clear();
+    mHullTrianglesVertexIndices.clear();
+    mNbHullVertices = 0;
+
+    // Copy the points of the cloud
+    const unsigned char* pointPointer = (const unsigned char*) arrayPoints;
+    Vector3 maxAbsCoordinates(0, 0, 0);
+    for (uint i=0; i<nbPoints; i++) {
+        const decimal* point = (const decimal*) pointPointer;
+        mPoints.push_back(Vector3(point[0], point[1], point[2]));
+        maxAbsCoordinates = Vector3::max(maxAbsCoordinates, mPoints[i].getAbsoluteVector());
+        pointPointer += stride;
+    }
+
+    // Precision of the computations with the coordinates of the points
+    mTolerance = decimal(3.0) * MACHINE_EPSILON *
+                 (maxAbsCoordinates.x + maxAbsCoordinates.y + maxAbsCoordinates.z);
+    mWeldingDistance = std::max(weldingDistance, mTolerance);
+
+    if (nbPoints < 4 || !computeInitialTetrahedron()) return false;
+
+    // Add a new vertex into the hull until all the points are inside it or the maximum
+    // number of vertices is reached
+    uint furthestFace;
+    while (mNbHullVertices < maxNbVertices && findFurthestFace(furthestFace)) {
+        uint eyeFace;
+        const uint eyePoint = selectEyePoint(furthestFace, eyeFace);
+        addPointToHull(eyePoint, eyeFace);
+    }
+
+    computeHullMesh();
+
+    return true;
+}
+
+// Create the initial tetrahedron of the hull
+/// The first two vertices are far from each other. The third one is the furthest from
+/// the line of the first two and the last one is the furthest from the plane of the
+/// first three.
+/**
+ * @return False if all the points are on a plane or on a line
+ */
+bool QuickHull::computeInitialTetrahedron() {
+
+    const uint nbPoints = static_cast<uint>(mPoints.size());
+    std::vector<uint> allPoints(nbPoints);
+    std::vector<decimal> values(nbPoints);
+    decimal maxValue;
+
+    // Select the point that is the furthest from an arbitrary point and then the point
+    // that is the furthest from the first selected one
+    for (uint i=0; i<nbPoints; i++) {
+        allPoints[i] = i;
+        values[i] = (mPoints[i] - mPoints[0]).lengthSquare();
+    }
+    uint v1 = selectExtremePoint(allPoints, values, mPoints[0], maxValue);
+    for (uint i=0; i<nbPoints; i++) {
+        values[i] = (mPoints[i] - mPoints[v1]).lengthSquare();
+    }
+    uint v0 = selectExtremePoint(allPoints, values, mPoints[v1], maxValue);
+    if (std::sqrt(maxValue) <= mWeldingDistance) return false;
+
+    // Select the point that is the furthest from the line of the two first points
+    const Vector3 lineDirection = (mPoints[v1] - mPoints[v0]).getUnit();
+    for (uint i=0; i<nbPoints; i++) {
+        values[i] = (mPoints[i] - mPoints[v0]).cross(lineDirection).length();
+    }
+    uint v2 = selectExtremePoint(allPoints, values, (mPoints[v0] + mPoints[v1]) * decimal(0.5),
+                                 maxValue);
+    if (maxValue <= mWeldingDistance) return false;
+
+    // Select the point that is the furthest from the plane of the three first points
+    const Vector3 planeNormal = (mPoints[v1] - mPoints[v0]).cross(mPoints[v2] - mPoints[v0]).getUnit();
+    for (uint i=0; i<nbPoints; i++) {
+        values[i] = std::abs(planeNormal.dot(mPoints[i] - mPoints[v0]));
+    }
+    const uint v3 = selectExtremePoint(allPoints, values,
+                                       (mPoints[v0] + mPoints[v1] + mPoints[v2]) / decimal(3.0),
+                                       maxValue);
+    if (maxValue <= mWeldingDistance) return false;
+
+    // The first face must be oriented away from the fourth point
+    if (planeNormal.dot(mPoints[v3] - mPoints[v0]) > decimal(0.0)) {
+        std::swap(v1, v2);
+    }
+
+    // Create the four faces of the tetrahedron
+    std::vector<uint> faces;
+    faces.push_back(createFace(v0, v1, v2));
+    faces.push_back(createFace(v1, v0, v3));
+    faces.push_back(createFace(v2, v1, v3));
+    faces.push_back(createFace(v0, v2, v3));
+    mNbHullVertices = 4;
+
+    // Assign the other points to the faces in front of which they are
+    std::vector<uint> points;
+    points.reserve(nbPoints);
+    for (uint i=0; i<nbPoints; i++) {
+        if (i != v0 && i != v1 && i != v2 && i != v3) points.push_back(i);
+    }
+    assignOutsidePoints(points, faces);
+
+    return true;
+}
+
+// Select the candidate point with the largest value
+/// The candidates with a value within the welding distance of the largest one are
+/// considered to be equal and the one that is the furthest from a reference point is selected. This
+/// avoids selecting a point in the middle of a flat part of the cloud.
+/**
+ * @param candidates Indices of the candidate points
+ * @param values Value of each candidate
+ * @param referencePoint Point used to select one of the candidates with the largest value
+ * @param[out] maxValue Largest value of the candidates
+ * @return The index of the selected point in the array of candidates
+ */
+uint QuickHull::selectExtremePoint(const std::vector<uint>& candidates,
+                                   const std::vector<decimal>& values,
+                                   const Vector3& referencePoint, decimal& maxValue) const {
+
+    assert(!candidates.empty());
+    assert(candidates.size() == values.size());
+
+    maxValue = values[0];
+    for (uint i=1; i<values.size(); i++) {
+        maxValue = std::max(maxValue, values[i]);
+    }
+
+    uint selectedCandidate = 0;
+    decimal maxDistanceSquare = decimal(-1.0);
+    for (uint i=0; i<values.size(); i++) {
+        if (values[i] < maxValue - mWeldingDistance) continue;
+        const decimal distanceSquare = (mPoints[candidates[i]] - referencePoint).lengthSquare();
+        if (distanceSquare > maxDistanceSquare) {
+            maxDistanceSquare = distanceSquare;
+            selectedCandidate = i;
+        }
+    }
+
+    return selectedCandidate;
+}
+
+// Return the index of the face with the point that is the furthest from the hull
+/// The entries of the queue of the faces that have been removed or reused since they
+/// have been added are discarded.
+/**
+ * @param[out] faceIndex Index of the face with the furthest outside point
+ * @return False if no point is outside of the hull
+ */
+bool QuickHull::findFurthestFace(uint& faceIndex) {
+
+    while (!mFacesQueue.empty()) {
+
+        const std::pair<decimal, uint> entry = mFacesQueue.top();
+        mFacesQueue.pop();
+
+        const HullFace& face = mFaces[entry.second];
+        if (!face.isDeleted && !face.outsidePoints.empty() && face.furthestDistance == entry.first) {
+            faceIndex = entry.second;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Create a new face of the hull and return its index
+/// The slot of a removed face is reused if there is one.
+/**
+ * @param v0 Index of the first point of the face
+ * @param v1 Index of the second point of the face
+ * @param v2 Index of the third point of the face
+ * @return The index of the new face
+ */
+uint QuickHull::createFace(uint v0, uint v1, uint v2) {
+
+    uint faceIndex;
+    if (!mFreeFaces.empty()) {
+        faceIndex = mFreeFaces.back();
+        mFreeFaces.pop_back();
+    }
+    else {
+        faceIndex = static_cast<uint>(mFaces.size());
+        mFaces.push_back(HullFace());
+    }
+    HullFace& face = mFaces[faceIndex];
+
+    face.vertices[0] = v0;
+    face.vertices[1] = v1;
+    face.vertices[2] = v2;
+    face.normal = (mPoints[v1] - mPoints[v0]).cross(mPoints[v2] - mPoints[v0]);
+    const decimal normalLength = face.normal.length();
+    if (normalLength > MACHINE_EPSILON) face.normal /= normalLength;
+    face.offset = face.normal.dot(mPoints[v0]);
+    face.furthestPoint = 0;
+    face.furthestDistance = decimal(0.0);
+    face.isDeleted = false;
+
+    // Register the three directed edges of the face
+    mEdgesFaces[std::make_pair(v0, v1)] = faceIndex;
+    mEdgesFaces[std::make_pair(v1, v2)] = faceIndex;
+    mEdgesFaces[std::make_pair(v2, v0)] = faceIndex;
+
+    return faceIndex;
+}
+
+// Assign some points to the outside points of the faces in front of which they are
+/// Each point is assigned to the face from which it is the furthest. The points that
+/// are not in front of any of the faces are inside the hull and are discarded. The
+/// faces with outside points are then added into the queue of the faces.
+/**
+ * @param points Indices of the points to assign
+ * @param faces Indices of the faces the points can be assigned to
+ */
+void QuickHull::assignOutsidePoints(const std::vector<uint>& points, const std::vector<uint>& faces) {
+
+    for (uint i=0; i<points.size(); i++) {
+
+        const Vector3& point = mPoints[points[i]];
+
+        // Find the face from which the point is the furthest
+        bool isOutside = false;
+        uint bestFace = 0;
+        decimal maxDistance = mWeldingDistance;
+        for (uint f=0; f<faces.size(); f++) {
+            const HullFace& face = mFaces[faces[f]];
+            const decimal distance = face.normal.dot(point) - face.offset;
+            if (distance > maxDistance) {
+                isOutside = true;
+                bestFace = faces[f];
+                maxDistance = distance;
+            }
+        }
+
+        if (isOutside) {
+            HullFace& face = mFaces[bestFace];
+            face.outsidePoints.push_back(points[i]);
+            if (maxDistance > face.furthestDistance) {
+                face.furthestDistance = maxDistance;
+                face.furthestPoint = points[i];
+            }
+        }
+    }
+
+    for (uint f=0; f<faces.size(); f++) {
+        const HullFace& face = mFaces[faces[f]];
+        if (!face.outsidePoints.empty()) {
+            mFacesQueue.push(std::make_pair(face.furthestDistance, faces[f]));
+        }
+    }
+}
+
+// Select the outside point to add into the hull from a face of the hull
+/// The new vertex is the outside point that is the furthest along the normal of the face.
+/// Because the face is on the boundary of the hull, this point is an extreme point of the
+/// whole cloud. The furthest outside point of the face itself could end up inside a face
+/// of the final hull because the extreme point can be in the outside points of another
+/// face. This other face is visible from the furthest outside point of the face and
+/// therefore, the outside points of the visible faces are also searched. The faces
+/// visible from the selected point are computed.
+/**
+ * @param faceIndex Index of a face of the hull with outside points
+ * @param[out] eyeFace Index of the face with the selected point in its outside points
+ * @return The index of the selected point
+ */
+uint QuickHull::selectEyePoint(uint faceIndex, uint& eyeFace) {
+
+    const Vector3 normal = mFaces[faceIndex].normal;
+    const decimal offset = mFaces[faceIndex].offset;
+    const Vector3 referencePoint = mPoints[mFaces[faceIndex].vertices[0]];
+    decimal maxProjection;
+
+    // Select the furthest outside point of the face along its normal
+    const std::vector<uint>& outsidePoints = mFaces[faceIndex].outsidePoints;
+    mProjections.resize(outsidePoints.size());
+    for (uint i=0; i<outsidePoints.size(); i++) {
+        mProjections[i] = normal.dot(mPoints[outsidePoints[i]]);
+    }
+    uint eyePoint = outsidePoints[selectExtremePoint(outsidePoints, mProjections,
+                                                     referencePoint, maxProjection)];
+    eyeFace = faceIndex;
+    computeVisibleFaces(faceIndex, eyePoint);
+
+    // Select the furthest outside point of the visible faces along the normal
+    mCandidates.clear();
+    mCandidatesFaces.clear();
+    mProjections.clear();
+    for (uint i=0; i<mVisibleFaces.size(); i++) {
+        const HullFace& face = mFaces[mVisibleFaces[i]];
+        for (uint p=0; p<face.outsidePoints.size(); p++) {
+            mCandidates.push_back(face.outsidePoints[p]);
+            mCandidatesFaces.push_back(mVisibleFaces[i]);
+            mProjections.push_back(normal.dot(mPoints[face.outsidePoints[p]]));
+        }
+    }
+    const uint candidate = selectExtremePoint(mCandidates, mProjections, referencePoint,
+                                              maxProjection);
+
+    // If the selected point is another point in front of the face, we compute the
+    // faces that are visible from it instead
+    if (mCandidates[candidate] != eyePoint && mProjections[candidate] - offset > mTolerance) {
+        for (uint i=0; i<mVisibleFaces.size(); i++) {
+            mFaces[mVisibleFaces[i]].isDeleted = false;
+        }
+        eyePoint = mCandidates[candidate];
+        eyeFace = mCandidatesFaces[candidate];
+        computeVisibleFaces(faceIndex, eyePoint);
+    }
+
+    return eyePoint;
+}
+
+// Find the faces of the hull that are visible from a point and the horizon edges
+/// The faces are found with a search from the given face across the edges. The visible
+/// faces are marked as removed and the edges on the boundary of the visible region (the
+/// horizon) are stored counter-clockwise as seen from the outside of the hull.
+/**
+ * @param faceIndex Index of a face of the hull that can see the point
+ * @param eyePoint Index of the point
+ */
+void QuickHull::computeVisibleFaces(uint faceIndex, uint eyePoint) {
+
+    const Vector3& eye = mPoints[eyePoint];
+
+    mVisibleFaces.clear();
+    mHorizonEdges.clear();
+    mVisibleFaces.push_back(faceIndex);
+    mFaces[faceIndex].isDeleted = true;
+    for (uint i=0; i<mVisibleFaces.size(); i++) {
+
+        for (int e=0; e<3; e++) {
+
+            const uint v1 = mFaces[mVisibleFaces[i]].vertices[e];
+            const uint v2 = mFaces[mVisibleFaces[i]].vertices[(e + 1) % 3];
+
+            // Get the face on the other side of the edge
+            std::map<std::pair<uint, uint>, uint>::const_iterator it =
+                    mEdgesFaces.find(std::make_pair(v2, v1));
+            assert(it != mEdgesFaces.end());
+            HullFace& neighborFace = mFaces[it->second];
+            if (neighborFace.isDeleted) continue;
+
+            if (neighborFace.normal.dot(eye) - neighborFace.offset > mTolerance) {
+                neighborFace.isDeleted = true;
+                mVisibleFaces.push_back(it->second);
+            }
+            else {
+                mHorizonEdges.push_back(std::make_pair(v1, v2));
+            }
+        }
+    }
+}
+
+// Add an outside point into the hull
+/// The faces that are visible from the point must have been computed. They are removed
+/// from the hull and the horizon edges are connected to the new point with new faces.
+/**
+ * @param eyePoint Index of the point to add
+ * @param eyeFace Index of the face with the point in its outside points
+ */
+void QuickHull::addPointToHull(uint eyePoint, uint eyeFace) {
+
+    // If the face of the point has not been found by the search (only possible with
+    // almost degenerate faces), remove the point from its outside points
+    if (!mFaces[eyeFace].isDeleted) {
+        HullFace& face = mFaces[eyeFace];
+        face.outsidePoints.erase(std::find(face.outsidePoints.begin(), face.outsidePoints.end(), eyePoint));
+        face.furthestDistance = decimal(0.0);
+        for (uint i=0; i<face.outsidePoints.size(); i++) {
+            const decimal distance = face.normal.dot(mPoints[face.outsidePoints[i]]) - face.offset;
+            if (distance > face.furthestDistance) {
+                face.furthestDistance = distance;
+                face.furthestPoint = face.outsidePoints[i];
+            }
+        }
+        if (!face.outsidePoints.empty()) {
+            mFacesQueue.push(std::make_pair(face.furthestDistance, eyeFace));
+        }
+    }
+
+    // Remove the visible faces and keep their outside points. The removed faces are
+    // then reused for the new faces.
+    mOrphanPoints.clear();
+    for (uint i=0; i<mVisibleFaces.size(); i++) {
+        HullFace& face = mFaces[mVisibleFaces[i]];
+        for (int e=0; e<3; e++) {
+            mEdgesFaces.erase(std::make_pair(face.vertices[e], face.vertices[(e + 1) % 3]));
+        }
+        for (uint p=0; p<face.outsidePoints.size(); p++) {
+            if (face.outsidePoints[p] != eyePoint) mOrphanPoints.push_back(face.outsidePoints[p]);
+        }
+        face.outsidePoints.clear();
+        mFreeFaces.push_back(mVisibleFaces[i]);
+    }
+
+    // Connect the horizon edges to the new point
+    mNewFaces.clear();
+    for (uint i=0; i<mHorizonEdges.size(); i++) {
+        mNewFaces.push_back(createFace(mHorizonEdges[i].first, mHorizonEdges[i].second, eyePoint));
+    }
+
+    // A closed triangle mesh without holes has (nbFaces / 2 + 2) vertices
+    const uint nbFaces = static_cast<uint>(mEdgesFaces.size() / 3);
+    mNbHullVertices = nbFaces / 2 + 2;
+
+    assignOutsidePoints(mOrphanPoints, mNewFaces);
+}
+
+// Compute the vertices and triangles of the hull from its faces
+/// Only the points of the cloud that are used by a face become vertices of the hull.
+void QuickHull::computeHullMesh() {
+
+    const uint unusedPoint = static_cast<uint>(-1);
+    std::vector<uint> hullVertexIndices(mPoints.size(), unusedPoint);
+
+    for (uint f=0; f<mFaces.size(); f++) {
+
+        if (mFaces[f].isDeleted) continue;
+
+        for (int k=0; k<3; k++) {
+            const uint point = mFaces[f].vertices[k];
+            if (hullVertexIndices[point] == unusedPoint) {
+                hullVertexIndices[point] = static_cast<uint>(mHullVertices.size());
+                mHullVertices.push_back(mPoints[point]);
+            }
+            mHullTrianglesVertexIndices.push_back(hullVertexIndices[point]);
+        }
+    }
+}
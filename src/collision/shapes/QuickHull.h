@@ -0,0 +1,215 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_QUICK_HULL_H
+#define REACTPHYSICS3D_QUICK_HULL_H
+
+// Libraries
+#include "configuration.h"
+#include "mathematics/Vector3.h"
+#include <vector>
+#include <map>
+#include <queue>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Class QuickHull
+/**
+ * This class computes the convex hull of a cloud of points with the Quickhull
+ * algorithm. The hull starts as a tetrahedron made of extreme points. Then, the point
+ * that is the furthest in front of a face of the hull is added until no point is
+ * outside of the hull or until the hull has a given maximum number of vertices. In
+ * the latter case, the hull is a simplification inside the hull of all the points.
+ * The points that are closer than a welding distance to the hull are considered to
+ * be inside it. Therefore, points that are very close to each other or almost
+ * coplanar with a face do not create additional vertices. The result is a set of
+ * vertices and the triangles (with an outward counter-clockwise winding) that
+ * describe the surface of the hull.
+ */
+class QuickHull {
+
+    private :
+
+        // Structure HullFace
+        /**
+         * Triangular face of the hull during the construction with the points
+         * that are in front of it.
+         */
+        struct HullFace {
+
+            /// Indices of the three points of the face (counter-clockwise seen from outside)
+            uint vertices[3];
+
+            /// Outward unit normal of the face
+            Vector3 normal;
+
+            /// Distance of the plane of the face from the origin along the normal
+            decimal offset;
+
+            /// Points in front of the face that are not part of the hull yet
+            std::vector<uint> outsidePoints;
+
+            /// Index of the point of the outside points that is the furthest from the face
+            uint furthestPoint;
+
+            /// Distance of the furthest outside point from the face
+            decimal furthestDistance;
+
+            /// True if the face has been removed from the hull
+            bool isDeleted;
+        };
+
+        // -------------------- Attributes -------------------- //
+
+        /// Points of the cloud
+        std::vector<Vector3> mPoints;
+
+        /// Faces of the hull (including the removed ones)
+        std::vector<HullFace> mFaces;
+
+        /// Indices of the removed faces that can be reused for new faces
+        std::vector<uint> mFreeFaces;
+
+        /// Distance of the furthest outside point and index of each face with outside
+        /// points. The entries of the faces that have been removed or reused are skipped.
+        std::priority_queue<std::pair<decimal, uint> > mFacesQueue;
+
+        /// Face of each directed edge of the hull (the edges of a face are directed
+        /// counter-clockwise)
+        std::map<std::pair<uint, uint>, uint> mEdgesFaces;
+
+        /// Precision of the computations with the coordinates of the points. A face
+        /// can see a point if the point is further than this distance in front of it.
+        decimal mTolerance;
+
+        /// Distance under which a point is considered to be on the hull
+        decimal mWeldingDistance;
+
+        /// Number of points of the cloud that are vertices of the hull
+        uint mNbHullVertices;
+
+        /// Vertices of the computed hull
+        std::vector<Vector3> mHullVertices;
+
+        /// Three vertex indices for each triangle of the computed hull
+        std::vector<uint> mHullTrianglesVertexIndices;
+
+        /// Temporary arrays reused by each new vertex of the hull
+        std::vector<uint> mCandidates;
+        std::vector<uint> mCandidatesFaces;
+        std::vector<decimal> mProjections;
+        std::vector<uint> mVisibleFaces;
+        std::vector<std::pair<uint, uint> > mHorizonEdges;
+        std::vector<uint> mOrphanPoints;
+        std::vector<uint> mNewFaces;
+
+        // -------------------- Methods -------------------- //
+
+        /// Private copy-constructor
+        QuickHull(const QuickHull& quickHull);
+
+        /// Private assignment operator
+        QuickHull& operator=(const QuickHull& quickHull);
+
+        /// Create the initial tetrahedron of the hull
+        bool computeInitialTetrahedron();
+
+        /// Select the candidate point with the largest value
+        uint selectExtremePoint(const std::vector<uint>& candidates, const std::vector<decimal>& values,
+                                const Vector3& referencePoint, decimal& maxValue) const;
+
+        /// Create a new face of the hull and return its index
+        uint createFace(uint v0, uint v1, uint v2);
+
+        /// Assign some points to the outside points of the faces in front of which they are
+        void assignOutsidePoints(const std::vector<uint>& points, const std::vector<uint>& faces);
+
+        /// Return the index of the face with the point that is the furthest from the hull
+        bool findFurthestFace(uint& faceIndex);
+
+        /// Select the outside point to add into the hull from a face of the hull
+        uint selectEyePoint(uint faceIndex, uint& eyeFace);
+
+        /// Find the faces of the hull that are visible from a point and the horizon edges
+        void computeVisibleFaces(uint faceIndex, uint eyePoint);
+
+        /// Add an outside point into the hull
+        void addPointToHull(uint eyePoint, uint eyeFace);
+
+        /// Compute the vertices and triangles of the hull from its faces
+        void computeHullMesh();
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        QuickHull();
+
+        /// Destructor
+        ~QuickHull();
+
+        /// Compute the convex hull of a cloud of points
+        bool computeHull(const decimal* arrayPoints, uint nbPoints, int stride,
+                         uint maxNbVertices, decimal weldingDistance);
+
+        /// Return the number of vertices of the hull
+        uint getNbVertices() const;
+
+        /// Return a vertex of the hull
+        const Vector3& getVertex(uint vertexIndex) const;
+
+        /// Return the number of triangles of the hull
+        uint getNbTriangles() const;
+
+        /// Return the three vertex indices of each triangle of the hull
+        const std::vector<uint>& getTrianglesVertexIndices() const;
+};
+
+// Return the number of vertices of the hull
+inline uint QuickHull::getNbVertices() const {
+    return static_cast<uint>(mHullVertices.size());
+}
+
+// Return a vertex of the hull
+inline const Vector3& QuickHull::getVertex(uint vertexIndex) const {
+    assert(vertexIndex < mHullVertices.size());
+    return mHullVertices[vertexIndex];
+}
+
+// Return the number of triangles of the hull
+inline uint QuickHull::getNbTriangles() const {
+    return static_cast<uint>(mHullTrianglesVertexIndices.size() / 3);
+}
+
+// Return the three vertex indices of each triangle of the hull
+inline const std::vector<uint>& QuickHull::getTrianglesVertexIndices() const {
+    return mHullTrianglesVertexIndices;
+}
+
+}
+
+#endif
@@ -41,6 +41,13 @@
     #define LINUX_OS
 #endif
 
+// SSE instructions are used by some batch computations (only in single precision). Define
+// the REACTPHYSICS3D_NO_SIMD macro to always use the scalar code instead.
+#if !defined(IS_DOUBLE_PRECISION_ENABLED) && !defined(REACTPHYSICS3D_NO_SIMD) && \
+    (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+    #define REACTPHYSICS3D_SSE_ENABLED
+#endif
+
 /// Namespace reactphysics3d
 namespace reactphysics3d {
 
@@ -71,6 +78,15 @@ enum JointsPositionCorrectionTechnique {BAUMGARTE_JOINTS, NON_LINEAR_GAUSS_SEIDE
 ///                 bodies momentum. This is the option used by default.
 enum ContactsPositionCorrectionTechnique {BAUMGARTE_CONTACTS, SPLIT_IMPULSES};
 
+/// Algorithm used by the broad-phase collision detection
+/// DYNAMIC_AABB_TREE : Dynamic AABB trees. Good for all kind of worlds. This is the
+///                     option used by default.
+/// SWEEP_AND_PRUNE : Sorted lists of AABBs. Can be faster for worlds made of many
+///                   shapes of similar sizes spread along a plane or an axis.
+/// SPATIAL_HASH : Hashed uniform grid. Can be faster for very large worlds made of
+///                many small shapes (compared to the size of the cells) spread uniformly.
+enum BroadPhaseType {DYNAMIC_AABB_TREE, SWEEP_AND_PRUNE, SPATIAL_HASH};
+
 // ------------------- Constants ------------------- //
 
 /// Smallest decimal value (negative)
@@ -109,6 +125,11 @@ const decimal PERSISTENT_CONTACT_DIST_THRESHOLD = decimal(0.03);
 /// Velocity threshold for contact velocity restitution
 const decimal RESTITUTION_VELOCITY_THRESHOLD = decimal(1.0);
 
+/// Penetration depth (in meters) of the collision shapes with their margins when the
+/// continuous collision detection stops a body at its time of impact (the contact is
+/// then found by the discrete collision detection of the next step)
+const decimal CCD_TARGET_PENETRATION_DEPTH = decimal(0.01);
+
 /// Number of iterations when solving the velocity constraints of the Sequential Impulse technique
 const uint DEFAULT_VELOCITY_SOLVER_NB_ITERATIONS = 10;
 
@@ -134,8 +155,41 @@ const decimal DYNAMIC_TREE_AABB_GAP = decimal(0.1);
 /// In the broad-phase collision detection (dynamic AABB tree), the AABBs are
 /// also inflated in direction of the linear motion of the body by mutliplying the
 /// followin constant with the linear velocity and the elapsed time between two frames.
+/// This is the initial value of the adaptive number of steps of motion predicted
+/// by the fat AABB of a moving collision shape.
 const decimal DYNAMIC_TREE_AABB_LIN_GAP_MULTIPLIER = decimal(1.7);
 
+/// In the broad-phase collision detection, the number of steps of motion predicted
+/// by the fat AABB of a moving collision shape is doubled when the shape leaves its
+/// fat AABB before this number of steps and halved when it stays inside it for more
+/// than four times this number of steps
+const uint FAT_AABB_TARGET_NB_STEPS = 8;
+
+/// Minimum number of steps of motion predicted by the fat AABB of a moving shape
+const decimal FAT_AABB_MIN_PREDICTION_STEPS = decimal(1.0);
+
+/// Maximum number of steps of motion predicted by the fat AABB of a moving shape
+const decimal FAT_AABB_MAX_PREDICTION_STEPS = decimal(32.0);
+
+/// Smallest constant gap of the fat AABB of a slowly moving collision shape (the gap
+/// grows with the speed of the shape up to DYNAMIC_TREE_AABB_GAP)
+const decimal FAT_AABB_MIN_GAP = decimal(0.04);
+
+/// In the broad-phase collision detection, the AABB tree of the static bodies is
+/// built again top-down when the number of static collision shapes that have been
+/// added, removed or moved since its last build is larger than this fraction of
+/// the number of static collision shapes
+const decimal STATIC_TREE_REBUILD_RATIO = decimal(0.1);
+
+/// Default size of the cells of the grid of the spatial hash broad-phase. The cells
+/// should be larger than most of the collision shapes of the world.
+const decimal DEFAULT_SPATIAL_HASH_CELL_SIZE = decimal(4.0);
+
+/// The support vertex of a convex mesh with at most this number of vertices is found by
+/// testing all its vertices (with SIMD instructions if available) even if the edges
+/// information of the mesh is used. The hill-climbing is faster for larger meshes.
+const uint CONVEX_MESH_MAX_NB_VERTICES_BRUTE_FORCE_SUPPORT = 64;
+
 /// Maximum number of contact manifolds in an overlapping pair that involves two
 /// convex collision shapes.
 const int NB_MAX_CONTACT_MANIFOLDS_CONVEX_SHAPE = 1;
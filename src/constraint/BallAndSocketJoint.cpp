@@ -50,8 +50,8 @@ BallAndSocketJoint::~BallAndSocketJoint() {
 void BallAndSocketJoint::initBeforeSolve(const ConstraintSolverData& constraintSolverData) {
 
     // Initialize the bodies index in the velocity array
-    mIndexBody1 = constraintSolverData.mapBodyToConstrainedVelocityIndex.find(mBody1)->second;
-    mIndexBody2 = constraintSolverData.mapBodyToConstrainedVelocityIndex.find(mBody2)->second;
+    mIndexBody1 = mBody1->mArrayIndex;
+    mIndexBody2 = mBody2->mArrayIndex;
 
     // Get the bodies center of mass and orientations
     const Vector3& x1 = mBody1->mCenterOfMassWorld;
@@ -114,15 +114,19 @@ void BallAndSocketJoint::warmstart(const ConstraintSolverData& constraintSolverD
     const Vector3 angularImpulseBody1 = mImpulse.cross(mR1World);
 
     // Apply the impulse to the body 1
-    v1 += mBody1->mMassInverse * linearImpulseBody1;
-    w1 += mI1 * angularImpulseBody1;
+    if (mBody1->getType() == DYNAMIC) {
+        v1 += mBody1->mMassInverse * linearImpulseBody1;
+        w1 += mI1 * angularImpulseBody1;
+    }
 
     // Compute the impulse P=J^T * lambda for the body 2
     const Vector3 angularImpulseBody2 = -mImpulse.cross(mR2World);
 
     // Apply the impulse to the body to the body 2
-    v2 += mBody2->mMassInverse * mImpulse;
-    w2 += mI2 * angularImpulseBody2;
+    if (mBody2->getType() == DYNAMIC) {
+        v2 += mBody2->mMassInverse * mImpulse;
+        w2 += mI2 * angularImpulseBody2;
+    }
 }
 
 // Solve the velocity constraint
@@ -146,15 +150,19 @@ void BallAndSocketJoint::solveVelocityConstraint(const ConstraintSolverData& con
     const Vector3 angularImpulseBody1 = deltaLambda.cross(mR1World);
 
     // Apply the impulse to the body 1
-    v1 += mBody1->mMassInverse * linearImpulseBody1;
-    w1 += mI1 * angularImpulseBody1;
+    if (mBody1->getType() == DYNAMIC) {
+        v1 += mBody1->mMassInverse * linearImpulseBody1;
+        w1 += mI1 * angularImpulseBody1;
+    }
 
     // Compute the impulse P=J^T * lambda for the body 2
     const Vector3 angularImpulseBody2 = -deltaLambda.cross(mR2World);
 
     // Apply the impulse to the body 2
-    v2 += mBody2->mMassInverse * deltaLambda;
-    w2 += mI2 * angularImpulseBody2;
+    if (mBody2->getType() == DYNAMIC) {
+        v2 += mBody2->mMassInverse * deltaLambda;
+        w2 += mI2 * angularImpulseBody2;
+    }
 }
 
 // Solve the position constraint (for position error correction)
@@ -215,9 +223,11 @@ void BallAndSocketJoint::solvePositionConstraint(const ConstraintSolverData& con
     const Vector3 w1 = mI1 * angularImpulseBody1;
 
     // Update the body center of mass and orientation of body 1
-    x1 += v1;
-    q1 += Quaternion(0, w1) * q1 * decimal(0.5);
-    q1.normalize();
+    if (mBody1->getType() == DYNAMIC) {
+        x1 += v1;
+        q1 += Quaternion(0, w1) * q1 * decimal(0.5);
+        q1.normalize();
+    }
 
     // Compute the impulse of body 2
     const Vector3 angularImpulseBody2 = -lambda.cross(mR2World);
@@ -227,8 +237,10 @@ void BallAndSocketJoint::solvePositionConstraint(const ConstraintSolverData& con
     const Vector3 w2 = mI2 * angularImpulseBody2;
 
     // Update the body position/orientation of body 2
-    x2 += v2;
-    q2 += Quaternion(0, w2) * q2 * decimal(0.5);
-    q2.normalize();
+    if (mBody2->getType() == DYNAMIC) {
+        x2 += v2;
+        q2 += Quaternion(0, w2) * q2 * decimal(0.5);
+        q2.normalize();
+    }
 }
 
@@ -43,7 +43,7 @@ ContactPoint::ContactPoint(const ContactPointInfo& contactInfo)
                mWorldPointOnBody2(contactInfo.shape2->getBody()->getTransform() *
                                   contactInfo.shape2->getLocalToBodyTransform() *
                                   contactInfo.localPoint2),
-               mIsRestingContact(false) {
+               mFeatureId(contactInfo.featureId), mIsRestingContact(false), mIsObsolete(false) {
 
     mFrictionVectors[0] = Vector3(0, 0, 0);
     mFrictionVectors[1] = Vector3(0, 0, 0);
@@ -36,6 +36,39 @@
 /// ReactPhysics3D namespace
 namespace reactphysics3d {
 
+/// Type of a feature of a collision shape that generates a contact point
+enum ContactFeatureType {CONTACT_FEATURE_VERTEX, CONTACT_FEATURE_EDGE, CONTACT_FEATURE_FACE};
+
+/// Feature identifier of a contact point computed without feature information
+const uint NO_CONTACT_FEATURE_ID = 0;
+
+// Return the feature identifier of a contact point between two features of the shapes
+/// A narrow-phase algorithm gives the same identifier to the contact points that are
+/// generated by the same pair of features (vertex, edge or face) of the two shapes at
+/// consecutive frames even if the shapes slide against each other. The type and the
+/// index of the two features are hashed into an identifier that is never equal to
+/// NO_CONTACT_FEATURE_ID. Two different pairs of features have different identifiers
+/// with a very high probability.
+/**
+ * @param type1 Type of the feature of the first shape
+ * @param index1 Index of the feature of the first shape
+ * @param type2 Type of the feature of the second shape
+ * @param index2 Index of the feature of the second shape
+ * @return Feature identifier of the contact point
+ */
+inline uint computeContactFeatureId(ContactFeatureType type1, uint index1,
+                                    ContactFeatureType type2, uint index2) {
+
+    // FNV-1a hash of the four values
+    const uint values[4] = {static_cast<uint>(type1), index1, static_cast<uint>(type2), index2};
+    uint hash = 2166136261u;
+    for (int i=0; i<4; i++) {
+        hash = (hash ^ values[i]) * 16777619u;
+    }
+
+    return hash != NO_CONTACT_FEATURE_ID ? hash : 1;
+}
+
 // Structure ContactPointInfo
 /**
  * This structure contains informations about a collision contact
@@ -77,6 +110,10 @@ struct ContactPointInfo {
         /// Contact point of body 2 in local space of body 2
         Vector3 localPoint2;
 
+        /// Identifier of the features of the shapes that generate the contact
+        /// (NO_CONTACT_FEATURE_ID if the narrow-phase algorithm does not compute it)
+        uint featureId;
+
         // -------------------- Methods -------------------- //
 
         /// Constructor
@@ -85,7 +122,7 @@ struct ContactPointInfo {
                          const Vector3& localPoint1, const Vector3& localPoint2)
             : shape1(proxyShape1), shape2(proxyShape2), collisionShape1(collShape1), collisionShape2(collShape2),
               normal(normal), penetrationDepth(penetrationDepth), localPoint1(localPoint1),
-              localPoint2(localPoint2) {
+              localPoint2(localPoint2), featureId(NO_CONTACT_FEATURE_ID) {
 
         }
 };
@@ -125,9 +162,16 @@ class ContactPoint {
         /// Contact point on body 2 in world space
         Vector3 mWorldPointOnBody2;
 
+        /// Identifier of the features of the shapes that generate the contact
+        const uint mFeatureId;
+
         /// True if the contact is a resting contact (exists for more than one time step)
         bool mIsRestingContact;
 
+        /// True if the contact has not been generated again by the narrow-phase since the
+        /// last update of its contact manifold (only used for the contacts with a feature id)
+        bool mIsObsolete;
+
         /// Two orthogonal vectors that span the tangential friction plane
         Vector3 mFrictionVectors[2];
 
@@ -185,6 +229,9 @@ class ContactPoint {
         /// Return the contact world point on body 2
         Vector3 getWorldPointOnBody2() const;
 
+        /// Return the identifier of the features of the shapes that generate the contact
+        uint getFeatureId() const;
+
         /// Return the cached penetration impulse
         decimal getPenetrationImpulse() const;
 
@@ -221,6 +268,16 @@ class ContactPoint {
         /// Set the mIsRestingContact variable
         void setIsRestingContact(bool isRestingContact);
 
+        /// Return true if the contact has not been generated again since the last update
+        bool getIsObsolete() const;
+
+        /// Set the mIsObsolete variable
+        void setIsObsolete(bool isObsolete);
+
+        /// Copy the cached impulses and friction vectors of another contact between
+        /// the same features
+        void setCachedImpulses(const ContactPoint& contact);
+
         /// Get the first friction vector
         Vector3 getFrictionVector1() const;
 
@@ -280,6 +337,11 @@ inline Vector3 ContactPoint::getWorldPointOnBody2() const {
     return mWorldPointOnBody2;
 }
 
+// Return the identifier of the features of the shapes that generate the contact
+inline uint ContactPoint::getFeatureId() const {
+    return mFeatureId;
+}
+
 // Return the cached penetration impulse
 inline decimal ContactPoint::getPenetrationImpulse() const {
     return mPenetrationImpulse;
@@ -340,6 +402,29 @@ inline void ContactPoint::setIsRestingContact(bool isRestingContact) {
     mIsRestingContact = isRestingContact;
 }
 
+// Return true if the contact has not been generated again since the last update
+inline bool ContactPoint::getIsObsolete() const {
+    return mIsObsolete;
+}
+
+// Set the mIsObsolete variable
+inline void ContactPoint::setIsObsolete(bool isObsolete) {
+    mIsObsolete = isObsolete;
+}
+
+// Copy the cached impulses and friction vectors of another contact between the same features
+/// The contact is warm-started with the impulses of the previous contact. The friction
+/// vectors are needed to project the cached friction impulses on the new friction vectors.
+inline void ContactPoint::setCachedImpulses(const ContactPoint& contact) {
+    mIsRestingContact = contact.mIsRestingContact;
+    mPenetrationImpulse = contact.mPenetrationImpulse;
+    mFrictionImpulse1 = contact.mFrictionImpulse1;
+    mFrictionImpulse2 = contact.mFrictionImpulse2;
+    mRollingResistanceImpulse = contact.mRollingResistanceImpulse;
+    mFrictionVectors[0] = contact.mFrictionVectors[0];
+    mFrictionVectors[1] = contact.mFrictionVectors[1];
+}
+
 // Get the first friction vector
 inline Vector3 ContactPoint::getFrictionVector1() const {
     return mFrictionVectors[0];
@@ -65,8 +65,8 @@ FixedJoint::~FixedJoint() {
 void FixedJoint::initBeforeSolve(const ConstraintSolverData& constraintSolverData) {
 
     // Initialize the bodies index in the velocity array
-    mIndexBody1 = constraintSolverData.mapBodyToConstrainedVelocityIndex.find(mBody1)->second;
-    mIndexBody2 = constraintSolverData.mapBodyToConstrainedVelocityIndex.find(mBody2)->second;
+    mIndexBody1 = mBody1->mArrayIndex;
+    mIndexBody2 = mBody2->mArrayIndex;
 
     // Get the bodies positions and orientations
     const Vector3& x1 = mBody1->mCenterOfMassWorld;
@@ -151,8 +151,10 @@ void FixedJoint::warmstart(const ConstraintSolverData& constraintSolverData) {
     angularImpulseBody1 += -mImpulseRotation;
 
     // Apply the impulse to the body 1
-    v1 += inverseMassBody1 * linearImpulseBody1;
-    w1 += mI1 * angularImpulseBody1;
+    if (mBody1->getType() == DYNAMIC) {
+        v1 += inverseMassBody1 * linearImpulseBody1;
+        w1 += mI1 * angularImpulseBody1;
+    }
 
     // Compute the impulse P=J^T * lambda for the 3 translation constraints for body 2
     Vector3 angularImpulseBody2 = -mImpulseTranslation.cross(mR2World);
@@ -161,8 +163,10 @@ void FixedJoint::warmstart(const ConstraintSolverData& constraintSolverData) {
     angularImpulseBody2 += mImpulseRotation;
 
     // Apply the impulse to the body 2
-    v2 += inverseMassBody2 * mImpulseTranslation;
-    w2 += mI2 * angularImpulseBody2;
+    if (mBody2->getType() == DYNAMIC) {
+        v2 += inverseMassBody2 * mImpulseTranslation;
+        w2 += mI2 * angularImpulseBody2;
+    }
 }
 
 // Solve the velocity constraint
@@ -193,15 +197,19 @@ void FixedJoint::solveVelocityConstraint(const ConstraintSolverData& constraintS
     Vector3 angularImpulseBody1 = deltaLambda.cross(mR1World);
 
     // Apply the impulse to the body 1
-    v1 += inverseMassBody1 * linearImpulseBody1;
-    w1 += mI1 * angularImpulseBody1;
+    if (mBody1->getType() == DYNAMIC) {
+        v1 += inverseMassBody1 * linearImpulseBody1;
+        w1 += mI1 * angularImpulseBody1;
+    }
 
     // Compute the impulse P=J^T * lambda  for body 2
     const Vector3 angularImpulseBody2 = -deltaLambda.cross(mR2World);
 
     // Apply the impulse to the body 2
-    v2 += inverseMassBody2 * deltaLambda;
-    w2 += mI2 * angularImpulseBody2;
+    if (mBody2->getType() == DYNAMIC) {
+        v2 += inverseMassBody2 * deltaLambda;
+        w2 += mI2 * angularImpulseBody2;
+    }
 
     // --------------- Rotation Constraints --------------- //
 
@@ -216,10 +224,14 @@ void FixedJoint::solveVelocityConstraint(const ConstraintSolverData& constraintS
     angularImpulseBody1 = -deltaLambda2;
 
     // Apply the impulse to the body 1
-    w1 += mI1 * angularImpulseBody1;
+    if (mBody1->getType() == DYNAMIC) {
+        w1 += mI1 * angularImpulseBody1;
+    }
 
     // Apply the impulse to the body 2
-    w2 += mI2 * deltaLambda2;
+    if (mBody2->getType() == DYNAMIC) {
+        w2 += mI2 * deltaLambda2;
+    }
 }
 
 // Solve the position constraint (for position error correction)
@@ -280,9 +292,11 @@ void FixedJoint::solvePositionConstraint(const ConstraintSolverData& constraintS
     Vector3 w1 = mI1 * angularImpulseBody1;
 
     // Update the body position/orientation of body 1
-    x1 += v1;
-    q1 += Quaternion(0, w1) * q1 * decimal(0.5);
-    q1.normalize();
+    if (mBody1->getType() == DYNAMIC) {
+        x1 += v1;
+        q1 += Quaternion(0, w1) * q1 * decimal(0.5);
+        q1.normalize();
+    }
 
     // Compute the impulse of body 2
     Vector3 angularImpulseBody2 = -lambdaTranslation.cross(mR2World);
@@ -292,9 +306,11 @@ void FixedJoint::solvePositionConstraint(const ConstraintSolverData& constraintS
     Vector3 w2 = mI2 * angularImpulseBody2;
 
     // Update the body position/orientation of body 2
-    x2 += v2;
-    q2 += Quaternion(0, w2) * q2 * decimal(0.5);
-    q2.normalize();
+    if (mBody2->getType() == DYNAMIC) {
+        x2 += v2;
+        q2 += Quaternion(0, w2) * q2 * decimal(0.5);
+        q2.normalize();
+    }
 
     // --------------- Rotation Constraints --------------- //
 
@@ -343,14 +359,18 @@ void FixedJoint::solvePositionConstraint(const ConstraintSolverData& constraintS
     w1 = mI1 * angularImpulseBody1;
 
     // Update the body position/orientation of body 1
-    q1 += Quaternion(0, w1) * q1 * decimal(0.5);
-    q1.normalize();
+    if (mBody1->getType() == DYNAMIC) {
+        q1 += Quaternion(0, w1) * q1 * decimal(0.5);
+        q1.normalize();
+    }
 
     // Compute the pseudo velocity of body 2
     w2 = mI2 * lambdaRotation;
 
     // Update the body position/orientation of body 2
-    q2 += Quaternion(0, w2) * q2 * decimal(0.5);
-    q2.normalize();
+    if (mBody2->getType() == DYNAMIC) {
+        q2 += Quaternion(0, w2) * q2 * decimal(0.5);
+        q2.normalize();
+    }
 }
 
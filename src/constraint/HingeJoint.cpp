@@ -73,8 +73,8 @@ HingeJoint::~HingeJoint() {
 void HingeJoint::initBeforeSolve(const ConstraintSolverData& constraintSolverData) {
 
     // Initialize the bodies index in the velocity array
-    mIndexBody1 = constraintSolverData.mapBodyToConstrainedVelocityIndex.find(mBody1)->second;
-    mIndexBody2 = constraintSolverData.mapBodyToConstrainedVelocityIndex.find(mBody2)->second;
+    mIndexBody1 = mBody1->mArrayIndex;
+    mIndexBody2 = mBody2->mArrayIndex;
 
     // Get the bodies positions and orientations
     const Vector3& x1 = mBody1->mCenterOfMassWorld;
@@ -237,8 +237,10 @@ void HingeJoint::warmstart(const ConstraintSolverData& constraintSolverData) {
     angularImpulseBody1 += motorImpulse;
 
     // Apply the impulse to the body 1
-    v1 += inverseMassBody1 * linearImpulseBody1;
-    w1 += mI1 * angularImpulseBody1;
+    if (mBody1->getType() == DYNAMIC) {
+        v1 += inverseMassBody1 * linearImpulseBody1;
+        w1 += mI1 * angularImpulseBody1;
+    }
 
     // Compute the impulse P=J^T * lambda for the 3 translation constraints of body 2
     Vector3 angularImpulseBody2 = -mImpulseTranslation.cross(mR2World);
@@ -253,8 +255,10 @@ void HingeJoint::warmstart(const ConstraintSolverData& constraintSolverData) {
     angularImpulseBody2 += -motorImpulse;
 
     // Apply the impulse to the body 2
-    v2 += inverseMassBody2 * mImpulseTranslation;
-    w2 += mI2 * angularImpulseBody2;
+    if (mBody2->getType() == DYNAMIC) {
+        v2 += inverseMassBody2 * mImpulseTranslation;
+        w2 += mI2 * angularImpulseBody2;
+    }
 }
 
 // Solve the velocity constraint
@@ -285,15 +289,19 @@ void HingeJoint::solveVelocityConstraint(const ConstraintSolverData& constraintS
     Vector3 angularImpulseBody1 = deltaLambdaTranslation.cross(mR1World);
 
     // Apply the impulse to the body 1
-    v1 += inverseMassBody1 * linearImpulseBody1;
-    w1 += mI1 * angularImpulseBody1;
+    if (mBody1->getType() == DYNAMIC) {
+        v1 += inverseMassBody1 * linearImpulseBody1;
+        w1 += mI1 * angularImpulseBody1;
+    }
 
     // Compute the impulse P=J^T * lambda of body 2
     Vector3 angularImpulseBody2 = -deltaLambdaTranslation.cross(mR2World);
 
     // Apply the impulse to the body 2
-    v2 += inverseMassBody2 * deltaLambdaTranslation;
-    w2 += mI2 * angularImpulseBody2;
+    if (mBody2->getType() == DYNAMIC) {
+        v2 += inverseMassBody2 * deltaLambdaTranslation;
+        w2 += mI2 * angularImpulseBody2;
+    }
 
     // --------------- Rotation Constraints --------------- //
 
@@ -310,14 +318,18 @@ void HingeJoint::solveVelocityConstraint(const ConstraintSolverData& constraintS
                                         mC2CrossA1 * deltaLambdaRotation.y;
 
     // Apply the impulse to the body 1
-    w1 += mI1 * angularImpulseBody1;
+    if (mBody1->getType() == DYNAMIC) {
+        w1 += mI1 * angularImpulseBody1;
+    }
 
     // Compute the impulse P=J^T * lambda for the 2 rotation constraints of body 2
     angularImpulseBody2 = mB2CrossA1 * deltaLambdaRotation.x +
             mC2CrossA1 * deltaLambdaRotation.y;
 
     // Apply the impulse to the body 2
-    w2 += mI2 * angularImpulseBody2;
+    if (mBody2->getType() == DYNAMIC) {
+        w2 += mI2 * angularImpulseBody2;
+    }
 
     // --------------- Limits Constraints --------------- //
 
@@ -339,13 +351,17 @@ void HingeJoint::solveVelocityConstraint(const ConstraintSolverData& constraintS
             const Vector3 angularImpulseBody1 = -deltaLambdaLower * mA1;
 
             // Apply the impulse to the body 1
-            w1 += mI1 * angularImpulseBody1;
+            if (mBody1->getType() == DYNAMIC) {
+                w1 += mI1 * angularImpulseBody1;
+            }
 
             // Compute the impulse P=J^T * lambda for the lower limit constraint of body 2
             const Vector3 angularImpulseBody2 = deltaLambdaLower * mA1;
 
             // Apply the impulse to the body 2
-            w2 += mI2 * angularImpulseBody2;
+            if (mBody2->getType() == DYNAMIC) {
+                w2 += mI2 * angularImpulseBody2;
+            }
         }
 
         // If the upper limit is violated
@@ -364,13 +380,17 @@ void HingeJoint::solveVelocityConstraint(const ConstraintSolverData& constraintS
             const Vector3 angularImpulseBody1 = deltaLambdaUpper * mA1;
 
             // Apply the impulse to the body 1
-            w1 += mI1 * angularImpulseBody1;
+            if (mBody1->getType() == DYNAMIC) {
+                w1 += mI1 * angularImpulseBody1;
+            }
 
             // Compute the impulse P=J^T * lambda for the upper limit constraint of body 2
             const Vector3 angularImpulseBody2 = -deltaLambdaUpper * mA1;
 
             // Apply the impulse to the body 2
-            w2 += mI2 * angularImpulseBody2;
+            if (mBody2->getType() == DYNAMIC) {
+                w2 += mI2 * angularImpulseBody2;
+            }
         }
     }
 
@@ -393,13 +413,17 @@ void HingeJoint::solveVelocityConstraint(const ConstraintSolverData& constraintS
         const Vector3 angularImpulseBody1 = -deltaLambdaMotor * mA1;
 
         // Apply the impulse to the body 1
-        w1 += mI1 * angularImpulseBody1;
+        if (mBody1->getType() == DYNAMIC) {
+            w1 += mI1 * angularImpulseBody1;
+        }
 
         // Compute the impulse P=J^T * lambda for the motor of body 2
         const Vector3 angularImpulseBody2 = deltaLambdaMotor * mA1;
 
         // Apply the impulse to the body 2
-        w2 += mI2 * angularImpulseBody2;
+        if (mBody2->getType() == DYNAMIC) {
+            w2 += mI2 * angularImpulseBody2;
+        }
     }
 }
 
@@ -480,9 +504,11 @@ void HingeJoint::solvePositionConstraint(const ConstraintSolverData& constraintS
     Vector3 w1 = mI1 * angularImpulseBody1;
 
     // Update the body position/orientation of body 1
-    x1 += v1;
-    q1 += Quaternion(0, w1) * q1 * decimal(0.5);
-    q1.normalize();
+    if (mBody1->getType() == DYNAMIC) {
+        x1 += v1;
+        q1 += Quaternion(0, w1) * q1 * decimal(0.5);
+        q1.normalize();
+    }
 
     // Compute the impulse of body 2
     Vector3 angularImpulseBody2 = -lambdaTranslation.cross(mR2World);
@@ -492,9 +518,11 @@ void HingeJoint::solvePositionConstraint(const ConstraintSolverData& constraintS
     Vector3 w2 = mI2 * angularImpulseBody2;
 
     // Update the body position/orientation of body 2
-    x2 += v2;
-    q2 += Quaternion(0, w2) * q2 * decimal(0.5);
-    q2.normalize();
+    if (mBody2->getType() == DYNAMIC) {
+        x2 += v2;
+        q2 += Quaternion(0, w2) * q2 * decimal(0.5);
+        q2.normalize();
+    }
 
     // --------------- Rotation Constraints --------------- //
 
@@ -530,8 +558,10 @@ void HingeJoint::solvePositionConstraint(const ConstraintSolverData& constraintS
     w1 = mI1 * angularImpulseBody1;
 
     // Update the body position/orientation of body 1
-    q1 += Quaternion(0, w1) * q1 * decimal(0.5);
-    q1.normalize();
+    if (mBody1->getType() == DYNAMIC) {
+        q1 += Quaternion(0, w1) * q1 * decimal(0.5);
+        q1.normalize();
+    }
 
     // Compute the impulse of body 2
     angularImpulseBody2 = mB2CrossA1 * lambdaRotation.x + mC2CrossA1 * lambdaRotation.y;
@@ -540,8 +570,10 @@ void HingeJoint::solvePositionConstraint(const ConstraintSolverData& constraintS
     w2 = mI2 * angularImpulseBody2;
 
     // Update the body position/orientation of body 2
-    q2 += Quaternion(0, w2) * q2 * decimal(0.5);
-    q2.normalize();
+    if (mBody2->getType() == DYNAMIC) {
+        q2 += Quaternion(0, w2) * q2 * decimal(0.5);
+        q2.normalize();
+    }
 
     // --------------- Limits Constraints --------------- //
 
@@ -568,8 +600,10 @@ void HingeJoint::solvePositionConstraint(const ConstraintSolverData& constraintS
             const Vector3 w1 = mI1 * angularImpulseBody1;
 
             // Update the body position/orientation of body 1
-            q1 += Quaternion(0, w1) * q1 * decimal(0.5);
-            q1.normalize();
+            if (mBody1->getType() == DYNAMIC) {
+                q1 += Quaternion(0, w1) * q1 * decimal(0.5);
+                q1.normalize();
+            }
 
             // Compute the impulse P=J^T * lambda of body 2
             const Vector3 angularImpulseBody2 = lambdaLowerLimit * mA1;
@@ -578,8 +612,10 @@ void HingeJoint::solvePositionConstraint(const ConstraintSolverData& constraintS
             const Vector3 w2 = mI2 * angularImpulseBody2;
 
             // Update the body position/orientation of body 2
-            q2 += Quaternion(0, w2) * q2 * decimal(0.5);
-            q2.normalize();
+            if (mBody2->getType() == DYNAMIC) {
+                q2 += Quaternion(0, w2) * q2 * decimal(0.5);
+                q2.normalize();
+            }
         }
 
         // If the upper limit is violated
@@ -595,8 +631,10 @@ void HingeJoint::solvePositionConstraint(const ConstraintSolverData& constraintS
             const Vector3 w1 = mI1 * angularImpulseBody1;
 
             // Update the body position/orientation of body 1
-            q1 += Quaternion(0, w1) * q1 * decimal(0.5);
-            q1.normalize();
+            if (mBody1->getType() == DYNAMIC) {
+                q1 += Quaternion(0, w1) * q1 * decimal(0.5);
+                q1.normalize();
+            }
 
             // Compute the impulse P=J^T * lambda of body 2
             const Vector3 angularImpulseBody2 = -lambdaUpperLimit * mA1;
@@ -605,8 +643,10 @@ void HingeJoint::solvePositionConstraint(const ConstraintSolverData& constraintS
             const Vector3 w2 = mI2 * angularImpulseBody2;
 
             // Update the body position/orientation of body 2
-            q2 += Quaternion(0, w2) * q2 * decimal(0.5);
-            q2.normalize();
+            if (mBody2->getType() == DYNAMIC) {
+                q2 += Quaternion(0, w2) * q2 * decimal(0.5);
+                q2.normalize();
+            }
         }
     }
 }
@@ -79,8 +79,8 @@ SliderJoint::~SliderJoint() {
 void SliderJoint::initBeforeSolve(const ConstraintSolverData& constraintSolverData) {
 
     // Initialize the bodies index in the veloc ity array
-    mIndexBody1 = constraintSolverData.mapBodyToConstrainedVelocityIndex.find(mBody1)->second;
-    mIndexBody2 = constraintSolverData.mapBodyToConstrainedVelocityIndex.find(mBody2)->second;
+    mIndexBody1 = mBody1->mArrayIndex;
+    mIndexBody2 = mBody2->mArrayIndex;
 
     // Get the bodies positions and orientations
     const Vector3& x1 = mBody1->mCenterOfMassWorld;
@@ -253,8 +253,10 @@ void SliderJoint::warmstart(const ConstraintSolverData& constraintSolverData) {
     linearImpulseBody1 += impulseMotor;
 
     // Apply the impulse to the body 1
-    v1 += inverseMassBody1 * linearImpulseBody1;
-    w1 += mI1 * angularImpulseBody1;
+    if (mBody1->getType() == DYNAMIC) {
+        v1 += inverseMassBody1 * linearImpulseBody1;
+        w1 += mI1 * angularImpulseBody1;
+    }
 
     // Compute the impulse P=J^T * lambda for the 2 translation constraints of body 2
     Vector3 linearImpulseBody2 = mN1 * mImpulseTranslation.x + mN2 * mImpulseTranslation.y;
@@ -272,8 +274,10 @@ void SliderJoint::warmstart(const ConstraintSolverData& constraintSolverData) {
     linearImpulseBody2 += -impulseMotor;
 
     // Apply the impulse to the body 2
-    v2 += inverseMassBody2 * linearImpulseBody2;
-    w2 += mI2 * angularImpulseBody2;
+    if (mBody2->getType() == DYNAMIC) {
+        v2 += inverseMassBody2 * linearImpulseBody2;
+        w2 += mI2 * angularImpulseBody2;
+    }
 }
 
 // Solve the velocity constraint
@@ -308,16 +312,20 @@ void SliderJoint::solveVelocityConstraint(const ConstraintSolverData& constraint
             mR1PlusUCrossN2 * deltaLambda.y;
 
     // Apply the impulse to the body 1
-    v1 += inverseMassBody1 * linearImpulseBody1;
-    w1 += mI1 * angularImpulseBody1;
+    if (mBody1->getType() == DYNAMIC) {
+        v1 += inverseMassBody1 * linearImpulseBody1;
+        w1 += mI1 * angularImpulseBody1;
+    }
 
     // Compute the impulse P=J^T * lambda for the 2 translation constraints of body 2
     const Vector3 linearImpulseBody2 = mN1 * deltaLambda.x + mN2 * deltaLambda.y;
     Vector3 angularImpulseBody2 = mR2CrossN1 * deltaLambda.x + mR2CrossN2 * deltaLambda.y;
 
     // Apply the impulse to the body 2
-    v2 += inverseMassBody2 * linearImpulseBody2;
-    w2 += mI2 * angularImpulseBody2;
+    if (mBody2->getType() == DYNAMIC) {
+        v2 += inverseMassBody2 * linearImpulseBody2;
+        w2 += mI2 * angularImpulseBody2;
+    }
 
     // --------------- Rotation Constraints --------------- //
 
@@ -332,13 +340,17 @@ void SliderJoint::solveVelocityConstraint(const ConstraintSolverData& constraint
     angularImpulseBody1 = -deltaLambda2;
 
     // Apply the impulse to the body to body 1
-    w1 += mI1 * angularImpulseBody1;
+    if (mBody1->getType() == DYNAMIC) {
+        w1 += mI1 * angularImpulseBody1;
+    }
 
     // Compute the impulse P=J^T * lambda for the 3 rotation constraints of body 2
     angularImpulseBody2 = deltaLambda2;
 
     // Apply the impulse to the body 2
-    w2 += mI2 * angularImpulseBody2;
+    if (mBody2->getType() == DYNAMIC) {
+        w2 += mI2 * angularImpulseBody2;
+    }
 
     // --------------- Limits Constraints --------------- //
 
@@ -362,16 +374,20 @@ void SliderJoint::solveVelocityConstraint(const ConstraintSolverData& constraint
             const Vector3 angularImpulseBody1 = -deltaLambdaLower * mR1PlusUCrossSliderAxis;
 
             // Apply the impulse to the body 1
-            v1 += inverseMassBody1 * linearImpulseBody1;
-            w1 += mI1 * angularImpulseBody1;
+            if (mBody1->getType() == DYNAMIC) {
+                v1 += inverseMassBody1 * linearImpulseBody1;
+                w1 += mI1 * angularImpulseBody1;
+            }
 
             // Compute the impulse P=J^T * lambda for the lower limit constraint of body 2
             const Vector3 linearImpulseBody2 = deltaLambdaLower * mSliderAxisWorld;
             const Vector3 angularImpulseBody2 = deltaLambdaLower * mR2CrossSliderAxis;
 
             // Apply the impulse to the body 2
-            v2 += inverseMassBody2 * linearImpulseBody2;
-            w2 += mI2 * angularImpulseBody2;
+            if (mBody2->getType() == DYNAMIC) {
+                v2 += inverseMassBody2 * linearImpulseBody2;
+                w2 += mI2 * angularImpulseBody2;
+            }
         }
 
         // If the upper limit is violated
@@ -392,16 +408,20 @@ void SliderJoint::solveVelocityConstraint(const ConstraintSolverData& constraint
             const Vector3 angularImpulseBody1 = deltaLambdaUpper * mR1PlusUCrossSliderAxis;
 
             // Apply the impulse to the body 1
-            v1 += inverseMassBody1 * linearImpulseBody1;
-            w1 += mI1 * angularImpulseBody1;
+            if (mBody1->getType() == DYNAMIC) {
+                v1 += inverseMassBody1 * linearImpulseBody1;
+                w1 += mI1 * angularImpulseBody1;
+            }
 
             // Compute the impulse P=J^T * lambda for the upper limit constraint of body 2
             const Vector3 linearImpulseBody2 = -deltaLambdaUpper * mSliderAxisWorld;
             const Vector3 angularImpulseBody2 = -deltaLambdaUpper * mR2CrossSliderAxis;
 
             // Apply the impulse to the body 2
-            v2 += inverseMassBody2 * linearImpulseBody2;
-            w2 += mI2 * angularImpulseBody2;
+            if (mBody2->getType() == DYNAMIC) {
+                v2 += inverseMassBody2 * linearImpulseBody2;
+                w2 += mI2 * angularImpulseBody2;
+            }
         }
     }
 
@@ -423,13 +443,17 @@ void SliderJoint::solveVelocityConstraint(const ConstraintSolverData& constraint
         const Vector3 linearImpulseBody1 = deltaLambdaMotor * mSliderAxisWorld;
 
         // Apply the impulse to the body 1
-        v1 += inverseMassBody1 * linearImpulseBody1;
+        if (mBody1->getType() == DYNAMIC) {
+            v1 += inverseMassBody1 * linearImpulseBody1;
+        }
 
         // Compute the impulse P=J^T * lambda for the motor of body 2
         const Vector3 linearImpulseBody2 = -deltaLambdaMotor * mSliderAxisWorld;
 
         // Apply the impulse to the body 2
-        v2 += inverseMassBody2 * linearImpulseBody2;
+        if (mBody2->getType() == DYNAMIC) {
+            v2 += inverseMassBody2 * linearImpulseBody2;
+        }
     }
 }
 
@@ -522,9 +546,11 @@ void SliderJoint::solvePositionConstraint(const ConstraintSolverData& constraint
     Vector3 w1 = mI1 * angularImpulseBody1;
 
     // Update the body position/orientation of body 1
-    x1 += v1;
-    q1 += Quaternion(0, w1) * q1 * decimal(0.5);
-    q1.normalize();
+    if (mBody1->getType() == DYNAMIC) {
+        x1 += v1;
+        q1 += Quaternion(0, w1) * q1 * decimal(0.5);
+        q1.normalize();
+    }
 
     // Compute the impulse P=J^T * lambda for the 2 translation constraints of body 2
     const Vector3 linearImpulseBody2 = mN1 * lambdaTranslation.x + mN2 * lambdaTranslation.y;
@@ -536,9 +562,11 @@ void SliderJoint::solvePositionConstraint(const ConstraintSolverData& constraint
     Vector3 w2 = mI2 * angularImpulseBody2;
 
     // Update the body position/orientation of body 2
-    x2 += v2;
-    q2 += Quaternion(0, w2) * q2 * decimal(0.5);
-    q2.normalize();
+    if (mBody2->getType() == DYNAMIC) {
+        x2 += v2;
+        q2 += Quaternion(0, w2) * q2 * decimal(0.5);
+        q2.normalize();
+    }
 
     // --------------- Rotation Constraints --------------- //
 
@@ -587,8 +615,10 @@ void SliderJoint::solvePositionConstraint(const ConstraintSolverData& constraint
     w1 = mI1 * angularImpulseBody1;
 
     // Update the body position/orientation of body 1
-    q1 += Quaternion(0, w1) * q1 * decimal(0.5);
-    q1.normalize();
+    if (mBody1->getType() == DYNAMIC) {
+        q1 += Quaternion(0, w1) * q1 * decimal(0.5);
+        q1.normalize();
+    }
 
     // Compute the impulse P=J^T * lambda for the 3 rotation constraints of body 2
     angularImpulseBody2 = lambdaRotation;
@@ -597,8 +627,10 @@ void SliderJoint::solvePositionConstraint(const ConstraintSolverData& constraint
     w2 = mI2 * angularImpulseBody2;
 
     // Update the body position/orientation of body 2
-    q2 += Quaternion(0, w2) * q2 * decimal(0.5);
-    q2.normalize();
+    if (mBody2->getType() == DYNAMIC) {
+        q2 += Quaternion(0, w2) * q2 * decimal(0.5);
+        q2.normalize();
+    }
 
     // --------------- Limits Constraints --------------- //
 
@@ -629,9 +661,11 @@ void SliderJoint::solvePositionConstraint(const ConstraintSolverData& constraint
             const Vector3 w1 = mI1 * angularImpulseBody1;
 
             // Update the body position/orientation of body 1
-            x1 += v1;
-            q1 += Quaternion(0, w1) * q1 * decimal(0.5);
-            q1.normalize();
+            if (mBody1->getType() == DYNAMIC) {
+                x1 += v1;
+                q1 += Quaternion(0, w1) * q1 * decimal(0.5);
+                q1.normalize();
+            }
 
             // Compute the impulse P=J^T * lambda for the lower limit constraint of body 2
             const Vector3 linearImpulseBody2 = lambdaLowerLimit * mSliderAxisWorld;
@@ -642,9 +676,11 @@ void SliderJoint::solvePositionConstraint(const ConstraintSolverData& constraint
             const Vector3 w2 = mI2 * angularImpulseBody2;
 
             // Update the body position/orientation of body 2
-            x2 += v2;
-            q2 += Quaternion(0, w2) * q2 * decimal(0.5);
-            q2.normalize();
+            if (mBody2->getType() == DYNAMIC) {
+                x2 += v2;
+                q2 += Quaternion(0, w2) * q2 * decimal(0.5);
+                q2.normalize();
+            }
         }
 
         // If the upper limit is violated
@@ -662,9 +698,11 @@ void SliderJoint::solvePositionConstraint(const ConstraintSolverData& constraint
             const Vector3 w1 = mI1 * angularImpulseBody1;
 
             // Update the body position/orientation of body 1
-            x1 += v1;
-            q1 += Quaternion(0, w1) * q1 * decimal(0.5);
-            q1.normalize();
+            if (mBody1->getType() == DYNAMIC) {
+                x1 += v1;
+                q1 += Quaternion(0, w1) * q1 * decimal(0.5);
+                q1.normalize();
+            }
 
             // Compute the impulse P=J^T * lambda for the upper limit constraint of body 2
             const Vector3 linearImpulseBody2 = -lambdaUpperLimit * mSliderAxisWorld;
@@ -675,9 +713,11 @@ void SliderJoint::solvePositionConstraint(const ConstraintSolverData& constraint
             const Vector3 w2 = mI2 * angularImpulseBody2;
 
             // Update the body position/orientation of body 2
-            x2 += v2;
-            q2 += Quaternion(0, w2) * q2 * decimal(0.5);
-            q2.normalize();
+            if (mBody2->getType() == DYNAMIC) {
+                x2 += v2;
+                q2 += Quaternion(0, w2) * q2 * decimal(0.5);
+                q2.normalize();
+            }
         }
     }
 }
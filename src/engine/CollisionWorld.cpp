@@ -32,8 +32,11 @@ using namespace reactphysics3d;
 using namespace std;
 
 // Constructor
-CollisionWorld::CollisionWorld()
-               : mCollisionDetection(this, mMemoryAllocator), mCurrentBodyID(0),
+/**
+ * @param broadPhaseType Algorithm used by the broad-phase collision detection
+ */
+CollisionWorld::CollisionWorld(BroadPhaseType broadPhaseType)
+               : mCollisionDetection(this, mMemoryAllocator, broadPhaseType), mCurrentBodyID(0),
                  mEventListener(NULL) {
 
 }
@@ -100,6 +103,47 @@ void CollisionWorld::destroyCollisionBody(CollisionBody* collisionBody) {
     mMemoryAllocator.release(collisionBody, sizeof(CollisionBody));
 }
 
+// Destroy many collision bodies at once
+/// The collision shapes of all the bodies are removed from the collision detection
+/// together, which is much faster than destroying the bodies one by one when a large
+/// number of bodies is destroyed (when a level is unloaded for instance).
+/**
+ * @param collisionBodies The bodies to destroy
+ */
+void CollisionWorld::destroyCollisionBodies(const std::vector<CollisionBody*>& collisionBodies) {
+
+    // Remove the collision shapes of all the bodies from the collision detection
+    std::vector<ProxyShape*> proxyShapes;
+    for (uint i=0; i<collisionBodies.size(); i++) {
+        collectProxyShapesToRemove(collisionBodies[i], proxyShapes);
+    }
+    mCollisionDetection.removeProxyCollisionShapes(proxyShapes);
+
+    // Destroy the bodies
+    for (uint i=0; i<collisionBodies.size(); i++) {
+        destroyCollisionBody(collisionBodies[i]);
+    }
+}
+
+// Remove the collision shapes of a body that is destroyed in a bulk destruction
+/// The proxy shapes of the body are added to the array of shapes to remove from the
+/// collision detection. The body is then deactivated so that its proxy shapes are not
+/// removed again from the collision detection when it is destroyed.
+/**
+ * @param body The body that will be destroyed
+ * @param proxyShapes Array of proxy shapes to remove from the collision detection
+ */
+void CollisionWorld::collectProxyShapesToRemove(CollisionBody* body,
+                                                std::vector<ProxyShape*>& proxyShapes) {
+
+    if (!body->mIsActive) return;
+
+    for (ProxyShape* shape = body->mProxyCollisionShapes; shape != NULL; shape = shape->mNext) {
+        proxyShapes.push_back(shape);
+    }
+    body->mIsActive = false;
+}
+
 // Return the next available body ID
 bodyindex CollisionWorld::computeNextAvailableBodyID() {
 
@@ -41,6 +41,7 @@
 #include "constraint/ContactPoint.h"
 #include "memory/MemoryAllocator.h"
 #include "EventListener.h"
+#include "ThreadPool.h"
 
 /// Namespace reactphysics3d
 namespace reactphysics3d {
@@ -78,6 +79,9 @@ class CollisionWorld {
         /// Pointer to an event listener object
         EventListener* mEventListener;
 
+        /// Pool of threads used to execute the parallel parts of the simulation
+        ThreadPool mThreadPool;
+
         // -------------------- Methods -------------------- //
 
         /// Private copy-constructor
@@ -92,12 +96,15 @@ class CollisionWorld {
         /// Reset all the contact manifolds linked list of each body
         void resetContactManifoldListsOfBodies();
 
+        /// Remove the collision shapes of a body that is destroyed in a bulk destruction
+        void collectProxyShapesToRemove(CollisionBody* body, std::vector<ProxyShape*>& proxyShapes);
+
     public :
 
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        CollisionWorld();
+        CollisionWorld(BroadPhaseType broadPhaseType = DYNAMIC_AABB_TREE);
 
         /// Destructor
         virtual ~CollisionWorld();
@@ -114,13 +121,51 @@ class CollisionWorld {
         /// Destroy a collision body
         void destroyCollisionBody(CollisionBody* collisionBody);
 
+        /// Destroy many collision bodies at once
+        void destroyCollisionBodies(const std::vector<CollisionBody*>& collisionBodies);
+
         /// Set the collision dispatch configuration
         void setCollisionDispatch(CollisionDispatch* collisionDispatch);
 
+        /// Return the number of threads used to run the simulation
+        uint getNbThreads() const;
+
+        /// Set the number of threads used to run the simulation
+        void setNbThreads(uint nbThreads);
+
+        /// Start adding a large number of bodies and collision shapes
+        void beginBulkInsertion();
+
+        /// Finish adding a large number of bodies and collision shapes
+        void endBulkInsertion();
+
+        /// Rebuild the broad-phase data structure of the world
+        void rebuildBroadPhase();
+
+        /// Return the AABB trees broad-phase of the world (NULL with another broad-phase)
+        AABBTreeAlgorithm* getAABBTreeBroadPhase();
+
+        /// Return the spatial hash broad-phase of the world (NULL with another broad-phase)
+        SpatialHashAlgorithm* getSpatialHashBroadPhase();
+
+        /// Return the counters of the broad-phase during the last step
+        const BroadPhaseStatistics& getBroadPhaseStatistics() const;
+
+        /// Return the counters of the EPA algorithm during the last step
+        const EPAStatistics& getEPAStatistics() const;
+
+        /// Return the number of GJK iterations of the last collision test of two shapes
+        uint getNbGJKIterations(ProxyShape* shape1, ProxyShape* shape2) const;
+
         /// Ray cast method
         void raycast(const Ray& ray, RaycastCallback* raycastCallback,
                      unsigned short raycastWithCategoryMaskBits = 0xFFFF) const;
 
+        /// Convex cast method
+        void convexCast(const ConvexShape* shape, const Transform& fromTransform,
+                        const Transform& toTransform, ConvexCastCallback* convexCastCallback,
+                        unsigned short convexCastWithCategoryMaskBits = 0xFFFF) const;
+
         /// Test if the AABBs of two bodies overlap
         bool testAABBOverlap(const CollisionBody* body1,
                              const CollisionBody* body2) const;
@@ -187,6 +232,107 @@ inline void CollisionWorld::setCollisionDispatch(CollisionDispatch* collisionDis
     mCollisionDetection.setCollisionDispatch(collisionDispatch);
 }
 
+// Return the number of threads used to run the simulation
+/**
+ * @return The number of threads (including the thread that updates the world)
+ */
+inline uint CollisionWorld::getNbThreads() const {
+    return mThreadPool.getNbThreads();
+}
+
+// Set the number of threads used to run the simulation
+/// By default, a single thread is used. With more threads, the independent
+/// islands of bodies are solved concurrently. The result of the simulation
+/// does not depend on the number of threads.
+/**
+ * @param nbThreads Number of threads (including the thread that updates the world)
+ */
+inline void CollisionWorld::setNbThreads(uint nbThreads) {
+    mThreadPool.setNbThreads(nbThreads);
+}
+
+// Start adding a large number of bodies and collision shapes
+/// The collision shapes that are added to the bodies of the world between this call
+/// and the call to endBulkInsertion() are not inserted one by one into the broad-phase.
+/// Instead, the broad-phase AABB tree is built at once at the end, which is much
+/// faster (when loading a level for instance) and gives a better tree. The world must
+/// not be updated or queried (raycast, collision tests) before endBulkInsertion() is
+/// called.
+inline void CollisionWorld::beginBulkInsertion() {
+    mCollisionDetection.beginBulkInsertion();
+}
+
+// Finish adding a large number of bodies and collision shapes
+/// The broad-phase AABB tree is rebuilt with all the collision shapes of the world.
+inline void CollisionWorld::endBulkInsertion() {
+    mCollisionDetection.endBulkInsertion();
+}
+
+// Rebuild the broad-phase data structure of the world
+/// The broad-phase AABB tree is updated incrementally when the bodies move. After
+/// a large number of bodies have been teleported for instance, it can be rebuilt
+/// from scratch to improve the performance of the collision queries.
+inline void CollisionWorld::rebuildBroadPhase() {
+    mCollisionDetection.rebuildBroadPhase();
+}
+
+// Return the AABB trees broad-phase of the world (NULL with another broad-phase)
+/// The settings that are specific to the DYNAMIC_AABB_TREE broad-phase (the tree
+/// optimization budget and the cost of the tree) are available on this object.
+/**
+ * @return The broad-phase if the world uses the DYNAMIC_AABB_TREE broad-phase and
+ *         NULL otherwise
+ */
+inline AABBTreeAlgorithm* CollisionWorld::getAABBTreeBroadPhase() {
+    return mCollisionDetection.getAABBTreeBroadPhase();
+}
+
+// Return the spatial hash broad-phase of the world (NULL with another broad-phase)
+/// The size of the cells of the grid of the SPATIAL_HASH broad-phase is set on this object.
+/**
+ * @return The broad-phase if the world uses the SPATIAL_HASH broad-phase and NULL otherwise
+ */
+inline SpatialHashAlgorithm* CollisionWorld::getSpatialHashBroadPhase() {
+    return mCollisionDetection.getSpatialHashBroadPhase();
+}
+
+// Return the counters of the broad-phase during the last step
+/// The counters give the number of moving collision shapes whose fat AABB has been
+/// computed again (which requires an update of the broad-phase data structure) and
+/// the number of potential overlapping pairs found during the last step (a pair whose
+/// shapes are not in contact is a false positive of the fat AABBs).
+/**
+ * @return The counters of the last call to update() or testCollision()
+ */
+inline const BroadPhaseStatistics& CollisionWorld::getBroadPhaseStatistics() const {
+    return mCollisionDetection.getBroadPhaseStatistics();
+}
+
+// Return the counters of the EPA algorithm during the last step
+/// The EPA algorithm computes the penetration depth of the convex shapes that are
+/// tested with GJK and whose objects without margin overlap. The counters give the
+/// number of runs and iterations of the algorithm and the reasons why it stopped.
+/**
+ * @return The counters of the last call to update() or testCollision()
+ */
+inline const EPAStatistics& CollisionWorld::getEPAStatistics() const {
+    return mCollisionDetection.getEPAStatistics();
+}
+
+// Return the number of GJK iterations of the last collision test of two shapes
+/// This can be used to check how fast the GJK algorithm converges for a given
+/// pair of convex shapes.
+/**
+ * @param shape1 The first proxy shape
+ * @param shape2 The second proxy shape
+ * @return The number of iterations (zero if the AABBs of the shapes do not overlap or
+ *         if the shapes have not been tested with the GJK algorithm)
+ */
+inline uint CollisionWorld::getNbGJKIterations(ProxyShape* shape1, ProxyShape* shape2) const {
+    const OverlappingPair* pair = mCollisionDetection.getOverlappingPair(shape1, shape2);
+    return pair != NULL ? pair->getNbGJKIterations() : 0;
+}
+
 // Ray cast method
 /**
  * @param ray Ray to use for raycasting
@@ -200,6 +346,26 @@ inline void CollisionWorld::raycast(const Ray& ray,
     mCollisionDetection.raycast(raycastCallback, ray, raycastWithCategoryMaskBits);
 }
 
+// Convex cast method
+/// A convex shape (that does not need to be attached to a body) is moved from a
+/// transform to another one and the callback is notified of the proxy shapes that
+/// it hits during the motion with their time of impact.
+/**
+ * @param shape Convex shape to cast
+ * @param fromTransform Local-to-world transform of the shape at the beginning of the motion
+ * @param toTransform Local-to-world transform of the shape at the end of the motion
+ * @param convexCastCallback Pointer to the class with the callback method
+ * @param convexCastWithCategoryMaskBits Bits mask corresponding to the category of
+ *                                       bodies to be hit by the shape
+ */
+inline void CollisionWorld::convexCast(const ConvexShape* shape, const Transform& fromTransform,
+                                       const Transform& toTransform,
+                                       ConvexCastCallback* convexCastCallback,
+                                       unsigned short convexCastWithCategoryMaskBits) const {
+    mCollisionDetection.convexCast(convexCastCallback, shape, fromTransform, toTransform,
+                                   convexCastWithCategoryMaskBits);
+}
+
 // Test if the AABBs of two proxy shapes overlap
 /**
  * @param shape1 Pointer to the first proxy shape to test
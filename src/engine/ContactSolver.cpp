@@ -30,6 +30,10 @@
 #include "Profiler.h"
 #include <limits>
 
+#ifdef REACTPHYSICS3D_SSE_ENABLED
+#include <xmmintrin.h>
+#endif
+
 using namespace reactphysics3d;
 using namespace std;
 
@@ -38,11 +42,33 @@ const decimal ContactSolver::BETA = decimal(0.2);
 const decimal ContactSolver::BETA_SPLIT_IMPULSE = decimal(0.2);
 const decimal ContactSolver::SLOP= decimal(0.01);
 
+#ifdef REACTPHYSICS3D_SSE_ENABLED
+
+// Return the dot products of the vectors (ax, ay, az) and (bx, by, bz) of the four lanes
+static inline __m128 computeLanesDotProducts(const float* ax, const float* ay, const float* az,
+                                             const float* bx, const float* by, const float* bz) {
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(ax), _mm_loadu_ps(bx)),
+                                 _mm_mul_ps(_mm_loadu_ps(ay), _mm_loadu_ps(by))),
+                      _mm_mul_ps(_mm_loadu_ps(az), _mm_loadu_ps(bz)));
+}
+
+// Add the vectors (bx, by, bz) multiplied by the factors of the four lanes
+// to the vectors (ax, ay, az)
+static inline void addScaledLanes(float* ax, float* ay, float* az, const float* bx,
+                                  const float* by, const float* bz, const __m128& factors) {
+    _mm_storeu_ps(ax, _mm_add_ps(_mm_loadu_ps(ax), _mm_mul_ps(_mm_loadu_ps(bx), factors)));
+    _mm_storeu_ps(ay, _mm_add_ps(_mm_loadu_ps(ay), _mm_mul_ps(_mm_loadu_ps(by), factors)));
+    _mm_storeu_ps(az, _mm_add_ps(_mm_loadu_ps(az), _mm_mul_ps(_mm_loadu_ps(bz), factors)));
+}
+
+#endif
+
 // Constructor
-ContactSolver::ContactSolver(const std::map<RigidBody*, uint>& mapBodyToVelocityIndex)
+ContactSolver::ContactSolver()
               :mSplitLinearVelocities(NULL), mSplitAngularVelocities(NULL),
-               mContactConstraints(NULL), mLinearVelocities(NULL), mAngularVelocities(NULL),
-               mMapBodyToConstrainedVelocityIndex(mapBodyToVelocityIndex),
+               mContactConstraints(NULL), mContactBatches(NULL), mNbContactBatches(0),
+               mNbAllocatedContactBatches(0),
+               mLinearVelocities(NULL), mAngularVelocities(NULL),
                mIsWarmStartingActive(true), mIsSplitImpulseActive(true),
                mIsSolveFrictionAtContactManifoldCenterActive(true) {
 
@@ -51,6 +77,7 @@ ContactSolver::ContactSolver(const std::map<RigidBody*, uint>& mapBodyToVelocity
 // Destructor
 ContactSolver::~ContactSolver() {
 
+    delete[] mContactBatches;
 }
 
 // Initialize the constraint solver for a given island
@@ -72,6 +99,8 @@ void ContactSolver::initializeForIsland(decimal dt, Island* island) {
     mContactConstraints = new ContactManifoldSolver[mNbContactManifolds];
     assert(mContactConstraints != NULL);
 
+    uint nbContactPoints = 0;
+
     // For each contact manifold of the island
     ContactManifold** contactManifolds = island->getContactManifold();
     for (uint i=0; i<mNbContactManifolds; i++) {
@@ -94,8 +123,8 @@ void ContactSolver::initializeForIsland(decimal dt, Island* island) {
 
         // Initialize the internal contact manifold structure using the external
         // contact manifold
-        internalManifold.indexBody1 = mMapBodyToConstrainedVelocityIndex.find(body1)->second;
-        internalManifold.indexBody2 = mMapBodyToConstrainedVelocityIndex.find(body2)->second;
+        internalManifold.indexBody1 = body1->mArrayIndex;
+        internalManifold.indexBody2 = body2->mArrayIndex;
         internalManifold.inverseInertiaTensorBody1 = body1->getInertiaTensorInverseWorld();
         internalManifold.inverseInertiaTensorBody2 = body2->getInertiaTensorInverseWorld();
         internalManifold.massInverseBody1 = body1->mMassInverse;
@@ -107,6 +136,7 @@ void ContactSolver::initializeForIsland(decimal dt, Island* island) {
         internalManifold.externalContactManifold = externalManifold;
         internalManifold.isBody1DynamicType = body1->getType() == DYNAMIC;
         internalManifold.isBody2DynamicType = body2->getType() == DYNAMIC;
+        nbContactPoints += internalManifold.nbContacts;
 
         // If we solve the friction constraints at the center of the contact manifold
         if (mIsSolveFrictionAtContactManifoldCenterActive) {
@@ -130,12 +160,10 @@ void ContactSolver::initializeForIsland(decimal dt, Island* island) {
             contactPoint.normal = externalContact->getNormal();
             contactPoint.r1 = p1 - x1;
             contactPoint.r2 = p2 - x2;
-            contactPoint.penetrationDepth = externalContact->getPenetrationDepth();
             contactPoint.isRestingContact = externalContact->getIsRestingContact();
             externalContact->setIsRestingContact(true);
             contactPoint.oldFrictionVector1 = externalContact->getFrictionVector1();
             contactPoint.oldFrictionVector2 = externalContact->getFrictionVector2();
-            contactPoint.penetrationImpulse = 0.0;
             contactPoint.friction1Impulse = 0.0;
             contactPoint.friction2Impulse = 0.0;
             contactPoint.rollingResistanceImpulse = Vector3::zero();
@@ -176,13 +204,23 @@ void ContactSolver::initializeForIsland(decimal dt, Island* island) {
         }
     }
 
+    // Allocate the batches (a contact point never needs more than its own batch)
+    if (nbContactPoints > mNbAllocatedContactBatches) {
+        delete[] mContactBatches;
+        mContactBatches = new ContactPointBatch[nbContactPoints];
+        mNbAllocatedContactBatches = nbContactPoints;
+    }
+    mNbContactBatches = 0;
+
     // Fill-in all the matrices needed to solve the LCP problem
     initializeContactConstraints();
 }
 
 // Initialize the contact constraints before solving the system
 void ContactSolver::initializeContactConstraints() {
-    
+
+    const decimal beta = mIsSplitImpulseActive ? BETA_SPLIT_IMPULSE : BETA;
+
     // For each contact constraint
     for (uint c=0; c<mNbContactManifolds; c++) {
 
@@ -212,16 +250,17 @@ void ContactSolver::initializeContactConstraints() {
             // Compute the velocity difference
             Vector3 deltaV = v2 + w2.cross(contactPoint.r2) - v1 - w1.cross(contactPoint.r1);
 
-            contactPoint.r1CrossN = contactPoint.r1.cross(contactPoint.normal);
-            contactPoint.r2CrossN = contactPoint.r2.cross(contactPoint.normal);
+            const Vector3 r1CrossN = contactPoint.r1.cross(contactPoint.normal);
+            const Vector3 r2CrossN = contactPoint.r2.cross(contactPoint.normal);
+            const Vector3 angularResponseBody1 = I1 * r1CrossN;
+            const Vector3 angularResponseBody2 = I2 * r2CrossN;
 
             // Compute the inverse mass matrix K for the penetration constraint
             decimal massPenetration = manifold.massInverseBody1 + manifold.massInverseBody2 +
-                    ((I1 * contactPoint.r1CrossN).cross(contactPoint.r1)).dot(contactPoint.normal) +
-                    ((I2 * contactPoint.r2CrossN).cross(contactPoint.r2)).dot(contactPoint.normal);
-            massPenetration > 0.0 ? contactPoint.inversePenetrationMass = decimal(1.0) /
-                                                                          massPenetration :
-                                                                          decimal(0.0);
+                    (angularResponseBody1.cross(contactPoint.r1)).dot(contactPoint.normal) +
+                    (angularResponseBody2.cross(contactPoint.r2)).dot(contactPoint.normal);
+            decimal inversePenetrationMass = massPenetration > 0.0 ?
+                                             decimal(1.0) / massPenetration : decimal(0.0);
 
             // If we do not solve the friction constraints at the center of the contact manifold
             if (!mIsSolveFrictionAtContactManifoldCenterActive) {
@@ -258,24 +297,49 @@ void ContactSolver::initializeContactConstraints() {
             // of inside the solve() method because we need to use the velocity difference
             // at the beginning of the contact. Note that if it is a resting contact (normal
             // velocity bellow a given threshold), we do not add a restitution velocity bias
-            contactPoint.restitutionBias = 0.0;
+            decimal restitutionBias = 0.0;
             decimal deltaVDotN = deltaV.dot(contactPoint.normal);
             if (deltaVDotN < -RESTITUTION_VELOCITY_THRESHOLD) {
-                contactPoint.restitutionBias = manifold.restitutionFactor * deltaVDotN;
+                restitutionBias = manifold.restitutionFactor * deltaVDotN;
+            }
+
+            // Compute the bias for the penetration depth correction
+            const decimal penetrationDepth = externalContact->getPenetrationDepth();
+            decimal biasPenetrationDepth = 0.0;
+            if (penetrationDepth > SLOP) {
+                biasPenetrationDepth = -(beta / mTimeStep) * (penetrationDepth - SLOP);
             }
 
             // If the warm starting of the contact solver is active
             if (mIsWarmStartingActive) {
 
                 // Get the cached accumulated impulses from the previous step
-                contactPoint.penetrationImpulse = externalContact->getPenetrationImpulse();
                 contactPoint.friction1Impulse = externalContact->getFrictionImpulse1();
                 contactPoint.friction2Impulse = externalContact->getFrictionImpulse2();
                 contactPoint.rollingResistanceImpulse = externalContact->getRollingResistanceImpulse();
             }
 
-            // Initialize the split impulses to zero
-            contactPoint.penetrationSplitImpulse = 0.0;
+            // Store the penetration constraint in a lane of a batch
+            insertIntoBatch(contactPoint, manifold);
+            ContactPointBatch& batch = mContactBatches[contactPoint.batchIndex];
+            const uint lane = contactPoint.batchLane;
+            batch.normal.set(lane, contactPoint.normal);
+            batch.r1CrossN.set(lane, r1CrossN);
+            batch.r2CrossN.set(lane, r2CrossN);
+            batch.angularResponseBody1.set(lane, angularResponseBody1);
+            batch.angularResponseBody2.set(lane, angularResponseBody2);
+            batch.massInverseBody1[lane] = manifold.massInverseBody1;
+            batch.massInverseBody2[lane] = manifold.massInverseBody2;
+            batch.inversePenetrationMass[lane] = inversePenetrationMass;
+            batch.velocityBias[lane] = mIsSplitImpulseActive ? restitutionBias :
+                                                               restitutionBias + biasPenetrationDepth;
+            batch.splitBias[lane] = biasPenetrationDepth;
+
+            // Only the contact points that were already existing at the previous step are
+            // warm started with their cached impulse
+            batch.penetrationImpulse[lane] = mIsWarmStartingActive && contactPoint.isRestingContact ?
+                                             externalContact->getPenetrationImpulse() : decimal(0.0);
+            batch.penetrationSplitImpulse[lane] = 0.0;
 
             // If we solve the friction constraints at the center of the contact manifold
             if (mIsSolveFrictionAtContactManifoldCenterActive) {
@@ -341,6 +405,18 @@ void ContactSolver::warmStart() {
     // Check that warm starting is active
     if (!mIsWarmStartingActive) return;
 
+    // For each batch of penetration constraints
+    for (uint b=0; b<mNbContactBatches; b++) {
+
+        const ContactPointBatch& batch = mContactBatches[b];
+
+        // Apply the accumulated penetration impulses to the bodies of the lanes
+        LaneVectors v1, w1, v2, w2;
+        gatherVelocities(batch, mLinearVelocities, mAngularVelocities, v1, w1, v2, w2);
+        applyBatchImpulses(batch, batch.penetrationImpulse, v1, w1, v2, w2);
+        scatterVelocities(batch, mLinearVelocities, mAngularVelocities, v1, w1, v2, w2);
+    }
+
     // For each constraint
     for (uint c=0; c<mNbContactManifolds; c++) {
 
@@ -357,15 +433,6 @@ void ContactSolver::warmStart() {
 
                 atLeastOneRestingContactPoint = true;
 
-                // --------- Penetration --------- //
-
-                // Compute the impulse P = J^T * lambda
-                const Impulse impulsePenetration = computePenetrationImpulse(
-                                                     contactPoint.penetrationImpulse, contactPoint);
-
-                // Apply the impulse to the bodies of the constraint
-                applyImpulse(impulsePenetration, contactManifold);
-
                 // If we do not solve the friction constraints at the center of the contact manifold
                 if (!mIsSolveFrictionAtContactManifoldCenterActive) {
 
@@ -414,7 +481,6 @@ void ContactSolver::warmStart() {
             else {  // If it is a new contact point
 
                 // Initialize the accumulated impulses to zero
-                contactPoint.penetrationImpulse = 0.0;
                 contactPoint.friction1Impulse = 0.0;
                 contactPoint.friction2Impulse = 0.0;
                 contactPoint.rollingResistanceImpulse = Vector3::zero();
@@ -513,6 +579,25 @@ void ContactSolver::solve() {
     decimal deltaLambda;
     decimal lambdaTemp;
 
+    // For each batch of penetration constraints
+    for (uint b=0; b<mNbContactBatches; b++) {
+
+        ContactPointBatch& batch = mContactBatches[b];
+
+        // --------- Penetration --------- //
+
+        solveBatch(batch, batch.velocityBias, batch.penetrationImpulse,
+                   mLinearVelocities, mAngularVelocities);
+
+        // If the split impulse position correction is active
+        if (mIsSplitImpulseActive) {
+
+            // Split impulse (position correction)
+            solveBatch(batch, batch.splitBias, batch.penetrationSplitImpulse,
+                       mSplitLinearVelocities, mSplitAngularVelocities);
+        }
+    }
+
     // For each contact manifold
     for (uint c=0; c<mNbContactManifolds; c++) {
 
@@ -530,67 +615,9 @@ void ContactSolver::solve() {
 
             ContactPointSolver& contactPoint = contactManifold.contacts[i];
 
-            // --------- Penetration --------- //
-
-            // Compute J*v
-            Vector3 deltaV = v2 + w2.cross(contactPoint.r2) - v1 - w1.cross(contactPoint.r1);
-            decimal deltaVDotN = deltaV.dot(contactPoint.normal);
-            decimal Jv = deltaVDotN;
-
-            // Compute the bias "b" of the constraint
-            decimal beta = mIsSplitImpulseActive ? BETA_SPLIT_IMPULSE : BETA;
-            decimal biasPenetrationDepth = 0.0;
-            if (contactPoint.penetrationDepth > SLOP) biasPenetrationDepth = -(beta/mTimeStep) *
-                    max(0.0f, float(contactPoint.penetrationDepth - SLOP));
-            decimal b = biasPenetrationDepth + contactPoint.restitutionBias;
-
-            // Compute the Lagrange multiplier lambda
-            if (mIsSplitImpulseActive) {
-                deltaLambda = - (Jv + contactPoint.restitutionBias) *
-                        contactPoint.inversePenetrationMass;
-            }
-            else {
-                deltaLambda = - (Jv + b) * contactPoint.inversePenetrationMass;
-            }
-            lambdaTemp = contactPoint.penetrationImpulse;
-            contactPoint.penetrationImpulse = std::max(contactPoint.penetrationImpulse +
-                                                       deltaLambda, decimal(0.0));
-            deltaLambda = contactPoint.penetrationImpulse - lambdaTemp;
-
-            // Compute the impulse P=J^T * lambda
-            const Impulse impulsePenetration = computePenetrationImpulse(deltaLambda,
-                                                                         contactPoint);
-
-            // Apply the impulse to the bodies of the constraint
-            applyImpulse(impulsePenetration, contactManifold);
-
-            sumPenetrationImpulse += contactPoint.penetrationImpulse;
-
-            // If the split impulse position correction is active
-            if (mIsSplitImpulseActive) {
-
-                // Split impulse (position correction)
-                const Vector3& v1Split = mSplitLinearVelocities[contactManifold.indexBody1];
-                const Vector3& w1Split = mSplitAngularVelocities[contactManifold.indexBody1];
-                const Vector3& v2Split = mSplitLinearVelocities[contactManifold.indexBody2];
-                const Vector3& w2Split = mSplitAngularVelocities[contactManifold.indexBody2];
-                Vector3 deltaVSplit = v2Split + w2Split.cross(contactPoint.r2) -
-                        v1Split - w1Split.cross(contactPoint.r1);
-                decimal JvSplit = deltaVSplit.dot(contactPoint.normal);
-                decimal deltaLambdaSplit = - (JvSplit + biasPenetrationDepth) *
-                        contactPoint.inversePenetrationMass;
-                decimal lambdaTempSplit = contactPoint.penetrationSplitImpulse;
-                contactPoint.penetrationSplitImpulse = std::max(
-                            contactPoint.penetrationSplitImpulse +
-                            deltaLambdaSplit, decimal(0.0));
-                deltaLambda = contactPoint.penetrationSplitImpulse - lambdaTempSplit;
-
-                // Compute the impulse P=J^T * lambda
-                const Impulse splitImpulsePenetration = computePenetrationImpulse(
-                            deltaLambdaSplit, contactPoint);
-
-                applySplitImpulse(splitImpulsePenetration, contactManifold);
-            }
+            const decimal penetrationImpulse =
+                    mContactBatches[contactPoint.batchIndex].penetrationImpulse[contactPoint.batchLane];
+            sumPenetrationImpulse += penetrationImpulse;
 
             // If we do not solve the friction constraints at the center of the contact manifold
             if (!mIsSolveFrictionAtContactManifoldCenterActive) {
@@ -598,14 +625,13 @@ void ContactSolver::solve() {
                 // --------- Friction 1 --------- //
 
                 // Compute J*v
-                deltaV = v2 + w2.cross(contactPoint.r2) - v1 - w1.cross(contactPoint.r1);
-                Jv = deltaV.dot(contactPoint.frictionVector1);
+                Vector3 deltaV = v2 + w2.cross(contactPoint.r2) - v1 - w1.cross(contactPoint.r1);
+                decimal Jv = deltaV.dot(contactPoint.frictionVector1);
 
                 // Compute the Lagrange multiplier lambda
                 deltaLambda = -Jv;
                 deltaLambda *= contactPoint.inverseFriction1Mass;
-                decimal frictionLimit = contactManifold.frictionCoefficient *
-                        contactPoint.penetrationImpulse;
+                decimal frictionLimit = contactManifold.frictionCoefficient * penetrationImpulse;
                 lambdaTemp = contactPoint.friction1Impulse;
                 contactPoint.friction1Impulse = std::max(-frictionLimit,
                                                          std::min(contactPoint.friction1Impulse
@@ -628,8 +654,7 @@ void ContactSolver::solve() {
                 // Compute the Lagrange multiplier lambda
                 deltaLambda = -Jv;
                 deltaLambda *= contactPoint.inverseFriction2Mass;
-                frictionLimit = contactManifold.frictionCoefficient *
-                        contactPoint.penetrationImpulse;
+                frictionLimit = contactManifold.frictionCoefficient * penetrationImpulse;
                 lambdaTemp = contactPoint.friction2Impulse;
                 contactPoint.friction2Impulse = std::max(-frictionLimit,
                                                          std::min(contactPoint.friction2Impulse
@@ -652,7 +677,7 @@ void ContactSolver::solve() {
 
                     // Compute the Lagrange multiplier lambda
                     Vector3 deltaLambdaRolling = contactManifold.inverseRollingResistance * (-JvRolling);
-                    decimal rollingLimit = contactManifold.rollingResistanceFactor * contactPoint.penetrationImpulse;
+                    decimal rollingLimit = contactManifold.rollingResistanceFactor * penetrationImpulse;
                     Vector3 lambdaTempRolling = contactPoint.rollingResistanceImpulse;
                     contactPoint.rollingResistanceImpulse = clamp(contactPoint.rollingResistanceImpulse +
                                                                          deltaLambdaRolling, rollingLimit);
@@ -791,7 +816,9 @@ void ContactSolver::storeImpulses() {
 
             ContactPointSolver& contactPoint = manifold.contacts[i];
 
-            contactPoint.externalContact->setPenetrationImpulse(contactPoint.penetrationImpulse);
+            const ContactPointBatch& batch = mContactBatches[contactPoint.batchIndex];
+            contactPoint.externalContact->setPenetrationImpulse(
+                        batch.penetrationImpulse[contactPoint.batchLane]);
             contactPoint.externalContact->setFrictionImpulse1(contactPoint.friction1Impulse);
             contactPoint.externalContact->setFrictionImpulse2(contactPoint.friction2Impulse);
             contactPoint.externalContact->setRollingResistanceImpulse(contactPoint.rollingResistanceImpulse);
@@ -809,38 +836,265 @@ void ContactSolver::storeImpulses() {
     }
 }
 
-// Apply an impulse to the two bodies of a constraint
+// Apply an impulse to the two bodies of a constraint. Only dynamic bodies are
+// updated so that a static body shared between islands is never written to.
 void ContactSolver::applyImpulse(const Impulse& impulse,
                                  const ContactManifoldSolver& manifold) {
 
     // Update the velocities of the body 1 by applying the impulse P
-    mLinearVelocities[manifold.indexBody1] += manifold.massInverseBody1 *
-                                              impulse.linearImpulseBody1;
-    mAngularVelocities[manifold.indexBody1] += manifold.inverseInertiaTensorBody1 *
-                                               impulse.angularImpulseBody1;
+    if (manifold.isBody1DynamicType) {
+        mLinearVelocities[manifold.indexBody1] += manifold.massInverseBody1 *
+                                                  impulse.linearImpulseBody1;
+        mAngularVelocities[manifold.indexBody1] += manifold.inverseInertiaTensorBody1 *
+                                                   impulse.angularImpulseBody1;
+    }
 
     // Update the velocities of the body 1 by applying the impulse P
-    mLinearVelocities[manifold.indexBody2] += manifold.massInverseBody2 *
-                                              impulse.linearImpulseBody2;
-    mAngularVelocities[manifold.indexBody2] += manifold.inverseInertiaTensorBody2 *
-                                               impulse.angularImpulseBody2;
+    if (manifold.isBody2DynamicType) {
+        mLinearVelocities[manifold.indexBody2] += manifold.massInverseBody2 *
+                                                  impulse.linearImpulseBody2;
+        mAngularVelocities[manifold.indexBody2] += manifold.inverseInertiaTensorBody2 *
+                                                   impulse.angularImpulseBody2;
+    }
 }
 
-// Apply an impulse to the two bodies of a constraint
+// Apply an impulse to the two bodies of a constraint. Only dynamic bodies are
+// updated so that a static body shared between islands is never written to.
 void ContactSolver::applySplitImpulse(const Impulse& impulse,
                                       const ContactManifoldSolver& manifold) {
 
     // Update the velocities of the body 1 by applying the impulse P
-    mSplitLinearVelocities[manifold.indexBody1] += manifold.massInverseBody1 *
-                                                   impulse.linearImpulseBody1;
-    mSplitAngularVelocities[manifold.indexBody1] += manifold.inverseInertiaTensorBody1 *
-                                                    impulse.angularImpulseBody1;
+    if (manifold.isBody1DynamicType) {
+        mSplitLinearVelocities[manifold.indexBody1] += manifold.massInverseBody1 *
+                                                       impulse.linearImpulseBody1;
+        mSplitAngularVelocities[manifold.indexBody1] += manifold.inverseInertiaTensorBody1 *
+                                                        impulse.angularImpulseBody1;
+    }
 
     // Update the velocities of the body 1 by applying the impulse P
-    mSplitLinearVelocities[manifold.indexBody2] += manifold.massInverseBody2 *
-                                                   impulse.linearImpulseBody2;
-    mSplitAngularVelocities[manifold.indexBody2] += manifold.inverseInertiaTensorBody2 *
-                                                    impulse.angularImpulseBody2;
+    if (manifold.isBody2DynamicType) {
+        mSplitLinearVelocities[manifold.indexBody2] += manifold.massInverseBody2 *
+                                                       impulse.linearImpulseBody2;
+        mSplitAngularVelocities[manifold.indexBody2] += manifold.inverseInertiaTensorBody2 *
+                                                        impulse.angularImpulseBody2;
+    }
+}
+
+// Insert a contact point into a batch that does not contain its dynamic bodies
+/// A contact point can only be inserted into a batch that comes after the last batch
+/// using one of its dynamic bodies. Therefore, the constraints that share a body are
+/// still solved in the order of the contact manifolds of the island and the result
+/// of an iteration is the same as solving the constraints one after the other. Static
+/// and kinematic bodies are never written by the solver and can be shared between
+/// lanes. Only the last created batches are searched and a new batch is created if
+/// none of them can receive the contact point.
+void ContactSolver::insertIntoBatch(ContactPointSolver& contactPoint,
+                                    const ContactManifoldSolver& manifold) {
+
+    const uint firstSearchedBatch = mNbContactBatches > NB_SEARCHED_BATCHES ?
+                                    mNbContactBatches - NB_SEARCHED_BATCHES : 0;
+
+    // Find the first batch with a free lane after the last batch using one of the bodies
+    uint insertionBatch = mNbContactBatches;
+    for (uint b=mNbContactBatches; b>firstSearchedBatch; b--) {
+
+        const ContactPointBatch& batch = mContactBatches[b - 1];
+
+        // Check if a lane of the batch already uses one of the dynamic bodies
+        bool isConflicting = false;
+        for (uint lane=0; lane<batch.nbContacts && !isConflicting; lane++) {
+            isConflicting = (manifold.isBody1DynamicType &&
+                             (manifold.indexBody1 == batch.indexBody1[lane] ||
+                              manifold.indexBody1 == batch.indexBody2[lane])) ||
+                            (manifold.isBody2DynamicType &&
+                             (manifold.indexBody2 == batch.indexBody1[lane] ||
+                              manifold.indexBody2 == batch.indexBody2[lane]));
+        }
+        if (isConflicting) break;
+
+        if (batch.nbContacts < NB_BATCH_LANES) insertionBatch = b - 1;
+    }
+
+    // If a batch can receive the contact point
+    if (insertionBatch < mNbContactBatches) {
+        ContactPointBatch& batch = mContactBatches[insertionBatch];
+        contactPoint.batchIndex = insertionBatch;
+        contactPoint.batchLane = batch.nbContacts;
+        batch.indexBody1[batch.nbContacts] = manifold.indexBody1;
+        batch.indexBody2[batch.nbContacts] = manifold.indexBody2;
+        batch.isBody1DynamicType[batch.nbContacts] = manifold.isBody1DynamicType;
+        batch.isBody2DynamicType[batch.nbContacts] = manifold.isBody2DynamicType;
+        batch.nbContacts++;
+        return;
+    }
+
+    // Create a new batch. The unused lanes read the velocities of the bodies of the
+    // first lane but have a zero inverse mass and are never written back.
+    ContactPointBatch& batch = mContactBatches[mNbContactBatches];
+    for (uint lane=0; lane<NB_BATCH_LANES; lane++) {
+        batch.indexBody1[lane] = manifold.indexBody1;
+        batch.indexBody2[lane] = manifold.indexBody2;
+        batch.isBody1DynamicType[lane] = false;
+        batch.isBody2DynamicType[lane] = false;
+        batch.normal.set(lane, Vector3::zero());
+        batch.r1CrossN.set(lane, Vector3::zero());
+        batch.r2CrossN.set(lane, Vector3::zero());
+        batch.angularResponseBody1.set(lane, Vector3::zero());
+        batch.angularResponseBody2.set(lane, Vector3::zero());
+        batch.massInverseBody1[lane] = 0.0;
+        batch.massInverseBody2[lane] = 0.0;
+        batch.inversePenetrationMass[lane] = 0.0;
+        batch.velocityBias[lane] = 0.0;
+        batch.splitBias[lane] = 0.0;
+        batch.penetrationImpulse[lane] = 0.0;
+        batch.penetrationSplitImpulse[lane] = 0.0;
+    }
+    batch.isBody1DynamicType[0] = manifold.isBody1DynamicType;
+    batch.isBody2DynamicType[0] = manifold.isBody2DynamicType;
+    batch.nbContacts = 1;
+
+    contactPoint.batchIndex = mNbContactBatches;
+    contactPoint.batchLane = 0;
+    mNbContactBatches++;
+}
+
+// Gather the velocities of the bodies of each lane of a batch
+void ContactSolver::gatherVelocities(const ContactPointBatch& batch,
+                                     const Vector3* linearVelocities,
+                                     const Vector3* angularVelocities, LaneVectors& v1,
+                                     LaneVectors& w1, LaneVectors& v2, LaneVectors& w2) const {
+
+    for (uint lane=0; lane<NB_BATCH_LANES; lane++) {
+        v1.set(lane, linearVelocities[batch.indexBody1[lane]]);
+        w1.set(lane, angularVelocities[batch.indexBody1[lane]]);
+        v2.set(lane, linearVelocities[batch.indexBody2[lane]]);
+        w2.set(lane, angularVelocities[batch.indexBody2[lane]]);
+    }
+}
+
+// Scatter the velocities of the bodies of each lane of a batch. Only dynamic bodies are
+// updated so that a static body shared between islands is never written to.
+void ContactSolver::scatterVelocities(const ContactPointBatch& batch, Vector3* linearVelocities,
+                                      Vector3* angularVelocities, const LaneVectors& v1,
+                                      const LaneVectors& w1, const LaneVectors& v2,
+                                      const LaneVectors& w2) const {
+
+    for (uint lane=0; lane<batch.nbContacts; lane++) {
+
+        if (batch.isBody1DynamicType[lane]) {
+            linearVelocities[batch.indexBody1[lane]] = v1.get(lane);
+            angularVelocities[batch.indexBody1[lane]] = w1.get(lane);
+        }
+
+        if (batch.isBody2DynamicType[lane]) {
+            linearVelocities[batch.indexBody2[lane]] = v2.get(lane);
+            angularVelocities[batch.indexBody2[lane]] = w2.get(lane);
+        }
+    }
+}
+
+// Apply a penetration impulse in each lane of a batch to the gathered velocities
+/// The impulse P = J^T * lambda of a lane changes the velocities with
+/// v1 -= m1^-1 * n * lambda, w1 -= I1^-1 * (r1 x n) * lambda,
+/// v2 += m2^-1 * n * lambda and w2 += I2^-1 * (r2 x n) * lambda
+void ContactSolver::applyBatchImpulses(const ContactPointBatch& batch,
+                                       const decimal* deltaLambdas,
+                                       LaneVectors& v1, LaneVectors& w1,
+                                       LaneVectors& v2, LaneVectors& w2) const {
+
+#ifdef REACTPHYSICS3D_SSE_ENABLED
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 lambdas = _mm_loadu_ps(deltaLambdas);
+    const __m128 linearFactors1 = _mm_sub_ps(zero, _mm_mul_ps(_mm_loadu_ps(batch.massInverseBody1),
+                                                              lambdas));
+    const __m128 linearFactors2 = _mm_mul_ps(_mm_loadu_ps(batch.massInverseBody2), lambdas);
+
+    addScaledLanes(v1.x, v1.y, v1.z, batch.normal.x, batch.normal.y, batch.normal.z,
+                   linearFactors1);
+    addScaledLanes(w1.x, w1.y, w1.z, batch.angularResponseBody1.x, batch.angularResponseBody1.y,
+                   batch.angularResponseBody1.z, _mm_sub_ps(zero, lambdas));
+    addScaledLanes(v2.x, v2.y, v2.z, batch.normal.x, batch.normal.y, batch.normal.z,
+                   linearFactors2);
+    addScaledLanes(w2.x, w2.y, w2.z, batch.angularResponseBody2.x, batch.angularResponseBody2.y,
+                   batch.angularResponseBody2.z, lambdas);
+
+#else
+
+    for (uint lane=0; lane<NB_BATCH_LANES; lane++) {
+
+        const Vector3 normal = batch.normal.get(lane);
+        v1.set(lane, v1.get(lane) - batch.massInverseBody1[lane] * deltaLambdas[lane] * normal);
+        w1.set(lane, w1.get(lane) - deltaLambdas[lane] * batch.angularResponseBody1.get(lane));
+        v2.set(lane, v2.get(lane) + batch.massInverseBody2[lane] * deltaLambdas[lane] * normal);
+        w2.set(lane, w2.get(lane) + deltaLambdas[lane] * batch.angularResponseBody2.get(lane));
+    }
+
+#endif
+}
+
+// Solve the penetration constraints of a batch
+/// The velocities of the bodies of the lanes are gathered, the Lagrange multipliers of
+/// all the lanes are computed at the same time and the velocities are scattered back.
+/**
+ * @param batch The batch of penetration constraints
+ * @param bias The bias "b" of the constraint in each lane
+ * @param impulses The accumulated impulses of the lanes
+ * @param linearVelocities Array of linear velocities of the bodies to update
+ * @param angularVelocities Array of angular velocities of the bodies to update
+ */
+void ContactSolver::solveBatch(ContactPointBatch& batch, const decimal* bias, decimal* impulses,
+                               Vector3* linearVelocities, Vector3* angularVelocities) const {
+
+    LaneVectors v1, w1, v2, w2;
+    gatherVelocities(batch, linearVelocities, angularVelocities, v1, w1, v2, w2);
+
+    decimal deltaLambdas[NB_BATCH_LANES];
+
+#ifdef REACTPHYSICS3D_SSE_ENABLED
+
+    // Compute J*v = n.(v2 - v1) + (r2 x n).w2 - (r1 x n).w1
+    const __m128 Jv = _mm_sub_ps(
+        _mm_add_ps(computeLanesDotProducts(batch.normal.x, batch.normal.y, batch.normal.z,
+                                           v2.x, v2.y, v2.z),
+                   computeLanesDotProducts(batch.r2CrossN.x, batch.r2CrossN.y, batch.r2CrossN.z,
+                                           w2.x, w2.y, w2.z)),
+        _mm_add_ps(computeLanesDotProducts(batch.normal.x, batch.normal.y, batch.normal.z,
+                                           v1.x, v1.y, v1.z),
+                   computeLanesDotProducts(batch.r1CrossN.x, batch.r1CrossN.y, batch.r1CrossN.z,
+                                           w1.x, w1.y, w1.z)));
+
+    // Compute the Lagrange multipliers lambda and clamp the accumulated impulses
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 deltaLambda = _mm_mul_ps(_mm_sub_ps(zero, _mm_add_ps(Jv, _mm_loadu_ps(bias))),
+                                          _mm_loadu_ps(batch.inversePenetrationMass));
+    const __m128 lambdaTemp = _mm_loadu_ps(impulses);
+    const __m128 lambda = _mm_max_ps(_mm_add_ps(lambdaTemp, deltaLambda), zero);
+    _mm_storeu_ps(impulses, lambda);
+    _mm_storeu_ps(deltaLambdas, _mm_sub_ps(lambda, lambdaTemp));
+
+#else
+
+    for (uint lane=0; lane<NB_BATCH_LANES; lane++) {
+
+        // Compute J*v
+        const decimal Jv = batch.normal.get(lane).dot(v2.get(lane) - v1.get(lane)) +
+                           batch.r2CrossN.get(lane).dot(w2.get(lane)) -
+                           batch.r1CrossN.get(lane).dot(w1.get(lane));
+
+        // Compute the Lagrange multiplier lambda
+        const decimal deltaLambda = -(Jv + bias[lane]) * batch.inversePenetrationMass[lane];
+        const decimal lambdaTemp = impulses[lane];
+        impulses[lane] = std::max(impulses[lane] + deltaLambda, decimal(0.0));
+        deltaLambdas[lane] = impulses[lane] - lambdaTemp;
+    }
+
+#endif
+
+    // Apply the impulses P=J^T * lambda to the bodies of the lanes
+    applyBatchImpulses(batch, deltaLambdas, v1, w1, v2, w2);
+
+    scatterVelocities(batch, linearVelocities, angularVelocities, v1, w1, v2, w2);
 }
 
 // Compute the two unit orthogonal vectors "t1" and "t2" that span the tangential friction plane
@@ -910,4 +1164,7 @@ void ContactSolver::cleanup() {
         delete[] mContactConstraints;
         mContactConstraints = NULL;
     }
+
+    // The batches are kept allocated for the next island
+    mNbContactBatches = 0;
 }
@@ -33,7 +33,6 @@
 #include "collision/ContactManifold.h"
 #include "Island.h"
 #include "Impulse.h"
-#include <map>
 #include <set>
 
 /// ReactPhysics3D namespace
@@ -108,30 +107,38 @@ namespace reactphysics3d {
  * constraints at the center of the contact manifold, we need two constraints for tangential
  * friction but also another twist friction constraint to prevent spin of the body around the
  * contact manifold center.
+ *
+ * The penetration constraints of the contact points are stored in batches (structure of
+ * arrays) of contact points that do not share any dynamic body. The constraints of a batch
+ * are solved at the same time with SIMD instructions when SSE is enabled. The friction
+ * constraints are solved afterwards for each contact manifold.
  */
 class ContactSolver {
 
     private:
 
+        // -------------------- Constants --------------------- //
+
+        /// Number of contact points that are solved together in a batch (one per SIMD lane)
+        static const uint NB_BATCH_LANES = 4;
+
+        /// Number of the last created batches in which we try to insert a new contact point
+        static const uint NB_SEARCHED_BATCHES = 16;
+
         // Structure ContactPointSolver
         /**
          * Contact solver internal data structure that to store all the
-         * information relative to a contact point
+         * information relative to a contact point. The penetration constraint
+         * of the contact point is stored in a lane of a contact point batch.
          */
         struct ContactPointSolver {
 
-            /// Accumulated normal impulse
-            decimal penetrationImpulse;
-
             /// Accumulated impulse in the 1st friction direction
             decimal friction1Impulse;
 
             /// Accumulated impulse in the 2nd friction direction
             decimal friction2Impulse;
 
-            /// Accumulated split impulse for penetration correction
-            decimal penetrationSplitImpulse;
-
             /// Accumulated rolling resistance impulse
             Vector3 rollingResistanceImpulse;
 
@@ -168,27 +175,18 @@ class ContactSolver {
             /// Cross product of r2 with 2nd friction vector
             Vector3 r2CrossT2;
 
-            /// Cross product of r1 with the contact normal
-            Vector3 r1CrossN;
-
-            /// Cross product of r2 with the contact normal
-            Vector3 r2CrossN;
-
-            /// Penetration depth
-            decimal penetrationDepth;
-
-            /// Velocity restitution bias
-            decimal restitutionBias;
-
-            /// Inverse of the matrix K for the penenetration
-            decimal inversePenetrationMass;
-
             /// Inverse of the matrix K for the 1st friction
             decimal inverseFriction1Mass;
 
             /// Inverse of the matrix K for the 2nd friction
             decimal inverseFriction2Mass;
 
+            /// Index of the batch that contains the penetration constraint
+            uint batchIndex;
+
+            /// Lane of the penetration constraint in its batch
+            uint batchLane;
+
             /// True if the contact was existing last time step
             bool isRestingContact;
 
@@ -196,6 +194,99 @@ class ContactSolver {
             ContactPoint* externalContact;
         };
 
+        // Structure LaneVectors
+        /**
+         * Coordinates of one vector for each lane of a contact point batch
+         */
+        struct LaneVectors {
+
+            /// X coordinates
+            decimal x[NB_BATCH_LANES];
+
+            /// Y coordinates
+            decimal y[NB_BATCH_LANES];
+
+            /// Z coordinates
+            decimal z[NB_BATCH_LANES];
+
+            /// Set the vector of a lane
+            void set(uint lane, const Vector3& vector) {
+                x[lane] = vector.x;
+                y[lane] = vector.y;
+                z[lane] = vector.z;
+            }
+
+            /// Return the vector of a lane
+            Vector3 get(uint lane) const {
+                return Vector3(x[lane], y[lane], z[lane]);
+            }
+        };
+
+        // Structure ContactPointBatch
+        /**
+         * Penetration constraints of several contact points stored as a structure
+         * of arrays so that they can be solved at the same time (one constraint in
+         * each SIMD lane). The contact points of a batch never share a dynamic body.
+         * Therefore, the velocities of the bodies can be gathered before solving the
+         * lanes and scattered afterwards with the same result as solving the
+         * constraints one after the other. The unused lanes have a zero inverse mass
+         * and never change the velocities.
+         */
+        struct ContactPointBatch {
+
+            /// Number of used lanes
+            uint nbContacts;
+
+            /// Index of body 1 in the constraint solver
+            uint indexBody1[NB_BATCH_LANES];
+
+            /// Index of body 2 in the constraint solver
+            uint indexBody2[NB_BATCH_LANES];
+
+            /// True if the body 1 is of type dynamic
+            bool isBody1DynamicType[NB_BATCH_LANES];
+
+            /// True if the body 2 is of type dynamic
+            bool isBody2DynamicType[NB_BATCH_LANES];
+
+            /// Normal vectors of the contacts
+            LaneVectors normal;
+
+            /// Cross products of r1 with the contact normal
+            LaneVectors r1CrossN;
+
+            /// Cross products of r2 with the contact normal
+            LaneVectors r2CrossN;
+
+            /// Inverse inertia tensors of the bodies 1 multiplied by r1CrossN
+            LaneVectors angularResponseBody1;
+
+            /// Inverse inertia tensors of the bodies 2 multiplied by r2CrossN
+            LaneVectors angularResponseBody2;
+
+            /// Inverse of the masses of the bodies 1
+            decimal massInverseBody1[NB_BATCH_LANES];
+
+            /// Inverse of the masses of the bodies 2
+            decimal massInverseBody2[NB_BATCH_LANES];
+
+            /// Inverse of the matrix K for the penetration
+            decimal inversePenetrationMass[NB_BATCH_LANES];
+
+            /// Bias of the velocity constraints (restitution and, without split
+            /// impulses, penetration depth correction)
+            decimal velocityBias[NB_BATCH_LANES];
+
+            /// Bias of the split impulse constraints (penetration depth correction)
+            decimal splitBias[NB_BATCH_LANES];
+
+            /// Accumulated normal impulses
+            decimal penetrationImpulse[NB_BATCH_LANES];
+
+            /// Accumulated split impulses for penetration correction
+            decimal penetrationSplitImpulse[NB_BATCH_LANES];
+        };
+
         // Structure ContactManifoldSolver
         /**
          * Contact solver internal data structure to store all the
@@ -311,8 +402,6 @@ class ContactSolver {
             Vector3 rollingResistanceImpulse;
         };
 
-        // -------------------- Constants --------------------- //
-
         /// Beta value for the penetration depth position correction without split impulses
         static const decimal BETA;
 
@@ -339,15 +428,21 @@ class ContactSolver {
         /// Number of contact constraints
         uint mNbContactManifolds;
 
+        /// Batches of penetration constraints
+        ContactPointBatch* mContactBatches;
+
+        /// Number of batches of penetration constraints
+        uint mNbContactBatches;
+
+        /// Number of allocated batches (reused from one island to the next)
+        uint mNbAllocatedContactBatches;
+
         /// Array of linear velocities
         Vector3* mLinearVelocities;
 
         /// Array of angular velocities
         Vector3* mAngularVelocities;
 
-        /// Reference to the map of rigid body to their index in the constrained velocities array
-        const std::map<RigidBody*, uint>& mMapBodyToConstrainedVelocityIndex;
-
         /// True if the warm starting of the solver is active
         bool mIsWarmStartingActive;
 
@@ -370,6 +465,30 @@ class ContactSolver {
         void applySplitImpulse(const Impulse& impulse,
                                const ContactManifoldSolver& manifold);
 
+        /// Insert a contact point into a batch that does not contain its dynamic bodies
+        void insertIntoBatch(ContactPointSolver& contactPoint,
+                             const ContactManifoldSolver& manifold);
+
+        /// Gather the velocities of the bodies of each lane of a batch
+        void gatherVelocities(const ContactPointBatch& batch, const Vector3* linearVelocities,
+                              const Vector3* angularVelocities, LaneVectors& v1,
+                              LaneVectors& w1, LaneVectors& v2, LaneVectors& w2) const;
+
+        /// Scatter the velocities of the bodies of each lane of a batch
+        void scatterVelocities(const ContactPointBatch& batch, Vector3* linearVelocities,
+                               Vector3* angularVelocities, const LaneVectors& v1,
+                               const LaneVectors& w1, const LaneVectors& v2,
+                               const LaneVectors& w2) const;
+
+        /// Apply a penetration impulse in each lane of a batch to the gathered velocities
+        void applyBatchImpulses(const ContactPointBatch& batch, const decimal* deltaLambdas,
+                                LaneVectors& v1, LaneVectors& w1,
+                                LaneVectors& v2, LaneVectors& w2) const;
+
+        /// Solve the penetration constraints of a batch
+        void solveBatch(ContactPointBatch& batch, const decimal* bias, decimal* impulses,
+                        Vector3* linearVelocities, Vector3* angularVelocities) const;
+
         /// Compute the collision restitution factor from the restitution factor of each body
         decimal computeMixedRestitutionFactor(RigidBody *body1,
                                               RigidBody *body2) const;
@@ -393,10 +512,6 @@ class ContactSolver {
         void computeFrictionVectors(const Vector3& deltaVelocity,
                                     ContactManifoldSolver& contactPoint) const;
 
-        /// Compute a penetration constraint impulse
-        const Impulse computePenetrationImpulse(decimal deltaLambda,
-                                                const ContactPointSolver& contactPoint) const;
-
         /// Compute the first friction constraint impulse
         const Impulse computeFriction1Impulse(decimal deltaLambda,
                                               const ContactPointSolver& contactPoint) const;
@@ -410,7 +525,7 @@ class ContactSolver {
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        ContactSolver(const std::map<RigidBody*, uint>& mapBodyToVelocityIndex);
+        ContactSolver();
 
         /// Destructor
         virtual ~ContactSolver();
@@ -442,6 +557,10 @@ class ContactSolver {
         /// Activate or Deactivate the split impulses for contacts
         void setIsSplitImpulseActive(bool isActive);
 
+        /// Return true if the friction constraints are solved at the center of
+        /// the contact manifold instead of at each contact point
+        bool isSolveFrictionAtContactManifoldCenterActive() const;
+
         /// Activate or deactivate the solving of friction constraints at the center of
         /// the contact manifold instead of solving them at each contact point
         void setIsSolveFrictionAtContactManifoldCenterActive(bool isActive);
@@ -478,6 +597,12 @@ inline void ContactSolver::setIsSplitImpulseActive(bool isActive) {
     mIsSplitImpulseActive = isActive;
 }
 
+// Return true if the friction constraints are solved at the center of
+// the contact manifold instead of at each contact point
+inline bool ContactSolver::isSolveFrictionAtContactManifoldCenterActive() const {
+    return mIsSolveFrictionAtContactManifoldCenterActive;
+}
+
 // Activate or deactivate the solving of friction constraints at the center of
 // the contact manifold instead of solving them at each contact point
 inline void ContactSolver::setIsSolveFrictionAtContactManifoldCenterActive(bool isActive) {
@@ -508,14 +633,6 @@ inline decimal ContactSolver::computeMixedRollingResistance(RigidBody* body1,
     return decimal(0.5f) * (body1->getMaterial().getRollingResistance() + body2->getMaterial().getRollingResistance());
 }
 
-// Compute a penetration constraint impulse
-inline const Impulse ContactSolver::computePenetrationImpulse(decimal deltaLambda,
-                                                          const ContactPointSolver& contactPoint)
-                                                          const {
-    return Impulse(-contactPoint.normal * deltaLambda, -contactPoint.r1CrossN * deltaLambda,
-                   contactPoint.normal * deltaLambda, contactPoint.r2CrossN * deltaLambda);
-}
-
 // Compute the first friction constraint impulse
 inline const Impulse ContactSolver::computeFriction1Impulse(decimal deltaLambda,
                                                         const ContactPointSolver& contactPoint)
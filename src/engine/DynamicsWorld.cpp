@@ -37,11 +37,10 @@ using namespace std;
 // Constructor
 /**
  * @param gravity Gravity vector in the world (in meters per second squared)
+ * @param broadPhaseType Algorithm used by the broad-phase collision detection
  */
-DynamicsWorld::DynamicsWorld(const Vector3 &gravity)
-              : CollisionWorld(),
-                mContactSolver(mMapBodyToConstrainedVelocityIndex),
-                mConstraintSolver(mMapBodyToConstrainedVelocityIndex),
+DynamicsWorld::DynamicsWorld(const Vector3 &gravity, BroadPhaseType broadPhaseType)
+              : CollisionWorld(broadPhaseType),
                 mNbVelocitySolverIterations(DEFAULT_VELOCITY_SOLVER_NB_ITERATIONS),
                 mNbPositionSolverIterations(DEFAULT_POSITION_SOLVER_NB_ITERATIONS),
                 mIsSleepingEnabled(SPLEEPING_ENABLED), mGravity(gravity),
@@ -88,6 +87,12 @@ DynamicsWorld::~DynamicsWorld() {
         mMemoryAllocator.release(mIslands, sizeof(Island*) * mNbIslandsCapacity);
     }
 
+    // Destroy the contact and constraint solvers of the worker threads
+    for (uint i=0; i<mThreadContactSolvers.size(); i++) {
+        delete mThreadContactSolvers[i];
+        delete mThreadConstraintSolvers[i];
+    }
+
     // Release the memory allocated for the bodies velocity arrays
     if (mNbBodiesCapacity > 0) {
         delete[] mSplitLinearVelocities;
@@ -151,6 +156,9 @@ void DynamicsWorld::update(decimal timeStep) {
     // Solve the position correction for constraints
     solvePositionCorrection();
 
+    // Stop the fast bodies with continuous collision detection at their time of impact
+    solveContinuousCollisions();
+
     // Update the state (positions and velocities) of the bodies
     updateBodiesState();
 
@@ -169,37 +177,106 @@ void DynamicsWorld::update(decimal timeStep) {
 void DynamicsWorld::integrateRigidBodiesPositions() {
 
     PROFILE("DynamicsWorld::integrateRigidBodiesPositions()");
-    
-    // For each island of the world
-    for (uint i=0; i < mNbIslands; i++) {
 
-        RigidBody** bodies = mIslands[i]->getBodies();
+    // Integrate the positions of the bodies of each island
+    IslandTask task(*this, &DynamicsWorld::integrateIslandPositions);
+    mThreadPool.parallelFor(mNbIslands, task);
+}
 
-        // For each body of the island
-        for (uint b=0; b < mIslands[i]->getNbBodies(); b++) {
+// Integrate position and orientation of the rigid bodies of an island
+void DynamicsWorld::integrateIslandPositions(uint threadIndex, uint islandIndex) {
 
-            // Get the constrained velocity
-            uint indexArray = mMapBodyToConstrainedVelocityIndex.find(bodies[b])->second;
-            Vector3 newLinVelocity = mConstrainedLinearVelocities[indexArray];
-            Vector3 newAngVelocity = mConstrainedAngularVelocities[indexArray];
+    RigidBody** bodies = mIslands[islandIndex]->getBodies();
 
-            // Add the split impulse velocity from Contact Solver (only used
-            // to update the position)
-            if (mContactSolver.isSplitImpulseActive()) {
+    // For each body of the island
+    for (uint b=0; b < mIslands[islandIndex]->getNbBodies(); b++) {
 
-                newLinVelocity += mSplitLinearVelocities[indexArray];
-                newAngVelocity += mSplitAngularVelocities[indexArray];
-            }
+        // The constrained position of a static body has already been set
+        // and cannot be written here because the body can be in several islands
+        if (bodies[b]->getType() == STATIC) continue;
+
+        // Get the constrained velocity
+        uint indexArray = bodies[b]->mArrayIndex;
+        Vector3 newLinVelocity = mConstrainedLinearVelocities[indexArray];
+        Vector3 newAngVelocity = mConstrainedAngularVelocities[indexArray];
+
+        // Add the split impulse velocity from Contact Solver (only used
+        // to update the position)
+        if (mContactSolver.isSplitImpulseActive()) {
+
+            newLinVelocity += mSplitLinearVelocities[indexArray];
+            newAngVelocity += mSplitAngularVelocities[indexArray];
+        }
+
+        // Get current position and orientation of the body
+        const Vector3& currentPosition = bodies[b]->mCenterOfMassWorld;
+        const Quaternion& currentOrientation = bodies[b]->getTransform().getOrientation();
+
+        // Update the new constrained position and orientation of the body
+        mConstrainedPositions[indexArray] = currentPosition + newLinVelocity * mTimeStep;
+        mConstrainedOrientations[indexArray] = currentOrientation +
+                                               Quaternion(0, newAngVelocity) *
+                                               currentOrientation * decimal(0.5) * mTimeStep;
+    }
+}
+
+// Stop the motion of the fast bodies with continuous collision detection at their time of impact
+/// The motion of each convex shape of a body with continuous collision detection during the
+/// step is swept against the other shapes (at their transforms before the step). If a shape
+/// hits another shape, the body is moved to its first time of impact instead of its new
+/// position (with a small penetration of the margins) and keeps its velocity. The contact
+/// is then found and solved by the discrete collision detection of the next step. A shape
+/// that moves less than half of its smallest extent during the step is not swept because
+/// the discrete collision detection cannot miss its contacts.
+void DynamicsWorld::solveContinuousCollisions() {
+
+    PROFILE("DynamicsWorld::solveContinuousCollisions()");
 
-            // Get current position and orientation of the body
-            const Vector3& currentPosition = bodies[b]->mCenterOfMassWorld;
-            const Quaternion& currentOrientation = bodies[b]->getTransform().getOrientation();
+    // For each island of the world
+    for (uint islandIndex = 0; islandIndex < mNbIslands; islandIndex++) {
+
+        RigidBody** bodies = mIslands[islandIndex]->getBodies();
+
+        for (uint b=0; b < mIslands[islandIndex]->getNbBodies(); b++) {
 
-            // Update the new constrained position and orientation of the body
-            mConstrainedPositions[indexArray] = currentPosition + newLinVelocity * mTimeStep;
-            mConstrainedOrientations[indexArray] = currentOrientation +
-                                                   Quaternion(0, newAngVelocity) *
-                                                   currentOrientation * decimal(0.5) * mTimeStep;
+            RigidBody* body = bodies[b];
+            if (!body->isCCDEnabled() || body->getType() != DYNAMIC) continue;
+
+            // Compute the transforms of the body before and after the step
+            const uint index = body->mArrayIndex;
+            const Transform fromTransform = body->getTransform();
+            const Quaternion toOrientation = mConstrainedOrientations[index].getUnit();
+            const Transform toTransform(mConstrainedPositions[index] - toOrientation * body->mCenterOfMassLocal,
+                                        toOrientation);
+
+            // Compute the first time of impact of the fast shapes of the body
+            decimal timeOfImpact = decimal(1.0);
+            for (ProxyShape* shape = body->getProxyShapesList(); shape != NULL; shape = shape->getNext()) {
+
+                Vector3 minBounds;
+                Vector3 maxBounds;
+                shape->getCollisionShape()->getLocalBounds(minBounds, maxBounds);
+                const Vector3 extent = maxBounds - minBounds;
+                const decimal minHalfExtent = decimal(0.5) * std::min(extent.x, std::min(extent.y, extent.z));
+                const Vector3& shapePosition = shape->getLocalToBodyTransform().getPosition();
+                const Vector3 displacement = toTransform * shapePosition - fromTransform * shapePosition;
+                if (displacement.lengthSquare() < minHalfExtent * minHalfExtent) continue;
+
+                decimal shapeTimeOfImpact;
+                if (mCollisionDetection.computeFirstTimeOfImpact(shape, fromTransform, toTransform,
+                                                                 shapeTimeOfImpact) &&
+                    shapeTimeOfImpact < timeOfImpact) {
+                    timeOfImpact = shapeTimeOfImpact;
+                }
+            }
+
+            // Move the body to its time of impact
+            if (timeOfImpact < decimal(1.0)) {
+                const Transform transform = Transform::interpolateTransforms(fromTransform, toTransform,
+                                                                             timeOfImpact);
+                mConstrainedPositions[index] = transform * body->mCenterOfMassLocal;
+                mConstrainedOrientations[index] = transform.getOrientation();
+            }
         }
     }
 }
@@ -217,7 +294,10 @@ void DynamicsWorld::updateBodiesState() {
 
         for (uint b=0; b < mIslands[islandIndex]->getNbBodies(); b++) {
 
-            uint index = mMapBodyToConstrainedVelocityIndex.find(bodies[b])->second;
+            // A static body does not move
+            if (bodies[b]->getType() == STATIC) continue;
+
+            uint index = bodies[b]->mArrayIndex;
 
             // Update the linear and angular velocity of the body
             bodies[b]->mLinearVelocity = mConstrainedLinearVelocities[index];
@@ -270,15 +350,19 @@ void DynamicsWorld::initVelocityArrays() {
         mSplitAngularVelocities[i].setToZero();
     }
 
-    // Initialize the map of body indexes in the velocity arrays
-    mMapBodyToConstrainedVelocityIndex.clear();
+    // A static body can be part of several islands. Therefore, its constrained
+    // state is initialized here and is never modified while solving the islands
+    // (which can be done concurrently).
     std::set<RigidBody*>::const_iterator it;
-    uint indexBody = 0;
     for (it = mRigidBodies.begin(); it != mRigidBodies.end(); ++it) {
 
-        // Add the body into the map
-        mMapBodyToConstrainedVelocityIndex.insert(std::make_pair(*it, indexBody));
-        indexBody++;
+        if ((*it)->getType() == STATIC) {
+            uint indexBody = (*it)->mArrayIndex;
+            mConstrainedLinearVelocities[indexBody] = (*it)->mLinearVelocity;
+            mConstrainedAngularVelocities[indexBody] = (*it)->mAngularVelocity;
+            mConstrainedPositions[indexBody] = (*it)->mCenterOfMassWorld;
+            mConstrainedOrientations[indexBody] = (*it)->getTransform().getOrientation();
+        }
     }
 }
 
@@ -294,57 +378,92 @@ void DynamicsWorld::integrateRigidBodiesVelocities() {
     // Initialize the bodies velocity arrays
     initVelocityArrays();
 
-    // For each island of the world
-    for (uint i=0; i < mNbIslands; i++) {
+    // Integrate the velocities of the bodies of each island
+    IslandTask task(*this, &DynamicsWorld::integrateIslandVelocities);
+    mThreadPool.parallelFor(mNbIslands, task);
+}
 
-        RigidBody** bodies = mIslands[i]->getBodies();
+// Integrate the velocities of the rigid bodies of an island
+void DynamicsWorld::integrateIslandVelocities(uint threadIndex, uint islandIndex) {
 
-        // For each body of the island
-        for (uint b=0; b < mIslands[i]->getNbBodies(); b++) {
+    RigidBody** bodies = mIslands[islandIndex]->getBodies();
 
-            // Insert the body into the map of constrained velocities
-            uint indexBody = mMapBodyToConstrainedVelocityIndex.find(bodies[b])->second;
+    // For each body of the island
+    for (uint b=0; b < mIslands[islandIndex]->getNbBodies(); b++) {
 
-            assert(mSplitLinearVelocities[indexBody] == Vector3(0, 0, 0));
-            assert(mSplitAngularVelocities[indexBody] == Vector3(0, 0, 0));
+        // The constrained velocity of a static body has already been set
+        // and cannot be written here because the body can be in several islands
+        if (bodies[b]->getType() == STATIC) continue;
 
-            // Integrate the external force to get the new velocity of the body
-            mConstrainedLinearVelocities[indexBody] = bodies[b]->getLinearVelocity() +
-                                        mTimeStep * bodies[b]->mMassInverse * bodies[b]->mExternalForce;
-            mConstrainedAngularVelocities[indexBody] = bodies[b]->getAngularVelocity() +
-                                        mTimeStep * bodies[b]->getInertiaTensorInverseWorld() *
-                                        bodies[b]->mExternalTorque;
+        // Get the index of the body in the constrained velocities array
+        uint indexBody = bodies[b]->mArrayIndex;
 
-            // If the gravity has to be applied to this rigid body
-            if (bodies[b]->isGravityEnabled() && mIsGravityEnabled) {
+        assert(mSplitLinearVelocities[indexBody] == Vector3(0, 0, 0));
+        assert(mSplitAngularVelocities[indexBody] == Vector3(0, 0, 0));
 
-                // Integrate the gravity force
-                mConstrainedLinearVelocities[indexBody] += mTimeStep * bodies[b]->mMassInverse *
-                        bodies[b]->getMass() * mGravity;
-            }
+        // Integrate the external force to get the new velocity of the body
+        mConstrainedLinearVelocities[indexBody] = bodies[b]->getLinearVelocity() +
+                                    mTimeStep * bodies[b]->mMassInverse * bodies[b]->mExternalForce;
+        mConstrainedAngularVelocities[indexBody] = bodies[b]->getAngularVelocity() +
+                                    mTimeStep * bodies[b]->getInertiaTensorInverseWorld() *
+                                    bodies[b]->mExternalTorque;
 
-            // Apply the velocity damping
-            // Damping force : F_c = -c' * v (c=damping factor)
-            // Equation      : m * dv/dt = -c' * v
-            //                 => dv/dt = -c * v (with c=c'/m)
-            //                 => dv/dt + c * v = 0
-            // Solution      : v(t) = v0 * e^(-c * t)
-            //                 => v(t + dt) = v0 * e^(-c(t + dt))
-            //                              = v0 * e^(-ct) * e^(-c * dt)
-            //                              = v(t) * e^(-c * dt)
-            //                 => v2 = v1 * e^(-c * dt)
-            // Using Taylor Serie for e^(-x) : e^x ~ 1 + x + x^2/2! + ...
-            //                              => e^(-x) ~ 1 - x
-            //                 => v2 = v1 * (1 - c * dt)
-            decimal linDampingFactor = bodies[b]->getLinearDamping();
-            decimal angDampingFactor = bodies[b]->getAngularDamping();
-            decimal linearDamping = pow(decimal(1.0) - linDampingFactor, mTimeStep);
-            decimal angularDamping = pow(decimal(1.0) - angDampingFactor, mTimeStep);
-            mConstrainedLinearVelocities[indexBody] *= linearDamping;
-            mConstrainedAngularVelocities[indexBody] *= angularDamping;
-
-            indexBody++;
+        // If the gravity has to be applied to this rigid body
+        if (bodies[b]->isGravityEnabled() && mIsGravityEnabled) {
+
+            // Integrate the gravity force
+            mConstrainedLinearVelocities[indexBody] += mTimeStep * bodies[b]->mMassInverse *
+                    bodies[b]->getMass() * mGravity;
         }
+
+        // Apply the velocity damping
+        // Damping force : F_c = -c' * v (c=damping factor)
+        // Equation      : m * dv/dt = -c' * v
+        //                 => dv/dt = -c * v (with c=c'/m)
+        //                 => dv/dt + c * v = 0
+        // Solution      : v(t) = v0 * e^(-c * t)
+        //                 => v(t + dt) = v0 * e^(-c(t + dt))
+        //                              = v0 * e^(-ct) * e^(-c * dt)
+        //                              = v(t) * e^(-c * dt)
+        //                 => v2 = v1 * e^(-c * dt)
+        // Using Taylor Serie for e^(-x) : e^x ~ 1 + x + x^2/2! + ...
+        //                              => e^(-x) ~ 1 - x
+        //                 => v2 = v1 * (1 - c * dt)
+        decimal linDampingFactor = bodies[b]->getLinearDamping();
+        decimal angDampingFactor = bodies[b]->getAngularDamping();
+        decimal linearDamping = pow(decimal(1.0) - linDampingFactor, mTimeStep);
+        decimal angularDamping = pow(decimal(1.0) - angDampingFactor, mTimeStep);
+        mConstrainedLinearVelocities[indexBody] *= linearDamping;
+        mConstrainedAngularVelocities[indexBody] *= angularDamping;
+    }
+}
+
+// Create the contact and constraint solvers of the worker threads if needed
+void DynamicsWorld::initThreadSolvers() {
+
+    // Create the missing solvers (one for each worker thread of the pool)
+    while (mThreadContactSolvers.size() + 1 < mThreadPool.getNbThreads()) {
+        mThreadContactSolvers.push_back(new ContactSolver());
+        mThreadConstraintSolvers.push_back(new ConstraintSolver());
+    }
+
+    // For each solver
+    for (uint i=0; i<mThreadContactSolvers.size(); i++) {
+
+        // Use the same settings as the solvers of the calling thread
+        mThreadContactSolvers[i]->setIsSplitImpulseActive(mContactSolver.isSplitImpulseActive());
+        mThreadContactSolvers[i]->setIsSolveFrictionAtContactManifoldCenterActive(
+                    mContactSolver.isSolveFrictionAtContactManifoldCenterActive());
+
+        // Set the velocities arrays
+        mThreadContactSolvers[i]->setSplitVelocitiesArrays(mSplitLinearVelocities,
+                                                           mSplitAngularVelocities);
+        mThreadContactSolvers[i]->setConstrainedVelocitiesArrays(mConstrainedLinearVelocities,
+                                                                 mConstrainedAngularVelocities);
+        mThreadConstraintSolvers[i]->setConstrainedVelocitiesArrays(mConstrainedLinearVelocities,
+                                                                    mConstrainedAngularVelocities);
+        mThreadConstraintSolvers[i]->setConstrainedPositionsArrays(mConstrainedPositions,
+                                                                   mConstrainedOrientations);
     }
 }
 
@@ -362,51 +481,61 @@ void DynamicsWorld::solveContactsAndConstraints() {
     mConstraintSolver.setConstrainedPositionsArrays(mConstrainedPositions,
                                                     mConstrainedOrientations);
 
+    // Initialize the solvers of the worker threads
+    initThreadSolvers();
+
     // ---------- Solve velocity constraints for joints and contacts ---------- //
 
-    // For each island of the world
-    for (uint islandIndex = 0; islandIndex < mNbIslands; islandIndex++) {
+    // Solve the islands (each island only modifies the state of its own dynamic bodies)
+    IslandTask task(*this, &DynamicsWorld::solveIslandContactsAndConstraints);
+    mThreadPool.parallelFor(mNbIslands, task);
+}
 
-        // Check if there are contacts and constraints to solve
-        bool isConstraintsToSolve = mIslands[islandIndex]->getNbJoints() > 0;
-        bool isContactsToSolve = mIslands[islandIndex]->getNbContactManifolds() > 0;
-        if (!isConstraintsToSolve && !isContactsToSolve) continue;
+// Solve the contacts and constraints of an island
+void DynamicsWorld::solveIslandContactsAndConstraints(uint threadIndex, uint islandIndex) {
 
-        // If there are contacts in the current island
-        if (isContactsToSolve) {
+    ContactSolver& contactSolver = getContactSolver(threadIndex);
+    ConstraintSolver& constraintSolver = getConstraintSolver(threadIndex);
 
-            // Initialize the solver
-            mContactSolver.initializeForIsland(mTimeStep, mIslands[islandIndex]);
+    // Check if there are contacts and constraints to solve
+    bool isConstraintsToSolve = mIslands[islandIndex]->getNbJoints() > 0;
+    bool isContactsToSolve = mIslands[islandIndex]->getNbContactManifolds() > 0;
+    if (!isConstraintsToSolve && !isContactsToSolve) return;
 
-            // Warm start the contact solver
-            mContactSolver.warmStart();
-        }
+    // If there are contacts in the current island
+    if (isContactsToSolve) {
 
-        // If there are constraints
-        if (isConstraintsToSolve) {
+        // Initialize the solver
+        contactSolver.initializeForIsland(mTimeStep, mIslands[islandIndex]);
 
-            // Initialize the constraint solver
-            mConstraintSolver.initializeForIsland(mTimeStep, mIslands[islandIndex]);
-        }
+        // Warm start the contact solver
+        contactSolver.warmStart();
+    }
 
-        // For each iteration of the velocity solver
-        for (uint i=0; i<mNbVelocitySolverIterations; i++) {
+    // If there are constraints
+    if (isConstraintsToSolve) {
 
-            // Solve the constraints
-            if (isConstraintsToSolve) {
-                mConstraintSolver.solveVelocityConstraints(mIslands[islandIndex]);
-            }
+        // Initialize the constraint solver
+        constraintSolver.initializeForIsland(mTimeStep, mIslands[islandIndex]);
+    }
 
-            // Solve the contacts
-            if (isContactsToSolve) mContactSolver.solve();
-        }        
+    // For each iteration of the velocity solver
+    for (uint i=0; i<mNbVelocitySolverIterations; i++) {
 
-        // Cache the lambda values in order to use them in the next
-        // step and cleanup the contact solver
-        if (isContactsToSolve) {
-            mContactSolver.storeImpulses();
-            mContactSolver.cleanup();
+        // Solve the constraints
+        if (isConstraintsToSolve) {
+            constraintSolver.solveVelocityConstraints(mIslands[islandIndex]);
         }
+
+        // Solve the contacts
+        if (isContactsToSolve) contactSolver.solve();
+    }
+
+    // Cache the lambda values in order to use them in the next
+    // step and cleanup the contact solver
+    if (isContactsToSolve) {
+        contactSolver.storeImpulses();
+        contactSolver.cleanup();
     }
 }
 
@@ -418,17 +547,26 @@ void DynamicsWorld::solvePositionCorrection() {
     // Do not continue if there is no constraints
     if (mJoints.empty()) return;
 
-    // For each island of the world
-    for (uint islandIndex = 0; islandIndex < mNbIslands; islandIndex++) {
+    // Solve the position error correction of each island
+    IslandTask task(*this, &DynamicsWorld::solveIslandPositionCorrection);
+    mThreadPool.parallelFor(mNbIslands, task);
+}
 
-        // ---------- Solve the position error correction for the constraints ---------- //
+// Solve the position error correction of the constraints of an island
+void DynamicsWorld::solveIslandPositionCorrection(uint threadIndex, uint islandIndex) {
 
-        // For each iteration of the position (error correction) solver
-        for (uint i=0; i<mNbPositionSolverIterations; i++) {
+    // Do not continue if there is no constraints in the island
+    if (mIslands[islandIndex]->getNbJoints() == 0) return;
 
-            // Solve the position constraints
-            mConstraintSolver.solvePositionConstraints(mIslands[islandIndex]);
-        }
+    ConstraintSolver& constraintSolver = getConstraintSolver(threadIndex);
+
+    // ---------- Solve the position error correction for the constraints ---------- //
+
+    // For each iteration of the position (error correction) solver
+    for (uint i=0; i<mNbPositionSolverIterations; i++) {
+
+        // Solve the position constraints
+        constraintSolver.solvePositionConstraints(mIslands[islandIndex]);
     }
 }
 
@@ -490,6 +628,28 @@ void DynamicsWorld::destroyRigidBody(RigidBody* rigidBody) {
     mMemoryAllocator.release(rigidBody, sizeof(RigidBody));
 }
 
+// Destroy many rigid bodies and all the joints which they belong at once
+/// The collision shapes of all the bodies are removed from the collision detection
+/// together, which is much faster than destroying the bodies one by one when a large
+/// number of bodies is destroyed.
+/**
+ * @param rigidBodies The rigid bodies to destroy
+ */
+void DynamicsWorld::destroyRigidBodies(const std::vector<RigidBody*>& rigidBodies) {
+
+    // Remove the collision shapes of all the bodies from the collision detection
+    std::vector<ProxyShape*> proxyShapes;
+    for (uint i=0; i<rigidBodies.size(); i++) {
+        collectProxyShapesToRemove(rigidBodies[i], proxyShapes);
+    }
+    mCollisionDetection.removeProxyCollisionShapes(proxyShapes);
+
+    // Destroy the bodies and their joints
+    for (uint i=0; i<rigidBodies.size(); i++) {
+        destroyRigidBody(rigidBodies[i]);
+    }
+}
+
 // Create a joint between two bodies in the world and return a pointer to the new joint
 /**
  * @param jointInfo The information that is necessary to create the joint
@@ -652,9 +812,13 @@ void DynamicsWorld::computeIslands() {
     int nbContactManifolds = 0;
 
     // Reset all the isAlreadyInIsland variables of bodies, joints and contact manifolds
+    // and assign to each body its index in the constrained velocities and positions arrays
+    uint arrayIndex = 0;
     for (std::set<RigidBody*>::iterator it = mRigidBodies.begin(); it != mRigidBodies.end(); ++it) {
         int nbBodyManifolds = (*it)->resetIsAlreadyInIslandAndCountManifolds();
         nbContactManifolds += nbBodyManifolds;
+        (*it)->mArrayIndex = arrayIndex;
+        arrayIndex++;
     }
     for (std::set<Joint*>::iterator it = mJoints.begin(); it != mJoints.end(); ++it) {
         (*it)->mIsAlreadyInIsland = false;
@@ -976,11 +1140,10 @@ std::vector<const ContactManifold*> DynamicsWorld::getContactsList() const {
     std::vector<const ContactManifold*> contactManifolds;
 
     // For each currently overlapping pair of bodies
-    std::map<overlappingpairid, OverlappingPair*>::const_iterator it;
-    for (it = mCollisionDetection.mOverlappingPairs.begin();
-         it != mCollisionDetection.mOverlappingPairs.end(); ++it) {
+    const OverlappingPairMap& overlappingPairs = mCollisionDetection.mOverlappingPairs;
+    for (uint p=0; p < overlappingPairs.getNbPairs(); p++) {
 
-        OverlappingPair* pair = it->second;
+        OverlappingPair* pair = overlappingPairs.getPair(p);
 
         // For each contact manifold of the pair
         const ContactManifoldSet& manifoldSet = pair->getContactManifoldSet();
@@ -38,6 +38,48 @@
 /// Namespace ReactPhysics3D
 namespace reactphysics3d {
 
+// Declarations
+class DynamicsWorld;
+
+// Class IslandTask
+/**
+ * This class is a parallel task that calls a given method of the dynamics
+ * world for each island of the world. It is used to process the islands
+ * concurrently with the thread pool of the world.
+ */
+class IslandTask : public ParallelTask {
+
+    public :
+
+        /// Type of the dynamics world method called for each island
+        typedef void (DynamicsWorld::*IslandMethod)(uint threadIndex, uint islandIndex);
+
+    private :
+
+        // -------------------- Attributes -------------------- //
+
+        /// Reference to the dynamics world
+        DynamicsWorld& mWorld;
+
+        /// Method of the world to call for each island
+        IslandMethod mMethod;
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        IslandTask(DynamicsWorld& world, IslandMethod method)
+            : mWorld(world), mMethod(method) {
+
+        }
+
+        /// Call the method of the world for a given island
+        virtual void execute(uint threadIndex, uint itemIndex) {
+            (mWorld.*mMethod)(threadIndex, itemIndex);
+        }
+};
+
 // Class DynamicsWorld
 /**
  * This class represents a dynamics world. This class inherits from
@@ -56,6 +98,14 @@ class DynamicsWorld : public CollisionWorld {
         /// Constraint solver
         ConstraintSolver mConstraintSolver;
 
+        /// Contact solvers used by the worker threads of the thread pool (the
+        /// calling thread uses the "mContactSolver" solver)
+        std::vector<ContactSolver*> mThreadContactSolvers;
+
+        /// Constraint solvers used by the worker threads of the thread pool (the
+        /// calling thread uses the "mConstraintSolver" solver)
+        std::vector<ConstraintSolver*> mThreadConstraintSolvers;
+
         /// Number of iterations for the velocity solver of the Sequential Impulses technique
         uint mNbVelocitySolverIterations;
 
@@ -100,9 +150,6 @@ class DynamicsWorld : public CollisionWorld {
         /// Array of constrained rigid bodies orientation (for position error correction)
         Quaternion* mConstrainedOrientations;
 
-        /// Map body to their index in the constrained velocities array
-        std::map<RigidBody*, uint> mMapBodyToConstrainedVelocityIndex;
-
         /// Number of islands in the world
         uint mNbIslands;
 
@@ -136,6 +183,9 @@ class DynamicsWorld : public CollisionWorld {
         /// Integrate the positions and orientations of rigid bodies.
         void integrateRigidBodiesPositions();
 
+        /// Integrate the positions and orientations of the rigid bodies of an island
+        void integrateIslandPositions(uint threadIndex, uint islandIndex);
+
         /// Update the AABBs of the bodies
         void updateRigidBodiesAABB();
 
@@ -155,12 +205,33 @@ class DynamicsWorld : public CollisionWorld {
         /// Integrate the velocities of rigid bodies.
         void integrateRigidBodiesVelocities();
 
+        /// Integrate the velocities of the rigid bodies of an island
+        void integrateIslandVelocities(uint threadIndex, uint islandIndex);
+
         /// Solve the contacts and constraints
         void solveContactsAndConstraints();
 
+        /// Solve the contacts and constraints of an island
+        void solveIslandContactsAndConstraints(uint threadIndex, uint islandIndex);
+
         /// Solve the position error correction of the constraints
         void solvePositionCorrection();
 
+        /// Solve the position error correction of the constraints of an island
+        void solveIslandPositionCorrection(uint threadIndex, uint islandIndex);
+
+        /// Stop the motion of the fast bodies with continuous collision detection at their time of impact
+        void solveContinuousCollisions();
+
+        /// Create the contact and constraint solvers of the worker threads if needed
+        void initThreadSolvers();
+
+        /// Return the contact solver used by a given thread of the thread pool
+        ContactSolver& getContactSolver(uint threadIndex);
+
+        /// Return the constraint solver used by a given thread of the thread pool
+        ConstraintSolver& getConstraintSolver(uint threadIndex);
+
         /// Cleanup the constrained velocities array at each step
         void cleanupConstrainedVelocitiesArray();
 
@@ -181,7 +252,7 @@ class DynamicsWorld : public CollisionWorld {
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        DynamicsWorld(const Vector3& mGravity);
+        DynamicsWorld(const Vector3& mGravity, BroadPhaseType broadPhaseType = DYNAMIC_AABB_TREE);
 
         /// Destructor
         virtual ~DynamicsWorld();
@@ -217,6 +288,9 @@ class DynamicsWorld : public CollisionWorld {
         /// Destroy a rigid body and all the joints which it belongs
         void destroyRigidBody(RigidBody* rigidBody);
 
+        /// Destroy many rigid bodies and all the joints which they belong at once
+        void destroyRigidBodies(const std::vector<RigidBody*>& rigidBodies);
+
         /// Create a joint between two bodies in the world and return a pointer to the new joint
         Joint* createJoint(const JointInfo& jointInfo);
 
@@ -316,6 +390,20 @@ inline void DynamicsWorld::resetBodiesForceAndTorque() {
     }
 }
 
+// Return the contact solver used by a given thread of the thread pool
+inline ContactSolver& DynamicsWorld::getContactSolver(uint threadIndex) {
+    if (threadIndex == 0) return mContactSolver;
+    assert(threadIndex <= mThreadContactSolvers.size());
+    return *mThreadContactSolvers[threadIndex - 1];
+}
+
+// Return the constraint solver used by a given thread of the thread pool
+inline ConstraintSolver& DynamicsWorld::getConstraintSolver(uint threadIndex) {
+    if (threadIndex == 0) return mConstraintSolver;
+    assert(threadIndex <= mThreadConstraintSolvers.size());
+    return *mThreadConstraintSolvers[threadIndex - 1];
+}
+
 // Get the number of iterations for the velocity constraint solver
 inline uint DynamicsWorld::getNbIterationsVelocitySolver() const {
     return mNbVelocitySolverIterations;
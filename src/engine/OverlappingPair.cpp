@@ -31,13 +31,23 @@ using namespace reactphysics3d;
 
 // Constructor
 OverlappingPair::OverlappingPair(ProxyShape* shape1, ProxyShape* shape2,
-                                 int nbMaxContactManifolds, MemoryAllocator& memoryAllocator)
-                : mContactManifoldSet(shape1, shape2, memoryAllocator, nbMaxContactManifolds),
-                  mCachedSeparatingAxis(1.0, 1.0, 1.0) {
+                                 int nbMaxContactManifolds, ContactManifoldPool& manifoldPool)
+                : mContactManifoldSet(shape1, shape2, manifoldPool, nbMaxContactManifolds),
+                  mCachedSeparatingAxis(1.0, 1.0, 1.0), mNbCachedSimplexPoints(0),
+                  mNbGJKIterations(0), mCachedSATFeatureType(SAT_NO_FEATURE),
+                  mCachedSATFeatureIndex1(0), mCachedSATFeatureIndex2(0),
+                  mCachedCollisionData1(NULL), mCachedCollisionData2(NULL) {
     
 }
 
 // Destructor
 OverlappingPair::~OverlappingPair() {
-    
+
+    // Release the cached collision data of the shapes
+    if (mCachedCollisionData1 != NULL) {
+        free(mCachedCollisionData1);
+    }
+    if (mCachedCollisionData2 != NULL) {
+        free(mCachedCollisionData2);
+    }
 }                                  
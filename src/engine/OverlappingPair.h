@@ -37,6 +37,13 @@ namespace reactphysics3d {
 // Type for the overlapping pair ID
 typedef std::pair<uint, uint> overlappingpairid;
 
+/// Type of the features of a separating axis found by the SAT algorithm
+/// SAT_NO_FEATURE : No separating axis has been found
+/// SAT_FACE_SHAPE1 : Normal of a face of the first shape
+/// SAT_FACE_SHAPE2 : Normal of a face of the second shape
+/// SAT_EDGES : Cross product of an edge of each shape
+enum SATFeatureType {SAT_NO_FEATURE, SAT_FACE_SHAPE1, SAT_FACE_SHAPE2, SAT_EDGES};
+
 // Class OverlappingPair
 /**
  * This class represents a pair of two proxy collision shapes that are overlapping
@@ -56,7 +63,38 @@ class OverlappingPair {
 
         /// Cached previous separating axis
         Vector3 mCachedSeparatingAxis;
-        
+
+        /// Number of points of the cached GJK simplex
+        uint mNbCachedSimplexPoints;
+
+        /// Support points of the first shape of the cached GJK simplex (in local-space
+        /// of the first shape)
+        Vector3 mCachedSimplexPointsA[4];
+
+        /// Support points of the second shape of the cached GJK simplex (in local-space
+        /// of the second shape)
+        Vector3 mCachedSimplexPointsB[4];
+
+        /// Number of GJK iterations during the last collision test of the pair
+        uint mNbGJKIterations;
+
+        /// Type of the features of the separating axis found by the SAT algorithm
+        /// during the last collision test of the pair
+        SATFeatureType mCachedSATFeatureType;
+
+        /// Index of the feature of the first shape of the cached separating axis
+        uint mCachedSATFeatureIndex1;
+
+        /// Index of the feature of the second shape of the cached separating axis
+        uint mCachedSATFeatureIndex2;
+
+        /// Cached collision data of the first shape for this pair (e.g. the last support
+        /// vertex of a convex mesh)
+        void* mCachedCollisionData1;
+
+        /// Cached collision data of the second shape for this pair
+        void* mCachedCollisionData2;
+
         // -------------------- Methods -------------------- //
 
         /// Private copy-constructor
@@ -71,7 +109,7 @@ class OverlappingPair {
 
         /// Constructor
         OverlappingPair(ProxyShape* shape1, ProxyShape* shape2,
-                        int nbMaxContactManifolds, MemoryAllocator& memoryAllocator);
+                        int nbMaxContactManifolds, ContactManifoldPool& manifoldPool);
 
         /// Destructor
         ~OverlappingPair();
@@ -83,17 +121,47 @@ class OverlappingPair {
         ProxyShape* getShape2() const;
 
         /// Add a contact to the contact cache
-        void addContact(ContactPoint* contact);
+        void addContact(const ContactPointInfo& contactInfo);
 
         /// Update the contact cache
         void update();
 
+        /// Remove the contacts that have not been generated again by the narrow-phase
+        void removeObsoleteContacts();
+
         /// Return the cached separating axis
         Vector3 getCachedSeparatingAxis() const;
 
         /// Set the cached separating axis
         void setCachedSeparatingAxis(const Vector3& axis);
 
+        /// Return the support points of the cached GJK simplex
+        uint getCachedSimplex(Vector3* suppPointsA, Vector3* suppPointsB) const;
+
+        /// Set the support points of the cached GJK simplex
+        void setCachedSimplex(uint nbPoints, const Vector3* suppPointsA, const Vector3* suppPointsB);
+
+        /// Return the number of GJK iterations during the last collision test of the pair
+        uint getNbGJKIterations() const;
+
+        /// Reset the number of GJK iterations before a collision test of the pair
+        void resetNbGJKIterations();
+
+        /// Increment the number of GJK iterations of the current collision test of the pair
+        void incrementNbGJKIterations();
+
+        /// Return the features of the separating axis cached by the SAT algorithm
+        SATFeatureType getCachedSATFeature(uint& featureIndex1, uint& featureIndex2) const;
+
+        /// Set the features of the separating axis cached by the SAT algorithm
+        void setCachedSATFeature(SATFeatureType featureType, uint featureIndex1, uint featureIndex2);
+
+        /// Return a pointer to the cached collision data of the first shape for this pair
+        void** getCachedCollisionData1();
+
+        /// Return a pointer to the cached collision data of the second shape for this pair
+        void** getCachedCollisionData2();
+
         /// Return the number of contacts in the cache
         uint getNbContactPoints() const;
 
@@ -125,8 +193,8 @@ inline ProxyShape* OverlappingPair::getShape2() const {
 }                
 
 // Add a contact to the contact manifold
-inline void OverlappingPair::addContact(ContactPoint* contact) {
-    mContactManifoldSet.addContactPoint(contact);
+inline void OverlappingPair::addContact(const ContactPointInfo& contactInfo) {
+    mContactManifoldSet.addContactPoint(contactInfo);
 }
 
 // Update the contact manifold
@@ -134,6 +202,11 @@ inline void OverlappingPair::update() {
     mContactManifoldSet.update();
 }
 
+// Remove the contacts that have not been generated again by the narrow-phase
+inline void OverlappingPair::removeObsoleteContacts() {
+    mContactManifoldSet.removeObsoleteContactPoints();
+}
+
 // Return the cached separating axis
 inline Vector3 OverlappingPair::getCachedSeparatingAxis() const {
     return mCachedSeparatingAxis;
@@ -144,6 +217,79 @@ inline void OverlappingPair::setCachedSeparatingAxis(const Vector3& axis) {
     mCachedSeparatingAxis = axis;
 }
 
+// Return the support points of the cached GJK simplex
+/**
+ * @param[out] suppPointsA Support points of the first shape (in local-space of the shape)
+ * @param[out] suppPointsB Support points of the second shape (in local-space of the shape)
+ * @return The number of points of the cached simplex
+ */
+inline uint OverlappingPair::getCachedSimplex(Vector3* suppPointsA, Vector3* suppPointsB) const {
+    for (uint i=0; i<mNbCachedSimplexPoints; i++) {
+        suppPointsA[i] = mCachedSimplexPointsA[i];
+        suppPointsB[i] = mCachedSimplexPointsB[i];
+    }
+    return mNbCachedSimplexPoints;
+}
+
+// Set the support points of the cached GJK simplex
+inline void OverlappingPair::setCachedSimplex(uint nbPoints, const Vector3* suppPointsA,
+                                              const Vector3* suppPointsB) {
+    assert(nbPoints <= 4);
+    for (uint i=0; i<nbPoints; i++) {
+        mCachedSimplexPointsA[i] = suppPointsA[i];
+        mCachedSimplexPointsB[i] = suppPointsB[i];
+    }
+    mNbCachedSimplexPoints = nbPoints;
+}
+
+// Return the number of GJK iterations during the last collision test of the pair
+inline uint OverlappingPair::getNbGJKIterations() const {
+    return mNbGJKIterations;
+}
+
+// Reset the number of GJK iterations before a collision test of the pair
+inline void OverlappingPair::resetNbGJKIterations() {
+    mNbGJKIterations = 0;
+}
+
+// Increment the number of GJK iterations of the current collision test of the pair
+inline void OverlappingPair::incrementNbGJKIterations() {
+    mNbGJKIterations++;
+}
+
+// Return the features of the separating axis cached by the SAT algorithm
+/**
+ * @param[out] featureIndex1 Index of the face or edge of the first shape
+ * @param[out] featureIndex2 Index of the edge of the second shape (or of its face)
+ * @return The type of the features of the cached separating axis
+ */
+inline SATFeatureType OverlappingPair::getCachedSATFeature(uint& featureIndex1,
+                                                           uint& featureIndex2) const {
+    featureIndex1 = mCachedSATFeatureIndex1;
+    featureIndex2 = mCachedSATFeatureIndex2;
+    return mCachedSATFeatureType;
+}
+
+// Set the features of the separating axis cached by the SAT algorithm
+inline void OverlappingPair::setCachedSATFeature(SATFeatureType featureType, uint featureIndex1,
+                                                 uint featureIndex2) {
+    mCachedSATFeatureType = featureType;
+    mCachedSATFeatureIndex1 = featureIndex1;
+    mCachedSATFeatureIndex2 = featureIndex2;
+}
+
+// Return a pointer to the cached collision data of the first shape for this pair
+/// Contrary to the cached collision data of the proxy shape, this data is only used by
+/// the collision tests of this pair and can therefore be used when several pairs of the
+/// same proxy shape are tested concurrently.
+inline void** OverlappingPair::getCachedCollisionData1() {
+    return &mCachedCollisionData1;
+}
+
+// Return a pointer to the cached collision data of the second shape for this pair
+inline void** OverlappingPair::getCachedCollisionData2() {
+    return &mCachedCollisionData2;
+}
 
 // Return the number of contact points in the contact manifold
 inline uint OverlappingPair::getNbContactPoints() const {
@@ -0,0 +1,184 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "OverlappingPairMap.h"
+
+using namespace reactphysics3d;
+
+// Constructor
+OverlappingPairMap::OverlappingPairMap()
+                   : mPairIDs(NULL), mPairs(NULL), mNbPairs(0), mNbAllocatedPairs(0),
+                     mSlots(NULL), mNbSlots(0) {
+
+}
+
+// Destructor
+OverlappingPairMap::~OverlappingPairMap() {
+
+    releaseMemory();
+}
+
+// Release the memory of the arrays
+void OverlappingPairMap::releaseMemory() {
+
+    if (mNbAllocatedPairs > 0) {
+        delete[] mPairIDs;
+        delete[] mPairs;
+        delete[] mSlots;
+    }
+
+    mPairIDs = NULL;
+    mPairs = NULL;
+    mSlots = NULL;
+    mNbAllocatedPairs = 0;
+    mNbSlots = 0;
+}
+
+// Allocate more memory for the pairs and rebuild the hash table
+void OverlappingPairMap::reserve(uint nbAllocatedPairs) {
+
+    assert(nbAllocatedPairs > mNbPairs);
+
+    // Allocate the new arrays (the hash table is kept at most half full)
+    overlappingpairid* newPairIDs = new overlappingpairid[nbAllocatedPairs];
+    OverlappingPair** newPairs = new OverlappingPair*[nbAllocatedPairs];
+    uint nbSlots = 2 * nbAllocatedPairs;
+    int* newSlots = new int[nbSlots];
+    assert(newPairIDs != NULL);
+    assert(newPairs != NULL);
+    assert(newSlots != NULL);
+
+    // Copy the current pairs into the new arrays
+    for (uint i=0; i<mNbPairs; i++) {
+        newPairIDs[i] = mPairIDs[i];
+        newPairs[i] = mPairs[i];
+    }
+    uint nbPairs = mNbPairs;
+
+    // Release the previous arrays
+    releaseMemory();
+
+    mPairIDs = newPairIDs;
+    mPairs = newPairs;
+    mSlots = newSlots;
+    mNbPairs = nbPairs;
+    mNbAllocatedPairs = nbAllocatedPairs;
+    mNbSlots = nbSlots;
+
+    // Rebuild the hash table
+    for (uint i=0; i<mNbSlots; i++) {
+        mSlots[i] = EMPTY_SLOT;
+    }
+    for (uint i=0; i<mNbPairs; i++) {
+        mSlots[findSlot(mPairIDs[i])] = i;
+    }
+}
+
+// Add a pair with a given ID
+/**
+ * @param pairID ID of the pair
+ * @param pair Pointer to the pair
+ * @return False if a pair with the same ID is already in the map and true otherwise
+ */
+bool OverlappingPairMap::add(const overlappingpairid& pairID, OverlappingPair* pair) {
+
+    assert(pair != NULL);
+
+    // If we need to allocate more memory
+    if (mNbPairs == mNbAllocatedPairs) {
+        reserve(mNbAllocatedPairs == 0 ? INIT_NB_ALLOCATED_PAIRS : 2 * mNbAllocatedPairs);
+    }
+
+    // Find the slot of the pair in the hash table
+    uint slot = findSlot(pairID);
+    if (mSlots[slot] != EMPTY_SLOT) return false;
+
+    // Add the pair at the end of the arrays
+    mPairIDs[mNbPairs] = pairID;
+    mPairs[mNbPairs] = pair;
+    mSlots[slot] = mNbPairs;
+    mNbPairs++;
+
+    return true;
+}
+
+// Remove the pair with a given ID
+/// The last pair of the array of pairs is moved at the index of the removed pair.
+/**
+ * @param pairID ID of the pair to remove (the pair must be in the map)
+ */
+void OverlappingPairMap::remove(const overlappingpairid& pairID) {
+
+    assert(mNbPairs > 0);
+
+    uint slot = findSlot(pairID);
+    const int index = mSlots[slot];
+    assert(index != EMPTY_SLOT);
+
+    // Remove the pair from the hash table. The following pairs of the same cluster
+    // are shifted backward so that no tombstone is needed
+    const uint mask = mNbSlots - 1;
+    uint nextSlot = slot;
+    while (true) {
+
+        nextSlot = (nextSlot + 1) & mask;
+        if (mSlots[nextSlot] == EMPTY_SLOT) break;
+
+        // Ideal slot of the pair in the next slot
+        uint idealSlot = computeHash(mPairIDs[mSlots[nextSlot]]) & mask;
+
+        // If the ideal slot is cyclically in the range ]slot, nextSlot], the pair
+        // cannot be moved into the empty slot
+        bool isInRange = slot <= nextSlot ? (slot < idealSlot && idealSlot <= nextSlot) :
+                                            (slot < idealSlot || idealSlot <= nextSlot);
+        if (isInRange) continue;
+
+        mSlots[slot] = mSlots[nextSlot];
+        slot = nextSlot;
+    }
+    mSlots[slot] = EMPTY_SLOT;
+
+    // Move the last pair of the arrays at the index of the removed pair
+    const uint lastIndex = mNbPairs - 1;
+    if (static_cast<uint>(index) != lastIndex) {
+        mSlots[findSlot(mPairIDs[lastIndex])] = index;
+        mPairIDs[index] = mPairIDs[lastIndex];
+        mPairs[index] = mPairs[lastIndex];
+    }
+    mNbPairs--;
+}
+
+// Remove all the pairs
+/// The allocated memory is kept to be reused.
+void OverlappingPairMap::clear() {
+
+    if (mNbPairs == 0) return;
+
+    for (uint i=0; i<mNbSlots; i++) {
+        mSlots[i] = EMPTY_SLOT;
+    }
+    mNbPairs = 0;
+}
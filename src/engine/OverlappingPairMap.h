@@ -0,0 +1,183 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_OVERLAPPING_PAIR_MAP_H
+#define REACTPHYSICS3D_OVERLAPPING_PAIR_MAP_H
+
+// Libraries
+#include "OverlappingPair.h"
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Class OverlappingPairMap
+/**
+ * This class stores the overlapping pairs of the collision detection. The pairs
+ * are stored in a contiguous array so that they can be iterated with a linear
+ * sweep. An open-addressing hash table (with linear probing) that is indexed by the
+ * pair ID gives the position of each pair in this array. When a pair is removed,
+ * the last pair of the array is moved to its position. Therefore, the order of the
+ * pairs in the array is not preserved when a pair is removed.
+ */
+class OverlappingPairMap {
+
+    private :
+
+        // -------------------- Constants -------------------- //
+
+        /// Value of an empty slot of the hash table
+        static const int EMPTY_SLOT = -1;
+
+        /// Initial number of pairs allocated
+        static const uint INIT_NB_ALLOCATED_PAIRS = 16;
+
+        // -------------------- Attributes -------------------- //
+
+        /// Array with the ID of each pair
+        overlappingpairid* mPairIDs;
+
+        /// Array with the pointer to each pair
+        OverlappingPair** mPairs;
+
+        /// Number of pairs in the arrays
+        uint mNbPairs;
+
+        /// Number of allocated pairs in the arrays
+        uint mNbAllocatedPairs;
+
+        /// Hash table with the index of the pairs in the arrays (or EMPTY_SLOT)
+        int* mSlots;
+
+        /// Number of slots of the hash table (power of two)
+        uint mNbSlots;
+
+        // -------------------- Methods -------------------- //
+
+        /// Private copy-constructor
+        OverlappingPairMap(const OverlappingPairMap& map);
+
+        /// Private assignment operator
+        OverlappingPairMap& operator=(const OverlappingPairMap& map);
+
+        /// Return the hash table slot of a given pair ID (or the empty slot where it should be)
+        uint findSlot(const overlappingpairid& pairID) const;
+
+        /// Allocate more memory for the pairs and rebuild the hash table
+        void reserve(uint nbAllocatedPairs);
+
+        /// Release the memory of the arrays
+        void releaseMemory();
+
+        /// Return the hash value of a pair ID
+        static uint computeHash(const overlappingpairid& pairID);
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        OverlappingPairMap();
+
+        /// Destructor
+        ~OverlappingPairMap();
+
+        /// Return the number of pairs
+        uint getNbPairs() const;
+
+        /// Return the pair at a given index of the array of pairs
+        OverlappingPair* getPair(uint index) const;
+
+        /// Return the ID of the pair at a given index of the array of pairs
+        const overlappingpairid& getPairID(uint index) const;
+
+        /// Return the pair with a given ID or NULL if there is no such pair
+        OverlappingPair* find(const overlappingpairid& pairID) const;
+
+        /// Add a pair with a given ID. Return false if a pair with this ID already exists.
+        bool add(const overlappingpairid& pairID, OverlappingPair* pair);
+
+        /// Remove the pair with a given ID
+        void remove(const overlappingpairid& pairID);
+
+        /// Remove all the pairs
+        void clear();
+};
+
+// Return the number of pairs
+inline uint OverlappingPairMap::getNbPairs() const {
+    return mNbPairs;
+}
+
+// Return the pair at a given index of the array of pairs
+inline OverlappingPair* OverlappingPairMap::getPair(uint index) const {
+    assert(index < mNbPairs);
+    return mPairs[index];
+}
+
+// Return the ID of the pair at a given index of the array of pairs
+inline const overlappingpairid& OverlappingPairMap::getPairID(uint index) const {
+    assert(index < mNbPairs);
+    return mPairIDs[index];
+}
+
+// Return the hash value of a pair ID
+inline uint OverlappingPairMap::computeHash(const overlappingpairid& pairID) {
+
+    // Mix the two indices of the pair (using the 32 bits finalizer of MurmurHash3)
+    uint32 hash = static_cast<uint32>(pairID.first) * 0x9E3779B1u ^ static_cast<uint32>(pairID.second);
+    hash ^= hash >> 16;
+    hash *= 0x85EBCA6Bu;
+    hash ^= hash >> 13;
+    hash *= 0xC2B2AE35u;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+// Return the hash table slot of a given pair ID (or the empty slot where it should be)
+inline uint OverlappingPairMap::findSlot(const overlappingpairid& pairID) const {
+
+    assert(mNbSlots > 0);
+
+    const uint mask = mNbSlots - 1;
+    uint slot = computeHash(pairID) & mask;
+    while (mSlots[slot] != EMPTY_SLOT && mPairIDs[mSlots[slot]] != pairID) {
+        slot = (slot + 1) & mask;
+    }
+
+    return slot;
+}
+
+// Return the pair with a given ID or NULL if there is no such pair
+inline OverlappingPair* OverlappingPairMap::find(const overlappingpairid& pairID) const {
+
+    if (mNbPairs == 0) return NULL;
+
+    int index = mSlots[findSlot(pairID)];
+    return index == EMPTY_SLOT ? NULL : mPairs[index];
+}
+
+}
+
+#endif
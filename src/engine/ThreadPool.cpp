@@ -0,0 +1,175 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "ThreadPool.h"
+#include <cassert>
+
+using namespace reactphysics3d;
+
+// Constructor
+/**
+ * @param nbThreads Number of threads used to execute the tasks (including the
+ *                  calling thread)
+ */
+ThreadPool::ThreadPool(uint nbThreads)
+           : mCurrentTask(NULL), mNbItems(0), mNextItem(0), mTaskIndex(0),
+             mNbActiveWorkers(0), mIsStopping(false) {
+
+    setNbThreads(nbThreads);
+}
+
+// Destructor
+ThreadPool::~ThreadPool() {
+
+    stopWorkers();
+}
+
+// Set the number of threads of the pool (including the calling thread)
+/**
+ * @param nbThreads Number of threads used to execute the tasks. A value of one
+ *                  means that the tasks are executed serially on the calling thread
+ */
+void ThreadPool::setNbThreads(uint nbThreads) {
+
+    assert(mCurrentTask == NULL);
+
+    if (nbThreads < 1) nbThreads = 1;
+    if (nbThreads == getNbThreads()) return;
+
+    // Stop the current workers
+    stopWorkers();
+
+    // Create the new workers (the calling thread is the thread with index zero). The
+    // index of the current task is given to the workers so that a worker that starts
+    // after the next task has been launched does not miss it.
+    mIsStopping = false;
+    for (uint i=1; i<nbThreads; i++) {
+        mWorkers.push_back(std::thread(&ThreadPool::workerLoop, this, i, mTaskIndex));
+    }
+}
+
+// Stop and join all the worker threads
+void ThreadPool::stopWorkers() {
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mIsStopping = true;
+    }
+    mWorkCondition.notify_all();
+
+    for (uint i=0; i<mWorkers.size(); i++) {
+        mWorkers[i].join();
+    }
+    mWorkers.clear();
+}
+
+// Execute a task for all the items between zero and "nbItems" minus one.
+/// The items are distributed dynamically between the threads of the pool. Therefore,
+/// the execution of an item must not depend on the thread that executes it or on the
+/// execution of the other items of the same task. This method returns when all the
+/// items have been executed.
+void ThreadPool::parallelFor(uint nbItems, ParallelTask& task) {
+
+    if (nbItems == 0) return;
+
+#ifndef IS_PROFILING_ACTIVE
+    const bool isParallel = !mWorkers.empty() && nbItems > 1;
+#else
+    const bool isParallel = false;
+#endif
+
+    // If the task has to be executed serially on the calling thread
+    if (!isParallel) {
+        for (uint i=0; i<nbItems; i++) {
+            task.execute(0, i);
+        }
+        return;
+    }
+
+    // Start the new task and wake up the workers
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mCurrentTask = &task;
+        mNbItems = nbItems;
+        mNextItem = 0;
+        mNbActiveWorkers = static_cast<uint>(mWorkers.size());
+        mTaskIndex++;
+    }
+    mWorkCondition.notify_all();
+
+    // The calling thread also executes items of the task
+    executeItems(0);
+
+    // Wait until all the workers are done with the current task
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (mNbActiveWorkers > 0) {
+        mDoneCondition.wait(lock);
+    }
+    mCurrentTask = NULL;
+}
+
+// Execute items of the current task until there are no more items left
+void ThreadPool::executeItems(uint threadIndex) {
+
+    while (true) {
+
+        // Get the next item to execute
+        uint itemIndex = mNextItem.fetch_add(1);
+        if (itemIndex >= mNbItems) return;
+
+        mCurrentTask->execute(threadIndex, itemIndex);
+    }
+}
+
+// Main loop of a worker thread
+/**
+ * @param threadIndex Index of the worker thread
+ * @param lastTaskIndex Index of the last task that was started before the worker was created
+ */
+void ThreadPool::workerLoop(uint threadIndex, uint lastTaskIndex) {
+
+    while (true) {
+
+        // Wait for a new task (or for the pool to stop)
+        std::unique_lock<std::mutex> lock(mMutex);
+        while (!mIsStopping && mTaskIndex == lastTaskIndex) {
+            mWorkCondition.wait(lock);
+        }
+        if (mIsStopping) return;
+        lastTaskIndex = mTaskIndex;
+        lock.unlock();
+
+        // Execute items of the task
+        executeItems(threadIndex);
+
+        // Notify the calling thread if this was the last active worker
+        lock.lock();
+        mNbActiveWorkers--;
+        if (mNbActiveWorkers == 0) {
+            mDoneCondition.notify_one();
+        }
+    }
+}
@@ -0,0 +1,152 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_THREAD_POOL_H
+#define REACTPHYSICS3D_THREAD_POOL_H
+
+// Libraries
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include "configuration.h"
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Class ParallelTask
+/**
+ * Task that has to be used as parameter of the ThreadPool::parallelFor() method.
+ * The execute() method is called once for each item of the task and can be
+ * called concurrently from different threads for different items.
+ */
+class ParallelTask {
+
+    public :
+
+        /// Destructor
+        virtual ~ParallelTask() {
+
+        }
+
+        /// Execute the task for a given item. The "threadIndex" parameter is the index
+        /// (between zero and the number of threads of the pool minus one) of the thread
+        /// that executes the item. It can be used to access per-thread scratch data.
+        virtual void execute(uint threadIndex, uint itemIndex)=0;
+};
+
+// Class ThreadPool
+/**
+ * This class represents a pool of worker threads that is used to execute the
+ * parallel parts of the simulation. The thread that calls the parallelFor()
+ * method also takes part in the work and has the thread index zero. With a
+ * single thread (the default), no worker thread is created and the tasks are
+ * executed serially on the calling thread. Note that the profiler is not
+ * thread-safe, therefore, when profiling is active, the tasks are always
+ * executed on the calling thread.
+ */
+class ThreadPool {
+
+    private :
+
+        // -------------------- Attributes -------------------- //
+
+        /// Worker threads of the pool (the calling thread is not part of this array)
+        std::vector<std::thread> mWorkers;
+
+        /// Mutex used to protect the shared state of the pool
+        std::mutex mMutex;
+
+        /// Condition variable used to wake up the workers when a new task is available
+        std::condition_variable mWorkCondition;
+
+        /// Condition variable used to notify the calling thread that the workers are done
+        std::condition_variable mDoneCondition;
+
+        /// Task that is currently executed
+        ParallelTask* mCurrentTask;
+
+        /// Number of items of the current task
+        uint mNbItems;
+
+        /// Index of the next item of the current task to be executed
+        std::atomic<uint> mNextItem;
+
+        /// Index of the current task (incremented each time a new task is started)
+        uint mTaskIndex;
+
+        /// Number of workers that have not finished the current task yet
+        uint mNbActiveWorkers;
+
+        /// True if the workers have to exit
+        bool mIsStopping;
+
+        // -------------------- Methods -------------------- //
+
+        /// Private copy-constructor
+        ThreadPool(const ThreadPool& threadPool);
+
+        /// Private assignment operator
+        ThreadPool& operator=(const ThreadPool& threadPool);
+
+        /// Main loop of a worker thread
+        void workerLoop(uint threadIndex, uint lastTaskIndex);
+
+        /// Execute items of the current task until there are no more items left
+        void executeItems(uint threadIndex);
+
+        /// Stop and join all the worker threads
+        void stopWorkers();
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        ThreadPool(uint nbThreads = 1);
+
+        /// Destructor
+        ~ThreadPool();
+
+        /// Return the number of threads of the pool (including the calling thread)
+        uint getNbThreads() const;
+
+        /// Set the number of threads of the pool (including the calling thread)
+        void setNbThreads(uint nbThreads);
+
+        /// Execute a task for all the items between zero and "nbItems" minus one
+        /// and return when all the items have been executed
+        void parallelFor(uint nbItems, ParallelTask& task);
+};
+
+// Return the number of threads of the pool (including the calling thread)
+inline uint ThreadPool::getNbThreads() const {
+    return static_cast<uint>(mWorkers.size()) + 1;
+}
+
+}
+
+#endif
@@ -57,3 +57,93 @@ Vector3 reactphysics3d::clamp(const Vector3& vector, decimal maxLength) {
     }
     return vector;
 }
+
+// Compute the point of a segment that is closest to a given point
+/// This method uses the technique described in the book Real-Time collision detection by
+/// Christer Ericson.
+Vector3 reactphysics3d::computeClosestPointOnSegment(const Vector3& segPointA, const Vector3& segPointB,
+                                                     const Vector3& pointC) {
+
+    const Vector3 ab = segPointB - segPointA;
+    const decimal abLengthSquare = ab.lengthSquare();
+
+    // If the segment is degenerate
+    if (abLengthSquare < MACHINE_EPSILON) return segPointA;
+
+    // Project the point onto the segment
+    decimal t = (pointC - segPointA).dot(ab) / abLengthSquare;
+    t = clamp(t, decimal(0.0), decimal(1.0));
+
+    return segPointA + t * ab;
+}
+
+// Compute the pair of closest points between two segments
+/// This method uses the technique described in the book Real-Time collision detection by
+/// Christer Ericson. If the segments are parallel, one of the pairs of closest points
+/// is returned.
+void reactphysics3d::computeClosestPointBetweenTwoSegments(const Vector3& seg1PointA, const Vector3& seg1PointB,
+                                                           const Vector3& seg2PointA, const Vector3& seg2PointB,
+                                                           Vector3& closestPointSeg1, Vector3& closestPointSeg2) {
+
+    const Vector3 d1 = seg1PointB - seg1PointA;
+    const Vector3 d2 = seg2PointB - seg2PointA;
+    const Vector3 r = seg1PointA - seg2PointA;
+    const decimal a = d1.lengthSquare();
+    const decimal e = d2.lengthSquare();
+    const decimal f = d2.dot(r);
+    decimal s, t;
+
+    // If both segments are degenerate
+    if (a <= MACHINE_EPSILON && e <= MACHINE_EPSILON) {
+        closestPointSeg1 = seg1PointA;
+        closestPointSeg2 = seg2PointA;
+        return;
+    }
+
+    // If the first segment is degenerate
+    if (a <= MACHINE_EPSILON) {
+        s = decimal(0.0);
+        t = clamp(f / e, decimal(0.0), decimal(1.0));
+    }
+    else {
+
+        const decimal c = d1.dot(r);
+
+        // If the second segment is degenerate
+        if (e <= MACHINE_EPSILON) {
+            t = decimal(0.0);
+            s = clamp(-c / a, decimal(0.0), decimal(1.0));
+        }
+        else {
+
+            const decimal b = d1.dot(d2);
+            const decimal denom = a * e - b * b;
+
+            // If the segments are not parallel, compute the closest point of the first
+            // line to the second line and clamp it to the first segment
+            if (denom > MACHINE_EPSILON * a * e) {
+                s = clamp((b * f - c * e) / denom, decimal(0.0), decimal(1.0));
+            }
+            else {
+                s = decimal(0.0);
+            }
+
+            // Compute the point of the second segment closest to the point of the first segment
+            t = (b * s + f) / e;
+
+            // If this point is outside the second segment, clamp it and compute the
+            // point of the first segment closest to it again
+            if (t < decimal(0.0)) {
+                t = decimal(0.0);
+                s = clamp(-c / a, decimal(0.0), decimal(1.0));
+            }
+            else if (t > decimal(1.0)) {
+                t = decimal(1.0);
+                s = clamp((b - c) / a, decimal(0.0), decimal(1.0));
+            }
+        }
+    }
+
+    closestPointSeg1 = seg1PointA + s * d1;
+    closestPointSeg2 = seg2PointA + t * d2;
+}
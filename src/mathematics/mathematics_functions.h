@@ -82,6 +82,15 @@ Vector3 clamp(const Vector3& vector, decimal maxLength);
 void computeBarycentricCoordinatesInTriangle(const Vector3& a, const Vector3& b, const Vector3& c,
                                              const Vector3& p, decimal& u, decimal& v, decimal& w);
 
+/// Compute the point of a segment that is closest to a given point
+Vector3 computeClosestPointOnSegment(const Vector3& segPointA, const Vector3& segPointB,
+                                     const Vector3& pointC);
+
+/// Compute the pair of closest points between two segments
+void computeClosestPointBetweenTwoSegments(const Vector3& seg1PointA, const Vector3& seg1PointB,
+                                           const Vector3& seg2PointA, const Vector3& seg2PointB,
+                                           Vector3& closestPointSeg1, Vector3& closestPointSeg2);
+
 }
 
 #endif
@@ -28,6 +28,7 @@
 
 // Libraries
 #include "configuration.h"
+#include <new>
 
 namespace reactphysics3d {
 
@@ -96,7 +97,9 @@ inline void Stack<T, capacity>::push(const T& element) {
         mNbAllocatedElements *= 2;
         mElements = (T*) malloc(mNbAllocatedElements * sizeof(T));
         assert(mElements);
-        memcpy(mElements, oldElements, mNbElements * sizeof(T));
+        for (uint i=0; i<mNbElements; i++) {
+            new (mElements + i) T(oldElements[i]);
+        }
         if (oldElements != mInitArray) {
             free(oldElements);
         }
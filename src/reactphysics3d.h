@@ -55,6 +55,7 @@
 #include "collision/shapes/AABB.h"
 #include "collision/ProxyShape.h"
 #include "collision/RaycastInfo.h"
+#include "collision/ConvexCastInfo.h"
 #include "collision/TriangleMesh.h"
 #include "collision/TriangleVertexArray.h"
 #include "constraint/BallAndSocketJoint.h"
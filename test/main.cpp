@@ -37,6 +37,12 @@
 #include "tests/collision/TestCollisionWorld.h"
 #include "tests/collision/TestAABB.h"
 #include "tests/collision/TestDynamicAABBTree.h"
+#include "tests/collision/TestStaticAABBTree.h"
+#include "tests/collision/TestBroadPhaseAlgorithms.h"
+#include "tests/collision/TestQuickHull.h"
+#include "tests/collision/TestContactManifold.h"
+#include "tests/engine/TestDynamicsWorld.h"
+#include "tests/engine/TestOverlappingPairMap.h"
 
 using namespace reactphysics3d;
 
@@ -61,6 +67,15 @@ int main() {
     testSuite.addTest(new TestRaycast("Raycasting"));
     testSuite.addTest(new TestCollisionWorld("CollisionWorld"));
     testSuite.addTest(new TestDynamicAABBTree("DynamicAABBTree"));
+    testSuite.addTest(new TestStaticAABBTree("StaticAABBTree"));
+    testSuite.addTest(new TestBroadPhaseAlgorithms("BroadPhaseAlgorithms"));
+    testSuite.addTest(new TestQuickHull("QuickHull"));
+    testSuite.addTest(new TestContactManifold("ContactManifold"));
+
+    // ---------- Engine tests ---------- //
+
+    testSuite.addTest(new TestOverlappingPairMap("OverlappingPairMap"));
+    testSuite.addTest(new TestDynamicsWorld("DynamicsWorld"));
 
     // Run the tests
     testSuite.run();
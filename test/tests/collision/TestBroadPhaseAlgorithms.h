@@ -0,0 +1,409 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_BROAD_PHASE_ALGORITHMS_H
+#define TEST_BROAD_PHASE_ALGORITHMS_H
+
+// Libraries
+#include "Test.h"
+#include "reactphysics3d.h"
+#include <vector>
+#include <set>
+#include <utility>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class BroadPhasePairsCallback
+/**
+ * Collision callback that records the pairs of bodies in contact
+ */
+class BroadPhasePairsCallback : public CollisionCallback {
+
+    public:
+
+        std::set<std::pair<bodyindex, bodyindex> > bodyPairs;
+
+        // This method will be called for contact
+        virtual void notifyContact(const ContactPointInfo& contactPointInfo) {
+            bodyindex id1 = contactPointInfo.shape1->getBody()->getID();
+            bodyindex id2 = contactPointInfo.shape2->getBody()->getID();
+            bodyPairs.insert(std::make_pair(std::min(id1, id2), std::max(id1, id2)));
+        }
+};
+
+// Class BroadPhaseHitsCallback
+/**
+ * Raycast callback that records the bodies hit by a ray
+ */
+class BroadPhaseHitsCallback : public RaycastCallback {
+
+    public:
+
+        std::set<bodyindex> hitBodies;
+
+        bool isClosestHitOnly;
+
+        BroadPhaseHitsCallback(bool closestHitOnly) : isClosestHitOnly(closestHitOnly) {
+
+        }
+
+        virtual decimal notifyRaycastHit(const RaycastInfo& info) {
+            if (isClosestHitOnly) {
+                hitBodies.clear();
+                hitBodies.insert(info.body->getID());
+                return info.hitFraction;
+            }
+            hitBodies.insert(info.body->getID());
+            return decimal(1.0);
+        }
+};
+
+// Class TestBroadPhaseAlgorithms
+/**
+ * Unit test for the sweep-and-prune and spatial hash broad-phases. The results of a
+ * world that uses one of these algorithms are compared with the ones of a world that
+ * uses the dynamic AABB trees.
+ */
+class TestBroadPhaseAlgorithms : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        // Collision shapes
+        BoxShape* mTileShape;
+        BoxShape* mBoxShape;
+        SphereShape* mSphereShape;
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestBroadPhaseAlgorithms(const std::string& name) : Test(name) {
+
+            mTileShape = new BoxShape(Vector3(2, decimal(0.5), 2));
+            mBoxShape = new BoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            mSphereShape = new SphereShape(decimal(0.6));
+        }
+
+        /// Destructor
+        ~TestBroadPhaseAlgorithms() {
+            delete mTileShape;
+            delete mBoxShape;
+            delete mSphereShape;
+        }
+
+        /// Run the tests
+        void run() {
+
+            testOverlappingPairs(SWEEP_AND_PRUNE, DEFAULT_SPATIAL_HASH_CELL_SIZE);
+            testRaycast(SWEEP_AND_PRUNE, DEFAULT_SPATIAL_HASH_CELL_SIZE);
+
+            // With small cells, the tiles are too large to be stored in the grid
+            // and the rays cross more cells than there are shapes
+            testOverlappingPairs(SPATIAL_HASH, decimal(0.5));
+            testRaycast(SPATIAL_HASH, decimal(0.5));
+            testOverlappingPairs(SPATIAL_HASH, decimal(3.0));
+            testRaycast(SPATIAL_HASH, decimal(3.0));
+
+            testAdaptiveFatAABB(DYNAMIC_AABB_TREE);
+            testAdaptiveFatAABB(SWEEP_AND_PRUNE);
+            testAdaptiveFatAABB(SPATIAL_HASH);
+
+            testDestroyBodies(DYNAMIC_AABB_TREE);
+            testDestroyBodies(SWEEP_AND_PRUNE);
+            testDestroyBodies(SPATIAL_HASH);
+
+            testBroadPhaseSettings();
+        }
+
+        /// Test that the settings of a broad-phase are only available on a world that
+        /// uses this broad-phase
+        void testBroadPhaseSettings() {
+
+            CollisionWorld treeWorld;
+            CollisionWorld sweepAndPruneWorld(SWEEP_AND_PRUNE);
+            CollisionWorld spatialHashWorld(SPATIAL_HASH);
+
+            test(treeWorld.getAABBTreeBroadPhase() != NULL);
+            test(treeWorld.getSpatialHashBroadPhase() == NULL);
+            test(sweepAndPruneWorld.getAABBTreeBroadPhase() == NULL);
+            test(sweepAndPruneWorld.getSpatialHashBroadPhase() == NULL);
+            test(spatialHashWorld.getAABBTreeBroadPhase() == NULL);
+            test(spatialHashWorld.getSpatialHashBroadPhase() != NULL);
+
+            treeWorld.getAABBTreeBroadPhase()->setNbTreeLeavesToOptimizePerStep(16);
+            test(treeWorld.getAABBTreeBroadPhase()->getNbTreeLeavesToOptimizePerStep() == 16);
+            spatialHashWorld.getSpatialHashBroadPhase()->setCellSize(decimal(2.5));
+            test(approxEqual(spatialHashWorld.getSpatialHashBroadPhase()->getCellSize(), decimal(2.5)));
+        }
+
+        /// Create a level of static tiles with boxes and spheres above them
+        void createScene(CollisionWorld* world, std::vector<CollisionBody*>& bodies) {
+
+            world->beginBulkInsertion();
+            for (int i=0; i<10; i++) {
+                for (int j=0; j<10; j++) {
+                    CollisionBody* tile = world->createCollisionBody(
+                                Transform(Vector3(decimal(i * 4), 0, decimal(j * 4)), Quaternion::identity()));
+                    tile->addCollisionShape(mTileShape, Transform::identity());
+                    tile->setType(STATIC);
+                    bodies.push_back(tile);
+                }
+            }
+            world->endBulkInsertion();
+
+            for (int i=0; i<60; i++) {
+                Vector3 position(decimal((i * 7) % 40), decimal(0.8 + (i % 3) * 0.5),
+                                 decimal((i * 13) % 40));
+                CollisionBody* body = world->createCollisionBody(Transform(position,
+                                                                           Quaternion::identity()));
+                if (i % 2 == 0) {
+                    body->addCollisionShape(mBoxShape, Transform::identity());
+                }
+                else {
+                    body->addCollisionShape(mSphereShape, Transform::identity());
+                }
+                bodies.push_back(body);
+            }
+        }
+
+        /// Test that the overlapping pairs are the same as with the AABB trees while the
+        /// bodies move, are removed and change their type
+        void testOverlappingPairs(BroadPhaseType broadPhaseType, decimal cellSize) {
+
+            CollisionWorld treeWorld;
+            CollisionWorld otherWorld(broadPhaseType);
+            if (broadPhaseType == SPATIAL_HASH) {
+                otherWorld.getSpatialHashBroadPhase()->setCellSize(cellSize);
+            }
+            CollisionWorld* worlds[2] = {&treeWorld, &otherWorld};
+            std::vector<CollisionBody*> bodies[2];
+            for (int w=0; w<2; w++) {
+                createScene(worlds[w], bodies[w]);
+            }
+
+            bool isSamePairs = true;
+            bool hasPairs = false;
+            for (int step=0; step<20; step++) {
+
+                BroadPhasePairsCallback callbacks[2];
+                for (int w=0; w<2; w++) {
+
+                    for (uint b=100; b<bodies[w].size(); b++) {
+
+                        // Move the bodies
+                        Transform transform = bodies[w][b]->getTransform();
+                        Vector3 displacement(decimal(0.3) * decimal(b % 5) - decimal(0.6), 0,
+                                             decimal(0.2) * decimal(b % 3));
+                        transform.setPosition(transform.getPosition() + displacement);
+
+                        // Teleport some bodies
+                        if (step % 7 == 3 && b % 11 == 0) {
+                            transform.setPosition(Vector3(decimal(b % 40), 1, decimal(step)));
+                        }
+                        bodies[w][b]->setTransform(transform);
+                    }
+
+                    // Move a static tile
+                    if (step == 5) {
+                        bodies[w][55]->setTransform(Transform(Vector3(20, 1, 20), Quaternion::identity()));
+                    }
+
+                    // Change the type of some bodies
+                    if (step == 8) {
+                        bodies[w][101]->setType(KINEMATIC);
+                        bodies[w][102]->setType(STATIC);
+                        bodies[w][12]->setType(DYNAMIC);
+                    }
+
+                    // Change the size of the cells of the grid
+                    if (step == 10 && w == 1 && broadPhaseType == SPATIAL_HASH) {
+                        worlds[w]->getSpatialHashBroadPhase()->setCellSize(decimal(2.0) * cellSize);
+                    }
+
+                    // Remove some bodies and create new ones
+                    if (step == 12) {
+                        for (int r=0; r<5; r++) {
+                            worlds[w]->destroyCollisionBody(bodies[w][110 + r]);
+                            bodies[w].erase(bodies[w].begin() + 110 + r);
+                        }
+                        for (int n=0; n<5; n++) {
+                            CollisionBody* body = worlds[w]->createCollisionBody(
+                                        Transform(Vector3(decimal(n * 3), 1, 10), Quaternion::identity()));
+                            body->addCollisionShape(mBoxShape, Transform::identity());
+                            bodies[w].push_back(body);
+                        }
+                    }
+
+                    worlds[w]->testCollision(&callbacks[w]);
+                }
+
+                isSamePairs = isSamePairs && callbacks[0].bodyPairs == callbacks[1].bodyPairs;
+                hasPairs = hasPairs || !callbacks[0].bodyPairs.empty();
+            }
+
+            test(hasPairs);
+            test(isSamePairs);
+
+            // The pairs must still be the same after rebuilding the broad-phase
+            otherWorld.rebuildBroadPhase();
+            BroadPhasePairsCallback callbacks[2];
+            treeWorld.testCollision(&callbacks[0]);
+            otherWorld.testCollision(&callbacks[1]);
+            test(callbacks[0].bodyPairs == callbacks[1].bodyPairs);
+        }
+
+        /// Test that the bodies hit by rays are the same as with the AABB trees
+        void testRaycast(BroadPhaseType broadPhaseType, decimal cellSize) {
+
+            CollisionWorld treeWorld;
+            CollisionWorld otherWorld(broadPhaseType);
+            if (broadPhaseType == SPATIAL_HASH) {
+                otherWorld.getSpatialHashBroadPhase()->setCellSize(cellSize);
+            }
+            CollisionWorld* worlds[2] = {&treeWorld, &otherWorld};
+            std::vector<CollisionBody*> bodies[2];
+            for (int w=0; w<2; w++) {
+                createScene(worlds[w], bodies[w]);
+                BroadPhasePairsCallback callback;
+                worlds[w]->testCollision(&callback);
+            }
+
+            bool isSameHits = true;
+            bool hasHits = false;
+            for (int r=0; r<40; r++) {
+
+                Ray ray(Vector3(decimal(r), 5, decimal(-2)),
+                        Vector3(decimal(40 - r), decimal(-1), decimal(42)));
+
+                for (int isClosestHitOnly=0; isClosestHitOnly<2; isClosestHitOnly++) {
+
+                    BroadPhaseHitsCallback treeCallback(isClosestHitOnly != 0);
+                    BroadPhaseHitsCallback otherCallback(isClosestHitOnly != 0);
+                    treeWorld.raycast(ray, &treeCallback);
+                    otherWorld.raycast(ray, &otherCallback);
+
+                    isSameHits = isSameHits && treeCallback.hitBodies == otherCallback.hitBodies;
+                    hasHits = hasHits || !treeCallback.hitBodies.empty();
+                }
+            }
+
+            test(hasHits);
+            test(isSameHits);
+        }
+
+        /// Test that a fast body is not reinserted into the broad-phase at each step
+        /// and that its fat AABB shrinks again when it stops
+        void testAdaptiveFatAABB(BroadPhaseType broadPhaseType) {
+
+            CollisionWorld world(broadPhaseType);
+            CollisionBody* projectile = world.createCollisionBody(Transform::identity());
+            ProxyShape* projectileShape = projectile->addCollisionShape(mBoxShape, Transform::identity());
+            BroadPhasePairsCallback callback;
+            world.testCollision(&callback);
+
+            // Move the projectile by one meter at each step
+            uint nbReinsertedShapes = 0;
+            for (int step=1; step<=40; step++) {
+                projectile->setTransform(Transform(Vector3(decimal(step), 0, 0), Quaternion::identity()));
+                world.testCollision(&callback);
+                test(world.getBroadPhaseStatistics().nbUpdatedShapes == 1);
+                nbReinsertedShapes += world.getBroadPhaseStatistics().nbReinsertedShapes;
+            }
+            test(nbReinsertedShapes > 0);
+            test(nbReinsertedShapes <= 10);
+
+            // The fat AABB of the projectile extends in front of it when it stops
+            CollisionBody* target = world.createCollisionBody(Transform(Vector3(44, 0, 0),
+                                                                        Quaternion::identity()));
+            ProxyShape* targetShape = target->addCollisionShape(mBoxShape, Transform::identity());
+            world.testCollision(&callback);
+            test(world.testAABBOverlap(projectileShape, targetShape));
+            test(world.getBroadPhaseStatistics().nbPotentialPairs == 1);
+
+            // The fat AABB of the projectile shrinks after it has stopped for a while
+            uint nbShrunkShapes = 0;
+            for (int step=0; step<20; step++) {
+                projectile->setTransform(Transform(Vector3(40, 0, 0), Quaternion::identity()));
+                world.testCollision(&callback);
+                nbShrunkShapes += world.getBroadPhaseStatistics().nbShrunkShapes;
+            }
+            test(nbShrunkShapes == 1);
+            test(!world.testAABBOverlap(projectileShape, targetShape));
+        }
+
+        /// Test that destroying many bodies at once gives the same overlapping pairs as
+        /// destroying them one by one (including bodies that have just moved)
+        void testDestroyBodies(BroadPhaseType broadPhaseType) {
+
+            CollisionWorld world1(broadPhaseType);
+            CollisionWorld world2(broadPhaseType);
+            CollisionWorld* worlds[2] = {&world1, &world2};
+            std::vector<CollisionBody*> bodies[2];
+            BroadPhasePairsCallback callbacks[2];
+            for (int w=0; w<2; w++) {
+
+                createScene(worlds[w], bodies[w]);
+                worlds[w]->testCollision(&callbacks[w]);
+
+                // Move some bodies before they are destroyed
+                for (uint b=100; b<bodies[w].size(); b += 2) {
+                    Transform transform = bodies[w][b]->getTransform();
+                    transform.setPosition(transform.getPosition() + Vector3(decimal(0.5), 0, 0));
+                    bodies[w][b]->setTransform(transform);
+                }
+
+                // Destroy some tiles and every third body
+                std::vector<CollisionBody*> bodiesToDestroy;
+                for (uint b=0; b<bodies[w].size(); b++) {
+                    if ((b < 100 && b % 10 == 3) || (b >= 100 && b % 3 == 0)) {
+                        bodiesToDestroy.push_back(bodies[w][b]);
+                    }
+                }
+                if (w == 0) {
+                    for (uint b=0; b<bodiesToDestroy.size(); b++) {
+                        worlds[w]->destroyCollisionBody(bodiesToDestroy[b]);
+                    }
+                }
+                else {
+                    worlds[w]->destroyCollisionBodies(bodiesToDestroy);
+                }
+                test(worlds[w]->getBodiesBeginIterator() != worlds[w]->getBodiesEndIterator());
+
+                callbacks[w].bodyPairs.clear();
+                worlds[w]->testCollision(&callbacks[w]);
+            }
+
+            test(!callbacks[0].bodyPairs.empty());
+            test(callbacks[0].bodyPairs == callbacks[1].bodyPairs);
+        }
+};
+
+}
+
+#endif
@@ -28,6 +28,7 @@
 
 // Libraries
 #include "reactphysics3d.h"
+#include "collision/narrowphase/GJK/GJKAlgorithm.h"
 
 /// Reactphysics3D namespace
 namespace reactphysics3d {
@@ -95,6 +96,81 @@ class WorldCollisionCallback : public CollisionCallback
         }
 };
 
+// Class ContactListCallback
+/**
+ * Collision callback that records the bodies and the penetration depth of all the
+ * reported contacts in order
+ */
+class ContactListCallback : public CollisionCallback
+{
+    public:
+
+        std::vector<bodyindex> bodyIDs;
+        std::vector<decimal> penetrationDepths;
+
+        // This method will be called for contact
+        virtual void notifyContact(const ContactPointInfo& contactPointInfo) {
+            bodyIDs.push_back(contactPointInfo.shape1->getBody()->getID());
+            bodyIDs.push_back(contactPointInfo.shape2->getBody()->getID());
+            penetrationDepths.push_back(contactPointInfo.penetrationDepth);
+        }
+};
+
+// Class ConvexCastHitsCallback
+/**
+ * Convex cast callback that records the hits (or only the closest one)
+ */
+class ConvexCastHitsCallback : public ConvexCastCallback {
+
+    public:
+
+        std::vector<bodyindex> bodyIDs;
+        std::vector<decimal> hitFractions;
+        std::vector<Vector3> worldNormals;
+        std::vector<Vector3> worldPoints;
+
+        bool isClosestHitOnly;
+
+        ConvexCastHitsCallback(bool closestHitOnly) : isClosestHitOnly(closestHitOnly) {
+
+        }
+
+        virtual decimal notifyConvexCastHit(const ConvexCastInfo& info) {
+            if (isClosestHitOnly) {
+                bodyIDs.clear();
+                hitFractions.clear();
+                worldNormals.clear();
+                worldPoints.clear();
+            }
+            bodyIDs.push_back(info.body->getID());
+            hitFractions.push_back(info.hitFraction);
+            worldNormals.push_back(info.worldNormal);
+            worldPoints.push_back(info.worldPoint);
+            return isClosestHitOnly ? info.hitFraction : decimal(1.0);
+        }
+};
+
+// Class GJKCollisionDispatch
+/**
+ * Collision dispatch that uses the GJK algorithm for all the pairs of convex shapes
+ */
+class GJKCollisionDispatch : public CollisionDispatch {
+
+    private:
+
+        GJKAlgorithm mGJKAlgorithm;
+
+    public:
+
+        virtual void init(CollisionDetection* collisionDetection, MemoryAllocator* memoryAllocator) {
+            mGJKAlgorithm.init(collisionDetection, memoryAllocator);
+        }
+
+        virtual NarrowPhaseAlgorithm* selectAlgorithm(int shape1Type, int shape2Type) {
+            return &mGJKAlgorithm;
+        }
+};
+
 // Class TestCollisionWorld
 /**
  * Unit test for the CollisionWorld class.
@@ -181,6 +257,14 @@ class TestCollisionWorld : public Test {
         void run() {
 
             testCollisions();
+            testBodyTypes();
+            testParallelBroadPhase();
+            testGJKWarmStart();
+            testAnalyticNarrowPhase();
+            testPolyhedronContacts();
+            testConvexMeshSupportPoints();
+            testEPA();
+            testConvexCast();
         }
 
         void testCollisions() {
@@ -336,6 +420,565 @@ class TestCollisionWorld : public Test {
             mSphere2ProxyShape->setCollideWithMaskBits(0xFFFF);
             mCylinderProxyShape->setCollideWithMaskBits(0xFFFF);
         }
+
+        void testBodyTypes() {
+
+            // --------- Test collision between static bodies --------- //
+
+            mBoxBody->setType(STATIC);
+            mCylinderBody->setType(STATIC);
+
+            mCollisionCallback.reset();
+            mWorld->testCollision(&mCollisionCallback);
+            test(mCollisionCallback.boxCollideWithSphere1);
+            test(!mCollisionCallback.boxCollideWithCylinder);
+            test(!mCollisionCallback.sphere1CollideWithCylinder);
+            test(!mCollisionCallback.sphere1CollideWithSphere2);
+
+            test(mWorld->testAABBOverlap(mBoxBody, mSphere1Body));
+            test(mWorld->testAABBOverlap(mBoxBody, mCylinderBody));
+
+            // Move a static body
+            mCylinderBody->setTransform(Transform(Vector3(10, 0, 20), Quaternion::identity()));
+            test(!mWorld->testAABBOverlap(mBoxBody, mCylinderBody));
+            mCylinderBody->setTransform(Transform(Vector3(10, -5, 0), Quaternion::identity()));
+            test(mWorld->testAABBOverlap(mBoxBody, mCylinderBody));
+
+            // --------- Test collision with a kinematic body --------- //
+
+            mSphere1Body->setType(KINEMATIC);
+
+            mCollisionCallback.reset();
+            mWorld->testCollision(&mCollisionCallback);
+            test(!mCollisionCallback.boxCollideWithSphere1);
+            test(!mCollisionCallback.boxCollideWithCylinder);
+            test(mWorld->testAABBOverlap(mBoxBody, mSphere1Body));
+
+            // --------- Test collision with dynamic bodies again --------- //
+
+            mBoxBody->setType(DYNAMIC);
+            mCylinderBody->setType(DYNAMIC);
+            mSphere1Body->setType(DYNAMIC);
+
+            mCollisionCallback.reset();
+            mWorld->testCollision(&mCollisionCallback);
+            test(mCollisionCallback.boxCollideWithSphere1);
+            test(mCollisionCallback.boxCollideWithCylinder);
+            test(!mCollisionCallback.sphere1CollideWithCylinder);
+            test(!mCollisionCallback.sphere1CollideWithSphere2);
+        }
+
+        /// Test that the overlapping pairs found by the parallel broad-phase are the same
+        /// (and are reported in the same order) as the pairs found serially
+        void testParallelBroadPhase() {
+
+            CollisionWorld serialWorld;
+            CollisionWorld parallelWorld;
+            parallelWorld.setNbThreads(4);
+
+            CollisionWorld* worlds[2] = {&serialWorld, &parallelWorld};
+            std::vector<CollisionBody*> bodies[2];
+            for (int w=0; w<2; w++) {
+
+                // Static boxes on the ground and a grid of moving spheres above them
+                for (int i=0; i<8; i++) {
+                    CollisionBody* body = worlds[w]->createCollisionBody(
+                                Transform(Vector3(decimal(i * 4), -4, 0), Quaternion::identity()));
+                    body->addCollisionShape(mBoxShape, Transform::identity());
+                    body->setType(STATIC);
+                }
+                for (int i=0; i<15; i++) {
+                    for (int j=0; j<15; j++) {
+                        Vector3 position(decimal(i * 1.8), decimal(-1 + 0.1 * j), decimal(j * 1.8));
+                        CollisionBody* body = worlds[w]->createCollisionBody(
+                                    Transform(position, Quaternion::identity()));
+                        body->addCollisionShape(mSphereShape, Transform::identity());
+                        bodies[w].push_back(body);
+                    }
+                }
+            }
+
+            ContactListCallback callbacks[2];
+            for (int step=0; step<3; step++) {
+
+                // Move the spheres
+                for (int w=0; w<2; w++) {
+                    for (uint b=0; b<bodies[w].size(); b++) {
+                        Transform transform = bodies[w][b]->getTransform();
+                        transform.setPosition(transform.getPosition() +
+                                              Vector3(decimal(0.4) * decimal((b % 3) - 1), 0,
+                                                      decimal(0.3) * decimal(step)));
+                        bodies[w][b]->setTransform(transform);
+                    }
+                    worlds[w]->testCollision(&callbacks[w]);
+                }
+            }
+
+            test(!callbacks[0].penetrationDepths.empty());
+            test(callbacks[0].bodyIDs == callbacks[1].bodyIDs);
+            test(callbacks[0].penetrationDepths == callbacks[1].penetrationDepths);
+        }
+
+        /// Create a body with a convex mesh box shape
+        ProxyShape* createConvexMeshBox(CollisionWorld& world, ConvexMeshShape& shape,
+                                        const Transform& transform) {
+            CollisionBody* body = world.createCollisionBody(transform);
+            return body->addCollisionShape(&shape, Transform::identity());
+        }
+
+        /// Test that the GJK algorithm reuses the simplex of the previous test of a
+        /// resting contact and that the contacts are the same as without the cached simplex
+        void testGJKWarmStart() {
+
+            ConvexMeshShape meshShape;
+            for (int i=0; i<8; i++) {
+                meshShape.addVertex(Vector3(i & 1 ? 1 : -1, i & 2 ? 1 : -1, i & 4 ? 1 : -1));
+            }
+
+            // The boxes are only in contact in their margins
+            CollisionWorld world;
+            ProxyShape* shape1 = createConvexMeshBox(world, meshShape, Transform::identity());
+            ProxyShape* shape2 = createConvexMeshBox(world, meshShape, Transform::identity());
+
+            bool isSameContacts = true;
+            uint maxNbWarmIterations = 0;
+            uint nbColdIterations = 0;
+            for (int step=0; step<10; step++) {
+
+                // Slightly move the top box at each step
+                Quaternion orientation(0, decimal(0.01) * decimal(step), 0);
+                Transform transform(Vector3(decimal(0.3), decimal(2.05), decimal(-0.2)), orientation);
+                shape2->getBody()->setTransform(transform);
+                ContactListCallback callback;
+                world.testCollision(&callback);
+
+                // Compare with a world in which the pair is tested for the first time
+                CollisionWorld coldWorld;
+                ProxyShape* coldShape1 = createConvexMeshBox(coldWorld, meshShape, Transform::identity());
+                ProxyShape* coldShape2 = createConvexMeshBox(coldWorld, meshShape, transform);
+                ContactListCallback coldCallback;
+                coldWorld.testCollision(&coldCallback);
+
+                isSameContacts = isSameContacts && callback.penetrationDepths.size() == 1 &&
+                                 coldCallback.penetrationDepths.size() == 1 &&
+                                 approxEqual(callback.penetrationDepths[0],
+                                             coldCallback.penetrationDepths[0], decimal(0.001));
+                nbColdIterations = coldWorld.getNbGJKIterations(coldShape1, coldShape2);
+                if (step > 0) {
+                    maxNbWarmIterations = std::max(maxNbWarmIterations,
+                                                   world.getNbGJKIterations(shape1, shape2));
+                }
+            }
+
+            test(isSameContacts);
+            test(maxNbWarmIterations > 0);
+            test(maxNbWarmIterations <= 2);
+            test(maxNbWarmIterations < nbColdIterations);
+        }
+
+        /// Test the collision of two shapes with the default collision dispatch and
+        /// return the number of contacts and the maximum penetration depth
+        uint testShapesCollision(CollisionShape* shape1, const Transform& transform1,
+                                 CollisionShape* shape2, const Transform& transform2,
+                                 CollisionDispatch* collisionDispatch, decimal& maxDepth) {
+
+            CollisionWorld world;
+            if (collisionDispatch != NULL) world.setCollisionDispatch(collisionDispatch);
+            world.createCollisionBody(transform1)->addCollisionShape(shape1, Transform::identity());
+            world.createCollisionBody(transform2)->addCollisionShape(shape2, Transform::identity());
+
+            ContactListCallback callback;
+            world.testCollision(&callback);
+
+            maxDepth = decimal(0.0);
+            for (uint i=0; i<callback.penetrationDepths.size(); i++) {
+                maxDepth = std::max(maxDepth, callback.penetrationDepths[i]);
+            }
+
+            return callback.penetrationDepths.size();
+        }
+
+        /// Test that the analytic box, sphere and capsule algorithms report the same
+        /// penetration depth as the GJK/EPA algorithm with both orders of the shapes
+        void testAnalyticNarrowPhase() {
+
+            BoxShape boxShape(Vector3(1, 1, 1));
+            SphereShape sphereShape(1);
+            CapsuleShape capsuleShape(decimal(0.5), 2);
+            GJKCollisionDispatch gjkDispatch;
+
+            CollisionShape* shapes1[] = {&boxShape, &sphereShape, &sphereShape, &capsuleShape, &boxShape};
+            CollisionShape* shapes2[] = {&boxShape, &boxShape, &capsuleShape, &capsuleShape, &sphereShape};
+            Transform transforms2[] = {
+                Transform(Vector3(decimal(0.2), decimal(1.9), decimal(-0.1)), Quaternion(0, decimal(0.3), 0)),
+                Transform(Vector3(decimal(0.3), decimal(1.8), 0), Quaternion::identity()),
+                Transform(Vector3(decimal(-1.3), decimal(0.2), 0), Quaternion(0, decimal(0.4), 0)),
+                Transform(Vector3(0, 0, decimal(0.9)), Quaternion(0, 0, PI / decimal(2.0))),
+                Transform(Vector3(decimal(1.7), decimal(-0.2), decimal(0.3)), Quaternion::identity())
+            };
+            decimal expectedDepths[] = {decimal(0.1), decimal(0.2), decimal(0.2), decimal(0.1), decimal(0.3)};
+
+            for (int i=0; i<5; i++) {
+                for (int order=0; order<2; order++) {
+
+                    CollisionShape* first = order == 0 ? shapes1[i] : shapes2[i];
+                    CollisionShape* second = order == 0 ? shapes2[i] : shapes1[i];
+                    const Transform transform1 = order == 0 ? Transform::identity() : transforms2[i];
+                    const Transform transform2 = order == 0 ? transforms2[i] : Transform::identity();
+
+                    decimal depth, gjkDepth;
+                    uint nbContacts = testShapesCollision(first, transform1, second, transform2,
+                                                          NULL, depth);
+                    uint nbGJKContacts = testShapesCollision(first, transform1, second, transform2,
+                                                             &gjkDispatch, gjkDepth);
+                    test(nbContacts > 0);
+                    test(nbGJKContacts == 1);
+                    test(approxEqual(depth, expectedDepths[i], decimal(0.001)));
+                    test(approxEqual(depth, gjkDepth, decimal(0.01)));
+                }
+            }
+
+            // A box resting on the face of another box has a full manifold after one test
+            decimal depth;
+            test(testShapesCollision(&boxShape, Transform::identity(), &boxShape, transforms2[0],
+                                     NULL, depth) == 4);
+
+            // Two parallel capsules lying on each other have a contact at each end of
+            // their overlapping part
+            Transform parallelTransform(Vector3(decimal(0.9), decimal(0.5), 0), Quaternion::identity());
+            test(testShapesCollision(&capsuleShape, Transform::identity(), &capsuleShape,
+                                     parallelTransform, NULL, depth) == 2);
+            test(approxEqual(depth, decimal(0.1), decimal(0.001)));
+        }
+
+        /// Test the faces computed for a convex mesh and the contacts computed with the
+        /// SAT algorithm between boxes and convex meshes
+        void testPolyhedronContacts() {
+
+            // Create a cube convex mesh with two triangles on each face
+            std::vector<Vector3> vertices;
+            for (int i=0; i<8; i++) {
+                vertices.push_back(Vector3(i & 1 ? 1 : -1, i & 2 ? 1 : -1, i & 4 ? 1 : -1));
+            }
+            const uint indices[36] = {0, 1, 3, 0, 3, 2, 4, 7, 5, 4, 6, 7, 0, 4, 5, 0, 5, 1,
+                                      2, 3, 7, 2, 7, 6, 0, 2, 6, 0, 6, 4, 1, 5, 7, 1, 7, 3};
+            TriangleVertexArray::VertexDataType vertexType = sizeof(decimal) == 4 ?
+                                                             TriangleVertexArray::VERTEX_FLOAT_TYPE :
+                                                             TriangleVertexArray::VERTEX_DOUBLE_TYPE;
+            TriangleVertexArray vertexArray(8, &(vertices[0]), sizeof(Vector3), 12,
+                                            const_cast<uint*>(indices), sizeof(uint), vertexType,
+                                            TriangleVertexArray::INDEX_INTEGER_TYPE);
+            ConvexMeshShape meshShape(&vertexArray);
+            BoxShape boxShape(Vector3(1, 1, 1));
+            GJKCollisionDispatch gjkDispatch;
+
+            test(meshShape.isFacesInformationAvailable());
+            test(meshShape.getNbFaces() == 6);
+            test(meshShape.getNbEdges() == 12);
+            test(approxEqual(meshShape.getFace(0).normal.length(), decimal(1.0)));
+
+            // A mesh resting on a face of another mesh has a full manifold after one test
+            const Transform restingTransform(Vector3(decimal(0.2), decimal(2.0), decimal(-0.1)),
+                                             Quaternion(0, decimal(0.3), 0));
+            decimal depth, gjkDepth;
+            test(testShapesCollision(&meshShape, Transform::identity(), &meshShape, restingTransform,
+                                     NULL, depth) == 4);
+            test(approxEqual(depth, decimal(0.08), decimal(0.001)));
+            test(testShapesCollision(&meshShape, Transform::identity(), &meshShape, restingTransform,
+                                     &gjkDispatch, gjkDepth) == 1);
+            test(approxEqual(depth, gjkDepth, decimal(0.01)));
+
+            // Box against mesh with both orders of the shapes
+            test(testShapesCollision(&boxShape, Transform::identity(), &meshShape, restingTransform,
+                                     NULL, depth) == 4);
+            test(approxEqual(depth, decimal(0.04), decimal(0.001)));
+            test(testShapesCollision(&meshShape, restingTransform, &boxShape, Transform::identity(),
+                                     NULL, depth) == 4);
+            test(approxEqual(depth, decimal(0.04), decimal(0.001)));
+
+            // Two meshes with crossed edges have a single contact
+            const decimal sqrt2 = std::sqrt(decimal(2.0));
+            const Transform edgeTransform1(Vector3(0, 0, 0), Quaternion(PI / decimal(4.0), 0, 0));
+            const Transform edgeTransform2(Vector3(0, decimal(2.0) * sqrt2, 0),
+                                           Quaternion(0, 0, PI / decimal(4.0)));
+            test(testShapesCollision(&meshShape, edgeTransform1, &meshShape, edgeTransform2,
+                                     NULL, depth) == 1);
+            test(approxEqual(depth, decimal(0.08), decimal(0.001)));
+            testShapesCollision(&meshShape, edgeTransform1, &meshShape, edgeTransform2,
+                                &gjkDispatch, gjkDepth);
+            test(approxEqual(depth, gjkDepth, decimal(0.01)));
+
+            // Separated meshes
+            const Transform separatedTransform(Vector3(decimal(0.2), decimal(2.1), 0), Quaternion::identity());
+            test(testShapesCollision(&meshShape, Transform::identity(), &meshShape, separatedTransform,
+                                     NULL, depth) == 0);
+
+            // The separating axis cached for a pair of edges is not trusted anymore when the
+            // polyhedra have rotated and are now deeply overlapping
+            const Transform rotatedTransform1(Vector3(0, 0, 0),
+                                              Quaternion(PI / decimal(4.0), PI / decimal(12.0),
+                                                         decimal(5.0) * PI / decimal(6.0)));
+            const Transform separatedTransform2(Vector3(0, decimal(3.5), 0),
+                                                Quaternion(decimal(7.0) * PI / decimal(12.0),
+                                                           decimal(3.0) * PI / decimal(4.0),
+                                                           decimal(3.0) * PI / decimal(4.0)));
+            const Transform deepTransform2(Vector3(0, decimal(1.7), decimal(0.4)),
+                                           Quaternion(decimal(11.0) * PI / decimal(12.0),
+                                                      decimal(2.0) * PI / decimal(3.0), 0));
+            CollisionWorld world;
+            world.createCollisionBody(rotatedTransform1)->addCollisionShape(&meshShape,
+                                                                            Transform::identity());
+            CollisionBody* body2 = world.createCollisionBody(separatedTransform2);
+            body2->addCollisionShape(&meshShape, Transform::identity());
+            ContactListCallback separatedCallback;
+            world.testCollision(&separatedCallback);
+            test(separatedCallback.penetrationDepths.empty());
+
+            const uint nbColdContacts = testShapesCollision(&meshShape, rotatedTransform1, &meshShape,
+                                                            deepTransform2, NULL, depth);
+            test(nbColdContacts > 0);
+            body2->setTransform(deepTransform2);
+            for (int step=0; step<3; step++) {
+                ContactListCallback callback;
+                world.testCollision(&callback);
+                test(callback.penetrationDepths.size() == nbColdContacts);
+                decimal warmDepth = decimal(0.0);
+                for (uint i=0; i<callback.penetrationDepths.size(); i++) {
+                    warmDepth = std::max(warmDepth, callback.penetrationDepths[i]);
+                }
+                test(approxEqual(warmDepth, depth, decimal(0.001)));
+            }
+        }
+
+        /// Test that the hill-climbing on the adjacency of the vertices of a large convex
+        /// mesh finds the same support points as testing all the vertices
+        void testConvexMeshSupportPoints() {
+
+            // Create a sphere mesh with 12 rings of 16 vertices and the two poles
+            const int nbRings = 12;
+            const int nbSegments = 16;
+            std::vector<Vector3> vertices;
+            vertices.push_back(Vector3(0, 1, 0));
+            for (int r=1; r<=nbRings; r++) {
+                const decimal theta = PI * decimal(r) / decimal(nbRings + 1);
+                for (int s=0; s<nbSegments; s++) {
+                    const decimal phi = PI_TIMES_2 * decimal(s) / decimal(nbSegments);
+                    vertices.push_back(Vector3(std::sin(theta) * std::cos(phi), std::cos(theta),
+                                               std::sin(theta) * std::sin(phi)));
+                }
+            }
+            vertices.push_back(Vector3(0, -1, 0));
+            const uint lastVertex = static_cast<uint>(vertices.size()) - 1;
+
+            std::vector<uint> indices;
+            for (int s=0; s<nbSegments; s++) {
+                const uint next = (s + 1) % nbSegments;
+                indices.push_back(0); indices.push_back(1 + s); indices.push_back(1 + next);
+                const uint lastRing = 1 + (nbRings - 1) * nbSegments;
+                indices.push_back(lastVertex); indices.push_back(lastRing + next);
+                indices.push_back(lastRing + s);
+                for (int r=0; r+1<nbRings; r++) {
+                    const uint a = 1 + r * nbSegments + s;
+                    const uint b = 1 + r * nbSegments + next;
+                    indices.push_back(a); indices.push_back(a + nbSegments); indices.push_back(b);
+                    indices.push_back(b); indices.push_back(a + nbSegments); indices.push_back(b + nbSegments);
+                }
+            }
+            TriangleVertexArray::VertexDataType vertexType = sizeof(decimal) == 4 ?
+                                                             TriangleVertexArray::VERTEX_FLOAT_TYPE :
+                                                             TriangleVertexArray::VERTEX_DOUBLE_TYPE;
+            TriangleVertexArray vertexArray(vertices.size(), &(vertices[0]), sizeof(Vector3),
+                                            indices.size() / 3, &(indices[0]), sizeof(uint),
+                                            vertexType, TriangleVertexArray::INDEX_INTEGER_TYPE);
+            ConvexMeshShape meshShapeEdges(&vertexArray, true);
+            ConvexMeshShape meshShapeNoEdges(&vertexArray, false);
+            test(meshShapeEdges.getNbVertices() > CONVEX_MESH_MAX_NB_VERTICES_BRUTE_FORCE_SUPPORT);
+
+            // The same mesh built vertex by vertex and edge by edge
+            ConvexMeshShape meshShapeAdded;
+            for (uint v=0; v<vertices.size(); v++) {
+                meshShapeAdded.addVertex(vertices[v]);
+            }
+            for (uint t=0; t + 2 < indices.size(); t += 3) {
+                meshShapeAdded.addEdge(indices[t], indices[t + 1]);
+                meshShapeAdded.addEdge(indices[t + 1], indices[t + 2]);
+                meshShapeAdded.addEdge(indices[t + 2], indices[t]);
+            }
+            meshShapeAdded.setIsEdgesInformationUsed(true);
+
+            // Collide a box with the two meshes from many directions
+            BoxShape boxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            GJKCollisionDispatch gjkDispatch;
+            for (int i=0; i<16; i++) {
+                const decimal angle = decimal(i) * decimal(0.7);
+                const Vector3 direction(std::cos(angle) * std::cos(decimal(i) * decimal(0.3)),
+                                        std::sin(decimal(i) * decimal(0.3)),
+                                        std::sin(angle) * std::cos(decimal(i) * decimal(0.3)));
+                const Transform boxTransform(decimal(1.3) * direction,
+                                             Quaternion(decimal(0.1) * i, decimal(0.2), 0));
+                decimal depthEdges, depthNoEdges;
+                const uint nbContactsEdges = testShapesCollision(&meshShapeEdges, Transform::identity(),
+                                                                 &boxShape, boxTransform,
+                                                                 &gjkDispatch, depthEdges);
+                const uint nbContactsNoEdges = testShapesCollision(&meshShapeNoEdges, Transform::identity(),
+                                                                   &boxShape, boxTransform,
+                                                                   &gjkDispatch, depthNoEdges);
+                decimal depthAdded;
+                const uint nbContactsAdded = testShapesCollision(&meshShapeAdded, Transform::identity(),
+                                                                 &boxShape, boxTransform,
+                                                                 &gjkDispatch, depthAdded);
+                test(nbContactsEdges == nbContactsNoEdges);
+                test(nbContactsEdges == nbContactsAdded);
+                test(nbContactsEdges > 0);
+                test(approxEqual(depthEdges, depthNoEdges, decimal(0.001)));
+                test(approxEqual(depthEdges, depthAdded, decimal(0.001)));
+            }
+
+            // A vertex added after the adjacency arrays have been built is still a support point
+            const Transform topBoxTransform(Vector3(0, decimal(2.4), 0), Quaternion::identity());
+            decimal depth;
+            test(testShapesCollision(&meshShapeAdded, Transform::identity(), &boxShape,
+                                     topBoxTransform, &gjkDispatch, depth) == 0);
+            meshShapeAdded.addVertex(Vector3(0, 2, 0));
+            test(testShapesCollision(&meshShapeAdded, Transform::identity(), &boxShape,
+                                     topBoxTransform, &gjkDispatch, depth) == 1);
+        }
+
+        /// Test that the EPA algorithm reuses and grows its storage of the polytope
+        /// and that it reports its counters for the last collision test
+        void testEPA() {
+
+            // The triangles store grows and the triangles are never moved
+            TrianglesStore triangleStore;
+            Vector3 points[3] = {Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(0, 0, 1)};
+            TriangleEPA* firstTriangle = triangleStore.newTriangle(points, 0, 1, 2);
+            test(firstTriangle != NULL);
+            for (uint i=1; i<3 * NB_TRIANGLES_PER_BLOCK; i++) {
+                triangleStore.newTriangle(points, 0, 1, 2);
+            }
+            test(triangleStore.getNbTriangles() == int(3 * NB_TRIANGLES_PER_BLOCK));
+            test(&triangleStore[0] == firstTriangle);
+            const uint capacity = triangleStore.getCapacity();
+            triangleStore.clear();
+            test(triangleStore.newTriangle(points, 0, 1, 2) == firstTriangle);
+            test(triangleStore.getCapacity() == capacity);
+
+            // Two cylinders whose objects without margin overlap
+            CylinderShape cylinderShape(decimal(1.0), decimal(3.0));
+            CollisionWorld world;
+            world.createCollisionBody(Transform::identity())->addCollisionShape(&cylinderShape,
+                                                                                 Transform::identity());
+            CollisionBody* body = world.createCollisionBody(Transform::identity());
+            body->addCollisionShape(&cylinderShape, Transform::identity());
+
+            for (int i=0; i<10; i++) {
+                const Transform transform(Vector3(decimal(0.4) + decimal(0.1) * i, decimal(0.2), 0),
+                                          Quaternion(decimal(0.3) * i, decimal(0.1), 0));
+                body->setTransform(transform);
+                ContactListCallback callback;
+                world.testCollision(&callback);
+                test(callback.penetrationDepths.size() == 1);
+                test(callback.penetrationDepths[0] > decimal(0.0));
+
+                const EPAStatistics& statistics = world.getEPAStatistics();
+                test(statistics.nbRuns == 1);
+                test(statistics.nbConvergedRuns == 1);
+                test(statistics.nbIterations > 0);
+                test(statistics.maxNbIterations == statistics.nbIterations);
+                test(statistics.maxNbTriangles >= 4);
+                test(statistics.nbInvalidPolytopeExits == 0);
+                test(statistics.nbSilhouetteExits == 0);
+                test(statistics.nbMaxSupportPointsExits == 0);
+            }
+
+            // The counters are reset when EPA is not needed anymore
+            body->setTransform(Transform(Vector3(10, 0, 0), Quaternion::identity()));
+            ContactListCallback callback;
+            world.testCollision(&callback);
+            test(callback.penetrationDepths.empty());
+            test(world.getEPAStatistics().nbRuns == 0);
+        }
+
+        /// Test the convex cast of a sphere and a box against a box, a sphere and a concave mesh
+        void testConvexCast() {
+
+            BoxShape boxShape(Vector3(1, 1, 1));
+            SphereShape sphereShape(decimal(1.0));
+            SphereShape castSphereShape(decimal(0.5));
+            BoxShape castBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+
+            // Concave wall made of two triangles in the plane x=0
+            const Vector3 vertices[4] = {Vector3(0, -5, -5), Vector3(0, -5, 5),
+                                         Vector3(0, 5, 5), Vector3(0, 5, -5)};
+            const uint indices[6] = {0, 1, 2, 0, 2, 3};
+            TriangleVertexArray::VertexDataType vertexType = sizeof(decimal) == 4 ?
+                                                             TriangleVertexArray::VERTEX_FLOAT_TYPE :
+                                                             TriangleVertexArray::VERTEX_DOUBLE_TYPE;
+            TriangleVertexArray vertexArray(4, const_cast<Vector3*>(vertices), sizeof(Vector3), 2,
+                                            const_cast<uint*>(indices), sizeof(uint), vertexType,
+                                            TriangleVertexArray::INDEX_INTEGER_TYPE);
+            TriangleMesh triangleMesh;
+            triangleMesh.addSubpart(&vertexArray);
+            ConcaveMeshShape meshShape(&triangleMesh);
+
+            CollisionWorld world;
+            CollisionBody* box = world.createCollisionBody(Transform(Vector3(10, 0, 0),
+                                                                     Quaternion::identity()));
+            box->addCollisionShape(&boxShape, Transform::identity())->setCollisionCategoryBits(CATEGORY_1);
+            CollisionBody* sphere = world.createCollisionBody(Transform(Vector3(20, 0, 0),
+                                                                        Quaternion::identity()));
+            sphere->addCollisionShape(&sphereShape, Transform::identity())->setCollisionCategoryBits(CATEGORY_2);
+            CollisionBody* wall = world.createCollisionBody(Transform(Vector3(30, 0, 0),
+                                                                      Quaternion::identity()));
+            wall->addCollisionShape(&meshShape, Transform::identity())->setCollisionCategoryBits(CATEGORY_2);
+
+            const Transform fromTransform(Vector3(0, decimal(0.2), decimal(0.1)), Quaternion::identity());
+            const Transform toTransform(Vector3(40, decimal(0.2), decimal(0.1)), Quaternion::identity());
+
+            // All the hits of a sphere
+            ConvexCastHitsCallback allHits(false);
+            world.convexCast(&castSphereShape, fromTransform, toTransform, &allHits);
+            test(allHits.bodyIDs.size() == 3);
+            for (uint i=0; i<allHits.bodyIDs.size(); i++) {
+                const decimal fraction = allHits.hitFractions[i];
+                if (allHits.bodyIDs[i] == box->getID()) {
+                    test(approxEqual(fraction, decimal(8.5 / 40.0), decimal(0.001)));
+                    test(approxEqual(allHits.worldNormals[i].x, decimal(-1.0), decimal(0.01)));
+                    test(approxEqual(allHits.worldPoints[i].x, decimal(9.0), decimal(0.01)));
+                    test(approxEqual(allHits.worldPoints[i].y, decimal(0.2), decimal(0.01)));
+                }
+                else if (allHits.bodyIDs[i] == sphere->getID()) {
+                    test(fraction > decimal(18.0 / 40.0) && fraction < decimal(18.6 / 40.0));
+                }
+                else {
+                    test(allHits.bodyIDs[i] == wall->getID());
+                    test(approxEqual(fraction, decimal(29.5 / 40.0), decimal(0.001)));
+                    test(approxEqual(allHits.worldNormals[i].x, decimal(-1.0), decimal(0.01)));
+                }
+            }
+
+            // Closest hit of a box and closest hit with a category mask
+            ConvexCastHitsCallback closestHit(true);
+            world.convexCast(&castBoxShape, fromTransform, toTransform, &closestHit);
+            test(closestHit.bodyIDs.size() == 1 && closestHit.bodyIDs[0] == box->getID());
+            test(approxEqual(closestHit.hitFractions[0], decimal(8.5 / 40.0), decimal(0.001)));
+
+            ConvexCastHitsCallback maskedHit(true);
+            world.convexCast(&castBoxShape, fromTransform, toTransform, &maskedHit, CATEGORY_2);
+            test(maskedHit.bodyIDs.size() == 1 && maskedHit.bodyIDs[0] == sphere->getID());
+
+            // A rotating box that starts in contact with the box and a motion that misses everything
+            ConvexCastHitsCallback rotatingHits(false);
+            world.convexCast(&castBoxShape, Transform(Vector3(decimal(8.5), 0, 0), Quaternion::identity()),
+                             Transform(Vector3(decimal(8.5), 0, 0), Quaternion(0, 0, decimal(0.8))),
+                             &rotatingHits);
+            test(rotatingHits.bodyIDs.size() == 1 && rotatingHits.hitFractions[0] == decimal(0.0));
+
+            ConvexCastHitsCallback noHits(false);
+            world.convexCast(&castSphereShape, Transform(Vector3(0, 8, 0), Quaternion::identity()),
+                             Transform(Vector3(40, 8, 0), Quaternion::identity()), &noHits);
+            test(noHits.bodyIDs.empty());
+        }
  };
 
 }
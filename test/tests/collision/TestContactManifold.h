@@ -0,0 +1,260 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_CONTACT_MANIFOLD_H
+#define TEST_CONTACT_MANIFOLD_H
+
+// Libraries
+#include "reactphysics3d.h"
+#include "collision/ContactManifold.h"
+#include "collision/ContactManifoldPool.h"
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestContactManifold
+/**
+ * Unit test for the ContactManifold class.
+ */
+class TestContactManifold : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        // Collision world used to create the proxy shapes of the contacts
+        CollisionWorld mWorld;
+
+        // Collision shapes
+        BoxShape mFloorShape;
+        BoxShape mBoxShape;
+
+        // Proxy shapes of the floor and of the box
+        ProxyShape* mFloorProxyShape;
+        ProxyShape* mBoxProxyShape;
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestContactManifold(const std::string& name)
+            : Test(name), mFloorShape(Vector3(5, decimal(0.5), 5)),
+              mBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5))) {
+
+            CollisionBody* floor = mWorld.createCollisionBody(Transform::identity());
+            mFloorProxyShape = floor->addCollisionShape(&mFloorShape, Transform::identity());
+
+            CollisionBody* box = mWorld.createCollisionBody(Transform(Vector3(0, decimal(0.99), 0),
+                                                                      Quaternion::identity()));
+            mBoxProxyShape = box->addCollisionShape(&mBoxShape, Transform::identity());
+        }
+
+        /// Return a contact between the top of the floor and a corner of the box
+        ContactPointInfo createContactInfo(const Vector3& floorPoint, const Vector3& boxPoint,
+                                           uint featureId) {
+
+            ContactPointInfo contactInfo(mFloorProxyShape, mBoxProxyShape, &mFloorShape, &mBoxShape,
+                                         Vector3(0, 1, 0), decimal(0.01), floorPoint, boxPoint);
+            contactInfo.featureId = featureId;
+
+            return contactInfo;
+        }
+
+        /// Run the tests
+        void run() {
+
+            testFeatureIds();
+            testPersistentFeatureContacts();
+            testReplacedContactFrictionVectors();
+            testFullManifold();
+            testManifoldPool();
+        }
+
+        /// Test the feature ids of the contacts
+        void testFeatureIds() {
+
+            const uint id1 = computeContactFeatureId(CONTACT_FEATURE_VERTEX, 3, CONTACT_FEATURE_FACE, 0);
+            const uint id2 = computeContactFeatureId(CONTACT_FEATURE_FACE, 0, CONTACT_FEATURE_VERTEX, 3);
+            const uint id3 = computeContactFeatureId(CONTACT_FEATURE_EDGE, 3, CONTACT_FEATURE_FACE, 0);
+
+            test(id1 != NO_CONTACT_FEATURE_ID);
+            test(id1 == computeContactFeatureId(CONTACT_FEATURE_VERTEX, 3, CONTACT_FEATURE_FACE, 0));
+            test(id1 != id2);
+            test(id1 != id3);
+        }
+
+        /// Test that a contact with a feature id keeps its cached impulses when the
+        /// bodies slide and is removed when the features are not in contact anymore
+        void testPersistentFeatureContacts() {
+
+            ContactManifold manifold(mFloorProxyShape, mBoxProxyShape, 0);
+            const uint featureId = computeContactFeatureId(CONTACT_FEATURE_FACE, 0,
+                                                           CONTACT_FEATURE_VERTEX, 0);
+
+            // A contact between two features and a contact without features
+            manifold.addContactPoint(createContactInfo(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)),
+                                                       Vector3(decimal(0.5), decimal(-0.5), decimal(0.5)),
+                                                       featureId));
+            ContactPoint* featureContact = manifold.getContactPoint(0);
+            featureContact->setIsRestingContact(true);
+            featureContact->setPenetrationImpulse(decimal(5.0));
+            featureContact->setFrictionImpulse1(decimal(2.0));
+            manifold.addContactPoint(createContactInfo(Vector3(decimal(-0.5), decimal(0.5), decimal(-0.5)),
+                                                       Vector3(decimal(-0.5), decimal(-0.5), decimal(-0.5)),
+                                                       NO_CONTACT_FEATURE_ID));
+            test(manifold.getNbContactPoints() == 2);
+
+            // The box slides further than the persistent contact distance threshold
+            const Transform boxTransform(Vector3(decimal(0.2), decimal(0.99), 0), Quaternion::identity());
+            manifold.update(Transform::identity(), boxTransform);
+            test(manifold.getNbContactPoints() == 1);
+            test(manifold.getContactPoint(0)->getIsObsolete());
+
+            // The narrow-phase finds the contact between the same features again
+            manifold.addContactPoint(createContactInfo(Vector3(decimal(0.7), decimal(0.5), decimal(0.5)),
+                                                       Vector3(decimal(0.5), decimal(-0.5), decimal(0.5)),
+                                                       featureId));
+            manifold.removeObsoleteContactPoints();
+            test(manifold.getNbContactPoints() == 1);
+            const ContactPoint* newContact = manifold.getContactPoint(0);
+            test(newContact->getFeatureId() == featureId);
+            test(approxEqual(newContact->getLocalPointOnBody1().x, decimal(0.7)));
+            test(!newContact->getIsObsolete());
+            test(newContact->getIsRestingContact());
+            test(approxEqual(newContact->getPenetrationImpulse(), decimal(5.0)));
+            test(approxEqual(newContact->getFrictionImpulse1(), decimal(2.0)));
+
+            // The contact is removed if the narrow-phase does not find it again
+            manifold.update(Transform::identity(), boxTransform);
+            manifold.removeObsoleteContactPoints();
+            test(manifold.getNbContactPoints() == 0);
+        }
+
+        /// Test that a contact replaced by a new contact between the same features keeps
+        /// its friction vectors for the warm-starting of the friction impulses
+        void testReplacedContactFrictionVectors() {
+
+            ContactManifold manifold(mFloorProxyShape, mBoxProxyShape, 0);
+            const uint featureId = computeContactFeatureId(CONTACT_FEATURE_FACE, 0,
+                                                           CONTACT_FEATURE_VERTEX, 0);
+
+            manifold.addContactPoint(createContactInfo(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)),
+                                                       Vector3(decimal(0.5), decimal(-0.5), decimal(0.5)),
+                                                       featureId));
+            ContactPoint* oldContact = manifold.getContactPoint(0);
+            oldContact->setFrictionImpulse1(decimal(2.0));
+            oldContact->setFrictionImpulse2(decimal(-1.0));
+            oldContact->setFrictionVector1(Vector3(1, 0, 0));
+            oldContact->setFrictionVector2(Vector3(0, 0, 1));
+
+            // The narrow-phase finds the contact between the same features again
+            manifold.addContactPoint(createContactInfo(Vector3(decimal(0.6), decimal(0.5), decimal(0.5)),
+                                                       Vector3(decimal(0.5), decimal(-0.5), decimal(0.5)),
+                                                       featureId));
+            test(manifold.getNbContactPoints() == 1);
+            const ContactPoint* newContact = manifold.getContactPoint(0);
+            test(approxEqual(newContact->getLocalPointOnBody1().x, decimal(0.6)));
+            test(approxEqual(newContact->getFrictionImpulse2(), decimal(-1.0)));
+            test(newContact->getFrictionVector1() == Vector3(1, 0, 0));
+            test(newContact->getFrictionVector2() == Vector3(0, 0, 1));
+        }
+
+        /// Test that the contacts added to a full manifold are stored in the manifold
+        void testFullManifold() {
+
+            ContactManifold manifold(mFloorProxyShape, mBoxProxyShape, 0);
+
+            // Add the four corners of the box and then contacts inside the square
+            const decimal corners[4][2] = {{-0.5, -0.5}, {0.5, -0.5}, {0.5, 0.5}, {-0.5, 0.5}};
+            for (int i=0; i<10; i++) {
+                const decimal x = i < 4 ? corners[i][0] : decimal(-0.4) + decimal(0.1) * i;
+                const decimal z = i < 4 ? corners[i][1] : decimal(0.1);
+                manifold.addContactPoint(createContactInfo(Vector3(x, decimal(0.5), z),
+                                                           Vector3(x, decimal(-0.5), z),
+                                                           computeContactFeatureId(CONTACT_FEATURE_FACE, 0,
+                                                                                   CONTACT_FEATURE_VERTEX, i)));
+                test(manifold.getNbContactPoints() == static_cast<uint>(i < 4 ? i + 1 : 4));
+            }
+
+            // The contact points must be distinct and stored in the memory of the manifold
+            bool isInManifold = true;
+            bool isDistinct = true;
+            for (uint i=0; i<manifold.getNbContactPoints(); i++) {
+                const char* contact = reinterpret_cast<const char*>(manifold.getContactPoint(i));
+                isInManifold = isInManifold && contact >= reinterpret_cast<const char*>(&manifold) &&
+                               contact < reinterpret_cast<const char*>(&manifold) + sizeof(ContactManifold);
+                for (uint j=0; j<i; j++) {
+                    isDistinct = isDistinct && manifold.getContactPoint(i) != manifold.getContactPoint(j);
+                }
+            }
+            test(isInManifold);
+            test(isDistinct);
+
+            manifold.clear();
+            test(manifold.getNbContactPoints() == 0);
+        }
+
+        /// Test that the pool reuses the memory of the destroyed contact manifolds
+        void testManifoldPool() {
+
+            ContactManifoldPool pool;
+            test(pool.getNbUsedManifolds() == 0);
+
+            std::vector<ContactManifold*> manifolds;
+            for (int i=0; i<100; i++) {
+                manifolds.push_back(pool.createManifold(mFloorProxyShape, mBoxProxyShape, 0));
+            }
+            test(pool.getNbUsedManifolds() == 100);
+            const uint nbAllocatedManifolds = pool.getNbAllocatedManifolds();
+            test(nbAllocatedManifolds >= 100);
+
+            // Destroy half of the manifolds and create them again
+            for (int i=0; i<100; i+=2) {
+                pool.destroyManifold(manifolds[i]);
+            }
+            test(pool.getNbUsedManifolds() == 50);
+            for (int i=0; i<100; i+=2) {
+                manifolds[i] = pool.createManifold(mFloorProxyShape, mBoxProxyShape, 0);
+                manifolds[i]->addContactPoint(createContactInfo(Vector3(0, decimal(0.5), 0),
+                                                                Vector3(0, decimal(-0.5), 0),
+                                                                NO_CONTACT_FEATURE_ID));
+            }
+            test(pool.getNbUsedManifolds() == 100);
+            test(pool.getNbAllocatedManifolds() == nbAllocatedManifolds);
+            test(manifolds[0]->getNbContactPoints() == 1);
+            test(manifolds[1]->getNbContactPoints() == 0);
+
+            for (int i=0; i<100; i++) {
+                pool.destroyManifold(manifolds[i]);
+            }
+            test(pool.getNbUsedManifolds() == 0);
+        }
+};
+
+}
+
+#endif
@@ -107,6 +107,8 @@ class TestDynamicAABBTree : public Test {
             testBasicsMethods();
             testOverlapping();
             testRaycast();
+            testBulkInsertionAndRebuild();
+            testOptimize();
 
         }
 
@@ -516,6 +518,170 @@ class TestDynamicAABBTree : public Test {
             test(mRaycastCallback.isHit(object3Id));
             test(mRaycastCallback.isHit(object4Id));
         }
+        void testBulkInsertionAndRebuild() {
+
+            // ------------- Create tree ----------- //
+
+            // Dynamic AABB Tree
+            DynamicAABBTree tree;
+
+            int object1Data = 56;
+            int object2Data = 23;
+            int object3Data = 13;
+            int object4Data = 7;
+            int object5Data = 3;
+
+            // The first object is inserted before the bulk insertion
+            AABB aabb1 = AABB(Vector3(-6, 4, -3), Vector3(4, 8, 3));
+            int object1Id = tree.addObject(aabb1, &object1Data);
+
+            tree.beginBulkInsertion();
+            test(tree.isBulkInsertionActive());
+
+            AABB aabb2 = AABB(Vector3(5, 2, -3), Vector3(10, 7, 3));
+            int object2Id = tree.addObject(aabb2, &object2Data);
+
+            AABB aabb3 = AABB(Vector3(-5, 1, -3), Vector3(-2, 3, 3));
+            int object3Id = tree.addObject(aabb3, &object3Data);
+
+            AABB aabb4 = AABB(Vector3(20, 20, 20), Vector3(21, 21, 21));
+            int object4Id = tree.addObject(aabb4, &object4Data);
+
+            AABB aabb5 = AABB(Vector3(30, 30, 30), Vector3(31, 31, 31));
+            int object5Id = tree.addObject(aabb5, &object5Data);
+
+            // Objects can be moved and removed during the bulk insertion
+            tree.updateObject(object4Id, AABB(Vector3(0, -4, -3), Vector3(3, -2, 3)), Vector3::zero());
+            tree.removeObject(object5Id);
+
+            tree.endBulkInsertion();
+            test(!tree.isBulkInsertionActive());
+
+            // ---------- Tests ---------- //
+
+            test(tree.getNodeDataPointer(object1Id) == &object1Data);
+            test(tree.getNodeDataPointer(object2Id) == &object2Data);
+            test(tree.getNodeDataPointer(object3Id) == &object3Data);
+            test(tree.getNodeDataPointer(object4Id) == &object4Data);
+            test(tree.computeHeight() == 2);
+
+            // AABB overlapping object 1 and 3
+            mOverlapCallback.reset();
+            tree.reportAllShapesOverlappingWithAABB(AABB(Vector3(-4, 2, -4), Vector3(-1, 7, 4)), mOverlapCallback);
+            test(mOverlapCallback.isOverlapping(object1Id));
+            test(!mOverlapCallback.isOverlapping(object2Id));
+            test(mOverlapCallback.isOverlapping(object3Id));
+            test(!mOverlapCallback.isOverlapping(object4Id));
+
+            // AABB overlapping object 3 and 4
+            mOverlapCallback.reset();
+            tree.reportAllShapesOverlappingWithAABB(AABB(Vector3(-6, -5, -2), Vector3(2, 2, 0)), mOverlapCallback);
+            test(!mOverlapCallback.isOverlapping(object1Id));
+            test(!mOverlapCallback.isOverlapping(object2Id));
+            test(mOverlapCallback.isOverlapping(object3Id));
+            test(mOverlapCallback.isOverlapping(object4Id));
+
+            // Ray that hits object 2 only
+            Ray ray(Vector3(7, 15, 0), Vector3(7, 0, 0));
+            mRaycastCallback.reset();
+            tree.raycast(ray, mRaycastCallback);
+            test(!mRaycastCallback.isHit(object1Id));
+            test(mRaycastCallback.isHit(object2Id));
+            test(!mRaycastCallback.isHit(object3Id));
+            test(!mRaycastCallback.isHit(object4Id));
+
+            // ------------- Rebuild a large tree ----------- //
+
+            DynamicAABBTree largeTree;
+            std::vector<AABB> aabbs;
+            std::vector<int> objectIds;
+            int objectData = 0;
+            for (int i=0; i<1000; i++) {
+                const Vector3 position((i * 37) % 101, (i * 13) % 7, (i * 71) % 97);
+                aabbs.push_back(AABB(position, position + Vector3(1 + i % 3, 1, 2)));
+                objectIds.push_back(largeTree.addObject(aabbs[i], &objectData));
+            }
+            const int heightBeforeRebuild = largeTree.computeHeight();
+            largeTree.rebuild();
+            test(largeTree.computeHeight() <= heightBeforeRebuild);
+
+            // The objects can still be removed and updated after the rebuild
+            for (int i=0; i<1000; i += 2) {
+                largeTree.removeObject(objectIds[i]);
+            }
+            for (int i=1; i<1000; i += 4) {
+                aabbs[i] = AABB(aabbs[i].getMin() + Vector3(50, 0, 0), aabbs[i].getMax() + Vector3(50, 0, 0));
+                largeTree.updateObject(objectIds[i], aabbs[i], Vector3::zero());
+            }
+
+            // Compare the overlapping objects with a brute-force test
+            bool isCorrect = true;
+            const AABB queryAABB(Vector3(20, 0, 20), Vector3(70, 3, 60));
+            mOverlapCallback.reset();
+            largeTree.reportAllShapesOverlappingWithAABB(queryAABB, mOverlapCallback);
+            for (int i=1; i<1000; i += 2) {
+                if (mOverlapCallback.isOverlapping(objectIds[i]) != queryAABB.testCollision(aabbs[i])) {
+                    isCorrect = false;
+                }
+            }
+            test(isCorrect);
+            test(mOverlapCallback.mOverlapNodes.size() <= 500);
+        }
+
+        void testOptimize() {
+
+            // ------------- Create a degraded tree ----------- //
+
+            DynamicAABBTree tree;
+            std::vector<AABB> aabbs;
+            std::vector<int> objectIds;
+            int objectData = 0;
+            for (int i=0; i<1000; i++) {
+                const Vector3 position(i % 10, i / 100, (i / 10) % 10);
+                aabbs.push_back(AABB(position, position + Vector3(1, 1, 1)));
+                objectIds.push_back(tree.addObject(aabbs[i], &objectData));
+            }
+
+            // Move the objects far away from their initial positions
+            for (int i=0; i<1000; i++) {
+                const Vector3 position((i * 37) % 101, (i * 13) % 7, (i * 71) % 97);
+                aabbs[i] = AABB(position, position + Vector3(1, 1, 1));
+                tree.updateObject(objectIds[i], aabbs[i], Vector3::zero());
+            }
+
+            // ------------- Optimize the tree ----------- //
+
+            const decimal initialCost = tree.computeCost();
+            test(initialCost > decimal(1.0));
+
+            uint nbRebuiltSubTrees = 0;
+            for (int i=0; i<50; i++) {
+                nbRebuiltSubTrees += tree.optimize(100);
+            }
+            test(nbRebuiltSubTrees > 0);
+            test(tree.computeCost() < initialCost);
+
+            // Compare the overlapping objects with a brute-force test
+            bool isCorrect = true;
+            const AABB queryAABB(Vector3(20, 0, 20), Vector3(70, 3, 60));
+            mOverlapCallback.reset();
+            tree.reportAllShapesOverlappingWithAABB(queryAABB, mOverlapCallback);
+            for (int i=0; i<1000; i++) {
+                if (mOverlapCallback.isOverlapping(objectIds[i]) != queryAABB.testCollision(aabbs[i])) {
+                    isCorrect = false;
+                }
+            }
+            test(isCorrect);
+
+            // The tree can still be modified after the optimization
+            for (int i=0; i<1000; i += 2) {
+                tree.removeObject(objectIds[i]);
+            }
+            mOverlapCallback.reset();
+            tree.reportAllShapesOverlappingWithAABB(AABB(Vector3(-1, -1, -1), Vector3(200, 200, 200)),
+                                                    mOverlapCallback);
+            test(mOverlapCallback.mOverlapNodes.size() == 500);
+        }
  };
 
 }
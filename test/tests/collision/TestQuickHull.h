@@ -0,0 +1,218 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_QUICK_HULL_H
+#define TEST_QUICK_HULL_H
+
+// Libraries
+#include "Test.h"
+#include "collision/shapes/QuickHull.h"
+#include "collision/shapes/ConvexMeshShape.h"
+#include <vector>
+#include <set>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestQuickHull
+/**
+ * Unit test for the convex hull of a cloud of points
+ */
+class TestQuickHull : public Test {
+
+    private :
+
+        // ---------- Methods ---------- //
+
+        /// Return a pseudo-random number between zero and one
+        static decimal random(uint32& seed) {
+            seed = seed * 1664525u + 1013904223u;
+            return decimal(seed >> 8) / decimal(1 << 24);
+        }
+
+        /// Return true if the points are behind all the triangles of the hull (with a tolerance)
+        static bool isInsideHull(const QuickHull& hull, const std::vector<Vector3>& points,
+                                 decimal tolerance) {
+
+            const std::vector<uint>& indices = hull.getTrianglesVertexIndices();
+            for (uint t=0; t<indices.size(); t += 3) {
+                const Vector3& v0 = hull.getVertex(indices[t]);
+                const Vector3 normal = (hull.getVertex(indices[t + 1]) - v0).cross(
+                                        hull.getVertex(indices[t + 2]) - v0).getUnit();
+                for (uint i=0; i<points.size(); i++) {
+                    if (normal.dot(points[i] - v0) > tolerance) return false;
+                }
+            }
+            return true;
+        }
+
+        /// Return true if each edge of the hull is shared by exactly two triangles with
+        /// opposite directions
+        static bool isClosedHull(const QuickHull& hull) {
+
+            const std::vector<uint>& indices = hull.getTrianglesVertexIndices();
+            std::set<std::pair<uint, uint> > edges;
+            for (uint t=0; t<indices.size(); t += 3) {
+                for (int k=0; k<3; k++) {
+                    std::pair<uint, uint> edge(indices[t + k], indices[t + (k + 1) % 3]);
+                    if (!edges.insert(edge).second) return false;
+                }
+            }
+            for (std::set<std::pair<uint, uint> >::const_iterator it = edges.begin(); it != edges.end(); ++it) {
+                if (edges.count(std::make_pair(it->second, it->first)) == 0) return false;
+            }
+
+            // Euler characteristic of a closed triangle mesh (V - E + F = 2)
+            return hull.getNbVertices() + hull.getNbTriangles() == edges.size() / 2 + 2;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestQuickHull(const std::string& name): Test(name)  {
+
+        }
+
+        /// Run the tests
+        void run() {
+
+            testCubeCloud();
+            testSphereCloud();
+            testDegenerateCloud();
+            testConvexMeshShape();
+        }
+
+        void testCubeCloud() {
+
+            // Corners of a cube, points inside the cube, on its faces and near its corners
+            std::vector<Vector3> points;
+            uint32 seed = 1;
+            for (int i=0; i<100; i++) {
+                points.push_back(Vector3(random(seed) * 2 - 1, random(seed) * 2 - 1, random(seed) * 2 - 1));
+                points.push_back(Vector3(1, random(seed) * 2 - 1, random(seed) * 2 - 1));
+            }
+            for (int i=0; i<8; i++) {
+                const Vector3 corner(i & 1 ? 1 : -1, i & 2 ? 1 : -1, i & 4 ? 1 : -1);
+                points.push_back(corner);
+                points.push_back(corner * decimal(0.9999));
+            }
+
+            QuickHull hull;
+            test(hull.computeHull(&(points[0].x), points.size(), sizeof(Vector3), 1000, decimal(0.001)));
+            test(hull.getNbVertices() == 8);
+            test(hull.getNbTriangles() == 12);
+            test(isClosedHull(hull));
+            test(isInsideHull(hull, points, decimal(0.001)));
+            for (uint v=0; v<hull.getNbVertices(); v++) {
+                const Vector3 vertex = hull.getVertex(v).getAbsoluteVector();
+                test(approxEqual(vertex.x, 1, decimal(0.001)) && approxEqual(vertex.y, 1, decimal(0.001)) &&
+                     approxEqual(vertex.z, 1, decimal(0.001)));
+            }
+        }
+
+        void testSphereCloud() {
+
+            // Points on the surface of a sphere and inside it
+            std::vector<Vector3> points;
+            uint32 seed = 7;
+            for (int i=0; i<2000; i++) {
+                Vector3 point(random(seed) * 2 - 1, random(seed) * 2 - 1, random(seed) * 2 - 1);
+                if (point.length() < decimal(0.1)) continue;
+                if (i % 2 == 0) point.normalize();
+                else if (point.length() > decimal(0.9)) point = decimal(0.9) * point.getUnit();
+                points.push_back(point);
+            }
+
+            // Complete hull of the points
+            QuickHull hull;
+            test(hull.computeHull(&(points[0].x), points.size(), sizeof(Vector3), 10000, decimal(0.0)));
+            test(hull.getNbVertices() > 100);
+            test(hull.getNbVertices() <= 1000);
+            test(isClosedHull(hull));
+            test(isInsideHull(hull, points, decimal(0.0001)));
+
+            // Simplified hull with a maximum number of vertices
+            test(hull.computeHull(&(points[0].x), points.size(), sizeof(Vector3), 32, decimal(0.0)));
+            test(hull.getNbVertices() <= 32);
+            test(hull.getNbVertices() >= 30);
+            test(isClosedHull(hull));
+            std::vector<Vector3> hullVertices;
+            for (uint v=0; v<hull.getNbVertices(); v++) {
+                hullVertices.push_back(hull.getVertex(v));
+                test(approxEqual(hull.getVertex(v).length(), decimal(1.0), decimal(0.001)));
+            }
+            test(isInsideHull(hull, hullVertices, decimal(0.0001)));
+
+            // Simplified hull with a welding distance
+            test(hull.computeHull(&(points[0].x), points.size(), sizeof(Vector3), 10000, decimal(0.05)));
+            test(hull.getNbVertices() < 200);
+            test(isClosedHull(hull));
+            test(isInsideHull(hull, points, decimal(0.05)));
+        }
+
+        void testDegenerateCloud() {
+
+            // Points on a plane do not have a hull
+            std::vector<Vector3> points;
+            for (int i=0; i<10; i++) {
+                points.push_back(Vector3(decimal(i), decimal(i * i % 7), 0));
+            }
+            QuickHull hull;
+            test(!hull.computeHull(&(points[0].x), points.size(), sizeof(Vector3), 100, decimal(0.0)));
+            test(hull.getNbVertices() == 0);
+        }
+
+        void testConvexMeshShape() {
+
+            // Cube with points inside it
+            std::vector<Vector3> points;
+            uint32 seed = 3;
+            for (int i=0; i<500; i++) {
+                points.push_back(Vector3(random(seed) * 4 - 2, random(seed) * 2 - 1, random(seed) * 2 - 1));
+            }
+            for (int i=0; i<8; i++) {
+                points.push_back(Vector3(i & 1 ? 2 : -2, i & 2 ? 1 : -1, i & 4 ? 1 : -1));
+            }
+
+            ConvexMeshShape meshShape(&(points[0].x), points.size(), sizeof(Vector3), 64, decimal(0.001));
+            test(meshShape.getNbVertices() == 8);
+            test(meshShape.isEdgesInformationUsed());
+            test(meshShape.isFacesInformationAvailable());
+            test(meshShape.getNbFaces() == 6);
+            test(meshShape.getNbEdges() == 12);
+
+            Vector3 min, max;
+            meshShape.getLocalBounds(min, max);
+            const Vector3 margin(OBJECT_MARGIN, OBJECT_MARGIN, OBJECT_MARGIN);
+            test((min - (Vector3(-2, -1, -1) - margin)).length() < decimal(0.0001));
+            test((max - (Vector3(2, 1, 1) + margin)).length() < decimal(0.0001));
+        }
+ };
+
+}
+
+#endif
@@ -0,0 +1,293 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_STATIC_AABB_TREE_H
+#define TEST_STATIC_AABB_TREE_H
+
+// Libraries
+#include "Test.h"
+#include "collision/broadphase/StaticAABBTree.h"
+#include <vector>
+#include <algorithm>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+class StaticTreeOverlapCallback : public DynamicAABBTreeOverlapCallback {
+
+    public :
+
+        std::vector<int> mOverlapObjects;
+
+        // Called when a overlapping object has been found during the call to
+        // StaticAABBTree:reportAllShapesOverlappingWithAABB()
+        virtual void notifyOverlappingNode(int objectIndex) {
+            mOverlapObjects.push_back(objectIndex);
+        }
+
+        void reset() {
+            mOverlapObjects.clear();
+        }
+};
+
+class StaticTreeRaycastCallback : public DynamicAABBTreeRaycastCallback {
+
+    public:
+
+        std::vector<int> mHitObjects;
+
+        // Called when the AABB of an object is hit by a ray
+        virtual decimal raycastBroadPhaseShape(int32 objectIndex, const Ray& ray) {
+            mHitObjects.push_back(objectIndex);
+            return decimal(-1.0);
+        }
+
+        void reset() {
+            mHitObjects.clear();
+        }
+};
+
+// Class TestStaticAABBTree
+/**
+ * Unit test for the static AABB tree
+ */
+class TestStaticAABBTree : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        StaticTreeOverlapCallback mOverlapCallback;
+        StaticTreeRaycastCallback mRaycastCallback;
+
+        // ---------- Methods ---------- //
+
+        /// Return true if the data of the reported objects is the given list of data
+        bool isReported(const StaticAABBTree& tree, const std::vector<int>& reportedObjects,
+                        std::vector<int> expectedData) const {
+
+            std::vector<int> reportedData;
+            for (uint i=0; i<reportedObjects.size(); i++) {
+                reportedData.push_back(tree.getNodeDataInt(reportedObjects[i])[1]);
+            }
+            std::sort(reportedData.begin(), reportedData.end());
+            std::sort(expectedData.begin(), expectedData.end());
+            return reportedData == expectedData;
+        }
+
+        /// Return a pseudo-random number between zero and one
+        static decimal random(uint32& seed) {
+            seed = seed * 1664525u + 1013904223u;
+            return decimal(seed >> 8) / decimal(1 << 24);
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestStaticAABBTree(const std::string& name): Test(name)  {
+
+        }
+
+        /// Run the tests
+        void run() {
+
+            testBasicsMethods();
+            testOverlapping();
+            testRaycast();
+            testManyObjects();
+        }
+
+        void testBasicsMethods() {
+
+            StaticAABBTree tree;
+            tree.addObject(AABB(Vector3(-6, 4, -3), Vector3(4, 8, 3)), 0, 56);
+            tree.addObject(AABB(Vector3(5, 2, -3), Vector3(10, 7, 3)), 0, 23);
+            tree.addObject(AABB(Vector3(-5, 1, -3), Vector3(-2, 3, 3)), 1, 13);
+            tree.addObject(AABB(Vector3(0, -4, -3), Vector3(3, -2, 3)), 1, 7);
+            tree.build();
+
+            // Test the number of objects and nodes
+            test(tree.getNbObjects() == 4);
+            test(tree.getNbNodes() == 7);
+            test(tree.getSizeInBytes() > 7 * sizeof(StaticTreeNode));
+
+            // Test root AABB
+            const AABB& rootAABB = tree.getRootAABB();
+            test(rootAABB.getMin() == Vector3(-6, -4, -3));
+            test(rootAABB.getMax() == Vector3(10, 8, 3));
+
+            // Test the data of the objects (the objects are reordered when the tree is built)
+            std::vector<int> allObjects;
+            for (int i=0; i<4; i++) allObjects.push_back(i);
+            test(isReported(tree, allObjects, {56, 23, 13, 7}));
+            int nbSubPart1 = 0;
+            for (int i=0; i<4; i++) {
+                if (tree.getNodeDataInt(i)[0] == 1) {
+                    nbSubPart1++;
+                    test(tree.getNodeDataInt(i)[1] == 13 || tree.getNodeDataInt(i)[1] == 7);
+                }
+            }
+            test(nbSubPart1 == 2);
+
+            // Reset the tree and build it again with a single object
+            tree.reset();
+            test(tree.getNbObjects() == 0);
+            tree.addObject(AABB(Vector3(1, 2, 3), Vector3(4, 5, 6)), 2, 3);
+            tree.build();
+            test(tree.getNbNodes() == 1);
+            test(tree.getRootAABB().getMin() == Vector3(1, 2, 3));
+        }
+
+        void testOverlapping() {
+
+            StaticAABBTree tree;
+            tree.addObject(AABB(Vector3(-6, 4, -3), Vector3(4, 8, 3)), 0, 1);
+            tree.addObject(AABB(Vector3(5, 2, -3), Vector3(10, 7, 3)), 0, 2);
+            tree.addObject(AABB(Vector3(-5, 1, -3), Vector3(-2, 3, 3)), 0, 3);
+            tree.addObject(AABB(Vector3(0, -4, -3), Vector3(3, -2, 3)), 0, 4);
+            tree.build();
+
+            // AABB overlapping nothing
+            mOverlapCallback.reset();
+            tree.reportAllShapesOverlappingWithAABB(AABB(Vector3(-10, 12, -4), Vector3(10, 50, 4)), mOverlapCallback);
+            test(isReported(tree, mOverlapCallback.mOverlapObjects, {}));
+
+            // AABB overlapping everything
+            mOverlapCallback.reset();
+            tree.reportAllShapesOverlappingWithAABB(AABB(Vector3(-15, -15, -4), Vector3(15, 15, 4)), mOverlapCallback);
+            test(isReported(tree, mOverlapCallback.mOverlapObjects, {1, 2, 3, 4}));
+
+            // AABB overlapping object 1 and 3
+            mOverlapCallback.reset();
+            tree.reportAllShapesOverlappingWithAABB(AABB(Vector3(-4, 2, -4), Vector3(-1, 7, 4)), mOverlapCallback);
+            test(isReported(tree, mOverlapCallback.mOverlapObjects, {1, 3}));
+
+            // AABB overlapping object 3 and 4
+            mOverlapCallback.reset();
+            tree.reportAllShapesOverlappingWithAABB(AABB(Vector3(-6, -5, -2), Vector3(2, 2, 0)), mOverlapCallback);
+            test(isReported(tree, mOverlapCallback.mOverlapObjects, {3, 4}));
+
+            // AABB overlapping object 2
+            mOverlapCallback.reset();
+            tree.reportAllShapesOverlappingWithAABB(AABB(Vector3(5, -10, -2), Vector3(7, 10, 9)), mOverlapCallback);
+            test(isReported(tree, mOverlapCallback.mOverlapObjects, {2}));
+        }
+
+        void testRaycast() {
+
+            StaticAABBTree tree;
+            tree.addObject(AABB(Vector3(-6, 4, -3), Vector3(4, 8, 3)), 0, 1);
+            tree.addObject(AABB(Vector3(5, 2, -3), Vector3(10, 7, 3)), 0, 2);
+            tree.addObject(AABB(Vector3(-5, 1, -3), Vector3(-2, 3, 3)), 0, 3);
+            tree.addObject(AABB(Vector3(0, -4, -3), Vector3(3, -2, 3)), 0, 4);
+            tree.build();
+
+            // Ray with no hits
+            mRaycastCallback.reset();
+            tree.raycast(Ray(Vector3(4.5, -10, -5), Vector3(4.5, 10, -5)), mRaycastCallback);
+            test(isReported(tree, mRaycastCallback.mHitObjects, {}));
+
+            // Ray that hits object 1
+            mRaycastCallback.reset();
+            tree.raycast(Ray(Vector3(-1, 10, 5), Vector3(-1, -10, -5)), mRaycastCallback);
+            test(isReported(tree, mRaycastCallback.mHitObjects, {1}));
+
+            // Ray that hits object 1 and 2
+            mRaycastCallback.reset();
+            tree.raycast(Ray(Vector3(-10, 10, -5), Vector3(20, -4, 7)), mRaycastCallback);
+            test(isReported(tree, mRaycastCallback.mHitObjects, {1, 2}));
+
+            // Ray that hits object 3 (the ray is too short to hit object 4)
+            mRaycastCallback.reset();
+            tree.raycast(Ray(Vector3(-7, 2, 0), Vector3(7, 2, 0), decimal(0.2)), mRaycastCallback);
+            test(isReported(tree, mRaycastCallback.mHitObjects, {3}));
+        }
+
+        /// Compare the queries of a tree with many objects with brute-force queries
+        void testManyObjects() {
+
+            uint32 seed = 42;
+            std::vector<AABB> aabbs;
+            StaticAABBTree tree;
+            for (int i=0; i<2000; i++) {
+                Vector3 min(random(seed) * 100, random(seed) * 10, random(seed) * 100);
+                Vector3 size(random(seed) * 3, random(seed) * 3, random(seed) * 3);
+                aabbs.push_back(AABB(min, min + size));
+                tree.addObject(aabbs[i], 0, i);
+            }
+            tree.build();
+            test(tree.getNbNodes() == 2 * 2000 - 1);
+
+            // The tree must report all the overlapping objects (and may report objects
+            // that are very close because the node AABBs are quantized)
+            bool isAllReported = true;
+            bool isOnlyCloseReported = true;
+            for (int q=0; q<100; q++) {
+                Vector3 min(random(seed) * 100, random(seed) * 10, random(seed) * 100);
+                AABB queryAABB(min, min + Vector3(5, 5, 5));
+                AABB inflatedQueryAABB = queryAABB;
+                inflatedQueryAABB.inflate(decimal(0.1), decimal(0.1), decimal(0.1));
+
+                mOverlapCallback.reset();
+                tree.reportAllShapesOverlappingWithAABB(queryAABB, mOverlapCallback);
+                std::vector<bool> isReportedObject(aabbs.size(), false);
+                for (uint i=0; i<mOverlapCallback.mOverlapObjects.size(); i++) {
+                    int data = tree.getNodeDataInt(mOverlapCallback.mOverlapObjects[i])[1];
+                    isReportedObject[data] = true;
+                    isOnlyCloseReported &= aabbs[data].testCollision(inflatedQueryAABB);
+                }
+                for (uint i=0; i<aabbs.size(); i++) {
+                    if (aabbs[i].testCollision(queryAABB)) isAllReported &= isReportedObject[i];
+                }
+            }
+            test(isAllReported);
+            test(isOnlyCloseReported);
+
+            // The tree must report all the objects hit by the rays
+            bool isAllHit = true;
+            for (int r=0; r<100; r++) {
+                Vector3 point1(random(seed) * 100, random(seed) * 10, random(seed) * 100);
+                Vector3 point2(random(seed) * 100, random(seed) * 10, random(seed) * 100);
+                Ray ray(point1, point2);
+
+                mRaycastCallback.reset();
+                tree.raycast(ray, mRaycastCallback);
+                std::vector<bool> isHitObject(aabbs.size(), false);
+                for (uint i=0; i<mRaycastCallback.mHitObjects.size(); i++) {
+                    isHitObject[tree.getNodeDataInt(mRaycastCallback.mHitObjects[i])[1]] = true;
+                }
+                for (uint i=0; i<aabbs.size(); i++) {
+                    if (aabbs[i].testRayIntersect(ray)) isAllHit &= isHitObject[i];
+                }
+            }
+            test(isAllHit);
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,460 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_DYNAMICS_WORLD_H
+#define TEST_DYNAMICS_WORLD_H
+
+// Libraries
+#include "reactphysics3d.h"
+#include <vector>
+#include <algorithm>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestDynamicsWorld
+/**
+ * Unit test for the DynamicsWorld class.
+ */
+class TestDynamicsWorld : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        // Collision shapes
+        BoxShape* mBoxShape;
+        BoxShape* mFloorShape;
+        SphereShape* mSphereShape;
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestDynamicsWorld(const std::string& name) : Test(name) {
+
+            mBoxShape = new BoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            mFloorShape = new BoxShape(Vector3(50, decimal(0.5), 50));
+            mSphereShape = new SphereShape(decimal(0.5));
+        }
+
+        /// Destructor
+        ~TestDynamicsWorld() {
+            delete mBoxShape;
+            delete mFloorShape;
+            delete mSphereShape;
+        }
+
+        /// Run the tests
+        void run() {
+
+            testNbThreads();
+            testParallelIslandsDeterminism();
+            testParallelNarrowPhaseContacts();
+            testDestroyRigidBodies();
+
+            testContinuousCollisionDetection(DYNAMIC_AABB_TREE);
+            testContinuousCollisionDetection(SWEEP_AND_PRUNE);
+            testContinuousCollisionDetection(SPATIAL_HASH);
+
+            testPersistentContacts();
+
+            testStackedBoxes(SPLIT_IMPULSES, true);
+            testStackedBoxes(SPLIT_IMPULSES, false);
+            testStackedBoxes(BAUMGARTE_CONTACTS, true);
+        }
+
+        /// Create a scene with several independent islands (piles of boxes sharing a
+        /// static floor and chains of bodies connected with joints)
+        void createScene(DynamicsWorld* world, std::vector<RigidBody*>& bodies) {
+
+            // Static floor shared by all the piles
+            RigidBody* floor = world->createRigidBody(Transform(Vector3(0, -decimal(0.5), 0),
+                                                                Quaternion::identity()));
+            floor->addCollisionShape(mFloorShape, Transform::identity(), decimal(1.0));
+            floor->setType(STATIC);
+
+            // Piles of boxes
+            for (int p=0; p<6; p++) {
+                for (int i=0; i<5; i++) {
+                    Vector3 position(decimal(-20 + p * 8), decimal(0.5 + i * 1.05),
+                                     decimal(0.05 * i));
+                    RigidBody* body = world->createRigidBody(Transform(position,
+                                                                       Quaternion::identity()));
+                    body->addCollisionShape(mBoxShape, Transform::identity(), decimal(1.0));
+                    bodies.push_back(body);
+                }
+            }
+
+            // Chains of spheres attached to a static anchor with ball-and-socket joints
+            for (int c=0; c<3; c++) {
+                Vector3 anchorPosition(decimal(-20 + c * 15), 20, 20);
+                RigidBody* previous = world->createRigidBody(Transform(anchorPosition,
+                                                                      Quaternion::identity()));
+                previous->addCollisionShape(mSphereShape, Transform::identity(), decimal(1.0));
+                previous->setType(STATIC);
+
+                for (int i=1; i<=4; i++) {
+                    Vector3 position = anchorPosition + Vector3(decimal(i * 1.2), 0, 0);
+                    RigidBody* body = world->createRigidBody(Transform(position,
+                                                                       Quaternion::identity()));
+                    body->addCollisionShape(mSphereShape, Transform::identity(), decimal(1.0));
+                    bodies.push_back(body);
+
+                    Vector3 jointPosition = anchorPosition + Vector3(decimal(i * 1.2 - 0.6), 0, 0);
+                    BallAndSocketJointInfo jointInfo(previous, body, jointPosition);
+                    world->createJoint(jointInfo);
+                    previous = body;
+                }
+            }
+        }
+
+        /// Test the number of threads of the world
+        void testNbThreads() {
+
+            DynamicsWorld world(Vector3(0, decimal(-9.81), 0));
+            test(world.getNbThreads() == 1);
+
+            world.setNbThreads(3);
+            test(world.getNbThreads() == 3);
+
+            world.setNbThreads(0);
+            test(world.getNbThreads() == 1);
+        }
+
+        /// Test that solving the islands in parallel gives exactly the same
+        /// result as solving them serially
+        void testParallelIslandsDeterminism() {
+
+            DynamicsWorld serialWorld(Vector3(0, decimal(-9.81), 0));
+            DynamicsWorld parallelWorld(Vector3(0, decimal(-9.81), 0));
+            parallelWorld.setNbThreads(4);
+
+            std::vector<RigidBody*> serialBodies;
+            std::vector<RigidBody*> parallelBodies;
+            createScene(&serialWorld, serialBodies);
+            createScene(&parallelWorld, parallelBodies);
+
+            for (int i=0; i<120; i++) {
+                serialWorld.update(decimal(1.0) / decimal(60.0));
+                parallelWorld.update(decimal(1.0) / decimal(60.0));
+            }
+
+            test(serialBodies.size() == parallelBodies.size());
+            bool isSameState = true;
+            for (uint i=0; i<serialBodies.size(); i++) {
+                const Transform& serialTransform = serialBodies[i]->getTransform();
+                const Transform& parallelTransform = parallelBodies[i]->getTransform();
+                isSameState = isSameState &&
+                              serialTransform.getPosition() == parallelTransform.getPosition() &&
+                              serialTransform.getOrientation() == parallelTransform.getOrientation();
+            }
+            test(isSameState);
+
+            // The bodies of the piles must have been stopped by the static floor
+            test(serialBodies[0]->getTransform().getPosition().y > decimal(0.3));
+        }
+
+        /// Test that the contacts computed by the parallel narrow-phase are the
+        /// same (and in the same order) as the ones computed serially
+        void testParallelNarrowPhaseContacts() {
+
+            DynamicsWorld serialWorld(Vector3(0, decimal(-9.81), 0));
+            DynamicsWorld parallelWorld(Vector3(0, decimal(-9.81), 0));
+            parallelWorld.setNbThreads(4);
+
+            std::vector<RigidBody*> serialBodies;
+            std::vector<RigidBody*> parallelBodies;
+            createScene(&serialWorld, serialBodies);
+            createScene(&parallelWorld, parallelBodies);
+
+            for (int i=0; i<30; i++) {
+                serialWorld.update(decimal(1.0) / decimal(60.0));
+                parallelWorld.update(decimal(1.0) / decimal(60.0));
+            }
+
+            std::vector<const ContactManifold*> serialManifolds = serialWorld.getContactsList();
+            std::vector<const ContactManifold*> parallelManifolds = parallelWorld.getContactsList();
+            test(!serialManifolds.empty());
+            test(serialManifolds.size() == parallelManifolds.size());
+
+            bool isSameContacts = serialManifolds.size() == parallelManifolds.size();
+            for (uint i=0; isSameContacts && i<serialManifolds.size(); i++) {
+                const ContactManifold* serialManifold = serialManifolds[i];
+                const ContactManifold* parallelManifold = parallelManifolds[i];
+                isSameContacts = serialManifold->getNbContactPoints() ==
+                                 parallelManifold->getNbContactPoints();
+                for (uint c=0; isSameContacts && c<serialManifold->getNbContactPoints(); c++) {
+                    const ContactPoint* serialContact = serialManifold->getContactPoint(c);
+                    const ContactPoint* parallelContact = parallelManifold->getContactPoint(c);
+                    isSameContacts = serialContact->getPenetrationDepth() ==
+                                     parallelContact->getPenetrationDepth() &&
+                                     serialContact->getNormal() == parallelContact->getNormal();
+                }
+            }
+            test(isSameContacts);
+        }
+
+        /// Destroy some boxes of the piles and some spheres of the chains of the scene
+        /// (with their contacts and joints) at once in the middle of the simulation
+        void destroySceneBodies(DynamicsWorld& world, std::vector<RigidBody*>& bodies,
+                                std::vector<RigidBody*>& bodiesToDestroy) {
+
+            std::vector<RigidBody*> remainingBodies;
+            for (uint i=0; i<bodies.size(); i++) {
+
+                // Second and fourth boxes of each pile and the two middle spheres of each chain
+                const bool isBox = i < 30;
+                const bool isDestroyed = isBox ? (i % 5 == 1 || i % 5 == 3) :
+                                                 ((i - 30) % 4 == 1 || (i - 30) % 4 == 2);
+                if (isDestroyed) bodiesToDestroy.push_back(bodies[i]);
+                else remainingBodies.push_back(bodies[i]);
+            }
+
+            world.destroyRigidBodies(bodiesToDestroy);
+            bodies = remainingBodies;
+        }
+
+        /// Test the destruction of many rigid bodies with contacts and joints at once
+        void testDestroyRigidBodies() {
+
+            DynamicsWorld serialWorld(Vector3(0, decimal(-9.81), 0));
+            DynamicsWorld parallelWorld(Vector3(0, decimal(-9.81), 0));
+            parallelWorld.setNbThreads(4);
+
+            std::vector<RigidBody*> serialBodies;
+            std::vector<RigidBody*> parallelBodies;
+            createScene(&serialWorld, serialBodies);
+            createScene(&parallelWorld, parallelBodies);
+            const uint nbBodies = serialWorld.getNbRigidBodies();
+            test(serialWorld.getNbJoints() == 12);
+
+            // Let the boxes of the piles touch each other
+            for (int i=0; i<30; i++) {
+                serialWorld.update(decimal(1.0) / decimal(60.0));
+                parallelWorld.update(decimal(1.0) / decimal(60.0));
+            }
+            test(!serialWorld.getContactsList().empty());
+
+            std::vector<RigidBody*> destroyedBodies;
+            std::vector<RigidBody*> parallelDestroyedBodies;
+            destroySceneBodies(serialWorld, serialBodies, destroyedBodies);
+            destroySceneBodies(parallelWorld, parallelBodies, parallelDestroyedBodies);
+
+            // Twelve boxes and six spheres are destroyed with three joints of each chain
+            test(serialWorld.getNbRigidBodies() == nbBodies - 18);
+            test(serialWorld.getNbJoints() == 3);
+            test(parallelWorld.getNbJoints() == 3);
+
+            for (int i=0; i<120; i++) {
+                serialWorld.update(decimal(1.0) / decimal(60.0));
+                parallelWorld.update(decimal(1.0) / decimal(60.0));
+            }
+
+            // The contact manifolds must only involve remaining bodies
+            std::vector<const ContactManifold*> manifolds = serialWorld.getContactsList();
+            test(!manifolds.empty());
+            bool isValidManifolds = true;
+            for (uint i=0; i<manifolds.size(); i++) {
+                for (uint b=0; b<destroyedBodies.size(); b++) {
+                    isValidManifolds = isValidManifolds &&
+                                       manifolds[i]->getBody1() != destroyedBodies[b] &&
+                                       manifolds[i]->getBody2() != destroyedBodies[b];
+                }
+            }
+            test(isValidManifolds);
+
+            // The remaining boxes have fallen on the lower boxes of their pile and the
+            // parallel world gives the same result as the serial one
+            bool isSameState = serialBodies.size() == parallelBodies.size();
+            bool isAboveFloor = true;
+            for (uint i=0; isSameState && i<serialBodies.size(); i++) {
+                const Transform& serialTransform = serialBodies[i]->getTransform();
+                const Transform& parallelTransform = parallelBodies[i]->getTransform();
+                isSameState = serialTransform.getPosition() == parallelTransform.getPosition() &&
+                              serialTransform.getOrientation() == parallelTransform.getOrientation();
+                isAboveFloor = isAboveFloor && serialTransform.getPosition().y > decimal(0.3);
+            }
+            test(isSameState);
+            test(isAboveFloor);
+        }
+
+        /// Return the sorted feature ids of the contacts of a world
+        std::vector<uint> getContactFeatureIds(DynamicsWorld& world) {
+
+            std::vector<uint> featureIds;
+            std::vector<const ContactManifold*> manifolds = world.getContactsList();
+            for (uint i=0; i<manifolds.size(); i++) {
+                for (uint c=0; c<manifolds[i]->getNbContactPoints(); c++) {
+                    featureIds.push_back(manifolds[i]->getContactPoint(c)->getFeatureId());
+                }
+            }
+            std::sort(featureIds.begin(), featureIds.end());
+
+            return featureIds;
+        }
+
+        /// Test that the contacts of a box sliding on the floor keep the same feature ids
+        /// even if the box moves more than the persistent contact threshold in one step
+        void testPersistentContacts() {
+
+            DynamicsWorld world(Vector3(0, decimal(-9.81), 0));
+            world.enableSleeping(false);
+
+            RigidBody* floor = world.createRigidBody(Transform(Vector3(0, -decimal(0.5), 0),
+                                                               Quaternion::identity()));
+            floor->addCollisionShape(mFloorShape, Transform::identity(), decimal(1.0));
+            floor->setType(STATIC);
+
+            RigidBody* box = world.createRigidBody(Transform(Vector3(0, decimal(0.49), 0),
+                                                             Quaternion::identity()));
+            box->addCollisionShape(mBoxShape, Transform::identity(), decimal(1.0));
+
+            // Let the box rest on the floor
+            for (int i=0; i<10; i++) {
+                world.update(decimal(1.0) / decimal(60.0));
+            }
+
+            std::vector<uint> restingFeatureIds = getContactFeatureIds(world);
+            test(restingFeatureIds.size() == 4);
+            bool isValidIds = restingFeatureIds.size() == 4;
+            for (uint i=0; isValidIds && i<restingFeatureIds.size(); i++) {
+                isValidIds = restingFeatureIds[i] != NO_CONTACT_FEATURE_ID &&
+                             (i == 0 || restingFeatureIds[i] != restingFeatureIds[i - 1]);
+            }
+            test(isValidIds);
+
+            // Slide the box faster than the distance threshold of the persistent contacts
+            box->setLinearVelocity(Vector3(6, 0, 0));
+            bool isSameContacts = true;
+            for (int i=0; i<20; i++) {
+                world.update(decimal(1.0) / decimal(60.0));
+                isSameContacts = isSameContacts && getContactFeatureIds(world) == restingFeatureIds;
+            }
+            test(isSameContacts);
+            test(box->getTransform().getPosition().x > decimal(1.0));
+        }
+
+        /// Test that a pyramid of boxes stays at rest on the floor. The pyramid is a single
+        /// island whose contact points share many bodies and are solved in several batches.
+        void testStackedBoxes(ContactsPositionCorrectionTechnique technique,
+                              bool isSolveFrictionAtManifoldCenter) {
+
+            DynamicsWorld world(Vector3(0, decimal(-9.81), 0));
+            world.enableSleeping(false);
+            world.setContactsPositionCorrectionTechnique(technique);
+            world.setIsSolveFrictionAtContactManifoldCenterActive(isSolveFrictionAtManifoldCenter);
+
+            RigidBody* floor = world.createRigidBody(Transform(Vector3(0, -decimal(0.5), 0),
+                                                               Quaternion::identity()));
+            floor->addCollisionShape(mFloorShape, Transform::identity(), decimal(1.0));
+            floor->setType(STATIC);
+
+            std::vector<RigidBody*> boxes;
+            std::vector<Vector3> initialPositions;
+            for (int row=0; row<6; row++) {
+                for (int i=0; i<6-row; i++) {
+                    Vector3 position(decimal(i * 1.0 + row * 0.5), decimal(0.5 + row * 1.0), 0);
+                    RigidBody* box = world.createRigidBody(Transform(position,
+                                                                     Quaternion::identity()));
+                    box->addCollisionShape(mBoxShape, Transform::identity(), decimal(1.0));
+                    boxes.push_back(box);
+                    initialPositions.push_back(position);
+                }
+            }
+
+            for (int i=0; i<180; i++) {
+                world.update(decimal(1.0) / decimal(60.0));
+            }
+
+            bool isAtRest = true;
+            for (uint i=0; i<boxes.size(); i++) {
+                const Vector3 displacement = boxes[i]->getTransform().getPosition() -
+                                             initialPositions[i];
+                isAtRest = isAtRest && displacement.length() < decimal(0.05) &&
+                           boxes[i]->getLinearVelocity().length() < decimal(0.05);
+            }
+            test(isAtRest);
+        }
+
+        /// Fire a small fast sphere at a thin static wall and return its final x coordinate
+        decimal fireSphereAtWall(BroadPhaseType broadPhaseType, CollisionShape* wallShape,
+                                 bool isCCDEnabled) {
+
+            DynamicsWorld world(Vector3(0, 0, 0), broadPhaseType);
+
+            RigidBody* wall = world.createRigidBody(Transform(Vector3(10, 0, 0),
+                                                              Quaternion::identity()));
+            wall->setType(STATIC);
+            wall->addCollisionShape(wallShape, Transform::identity(), decimal(1.0));
+
+            SphereShape bulletShape(decimal(0.1));
+            RigidBody* bullet = world.createRigidBody(Transform(Vector3(0, 0, 0),
+                                                                Quaternion::identity()));
+            bullet->addCollisionShape(&bulletShape, Transform::identity(), decimal(10.0));
+            bullet->enableCCD(isCCDEnabled);
+            bullet->setLinearVelocity(Vector3(300, 0, 0));
+
+            for (int i=0; i<20; i++) {
+                world.update(decimal(1.0) / decimal(60.0));
+            }
+
+            return bullet->getTransform().getPosition().x;
+        }
+
+        /// Test that a fast body with continuous collision detection does not tunnel
+        /// through thin convex and concave walls
+        void testContinuousCollisionDetection(BroadPhaseType broadPhaseType) {
+
+            BoxShape thinBoxShape(Vector3(decimal(0.02), 5, 5), decimal(0.01));
+
+            // Thin wall made of two triangles in the plane x=0
+            const Vector3 vertices[4] = {Vector3(0, -5, -5), Vector3(0, -5, 5),
+                                         Vector3(0, 5, 5), Vector3(0, 5, -5)};
+            const uint indices[6] = {0, 1, 2, 0, 2, 3};
+            TriangleVertexArray::VertexDataType vertexType = sizeof(decimal) == 4 ?
+                                                             TriangleVertexArray::VERTEX_FLOAT_TYPE :
+                                                             TriangleVertexArray::VERTEX_DOUBLE_TYPE;
+            TriangleVertexArray vertexArray(4, const_cast<Vector3*>(vertices), sizeof(Vector3), 2,
+                                            const_cast<uint*>(indices), sizeof(uint), vertexType,
+                                            TriangleVertexArray::INDEX_INTEGER_TYPE);
+            TriangleMesh triangleMesh;
+            triangleMesh.addSubpart(&vertexArray);
+            ConcaveMeshShape meshShape(&triangleMesh);
+
+            // Without continuous collision detection, the sphere tunnels through the walls
+            test(fireSphereAtWall(broadPhaseType, &thinBoxShape, false) > decimal(11.0));
+            test(fireSphereAtWall(broadPhaseType, &meshShape, false) > decimal(11.0));
+
+            // With continuous collision detection, it is stopped in front of the walls
+            test(fireSphereAtWall(broadPhaseType, &thinBoxShape, true) < decimal(10.0));
+            test(fireSphereAtWall(broadPhaseType, &meshShape, true) < decimal(10.0));
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,148 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_OVERLAPPING_PAIR_MAP_H
+#define TEST_OVERLAPPING_PAIR_MAP_H
+
+// Libraries
+#include "reactphysics3d.h"
+#include "engine/OverlappingPairMap.h"
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestOverlappingPairMap
+/**
+ * Unit test for the OverlappingPairMap class.
+ */
+class TestOverlappingPairMap : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        // Objects used as values of the map (the pairs are never dereferenced)
+        std::vector<int> mValues;
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestOverlappingPairMap(const std::string& name) : Test(name), mValues(1000) {
+
+        }
+
+        /// Return the fake pair associated with a given index
+        OverlappingPair* getPair(uint index) {
+            return reinterpret_cast<OverlappingPair*>(&mValues[index]);
+        }
+
+        /// Return the pair ID associated with a given index
+        overlappingpairid getPairID(uint index) {
+            return std::make_pair(index / 4, index / 4 + 1 + index % 4);
+        }
+
+        /// Run the tests
+        void run() {
+
+            testAddAndFind();
+            testRemove();
+        }
+
+        void testAddAndFind() {
+
+            OverlappingPairMap map;
+            test(map.getNbPairs() == 0);
+            test(map.find(getPairID(0)) == NULL);
+
+            for (uint i=0; i<1000; i++) {
+                map.add(getPairID(i), getPair(i));
+            }
+            test(map.getNbPairs() == 1000);
+
+            // A pair cannot be added twice
+            test(!map.add(getPairID(17), getPair(17)));
+            test(map.getNbPairs() == 1000);
+
+            bool isAllFound = true;
+            for (uint i=0; i<1000; i++) {
+                isAllFound = isAllFound && map.find(getPairID(i)) == getPair(i);
+            }
+            test(isAllFound);
+            test(map.find(std::make_pair(uint(5000), uint(5001))) == NULL);
+
+            // The pairs are stored contiguously in insertion order
+            test(map.getPair(0) == getPair(0));
+            test(map.getPairID(999) == getPairID(999));
+            test(map.getPair(999) == getPair(999));
+
+            map.clear();
+            test(map.getNbPairs() == 0);
+            test(map.find(getPairID(3)) == NULL);
+            test(map.add(getPairID(3), getPair(3)));
+            test(map.find(getPairID(3)) == getPair(3));
+        }
+
+        void testRemove() {
+
+            OverlappingPairMap map;
+            for (uint i=0; i<1000; i++) {
+                map.add(getPairID(i), getPair(i));
+            }
+
+            // Remove one pair out of three
+            for (uint i=0; i<1000; i+=3) {
+                map.remove(getPairID(i));
+            }
+            test(map.getNbPairs() == 666);
+
+            bool isCorrect = true;
+            for (uint i=0; i<1000; i++) {
+                OverlappingPair* expectedPair = (i % 3 == 0) ? NULL : getPair(i);
+                isCorrect = isCorrect && map.find(getPairID(i)) == expectedPair;
+            }
+            test(isCorrect);
+
+            // The array of pairs must only contain the remaining pairs
+            bool isArrayCorrect = true;
+            for (uint i=0; i<map.getNbPairs(); i++) {
+                isArrayCorrect = isArrayCorrect && map.find(map.getPairID(i)) == map.getPair(i);
+            }
+            test(isArrayCorrect);
+
+            // Remove all the remaining pairs
+            for (uint i=0; i<1000; i++) {
+                if (i % 3 != 0) map.remove(getPairID(i));
+            }
+            test(map.getNbPairs() == 0);
+            test(map.find(getPairID(1)) == NULL);
+        }
+};
+
+}
+
+#endif
@@ -31,7 +31,7 @@ using namespace openglframework;
 using namespace cubesscene;
 
 // Constructor
-CubesScene::CubesScene(const std::string& name)
+CubesScene::CubesScene(const std::string& name, rp3d::BroadPhaseType broadPhaseType)
       : SceneDemo(name, SCENE_RADIUS) {
 
     // Compute the radius and the center of the scene
@@ -44,7 +44,7 @@ CubesScene::CubesScene(const std::string& name)
     rp3d::Vector3 gravity(0, rp3d::decimal(-9.81), 0);
 
     // Create the dynamics world for the physics simulation
-    mDynamicsWorld = new rp3d::DynamicsWorld(gravity);
+    mDynamicsWorld = new rp3d::DynamicsWorld(gravity, broadPhaseType);
 
     // Set the number of iterations of the constraint solver
     mDynamicsWorld->setNbIterationsVelocitySolver(15);
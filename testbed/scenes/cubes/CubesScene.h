@@ -63,7 +63,8 @@ class CubesScene : public SceneDemo {
         // -------------------- Methods -------------------- //
 
         /// Constructor
-        CubesScene(const std::string& name);
+        CubesScene(const std::string& name,
+                   rp3d::BroadPhaseType broadPhaseType = rp3d::DYNAMIC_AABB_TREE);
 
         /// Destructor
         virtual ~CubesScene();
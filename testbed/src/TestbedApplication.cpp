@@ -97,6 +97,11 @@ void TestbedApplication::createScenes() {
     CubesScene* cubeScene = new CubesScene("Cubes");
     mScenes.push_back(cubeScene);
 
+    // Cubes scene with the sweep-and-prune broad-phase (to compare its physics time
+    // with the one of the AABB trees)
+    CubesScene* cubeSAPScene = new CubesScene("Cubes (Sweep and Prune)", rp3d::SWEEP_AND_PRUNE);
+    mScenes.push_back(cubeSAPScene);
+
     // Joints scene
     JointsScene* jointsScene = new JointsScene("Joints");
     mScenes.push_back(jointsScene);